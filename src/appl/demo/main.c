@@ -117,6 +117,12 @@
 #include <bcma/bcmbd/bcma_bcmbdcmd_cmicd.h>
 #include <bcma/bcmbd/bcma_bcmbdcmd_dev.h>
 #include <bcma/bcmpkt/bcma_bcmpktcmd.h>
+#include <bcma/bcmptm/bcma_bcmptmcmd.h>
+#include <bcma/bcmlm/bcma_bcmlmcmd.h>
+#include <bcma/bcmevm/bcma_bcmevmcmd.h>
+#include <bcma/bcmimm/bcma_bcmimmcmd.h>
+#include <bcma/bcmecmp/bcma_bcmecmpcmd.h>
+#include <bcma/shr/bcma_shrcmd.h>
 #include <bcma/cint/bcma_cint_cmd.h>
 #include <bcma/ha/bcma_ha.h>
 #include <bcma/sys/bcma_sys_conf_sdk.h>
@@ -159,6 +165,24 @@ cli_init(bcma_sys_conf_t *sc)
     bcma_bcmbdcmd_add_cmicd_cmds(sc->dsh);
     bcma_bcmbdcmd_add_dev_cmds(sc->dsh);
 
+    /* Add CLI commands for PTM resource manager debug to debug shell */
+    bcma_bcmptmcmd_add_cmds(sc->dsh);
+
+    /* Add CLI commands for Link Manager debug to debug shell */
+    bcma_bcmlmcmd_add_cmds(sc->dsh);
+
+    /* Add CLI commands for event manager tests to debug shell */
+    bcma_bcmevmcmd_add_cmds(sc->dsh);
+
+    /* Add CLI commands for IMM back-end tests to debug shell */
+    bcma_bcmimmcmd_add_cmds(sc->dsh);
+
+    /* Add CLI commands for ECMP allocator tests to debug shell */
+    bcma_bcmecmpcmd_add_cmds(sc->dsh);
+
+    /* Add CLI commands for shared library tests to debug shell */
+    bcma_shrcmd_add_cmds(sc->dsh);
+
     /* Add CLI commands for packet I/O driver */
     bcma_bcmpktcmd_add_cmds(sc->cli);
 
@@ -0,0 +1,369 @@
+/*! \file bcma_bcmecmpcmd_ecmpperf.c
+ *
+ * CLI 'ecmpperf' command for ECMP member table allocator performance tests.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <bsl/bsl.h>
+
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_time.h>
+
+#include <shr/shr_error.h>
+
+#include <bcmecmp/bcmecmp_ext.h>
+
+#include <bcma/cli/bcma_cli_parse.h>
+
+#include <bcma/bcmecmp/bcma_bcmecmpcmd_ecmpperf.h>
+
+/* Default number of operations per test run. */
+#ifndef BCMA_BCMECMP_CONFIG_DEFAULT_PERF_COUNT
+#define BCMA_BCMECMP_CONFIG_DEFAULT_PERF_COUNT 10000
+#endif
+
+/* Default number of entries of the scratch member table. */
+#ifndef BCMA_BCMECMP_CONFIG_DEFAULT_PERF_SIZE
+#define BCMA_BCMECMP_CONFIG_DEFAULT_PERF_SIZE 16384
+#endif
+
+/* Member table fill level kept by the test. */
+#define PERF_ECMP_FILL_PCT 90
+
+/*******************************************************************************
+ * Private functions
+ */
+
+/* ECMP allocator test state. */
+typedef struct perf_ecmp_s {
+    /* Member table usage. */
+    bcmecmp_tbl_prop_t tbl;
+
+    /* Member blocks of the live groups. */
+    bcmecmp_ext_blk_t *blk;
+
+    /* Number of live groups. */
+    int num_blk;
+
+    /* Number of member table entries used by the live groups. */
+    uint32_t used;
+
+    /* Random number state. */
+    uint32_t seed;
+} perf_ecmp_t;
+
+static uint32_t
+perf_ecmp_rand(perf_ecmp_t *pe)
+{
+    pe->seed = pe->seed * 1103515245U + 12345U;
+    return pe->seed >> 8;
+}
+
+/* First-fit scan of the member table as done without the extent index. */
+static int
+perf_ecmp_scan(perf_ecmp_t *pe, uint32_t num_ent, int *start)
+{
+    int imax = pe->tbl.imax;
+    int start_idx, idx;
+
+    for (start_idx = pe->tbl.imin; start_idx <= imax; start_idx++) {
+        if (BCMECMP_TBL_REF_CNT(&pe->tbl, start_idx)) {
+            continue;
+        }
+        for (idx = start_idx;
+             idx < (start_idx + (int)num_ent) && idx <= imax;
+             idx++) {
+            if (BCMECMP_TBL_REF_CNT(&pe->tbl, idx)) {
+                break;
+            }
+        }
+        if (idx == (start_idx + (int)num_ent)) {
+            *start = start_idx;
+            return SHR_E_NONE;
+        }
+    }
+    return SHR_E_FULL;
+}
+
+/* Move callback which only updates the member table usage. */
+static int
+perf_ecmp_move(void *user_data, bcmecmp_ext_blk_t *blk, int new_start)
+{
+    perf_ecmp_t *pe = (perf_ecmp_t *)user_data;
+
+    bcmecmp_tbl_ref_cnt_incr(&pe->tbl, new_start, blk->count);
+    bcmecmp_tbl_ref_cnt_decr(&pe->tbl, blk->start, blk->count);
+
+    /* Keep the group list in step with the moved block. */
+    pe->blk[blk->id].start = new_start;
+
+    return SHR_E_NONE;
+}
+
+/*
+ * Add groups of random size to a scratch member table of <size> entries,
+ * deleting random groups whenever the table is filled beyond
+ * PERF_ECMP_FILL_PCT, using either the first-fit scan or the extent index.
+ */
+static int
+perf_ecmp_run(int unit, int size, uint32_t count, bool ext)
+{
+    perf_ecmp_t pe;
+    bcmecmp_ext_blk_t *blk = NULL;
+    uint32_t idx, num_ent, allocs = 0, fails = 0, rescued = 0;
+    uint32_t free_cnt, max_free;
+    int start, moved = 0, moves = 0, num, rv = SHR_E_NONE;
+    sal_usecs_t usecs = 0, t0;
+
+    sal_memset(&pe, 0, sizeof(pe));
+    pe.seed = 1;
+    pe.tbl.imin = 0;
+    pe.tbl.imax = size - 1;
+    pe.tbl.ent_arr = sal_alloc(size * sizeof(*pe.tbl.ent_arr),
+                               "bcmaEcmpPerfEcmp");
+    pe.blk = sal_alloc(size * sizeof(*pe.blk), "bcmaEcmpPerfEcmpBlk");
+    blk = sal_alloc(size * sizeof(*blk), "bcmaEcmpPerfEcmpDefrag");
+    if (pe.tbl.ent_arr == NULL || pe.blk == NULL || blk == NULL) {
+        rv = SHR_E_MEMORY;
+    } else {
+        sal_memset(pe.tbl.ent_arr, 0, size * sizeof(*pe.tbl.ent_arr));
+        if (ext) {
+            rv = bcmecmp_ext_create(unit, pe.tbl.ent_arr, size, &pe.tbl.ext);
+        }
+    }
+
+    for (idx = 0; idx < count && SHR_SUCCESS(rv); idx++) {
+        /* Delete random groups while the table is above the fill level. */
+        if (pe.num_blk > 0 &&
+            pe.used * 100 > (uint32_t)size * PERF_ECMP_FILL_PCT) {
+            num = perf_ecmp_rand(&pe) % pe.num_blk;
+            bcmecmp_tbl_ref_cnt_decr(&pe.tbl, pe.blk[num].start,
+                                     pe.blk[num].count);
+            pe.used -= pe.blk[num].count;
+            pe.blk[num] = pe.blk[--pe.num_blk];
+            continue;
+        }
+
+        /* Group sizes from 2 to 256 entries, smaller ones more likely. */
+        num_ent = 2U << (perf_ecmp_rand(&pe) % 8);
+        num_ent >>= (perf_ecmp_rand(&pe) % 4);
+        if (num_ent < 2) {
+            num_ent = 2;
+        }
+
+        t0 = sal_time_usecs();
+        if (ext) {
+            rv = bcmecmp_ext_find(pe.tbl.ext, 0, size - 1, num_ent, &start);
+            if (rv == SHR_E_FULL) {
+                bcmecmp_ext_usage_get(pe.tbl.ext, 0, size - 1,
+                                      &free_cnt, NULL);
+                if (free_cnt >= num_ent) {
+                    for (num = 0; num < pe.num_blk; num++) {
+                        blk[num] = pe.blk[num];
+                        blk[num].id = num;
+                    }
+                    rv = bcmecmp_ext_defrag(pe.tbl.ext, 0, size - 1, num_ent,
+                                            blk, pe.num_blk, perf_ecmp_move,
+                                            &pe, &moved);
+                    moves += moved;
+                    if (SHR_SUCCESS(rv)) {
+                        rescued++;
+                        rv = bcmecmp_ext_find(pe.tbl.ext, 0, size - 1,
+                                              num_ent, &start);
+                    }
+                }
+            }
+        } else {
+            rv = perf_ecmp_scan(&pe, num_ent, &start);
+        }
+        usecs += SAL_USECS_SUB(sal_time_usecs(), t0);
+        allocs++;
+
+        if (rv == SHR_E_FULL) {
+            fails++;
+            rv = SHR_E_NONE;
+            continue;
+        }
+        if (SHR_SUCCESS(rv)) {
+            bcmecmp_tbl_ref_cnt_incr(&pe.tbl, start, num_ent);
+            pe.blk[pe.num_blk].start = start;
+            pe.blk[pe.num_blk].count = num_ent;
+            pe.num_blk++;
+            pe.used += num_ent;
+        }
+    }
+
+    /* Fragmentation of the free entries left at the end of the run. */
+    free_cnt = 0;
+    max_free = 0;
+    for (num = 0, start = 0; num < size; num++) {
+        if (pe.tbl.ent_arr && pe.tbl.ent_arr[num].ref_cnt == 0) {
+            free_cnt++;
+            if ((uint32_t)(num - start + 1) > max_free) {
+                max_free = num - start + 1;
+            }
+        } else {
+            start = num + 1;
+        }
+    }
+
+    bcmecmp_ext_destroy(pe.tbl.ext);
+    if (blk) {
+        sal_free(blk);
+    }
+    if (pe.blk) {
+        sal_free(pe.blk);
+    }
+    if (pe.tbl.ent_arr) {
+        sal_free(pe.tbl.ent_arr);
+    }
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sECMP allocator test failed: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    cli_out("  %-8s %10"PRIu32" %12"PRIu64" %8"PRIu32" %8"PRIu32
+            " %8d %8"PRIu32" %8"PRIu32" %5"PRIu32"%%\n",
+            ext ? "extent" : "scan", allocs,
+            allocs ? (uint64_t)usecs * 1000 / allocs : 0,
+            fails, rescued, moves, free_cnt, max_free,
+            free_cnt ? 100 - (max_free * 100 / free_cnt) : 0);
+
+    return BCMA_CLI_CMD_OK;
+}
+
+/*
+ * Compare the ECMP member table first-fit scan with the extent index.
+ */
+static int
+perf_ecmp(int unit, uint32_t count, int size)
+{
+    int rv;
+
+    cli_out("ECMP member allocator, %d entries:\n", size);
+    cli_out("  %-8s %10s %12s %8s %8s %8s %8s %8s %6s\n",
+            "Mode", "Allocs", "nsec/alloc", "Failed", "Rescued",
+            "Moves", "Free", "MaxFree", "Frag");
+    rv = perf_ecmp_run(unit, size, count, false);
+    if (rv == BCMA_CLI_CMD_OK) {
+        rv = perf_ecmp_run(unit, size, count, true);
+    }
+
+    return rv;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+bcma_bcmecmpcmd_ecmpperf(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    bcma_cli_parse_table_t pt;
+    int count = BCMA_BCMECMP_CONFIG_DEFAULT_PERF_COUNT;
+    int size = BCMA_BCMECMP_CONFIG_DEFAULT_PERF_SIZE;
+
+    if (cli == NULL || args == NULL) {
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "count", "int", &count, NULL);
+    bcma_cli_parse_table_add(&pt, "size", "int", &size, NULL);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0 ||
+        BCMA_CLI_ARG_CNT(args) > 0 || count <= 0 || size <= 0) {
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    return perf_ecmp(cli->cur_unit, count, size);
+}
@@ -0,0 +1,323 @@
+/*! \file bcma_bcmevmcmd_evmperf.c
+ *
+ * CLI 'evmperf' command for event manager performance tests.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <bsl/bsl.h>
+
+#include <sal/sal_libc.h>
+#include <sal/sal_time.h>
+#include <sal/sal_thread.h>
+#include <sal/sal_sem.h>
+
+#include <shr/shr_error.h>
+
+#include <bcmevm/bcmevm_api.h>
+
+#include <bcma/cli/bcma_cli_parse.h>
+
+#include <bcma/bcmevm/bcma_bcmevmcmd_evmperf.h>
+
+/* Default number of operations per test run. */
+#ifndef BCMA_BCMEVM_CONFIG_DEFAULT_PERF_COUNT
+#define BCMA_BCMEVM_CONFIG_DEFAULT_PERF_COUNT 10000
+#endif
+
+/* Default number of publisher threads. */
+#ifndef BCMA_BCMEVM_CONFIG_DEFAULT_PERF_THREADS
+#define BCMA_BCMEVM_CONFIG_DEFAULT_PERF_THREADS 4
+#endif
+
+/* Maximum number of publisher threads. */
+#define PERF_EVM_THREADS_MAX 16
+
+/* Published event used by the test. */
+#define PERF_EVM_EVENT "bcmaEvmPerfEv"
+
+/* Publisher context of the event test. */
+typedef struct perf_evm_ctx_s {
+
+    /*! Unit number. */
+    int unit;
+
+    /*! Publish by event ID rather than by event name. */
+    bool by_id;
+
+    /*! Event ID of the test event. */
+    uint32_t event_id;
+
+    /*! Number of events to publish. */
+    uint32_t count;
+
+    /*! Signaled when the publisher is done. */
+    sal_sem_t done;
+
+    /*! Total publish time. */
+    uint32_t usecs;
+
+    /*! Longest single publish time. */
+    uint32_t max_usecs;
+
+} perf_evm_ctx_t;
+
+/*******************************************************************************
+ * Private functions
+ */
+
+static void
+perf_evm_cb(int unit, const char *event, uint64_t ev_data)
+{
+}
+
+static void
+perf_evm_churn_cb(int unit, const char *event, uint64_t ev_data)
+{
+}
+
+static void
+perf_evm_publisher(void *arg)
+{
+    perf_evm_ctx_t *ctx = (perf_evm_ctx_t *)arg;
+    sal_usecs_t start, t0, t1;
+    uint32_t idx, usecs;
+
+    start = sal_time_usecs();
+    t0 = start;
+    for (idx = 0; idx < ctx->count; idx++) {
+        if (ctx->by_id) {
+            bcmevm_publish_event_id_notify(ctx->unit, ctx->event_id, idx);
+        } else {
+            bcmevm_publish_event_notify(ctx->unit, PERF_EVM_EVENT, idx);
+        }
+        t1 = sal_time_usecs();
+        usecs = SAL_USECS_SUB(t1, t0);
+        if (usecs > ctx->max_usecs) {
+            ctx->max_usecs = usecs;
+        }
+        t0 = t1;
+    }
+    ctx->usecs = SAL_USECS_SUB(t0, start);
+    sal_sem_give(ctx->done);
+}
+
+/*
+ * Run one event publish test with concurrent publishers and optionally
+ * a concurrent writer which keeps (un)registering a second callback.
+ */
+static int
+perf_evm_run(int unit, uint32_t event_id, int threads, uint32_t count,
+             bool by_id, bool churn)
+{
+    perf_evm_ctx_t ctx[PERF_EVM_THREADS_MAX];
+    sal_sem_t done;
+    sal_thread_t tid;
+    uint32_t writes = 0, max_usecs = 0;
+    uint64_t pub_usecs = 0, pubs = 0;
+    int started, finished, j;
+
+    done = sal_sem_create("bcmaEvmPerfEvm", SAL_SEM_COUNTING, 0);
+    if (!done) {
+        cli_out("%sFailed to create semaphore.\n", BCMA_CLI_CONFIG_ERROR_STR);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    sal_memset(ctx, 0, sizeof(ctx));
+    for (started = 0; started < threads; started++) {
+        ctx[started].unit = unit;
+        ctx[started].by_id = by_id;
+        ctx[started].event_id = event_id;
+        ctx[started].count = count;
+        ctx[started].done = done;
+        tid = sal_thread_create("bcmaEvmPerfEvm", SAL_THREAD_STKSZ,
+                                SAL_THREAD_PRIO_DEFAULT,
+                                perf_evm_publisher, &ctx[started]);
+        if (tid == SAL_THREAD_ERROR) {
+            cli_out("%sFailed to create publisher thread.\n",
+                    BCMA_CLI_CONFIG_ERROR_STR);
+            break;
+        }
+    }
+
+    finished = 0;
+    while (finished < started) {
+        if (churn) {
+            if (SHR_SUCCESS(bcmevm_register_published_event(
+                                unit, PERF_EVM_EVENT, perf_evm_churn_cb))) {
+                bcmevm_unregister_published_event(unit, PERF_EVM_EVENT,
+                                                  perf_evm_churn_cb);
+                writes += 2;
+            }
+        }
+        if (sal_sem_take(done, churn ? SAL_SEM_NOWAIT : SAL_SEM_FOREVER) == 0) {
+            finished++;
+        }
+    }
+    sal_sem_destroy(done);
+
+    for (j = 0; j < started; j++) {
+        pubs += ctx[j].count;
+        pub_usecs += ctx[j].usecs;
+        if (ctx[j].max_usecs > max_usecs) {
+            max_usecs = ctx[j].max_usecs;
+        }
+    }
+    if (pubs == 0) {
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    cli_out("  %-6s %-6s %8d %10"PRIu64" %10"PRIu64" %10"PRIu32
+            " %8"PRIu32"\n",
+            by_id ? "id" : "name", churn ? "yes" : "no", started, pubs,
+            pub_usecs * 1000 / pubs, max_usecs, writes);
+
+    return (started == threads) ? BCMA_CLI_CMD_OK : BCMA_CLI_CMD_FAIL;
+}
+
+/*
+ * Measure the published event latency under contention.
+ */
+static int
+perf_evm(int unit, uint32_t count, int threads)
+{
+    uint32_t event_id;
+    int rv, mode;
+
+    rv = bcmevm_register_published_event(unit, PERF_EVM_EVENT, perf_evm_cb);
+    if (SHR_SUCCESS(rv)) {
+        rv = bcmevm_event_id_get(unit, PERF_EVM_EVENT, &event_id);
+    }
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sFailed to register test event: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    cli_out("Published events:\n");
+    cli_out("  %-6s %-6s %8s %10s %10s %10s %8s\n",
+            "Mode", "Churn", "Threads", "Count", "nsec/pub", "Max(usec)",
+            "Writes");
+    rv = BCMA_CLI_CMD_OK;
+    for (mode = 0; mode < 4 && rv == BCMA_CLI_CMD_OK; mode++) {
+        rv = perf_evm_run(unit, event_id, threads, count,
+                          (mode & 1) != 0, (mode & 2) != 0);
+    }
+
+    bcmevm_unregister_published_event(unit, PERF_EVM_EVENT, perf_evm_cb);
+
+    return rv;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+bcma_bcmevmcmd_evmperf(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    bcma_cli_parse_table_t pt;
+    int count = BCMA_BCMEVM_CONFIG_DEFAULT_PERF_COUNT;
+    int threads = BCMA_BCMEVM_CONFIG_DEFAULT_PERF_THREADS;
+
+    if (cli == NULL || args == NULL) {
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "count", "int", &count, NULL);
+    bcma_cli_parse_table_add(&pt, "threads", "int", &threads, NULL);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0 ||
+        BCMA_CLI_ARG_CNT(args) > 0 || count <= 0 || threads <= 0 || threads > PERF_EVM_THREADS_MAX) {
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    return perf_evm(cli->cur_unit, count, threads);
+}
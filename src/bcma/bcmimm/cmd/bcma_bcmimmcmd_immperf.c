@@ -0,0 +1,342 @@
+/*! \file bcma_bcmimmcmd_immperf.c
+ *
+ * CLI 'immperf' command for in-memory table back-end performance tests.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <bsl/bsl.h>
+
+#include <sal/sal_libc.h>
+#include <sal/sal_time.h>
+
+#include <shr/shr_error.h>
+
+#include <bcmimm/bcmimm_backend.h>
+#include <bcmmgmt/bcmmgmt_sysm.h>
+
+#include <bcma/cli/bcma_cli_parse.h>
+
+#include <bcma/bcmimm/bcma_bcmimmcmd_immperf.h>
+
+/* Default number of operations per test run. */
+#ifndef BCMA_BCMIMM_CONFIG_DEFAULT_PERF_COUNT
+#define BCMA_BCMIMM_CONFIG_DEFAULT_PERF_COUNT 10000
+#endif
+
+/* Default number of hash bins of the test table. */
+#ifndef BCMA_BCMIMM_CONFIG_DEFAULT_PERF_ROWS
+#define BCMA_BCMIMM_CONFIG_DEFAULT_PERF_ROWS 1024
+#endif
+
+/*******************************************************************************
+ * Private functions
+ */
+
+/*
+ * Insert and look up <count> entries in a temporary IMM back-end table
+ * with or without the entry index.
+ */
+static int
+perf_imm_run(int unit, uint32_t rows, uint32_t count, bool index)
+{
+    bcmimm_be_tbl_hdl_t hdl;
+    bcmimm_be_fields_t flds;
+    uint32_t fid = 0;
+    uint64_t data;
+    uint32_t idx, key;
+    sal_usecs_t start;
+    uint32_t ins_usecs, lkp_usecs;
+    int rv;
+
+    rv = bcmimm_be_table_create(unit, BCMMGMT_IMM_BE_COMP_ID,
+                                BCMIMM_BE_TEMP_SUB_ID, sizeof(key),
+                                sizeof(data), rows, false, &hdl);
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sFailed to create test table: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    rv = bcmimm_be_table_index_set(hdl, index);
+    flds.fid = &fid;
+    flds.fdata = &data;
+
+    /* Spread the keys as the key fields of a real table would be. */
+    start = sal_time_usecs();
+    for (idx = 0; idx < count && SHR_SUCCESS(rv); idx++) {
+        key = idx * 2654435761U;
+        data = idx;
+        flds.count = 1;
+        rv = bcmimm_be_entry_insert(hdl, &key, &flds);
+    }
+    ins_usecs = SAL_USECS_SUB(sal_time_usecs(), start);
+
+    start = sal_time_usecs();
+    for (idx = 0; idx < count && SHR_SUCCESS(rv); idx++) {
+        key = idx * 2654435761U;
+        flds.count = 1;
+        rv = bcmimm_be_entry_lookup(hdl, &key, &flds);
+    }
+    lkp_usecs = SAL_USECS_SUB(sal_time_usecs(), start);
+
+    bcmimm_be_table_destroy(hdl);
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sIMM back-end test failed: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    cli_out("  %-8s %10"PRIu32" %12"PRIu64" %12"PRIu64"\n",
+            index ? "index" : "bins", count,
+            (uint64_t)ins_usecs * 1000 / count,
+            (uint64_t)lkp_usecs * 1000 / count);
+
+    return BCMA_CLI_CMD_OK;
+}
+
+/*
+ * Traverse <count> entries of a temporary IMM back-end table in key
+ * order. One third of the entries are deleted before the traverse, and
+ * the traverse must return the remaining keys in ascending order. A
+ * get-next from a key which is not in the table must return the lowest
+ * key above it.
+ */
+static int
+perf_imm_order(int unit, uint32_t rows, uint32_t count)
+{
+    bcmimm_be_tbl_hdl_t hdl;
+    bcmimm_be_fields_t flds;
+    uint32_t fid = 0;
+    uint64_t data;
+    uint32_t idx, key, next, seek, exp_next;
+    sal_usecs_t start;
+    uint32_t trv_usecs;
+    bool order_ok = true, found;
+    int rv;
+
+    rv = bcmimm_be_table_create(unit, BCMMGMT_IMM_BE_COMP_ID,
+                                BCMIMM_BE_TEMP_SUB_ID, sizeof(key),
+                                sizeof(data), rows, false, &hdl);
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sFailed to create test table: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    rv = bcmimm_be_table_order_set(hdl, true, NULL, NULL);
+    flds.fid = &fid;
+    flds.fdata = &data;
+
+    for (idx = 0; idx < count && SHR_SUCCESS(rv); idx++) {
+        key = idx * 2654435761U;
+        data = idx;
+        flds.count = 1;
+        rv = bcmimm_be_entry_insert(hdl, &key, &flds);
+    }
+    for (idx = 0; idx < count && SHR_SUCCESS(rv); idx += 3) {
+        key = idx * 2654435761U;
+        rv = bcmimm_be_entry_delete(hdl, &key);
+    }
+
+    /* Seek from a deleted key to the lowest remaining key above it. */
+    seek = 3 * 2654435761U;
+    exp_next = 0;
+    found = false;
+    for (idx = 0; idx < count; idx++) {
+        key = idx * 2654435761U;
+        if (idx % 3 != 0 && key > seek && (!found || key < exp_next)) {
+            exp_next = key;
+            found = true;
+        }
+    }
+
+    start = sal_time_usecs();
+    idx = 0;
+    if (SHR_SUCCESS(rv)) {
+        flds.count = 1;
+        rv = bcmimm_be_table_ctx_get_first(hdl, &key, &flds);
+        while (SHR_SUCCESS(rv)) {
+            idx++;
+            flds.count = 1;
+            rv = bcmimm_be_table_ctx_get_next(hdl, &key, &next, &flds);
+            if (SHR_SUCCESS(rv)) {
+                if (next <= key) {
+                    order_ok = false;
+                }
+                key = next;
+            }
+        }
+        if (rv == SHR_E_NOT_FOUND) {
+            rv = SHR_E_NONE;
+        }
+    }
+    trv_usecs = SAL_USECS_SUB(sal_time_usecs(), start);
+
+    if (SHR_SUCCESS(rv) && idx != count - (count + 2) / 3) {
+        order_ok = false;
+    }
+    if (SHR_SUCCESS(rv)) {
+        flds.count = 1;
+        rv = bcmimm_be_table_ctx_get_next(hdl, &seek, &next, &flds);
+        if (rv == SHR_E_NOT_FOUND && !found) {
+            rv = SHR_E_NONE;
+        } else if (SHR_SUCCESS(rv) && (!found || next != exp_next)) {
+            order_ok = false;
+        }
+    }
+
+    bcmimm_be_table_destroy(hdl);
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sIMM back-end ordered test failed: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+    if (!order_ok) {
+        cli_out("%sIMM back-end ordered traverse returned wrong keys.\n",
+                BCMA_CLI_CONFIG_ERROR_STR);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    cli_out("  %-8s %10"PRIu32" %12s %12s %12"PRIu64"\n",
+            "ordered", idx, "-", "-",
+            idx ? (uint64_t)trv_usecs * 1000 / idx : 0);
+
+    return BCMA_CLI_CMD_OK;
+}
+
+/*
+ * Compare the IMM back-end hash bins with the entry index and check the
+ * key ordered traverse.
+ */
+static int
+perf_imm(int unit, uint32_t count, int rows)
+{
+    int rv;
+
+    cli_out("IMM back-end, %d rows:\n", rows);
+    cli_out("  %-8s %10s %12s %12s %12s\n",
+            "Mode", "Count", "nsec/insert", "nsec/lookup", "nsec/next");
+    rv = perf_imm_run(unit, rows, count, false);
+    if (rv == BCMA_CLI_CMD_OK) {
+        rv = perf_imm_run(unit, rows, count, true);
+    }
+    if (rv == BCMA_CLI_CMD_OK) {
+        rv = perf_imm_order(unit, rows, count);
+    }
+
+    return rv;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+bcma_bcmimmcmd_immperf(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    bcma_cli_parse_table_t pt;
+    int count = BCMA_BCMIMM_CONFIG_DEFAULT_PERF_COUNT;
+    int rows = BCMA_BCMIMM_CONFIG_DEFAULT_PERF_ROWS;
+
+    if (cli == NULL || args == NULL) {
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "count", "int", &count, NULL);
+    bcma_cli_parse_table_add(&pt, "rows", "int", &rows, NULL);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0 ||
+        BCMA_CLI_ARG_CNT(args) > 0 || count <= 0 || rows <= 0) {
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    return perf_imm(cli->cur_unit, count, rows);
+}
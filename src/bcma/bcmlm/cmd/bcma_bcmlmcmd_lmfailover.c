@@ -0,0 +1,356 @@
+/*! \file bcma_bcmlmcmd_lmfailover.c
+ *
+ * CLI 'lmfailover' command for Link Manager fast failover.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <bsl/bsl.h>
+
+#include <sal/sal_libc.h>
+
+#include <shr/shr_error.h>
+
+#include <bcmdrd/bcmdrd_dev.h>
+#include <bcmevm/bcmevm_api.h>
+#include <bcmlm/bcmlm_failover.h>
+#include <bcmtrunk/bcmtrunk_prune.h>
+
+#include <bcma/bcmlm/bcma_bcmlmcmd_lmfailover.h>
+
+/* Number of trunk members used by the test. */
+#define FF_TEST_MEMBERS 5
+
+/*******************************************************************************
+ * Private functions
+ */
+
+static int
+lmfailover_stats(bcma_cli_t *cli, int unit, bool clear)
+{
+    int rv;
+    bcmlm_failover_stats_t stats;
+
+    rv = bcmlm_failover_stats_get(unit, &stats);
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sUnit %d: failed to get fast failover stats: %s\n",
+                BCMA_CLI_CONFIG_ERROR_STR, unit, shr_errmsg(rv));
+        return BCMA_CLI_CMD_FAIL;
+    }
+    cli_out("Link down events: %"PRIu32" (%"PRIu32" failed)\n",
+            stats.count, stats.errors);
+    cli_out("Latency (usecs):  last %"PRIu32", max %"PRIu32", avg %"PRIu64"\n",
+            stats.last_usecs, stats.max_usecs,
+            stats.count ? stats.total_usecs / stats.count : 0);
+
+    if (clear) {
+        rv = bcmlm_failover_stats_clear(unit);
+        if (SHR_FAILURE(rv)) {
+            cli_out("%sUnit %d: failed to clear fast failover stats: %s\n",
+                    BCMA_CLI_CONFIG_ERROR_STR, unit, shr_errmsg(rv));
+            return BCMA_CLI_CMD_FAIL;
+        }
+    }
+
+    return BCMA_CLI_CMD_OK;
+}
+
+/*
+ * Publish a fast failover event for a port and wait for the subscribers
+ * to handle it.
+ */
+static int
+ff_test_event(int unit, uint32_t ev_id, shr_port_t port, uint32_t seq)
+{
+    return bcmevm_publish_event_id_notify(unit, ev_id,
+                                          BCMLM_FAILOVER_EV_DATA(port, seq));
+}
+
+/*
+ * Check the pruned member list of the test group against the expected
+ * set of ports which are down.
+ */
+static int
+ff_test_check(bcma_cli_t *cli, int unit, const char *step,
+              const uint8_t *modport, uint32_t down)
+{
+    uint8_t modid[FF_TEST_MEMBERS];
+    uint8_t hw_modid[FF_TEST_MEMBERS];
+    uint8_t hw_modport[FF_TEST_MEMBERS];
+    uint16_t cnt, exp_cnt, px, hx;
+    int fail = 0;
+
+    sal_memset(modid, 0, sizeof(modid));
+    cnt = bcmtrunk_prune_members_get(unit, FF_TEST_MEMBERS, modid, modport,
+                                     hw_modid, hw_modport);
+
+    exp_cnt = 0;
+    for (px = 0; px < FF_TEST_MEMBERS; px++) {
+        if (!(down & (1 << px))) {
+            exp_cnt++;
+        }
+    }
+    if (exp_cnt == 0) {
+        /* Nothing to prune to, the list must be left as is. */
+        exp_cnt = FF_TEST_MEMBERS;
+        down = 0;
+    }
+
+    if (cnt != exp_cnt) {
+        fail = 1;
+    }
+    for (px = 0; !fail && px < FF_TEST_MEMBERS; px++) {
+        if (down & (1 << px)) {
+            /* A member which is down must not be written. */
+            for (hx = 0; hx < cnt; hx++) {
+                if (hw_modport[hx] == modport[px]) {
+                    fail = 1;
+                }
+            }
+        } else if (px < cnt) {
+            /* A member which is up must keep its position. */
+            if (hw_modport[px] != modport[px]) {
+                fail = 1;
+            }
+        } else {
+            /* A member beyond the new size must have filled a hole. */
+            for (hx = 0; hx < cnt; hx++) {
+                if (hw_modport[hx] == modport[px]) {
+                    break;
+                }
+            }
+            if (hx == cnt) {
+                fail = 1;
+            }
+        }
+    }
+
+    cli_out("  %-28s", step);
+    for (hx = 0; hx < cnt; hx++) {
+        cli_out(" %3d", hw_modport[hx]);
+    }
+    cli_out("%*s %s\n", 4 * (FF_TEST_MEMBERS - cnt), "",
+            fail ? "FAIL" : "ok");
+
+    return fail;
+}
+
+static int
+lmfailover_test(bcma_cli_t *cli, int unit)
+{
+    int rv;
+    uint32_t down_ev, up_ev;
+    uint8_t modport[FF_TEST_MEMBERS];
+    bcmdrd_pbmp_t valid, logic;
+    uint32_t seq = 1;
+    int port, px, fail = 0;
+
+    /*
+     * Use ports the device does not have, so no trunk group of the
+     * application is rewritten by the test.
+     */
+    BCMDRD_PBMP_CLEAR(valid);
+    BCMDRD_PBMP_CLEAR(logic);
+    (void)bcmdrd_dev_valid_ports_get(unit, &valid);
+    (void)bcmdrd_dev_logic_pbmp(unit, &logic);
+    px = 0;
+    for (port = 255; port >= 0 && px < FF_TEST_MEMBERS; port--) {
+        if (port >= BCMDRD_CONFIG_MAX_PORTS ||
+            BCMDRD_PBMP_MEMBER(valid, port) ||
+            BCMDRD_PBMP_MEMBER(logic, port)) {
+            continue;
+        }
+        modport[px++] = port;
+    }
+    if (px < FF_TEST_MEMBERS) {
+        cli_out("%sUnit %d: not enough unused ports for the test\n",
+                BCMA_CLI_CONFIG_ERROR_STR, unit);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    rv = bcmevm_event_id_get(unit, BCMLM_EV_LINK_DOWN_FAST, &down_ev);
+    if (SHR_SUCCESS(rv)) {
+        rv = bcmevm_event_id_get(unit, BCMLM_EV_LINK_UP_FAST, &up_ev);
+    }
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sUnit %d: failed to get fast failover events: %s\n",
+                BCMA_CLI_CONFIG_ERROR_STR, unit, shr_errmsg(rv));
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    /* Start from all ports up, whatever an earlier run left behind. */
+    for (px = 0; px < FF_TEST_MEMBERS; px++) {
+        (void)ff_test_event(unit, down_ev, modport[px], seq);
+        (void)ff_test_event(unit, up_ev, modport[px], seq + 1);
+    }
+    seq += 2;
+
+    cli_out("Trunk members written to hardware:\n");
+    fail |= ff_test_check(cli, unit, "all up", modport, 0);
+
+    /* Holes at the head, in the middle and at the tail. */
+    (void)ff_test_event(unit, down_ev, modport[0], seq++);
+    fail |= ff_test_check(cli, unit, "head down", modport, 0x1);
+    (void)ff_test_event(unit, down_ev, modport[2], seq++);
+    (void)ff_test_event(unit, down_ev, modport[4], seq++);
+    fail |= ff_test_check(cli, unit, "head, middle, tail down",
+                          modport, 0x15);
+
+    /* A link up overtaken by a later link down is dropped. */
+    (void)ff_test_event(unit, up_ev, modport[2], seq - 2);
+    fail |= ff_test_check(cli, unit, "stale up ignored", modport, 0x15);
+    (void)ff_test_event(unit, up_ev, modport[2], seq++);
+    fail |= ff_test_check(cli, unit, "middle up", modport, 0x11);
+
+    /* The list is left as is if no member is up. */
+    for (px = 0; px < FF_TEST_MEMBERS; px++) {
+        (void)ff_test_event(unit, down_ev, modport[px], seq++);
+    }
+    fail |= ff_test_check(cli, unit, "all down", modport, 0x1f);
+
+    for (px = 0; px < FF_TEST_MEMBERS; px++) {
+        (void)ff_test_event(unit, up_ev, modport[px], seq++);
+    }
+    fail |= ff_test_check(cli, unit, "all up again", modport, 0);
+
+    if (fail) {
+        cli_out("%sFast failover trunk pruning test failed.\n",
+                BCMA_CLI_CONFIG_ERROR_STR);
+        return BCMA_CLI_CMD_FAIL;
+    }
+    cli_out("Fast failover trunk pruning test passed.\n");
+
+    return BCMA_CLI_CMD_OK;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+bcma_bcmlmcmd_lmfailover(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    int rv;
+    int unit;
+    const char *arg;
+
+    if (cli == NULL || args == NULL) {
+        return BCMA_CLI_CMD_FAIL;
+    }
+    unit = cli->cmd_unit;
+    if (!bcmdrd_dev_exists(unit)) {
+        return BCMA_CLI_CMD_BAD_ARG;
+    }
+
+    arg = BCMA_CLI_ARG_GET(args);
+    if (arg == NULL) {
+        return lmfailover_stats(cli, unit, false);
+    }
+    if (sal_strcasecmp(arg, "enable") == 0 ||
+        sal_strcasecmp(arg, "disable") == 0) {
+        rv = bcmlm_failover_enable(unit, sal_strcasecmp(arg, "enable") == 0);
+        if (SHR_FAILURE(rv)) {
+            cli_out("%sUnit %d: failed to %s fast failover: %s\n",
+                    BCMA_CLI_CONFIG_ERROR_STR, unit, arg, shr_errmsg(rv));
+            return BCMA_CLI_CMD_FAIL;
+        }
+        return BCMA_CLI_CMD_OK;
+    }
+    if (sal_strcasecmp(arg, "stats") == 0) {
+        arg = BCMA_CLI_ARG_GET(args);
+        if (arg != NULL && sal_strcasecmp(arg, "clear") != 0) {
+            return BCMA_CLI_CMD_USAGE;
+        }
+        return lmfailover_stats(cli, unit, arg != NULL);
+    }
+    if (sal_strcasecmp(arg, "test") == 0) {
+        return lmfailover_test(cli, unit);
+    }
+
+    return BCMA_CLI_CMD_USAGE;
+}
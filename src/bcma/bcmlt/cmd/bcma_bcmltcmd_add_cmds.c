@@ -94,6 +94,9 @@
 #include <bcma/bcmlt/bcma_bcmltcmd_lt.h>
 #include <bcma/bcmlt/bcma_bcmltcmd_pt.h>
 #include <bcma/bcmlt/bcma_bcmltcmd_ltcapture.h>
+#include <bcma/bcmlt/bcma_bcmltcmd_ltperf.h>
+#include <bcma/bcmlt/bcma_bcmltcmd_ltstats.h>
+#include <bcma/bcmlt/bcma_bcmltcmd_ltchgfeed.h>
 #include <bcma/bcmlt/bcma_bcmltcmd.h>
 
 static bcma_cli_command_t cmd_lt = {
@@ -120,12 +123,39 @@ static bcma_cli_command_t cmd_ltcapture = {
     { BCMA_BCMLTCMD_LTCAPTURE_HELP }
 };
 
+static bcma_cli_command_t cmd_ltperf = {
+    "LtPERF",
+    bcma_bcmltcmd_ltperf,
+    BCMA_BCMLTCMD_LTPERF_DESC,
+    BCMA_BCMLTCMD_LTPERF_SYNOP,
+    { BCMA_BCMLTCMD_LTPERF_HELP }
+};
+
+static bcma_cli_command_t cmd_ltstats = {
+    "LtSTATs",
+    bcma_bcmltcmd_ltstats,
+    BCMA_BCMLTCMD_LTSTATS_DESC,
+    BCMA_BCMLTCMD_LTSTATS_SYNOP,
+    { BCMA_BCMLTCMD_LTSTATS_HELP }
+};
+
+static bcma_cli_command_t cmd_ltchgfeed = {
+    "LtCHGFeed",
+    bcma_bcmltcmd_ltchgfeed,
+    BCMA_BCMLTCMD_LTCHGFEED_DESC,
+    BCMA_BCMLTCMD_LTCHGFEED_SYNOP,
+    { BCMA_BCMLTCMD_LTCHGFEED_HELP }
+};
+
 int
 bcma_bcmltcmd_add_cmds(bcma_cli_t *cli)
 {
     bcma_cli_add_command(cli, &cmd_lt, 0);
     bcma_cli_add_command(cli, &cmd_pt, 0);
     bcma_cli_add_command(cli, &cmd_ltcapture, 0);
+    bcma_cli_add_command(cli, &cmd_ltperf, 0);
+    bcma_cli_add_command(cli, &cmd_ltstats, 0);
+    bcma_cli_add_command(cli, &cmd_ltchgfeed, 0);
 
     return 0;
 }
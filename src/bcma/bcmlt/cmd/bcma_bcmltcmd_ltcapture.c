@@ -133,6 +133,12 @@ typedef struct replay_data_s {
     /*! The replay will take effect if 'submit' is set to true. */
     bool submit;
 
+    /*!
+     * The replay will submit the operations at the maximal rate and report
+     * the performance if 'maxrate' is set to true.
+     */
+    bool maxrate;
+
 } replay_data_t;
 
 /*******************************************************************************
@@ -513,13 +519,28 @@ capture_stop(void)
     return rv;
 }
 
+static void
+replay_stats_show(bcmlt_replay_stats_t *stats)
+{
+    cli_out("Replayed %"PRIu32" operations (%"PRIu32" entries, "
+            "%"PRIu32" failed) in %"PRIu64" usecs: %"PRIu32" ops/sec\n",
+            stats->num_ops, stats->num_entries, stats->num_failed,
+            stats->elapsed_usecs, stats->ops_per_sec);
+    cli_out("Latency (usecs): min=%"PRIu32" avg=%"PRIu32" p50=%"PRIu32
+            " p90=%"PRIu32" p99=%"PRIu32" max=%"PRIu32"\n",
+            stats->lat_min, stats->lat_avg, stats->lat_p50,
+            stats->lat_p90, stats->lat_p99, stats->lat_max);
+}
+
 static int
-capture_replay(char *logfile, bool timing, bool verbose, bool submit)
+capture_replay(char *logfile, bool timing, bool verbose, bool submit,
+               bool maxrate)
 {
     int rv = SHR_E_NONE, bcmlt_rv;
     bcma_io_file_handle_t fh;
     bcmlt_replay_cb_t replay_cb, *cb = &replay_cb;
     replay_action_f *replay_act = NULL;
+    bcmlt_replay_stats_t stats;
 
     /* Check whether capture in in progress. */
     if (lcap_fh != NULL) {
@@ -538,13 +559,20 @@ capture_replay(char *logfile, bool timing, bool verbose, bool submit)
         replay_act = capture_action;
     }
 
-    cli_out("Replay options: logfile=%s timing=%d verbose=%d submit=%d\n",
-            logfile, timing, verbose, submit);
+    cli_out("Replay options: logfile=%s timing=%d verbose=%d submit=%d "
+            "maxrate=%d\n", logfile, timing, verbose, submit, maxrate);
 
     cb->fd = fh;
     cb->read = capture_read;
 
-    bcmlt_rv = bcmlt_capture_replay(timing, replay_act, !submit, cb);
+    if (maxrate) {
+        bcmlt_rv = bcmlt_capture_replay_max_rate(replay_act, cb, &stats);
+        if (SHR_SUCCESS(bcmlt_rv)) {
+            replay_stats_show(&stats);
+        }
+    } else {
+        bcmlt_rv = bcmlt_capture_replay(timing, replay_act, !submit, cb);
+    }
     if (SHR_FAILURE(bcmlt_rv)) {
         LOG_ERROR(BSL_LS_APPL_SHELL,
                   (BSL_META("Failed to replay the capture log file %s: "
@@ -564,7 +592,8 @@ capture_replay_ctrlc(void *data)
     int rv;
     replay_data_t *rp = (replay_data_t *)data;
 
-    rv = capture_replay(rp->file, rp->timing, rp->verbose, rp->submit);
+    rv = capture_replay(rp->file, rp->timing, rp->verbose, rp->submit,
+                        rp->maxrate);
     if (SHR_FAILURE(rv)) {
         if (rv == SHR_E_BUSY) {
             cli_out("%sCapture must be stopped before replay.\n",
@@ -633,7 +662,7 @@ ltcapture_replay(bcma_cli_t *cli, bcma_cli_args_t *args)
     int rv = BCMA_CLI_CMD_OK;
     bcma_cli_parse_table_t pt;
     char *logfile = BCMA_BCMLT_CONFIG_DEFAULT_CAPTURE_FILE;
-    int timing = 0, verbose = 1, submit = 0;
+    int timing = 0, verbose = 1, submit = 0, maxrate = 0;
     replay_data_t replay_data, *rp = &replay_data;
 
     if (lcap_fh != NULL) {
@@ -647,6 +676,7 @@ ltcapture_replay(bcma_cli_t *cli, bcma_cli_args_t *args)
     bcma_cli_parse_table_add(&pt, "timing", "bool", &timing, NULL);
     bcma_cli_parse_table_add(&pt, "verbose", "bool", &verbose, NULL);
     bcma_cli_parse_table_add(&pt, "submit", "bool", &submit, NULL);
+    bcma_cli_parse_table_add(&pt, "maxrate", "bool", &maxrate, NULL);
 
     if (bcma_cli_parse_table_do_args(&pt, args) < 0 ||
         sal_strlen(logfile) == 0) {
@@ -659,6 +689,11 @@ ltcapture_replay(bcma_cli_t *cli, bcma_cli_args_t *args)
     rp->timing = timing;
     rp->verbose = verbose;
     rp->submit = submit;
+    rp->maxrate = maxrate;
+    if (maxrate) {
+        /* Keep the per-operation output out of the measurement. */
+        rp->verbose = false;
+    }
 
     rv = bcma_cli_ctrlc_exec(cli, capture_replay_ctrlc, rp);
     if (rv == BCMA_CLI_CMD_INTR) {
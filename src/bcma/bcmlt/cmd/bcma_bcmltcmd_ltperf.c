@@ -0,0 +1,363 @@
+/*! \file bcma_bcmltcmd_ltperf.c
+ *
+ * Logical table performance command in CLI.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+#include <bsl/bsl.h>
+
+#include <sal/sal_libc.h>
+#include <sal/sal_time.h>
+
+#include <shr/shr_debug.h>
+
+#include <bcmlt/bcmlt.h>
+#include <bcmtrm/trm_api.h>
+#include <bcmltm/bcmltm_md_internal.h>
+
+#include <bcma/cli/bcma_cli_parse.h>
+
+#include <bcma/bcmlt/bcma_bcmltcmd_ltperf.h>
+
+#include "bcmltcmd_internal.h"
+
+/* Default number of operations per test run. */
+#ifndef BCMA_BCMLT_CONFIG_DEFAULT_PERF_COUNT
+#define BCMA_BCMLT_CONFIG_DEFAULT_PERF_COUNT 10000
+#endif
+
+/* Default number of nodes in the interpreter test tree. */
+#ifndef BCMA_BCMLT_CONFIG_DEFAULT_PERF_INTERP_NODES
+#define BCMA_BCMLT_CONFIG_DEFAULT_PERF_INTERP_NODES 32
+#endif
+
+/* Processing modes of synchronous entries. */
+typedef enum perf_mode_e {
+    PERF_MODE_QUEUED = 0,
+    PERF_MODE_INLINE,
+    PERF_MODE_BOTH
+} perf_mode_t;
+
+static bcma_cli_parse_enum_t perf_mode_enum[] = {
+    { "queued", PERF_MODE_QUEUED },
+    { "inline", PERF_MODE_INLINE },
+    { "both",   PERF_MODE_BOTH   },
+    { NULL,     0                }
+};
+
+/*
+ * Cookie for perf_run_ctrlc() that contains the parameters
+ * used in the test run.
+ */
+typedef struct perf_data_s {
+
+    /*! Entry information of the table operation. */
+    bcma_bcmlt_entry_info_t *ei;
+
+    /*! Table operation code. */
+    int opc;
+
+    /*! Number of operations to commit. */
+    uint32_t count;
+
+    /*! Processing mode of synchronous entries. */
+    bool inline_sync;
+
+} perf_data_t;
+
+/*******************************************************************************
+ * Private functions
+ */
+
+/*
+ * Get table operation code from CLI input.
+ */
+static int
+perf_opcode_parse(const char *str, bool logical)
+{
+    const bcma_cli_parse_enum_t *e;
+
+    if (logical) {
+        e = bcmltcmd_lt_opcodes_get();
+    } else {
+        e = bcmltcmd_pt_opcodes_get();
+    }
+
+    if (str == NULL) {
+        return -1;
+    }
+
+    while (e->name != NULL) {
+        if (sal_strcasecmp(e->name, str) == 0) {
+            return e->val;
+        }
+        e++;
+    }
+
+    return -1;
+}
+
+static int
+perf_run_ctrlc(void *data)
+{
+    int rv;
+    uint32_t idx, fail_cnt = 0;
+    sal_usecs_t start;
+    int usecs;
+    uint64_t rate;
+    perf_data_t *pd = (perf_data_t *)data;
+    bcma_bcmlt_entry_info_t *ei = pd->ei;
+    bcmtrm_sync_stats_t stats;
+
+    rv = bcmtrm_inline_sync_set(ei->unit, pd->inline_sync);
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sFailed to set processing mode: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+    bcmtrm_sync_stats_get(ei->unit, true, &stats);
+
+    start = sal_time_usecs();
+    for (idx = 0; idx < pd->count; idx++) {
+        if (ei->logical) {
+            rv = bcmlt_entry_commit(ei->eh, pd->opc, BCMLT_PRIORITY_NORMAL);
+        } else {
+            rv = bcmlt_pt_entry_commit(ei->eh, pd->opc, BCMLT_PRIORITY_NORMAL);
+        }
+        if (SHR_FAILURE(rv)) {
+            fail_cnt++;
+        }
+    }
+    usecs = SAL_USECS_SUB(sal_time_usecs(), start);
+    if (usecs <= 0) {
+        usecs = 1;
+    }
+    rate = ((uint64_t)pd->count * 1000000) / usecs;
+
+    bcmtrm_sync_stats_get(ei->unit, true, &stats);
+
+    cli_out("  %-8s %10"PRIu32" %12d %10"PRIu64" %10"PRIu64" %10"PRIu64
+            " %8"PRIu32"\n",
+            pd->inline_sync ? "inline" : "queued", pd->count, usecs, rate,
+            stats.inline_cnt, stats.queued_cnt, fail_cnt);
+
+    return BCMA_CLI_CMD_OK;
+}
+
+/*
+ * Compare the LTM tree walk with the compiled operation program.
+ */
+static int
+perf_interp(int unit, uint32_t count, bcma_cli_args_t *args)
+{
+    const char *arg;
+    int nodes = BCMA_BCMLT_CONFIG_DEFAULT_PERF_INTERP_NODES;
+    uint32_t tree_usecs, prog_usecs;
+    int rv;
+
+    if ((arg = BCMA_CLI_ARG_GET(args)) != NULL) {
+        if (bcma_cli_parse_int(arg, &nodes) < 0 || nodes <= 0) {
+            return BCMA_CLI_CMD_USAGE;
+        }
+    }
+
+    rv = bcmltm_md_op_prog_bench(unit, nodes, count,
+                                 &tree_usecs, &prog_usecs);
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sInterpreter test failed: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    cli_out("Interpreter, %d nodes:\n", nodes);
+    cli_out("  %-8s %10s %12s %12s\n",
+            "Mode", "Count", "Time(usec)", "nsec/exec");
+    cli_out("  %-8s %10"PRIu32" %12"PRIu32" %12"PRIu64"\n",
+            "tree", count, tree_usecs,
+            (uint64_t)tree_usecs * 1000 / count);
+    cli_out("  %-8s %10"PRIu32" %12"PRIu32" %12"PRIu64"\n",
+            "program", count, prog_usecs,
+            (uint64_t)prog_usecs * 1000 / count);
+
+    return BCMA_CLI_CMD_OK;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+bcma_bcmltcmd_ltperf(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    int rv = BCMA_CLI_CMD_OK;
+    bcma_cli_parse_table_t pt;
+    int count = BCMA_BCMLT_CONFIG_DEFAULT_PERF_COUNT;
+    int mode = PERF_MODE_BOTH;
+    const char *arg, *table_name;
+    bool logical, orig_mode;
+    int unit = cli->cur_unit;
+    perf_data_t perf_data, *pd = &perf_data;
+
+    if (cli == NULL || args == NULL) {
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "count", "int", &count, NULL);
+    bcma_cli_parse_table_add(&pt, "mode", "enum", &mode, perf_mode_enum);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0 || count <= 0) {
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    if ((arg = BCMA_CLI_ARG_GET(args)) == NULL) {
+        return BCMA_CLI_CMD_USAGE;
+    }
+    if (sal_strcasecmp(arg, "interp") == 0) {
+        return perf_interp(unit, count, args);
+    }
+    if (sal_strcasecmp(arg, "lt") == 0) {
+        logical = true;
+    } else if (sal_strcasecmp(arg, "pt") == 0) {
+        logical = false;
+    } else {
+        return BCMA_CLI_CMD_USAGE;
+    }
+
+    if ((table_name = BCMA_CLI_ARG_GET(args)) == NULL) {
+        return BCMA_CLI_CMD_USAGE;
+    }
+
+    sal_memset(pd, 0, sizeof(*pd));
+    pd->count = count;
+    pd->opc = perf_opcode_parse(BCMA_CLI_ARG_GET(args), logical);
+    if (pd->opc < 0) {
+        return BCMA_CLI_CMD_USAGE;
+    }
+
+    if (SHR_FAILURE(bcmtrm_inline_sync_get(unit, &orig_mode))) {
+        cli_out("%sTransaction manager is not initialized.\n",
+                BCMA_CLI_CONFIG_ERROR_STR);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    pd->ei = bcma_bcmlt_entry_info_create(unit, table_name, logical, 0,
+                                          NULL, 0);
+    if (pd->ei == NULL) {
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    if (bcmltcmd_parse_fields(args, pd->ei) < 0) {
+        bcma_bcmlt_entry_info_destroy(pd->ei);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    cli_out("Table %s:\n", pd->ei->name);
+    cli_out("  %-8s %10s %12s %10s %10s %10s %8s\n",
+            "Mode", "Count", "Time(usec)", "Ops/sec",
+            "Inline", "Queued", "Failed");
+
+    if (mode == PERF_MODE_QUEUED || mode == PERF_MODE_BOTH) {
+        pd->inline_sync = false;
+        rv = bcma_cli_ctrlc_exec(cli, perf_run_ctrlc, pd);
+    }
+    if (rv == BCMA_CLI_CMD_OK &&
+        (mode == PERF_MODE_INLINE || mode == PERF_MODE_BOTH)) {
+        pd->inline_sync = true;
+        rv = bcma_cli_ctrlc_exec(cli, perf_run_ctrlc, pd);
+    }
+    if (rv == BCMA_CLI_CMD_INTR) {
+        cli_out("%sTest aborted.\n", BCMA_CLI_CONFIG_ERROR_STR);
+    }
+
+    bcmtrm_inline_sync_set(unit, orig_mode);
+    bcma_bcmlt_entry_info_destroy(pd->ei);
+
+    return rv;
+}
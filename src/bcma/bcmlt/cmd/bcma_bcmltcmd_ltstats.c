@@ -0,0 +1,295 @@
+/*! \file bcma_bcmltcmd_ltstats.c
+ *
+ * CLI 'ltstats' command to show the latency statistics of table operations.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <sal/sal_libc.h>
+
+#include <shr/shr_debug.h>
+
+#include <bcmlrd/bcmlrd_table.h>
+#include <bcmltm/bcmltm_stats_internal.h>
+
+#include <bcma/bcmlt/bcma_bcmltcmd_ltstats.h>
+
+/* Names of the LT opcodes, indexed by opcode. */
+static const char *lt_opcode_names[BCMLT_OPCODE_NUM] = {
+    "nop", "insert", "lookup", "delete", "update", "traverse"
+};
+
+/* Names of the PT opcodes, indexed by opcode. */
+static const char *pt_opcode_names[BCMLT_PT_OPCODE_NUM] = {
+    "nop", "fifo_pop", "fifo_push", "set", "modify",
+    "get", "clear", "insert", "delete", "lookup"
+};
+
+/* Names of the processing stages, indexed by stage. */
+static const char *stage_names[BCMLTM_STATS_STAGE_COUNT] = {
+    "field adaptation", "execution engine", "table commit", "ptm commit"
+};
+
+/*******************************************************************************
+ * Private functions
+ */
+
+static const char *
+ltstats_table_name(uint32_t ltid)
+{
+    const bcmlrd_table_rep_t *tbl;
+
+    tbl = bcmlrd_table_get(ltid);
+    if (tbl == NULL || tbl->name == NULL) {
+        return "UNKNOWN";
+    }
+
+    return tbl->name;
+}
+
+static void
+ltstats_header_show(const char *title)
+{
+    cli_out("%-40s %10s %8s %8s %8s %8s %8s\n",
+            title, "Count", "Avg", "P50", "P90", "P99", "Max");
+}
+
+static void
+ltstats_lat_show(const char *name, const char *op,
+                 const bcmltm_stats_lat_t *lat)
+{
+    char label[64];
+
+    if (op != NULL) {
+        sal_snprintf(label, sizeof(label), "%s.%s", name, op);
+    } else {
+        sal_snprintf(label, sizeof(label), "%s", name);
+    }
+
+    cli_out("%-40s %10"PRIu32" %8"PRIu64" %8"PRIu32" %8"PRIu32
+            " %8"PRIu32" %8"PRIu32"\n",
+            label, lat->count, lat->sum / lat->count,
+            bcmltm_stats_lat_percentile(lat, 50),
+            bcmltm_stats_lat_percentile(lat, 90),
+            bcmltm_stats_lat_percentile(lat, 99),
+            lat->max);
+}
+
+static void
+ltstats_histogram_show(const char *name, const char *op,
+                       const bcmltm_stats_lat_t *lat)
+{
+    uint32_t bucket, lo, hi;
+
+    cli_out("\n%s.%s latency histogram (usecs):\n", name, op);
+    for (bucket = 0; bucket < BCMLTM_STATS_LAT_BUCKETS; bucket++) {
+        if (lat->bucket[bucket] == 0) {
+            continue;
+        }
+        lo = bcmltm_stats_lat_bucket_min(bucket);
+        if (bucket == BCMLTM_STATS_LAT_BUCKETS - 1) {
+            hi = 0xffffffff;
+        } else {
+            hi = bcmltm_stats_lat_bucket_min(bucket + 1) - 1;
+        }
+        cli_out("  %10"PRIu32" - %-10"PRIu32" %10"PRIu32"\n",
+                lo, hi, lat->bucket[bucket]);
+    }
+}
+
+static int
+ltstats_show(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    int unit = cli->cmd_unit;
+    const char *table = BCMA_CLI_ARG_GET(args);
+    bcmltm_stats_lat_t lat;
+    uint32_t ltid, op, stage;
+    bool found = false;
+    int rv;
+
+    if (!bcmltm_stats_lat_enabled(unit)) {
+        cli_out("Latency recording is disabled.\n");
+    }
+
+    ltstats_header_show("Stage");
+    for (stage = 0; stage < BCMLTM_STATS_STAGE_COUNT; stage++) {
+        rv = bcmltm_stats_lat_stage_get(unit, stage, &lat);
+        if (SHR_FAILURE(rv)) {
+            cli_out("%sLatency statistics not available: %s (%d).\n",
+                    BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+            return BCMA_CLI_CMD_FAIL;
+        }
+        if (lat.count > 0) {
+            ltstats_lat_show(stage_names[stage], NULL, &lat);
+        }
+    }
+
+    cli_out("\n");
+    ltstats_header_show("Physical table operation");
+    for (op = 0; op < BCMLT_PT_OPCODE_NUM; op++) {
+        if (SHR_SUCCESS(bcmltm_stats_lat_pt_get(unit, op, &lat)) &&
+            lat.count > 0) {
+            ltstats_lat_show("*", pt_opcode_names[op], &lat);
+        }
+    }
+
+    cli_out("\n");
+    ltstats_header_show("Logical table operation");
+    for (ltid = 0; ltid < BCMLTD_TABLE_COUNT; ltid++) {
+        if (table != NULL &&
+            sal_strcasecmp(table, ltstats_table_name(ltid)) != 0) {
+            continue;
+        }
+        found = true;
+        for (op = 0; op < BCMLT_OPCODE_NUM; op++) {
+            if (SHR_SUCCESS(bcmltm_stats_lat_lt_get(unit, ltid, op, &lat)) &&
+                lat.count > 0) {
+                ltstats_lat_show(ltstats_table_name(ltid),
+                                 lt_opcode_names[op], &lat);
+            }
+        }
+    }
+
+    if (table == NULL) {
+        return BCMA_CLI_CMD_OK;
+    }
+    if (!found) {
+        cli_out("%sUnknown logical table: %s\n",
+                BCMA_CLI_CONFIG_ERROR_STR, table);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    for (ltid = 0; ltid < BCMLTD_TABLE_COUNT; ltid++) {
+        if (sal_strcasecmp(table, ltstats_table_name(ltid)) != 0) {
+            continue;
+        }
+        for (op = 0; op < BCMLT_OPCODE_NUM; op++) {
+            if (SHR_SUCCESS(bcmltm_stats_lat_lt_get(unit, ltid, op, &lat)) &&
+                lat.count > 0) {
+                ltstats_histogram_show(ltstats_table_name(ltid),
+                                       lt_opcode_names[op], &lat);
+            }
+        }
+    }
+
+    return BCMA_CLI_CMD_OK;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+bcma_bcmltcmd_ltstats(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    const char *arg;
+
+    if (cli == NULL || args == NULL) {
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    if (cli->cmd_unit < 0) {
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    arg = BCMA_CLI_ARG_GET(args);
+    if (arg == NULL || sal_strcasecmp(arg, "show") == 0) {
+        return ltstats_show(cli, args);
+    } else if (sal_strcasecmp(arg, "clear") == 0) {
+        bcmltm_stats_lat_clear(cli->cmd_unit);
+        return BCMA_CLI_CMD_OK;
+    } else if (sal_strcasecmp(arg, "enable") == 0) {
+        bcmltm_stats_lat_enable_set(cli->cmd_unit, true);
+        return BCMA_CLI_CMD_OK;
+    } else if (sal_strcasecmp(arg, "disable") == 0) {
+        bcmltm_stats_lat_enable_set(cli->cmd_unit, false);
+        return BCMA_CLI_CMD_OK;
+    }
+
+    return BCMA_CLI_CMD_USAGE;
+}
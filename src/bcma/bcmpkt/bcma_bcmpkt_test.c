@@ -360,6 +360,78 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+/* Packets per burst in the partial burst check, more than a TX ring holds. */
+#define TX_BURST_CHECK_PKTS     4096
+
+/*
+ * Send one burst of copies of a packet and check that exactly the first
+ * num_sent packets were consumed. Returns SHR_E_FAIL from the driver
+ * (ring full) through rv_burst, other errors as the function result.
+ */
+static int
+packet_burst_check(int unit, int netif_id, bcmpkt_packet_t *packet, int num,
+                   int *rv_burst, int *num_sent)
+{
+    bcmpkt_packet_t **pkts = NULL;
+    int buf_unit = unit;
+    bcmpkt_dev_drv_types_t dev_drv_type;
+    int i;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_IF_ERR_EXIT(bcmpkt_dev_drv_type_get(unit, &dev_drv_type));
+    if (dev_drv_type == BCMPKT_DEV_DRV_T_KNET) {
+        /* KNET mode, use shared buff pool. */
+        buf_unit = BCMPKT_BPOOL_SHARED_ID;
+    }
+
+    SHR_ALLOC(pkts, sizeof(*pkts) * num, "bcmaBcmpktTestBurst");
+    SHR_NULL_CHECK(pkts, SHR_E_MEMORY);
+    sal_memset(pkts, 0, sizeof(*pkts) * num);
+    for (i = 0; i < num; i++) {
+        SHR_IF_ERR_EXIT(bcmpkt_packet_clone(unit, packet, &pkts[i]));
+        if (pkts[i]->data_buf) {
+            bcmpkt_data_buf_free(pkts[i]->unit, pkts[i]->data_buf);
+            pkts[i]->data_buf = NULL;
+        }
+        SHR_IF_ERR_EXIT
+            (bcmpkt_data_buf_copy(buf_unit, packet->data_buf,
+                                  &pkts[i]->data_buf));
+        pkts[i]->unit = buf_unit;
+    }
+
+    *num_sent = -1;
+    *rv_burst = bcmpkt_tx_burst(unit, netif_id, pkts, num, num_sent);
+    if (*rv_burst != SHR_E_NONE && *rv_burst != SHR_E_FAIL) {
+        SHR_RETURN_VAL_EXIT(*rv_burst);
+    }
+    if (*num_sent < 0 || *num_sent > num ||
+        (*rv_burst == SHR_E_NONE && *num_sent != num)) {
+        cli_out("Burst of %d packets reported %d sent (%s).\n",
+                num, *num_sent, shr_errmsg(*rv_burst));
+        SHR_RETURN_VAL_EXIT(SHR_E_FAIL);
+    }
+    for (i = 0; i < num; i++) {
+        if ((pkts[i]->data_buf == NULL) != (i < *num_sent)) {
+            cli_out("Burst of %d packets reported %d sent, "
+                    "but packet %d was %sconsumed.\n",
+                    num, *num_sent, i, (i < *num_sent) ? "not " : "");
+            SHR_RETURN_VAL_EXIT(SHR_E_FAIL);
+        }
+    }
+
+exit:
+    if (pkts) {
+        for (i = 0; i < num; i++) {
+            if (pkts[i]) {
+                bcmpkt_free(pkts[i]->unit, pkts[i]);
+            }
+        }
+        SHR_FREE(pkts);
+    }
+    SHR_FUNC_EXIT();
+}
+
 static int
 lt_find_first_unused_entry(int unit, const char *table_name,
                            const char *field_name, uint64_t *entry_id)
@@ -1519,3 +1591,53 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+int
+bcma_bcmpkt_test_tx_burst_run(int unit, bcma_bcmpkt_test_tx_param_t *tx_param)
+{
+    int netif_id = bcma_bcmpkt_netif_defid_get(unit);
+    int rv_burst, num_sent, round;
+
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(tx_param, SHR_E_PARAM);
+    SHR_NULL_CHECK(tx_param->ifp_cfg, SHR_E_PARAM);
+    SHR_NULL_CHECK(tx_param->packet, SHR_E_PARAM);
+
+    SHR_IF_ERR_EXIT
+        (lt_ifp_policy_update(unit, tx_param->ifp_cfg->entry_id,
+                              tx_param->ifp_cfg->drop_policy_id));
+
+    /* A short burst on an idle ring must be sent in full. */
+    sal_usleep(50000);
+    SHR_IF_ERR_EXIT
+        (packet_burst_check(unit, netif_id, tx_param->packet,
+                            BCMPKT_TX_BURST_MAX / 2, &rv_burst, &num_sent));
+    if (rv_burst != SHR_E_NONE) {
+        cli_out("Burst of %d packets on an idle ring failed after %d.\n",
+                BCMPKT_TX_BURST_MAX / 2, num_sent);
+        SHR_RETURN_VAL_EXIT(SHR_E_FAIL);
+    }
+    cli_out("Full burst:    %d of %d packets sent.\n",
+            num_sent, BCMPKT_TX_BURST_MAX / 2);
+
+    /* Bursts larger than the ring stop when it fills up. */
+    sal_usleep(50000);
+    for (round = 0; round < 16; round++) {
+        SHR_IF_ERR_EXIT
+            (packet_burst_check(unit, netif_id, tx_param->packet,
+                                TX_BURST_CHECK_PKTS, &rv_burst, &num_sent));
+        if (rv_burst == SHR_E_FAIL) {
+            break;
+        }
+    }
+    if (rv_burst == SHR_E_FAIL) {
+        cli_out("Partial burst: %d of %d packets sent.\n",
+                num_sent, TX_BURST_CHECK_PKTS);
+    } else {
+        cli_out("Partial burst: not reached, the ring kept up with "
+                "%d bursts of %d packets.\n", round, TX_BURST_CHECK_PKTS);
+    }
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
@@ -190,7 +190,7 @@ pkttest_rx(bcma_cli_t *cli, bcma_cli_args_t *args)
 }
 
 static int
-pkttest_tx(bcma_cli_t *cli, bcma_cli_args_t *args)
+pkttest_tx(bcma_cli_t *cli, bcma_cli_args_t *args, bool burst)
 {
     int rv = BCMA_CLI_CMD_OK;
     int unit = cli->cur_unit;
@@ -247,7 +247,11 @@ pkttest_tx(bcma_cli_t *cli, bcma_cli_args_t *args)
         return BCMA_CLI_CMD_FAIL;
     }
 
-    rv = bcma_bcmpkt_test_tx_run(unit, tx_param);
+    if (burst) {
+        rv = bcma_bcmpkt_test_tx_burst_run(unit, tx_param);
+    } else {
+        rv = bcma_bcmpkt_test_tx_run(unit, tx_param);
+    }
     if (SHR_FAILURE(rv)) {
         fail_cnt++;
     }
@@ -285,7 +289,11 @@ bcma_bcmpktcmd_pkttest(bcma_cli_t *cli, bcma_cli_args_t *args)
     }
 
     if (bcma_cli_parse_cmp("tx", cmd,  ' ')) {
-        return pkttest_tx(cli, args);
+        return pkttest_tx(cli, args, false);
+    }
+
+    if (bcma_cli_parse_cmp("txburst", cmd,  ' ')) {
+        return pkttest_tx(cli, args, true);
     }
 
     cli_out("Error: Unknown PKTTEST command: %s.\n", cmd);
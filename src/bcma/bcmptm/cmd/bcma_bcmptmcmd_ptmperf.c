@@ -0,0 +1,507 @@
+/*! \file bcma_bcmptmcmd_ptmperf.c
+ *
+ * CLI 'ptmperf' command for PTM resource manager benchmarks.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <sal/sal_libc.h>
+
+#include <shr/shr_debug.h>
+
+#include <bcmptm/bcmptm_rm_alpm_internal.h>
+#include <bcmptm/bcmptm_rm_tcam_internal.h>
+#include <bcmptm/bcmptm_rm_hash_internal.h>
+#include <bcmptm/bcmptm_cci_internal.h>
+#include <bcmptm/bcmptm_cci.h>
+#include <bcmptm/bcmptm_ser_internal.h>
+#include <bcmdrd/bcmdrd_pt.h>
+
+#include <bcma/cli/bcma_cli_parse.h>
+
+#include <bcma/bcmptm/bcma_bcmptmcmd_ptmperf.h>
+
+/* Default number of routes of the ALPM trie benchmark. */
+#ifndef BCMA_BCMPTM_CONFIG_DEFAULT_PERF_ROUTES
+#define BCMA_BCMPTM_CONFIG_DEFAULT_PERF_ROUTES 100000
+#endif
+
+/* Default number of entries of the TCAM priority benchmark. */
+#ifndef BCMA_BCMPTM_CONFIG_DEFAULT_PERF_ENTRIES
+#define BCMA_BCMPTM_CONFIG_DEFAULT_PERF_ENTRIES 2048
+#endif
+
+/* Default number of keys of the hash CRC test. */
+#ifndef BCMA_BCMPTM_CONFIG_DEFAULT_PERF_KEYS
+#define BCMA_BCMPTM_CONFIG_DEFAULT_PERF_KEYS 100000
+#endif
+
+/*******************************************************************************
+ * Private functions
+ */
+
+/*
+ * Convert a count and a time in usecs to a rate per second.
+ */
+static uint64_t
+perf_rate(uint32_t count, uint32_t usecs)
+{
+    if (usecs == 0) {
+        usecs = 1;
+    }
+    return ((uint64_t)count * 1000000) / usecs;
+}
+
+static void
+alpmtrie_result_show(const char *name, bcmptm_rm_alpm_trie_bench_t *bench)
+{
+    cli_out("  %-8s %12"PRIu64" %12"PRIu64" %12"PRIu64" %12"PRIu64
+            " %10"PRIu32"\n",
+            name,
+            perf_rate(bench->routes, bench->insert_usecs),
+            perf_rate(bench->lookups, bench->lpm_usecs),
+            perf_rate(bench->churns, bench->churn_usecs),
+            perf_rate(bench->routes, bench->delete_usecs),
+            bench->mismatches);
+}
+
+static int
+ptmperf_alpmtrie(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    int rv;
+    bcma_cli_parse_table_t pt;
+    int v6 = 0;
+    int routes = BCMA_BCMPTM_CONFIG_DEFAULT_PERF_ROUTES;
+    int churns = -1, lookups = -1, seed = 1;
+    bcmptm_rm_alpm_trie_bench_t binary, stride;
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "IPv6", "bool", &v6, NULL);
+    bcma_cli_parse_table_add(&pt, "Routes", "int", &routes, NULL);
+    bcma_cli_parse_table_add(&pt, "Churns", "int", &churns, NULL);
+    bcma_cli_parse_table_add(&pt, "Lookups", "int", &lookups, NULL);
+    bcma_cli_parse_table_add(&pt, "Seed", "int", &seed, NULL);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0 || routes <= 0) {
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    if (churns < 0) {
+        churns = routes / 2;
+    }
+    if (lookups < 0) {
+        lookups = routes;
+    }
+
+    rv = bcmptm_rm_alpm_trie_bench(v6, routes, churns, lookups, seed,
+                                   &binary, &stride);
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sALPM trie benchmark failed: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    cli_out("ALPM trie, %d IPv%d routes (ops/sec):\n", routes, v6 ? 6 : 4);
+    cli_out("  %-8s %12s %12s %12s %12s %10s\n",
+            "Trie", "Insert", "LPM", "Churn", "Delete", "Mismatch");
+    alpmtrie_result_show("binary", &binary);
+    alpmtrie_result_show("stride", &stride);
+
+    return BCMA_CLI_CMD_OK;
+}
+
+static void
+tcamprio_result_show(const char *name, bcmptm_rm_tcam_prio_bench_t *bench)
+{
+    cli_out("  %-8s %12"PRIu64" %12"PRIu64" %12"PRIu64" %12"PRIu32
+            " %10"PRIu32"\n",
+            name,
+            perf_rate(bench->inserts, bench->insert_usecs),
+            perf_rate(bench->churns, bench->churn_usecs),
+            perf_rate(bench->lookups, bench->lookup_usecs),
+            bench->moves,
+            bench->mismatches);
+}
+
+static int
+ptmperf_tcamprio(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    int rv;
+    bcma_cli_parse_table_t pt;
+    int entries = BCMA_BCMPTM_CONFIG_DEFAULT_PERF_ENTRIES;
+    int churns = -1, seed = 1;
+    bcmptm_rm_tcam_prio_bench_t scan, indexed;
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "Entries", "int", &entries, NULL);
+    bcma_cli_parse_table_add(&pt, "Churns", "int", &churns, NULL);
+    bcma_cli_parse_table_add(&pt, "Seed", "int", &seed, NULL);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0 || entries <= 0) {
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    if (churns < 0) {
+        churns = entries * 4;
+    }
+
+    rv = bcmptm_rm_tcam_prio_bench(cli->cmd_unit, entries, churns, seed,
+                                   &scan, &indexed);
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sTCAM priority benchmark failed: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    cli_out("TCAM priority slots, %d entries (ops/sec):\n", entries);
+    cli_out("  %-8s %12s %12s %12s %12s %10s\n",
+            "Method", "Insert", "Churn", "Lookup", "Moves", "Mismatch");
+    tcamprio_result_show("scan", &scan);
+    tcamprio_result_show("index", &indexed);
+
+    return BCMA_CLI_CMD_OK;
+}
+
+static int
+ptmperf_ccicol(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    int rv;
+    int thread;
+    bcma_cli_parse_table_t pt;
+    int threads = 0;
+    bcmptm_cci_col_sweep_stats_t stats;
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "Threads", "int", &threads, NULL);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0 || threads < 0) {
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    if (threads > 0) {
+        rv = bcmptm_cci_col_threads_set(cli->cmd_unit, threads);
+        if (SHR_FAILURE(rv)) {
+            cli_out("%sFailed to set %d collection threads: %s (%d).\n",
+                    BCMA_CLI_CONFIG_ERROR_STR, threads, shr_errmsg(rv), rv);
+            return BCMA_CLI_CMD_FAIL;
+        }
+    }
+
+    for (thread = 0; ; thread++) {
+        rv = bcmptm_cci_col_sweep_stats_get(cli->cmd_unit, thread, &stats);
+        if (SHR_FAILURE(rv)) {
+            break;
+        }
+        if (thread == 0) {
+            cli_out("Counter collection, %d threads (sweep usecs):\n",
+                    stats.nthreads);
+            cli_out("  %-6s %6s %10s %10s %10s %10s %10s\n",
+                    "Thread", "Ports", "Sweeps", "Last", "Min", "Max", "Avg");
+        }
+        cli_out("  %-6d %6d %10"PRIu64" %10"PRIu32" %10"PRIu32" %10"PRIu32
+                " %10"PRIu64"\n",
+                thread, stats.nports, stats.sweeps, stats.last_usecs,
+                stats.min_usecs, stats.max_usecs,
+                stats.sweeps ? stats.total_usecs / stats.sweeps : 0);
+    }
+    if (thread == 0) {
+        cli_out("%sCounter collection is not running.\n",
+                BCMA_CLI_CONFIG_ERROR_STR);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    return BCMA_CLI_CMD_OK;
+}
+
+static int
+ptmperf_ccisnap(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    int rv;
+    bcmptm_cci_snap_test_t result;
+
+    if (BCMA_CLI_ARG_CNT(args) > 0) {
+        return BCMA_CLI_CMD_USAGE;
+    }
+
+    rv = bcmptm_cci_snap_test(cli->cmd_unit, &result);
+    if (rv == SHR_E_NONE || rv == SHR_E_FAIL) {
+        cli_out("Counter snapshot, %"PRIu32" counters:\n", result.num_ctrs);
+        cli_out("  %10s %10s %10s %10s %10s\n",
+                "Take usecs", "Changed", "Mismatch", "Others", "Result");
+        cli_out("  %10"PRIu32" %10"PRIu32" %10"PRIu32" %10"PRIu32" %10s\n",
+                result.take_usecs, result.num_checked, result.mismatches,
+                result.others, (rv == SHR_E_NONE) ? "PASS" : "FAIL");
+    }
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sCounter snapshot test failed: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    return BCMA_CLI_CMD_OK;
+}
+
+static int
+ptmperf_serscan(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    int rv;
+    int unit = cli->cmd_unit;
+    bcma_cli_parse_table_t pt;
+    char *pt_name = NULL;
+    bcmdrd_sid_t sid = INVALIDm;
+    bcmptm_ser_scan_type_t type;
+    bcmptm_ser_scan_sched_stats_t stats;
+    bcmptm_ser_scan_stats_t pt_stats;
+    static const char *type_name[BCMPTM_SER_SCAN_COUNT] = { "SRAM", "TCAM" };
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "PT", "str", &pt_name, NULL);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0) {
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    if (pt_name != NULL && bcmdrd_pt_name_to_sid(unit, pt_name, &sid) < 0) {
+        cli_out("%sUnknown PT: %s.\n", BCMA_CLI_CONFIG_ERROR_STR, pt_name);
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_FAIL;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    if (sid != INVALIDm) {
+        rv = bcmptm_ser_scan_stats_get(unit, sid, &pt_stats);
+        if (SHR_FAILURE(rv)) {
+            cli_out("%sFailed to get scan statistics: %s (%d).\n",
+                    BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+            return BCMA_CLI_CMD_FAIL;
+        }
+        cli_out("SER scan of %s (usecs):\n", bcmdrd_pt_sid_to_name(unit, sid));
+        cli_out("  %10s %12s %12s %12s %10s\n",
+                "Rounds", "Scan", "Period", "Max period", "SLA misses");
+        cli_out("  %10"PRIu32" %12"PRIu64" %12"PRIu64" %12"PRIu64
+                " %10"PRIu32"\n",
+                pt_stats.rounds, pt_stats.scan_usecs, pt_stats.period_usecs,
+                pt_stats.period_max_usecs, pt_stats.sla_misses);
+        return BCMA_CLI_CMD_OK;
+    }
+
+    for (type = 0; type < BCMPTM_SER_SCAN_COUNT; type++) {
+        rv = bcmptm_ser_scan_sched_stats_get(unit, type, &stats);
+        if (SHR_FAILURE(rv)) {
+            cli_out("%sFailed to get scan statistics: %s (%d).\n",
+                    BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+            return BCMA_CLI_CMD_FAIL;
+        }
+        if (type == 0) {
+            cli_out("SER scan threads (usecs):\n");
+            cli_out("  %-6s %12s %8s %12s %10s %12s %10s\n",
+                    "Thread", "Entries", "Backoffs", "Backoff", "Throttled",
+                    "Max period", "SLA misses");
+        }
+        cli_out("  %-6s %12"PRIu64" %8"PRIu32" %12"PRIu64" %10"PRIu32
+                " %12"PRIu64" %10"PRIu32"\n",
+                type_name[type], stats.entries, stats.backoffs,
+                stats.backoff_usecs, stats.throttled,
+                stats.period_max_usecs, stats.sla_misses);
+    }
+
+    return BCMA_CLI_CMD_OK;
+}
+
+static int
+ptmperf_serpace(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    int rv;
+    bcmptm_ser_scan_sched_test_t result;
+
+    if (BCMA_CLI_ARG_CNT(args) > 0) {
+        return BCMA_CLI_CMD_USAGE;
+    }
+
+    rv = bcmptm_ser_scan_sched_test(cli->cmd_unit, &result);
+    if (rv == SHR_E_NONE || rv == SHR_E_FAIL) {
+        cli_out("SER scan pacing, budget %"PRIu32" entries per interval:\n",
+                result.entries);
+        cli_out("  %10s %10s %10s %8s %12s %8s\n",
+                "Idle", "Busy", "Catch up", "Backoffs", "Backoff us",
+                "Result");
+        cli_out("  %10"PRIu32" %10"PRIu32" %10"PRIu32" %8"PRIu32
+                " %12"PRIu64" %8s\n",
+                result.idle_entries, result.busy_entries,
+                result.catchup_entries, result.backoffs,
+                result.backoff_usecs, (rv == SHR_E_NONE) ? "PASS" : "FAIL");
+    }
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sSER scan pacing test failed: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    return BCMA_CLI_CMD_OK;
+}
+
+static int
+ptmperf_hashcrc(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    int rv;
+    bcma_cli_parse_table_t pt;
+    int keys = BCMA_BCMPTM_CONFIG_DEFAULT_PERF_KEYS;
+    int seed = 1;
+    bcmptm_rm_hash_crc_test_t result;
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "Keys", "int", &keys, NULL);
+    bcma_cli_parse_table_add(&pt, "Seed", "int", &seed, NULL);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0 || keys <= 0) {
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    rv = bcmptm_rm_hash_crc_test(keys, seed, &result);
+    if (rv == SHR_E_NONE || rv == SHR_E_FAIL) {
+        cli_out("Hash vector CRC, %"PRIu32" random keys (keys/sec):\n",
+                result.keys);
+        cli_out("  %12s %12s %10s %10s\n",
+                "Reference", "SDK", "CRC16 err", "CRC32 err");
+        cli_out("  %12"PRIu64" %12"PRIu64" %10"PRIu32" %10"PRIu32"\n",
+                perf_rate(result.keys, result.ref_usecs),
+                perf_rate(result.keys, result.shr_usecs),
+                result.crc16_mismatches, result.crc32_mismatches);
+    }
+    if (SHR_FAILURE(rv)) {
+        cli_out("%sHash vector CRC test failed: %s (%d).\n",
+                BCMA_CLI_CONFIG_ERROR_STR, shr_errmsg(rv), rv);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    return BCMA_CLI_CMD_OK;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+bcma_bcmptmcmd_ptmperf(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    const char *arg;
+
+    if (cli == NULL || args == NULL) {
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    if ((arg = BCMA_CLI_ARG_GET(args)) == NULL) {
+        return BCMA_CLI_CMD_USAGE;
+    }
+    if (sal_strcasecmp(arg, "alpmtrie") == 0) {
+        return ptmperf_alpmtrie(cli, args);
+    }
+    if (sal_strcasecmp(arg, "tcamprio") == 0) {
+        return ptmperf_tcamprio(cli, args);
+    }
+    if (sal_strcasecmp(arg, "ccicol") == 0) {
+        return ptmperf_ccicol(cli, args);
+    }
+    if (sal_strcasecmp(arg, "ccisnap") == 0) {
+        return ptmperf_ccisnap(cli, args);
+    }
+    if (sal_strcasecmp(arg, "serscan") == 0) {
+        return ptmperf_serscan(cli, args);
+    }
+    if (sal_strcasecmp(arg, "serpace") == 0) {
+        return ptmperf_serpace(cli, args);
+    }
+    if (sal_strcasecmp(arg, "hashcrc") == 0) {
+        return ptmperf_hashcrc(cli, args);
+    }
+
+    return BCMA_CLI_CMD_USAGE;
+}
@@ -102,7 +102,8 @@
 #define BCMA_BCMLTCMD_LTCAPTURE_SYNOP \
     "start [logfile=<file>]\n" \
     "stop\n" \
-    "replay [logfile=<file>] [timing=0|1] [verbose=0|1] [submit=0|1]"
+    "replay [logfile=<file>] [timing=0|1] [verbose=0|1] [submit=0|1]\n" \
+    "       [maxrate=0|1]"
 
 /*! Help for CLI command. */
 #define BCMA_BCMLTCMD_LTCAPTURE_HELP \
@@ -114,7 +115,9 @@
     "turned on for the replay to take effect.\n" \
     "The replay will be executed as fast as the system permits unless the\n" \
     "'timing' parameter is set to true, in which case the replay function\n" \
-    "will attempt to impose the original timing.\n\n" \
+    "will attempt to impose the original timing.\n" \
+    "With 'maxrate' the operations are submitted back to back and the\n" \
+    "throughput and per-operation latency percentiles are reported.\n\n" \
     "If a log file name is not specified, the name 'bcmlt.lcap' will be\n" \
     "used.\n\n"
 
@@ -295,6 +295,22 @@ bcma_bcmpkt_test_rx_run(int unit, bcma_bcmpkt_test_rx_param_t *rx_param);
 extern int
 bcma_bcmpkt_test_tx_run(int unit, bcma_bcmpkt_test_tx_param_t *tx_param);
 
+/*!
+ * \brief Packet I/O tx burst test procedure.
+ *
+ * Send a short burst on an idle ring and check that all packets are
+ * reported as sent. Then send bursts larger than the TX ring until it
+ * fills up, and check that the reported count matches the packets
+ * consumed.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] tx_param Packet I/O tx test parameter.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+extern int
+bcma_bcmpkt_test_tx_burst_run(int unit, bcma_bcmpkt_test_tx_param_t *tx_param);
+
 /*!
  * \brief Packet I/O rx test cleanup procedure.
  *
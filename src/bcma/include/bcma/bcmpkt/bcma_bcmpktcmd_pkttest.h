@@ -121,9 +121,14 @@
     "        LengthEnd=<value>    - The end packet length (default=1536).\n"\
     "        LengthInc=<value>    - The increasing step of packet length \n"\
     "                               (default=64).\n"\
+    "    TXBURST - Tx burst check for Packet IO. Sends a short burst on\n"\
+    "        an idle ring and bursts larger than the ring, and checks that\n"\
+    "        the reported sent count matches the packets consumed.\n"\
+    "        LengthStart=<value>  - The packet length (default=64).\n"\
     "\nExamples:\n"\
     "pkttest rx t=2 ls=128 le=512 li=128\n"\
-    "pkttest tx sc=100000 ls=128 le=512 li=128\n\n"\
+    "pkttest tx sc=100000 ls=128 le=512 li=128\n"\
+    "pkttest txburst ls=128\n\n"\
 
 /*!
  * \brief PKTTEST command in CLI.
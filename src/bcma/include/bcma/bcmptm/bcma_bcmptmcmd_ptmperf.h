@@ -0,0 +1,162 @@
+/*! \file bcma_bcmptmcmd_ptmperf.h
+ *
+ * CLI 'ptmperf' command for PTM resource manager benchmarks.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#ifndef BCMA_BCMPTMCMD_PTMPERF_H
+#define BCMA_BCMPTMCMD_PTMPERF_H
+
+#include <bcma/cli/bcma_cli.h>
+
+/*! Brief description for CLI command. */
+#define BCMA_BCMPTMCMD_PTMPERF_DESC \
+    "Benchmark PTM resource managers and counter collection"
+
+/*! Syntax for CLI command. */
+#define BCMA_BCMPTMCMD_PTMPERF_SYNOP \
+    "alpmtrie [IPv6=yes|no] [Routes=<n>] [Churns=<n>] [Lookups=<n>] [Seed=<n>]\n" \
+    "tcamprio [Entries=<n>] [Churns=<n>] [Seed=<n>]\n" \
+    "ccicol [Threads=<n>]\n" \
+    "ccisnap\n" \
+    "serscan [PT=<name>]\n" \
+    "serpace\n" \
+    "hashcrc [Keys=<n>] [Seed=<n>]"
+
+/*! Help for CLI command. */
+#define BCMA_BCMPTMCMD_PTMPERF_HELP \
+    "The alpmtrie benchmark runs the same random route set on the ALPM\n" \
+    "binary trie and on the stride trie index. Routes are inserted, looked\n" \
+    "up by LPM, churned (a random route deleted and a new one inserted)\n" \
+    "and finally deleted, and the rate of each phase is reported. The LPM\n" \
+    "results of the stride trie are checked against the binary trie.\n" \
+    "Rates of the stride trie include maintaining the binary trie.\n\n" \
+    "The tcamprio benchmark fills a simulated priority TCAM to 90% and\n" \
+    "churns it (a random entry deleted and a new one of random priority\n" \
+    "inserted), finding the target slots by linear scan and by the\n" \
+    "priority index. Lookup reports the target slot search alone. The\n" \
+    "index results are checked against the scan.\n\n" \
+    "The ccicol command shows the sweep times of the counter collection\n" \
+    "threads. Threads=<n> first restarts the collection with n threads,\n" \
+    "each collecting its own range of the active ports.\n\n" \
+    "The ccisnap test takes a snapshot of all counters, adds known values\n" \
+    "to the first and last counter of a few counter symbols and checks\n" \
+    "that the next take reports exactly these deltas at the positions of\n" \
+    "the snapshot layout, then subtracts them again. Run it with traffic\n" \
+    "stopped.\n\n" \
+    "The serscan command shows the bandwidth budget statistics of the SER\n" \
+    "memory scan threads, or the scan coverage of one PT.\n\n" \
+    "The serpace test runs the SER scan pacing on a simulated clock and\n" \
+    "checks the rate while WAL is idle and busy, the backoff count and\n" \
+    "time, and the catch up once WAL is idle again.\n\n" \
+    "The hashcrc test hashes random keys of random bit lengths with the\n" \
+    "SDK CRC16/CRC32 hash vector functions and with the scalar reference\n" \
+    "CRC, and reports any mismatch and the rate of both.\n\n" \
+    "Examples:\n" \
+    "ptmperf alpmtrie Routes=1000000\n" \
+    "ptmperf alpmtrie IPv6=yes Routes=300000 Churns=100000\n" \
+    "ptmperf tcamprio Entries=16384\n" \
+    "ptmperf ccicol Threads=4\n" \
+    "ptmperf ccisnap\n" \
+    "ptmperf serscan PT=L2Xm\n" \
+    "ptmperf serpace\n" \
+    "ptmperf hashcrc Keys=1000000\n"
+
+/*!
+ * \brief PTM benchmark command in CLI.
+ *
+ * \param[in] cli CLI object
+ * \param[in] args CLI arguments list
+ *
+ * \return BCMA_CLI_CMD_xxx return values.
+ */
+extern int
+bcma_bcmptmcmd_ptmperf(bcma_cli_t *cli, bcma_cli_args_t *args);
+
+#endif /* BCMA_BCMPTMCMD_PTMPERF_H */
@@ -100,7 +100,8 @@
 
 /*! Syntax for CLI command. */
 #define BCMA_SALCMD_SAL_SYNOP \
-    "alloc trace|track|status|dump|nofill|fill [-|<prefix>]"
+    "alloc trace|track|status|dump|nofill|fill [-|<prefix>]\n" \
+    "msgq perf [Producers=<n>] [Count=<n>] [QueueSize=<n>]"
 
 /*! Help for CLI command. */
 #define BCMA_SALCMD_SAL_HELP \
@@ -114,6 +115,11 @@
     "according to the specified track prefix.\n\n" \
     "Allocated and freed memory will be filled with a fixed\n" \
     "pattern by default. Use nofill/fill to turn this off/on.\n\n" \
+    "The msgq perf command measures the message queue throughput.\n" \
+    "The specified number of producer threads post a total of Count\n" \
+    "messages into a queue of QueueSize elements, while the CLI\n" \
+    "thread receives them. If Producers is not specified, the test\n" \
+    "is repeated with 1, 2, 4, 8 and 16 producers.\n\n" \
     "Examples:\n" \
     "sal alloc status\n" \
     "sal alloc trace *\n" \
@@ -123,7 +129,9 @@
     "sal alloc notrace cli\n" \
     "sal alloc track bcmpc\n" \
     "sal alloc nofill\n" \
-    "sal alloc dump"
+    "sal alloc dump\n" \
+    "sal msgq perf\n" \
+    "sal msgq perf Producers=4 Count=100000"
 
 /*!
  * \brief CLI 'sal' command implementation.
@@ -92,12 +92,39 @@
 #include <bsl/bsl.h>
 
 #include <sal/sal_libc.h>
+#include <sal/sal_msgq.h>
+#include <sal/sal_sem.h>
+#include <sal/sal_thread.h>
+#include <sal/sal_time.h>
 
+#include <bcma/cli/bcma_cli_parse.h>
 #include <bcma/sal/bcma_sal_alloc_debug.h>
 #include <bcma/sal/bcma_salcmd_sal.h>
 
 #define BSL_LOG_MODULE  BSL_LS_APPL_SHELL
 
+/* Maximum number of producer threads for the message queue benchmark */
+#define MSGQ_PERF_PRODUCERS_MAX 16
+
+/* Interval to drain the queue while waiting for the producers to exit */
+#define MSGQ_PERF_POLL_USEC     10000
+
+/* Message queue benchmark element (similar in size to typical requests) */
+typedef struct msgq_perf_msg_s {
+    void *ptr;
+    uint32_t seq;
+    uint32_t id;
+} msgq_perf_msg_t;
+
+/* Message queue benchmark producer context */
+typedef struct msgq_perf_ctx_s {
+    sal_msgq_t msgq;
+    sal_sem_t done;
+    uint32_t id;
+    uint32_t count;
+    uint32_t failed;
+} msgq_perf_ctx_t;
+
 static int
 cmd_alloc(bcma_cli_t *cli, bcma_cli_args_t *args)
 {
@@ -153,6 +180,160 @@ cmd_alloc(bcma_cli_t *cli, bcma_cli_args_t *args)
     return BCMA_CLI_CMD_OK;
 }
 
+static void
+msgq_perf_producer(void *arg)
+{
+    msgq_perf_ctx_t *ctx = (msgq_perf_ctx_t *)arg;
+    msgq_perf_msg_t msg;
+    uint32_t idx;
+
+    msg.ptr = ctx;
+    msg.id = ctx->id;
+    for (idx = 0; idx < ctx->count; idx++) {
+        msg.seq = idx;
+        if (sal_msgq_post(ctx->msgq, &msg, SAL_MSGQ_NORMAL_PRIORITY,
+                          SECOND_USEC) != 0) {
+            /* The consumer gave up, count the remaining messages */
+            ctx->failed += ctx->count - idx;
+            break;
+        }
+    }
+    sal_sem_give(ctx->done);
+}
+
+static int
+msgq_perf_run(int producers, uint32_t count, uint32_t qsize)
+{
+    msgq_perf_ctx_t ctx[MSGQ_PERF_PRODUCERS_MAX];
+    msgq_perf_msg_t msg;
+    sal_msgq_t msgq;
+    sal_sem_t done;
+    sal_thread_t tid;
+    sal_usecs_t start, usecs;
+    uint32_t total = 0, failed = 0, idx;
+    uint64_t rate;
+    int started, j;
+
+    msgq = sal_msgq_create(sizeof(msg), qsize, "bcmaMsgqPerf");
+    if (!msgq) {
+        cli_out("%sFailed to create message queue\n",
+                BCMA_CLI_CONFIG_ERROR_STR);
+        return -1;
+    }
+    done = sal_sem_create("bcmaMsgqPerfDone", SAL_SEM_COUNTING, 0);
+    if (!done) {
+        cli_out("%sFailed to create semaphore\n", BCMA_CLI_CONFIG_ERROR_STR);
+        sal_msgq_destroy(msgq);
+        return -1;
+    }
+
+    start = sal_time_usecs();
+    for (started = 0; started < producers; started++) {
+        ctx[started].msgq = msgq;
+        ctx[started].done = done;
+        ctx[started].id = started;
+        ctx[started].count = count / producers;
+        ctx[started].failed = 0;
+        tid = sal_thread_create("bcmaMsgqPerf", SAL_THREAD_STKSZ,
+                                SAL_THREAD_PRIO_DEFAULT,
+                                msgq_perf_producer, &ctx[started]);
+        if (tid == SAL_THREAD_ERROR) {
+            cli_out("%sFailed to create producer thread\n",
+                    BCMA_CLI_CONFIG_ERROR_STR);
+            break;
+        }
+        total += ctx[started].count;
+    }
+
+    /* Receive all messages from the producers that were started */
+    for (idx = 0; idx < total; idx++) {
+        if (sal_msgq_recv(msgq, &msg, SECOND_USEC) != 0) {
+            failed++;
+            break;
+        }
+    }
+    usecs = SAL_USECS_SUB(sal_time_usecs(), start);
+
+    /*
+     * Wait for the producers. If the receive loop gave up, keep draining
+     * the queue so that no producer is blocked on a full queue.
+     */
+    for (j = 0; j < started; j++) {
+        while (sal_sem_take(done, MSGQ_PERF_POLL_USEC) != 0) {
+            while (sal_msgq_recv(msgq, &msg, SAL_MSGQ_NOWAIT) == 0) {
+                ;
+            }
+        }
+        failed += ctx[j].failed;
+    }
+    sal_sem_destroy(done);
+    sal_msgq_destroy(msgq);
+
+    if (usecs == 0) {
+        usecs = 1;
+    }
+    rate = (uint64_t)idx * SECOND_USEC / usecs;
+    cli_out("%9d %10"PRIu32" %12"PRIu32" %12"PRIu64" %8"PRIu32"\n",
+            started, idx, (uint32_t)usecs, rate, failed);
+
+    return (started == producers && failed == 0) ? 0 : -1;
+}
+
+static int
+cmd_msgq(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    const char *cmd;
+    bcma_cli_parse_table_t pt;
+    int producers = 0;
+    int count = 1000000;
+    int qsize = 1024;
+    int num;
+
+    cmd = BCMA_CLI_ARG_GET(args);
+    if (!cmd) {
+        return BCMA_CLI_CMD_USAGE;
+    }
+
+    if (sal_strcmp(cmd, "perf") != 0) {
+        cli_out("%sunknown or unsupported command: '%s'\n",
+                BCMA_CLI_CONFIG_ERROR_STR, cmd);
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "Producers", "int", &producers, NULL);
+    bcma_cli_parse_table_add(&pt, "Count", "int", &count, NULL);
+    bcma_cli_parse_table_add(&pt, "QueueSize", "int", &qsize, NULL);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0) {
+        cli_out("%s: Invalid option: %s\n",
+                BCMA_CLI_ARG_CMD(args), BCMA_CLI_ARG_CUR(args));
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    if (producers < 0 || producers > MSGQ_PERF_PRODUCERS_MAX ||
+        count <= 0 || qsize <= 0) {
+        return BCMA_CLI_CMD_USAGE;
+    }
+
+    cli_out("Producers   Messages   Time(usec)     Msgs/sec   Failed\n");
+    if (producers > 0) {
+        /* Run with the specified number of producers only */
+        if (msgq_perf_run(producers, count, qsize) < 0) {
+            return BCMA_CLI_CMD_FAIL;
+        }
+        return BCMA_CLI_CMD_OK;
+    }
+    for (num = 1; num <= MSGQ_PERF_PRODUCERS_MAX; num <<= 1) {
+        if (msgq_perf_run(num, count, qsize) < 0) {
+            return BCMA_CLI_CMD_FAIL;
+        }
+    }
+
+    return BCMA_CLI_CMD_OK;
+}
+
 int
 bcma_salcmd_sal(bcma_cli_t *cli, bcma_cli_args_t *args)
 {
@@ -166,6 +347,8 @@ bcma_salcmd_sal(bcma_cli_t *cli, bcma_cli_args_t *args)
 
     if (sal_strcmp(api, "alloc") == 0) {
         rv = cmd_alloc(cli, args);
+    } else if (sal_strcmp(api, "msgq") == 0) {
+        rv = cmd_msgq(cli, args);
     } else {
         cli_out("%sunknown or unsupported API: '%s'\n",
                 BCMA_CLI_CONFIG_ERROR_STR, api);
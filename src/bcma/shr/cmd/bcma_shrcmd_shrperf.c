@@ -0,0 +1,503 @@
+/*! \file bcma_shrcmd_shrperf.c
+ *
+ * CLI 'shrperf' command for shared library performance tests.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <bsl/bsl.h>
+
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_time.h>
+#include <sal/sal_thread.h>
+#include <sal/sal_sem.h>
+
+#include <shr/shr_mpool.h>
+
+#include <bcma/cli/bcma_cli_parse.h>
+
+#include <bcma/shr/bcma_shrcmd_shrperf.h>
+
+/* Default number of operations per test run. */
+#ifndef BCMA_SHR_CONFIG_DEFAULT_PERF_COUNT
+#define BCMA_SHR_CONFIG_DEFAULT_PERF_COUNT 100000
+#endif
+
+/* Default size of the memory pool in KB. */
+#ifndef BCMA_SHR_CONFIG_DEFAULT_PERF_MPOOL_KB
+#define BCMA_SHR_CONFIG_DEFAULT_PERF_MPOOL_KB 4096
+#endif
+
+/* Default number of threads sharing the memory pool. */
+#ifndef BCMA_SHR_CONFIG_DEFAULT_PERF_MPOOL_THREADS
+#define BCMA_SHR_CONFIG_DEFAULT_PERF_MPOOL_THREADS 8
+#endif
+
+/* Maximum number of threads sharing the memory pool. */
+#define PERF_MPOOL_THREADS_MAX 16
+
+/* Number of live buffers shared by all threads. */
+#define PERF_MPOOL_BUFS 512
+
+/* Operations between two overlap checks of a thread's own buffers. */
+#define PERF_MPOOL_CHECK_OPS 1024
+
+/* Address range of an allocated buffer. */
+typedef struct perf_mpool_ext_s {
+
+    /*! First byte of the buffer. */
+    uint8_t *addr;
+
+    /*! Requested size of the buffer. */
+    size_t len;
+
+} perf_mpool_ext_t;
+
+/* Per-thread context of the memory pool test. */
+typedef struct perf_mpool_ctx_s {
+
+    /*! Memory pool shared by all threads. */
+    shr_mpool_handle_t mp;
+
+    /*! Memory managed by the pool. */
+    uint8_t *base;
+
+    /*! Size of the memory managed by the pool. */
+    size_t size;
+
+    /*! Number of alloc/free operations. */
+    uint32_t count;
+
+    /*! Random seed of this thread. */
+    uint32_t seed;
+
+    /*! Fill the buffers and verify their contents and addresses. */
+    bool check;
+
+    /*! Number of buffer slots of this thread. */
+    uint32_t num_bufs;
+
+    /*! Buffer slots, NULL if free. */
+    perf_mpool_ext_t *buf;
+
+    /*! Fill pattern of each buffer slot. */
+    uint8_t *tag;
+
+    /*! Scratch array for the overlap check. */
+    perf_mpool_ext_t *sorted;
+
+    /*! Failed allocations. */
+    uint32_t fails;
+
+    /*! Corrupted, overlapping or out of range buffers. */
+    uint32_t errors;
+
+    /*! Signaled when the thread is done. */
+    sal_sem_t done;
+
+} perf_mpool_ctx_t;
+
+/*******************************************************************************
+ * Private functions
+ */
+
+static int
+perf_mpool_ext_cmp(const void *a, const void *b)
+{
+    const perf_mpool_ext_t *ea = (const perf_mpool_ext_t *)a;
+    const perf_mpool_ext_t *eb = (const perf_mpool_ext_t *)b;
+
+    if (ea->addr < eb->addr) {
+        return -1;
+    }
+    return (ea->addr > eb->addr) ? 1 : 0;
+}
+
+/*
+ * Sort <num> buffers by address and count the buffers which are outside
+ * the pool or overlap their predecessor.
+ */
+static uint32_t
+perf_mpool_overlaps(perf_mpool_ext_t *ext, uint32_t num,
+                    uint8_t *base, size_t size)
+{
+    uint8_t *end = base;
+    uint32_t idx, errors = 0;
+
+    sal_qsort(ext, num, sizeof(*ext), perf_mpool_ext_cmp);
+    for (idx = 0; idx < num; idx++) {
+        if (ext[idx].addr < end || ext[idx].addr + ext[idx].len > base + size) {
+            errors++;
+        }
+        if (ext[idx].addr + ext[idx].len > end) {
+            end = ext[idx].addr + ext[idx].len;
+        }
+    }
+
+    return errors;
+}
+
+/* Check the thread's own live buffers for overlaps. */
+static void
+perf_mpool_check(perf_mpool_ctx_t *ctx)
+{
+    uint32_t idx, num = 0;
+
+    for (idx = 0; idx < ctx->num_bufs; idx++) {
+        if (ctx->buf[idx].addr) {
+            ctx->sorted[num++] = ctx->buf[idx];
+        }
+    }
+    ctx->errors += perf_mpool_overlaps(ctx->sorted, num, ctx->base, ctx->size);
+}
+
+/* Free a buffer slot and verify its fill pattern in check mode. */
+static void
+perf_mpool_free(perf_mpool_ctx_t *ctx, uint32_t num)
+{
+    perf_mpool_ext_t *ext = &ctx->buf[num];
+    size_t idx;
+
+    if (ctx->check) {
+        for (idx = 0; idx < ext->len; idx++) {
+            if (ext->addr[idx] != ctx->tag[num]) {
+                ctx->errors++;
+                break;
+            }
+        }
+    }
+    shr_mpool_free(ctx->mp, ext->addr);
+    ext->addr = NULL;
+}
+
+/*
+ * Allocate and free buffers of mixed sizes in random slots. Mostly
+ * descriptor and packet sized buffers with some larger table DMA
+ * buffers in between.
+ */
+static void
+perf_mpool_worker(void *arg)
+{
+    perf_mpool_ctx_t *ctx = (perf_mpool_ctx_t *)arg;
+    uint32_t idx, num, seed = ctx->seed;
+    size_t size;
+
+    for (idx = 0; idx < ctx->count; idx++) {
+        seed = seed * 1103515245U + 12345U;
+        num = (seed >> 8) % ctx->num_bufs;
+        if (ctx->buf[num].addr) {
+            perf_mpool_free(ctx, num);
+        } else {
+            size = ((seed >> 16) % 10) ? 64 + (seed >> 4) % 2048 :
+                                         4096 + (seed >> 4) % 61440;
+            ctx->buf[num].addr = shr_mpool_alloc(ctx->mp, size);
+            ctx->buf[num].len = size;
+            if (ctx->buf[num].addr == NULL) {
+                ctx->fails++;
+            } else if (ctx->check) {
+                ctx->tag[num] = (uint8_t)(seed >> 24) | 1;
+                sal_memset(ctx->buf[num].addr, ctx->tag[num], size);
+            }
+        }
+        if (ctx->check && (idx + 1) % PERF_MPOOL_CHECK_OPS == 0) {
+            perf_mpool_check(ctx);
+        }
+    }
+    sal_sem_give(ctx->done);
+}
+
+/*
+ * Run <count> operations in each of <threads> threads on one pool of
+ * <kbytes>, either with the first-fit allocator only or with slabs.
+ *
+ * In check mode every buffer is filled when allocated and verified when
+ * freed, and the live buffers of all threads are checked for overlaps
+ * at the end. The check mode is not timed.
+ */
+static int
+perf_mpool_run(int kbytes, int threads, uint32_t count, bool slab, bool check)
+{
+    shr_mpool_handle_t mp = NULL;
+    shr_mpool_stats_t stats;
+    perf_mpool_ctx_t ctx[PERF_MPOOL_THREADS_MAX];
+    perf_mpool_ext_t *buf;
+    uint8_t *mem, *tag;
+    size_t size = (size_t)kbytes * 1024;
+    uint32_t num_bufs = PERF_MPOOL_BUFS / threads;
+    uint32_t idx, num, fails = 0, errors = 0;
+    sal_usecs_t start, usecs;
+    sal_sem_t done = NULL;
+    sal_thread_t tid;
+    int started = 0, j;
+
+    mem = sal_alloc(size, "bcmaShrPerfMpool");
+    buf = sal_alloc(2 * PERF_MPOOL_BUFS * sizeof(*buf), "bcmaShrPerfMpoolBuf");
+    tag = sal_alloc(PERF_MPOOL_BUFS, "bcmaShrPerfMpoolTag");
+    if (mem && buf && tag) {
+        sal_memset(buf, 0, 2 * PERF_MPOOL_BUFS * sizeof(*buf));
+        mp = shr_mpool_create(mem, size, 0);
+        done = sal_sem_create("bcmaShrPerfMpool", SAL_SEM_COUNTING, 0);
+    }
+    if (mp == NULL || done == NULL ||
+        (slab && shr_mpool_slab_enable(mp) < 0)) {
+        cli_out("%sFailed to create %d KB memory pool.\n",
+                BCMA_CLI_CONFIG_ERROR_STR, kbytes);
+        threads = 0;
+    }
+
+    sal_memset(ctx, 0, sizeof(ctx));
+    start = sal_time_usecs();
+    for (started = 0; started < threads; started++) {
+        ctx[started].mp = mp;
+        ctx[started].base = mem;
+        ctx[started].size = size;
+        ctx[started].count = count;
+        ctx[started].seed = started + 1;
+        ctx[started].check = check;
+        ctx[started].num_bufs = num_bufs;
+        ctx[started].buf = &buf[started * num_bufs];
+        ctx[started].tag = &tag[started * num_bufs];
+        ctx[started].sorted = &buf[PERF_MPOOL_BUFS + started * num_bufs];
+        ctx[started].done = done;
+        tid = sal_thread_create("bcmaShrPerfMpool", SAL_THREAD_STKSZ,
+                                SAL_THREAD_PRIO_DEFAULT,
+                                perf_mpool_worker, &ctx[started]);
+        if (tid == SAL_THREAD_ERROR) {
+            cli_out("%sFailed to create test thread.\n",
+                    BCMA_CLI_CONFIG_ERROR_STR);
+            break;
+        }
+    }
+    for (j = 0; j < started; j++) {
+        sal_sem_take(done, SAL_SEM_FOREVER);
+    }
+    usecs = SAL_USECS_SUB(sal_time_usecs(), start);
+
+    for (j = 0; j < started; j++) {
+        fails += ctx[j].fails;
+    }
+
+    if (check && started > 0) {
+        /* Overlaps between the buffers of different threads. */
+        num = 0;
+        for (idx = 0; idx < started * num_bufs; idx++) {
+            if (buf[idx].addr) {
+                buf[PERF_MPOOL_BUFS + num++] = buf[idx];
+            }
+        }
+        errors += perf_mpool_overlaps(&buf[PERF_MPOOL_BUFS], num, mem, size);
+    }
+
+    if (started > 0) {
+        shr_mpool_stats_get(mp, &stats);
+        cli_out("  %-8s %7d %10"PRIu32, slab ? "slab" : "ffit", started,
+                started * count);
+        if (check) {
+            cli_out(" %8s", "-");
+        } else {
+            cli_out(" %8"PRIu64, (uint64_t)usecs * 1000 / (started * count));
+        }
+        cli_out(" %8"PRIu32" %8"PRIu64" %8"PRIu32" %6"PRIu32" %5"PRIu32"%%",
+                fails,
+                stats.ff_allocs ? stats.ff_steps / stats.ff_allocs : 0,
+                stats.blocks, stats.slabs,
+                stats.free ?
+                (uint32_t)(100 - stats.max_free * 100 / stats.free) : 0);
+        for (j = 0; j < started; j++) {
+            for (num = 0; num < num_bufs; num++) {
+                if (ctx[j].buf[num].addr) {
+                    perf_mpool_free(&ctx[j], num);
+                }
+            }
+            errors += ctx[j].errors;
+        }
+        if (check) {
+            cli_out(" %s", errors ? "FAIL" : "PASS");
+        }
+        cli_out("\n");
+    }
+    if (errors) {
+        cli_out("%s%"PRIu32" corrupted or overlapping buffers.\n",
+                BCMA_CLI_CONFIG_ERROR_STR, errors);
+    }
+
+    if (done) {
+        sal_sem_destroy(done);
+    }
+    if (mp) {
+        shr_mpool_destroy(mp);
+    }
+    if (tag) {
+        sal_free(tag);
+    }
+    if (buf) {
+        sal_free(buf);
+    }
+    if (mem) {
+        sal_free(mem);
+    }
+
+    return (started == threads && started > 0 && errors == 0) ?
+           BCMA_CLI_CMD_OK : BCMA_CLI_CMD_FAIL;
+}
+
+/*
+ * Compare the first-fit memory pool allocator with the slab allocator
+ * in a single thread and in <threads> threads sharing the pool, then
+ * verify the buffers handed out under contention.
+ */
+static int
+perf_mpool(bcma_cli_t *cli, uint32_t count, bcma_cli_args_t *args)
+{
+    bcma_cli_parse_table_t pt;
+    int kbytes = BCMA_SHR_CONFIG_DEFAULT_PERF_MPOOL_KB;
+    int threads = BCMA_SHR_CONFIG_DEFAULT_PERF_MPOOL_THREADS;
+    int rv = BCMA_CLI_CMD_OK;
+    int mode;
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "kbytes", "int", &kbytes, NULL);
+    bcma_cli_parse_table_add(&pt, "threads", "int", &threads, NULL);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0 ||
+        BCMA_CLI_ARG_CNT(args) > 0 || kbytes <= 0 ||
+        threads <= 0 || threads > PERF_MPOOL_THREADS_MAX) {
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    cli_out("Memory pool, %d KB:\n", kbytes);
+    cli_out("  %-8s %7s %10s %8s %8s %8s %8s %6s %6s\n",
+            "Mode", "Threads", "Ops", "nsec/op", "Failed", "Steps",
+            "Blocks", "Slabs", "Frag");
+    for (mode = 0; mode < 2 && rv == BCMA_CLI_CMD_OK; mode++) {
+        rv = perf_mpool_run(kbytes, 1, count, mode != 0, false);
+        if (rv == BCMA_CLI_CMD_OK && threads > 1) {
+            rv = perf_mpool_run(kbytes, threads, count, mode != 0, false);
+        }
+        if (rv == BCMA_CLI_CMD_OK) {
+            rv = perf_mpool_run(kbytes, threads, count, mode != 0, true);
+        }
+    }
+
+    return rv;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+bcma_shrcmd_shrperf(bcma_cli_t *cli, bcma_cli_args_t *args)
+{
+    bcma_cli_parse_table_t pt;
+    int count = BCMA_SHR_CONFIG_DEFAULT_PERF_COUNT;
+    const char *arg;
+
+    if (cli == NULL || args == NULL) {
+        return BCMA_CLI_CMD_FAIL;
+    }
+
+    bcma_cli_parse_table_init(cli, &pt);
+    bcma_cli_parse_table_add(&pt, "count", "int", &count, NULL);
+    if (bcma_cli_parse_table_do_args(&pt, args) < 0 || count <= 0) {
+        bcma_cli_parse_table_done(&pt);
+        return BCMA_CLI_CMD_USAGE;
+    }
+    bcma_cli_parse_table_done(&pt);
+
+    if ((arg = BCMA_CLI_ARG_GET(args)) == NULL) {
+        return BCMA_CLI_CMD_USAGE;
+    }
+    if (sal_strcasecmp(arg, "mpool") == 0) {
+        return perf_mpool(cli, count, args);
+    }
+
+    return BCMA_CLI_CMD_USAGE;
+}
@@ -839,6 +839,11 @@ bcma_sys_probe(void)
                     LOG_WARN(BSL_LS_SYS_PCI,
                              (BSL_META_U(unit,
                                          "Unable to create DMA mpool.\n")));
+                } else if (shr_mpool_slab_enable(sd->mpool) < 0) {
+                    /* Small DMA buffers will use the first-fit allocator. */
+                    LOG_VERBOSE(BSL_LS_SYS_PCI,
+                                (BSL_META_U(unit,
+                                            "No DMA mpool slabs.\n")));
                 }
             }
 
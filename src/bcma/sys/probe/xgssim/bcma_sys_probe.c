@@ -138,6 +138,26 @@ sim_write(int unit, uint32_t addrx, uint32_t addr, void *data, int size)
     return chelem_write(unit, addrx, addr, data, size);
 }
 
+/*
+ * The simulation environment has no DMA memory of its own, so the
+ * DMA address of a table DMA buffer is its host address.
+ */
+static int
+sim_range_read(int unit, uint32_t addrx, uint32_t addr, uint32_t stride,
+               uint32_t count, uint64_t dma_addr, int size)
+{
+    return chelem_range_read(unit, addrx, addr, stride, count,
+                             (void *)(uintptr_t)dma_addr, size);
+}
+
+static int
+sim_range_write(int unit, uint32_t addrx, uint32_t addr, uint32_t stride,
+                uint32_t count, uint64_t dma_addr, int size)
+{
+    return chelem_range_write(unit, addrx, addr, stride, count,
+                              (void *)(uintptr_t)dma_addr, size);
+}
+
 /*
  * These are the successfully create devices
  */
@@ -156,6 +176,10 @@ bcma_sys_probe_cleanup(void)
 
     for (unit = 0; unit < BCMDRD_CONFIG_MAX_UNITS; unit++) {
         if (bcmdrd_dev_exists(unit)) {
+            LOG_VERBOSE(BSL_LS_SYS_PCI,
+                        (BSL_META_U(unit,
+                                    "Simulator holds %d elements\n"),
+                         chelem_count(unit)));
             bcmdrd_dev_destroy(unit);
         }
     }
@@ -171,9 +195,18 @@ bcma_sys_probe(void)
     bcmdrd_hal_io_t io;
     const char *name;
 
+    /* Create the simulator storage before any device uses it */
+    if (chelem_init() < 0) {
+        LOG_ERROR(BSL_LS_SYS_PCI,
+                  (BSL_META("Failed to initialize simulator storage\n")));
+        return -1;
+    }
+
     /* Install generic simulation hooks */
     bcmbd_simhook_read = sim_read;
     bcmbd_simhook_write = sim_write;
+    bcmbd_simhook_range_read = sim_range_read;
+    bcmbd_simhook_range_write = sim_range_write;
 
     for (edx = 0; edx < BCMDRD_CONFIG_MAX_UNITS; edx++) {
 
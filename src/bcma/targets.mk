@@ -96,6 +96,12 @@ BCMA_DEFAULT_TARGETS = \
 	sys \
 	bcmlt \
 	bcmpkt \
+	bcmptm \
+	bcmlm \
+	bcmevm \
+	bcmimm \
+	bcmecmp \
+	shr \
 	cint \
 	bcmpc \
 	bcmbd \
@@ -93,6 +93,7 @@
 
 #include <bcmbd/bcmbd_cmicx.h>
 #include <bcmbd/bcmbd_cmicx_mem.h>
+#include <bcmbd/bcmbd_simhook.h>
 
 #include "bcmbd_cmicx_schan.h"
 #include "bcmbd_cmicx_sbusdma.h"
@@ -103,6 +104,51 @@
 #define SBUSDMA_MEM_READ        0
 #define SBUSDMA_MEM_WRITE       1
 
+/*
+ * Simulated table DMA. The entries are moved in one hook call unless
+ * all of them share a single buffer entry.
+ */
+static int
+bcmbd_cmicx_mem_range_sim_op(int unit, uint32_t adext, uint32_t addr,
+                             size_t wsize, uint32_t shift, uint32_t count,
+                             uint64_t buf_paddr, uint32_t flags, bool write)
+{
+    uint32_t stride = 1U << shift;
+    uint32_t idx;
+    int size = BCMDRD_WORDS2BYTES(wsize);
+    int rv;
+
+    adext |= BCMBD_SIM_SOC_MEM;
+    if (flags & USE_SINGLE_ADDR) {
+        stride = 0;
+    } else if (flags & USE_INVERS_ADDR) {
+        stride = 0U - stride;
+    }
+
+    if ((flags & USE_SINGLE_DATA) == 0) {
+        if (write) {
+            return bcmbd_simhook_range_write(unit, adext, addr, stride,
+                                             count, buf_paddr, size);
+        }
+        return bcmbd_simhook_range_read(unit, adext, addr, stride,
+                                        count, buf_paddr, size);
+    }
+
+    for (idx = 0; idx < count; idx++) {
+        if (write) {
+            rv = bcmbd_simhook_range_write(unit, adext, addr + idx * stride,
+                                           0, 1, buf_paddr, size);
+        } else {
+            rv = bcmbd_simhook_range_read(unit, adext, addr + idx * stride,
+                                          0, 1, buf_paddr, size);
+        }
+        if (rv < 0) {
+            return rv;
+        }
+    }
+    return SHR_E_NONE;
+}
+
 static int
 bcmbd_cmicx_mem_range_op(int unit, uint32_t adext, uint32_t addr,
                          size_t wsize, uint32_t shift, uint32_t count,
@@ -119,6 +165,12 @@ bcmbd_cmicx_mem_range_op(int unit, uint32_t adext, uint32_t addr,
         return SHR_E_NONE;
     }
 
+    /* Simulator hooks */
+    if (bcmbd_simhook_range_read && bcmbd_simhook_range_write) {
+        return bcmbd_cmicx_mem_range_sim_op(unit, adext, addr, wsize, shift,
+                                            count, buf_paddr, flags, write);
+    }
+
     /* Initialize sbusdma work */
     sal_memset(&data, 0, sizeof(data));
     sal_memset(&work, 0, sizeof(work));
@@ -152,4 +152,46 @@ extern int (*bcmbd_simhook_read)(int unit, uint32_t addrx, uint32_t addr,
 extern int (*bcmbd_simhook_write)(int unit, uint32_t addrx, uint32_t addr,
                                   void *vptr, int size);
 
+/*!
+ * \brief Simulator hook for reading a range of memory entries.
+ *
+ * Replaces a table DMA read. Entry \c n is read from address \c addr +
+ * \c n * \c stride (modulo 2^32) into entry \c n of the DMA buffer.
+ *
+ * \param [in] unit Unit number
+ * \param [in] addrx Address extension (bits [47:32]).
+ * \param [in] addr Address of the first entry.
+ * \param [in] stride Address increment between entries.
+ * \param [in] count Number of entries.
+ * \param [in] dma_addr DMA address of the entry buffer.
+ * \param [in] size Size of one entry.
+ *
+ * \return 0 if no errors, otherwise a negative value.
+ */
+extern int (*bcmbd_simhook_range_read)(int unit, uint32_t addrx,
+                                       uint32_t addr, uint32_t stride,
+                                       uint32_t count, uint64_t dma_addr,
+                                       int size);
+
+/*!
+ * \brief Simulator hook for writing a range of memory entries.
+ *
+ * Replaces a table DMA write. Entry \c n of the DMA buffer is written
+ * to address \c addr + \c n * \c stride (modulo 2^32).
+ *
+ * \param [in] unit Unit number
+ * \param [in] addrx Address extension (bits [47:32]).
+ * \param [in] addr Address of the first entry.
+ * \param [in] stride Address increment between entries.
+ * \param [in] count Number of entries.
+ * \param [in] dma_addr DMA address of the entry buffer.
+ * \param [in] size Size of one entry.
+ *
+ * \return 0 if no errors, otherwise a negative value.
+ */
+extern int (*bcmbd_simhook_range_write)(int unit, uint32_t addrx,
+                                        uint32_t addr, uint32_t stride,
+                                        uint32_t count, uint64_t dma_addr,
+                                        int size);
+
 #endif /* BCMBD_SIMHOOK_H */
@@ -95,3 +95,9 @@ int (*bcmbd_simhook_read)(int unit, uint32_t addrx, uint32_t addr,
                           void *vptr, int size);
 int (*bcmbd_simhook_write)(int unit, uint32_t addrx, uint32_t addr,
                            void *vptr, int size);
+int (*bcmbd_simhook_range_read)(int unit, uint32_t addrx, uint32_t addr,
+                                uint32_t stride, uint32_t count,
+                                uint64_t dma_addr, int size);
+int (*bcmbd_simhook_range_write)(int unit, uint32_t addrx, uint32_t addr,
+                                 uint32_t stride, uint32_t count,
+                                 uint64_t dma_addr, int size);
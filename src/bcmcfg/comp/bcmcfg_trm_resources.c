@@ -111,16 +111,23 @@ static const bcmcfg_comp_node_t bcmcfg_trm_resources_schema[] = {
     {
         .node = BCMCFG_COMP_SCALAR,
         .key = "max_transactions",
-        .next = BCMCFG_NO_IDX,
+        .next = 3,
         .offset = offsetof(bcmcfg_trm_resources_config_t, max_transactions),
         .size = sizeof(((bcmcfg_trm_resources_config_t *)0)->max_transactions),
     }, /* max_transactions 2 */
+    {
+        .node = BCMCFG_COMP_SCALAR,
+        .key = "inline_sync_commit",
+        .next = BCMCFG_NO_IDX,
+        .offset = offsetof(bcmcfg_trm_resources_config_t, inline_sync_commit),
+        .size = sizeof(((bcmcfg_trm_resources_config_t *)0)->inline_sync_commit),
+    }, /* inline_sync_commit 3 */
 };
 
 static bcmcfg_trm_resources_config_t *bcmcfg_trm_resources_data;
 
 const bcmcfg_comp_scanner_t bcmcfg_trm_resources_scanner = {
-    .schema_count = 3,
+    .schema_count = 4,
     .schema = bcmcfg_trm_resources_schema,
     .data_size = sizeof(*bcmcfg_trm_resources_data),
     .data = (uint32_t **)(char *)&bcmcfg_trm_resources_data,
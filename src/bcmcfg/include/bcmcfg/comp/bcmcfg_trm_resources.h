@@ -97,6 +97,7 @@
 typedef struct bcmcfg_trm_resources_config_s {
     uint32_t max_entries;
     uint32_t max_transactions;
+    uint32_t inline_sync_commit;
 } bcmcfg_trm_resources_config_t;
 
 extern const bcmcfg_trm_resources_config_t *
@@ -722,6 +722,134 @@ cmicd_pdma_pkt_xmit(struct pdma_hw *hw, struct pdma_tx_queue *txq, void *buf)
     return SHR_E_NONE;
 }
 
+/*!
+ * \brief Start transmission of a burst of packets
+ *
+ * Set up one descriptor per packet while the ring has room and kick off
+ * the DMA once for the whole burst.
+ *
+ * \param [in] hw HW structure point.
+ * \param [in] txq Tx queue structure point.
+ * \param [in] bufs Tx packet buffers.
+ * \param [in] num Number of Tx packet buffers.
+ *
+ * \retval Number of packets consumed.
+ * \retval SHR_E_XXXX Operation failed.
+ */
+static int
+cmicd_pdma_pkt_burst_xmit(struct pdma_hw *hw, struct pdma_tx_queue *txq,
+                           void **bufs, int num)
+{
+    struct pdma_dev *dev = hw->dev;
+    struct cmicd_tx_desc *ring = (struct cmicd_tx_desc *)txq->ring;
+    struct pdma_tx_buf *pbuf = NULL;
+    struct pkt_hdr *pkh = NULL;
+    dma_addr_t addr;
+    uint32_t curr, flags;
+    int done, rv;
+
+    if (!(txq->state & PDMA_TX_QUEUE_ACTIVE)) {
+        return SHR_E_UNAVAIL;
+    }
+
+    /* Chain mode restarts the channel per packet */
+    if (dev->flags & PDMA_CHAIN_MODE) {
+        for (done = 0; done < num; done++) {
+            rv = cmicd_pdma_pkt_xmit(hw, txq, bufs[done]);
+            if (SHR_FAILURE(rv)) {
+                return done ? done : rv;
+            }
+        }
+        return done;
+    }
+
+    if (dev->tx_suspend) {
+        sal_spinlock_lock(txq->mutex);
+    } else {
+        sal_sem_take(txq->sem, SAL_SEM_FOREVER);
+    }
+
+    /* Suspend Tx if no resource */
+    if (dev->tx_suspend) {
+        rv = cmicd_pdma_tx_ring_check(hw, txq);
+        if (SHR_FAILURE(rv)) {
+            sal_spinlock_unlock(txq->mutex);
+            return rv;
+        }
+    }
+
+    /* Setup the new descriptors */
+    curr = txq->curr;
+    for (done = 0; done < num; done++) {
+        if (!cmicd_pdma_tx_ring_unused(txq)) {
+            if (!(txq->state & PDMA_TX_QUEUE_POLL)) {
+                break;
+            }
+            cmicd_pdma_tx_ring_clean(hw, txq, txq->nb_desc - txq->free_thresh);
+            if (!cmicd_pdma_tx_ring_unused(txq)) {
+                break;
+            }
+        }
+
+        pbuf = &txq->pbuf[curr];
+        pbuf->adj = 0;
+        pkh = bcmcnet_tx_buff_get(txq, pbuf, bufs[done]);
+        if (!pkh) {
+            txq->stats.dropped++;
+            continue;
+        }
+        bcmcnet_tx_buff_dma(txq, pbuf, &addr);
+        flags = 0;
+        flags |= pkh->attrs & PDMA_TX_HIGIG_PKT ? CMICD_DESC_TX_HIGIG_PKT : 0;
+        flags |= pkh->attrs & PDMA_TX_PAUSE_PKT ? CMICD_DESC_TX_PAUSE_PKT : 0;
+        flags |= pkh->attrs & PDMA_TX_PURGE_PKT ? CMICD_DESC_TX_PURGE_PKT : 0;
+        cmicd_tx_desc_config(&ring[curr], addr, pbuf->len, flags);
+        if (pkh->meta_len) {
+            sal_memcpy(&ring[curr].md, &pbuf->pkb->data, sizeof(ring->md.data));
+        }
+
+        /* Count the packets/bytes */
+        txq->stats.packets++;
+        txq->stats.bytes += pbuf->len;
+
+        /* Update the indicators */
+        curr = (curr + 1) % txq->nb_desc;
+        txq->curr = curr;
+    }
+
+    /* Kick off DMA once for the burst */
+    txq->halt_addr = txq->ring_addr + sizeof(struct cmicd_tx_desc) * curr;
+    hw->hdls.chan_goto(hw, txq->chan_id, txq->halt_addr);
+
+    if (txq->state & PDMA_TX_QUEUE_POLL &&
+        cmicd_pdma_tx_ring_unused(txq) <= (int)txq->free_thresh) {
+        cmicd_pdma_tx_ring_clean(hw, txq, txq->nb_desc - txq->free_thresh);
+    }
+
+    /* Suspend Tx if no resource */
+    rv = cmicd_pdma_tx_ring_check(hw, txq);
+    if (SHR_FAILURE(rv)) {
+        /* In polling mode, must wait till the ring is available */
+        if (txq->state & PDMA_TX_QUEUE_POLL) {
+            do {
+                cmicd_pdma_tx_ring_clean(hw, txq, txq->free_thresh);
+            } while (txq->state & PDMA_TX_QUEUE_XOFF);
+        }
+
+        if (!dev->tx_suspend) {
+            return done;
+        }
+    }
+
+    if (dev->tx_suspend) {
+        sal_spinlock_unlock(txq->mutex);
+    } else {
+        sal_sem_give(txq->sem);
+    }
+
+    return done;
+}
+
 /*!
  * Suspend Rx queue
  */
@@ -788,6 +916,7 @@ bcmcnet_cmicd_pdma_desc_ops_init(struct pdma_hw *hw)
     hw->dops.tx_ring_clean = cmicd_pdma_tx_ring_clean;
     hw->dops.tx_ring_dump = cmicd_pdma_tx_ring_dump;
     hw->dops.pkt_xmit = cmicd_pdma_pkt_xmit;
+    hw->dops.pkt_burst_xmit = cmicd_pdma_pkt_burst_xmit;
 
     return SHR_E_NONE;
 }
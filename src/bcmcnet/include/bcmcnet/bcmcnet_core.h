@@ -490,6 +490,11 @@ typedef int (*reg32_write_t)(struct pdma_dev *dev, uint32_t addr, uint32_t data)
 typedef int (*pdma_rx_t)(struct pdma_dev *dev, int queue, void *buf);
 /*! Packet transmission */
 typedef int (*pdma_tx_t)(struct pdma_dev *dev, int queue, void *buf);
+/*! Packet burst transmission */
+typedef int (*pdma_tx_burst_t)(struct pdma_dev *dev, int queue,
+                               void **bufs, int num);
+/*! End of a packet reception pass */
+typedef void (*pdma_rx_done_t)(struct pdma_dev *dev, int queue);
 /*! Tx suspend */
 typedef void (*sys_tx_suspend_t)(struct pdma_dev *dev, int queue);
 /*! Tx resume */
@@ -544,6 +549,12 @@ struct pdma_dev {
     /*! Packet transmission */
     pdma_tx_t pkt_xmit;
 
+    /*! Packet burst transmission */
+    pdma_tx_burst_t pkt_burst_xmit;
+
+    /*! End of a packet reception pass */
+    pdma_rx_done_t pkt_recv_done;
+
     /*! Tx suspend */
     sys_tx_suspend_t tx_suspend;
 
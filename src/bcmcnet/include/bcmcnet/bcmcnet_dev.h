@@ -233,6 +233,10 @@ struct desc_operations {
 
     /*! Tx transmit */
     int (*pkt_xmit)(struct pdma_hw *, struct pdma_tx_queue *, void *);
+
+    /*! Tx burst transmit */
+    int (*pkt_burst_xmit)(struct pdma_hw *, struct pdma_tx_queue *,
+                          void **, int);
 };
 
 /*!
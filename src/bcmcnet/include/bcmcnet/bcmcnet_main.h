@@ -218,6 +218,9 @@ struct bcmcnet_rcpu_hdr {
 /*! Function type for RX packet processing callbacks */
 typedef int (*bcmcnet_rx_cb_t)(int unit, int queue, bcmpkt_data_buf_t *buf, void *ck);
 
+/*! Function type for end of RX polling pass callbacks */
+typedef void (*bcmcnet_rx_done_cb_t)(int unit, int queue, void *ck);
+
 /*!
  * \brief Callbacks information structure.
  */
@@ -225,6 +228,9 @@ typedef struct bcmcnet_rx_cbs_s {
     /*! Callback */
     bcmcnet_rx_cb_t cb;
 
+    /*! End of polling pass callback */
+    bcmcnet_rx_done_cb_t done;
+
     /*! Callback parameter */
     void *ck;
 } bcmcnet_rx_cbs_t;
@@ -346,6 +352,25 @@ bcmcnet_rx_cb_register(int unit, bcmcnet_rx_cb_t cb, void *ck);
 extern int
 bcmcnet_rx_cb_unregister(int unit, bcmcnet_rx_cb_t cb, void *ck);
 
+/*!
+ * \brief Set the end of polling pass callback of a registered callback.
+ *
+ * The done callback is invoked after each Rx polling pass which delivered
+ * at least one packet on a queue. Receivers which collect packets into
+ * vectors use it to flush the packets of the pass.
+ *
+ * \param [in] unit Device number.
+ * \param [in] cb Registered callback.
+ * \param [in] done End of polling pass callback.
+ * \param [in] ck Callback parameter.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_XXXX Operation failed.
+ */
+extern int
+bcmcnet_rx_done_cb_set(int unit, bcmcnet_rx_cb_t cb,
+                       bcmcnet_rx_done_cb_t done, void *ck);
+
 /*!
  * \brief Sent a Tx packet to the the core networking subsystem.
  *
@@ -359,6 +384,24 @@ bcmcnet_rx_cb_unregister(int unit, bcmcnet_rx_cb_t cb, void *ck);
 extern int
 bcmcnet_tx(int unit, int queue, bcmpkt_data_buf_t *buf);
 
+/*!
+ * \brief Send a burst of Tx packets to the core networking subsystem.
+ *
+ * The packets are placed on the Tx ring and the DMA is kicked off once
+ * per burst instead of once per packet. Packets bound to another queue
+ * by their RCPU header are sent individually.
+ *
+ * \param [in] unit Device number.
+ * \param [in] queue Tx queue.
+ * \param [in] bufs Array of Tx packet buffer points.
+ * \param [in] num Number of Tx packet buffers.
+ *
+ * \retval Number of packet buffers consumed.
+ * \retval SHR_E_XXXX Operation failed before any buffer was consumed.
+ */
+extern int
+bcmcnet_tx_burst(int unit, int queue, bcmpkt_data_buf_t **bufs, int num);
+
 /*!
  * \brief Get the core networking subsystem information.
  *
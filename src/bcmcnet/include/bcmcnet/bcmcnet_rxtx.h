@@ -462,6 +462,24 @@ bcmcnet_pdma_tx_queue_wakeup(struct pdma_dev *dev, int queue);
 extern int
 bcmcnet_pdma_tx_queue_xmit(struct pdma_dev *dev, int queue, void *buf);
 
+/*!
+ * \brief Start Tx queue transmission of a burst of packets.
+ *
+ * The descriptors of all the packets are set up before the DMA is
+ * kicked off once for the whole burst.
+ *
+ * \param [in] dev Device structure point.
+ * \param [in] queue Tx queue number.
+ * \param [in] bufs Tx packet buffers.
+ * \param [in] num Number of Tx packet buffers.
+ *
+ * \retval Number of packets consumed (may be less than num if the ring
+ *          is full), or SHR_E_XXXX if no packet could be transmitted.
+ */
+extern int
+bcmcnet_pdma_tx_queue_xmit_burst(struct pdma_dev *dev, int queue,
+                                 void **bufs, int num);
+
 /*!
  * \brief Poll Rx queue.
  *
@@ -1008,6 +1008,7 @@ bcmcnet_pdma_open(struct pdma_dev *dev)
     bcn_tx_queues_alloc(dev);
 
     dev->pkt_xmit = bcmcnet_pdma_tx_queue_xmit;
+    dev->pkt_burst_xmit = bcmcnet_pdma_tx_queue_xmit_burst;
 
     return SHR_E_NONE;
 }
@@ -223,6 +223,11 @@ bcmcnet_tx_pkt_process(struct pdma_dev *dev, bcmpkt_data_buf_t *buf)
     struct pkt_hdr *pkh = (struct pkt_hdr *)buf->data;
     unsigned char *rcpu_hdr = (unsigned char *)rch;
 
+    if (pkh->attrs & PDMA_TX_HDR_COOKED) {
+        /* Resumed packet */
+        return SHR_E_NONE;
+    }
+
     pkh->data_len = (rcpu_hdr[24] << 8 | rcpu_hdr[25]) + ETH_FCS_LEN;
     pkh->meta_len = rch->meta_len;
     pkh->attrs = 0;
@@ -240,6 +245,9 @@ bcmcnet_tx_pkt_process(struct pdma_dev *dev, bcmpkt_data_buf_t *buf)
         pkh->attrs |= PDMA_TX_BIND_QUE;
     }
 
+    /* Packet header done here */
+    pkh->attrs |= PDMA_TX_HDR_COOKED;
+
     return SHR_E_NONE;
 }
 
@@ -285,6 +293,23 @@ bcmcnet_pkt_recv(struct pdma_dev *dev, int queue, void *buf)
     return SHR_E_FAIL;
 }
 
+/*!
+ * End of a packet reception pass
+ */
+static void
+bcmcnet_pkt_recv_done(struct pdma_dev *dev, int queue)
+{
+    struct bcmcnet_rx_cbs_s *cbs;
+    int ci;
+
+    for (ci = 0; ci < NUM_RX_CB_MAX; ci++) {
+        cbs = &rx_cbs[ci];
+        if (cbs->cb != NULL && cbs->done != NULL) {
+            cbs->done(dev->unit, queue, cbs->ck);
+        }
+    }
+}
+
 /*!
  * Enable a set of interrupts
  */
@@ -405,6 +430,7 @@ bcmcnet_dev_init(int unit, bcmcnet_dev_cfg_t *dev_cfg)
     dev->dev_read32 = bcmcnet_dev_read32;
     dev->dev_write32 = bcmcnet_dev_write32;
     dev->pkt_recv = bcmcnet_pkt_recv;
+    dev->pkt_recv_done = bcmcnet_pkt_recv_done;
     dev->intr_unmask = bcmcnet_sys_intr_enable;
     dev->intr_mask = bcmcnet_sys_intr_disable;
 
@@ -745,6 +771,7 @@ bcmcnet_rx_cb_unregister(int unit, bcmcnet_rx_cb_t cb, void *ck)
         cbs = &rx_cbs[ci];
         if (cbs->cb == cb && cbs->ck == ck) {
             cbs->cb = NULL;
+            cbs->done = NULL;
             cbs->ck = NULL;
         }
     }
@@ -752,6 +779,32 @@ bcmcnet_rx_cb_unregister(int unit, bcmcnet_rx_cb_t cb, void *ck)
     return SHR_E_NONE;
 }
 
+/*!
+ * Set the end of polling pass callback of a Rx callback
+ */
+int
+bcmcnet_rx_done_cb_set(int unit, bcmcnet_rx_cb_t cb,
+                       bcmcnet_rx_done_cb_t done, void *ck)
+{
+    struct pdma_dev *dev = &pdma_devices[unit];
+    struct bcmcnet_rx_cbs_s *cbs;
+    int ci;
+
+    if (!dev->attached) {
+        return SHR_E_UNAVAIL;
+    }
+
+    for (ci = 0; ci < NUM_RX_CB_MAX; ci++) {
+        cbs = &rx_cbs[ci];
+        if (cbs->cb == cb && cbs->ck == ck) {
+            cbs->done = done;
+            return SHR_E_NONE;
+        }
+    }
+
+    return SHR_E_NOT_FOUND;
+}
+
 /*!
  * Send a packet on a Tx queue
  */
@@ -800,6 +853,68 @@ bcmcnet_tx(int unit, int queue, bcmpkt_data_buf_t *buf)
     return dev->pkt_xmit(dev, queue, buf);
 }
 
+/*!
+ * Send a burst of packets on a Tx queue
+ */
+int
+bcmcnet_tx_burst(int unit, int queue, bcmpkt_data_buf_t **bufs, int num)
+{
+    struct pdma_dev *dev = &pdma_devices[unit];
+    struct dev_ctrl *ctrl = &dev->ctrl;
+    struct pkt_hdr *pkh = NULL;
+    int done, run, bi;
+    int rv;
+
+    if (!dev->attached) {
+        return SHR_E_UNAVAIL;
+    }
+
+    if (queue < 0 || queue > (int)ctrl->nb_txq || bufs == NULL || num <= 0) {
+        return SHR_E_PARAM;
+    }
+    for (bi = 0; bi < num; bi++) {
+        if (bufs[bi] == NULL) {
+            return SHR_E_PARAM;
+        }
+    }
+
+    if (!dev->pkt_xmit || !dev->pkt_burst_xmit) {
+        return SHR_E_INTERNAL;
+    }
+
+    for (done = 0; done < num; done = run) {
+        /* Prepare the packets up to the next queue bound one */
+        for (run = done; run < num; run++) {
+            bcmcnet_tx_pkt_process(dev, bufs[run]);
+            pkh = (struct pkt_hdr *)bufs[run]->data;
+            if (pkh->attrs & PDMA_TX_BIND_QUE) {
+                break;
+            }
+        }
+
+        /* Transmit the prepared packets, waiting for ring space */
+        while (done < run) {
+            rv = dev->pkt_burst_xmit(dev, queue, (void **)&bufs[done],
+                                     run - done);
+            if (SHR_FAILURE(rv) || rv == 0) {
+                return done ? done : rv;
+            }
+            done += rv;
+        }
+
+        /* Transmit the queue bound packet on its own queue */
+        if (run < num) {
+            rv = dev->pkt_xmit(dev, pkh->queue_id, bufs[run]);
+            if (SHR_FAILURE(rv)) {
+                return done ? done : rv;
+            }
+            run++;
+        }
+    }
+
+    return done;
+}
+
 /*!
  * Get device information
  */
@@ -244,8 +244,17 @@ bcn_rx_poll(struct pdma_rx_queue *rxq, int budget)
 {
     struct dev_ctrl *ctrl = rxq->ctrl;
     struct pdma_hw *hw = (struct pdma_hw *)ctrl->hw;
+    struct pdma_dev *dev = ctrl->dev;
+    int done;
 
-    return hw->dops.rx_ring_clean(hw, rxq, budget);
+    done = hw->dops.rx_ring_clean(hw, rxq, budget);
+
+    /* Let the receivers flush the packets collected in this pass */
+    if (done > 0 && dev->pkt_recv_done) {
+        dev->pkt_recv_done(dev, rxq->queue_id);
+    }
+
+    return done;
 }
 
 /*!
@@ -517,6 +526,37 @@ bcmcnet_pdma_tx_queue_xmit(struct pdma_dev *dev, int queue, void *buf)
     return hw->dops.pkt_xmit(hw, txq, buf);
 }
 
+/*!
+ * Transmit a burst of outputing packets
+ */
+int
+bcmcnet_pdma_tx_queue_xmit_burst(struct pdma_dev *dev, int queue,
+                                 void **bufs, int num)
+{
+    struct dev_ctrl *ctrl = &dev->ctrl;
+    struct pdma_hw *hw = (struct pdma_hw *)ctrl->hw;
+    struct pdma_tx_queue *txq = NULL;
+    int done, rv;
+
+    txq = (struct pdma_tx_queue *)ctrl->tx_queue[queue];
+    if (!txq || !(txq->state & PDMA_TX_QUEUE_ACTIVE)) {
+        return SHR_E_UNAVAIL;
+    }
+
+    if (hw->dops.pkt_burst_xmit) {
+        return hw->dops.pkt_burst_xmit(hw, txq, bufs, num);
+    }
+
+    for (done = 0; done < num; done++) {
+        rv = hw->dops.pkt_xmit(hw, txq, bufs[done]);
+        if (SHR_FAILURE(rv)) {
+            return done ? done : rv;
+        }
+    }
+
+    return done;
+}
+
 /*!
  * Poll a Rx queues
  */
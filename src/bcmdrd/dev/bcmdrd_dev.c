@@ -221,6 +221,11 @@ bcmdrd_dev_destroy(int unit)
     }
 
     dev = &bcmdrd_dev[unit];
+#if BCMDRD_CONFIG_INCLUDE_CHIP_SYMBOLS == 1
+    if (dev->chip_info && dev->chip_info->symbols) {
+        (void)bcmdrd_symbols_index_destroy(dev->chip_info->symbols);
+    }
+#endif
     sal_memset(dev, 0, sizeof(*dev));
 
     return SHR_E_NONE;
@@ -267,6 +272,16 @@ bcmdrd_dev_create(int unit, bcmdrd_dev_id_t *id)
 
         dev_valid_pipes_set(dev);
 
+#if BCMDRD_CONFIG_INCLUDE_CHIP_SYMBOLS == 1
+        /* The name index is an optimization, so failure is not fatal */
+        if (dev->chip_info->symbols &&
+            SHR_FAILURE(bcmdrd_symbols_index_create(dev->chip_info->symbols))) {
+            LOG_WARN(BSL_LS_BCMDRD_DEV,
+                     (BSL_META_U(unit,
+                                 "Failed to create symbol name index\n")));
+        }
+#endif
+
         /* Reset feature list */
         bcmdrd_feature_disable(unit, BCMDRD_FT_ALL);
 
@@ -608,6 +608,37 @@ extern const bcmdrd_symbol_t *
 bcmdrd_symbols_find(const char *name, const bcmdrd_symbols_t *symbols,
                     bcmdrd_sid_t *sid);
 
+/*!
+ * \brief Create a name index for a symbol table.
+ *
+ * Build a perfect hash index of all symbol names (including alias
+ * names) which allows \ref bcmdrd_symbols_find to find a symbol with a
+ * single string compare. Symbol tables without an index are searched
+ * linearly.
+ *
+ * The index is reference counted, so units of the same chip share a
+ * single index.
+ *
+ * \param [in] symbols Symbol table structure.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_MEMORY Insufficient memory.
+ * \retval SHR_E_RESOURCE Too many symbol tables are indexed.
+ */
+extern int
+bcmdrd_symbols_index_create(const bcmdrd_symbols_t *symbols);
+
+/*!
+ * \brief Release the name index of a symbol table.
+ *
+ * \param [in] symbols Symbol table structure.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_NOT_FOUND Symbol table has no index.
+ */
+extern int
+bcmdrd_symbols_index_destroy(const bcmdrd_symbols_t *symbols);
+
 /*!
  * \brief Get a specific symbol by index.
  *
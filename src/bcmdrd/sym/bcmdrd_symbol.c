@@ -90,15 +90,56 @@
  */
 
 #include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
 #include <sal/sal_assert.h>
 
 #include <shr/shr_error.h>
+#include <shr/shr_mph.h>
 
 #include <bcmdrd/bcmdrd_field.h>
 #include <bcmdrd/bcmdrd_symbols.h>
 
 #if BCMDRD_CONFIG_INCLUDE_CHIP_SYMBOLS == 1
 
+/* Symbol name index of a symbol table (shared by units of the same chip). */
+typedef struct sym_index_s {
+    const bcmdrd_symbols_t *symbols;
+    shr_mph_t *mph;
+    int ref_cnt;
+} sym_index_t;
+
+static sym_index_t sym_index[BCMDRD_CONFIG_MAX_UNITS];
+
+static sym_index_t *
+sym_index_find(const bcmdrd_symbols_t *symbols)
+{
+    int idx;
+
+    for (idx = 0; idx < BCMDRD_CONFIG_MAX_UNITS; idx++) {
+        if (sym_index[idx].symbols == symbols) {
+            return &sym_index[idx];
+        }
+    }
+    return NULL;
+}
+
+static int
+sym_match(const bcmdrd_symbol_t *sym, const char *name)
+{
+    if (sal_strcmp(sym->name, name) == 0) {
+        return 1;
+    }
+#if BCMDRD_CONFIG_INCLUDE_ALIAS_NAMES == 1
+    if (sym->ufname && sal_strcmp(sym->ufname, name) == 0) {
+        return 1;
+    }
+    if (sym->alias && sal_strcmp(sym->alias, name) == 0) {
+        return 1;
+    }
+#endif
+    return 0;
+}
+
 static const bcmdrd_symbol_t *
 symbol_from_sid(const bcmdrd_symbols_t *symbols, bcmdrd_sid_t sid)
 {
@@ -153,18 +194,10 @@ bcmdrd_symbol_find(const char *name,
     assert(table);
 
     for (idx = 0; idx < size; idx++) {
-	if (sal_strcmp(sym->name, name) == 0) {
-	    break;
-	}
-#if BCMDRD_CONFIG_INCLUDE_ALIAS_NAMES == 1
-	if (sym->ufname && sal_strcmp(sym->ufname, name) == 0) {
-	    break;
-	}
-	if (sym->alias && sal_strcmp(sym->alias, name) == 0) {
-	    break;
-	}
-#endif
-	sym++;
+        if (sym_match(sym, name)) {
+            break;
+        }
+        sym++;
     }
     if (idx >= size) {
         sym = NULL;
@@ -178,11 +211,105 @@ const bcmdrd_symbol_t *
 bcmdrd_symbols_find(const char *name, const bcmdrd_symbols_t *symbols,
                     bcmdrd_sid_t *sid)
 {
+    sym_index_t *si;
+    const bcmdrd_symbol_t *sym;
+    uint32_t idx;
+
     if (symbols == NULL || symbols->symbols == NULL) {
         return NULL;
     }
 
-    return bcmdrd_symbol_find(name, symbols->symbols, symbols->size, sid);
+    si = sym_index_find(symbols);
+    if (si == NULL ||
+        shr_mph_lookup(si->mph, 0, name, &idx) != SHR_E_NONE) {
+        return bcmdrd_symbol_find(name, symbols->symbols, symbols->size, sid);
+    }
+
+    /* Every indexed name maps to its own symbol, so one compare is enough */
+    sym = &symbols->symbols[idx];
+    if (!sym_match(sym, name)) {
+        return NULL;
+    }
+    if (sid) {
+        *sid = idx;
+    }
+    return sym;
+}
+
+int
+bcmdrd_symbols_index_create(const bcmdrd_symbols_t *symbols)
+{
+    sym_index_t *si;
+    shr_mph_key_t *keys;
+    const bcmdrd_symbol_t *sym;
+    uint32_t idx, num_keys = 0;
+    int rv;
+
+    if (symbols == NULL || symbols->symbols == NULL) {
+        return SHR_E_PARAM;
+    }
+
+    si = sym_index_find(symbols);
+    if (si) {
+        si->ref_cnt++;
+        return SHR_E_NONE;
+    }
+    si = sym_index_find(NULL);
+    if (si == NULL) {
+        return SHR_E_RESOURCE;
+    }
+
+    /* Up to three names per symbol */
+    keys = sal_alloc(sizeof(*keys) * symbols->size * 3, "bcmdrdSymIdx");
+    if (keys == NULL) {
+        return SHR_E_MEMORY;
+    }
+    sal_memset(keys, 0, sizeof(*keys) * symbols->size * 3);
+    for (idx = 0; idx < symbols->size; idx++) {
+        sym = &symbols->symbols[idx];
+        keys[num_keys].str = sym->name;
+        keys[num_keys++].val = idx;
+#if BCMDRD_CONFIG_INCLUDE_ALIAS_NAMES == 1
+        if (sym->ufname) {
+            keys[num_keys].str = sym->ufname;
+            keys[num_keys++].val = idx;
+        }
+        if (sym->alias) {
+            keys[num_keys].str = sym->alias;
+            keys[num_keys++].val = idx;
+        }
+#endif
+    }
+    /* Duplicate names keep the first symbol, same as the linear search */
+    rv = shr_mph_create(keys, num_keys, &si->mph);
+    sal_free(keys);
+    if (SHR_FAILURE(rv)) {
+        return rv;
+    }
+    si->symbols = symbols;
+    si->ref_cnt = 1;
+    return SHR_E_NONE;
+}
+
+int
+bcmdrd_symbols_index_destroy(const bcmdrd_symbols_t *symbols)
+{
+    sym_index_t *si;
+
+    if (symbols == NULL) {
+        return SHR_E_PARAM;
+    }
+    si = sym_index_find(symbols);
+    if (si == NULL) {
+        return SHR_E_NOT_FOUND;
+    }
+    if (--si->ref_cnt > 0) {
+        return SHR_E_NONE;
+    }
+    si->symbols = NULL;
+    shr_mph_destroy(si->mph);
+    si->mph = NULL;
+    return SHR_E_NONE;
 }
 
 int
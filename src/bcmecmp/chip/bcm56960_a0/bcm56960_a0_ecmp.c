@@ -101,6 +101,7 @@
 #include <bcmltd/chip/bcmltd_id.h>
 #include <bcmlrd/bcmlrd_map.h>
 #include <bcmecmp/bcmecmp_db_internal.h>
+#include <bcmecmp/bcmecmp_ext.h>
 #include "bcm56960_a0_ecmp.h"
 
 /*******************************************************************************
@@ -3717,6 +3718,11 @@ bcm56960_a0_ecmp_entries_init(int unit, bool warm)
          tbl_size * sizeof(bcmecmp_hw_entry_info_t),
          "bcmecmpBcm56960MembTblBk");
 
+    /* Create free extent index for Member Table entries array. */
+    SHR_IF_ERR_EXIT
+        (bcmecmp_ext_create(unit, tbl_ptr->ent_arr, (int)tbl_size,
+                            &tbl_ptr->ext));
+
     /* Allocate memory for Group Table entries arrary. */
     tbl_ptr = BCMECMP_TBL_PTR(unit, group, BCMECMP_GRP_TYPE_SINGLE);
     tbl_size = (size_t) BCMECMP_TBL_SIZE(unit, group, BCMECMP_GRP_TYPE_SINGLE);
@@ -3758,6 +3764,8 @@ bcm56960_a0_ecmp_entries_init(int unit, bool warm)
         (BCMECMP_TBL_PTR
             (unit, member, BCMECMP_GRP_TYPE_OVERLAY))->ent_bk_arr
                                                         = tbl_ptr->ent_bk_arr;
+        (BCMECMP_TBL_PTR
+            (unit, member, BCMECMP_GRP_TYPE_OVERLAY))->ext = tbl_ptr->ext;
 
         /*
          * Initialize Underlay Member table entries array pointer.
@@ -3772,6 +3780,8 @@ bcm56960_a0_ecmp_entries_init(int unit, bool warm)
         (BCMECMP_TBL_PTR
             (unit, member, BCMECMP_GRP_TYPE_UNDERLAY))->ent_bk_arr
                                                         = tbl_ptr->ent_bk_arr;
+        (BCMECMP_TBL_PTR
+            (unit, member, BCMECMP_GRP_TYPE_UNDERLAY))->ext = tbl_ptr->ext;
 
         /* Get single level ECMP Group table pointer. */
         tbl_ptr = BCMECMP_TBL_PTR(unit, group, BCMECMP_GRP_TYPE_SINGLE);
@@ -3840,6 +3850,7 @@ bcm56960_a0_ecmp_entries_cleanup(int unit)
         tbl_ptr = BCMECMP_TBL_PTR(unit, member, BCMECMP_GRP_TYPE_OVERLAY);
         tbl_ptr->ent_arr = NULL;
         tbl_ptr->ent_bk_arr = NULL;
+        tbl_ptr->ext = NULL;
 
         /* Clear Overlay Group table entries array pointer. */
         tbl_ptr = BCMECMP_TBL_PTR(unit, group, BCMECMP_GRP_TYPE_OVERLAY);
@@ -3850,6 +3861,7 @@ bcm56960_a0_ecmp_entries_cleanup(int unit)
         tbl_ptr = BCMECMP_TBL_PTR(unit, member, BCMECMP_GRP_TYPE_UNDERLAY);
         tbl_ptr->ent_arr = NULL;
         tbl_ptr->ent_bk_arr = NULL;
+        tbl_ptr->ext = NULL;
 
         /* Clear Underlay Group table entries array pointer. */
         tbl_ptr = BCMECMP_TBL_PTR(unit, group, BCMECMP_GRP_TYPE_UNDERLAY);
@@ -3859,6 +3871,8 @@ bcm56960_a0_ecmp_entries_cleanup(int unit)
 
     /* Free Member table entries array memory. */
     tbl_ptr = BCMECMP_TBL_PTR(unit, member, BCMECMP_GRP_TYPE_SINGLE);
+    bcmecmp_ext_destroy(tbl_ptr->ext);
+    tbl_ptr->ext = NULL;
     if (tbl_ptr->ent_arr) {
         BCMECMP_FREE(tbl_ptr->ent_arr);
     }
@@ -0,0 +1,549 @@
+/*! \file bcmecmp_ext.c
+ *
+ * This file implements the ECMP member table free extent index.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <sal/sal_libc.h>
+#include <shr/shr_debug.h>
+#include <bcmecmp/bcmecmp_ext.h>
+
+/*******************************************************************************
+ * Local definitions
+ */
+#define BSL_LOG_MODULE BSL_LS_BCMLTX_ECMP
+
+/*
+ * Free run summary of a range of entries.
+ *
+ * The tree keeps one summary per internal node in separate arrays. Node 1
+ * is the root and the children of node n are 2n and 2n+1. Nodes from
+ * 'size' upwards are the leaves, i.e. the table entries, and are not
+ * stored but derived from the entry reference counts.
+ */
+typedef struct ext_run_s {
+    uint32_t pre;   /* Free entries at the start of the range. */
+    uint32_t suf;   /* Free entries at the end of the range. */
+    uint32_t best;  /* Longest run of free entries. */
+    uint32_t cnt;   /* Number of free entries. */
+    uint32_t len;   /* Number of entries in the range. */
+} ext_run_t;
+
+struct bcmecmp_ext_s {
+    /* Entry array. */
+    bcmecmp_hw_entry_info_t *ent_arr;
+
+    /* Number of entries in the entry array. */
+    int tbl_size;
+
+    /* Number of leaves (power of two). */
+    int size;
+
+    /* Internal node summaries are up to date. */
+    bool valid;
+
+    /* Internal node summaries. */
+    uint32_t *pre;
+    uint32_t *suf;
+    uint32_t *best;
+    uint32_t *cnt;
+};
+
+/*******************************************************************************
+ * Private functions
+ */
+
+static inline void
+ext_node_get(bcmecmp_ext_t *ext, int node, uint32_t len, ext_run_t *run)
+{
+    int idx;
+
+    run->len = len;
+    if (node < ext->size) {
+        run->pre = ext->pre[node];
+        run->suf = ext->suf[node];
+        run->best = ext->best[node];
+        run->cnt = ext->cnt[node];
+        return;
+    }
+
+    /* Entries beyond the end of the table are never free. */
+    idx = node - ext->size;
+    run->pre = (idx < ext->tbl_size && ext->ent_arr[idx].ref_cnt == 0);
+    run->suf = run->best = run->cnt = run->pre;
+}
+
+static inline void
+ext_run_join(const ext_run_t *l, const ext_run_t *r, ext_run_t *run)
+{
+    run->pre = (l->pre == l->len) ? l->len + r->pre : l->pre;
+    run->suf = (r->suf == r->len) ? r->len + l->suf : r->suf;
+    run->best = l->suf + r->pre;
+    if (l->best > run->best) {
+        run->best = l->best;
+    }
+    if (r->best > run->best) {
+        run->best = r->best;
+    }
+    run->cnt = l->cnt + r->cnt;
+    run->len = l->len + r->len;
+}
+
+static void
+ext_node_calc(bcmecmp_ext_t *ext, int node, uint32_t child_len)
+{
+    ext_run_t l, r, run;
+
+    ext_node_get(ext, 2 * node, child_len, &l);
+    ext_node_get(ext, 2 * node + 1, child_len, &r);
+    ext_run_join(&l, &r, &run);
+    ext->pre[node] = run.pre;
+    ext->suf[node] = run.suf;
+    ext->best[node] = run.best;
+    ext->cnt[node] = run.cnt;
+}
+
+/* Recalculate the internal nodes above the leaves first..last. */
+static void
+ext_calc(bcmecmp_ext_t *ext, int first, int last)
+{
+    int lo = (ext->size + first) / 2;
+    int hi = (ext->size + last) / 2;
+    uint32_t child_len = 1;
+    int node;
+
+    while (lo >= 1) {
+        for (node = lo; node <= hi; node++) {
+            ext_node_calc(ext, node, child_len);
+        }
+        lo /= 2;
+        hi /= 2;
+        child_len *= 2;
+    }
+}
+
+static void
+ext_validate(bcmecmp_ext_t *ext)
+{
+    if (!ext->valid) {
+        ext_calc(ext, 0, ext->size - 1);
+        ext->valid = true;
+    }
+}
+
+/* Summarize the intersection of node [nlo, nhi] with [lo, hi]. */
+static void
+ext_query(bcmecmp_ext_t *ext, int node, int nlo, int nhi, int lo, int hi,
+          ext_run_t *run)
+{
+    int mid;
+    ext_run_t l, r;
+
+    if (lo <= nlo && nhi <= hi) {
+        ext_node_get(ext, node, nhi - nlo + 1, run);
+        return;
+    }
+
+    mid = nlo + (nhi - nlo) / 2;
+    if (hi <= mid) {
+        ext_query(ext, 2 * node, nlo, mid, lo, hi, run);
+    } else if (lo > mid) {
+        ext_query(ext, 2 * node + 1, mid + 1, nhi, lo, hi, run);
+    } else {
+        ext_query(ext, 2 * node, nlo, mid, lo, hi, &l);
+        ext_query(ext, 2 * node + 1, mid + 1, nhi, lo, hi, &r);
+        ext_run_join(&l, &r, run);
+    }
+}
+
+/* Lowest start of num free entries within [lo, hi] in node [nlo, nhi]. */
+static int
+ext_search(bcmecmp_ext_t *ext, int node, int nlo, int nhi, int lo, int hi,
+           uint32_t num)
+{
+    int mid, s, e, rv;
+    ext_run_t l, r;
+
+    if (nhi < lo || nlo > hi) {
+        return -1;
+    }
+    ext_node_get(ext, node, nhi - nlo + 1, &l);
+    if (l.best < num) {
+        return -1;
+    }
+    if (nlo == nhi) {
+        return nlo;
+    }
+
+    mid = nlo + (nhi - nlo) / 2;
+    rv = ext_search(ext, 2 * node, nlo, mid, lo, hi, num);
+    if (rv >= 0) {
+        return rv;
+    }
+
+    /* Free run crossing the middle, clipped to [lo, hi]. */
+    ext_node_get(ext, 2 * node, mid - nlo + 1, &l);
+    ext_node_get(ext, 2 * node + 1, nhi - mid, &r);
+    if (l.suf > 0 && r.pre > 0) {
+        s = mid + 1 - (int)l.suf;
+        e = mid + (int)r.pre;
+        if (s < lo) {
+            s = lo;
+        }
+        if (e > hi) {
+            e = hi;
+        }
+        if (s <= mid && e > mid && (uint32_t)(e - s + 1) >= num) {
+            return s;
+        }
+    }
+
+    return ext_search(ext, 2 * node + 1, mid + 1, nhi, lo, hi, num);
+}
+
+/* Lowest start of num free entries within [lo, hi], -1 if none. */
+static int
+ext_range_search(bcmecmp_ext_t *ext, int lo, int hi, uint32_t num)
+{
+    if (lo > hi) {
+        return -1;
+    }
+    return ext_search(ext, 1, 0, ext->size - 1, lo, hi, num);
+}
+
+/*
+ * Find the range of num_ent entries within [imin, imax] which is cheapest
+ * to clear, i.e. whose used entries all belong to blocks in blk and which
+ * overlaps the fewest block entries. Candidate ranges start at imin or
+ * right after a block. Returns the index of the first overlapping block
+ * and the number of overlapping blocks in first and num.
+ */
+static int
+ext_window_find(bcmecmp_ext_t *ext, int imin, int imax, uint32_t num_ent,
+                bcmecmp_ext_blk_t *blk, int num_blk, int *first, int *num)
+{
+    ext_run_t run;
+    int idx, blk_idx, w, wend, s, e;
+    int best = -1;
+    uint32_t cost, used, best_cost = 0;
+
+    for (idx = -1, blk_idx = 0; idx < num_blk; idx++) {
+        w = (idx < 0) ? imin : blk[idx].start + (int)blk[idx].count;
+        wend = w + (int)num_ent - 1;
+        if (w < imin) {
+            continue;
+        }
+        if (wend > imax) {
+            break;
+        }
+
+        /* Skip blocks which end before the range. */
+        while (blk_idx < num_blk &&
+               blk[blk_idx].start + (int)blk[blk_idx].count <= w) {
+            blk_idx++;
+        }
+
+        cost = 0;
+        used = 0;
+        for (s = blk_idx; s < num_blk && blk[s].start <= wend; s++) {
+            e = blk[s].start + (int)blk[s].count - 1;
+            used += ((e < wend) ? e : wend) -
+                    ((blk[s].start > w) ? blk[s].start : w) + 1;
+            cost += blk[s].count;
+        }
+
+        /* Entries used by blocks which may not be moved. */
+        ext_query(ext, 1, 0, ext->size - 1, w, wend, &run);
+        if (num_ent - run.cnt != used) {
+            continue;
+        }
+        if (best < 0 || cost < best_cost) {
+            best = w;
+            best_cost = cost;
+            *first = blk_idx;
+            *num = s - blk_idx;
+        }
+    }
+
+    return best;
+}
+
+static int
+ext_blk_cmp(const void *a, const void *b)
+{
+    const bcmecmp_ext_blk_t *blk_a = a;
+    const bcmecmp_ext_blk_t *blk_b = b;
+
+    return (blk_a->start > blk_b->start) - (blk_a->start < blk_b->start);
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+bcmecmp_ext_create(int unit,
+                   bcmecmp_hw_entry_info_t *ent_arr,
+                   int tbl_size,
+                   bcmecmp_ext_t **ext)
+{
+    bcmecmp_ext_t *e = NULL;
+    size_t arr_size;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_NULL_CHECK(ent_arr, SHR_E_PARAM);
+    SHR_NULL_CHECK(ext, SHR_E_PARAM);
+    if (tbl_size <= 0) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+
+    BCMECMP_ALLOC(e, sizeof(*e), "bcmecmpExt");
+    e->ent_arr = ent_arr;
+    e->tbl_size = tbl_size;
+    e->size = 2;
+    while (e->size < tbl_size) {
+        e->size *= 2;
+    }
+    arr_size = e->size * sizeof(uint32_t);
+    BCMECMP_ALLOC(e->pre, arr_size, "bcmecmpExtPre");
+    BCMECMP_ALLOC(e->suf, arr_size, "bcmecmpExtSuf");
+    BCMECMP_ALLOC(e->best, arr_size, "bcmecmpExtBest");
+    BCMECMP_ALLOC(e->cnt, arr_size, "bcmecmpExtCnt");
+
+    *ext = e;
+    e = NULL;
+
+exit:
+    bcmecmp_ext_destroy(e);
+    SHR_FUNC_EXIT();
+}
+
+void
+bcmecmp_ext_destroy(bcmecmp_ext_t *ext)
+{
+    if (ext == NULL) {
+        return;
+    }
+    BCMECMP_FREE(ext->pre);
+    BCMECMP_FREE(ext->suf);
+    BCMECMP_FREE(ext->best);
+    BCMECMP_FREE(ext->cnt);
+    BCMECMP_FREE(ext);
+}
+
+void
+bcmecmp_ext_invalidate(bcmecmp_ext_t *ext)
+{
+    if (ext) {
+        ext->valid = false;
+    }
+}
+
+void
+bcmecmp_ext_update(bcmecmp_ext_t *ext, int start_idx, uint32_t count)
+{
+    if (ext == NULL || !ext->valid || count == 0) {
+        return;
+    }
+    ext_calc(ext, start_idx, start_idx + (int)count - 1);
+}
+
+int
+bcmecmp_ext_find(bcmecmp_ext_t *ext, int imin, int imax, uint32_t num_ent,
+                 int *start)
+{
+    int idx;
+
+    if (ext == NULL || start == NULL || num_ent == 0 ||
+        imin < 0 || imax >= ext->tbl_size) {
+        return SHR_E_PARAM;
+    }
+    if (imin > imax) {
+        return SHR_E_FULL;
+    }
+    ext_validate(ext);
+
+    idx = ext_search(ext, 1, 0, ext->size - 1, imin, imax, num_ent);
+    if (idx < 0) {
+        return SHR_E_FULL;
+    }
+    *start = idx;
+    return SHR_E_NONE;
+}
+
+void
+bcmecmp_ext_usage_get(bcmecmp_ext_t *ext, int imin, int imax,
+                      uint32_t *free_cnt, uint32_t *max_free)
+{
+    ext_run_t run;
+
+    sal_memset(&run, 0, sizeof(run));
+    if (ext && imin >= 0 && imin <= imax && imax < ext->tbl_size) {
+        ext_validate(ext);
+        ext_query(ext, 1, 0, ext->size - 1, imin, imax, &run);
+    }
+    if (free_cnt) {
+        *free_cnt = run.cnt;
+    }
+    if (max_free) {
+        *max_free = run.best;
+    }
+}
+
+int
+bcmecmp_ext_defrag(bcmecmp_ext_t *ext, int imin, int imax, uint32_t num_ent,
+                   bcmecmp_ext_blk_t *blk, int num_blk,
+                   bcmecmp_ext_move_f move_cb, void *user_data, int *moved)
+{
+    int idx, new_start, rv, w, wend, first = 0, num = 0;
+    int cnt = 0;
+
+    if (ext == NULL || move_cb == NULL || (blk == NULL && num_blk > 0)) {
+        return SHR_E_PARAM;
+    }
+
+    sal_qsort(blk, num_blk, sizeof(*blk), ext_blk_cmp);
+
+    rv = bcmecmp_ext_find(ext, imin, imax, num_ent, &new_start);
+    if (rv != SHR_E_FULL) {
+        return rv;
+    }
+
+    /*
+     * Try to clear the cheapest range first by moving the blocks in it to
+     * free ranges outside of it.
+     */
+    w = ext_window_find(ext, imin, imax, num_ent, blk, num_blk, &first, &num);
+    if (w >= 0) {
+        wend = w + (int)num_ent - 1;
+        for (idx = first; idx < first + num; idx++) {
+            new_start = ext_range_search(ext, imin, w - 1, blk[idx].count);
+            if (new_start < 0) {
+                new_start = ext_range_search(ext, wend + 1, imax,
+                                             blk[idx].count);
+            }
+            if (new_start < 0) {
+                break;
+            }
+            rv = move_cb(user_data, &blk[idx], new_start);
+            if (SHR_FAILURE(rv)) {
+                if (moved) {
+                    *moved = cnt;
+                }
+                return rv;
+            }
+            blk[idx].start = new_start;
+            cnt++;
+        }
+        rv = bcmecmp_ext_find(ext, imin, imax, num_ent, &new_start);
+        sal_qsort(blk, num_blk, sizeof(*blk), ext_blk_cmp);
+    }
+
+    /* Otherwise slide the blocks towards the start of the range. */
+    for (idx = 0; idx < num_blk && rv == SHR_E_FULL; idx++) {
+        if (SHR_FAILURE(bcmecmp_ext_find(ext, imin, imax, blk[idx].count,
+                                         &new_start)) ||
+            new_start >= blk[idx].start) {
+            continue;
+        }
+        rv = move_cb(user_data, &blk[idx], new_start);
+        if (SHR_FAILURE(rv)) {
+            break;
+        }
+        blk[idx].start = new_start;
+        cnt++;
+        rv = bcmecmp_ext_find(ext, imin, imax, num_ent, &new_start);
+    }
+
+    if (moved) {
+        *moved = cnt;
+    }
+    return rv;
+}
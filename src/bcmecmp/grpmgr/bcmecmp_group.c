@@ -94,6 +94,7 @@
 #include <bcmecmp/bcmecmp_lth_common.h>
 #include <bcmecmp/bcmecmp_lt_utils.h>
 #include <bcmecmp/bcmecmp_group.h>
+#include <bcmecmp/bcmecmp_ext.h>
 
 /*******************************************************************************
  * Local definitions
@@ -139,7 +140,7 @@ bcmecmp_tbl_op_t_init(bcmecmp_tbl_op_t *op_info)
 static int
 bcmecmp_tbl_free_idx_get(int unit, bcmecmp_tbl_op_t *op_data)
 {
-    int imin, imax, start_idx, idx;
+    int imin, imax, start_idx, idx, rv;
     uint32_t num_ent;
     uint32_t oper_flags;
     bcmecmp_tbl_prop_t *tbl_ptr;
@@ -169,6 +170,21 @@ bcmecmp_tbl_free_idx_get(int unit, bcmecmp_tbl_op_t *op_data)
               num_ent,
               oper_flags));
 
+    if (tbl_ptr->ext) {
+        /* skip index zero if required by hardware. */
+        if (!imin && (oper_flags & BCMECMP_OPER_SKIP_ZERO)) {
+            imin = 1;
+        }
+        rv = bcmecmp_ext_find(tbl_ptr->ext, imin, imax, num_ent, &start_idx);
+        if (SHR_FAILURE(rv)) {
+            SHR_RETURN_VAL_EXIT(rv);
+        }
+        op_data->free_idx = start_idx;
+        LOG_DEBUG(BSL_LOG_MODULE,
+                  (BSL_META_U(unit, "free_idx=%d\n"), op_data->free_idx));
+        SHR_EXIT();
+    }
+
     for (start_idx = imin; start_idx <= imax; start_idx++) {
         /* skip index zero if required by hardware. */
         if (!start_idx && (oper_flags & BCMECMP_OPER_SKIP_ZERO)) {
@@ -2302,6 +2318,210 @@ bcmecmp_group_update_member_fields_set(int unit,
         SHR_FUNC_EXIT();
 }
 
+/*!
+ * \brief Group member block relocation context.
+ */
+typedef struct bcmecmp_grp_move_s {
+    /*! Unit number. */
+    int unit;
+
+    /*! Member table of the relocated groups. */
+    bcmecmp_tbl_prop_t *tbl_ptr;
+
+    /*! Transaction identifier of the request that triggered compaction. */
+    uint32_t trans_id;
+
+    /*! Scratch logical table entry used to re-install moved groups. */
+    bcmecmp_lt_entry_t *lt_ent;
+} bcmecmp_grp_move_t;
+
+/*!
+ * \brief Relocate an ECMP group's member table block.
+ *
+ * Installs the group members at the new base index and then re-points the
+ * group entry to them, so traffic never sees a partially written block.
+ * The group is staged in the current transaction so that its previous
+ * base index is restored on abort.
+ *
+ * \param [in] user_data Pointer to bcmecmp_grp_move_t structure.
+ * \param [in] blk Group member block to relocate.
+ * \param [in] new_start New member table base index.
+ *
+ * \return SHR_E_NONE No errors.
+ * \return !SHR_E_NONE Failure.
+ */
+static int
+bcmecmp_group_move(void *user_data,
+                   bcmecmp_ext_blk_t *blk,
+                   int new_start)
+{
+    bcmecmp_grp_move_t *move = (bcmecmp_grp_move_t *)user_data;
+    bcmecmp_lt_entry_t *lt_ent = move->lt_ent;
+    int unit = move->unit;
+    bcmecmp_id_t ecmp_id = blk->id;
+
+    SHR_FUNC_ENTER(unit);
+
+    sal_memset(lt_ent, 0, sizeof(*lt_ent));
+    lt_ent->ecmp_id = ecmp_id;
+    lt_ent->grp_type = BCMECMP_GRP_TYPE(unit, ecmp_id);
+    lt_ent->glt_sid = BCMECMP_GRP_LT_SID(unit, ecmp_id);
+    lt_ent->lb_mode = BCMECMP_GRP_LB_MODE(unit, ecmp_id);
+    lt_ent->nhop_sorted = BCMECMP_GRP_NHOP_SORTED(unit, ecmp_id);
+    lt_ent->max_paths = BCMECMP_GRP_MAX_PATHS(unit, ecmp_id);
+    lt_ent->num_paths = BCMECMP_GRP_NUM_PATHS(unit, ecmp_id);
+    lt_ent->ecmp_nhop = BCMECMP_GRP_ECMP_NHOP(unit, ecmp_id);
+    lt_ent->rh_size_enc = BCMECMP_GRP_RH_SIZE(unit, ecmp_id);
+    lt_ent->rh_entries_cnt = BCMECMP_GRP_RH_ENTRIES_CNT(unit, ecmp_id);
+    lt_ent->mstart_idx = new_start;
+    lt_ent->trans_id = move->trans_id;
+
+    if (lt_ent->ecmp_nhop) {
+        sal_memcpy(lt_ent->uecmp_id, BCMECMP_GRP_UECMP_PTR(unit, ecmp_id),
+                   sizeof(lt_ent->uecmp_id[0]) * lt_ent->max_paths);
+    } else {
+        sal_memcpy(lt_ent->nhop_id, BCMECMP_GRP_NHOP_PTR(unit, ecmp_id),
+                   sizeof(lt_ent->nhop_id[0]) * lt_ent->max_paths);
+    }
+
+    if (BCMECMP_LB_MODE_RESILIENT == lt_ent->lb_mode) {
+        lt_ent->rh_entries_arr = BCMECMP_GRP_RH_ENTRIES_PTR(unit, ecmp_id);
+        SHR_IF_ERR_EXIT
+            (BCMECMP_FNCALL_EXEC(unit, rh_grp_ins)(unit, lt_ent));
+    } else {
+        SHR_IF_ERR_EXIT
+            (BCMECMP_FNCALL_EXEC(unit, grp_ins)(unit, lt_ent));
+    }
+
+    SHR_IF_ERR_EXIT
+        (bcmecmp_tbl_ref_cnt_incr(move->tbl_ptr, new_start, blk->count));
+    SHR_IF_ERR_EXIT
+        (bcmecmp_tbl_ref_cnt_decr(move->tbl_ptr, blk->start, blk->count));
+    BCMECMP_GRP_MEMB_TBL_START_IDX(unit, ecmp_id) = new_start;
+
+    BCMECMP_TBL_BK_ENT_STAGED_SET
+        (BCMECMP_TBL_PTR(unit, group, lt_ent->grp_type), ecmp_id);
+    BCMECMP_GRP_TRANS_ID_BK(unit, ecmp_id) = move->trans_id;
+
+    LOG_VERBOSE(BSL_LOG_MODULE,
+                (BSL_META_U(unit,
+                            "[ECMP_ID=%d]: moved mstart_idx %d -> %d.\n"),
+                 ecmp_id, blk->start, new_start));
+
+    exit:
+        lt_ent->rh_entries_arr = NULL;
+        SHR_FUNC_EXIT();
+}
+
+/*!
+ * \brief Compact member table blocks to satisfy a group add request.
+ *
+ * Called when no contiguous range of tbl_op->num_ent free member table
+ * entries exists. If enough entries are free in total, groups of the same
+ * logical table are moved towards the start of the member table range
+ * until a large enough free range opens up.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] lt_entry Pointer to ECMP logical table entry data.
+ * \param [in,out] tbl_op Table operation info, free_idx is set on success.
+ *
+ * \return SHR_E_NONE No errors.
+ * \return SHR_E_FULL Requested hardware resources unavailable.
+ */
+static int
+bcmecmp_group_compact(int unit,
+                      bcmecmp_lt_entry_t *lt_entry,
+                      bcmecmp_tbl_op_t *tbl_op)
+{
+    bcmecmp_tbl_prop_t *tbl_ptr = tbl_op->tbl_ptr;
+    bcmecmp_grp_type_t gtype = lt_entry->grp_type;
+    bcmecmp_ext_blk_t *blk = NULL;
+    bcmecmp_grp_move_t move;
+    bcmecmp_id_t ecmp_id, min_id, max_id;
+    uint32_t free_cnt = 0, count;
+    int imin, imax, start, num_blk = 0, moved = 0;
+
+    SHR_FUNC_ENTER(unit);
+
+    sal_memset(&move, 0, sizeof(move));
+
+    imin = tbl_ptr->imin;
+    imax = tbl_ptr->imax;
+    if (!imin && (tbl_op->oper_flags & BCMECMP_OPER_SKIP_ZERO)) {
+        imin = 1;
+    }
+
+    if (tbl_ptr->ext == NULL
+        || !BCMECMP_FNCALL_CHECK(unit, grp_ins)
+        || !BCMECMP_FNCALL_CHECK(unit, rh_grp_ins)) {
+        SHR_RETURN_VAL_EXIT(SHR_E_FULL);
+    }
+
+    bcmecmp_ext_usage_get(tbl_ptr->ext, imin, imax, &free_cnt, NULL);
+    if (free_cnt < tbl_op->num_ent) {
+        SHR_RETURN_VAL_EXIT(SHR_E_FULL);
+    }
+
+    min_id = BCMECMP_LT_MIN_ECMP_ID(unit, group, gtype);
+    max_id = BCMECMP_LT_MAX_ECMP_ID(unit, group, gtype);
+    BCMECMP_ALLOC(blk, (max_id - min_id + 1) * sizeof(*blk),
+                  "bcmecmpGrpCompactBlkArr");
+
+    for (ecmp_id = min_id; ecmp_id <= max_id; ecmp_id++) {
+        if (!BCMECMP_TBL_REF_CNT(BCMECMP_TBL_PTR(unit, group, gtype), ecmp_id)
+            || BCMECMP_GRP_LT_SID(unit, ecmp_id) != lt_entry->glt_sid
+            || BCMECMP_GRP_TYPE(unit, ecmp_id) != gtype) {
+            continue;
+        }
+
+        /* Groups staged by another transaction must not be touched. */
+        if (BCMECMP_TBL_BK_ENT_STAGED_GET(BCMECMP_TBL_PTR(unit, group, gtype),
+                                          ecmp_id)
+            && BCMECMP_GRP_TRANS_ID_BK(unit, ecmp_id) != lt_entry->trans_id) {
+            continue;
+        }
+
+        if (BCMECMP_LB_MODE_RESILIENT == BCMECMP_GRP_LB_MODE(unit, ecmp_id)) {
+            count = BCMECMP_GRP_RH_ENTRIES_CNT(unit, ecmp_id);
+        } else {
+            count = BCMECMP_GRP_MAX_PATHS(unit, ecmp_id);
+        }
+        start = BCMECMP_GRP_MEMB_TBL_START_IDX(unit, ecmp_id);
+        if (count == 0 || start < imin || (start + (int)count - 1) > imax) {
+            continue;
+        }
+
+        blk[num_blk].id = ecmp_id;
+        blk[num_blk].start = start;
+        blk[num_blk].count = count;
+        num_blk++;
+    }
+
+    move.unit = unit;
+    move.tbl_ptr = tbl_ptr;
+    move.trans_id = lt_entry->trans_id;
+    BCMECMP_ALLOC(move.lt_ent, sizeof(*move.lt_ent),
+                  "bcmecmpGrpCompactLtEnt");
+
+    SHR_IF_ERR_EXIT_EXCEPT_IF
+        (bcmecmp_ext_defrag(tbl_ptr->ext, imin, imax, tbl_op->num_ent,
+                            blk, num_blk, bcmecmp_group_move, &move, &moved),
+         SHR_E_FULL);
+
+    LOG_VERBOSE(BSL_LOG_MODULE,
+                (BSL_META_U(unit,
+                            "Compaction moved %d of %d groups.\n"),
+                 moved, num_blk));
+
+    SHR_IF_ERR_VERBOSE_EXIT
+        (bcmecmp_tbl_free_idx_get(unit, tbl_op));
+
+    exit:
+        BCMECMP_FREE(move.lt_ent);
+        BCMECMP_FREE(blk);
+        SHR_FUNC_EXIT();
+}
+
 /*******************************************************************************
  * Public functions
  */
@@ -2393,8 +2613,9 @@ bcmecmp_group_add(int unit,
         /* Get free base index from member table. */
         rv = bcmecmp_tbl_free_idx_get(unit, &tbl_op);
         if (SHR_E_FULL == rv) {
-            /* TBD: Compact group entries to create space for new request. */
-            SHR_RETURN_VAL_EXIT(rv);
+            /* Compact group entries to create space for new request. */
+            SHR_IF_ERR_VERBOSE_EXIT
+                (bcmecmp_group_compact(unit, lt_entry, &tbl_op));
         } else if (SHR_E_NONE != rv) {
             SHR_RETURN_VAL_EXIT(rv);
         }
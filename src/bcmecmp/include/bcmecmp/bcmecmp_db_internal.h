@@ -483,6 +483,9 @@ typedef struct bcmecmp_tbl_prop_s {
 
     /*! Table entry backup array elements base pointer.  */
     bcmecmp_hw_entry_info_t *ent_bk_arr;
+
+    /*! Free extent index of the entry array (member tables only). */
+    bcmecmp_ext_t *ext;
 } bcmecmp_tbl_prop_t;
 
 /*!
@@ -1548,6 +1551,35 @@ extern bcmecmp_control_t *ecmp_ctrl[BCMECMP_NUM_UNITS_MAX];
 #define BCMECMP_TBL_BK_ENT_STAGED_GET(_tptr, _i)    \
             (((_tptr)->ent_bk_arr[(_i)]).flags & (BCMECMP_ENTRY_STAGED))
 
+/*!
+ * \brief Update the free extent index for a range of entries.
+ *
+ * Must be called after the reference count of the entries in the range
+ * has changed between zero and non-zero.
+ *
+ * \param [in] ext Free extent index.
+ * \param [in] start_idx First entry of the range.
+ * \param [in] count Number of entries in the range.
+ *
+ * \returns Nothing.
+ */
+extern void
+bcmecmp_ext_update(bcmecmp_ext_t *ext, int start_idx, uint32_t count);
+
+/*!
+ * \brief Invalidate the free extent index.
+ *
+ * Must be called after the entry array has been overwritten as a whole,
+ * e.g. when a transaction is aborted. The index is rebuilt from the
+ * entry reference counts on next use.
+ *
+ * \param [in] ext Free extent index.
+ *
+ * \returns Nothing.
+ */
+extern void
+bcmecmp_ext_invalidate(bcmecmp_ext_t *ext);
+
 /*!
  * \brief Increment the reference count for a range of entries in member table.
  *
@@ -1574,6 +1606,9 @@ static inline int bcmecmp_tbl_ref_cnt_incr(bcmecmp_tbl_prop_t *tbl_ptr,
     for (offset = 0; offset < count; offset++) {
         tbl_ptr->ent_arr[(start_idx + (int)offset)].ref_cnt++;
     }
+    if (tbl_ptr->ext) {
+        bcmecmp_ext_update(tbl_ptr->ext, start_idx, count);
+    }
     return (SHR_E_NONE);
 }
 
@@ -1605,6 +1640,9 @@ static inline int bcmecmp_tbl_ref_cnt_decr(bcmecmp_tbl_prop_t *tbl_ptr,
             tbl_ptr->ent_arr[(start_idx + (int)offset)].ref_cnt--;
         }
     }
+    if (tbl_ptr->ext) {
+        bcmecmp_ext_update(tbl_ptr->ext, start_idx, count);
+    }
     return (SHR_E_NONE);
 }
 
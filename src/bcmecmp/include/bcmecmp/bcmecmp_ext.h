@@ -0,0 +1,231 @@
+/*! \file bcmecmp_ext.h
+ *
+ * This file contains ECMP member table free extent index definitions.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#ifndef BCMECMP_EXT_H
+#define BCMECMP_EXT_H
+
+#include <shr/shr_types.h>
+#include <bcmecmp/bcmecmp_db_internal.h>
+
+/*!
+ * \brief Member table block descriptor used for defragmentation.
+ */
+typedef struct bcmecmp_ext_blk_s {
+
+    /*! Block owner identifier (e.g. ECMP group ID). */
+    int id;
+
+    /*! First member table entry of the block. */
+    int start;
+
+    /*! Number of member table entries in the block. */
+    uint32_t count;
+} bcmecmp_ext_blk_t;
+
+/*!
+ * \brief Relocate a member table block.
+ *
+ * The function must install the block contents at \c new_start, switch
+ * the owner to the new location, and then move the entry reference counts
+ * from the old to the new location, so that the free extent index is
+ * updated.
+ *
+ * \param [in] user_data User data passed to \ref bcmecmp_ext_defrag.
+ * \param [in] blk Block to relocate.
+ * \param [in] new_start New first member table entry of the block.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval !SHR_E_NONE Failure.
+ */
+typedef int (*bcmecmp_ext_move_f)(void *user_data,
+                                  bcmecmp_ext_blk_t *blk,
+                                  int new_start);
+
+/*!
+ * \brief Create a free extent index for a member table entry array.
+ *
+ * The index is a segment tree which keeps, for every subrange of the
+ * table, the longest run of free (zero reference count) entries and the
+ * free runs at both ends. It finds the lowest free range of a given size
+ * in logarithmic time.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] ent_arr Entry array.
+ * \param [in] tbl_size Number of entries in \c ent_arr.
+ * \param [out] ext Free extent index.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_PARAM Input parameter error.
+ * \retval SHR_E_MEMORY Memory allocation failed.
+ */
+extern int
+bcmecmp_ext_create(int unit,
+                   bcmecmp_hw_entry_info_t *ent_arr,
+                   int tbl_size,
+                   bcmecmp_ext_t **ext);
+
+/*!
+ * \brief Destroy a free extent index.
+ *
+ * \param [in] ext Free extent index.
+ *
+ * \returns Nothing.
+ */
+extern void
+bcmecmp_ext_destroy(bcmecmp_ext_t *ext);
+
+/*!
+ * \brief Find the lowest range of free entries.
+ *
+ * \param [in] ext Free extent index.
+ * \param [in] imin Lowest entry the range may start at.
+ * \param [in] imax Highest entry the range may end at.
+ * \param [in] num_ent Number of entries in the range.
+ * \param [out] start First entry of the range.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_PARAM Input parameter error.
+ * \retval SHR_E_FULL No range of \c num_ent free entries.
+ */
+extern int
+bcmecmp_ext_find(bcmecmp_ext_t *ext, int imin, int imax, uint32_t num_ent,
+                 int *start);
+
+/*!
+ * \brief Get the free entry usage of an entry range.
+ *
+ * \param [in] ext Free extent index.
+ * \param [in] imin First entry of the range.
+ * \param [in] imax Last entry of the range.
+ * \param [out] free_cnt Number of free entries.
+ * \param [out] max_free Longest run of free entries.
+ *
+ * \returns Nothing.
+ */
+extern void
+bcmecmp_ext_usage_get(bcmecmp_ext_t *ext, int imin, int imax,
+                      uint32_t *free_cnt, uint32_t *max_free);
+
+/*!
+ * \brief Compact blocks to create a range of free entries.
+ *
+ * The range of \c num_ent entries which overlaps the fewest block entries
+ * is cleared first by relocating its blocks to free ranges outside of it.
+ * If that is not possible, blocks are visited in ascending start order
+ * and every block which fits into a lower free range is relocated to the
+ * lowest one, until a range of \c num_ent free entries exists. As the new
+ * location of a block is always disjoint from the old one, the move
+ * function can install the block before releasing its old location
+ * (make-before-break).
+ *
+ * The \c blk array is sorted by start entry.
+ *
+ * \param [in] ext Free extent index.
+ * \param [in] imin Lowest entry blocks may be moved to.
+ * \param [in] imax Highest entry blocks may be moved to.
+ * \param [in] num_ent Number of free entries needed.
+ * \param [in] blk Blocks which may be relocated.
+ * \param [in] num_blk Number of elements in \c blk.
+ * \param [in] move_cb Block relocation function.
+ * \param [in] user_data User data passed to \c move_cb.
+ * \param [out] moved Number of relocated blocks (optional).
+ *
+ * \retval SHR_E_NONE A range of \c num_ent free entries exists.
+ * \retval SHR_E_FULL Not enough space could be reclaimed.
+ * \retval !SHR_E_NONE Failure returned by \c move_cb.
+ */
+extern int
+bcmecmp_ext_defrag(bcmecmp_ext_t *ext, int imin, int imax, uint32_t num_ent,
+                   bcmecmp_ext_blk_t *blk, int num_blk,
+                   bcmecmp_ext_move_f move_cb, void *user_data, int *moved);
+
+#endif /* BCMECMP_EXT_H */
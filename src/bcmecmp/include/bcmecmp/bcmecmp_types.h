@@ -148,6 +148,9 @@ typedef int bcmecmp_nhop_id_t;
 /*! Logical Table Definition Field Identifier. */
 typedef uint32_t bcmecmp_ltd_fid_t;
 
+/*! Member table free extent index. */
+typedef struct bcmecmp_ext_s bcmecmp_ext_t;
+
 /*!
  * \brief Device ECMP modes.
  *
@@ -1080,6 +1080,7 @@ bcmecmp_lth_underlay_group_abort(int unit,
                                                    BCMECMP_GRP_TYPE_OVERLAY);
         sal_memcpy(tbl_ptr->ent_arr, tbl_ptr->ent_bk_arr,
                    (sizeof(bcmecmp_hw_entry_info_t) * tbl_size));
+        bcmecmp_ext_invalidate(tbl_ptr->ext);
 
         BCMECMP_TBL_REF_CNT(BCMECMP_TBL_PTR(unit, group,
                                             BCMECMP_GRP_TYPE_UNDERLAY), ecmp_id)
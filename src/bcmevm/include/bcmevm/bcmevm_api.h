@@ -95,6 +95,9 @@
 #include <bcmltm/bcmltm_types.h>
 #include <bcmltd/bcmltd_lt_types.h>
 
+/*! Invalid published event ID. */
+#define BCMEVM_EVENT_ID_INVALID     0xffffffff
+
 /*!
  * \brief North bound table change notification.
  *
@@ -201,6 +204,10 @@ extern int bcmevm_register_tbl_event(int unit,
  * The callback function being called from the context of the event poster
  * thread. Therefore the action taken by the component should be minimal.
  *
+ * The callback function may register or unregister published events,
+ * but it must not shut down the unit, as this would wait for the
+ * callback itself to complete.
+ *
  * \param [in] unit Unit number.
  * \param [in] event Event for which the function had been called for.
  * \param [in] ev_data Data associated with the event.
@@ -220,6 +227,9 @@ typedef void (bcmevm_event_cb)(int unit,
  * It is expected that the call to this function will happen only after
  * the init state of the system manager.
  *
+ * Registration replaces the subscriber lists of the unit as a whole
+ * and waits for all ongoing event notifications to complete.
+ *
  * \param [in] unit Unit number.
  * \param [in] event Event to be associated with.
  * \param [in] cb Callback function to call when the event being posted.
@@ -264,6 +274,8 @@ extern int bcmevm_unregister_published_event(int unit,
  * components had been informed.
  * The caller should not be aware if any other component is registered to
  * receive this event or not.
+ * The function does not take any locks, so events can be published
+ * concurrently from multiple threads.
  *
  * \param [in] unit Unit number.
  * \param [in] event Event to be associated with.
@@ -275,4 +287,66 @@ extern void bcmevm_publish_event_notify(int unit,
                                         const char *event,
                                         uint64_t ev_data);
 
+/*!
+ * \brief Get the ID of a published event.
+ *
+ * This function maps an event name to a unit specific event ID, which
+ * can be used to publish the event without looking up the event name
+ * every time. An ID is assigned to the event if the event is not known
+ * yet. The ID of an event remains valid until the unit is shut down.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] event Event name.
+ * \param [out] event_id Event ID.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_INIT Unit is not initialized.
+ * \retval SHR_E_PARAM Invalid event name.
+ * \retval SHR_E_MEMORY Failed to allocate memory.
+ */
+extern int bcmevm_event_id_get(int unit,
+                               const char *event,
+                               uint32_t *event_id);
+
+/*!
+ * \brief Notify other components of an event by event ID.
+ *
+ * This function is equivalent to \ref bcmevm_publish_event_notify, but
+ * the event is identified by an event ID obtained from \ref
+ * bcmevm_event_id_get.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] event_id Event ID.
+ * \param [in] ev_data Data associated with the event.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_INIT Unit is not initialized.
+ * \retval SHR_E_PARAM Invalid event ID.
+ */
+extern int bcmevm_publish_event_id_notify(int unit,
+                                          uint32_t event_id,
+                                          uint64_t ev_data);
+
+/*!
+ * \brief Post an event for deferred notification.
+ *
+ * This function queues the event for notification from the context of
+ * the per-unit event thread and returns without waiting for the
+ * registered components to be informed. The event thread is created
+ * when the first event is posted.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] event_id Event ID obtained from \ref bcmevm_event_id_get.
+ * \param [in] ev_data Data associated with the event.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_INIT Unit is not initialized.
+ * \retval SHR_E_PARAM Invalid event ID.
+ * \retval SHR_E_FULL The event queue is full.
+ * \retval SHR_E_FAIL Failed to start the event thread.
+ */
+extern int bcmevm_publish_event_post(int unit,
+                                     uint32_t event_id,
+                                     uint64_t ev_data);
+
 #endif /* BCMEVM_API_H */
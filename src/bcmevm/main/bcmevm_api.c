@@ -92,22 +92,42 @@
  */
 
 #include <sal/sal_types.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
 #include <sal/sal_mutex.h>
+#include <sal/sal_msgq.h>
+#include <sal/sal_sleep.h>
 #include <shr/shr_error.h>
 #include <shr/shr_debug.h>
-#include <shr/shr_hash_str.h>
+#include <shr/shr_thread.h>
 #include <bcmdrd_config.h>
 #include <bcmevm/bcmevm_api.h>
 #include "bcmevm_internal.h"
 
 #define BSL_LOG_MODULE BSL_LS_BCMEVM_EVENT
 
+/* Minimum size of the event name hash in a snapshot. */
 #define EVENT_TABLE_SIZE    32
 
-typedef struct notify_comp_cb_s {
-    bcmevm_event_cb *cb;
-    struct notify_comp_cb_s *next;
-} notify_comp_cb_t;
+/* Depth of the deferred event queue of a unit. */
+#ifndef BCMEVM_DEFER_QUEUE_SIZE
+#define BCMEVM_DEFER_QUEUE_SIZE     1024
+#endif
+
+/* Time to wait for the deferred event thread to exit. */
+#define DEFER_THREAD_STOP_USEC      500000
+
+/* Polling interval while waiting for readers to leave a snapshot. */
+#define GRACE_POLL_USEC             10
+
+/* Pseudo event ID used to wake up the deferred event thread. */
+#define EVENT_ID_WAKE               BCMEVM_EVENT_ID_INVALID
+
+/* Atomic access helpers */
+#define ATOMIC_LOAD(_p, _mo)            __atomic_load_n(_p, _mo)
+#define ATOMIC_STORE(_p, _v, _mo)       __atomic_store_n(_p, _v, _mo)
+#define ATOMIC_ADD(_p, _v)              __atomic_fetch_add(_p, _v, __ATOMIC_SEQ_CST)
+#define ATOMIC_SUB(_p, _v)              __atomic_fetch_sub(_p, _v, __ATOMIC_SEQ_CST)
 
 typedef struct notify_table_cb_s {
     bcmevm_cb *cb;
@@ -115,20 +135,523 @@ typedef struct notify_table_cb_s {
     struct notify_table_cb_s *next;
 } notify_table_cb_t;
 
+/*
+ * Published events are dispatched from an immutable snapshot of the
+ * subscriber lists, which is replaced as a whole (read-copy-update)
+ * whenever a callback is registered or unregistered.
+ *
+ * Event names are interned into dense event IDs. The ID of an event
+ * never changes and the interned name is kept until the unit is shut
+ * down, so publishers may cache event IDs and callbacks may hold on to
+ * the event name.
+ *
+ * Publishers never take a lock. A publisher announces itself in one of
+ * two reader counters selected by the current epoch, loads the unit and
+ * its snapshot, dispatches and leaves the counter again. The epoch and
+ * the reader counters are kept outside of the unit, so a publisher may
+ * announce itself while the unit is being shut down.
+ *
+ * A writer, which is serialized by nfy_mutex, installs the new snapshot
+ * and retires the old one without waiting for readers, so callbacks may
+ * (un)register published events themselves. The epoch is advanced only
+ * when the readers of the parity it is about to reuse have drained, and
+ * a retired snapshot is freed once the epoch has advanced three times
+ * since it was replaced. Any reader which could have loaded it has left
+ * by then. Snapshots retired while readers are active are freed by a
+ * later update or when the unit is shut down.
+ */
+typedef struct evm_event_s {
+    /* Interned event name. */
+    const char *name;
+
+    /* Hash value of the event name. */
+    uint32_t hval;
+
+    /* Number of registered callbacks. */
+    uint32_t num_cb;
+
+    /* Registered callbacks. */
+    bcmevm_event_cb **cb;
+} evm_event_t;
+
+typedef struct evm_snap_s {
+    /* Next retired snapshot. */
+    struct evm_snap_s *next;
+
+    /* Epoch at which the snapshot was replaced. */
+    uint32_t retire_epoch;
+
+    /* Number of interned events, i.e. valid event IDs. */
+    uint32_t num_events;
+
+    /* Hash mask of the name hash (size - 1). */
+    uint32_t hash_mask;
+
+    /* Open addressing name hash holding (event ID + 1), 0 is empty. */
+    uint32_t *hash;
+
+    /* Events indexed by event ID. */
+    evm_event_t *events;
+} evm_snap_t;
+
+typedef struct evm_defer_msg_s {
+    uint32_t event_id;
+    uint64_t ev_data;
+} evm_defer_msg_t;
+
+typedef struct evm_unit_s {
+    /* Unit number. */
+    int unit;
+
+    /* Current snapshot of the published events. */
+    evm_snap_t *snap;
+
+    /* Replaced snapshots which may still be in use by readers. */
+    evm_snap_t *retired;
+
+    /* Interned event names (writer side, owns the strings). */
+    char **names;
+
+    /* Number of interned event names. */
+    uint32_t num_names;
+
+    /* Allocated size of the names array. */
+    uint32_t max_names;
+
+    /* Deferred event queue. */
+    sal_msgq_t defer_q;
+
+    /* Deferred event thread. */
+    shr_thread_ctrl_t *defer_tc;
+
+    /* Deferred event delivery is ready. */
+    int defer_ready;
+} evm_unit_t;
+
 static bcmevm_cb *cb_func;
 
 static sal_mutex_t nfy_mutex;
 
 static int nfy_active_units;
 
-static shr_hash_str_hdl event_handler_tbl[BCMDRD_CONFIG_MAX_UNITS];
+static evm_unit_t *evm_unit[BCMDRD_CONFIG_MAX_UNITS];
+
+/* Reader grace period epoch of each unit. */
+static uint32_t evm_epoch[BCMDRD_CONFIG_MAX_UNITS];
+
+/* Active readers of each epoch parity of each unit. */
+static uint32_t evm_readers[BCMDRD_CONFIG_MAX_UNITS][2];
 
 static notify_table_cb_t *tbl_event_list[BCMDRD_CONFIG_MAX_UNITS];
 
+/*******************************************************************************
+ * Private functions
+ */
+
+static uint32_t
+evm_name_hash(const char *name)
+{
+    uint32_t hval = 2166136261U;
+
+    while (*name) {
+        hval ^= (uint8_t)*name++;
+        hval *= 16777619U;
+    }
+    return hval;
+}
+
+/*
+ * Look up the event ID of an event name in a snapshot.
+ *
+ * Returns the number of events in the snapshot if not found.
+ */
+static uint32_t
+evm_snap_lookup(const evm_snap_t *snap, const char *name)
+{
+    uint32_t hval = evm_name_hash(name);
+    uint32_t idx = hval & snap->hash_mask;
+    uint32_t slot;
+    const evm_event_t *ev;
+
+    while ((slot = snap->hash[idx]) != 0) {
+        ev = &snap->events[slot - 1];
+        if (ev->hval == hval && sal_strcmp(ev->name, name) == 0) {
+            return slot - 1;
+        }
+        idx = (idx + 1) & snap->hash_mask;
+    }
+    return snap->num_events;
+}
+
+/*
+ * Enter a read-side critical section and return the unit.
+ *
+ * The unit is loaded only after the reader has been announced, so it
+ * remains valid until evm_read_unlock() even if the unit is being shut
+ * down. Returns NULL if the unit is not initialized, in which case
+ * evm_read_unlock() must be called all the same.
+ */
+static inline evm_unit_t *
+evm_read_lock(int unit, uint32_t *parity)
+{
+    uint32_t idx = ATOMIC_LOAD(&evm_epoch[unit], __ATOMIC_SEQ_CST) & 1;
+
+    ATOMIC_ADD(&evm_readers[unit][idx], 1);
+    *parity = idx;
+    return ATOMIC_LOAD(&evm_unit[unit], __ATOMIC_SEQ_CST);
+}
+
+static inline void
+evm_read_unlock(int unit, uint32_t parity)
+{
+    ATOMIC_SUB(&evm_readers[unit][parity], 1);
+}
+
+/*
+ * Wait until no reader can reference a unit or snapshot that was
+ * replaced before this call.
+ *
+ * A reader which sampled the epoch just before the first flip may
+ * register itself with the old parity after the writer checked it,
+ * hence the epoch is flipped twice.
+ *
+ * Used by shutdown only. Must not be called from a callback.
+ */
+static void
+evm_synchronize(int unit)
+{
+    uint32_t idx;
+    int flip;
+
+    for (flip = 0; flip < 2; flip++) {
+        idx = ATOMIC_ADD(&evm_epoch[unit], 1) & 1;
+        while (ATOMIC_LOAD(&evm_readers[unit][idx], __ATOMIC_SEQ_CST) != 0) {
+            sal_usleep(GRACE_POLL_USEC);
+        }
+    }
+}
+
+/*
+ * Free the retired snapshots which no reader can reference anymore.
+ *
+ * The epoch is flipped from e to e + 1 only if no reader is left with
+ * the parity of e + 1, which was last used at e - 1. A snapshot retired
+ * at epoch e is thus free once the epoch reached e + 3, as the readers
+ * of both parities have been seen drained after it was replaced.
+ *
+ * Must be called with nfy_mutex held.
+ */
+static void
+evm_reclaim(evm_unit_t *eu)
+{
+    evm_snap_t **snapp = &eu->retired;
+    evm_snap_t *snap;
+    uint32_t epoch;
+    int flip;
+
+    for (flip = 0; flip < 3 && eu->retired; flip++) {
+        epoch = ATOMIC_LOAD(&evm_epoch[eu->unit], __ATOMIC_SEQ_CST);
+        if (ATOMIC_LOAD(&evm_readers[eu->unit][(epoch + 1) & 1],
+                        __ATOMIC_SEQ_CST) != 0) {
+            break;
+        }
+        ATOMIC_ADD(&evm_epoch[eu->unit], 1);
+    }
+
+    epoch = ATOMIC_LOAD(&evm_epoch[eu->unit], __ATOMIC_SEQ_CST);
+    while ((snap = *snapp) != NULL) {
+        if (epoch - snap->retire_epoch >= 3) {
+            *snapp = snap->next;
+            sal_free(snap);
+        } else {
+            snapp = &snap->next;
+        }
+    }
+}
+
+static void
+evm_retired_free(evm_unit_t *eu)
+{
+    evm_snap_t *snap;
+
+    while ((snap = eu->retired) != NULL) {
+        eu->retired = snap->next;
+        sal_free(snap);
+    }
+}
+
+/*
+ * Call all callbacks registered for an event.
+ */
+static void
+evm_dispatch(int unit, const evm_event_t *ev, uint64_t ev_data)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < ev->num_cb; idx++) {
+        ev->cb[idx](unit, ev->name, ev_data);
+    }
+}
+
+static void
+evm_deliver(int unit, uint32_t event_id, uint64_t ev_data)
+{
+    evm_unit_t *eu;
+    evm_snap_t *snap;
+    uint32_t parity;
+
+    eu = evm_read_lock(unit, &parity);
+    if (eu) {
+        snap = ATOMIC_LOAD(&eu->snap, __ATOMIC_ACQUIRE);
+        if (event_id < snap->num_events) {
+            evm_dispatch(unit, &snap->events[event_id], ev_data);
+        }
+    }
+    evm_read_unlock(unit, parity);
+}
+
+/*
+ * Find the registration slot of a callback in an event.
+ */
+static int
+evm_cb_find(const evm_event_t *ev, bcmevm_event_cb *cb)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < ev->num_cb; idx++) {
+        if (ev->cb[idx] == cb) {
+            return idx;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Build and install a new snapshot for the interned events.
+ *
+ * The callback add_cb is appended to and the callback del_cb is
+ * removed from the event event_id. Either may be NULL.
+ *
+ * Must be called with nfy_mutex held.
+ */
+static int
+evm_snap_update(evm_unit_t *eu, uint32_t event_id,
+                bcmevm_event_cb *add_cb, bcmevm_event_cb *del_cb)
+{
+    evm_snap_t *old = eu->snap;
+    evm_snap_t *snap;
+    evm_event_t *ev;
+    const evm_event_t *old_ev;
+    bcmevm_event_cb **cbp;
+    uint32_t num_events = eu->num_names;
+    uint32_t num_cb = add_cb ? 1 : 0;
+    uint32_t hash_size = EVENT_TABLE_SIZE;
+    uint32_t id, idx, hidx;
+    size_t size;
+
+    if (old) {
+        for (id = 0; id < old->num_events; id++) {
+            num_cb += old->events[id].num_cb;
+        }
+    }
+    while (hash_size < num_events * 2) {
+        hash_size <<= 1;
+    }
+
+    /* Single allocation: header, events, callbacks and name hash. */
+    size = sizeof(*snap) +
+           num_events * sizeof(evm_event_t) +
+           num_cb * sizeof(bcmevm_event_cb *) +
+           hash_size * sizeof(uint32_t);
+    snap = sal_alloc(size, "bcmevmSnap");
+    if (!snap) {
+        return SHR_E_MEMORY;
+    }
+    sal_memset(snap, 0, size);
+    snap->num_events = num_events;
+    snap->hash_mask = hash_size - 1;
+    snap->events = (evm_event_t *)(snap + 1);
+    cbp = (bcmevm_event_cb **)(snap->events + num_events);
+    snap->hash = (uint32_t *)(cbp + num_cb);
+
+    for (id = 0; id < num_events; id++) {
+        ev = &snap->events[id];
+        ev->name = eu->names[id];
+        ev->hval = evm_name_hash(ev->name);
+        ev->cb = cbp;
+        if (old && id < old->num_events) {
+            old_ev = &old->events[id];
+            for (idx = 0; idx < old_ev->num_cb; idx++) {
+                if (id == event_id && old_ev->cb[idx] == del_cb) {
+                    continue;
+                }
+                ev->cb[ev->num_cb++] = old_ev->cb[idx];
+            }
+        }
+        if (id == event_id && add_cb) {
+            ev->cb[ev->num_cb++] = add_cb;
+        }
+        cbp += ev->num_cb;
+
+        hidx = ev->hval & snap->hash_mask;
+        while (snap->hash[hidx] != 0) {
+            hidx = (hidx + 1) & snap->hash_mask;
+        }
+        snap->hash[hidx] = id + 1;
+    }
+
+    ATOMIC_STORE(&eu->snap, snap, __ATOMIC_SEQ_CST);
+    if (old) {
+        old->retire_epoch = ATOMIC_LOAD(&evm_epoch[eu->unit],
+                                        __ATOMIC_SEQ_CST);
+        old->next = eu->retired;
+        eu->retired = old;
+    }
+    evm_reclaim(eu);
+    return SHR_E_NONE;
+}
+
+/*
+ * Get the event ID of an event name and intern the name if needed.
+ *
+ * Must be called with nfy_mutex held.
+ */
+static int
+evm_event_intern(evm_unit_t *eu, const char *event, uint32_t *event_id)
+{
+    uint32_t id;
+    uint32_t max_names;
+    char **names;
+    char *name;
+    int rv;
+
+    id = evm_snap_lookup(eu->snap, event);
+    if (id < eu->snap->num_events) {
+        *event_id = id;
+        return SHR_E_NONE;
+    }
+
+    if (eu->num_names == eu->max_names) {
+        max_names = eu->max_names ? eu->max_names * 2 : EVENT_TABLE_SIZE;
+        names = sal_alloc(max_names * sizeof(char *), "bcmevmNames");
+        if (!names) {
+            return SHR_E_MEMORY;
+        }
+        if (eu->names) {
+            sal_memcpy(names, eu->names, eu->num_names * sizeof(char *));
+            sal_free(eu->names);
+        }
+        eu->names = names;
+        eu->max_names = max_names;
+    }
+
+    name = sal_strdup(event);
+    if (!name) {
+        return SHR_E_MEMORY;
+    }
+    eu->names[eu->num_names++] = name;
+
+    rv = evm_snap_update(eu, BCMEVM_EVENT_ID_INVALID, NULL, NULL);
+    if (SHR_FAILURE(rv)) {
+        eu->num_names--;
+        sal_free(name);
+        return rv;
+    }
+    *event_id = id;
+    return SHR_E_NONE;
+}
+
+static void
+evm_defer_thread(shr_thread_ctrl_t *tc, void *arg)
+{
+    evm_unit_t *eu = (evm_unit_t *)arg;
+    evm_defer_msg_t msg;
+
+    while (1) {
+        if (sal_msgq_recv(eu->defer_q, &msg, SAL_MSGQ_FOREVER) != 0) {
+            continue;
+        }
+        if (shr_thread_stopping(tc)) {
+            break;
+        }
+        if (msg.event_id != EVENT_ID_WAKE) {
+            evm_deliver(eu->unit, msg.event_id, msg.ev_data);
+        }
+    }
+}
+
+/*
+ * Create the deferred event queue and thread of a unit.
+ *
+ * Must be called from a read-side critical section in which eu was
+ * loaded. This keeps eu and nfy_mutex valid, and as writers never wait
+ * for readers while holding nfy_mutex, it may be taken here.
+ */
+static int
+evm_defer_start(evm_unit_t *eu)
+{
+    SHR_FUNC_ENTER(eu->unit);
+
+    SHR_IF_ERR_EXIT(sal_mutex_take(nfy_mutex, SAL_MUTEX_FOREVER));
+    if (evm_unit[eu->unit] != eu) {
+        /* The unit is being shut down. */
+        SHR_RETURN_VAL_EXIT(SHR_E_INIT);
+    }
+    if (!eu->defer_ready) {
+        if (!eu->defer_q) {
+            eu->defer_q = sal_msgq_create(sizeof(evm_defer_msg_t),
+                                          BCMEVM_DEFER_QUEUE_SIZE,
+                                          "bcmevmDeferQ");
+            SHR_NULL_CHECK(eu->defer_q, SHR_E_MEMORY);
+        }
+        eu->defer_tc = shr_thread_start("bcmevmDefer", -1,
+                                        evm_defer_thread, eu);
+        SHR_NULL_CHECK(eu->defer_tc, SHR_E_FAIL);
+        ATOMIC_STORE(&eu->defer_ready, 1, __ATOMIC_RELEASE);
+    }
+
+exit:
+    sal_mutex_give(nfy_mutex);
+    SHR_FUNC_EXIT();
+}
+
+static void
+evm_defer_stop(evm_unit_t *eu)
+{
+    evm_defer_msg_t msg;
+
+    if (eu->defer_tc) {
+        /* Issue the stop request and wake up the thread. */
+        shr_thread_stop(eu->defer_tc, 0);
+        msg.event_id = EVENT_ID_WAKE;
+        msg.ev_data = 0;
+        sal_msgq_post(eu->defer_q, &msg, SAL_MSGQ_HIGH_PRIORITY,
+                      SAL_MSGQ_FOREVER);
+        if (SHR_FAILURE(shr_thread_stop(eu->defer_tc,
+                                        DEFER_THREAD_STOP_USEC))) {
+            LOG_WARN(BSL_LOG_MODULE,
+                     (BSL_META_U(eu->unit,
+                                 "Deferred event thread did not stop\n")));
+        }
+        eu->defer_tc = NULL;
+    }
+    if (eu->defer_q) {
+        sal_msgq_destroy(eu->defer_q);
+        eu->defer_q = NULL;
+    }
+    eu->defer_ready = 0;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
 int bcmevm_unit_init(int unit)
 {
+    evm_unit_t *eu = NULL;
+
     SHR_FUNC_ENTER(unit);
-    if (event_handler_tbl[unit]) {
+    if (evm_unit[unit]) {
         return SHR_E_RESOURCE;
     }
 
@@ -137,46 +660,54 @@ int bcmevm_unit_init(int unit)
     }
     SHR_NULL_CHECK(nfy_mutex, SHR_E_MEMORY);
 
-    SHR_IF_ERR_EXIT(
-           shr_hash_str_dict_alloc(EVENT_TABLE_SIZE, &event_handler_tbl[unit]));
+    eu = sal_alloc(sizeof(*eu), "bcmevmUnit");
+    SHR_NULL_CHECK(eu, SHR_E_MEMORY);
+    sal_memset(eu, 0, sizeof(*eu));
+    eu->unit = unit;
+
+    /* Start with an empty snapshot, so readers never see NULL. */
+    SHR_IF_ERR_EXIT(evm_snap_update(eu, BCMEVM_EVENT_ID_INVALID, NULL, NULL));
 
+    ATOMIC_STORE(&evm_unit[unit], eu, __ATOMIC_RELEASE);
+    eu = NULL;
     nfy_active_units++;
 exit:
+    if (eu) {
+        sal_free(eu);
+    }
     SHR_FUNC_EXIT();
 }
 
 int bcmevm_unit_shutdown(int unit)
 {
-    notify_comp_cb_t *it;
-    void *val;
-    int rv;
-    char *key;
+    evm_unit_t *eu = evm_unit[unit];
+    uint32_t id;
 
     SHR_FUNC_ENTER(unit);
-    if (!event_handler_tbl[unit]) {
+    if (!eu) {
         return SHR_E_INIT;
     }
 
     /*
-     * Free all the registered callback structures by traversing the dictionary
+     * Unpublish the unit and wait for the last publishers to leave.
+     * Thereafter nothing can be posted to the deferred event queue.
      */
-    rv = shr_hash_str_get_first(event_handler_tbl[unit], &key, &val);
-    while (rv == SHR_E_NONE) {
-        /* Coverity
-         * The value of 'val' is being refreshed by the function
-         * shr_hash_str_get_next() below.
-         */
-        /* coverity[use_after_free : FALSE] */
-        it = (notify_comp_cb_t *)val;
-        while (it) {
-            val = it;
-            it = it->next;
-            sal_free(val);
-        }
-        rv = shr_hash_str_get_next(event_handler_tbl[unit], &key, &val);
+    sal_mutex_take(nfy_mutex, SAL_MUTEX_FOREVER);
+    ATOMIC_STORE(&evm_unit[unit], NULL, __ATOMIC_SEQ_CST);
+    sal_mutex_give(nfy_mutex);
+    evm_synchronize(unit);
+
+    evm_defer_stop(eu);
+
+    evm_retired_free(eu);
+    sal_free(eu->snap);
+    for (id = 0; id < eu->num_names; id++) {
+        sal_free(eu->names[id]);
+    }
+    if (eu->names) {
+        sal_free(eu->names);
     }
-    shr_hash_str_dict_free(event_handler_tbl[unit]);
-    event_handler_tbl[unit] = NULL;
+    sal_free(eu);
 
     if (--nfy_active_units == 0) {
         sal_mutex_destroy(nfy_mutex);
@@ -254,56 +785,46 @@ exit:
     SHR_FUNC_EXIT();
 }
 
-int bcmevm_register_published_event(int unit,
-                                    const char *event,
-                                    bcmevm_event_cb *cb)
+int bcmevm_event_id_get(int unit,
+                        const char *event,
+                        uint32_t *event_id)
 {
-    int rv;
-    notify_comp_cb_t *comp_cb;
-    notify_comp_cb_t *it = NULL;
-    void *val;
-    bool new_event;
+    evm_unit_t *eu;
 
     SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(event, SHR_E_PARAM);
+    SHR_NULL_CHECK(event_id, SHR_E_PARAM);
     SHR_IF_ERR_EXIT(sal_mutex_take(nfy_mutex, SAL_MUTEX_FOREVER));
-    if (!event_handler_tbl[unit]) {
+    eu = evm_unit[unit];
+    if (!eu) {
         SHR_RETURN_VAL_EXIT(SHR_E_INIT);
     }
+    SHR_IF_ERR_EXIT(evm_event_intern(eu, event, event_id));
 
-    rv = shr_hash_str_dict_lookup(event_handler_tbl[unit], event, &val);
-    if (rv != SHR_E_NONE) {
-        new_event = true;
-    } else {
-        comp_cb = (notify_comp_cb_t *)val;
-        /*
-         * It is possible that two events will have the same hash value.
-         * Therefore need to check matching event string as well.
-         */
-        if (comp_cb->cb == cb) {
-            SHR_RETURN_VAL_EXIT(SHR_E_EXISTS);
-        }
+exit:
+    sal_mutex_give(nfy_mutex);
+    SHR_FUNC_EXIT();
+}
 
-        new_event = false;
-        it = comp_cb;
-        while (it->next && it->next->cb != cb) {
-            it = it->next;
-        }
-        if (it->next) {
-            SHR_RETURN_VAL_EXIT(SHR_E_EXISTS);
-        }
+int bcmevm_register_published_event(int unit,
+                                    const char *event,
+                                    bcmevm_event_cb *cb)
+{
+    evm_unit_t *eu;
+    uint32_t event_id;
+
+    SHR_FUNC_ENTER(unit);
+    SHR_IF_ERR_EXIT(sal_mutex_take(nfy_mutex, SAL_MUTEX_FOREVER));
+    eu = evm_unit[unit];
+    if (!eu) {
+        SHR_RETURN_VAL_EXIT(SHR_E_INIT);
     }
-    comp_cb = sal_alloc(sizeof(notify_comp_cb_t), "evNotify");
-    SHR_NULL_CHECK(comp_cb, SHR_E_MEMORY);
 
-    /* Need to create the entry */
-    comp_cb->cb = cb;
-    comp_cb->next = NULL;
-    if (new_event) {
-        SHR_IF_ERR_EXIT(
-               shr_hash_str_dict_insert(event_handler_tbl[unit], event, comp_cb));
-    } else {
-        it->next = comp_cb;
+    SHR_IF_ERR_EXIT(evm_event_intern(eu, event, &event_id));
+    if (evm_cb_find(&eu->snap->events[event_id], cb) >= 0) {
+        SHR_RETURN_VAL_EXIT(SHR_E_EXISTS);
     }
+    SHR_IF_ERR_EXIT(evm_snap_update(eu, event_id, cb, NULL));
 
 exit:
     sal_mutex_give(nfy_mutex);
@@ -314,46 +835,23 @@ int bcmevm_unregister_published_event(int unit,
                                       const char *event,
                                       bcmevm_event_cb *cb)
 {
-    notify_comp_cb_t *comp_cb;
-    notify_comp_cb_t *it;
-    void *val;
+    evm_unit_t *eu;
+    uint32_t event_id;
 
     SHR_FUNC_ENTER(unit);
     SHR_IF_ERR_EXIT(sal_mutex_take(nfy_mutex, SAL_MUTEX_FOREVER));
 
-    if (!event_handler_tbl[unit]) {
+    eu = evm_unit[unit];
+    if (!eu) {
         SHR_RETURN_VAL_EXIT(SHR_E_INIT);
     }
-    SHR_IF_ERR_EXIT(
-        shr_hash_str_dict_lookup(event_handler_tbl[unit], event, &val));
-
-    comp_cb = (notify_comp_cb_t *)val;
-
-    if (comp_cb->cb == cb) {
-        /* If the first element matches then need to delete the hash entry */
-        shr_hash_str_dict_delete(event_handler_tbl[unit], event);
-        /*
-         * If there are more callbacks for this hash slot insert the next
-         * element into the hash dtring
-         */
-        if (comp_cb->next) {
-            SHR_IF_ERR_EXIT(shr_hash_str_dict_insert(event_handler_tbl[unit],
-                                                     event,
-                                                     comp_cb->next));
-        }
-    } else {
-        it = comp_cb;
-        while (it->next && it->next->cb != cb) {
-            it = it->next;
-        }
-        if (it->next) {
-            comp_cb = it->next;
-            it->next = comp_cb->next;
-        } else {
-            SHR_RETURN_VAL_EXIT(SHR_E_NOT_FOUND);
-        }
+    event_id = evm_snap_lookup(eu->snap, event);
+    if (event_id >= eu->snap->num_events ||
+        evm_cb_find(&eu->snap->events[event_id], cb) < 0) {
+        SHR_RETURN_VAL_EXIT(SHR_E_NOT_FOUND);
     }
-    sal_free(comp_cb);
+    SHR_IF_ERR_EXIT(evm_snap_update(eu, event_id, NULL, cb));
+
 exit:
     sal_mutex_give(nfy_mutex);
     SHR_FUNC_EXIT();
@@ -363,25 +861,76 @@ void bcmevm_publish_event_notify(int unit,
                                  const char *event,
                                  uint64_t ev_data)
 {
-    notify_comp_cb_t *it;
-    void *val;
-    int rv;
+    evm_unit_t *eu;
+    evm_snap_t *snap;
+    uint32_t parity;
+    uint32_t event_id;
+
+    eu = evm_read_lock(unit, &parity);
+    if (eu) {
+        snap = ATOMIC_LOAD(&eu->snap, __ATOMIC_ACQUIRE);
+        event_id = evm_snap_lookup(snap, event);
+        if (event_id < snap->num_events) {
+            evm_dispatch(unit, &snap->events[event_id], ev_data);
+        }
+    }
+    evm_read_unlock(unit, parity);
+}
 
-    if (!event_handler_tbl[unit]) {
-        return;
+int bcmevm_publish_event_id_notify(int unit,
+                                   uint32_t event_id,
+                                   uint64_t ev_data)
+{
+    evm_unit_t *eu;
+    evm_snap_t *snap;
+    uint32_t parity;
+    int rv = SHR_E_NONE;
+
+    eu = evm_read_lock(unit, &parity);
+    if (!eu) {
+        rv = SHR_E_INIT;
+    } else {
+        snap = ATOMIC_LOAD(&eu->snap, __ATOMIC_ACQUIRE);
+        if (event_id < snap->num_events) {
+            evm_dispatch(unit, &snap->events[event_id], ev_data);
+        } else {
+            rv = SHR_E_PARAM;
+        }
     }
-    sal_mutex_take(nfy_mutex, SAL_MUTEX_FOREVER);
-    do {
-        rv = shr_hash_str_dict_lookup(event_handler_tbl[unit], event, &val);
-        if (rv != SHR_E_NONE) { /* Nobody registered for this event. */
-            break;
+    evm_read_unlock(unit, parity);
+    return rv;
+}
+
+int bcmevm_publish_event_post(int unit,
+                              uint32_t event_id,
+                              uint64_t ev_data)
+{
+    evm_unit_t *eu;
+    evm_snap_t *snap;
+    evm_defer_msg_t msg;
+    uint32_t parity;
+    int rv = SHR_E_NONE;
+
+    /* The queue is destroyed only after the last reader has left. */
+    eu = evm_read_lock(unit, &parity);
+    if (!eu) {
+        rv = SHR_E_INIT;
+    } else {
+        snap = ATOMIC_LOAD(&eu->snap, __ATOMIC_ACQUIRE);
+        if (event_id >= snap->num_events) {
+            rv = SHR_E_PARAM;
+        } else if (!ATOMIC_LOAD(&eu->defer_ready, __ATOMIC_ACQUIRE)) {
+            rv = evm_defer_start(eu);
         }
-        it = (notify_comp_cb_t *)val;
-        while (it) {
-            it->cb(unit, event, ev_data);
-            it = it->next;
+    }
+    if (SHR_SUCCESS(rv)) {
+        msg.event_id = event_id;
+        msg.ev_data = ev_data;
+        if (sal_msgq_post(eu->defer_q, &msg, SAL_MSGQ_NORMAL_PRIORITY,
+                          SAL_MSGQ_NOWAIT) != 0) {
+            rv = SHR_E_FULL;
         }
-    } while (0);
-    sal_mutex_give(nfy_mutex);
+    }
+    evm_read_unlock(unit, parity);
+    return rv;
 }
-
@@ -113,6 +113,8 @@ bcmfp_common_cleanup(int unit)
 {
    SHR_FUNC_ENTER(unit);
 
+   bcmfp_profile_index_cleanup(unit);
+
    SHR_FREE(bcmfp_control[unit]);
 
    SHR_FUNC_EXIT();
@@ -91,6 +91,7 @@
 
 #include <shr/shr_error.h>
 #include <shr/shr_debug.h>
+#include <shr/shr_hash_dedup.h>
 #include <bcmbd/bcmbd.h>
 #include <bcmptm/bcmptm.h>
 #include <bcmdrd/bcmdrd_pt.h>
@@ -101,14 +102,46 @@
 static uint32_t req_ew[BCMDRD_CONFIG_MAX_UNITS][BCMFP_ENTRY_WORDS_MAX];
 static uint32_t rsp_ew[BCMDRD_CONFIG_MAX_UNITS][BCMFP_ENTRY_WORDS_MAX];
 
-int
-bcmfp_profile_entry_lookup(int unit,
-                           uint32_t trans_id,
-                           int tbl_inst,
-                           bcmltd_sid_t req_ltid,
-                           bcmdrd_sid_t profile_sid,
-                           uint32_t *profile_data,
-                           int index)
+/*
+ * Content index of a set of profile tables sharing the same index
+ * space (identified by the first profile SID and the table instance).
+ *
+ * The index maps the concatenated data of all profile tables to the
+ * profile index holding it. It is volatile and mirrors the profile
+ * reference counts in HA memory: it is built from the in-use entries
+ * on first use (also after warm boot) and invalidated when an FP
+ * transaction is aborted, as the aborted HA reference counts and PTM
+ * entries no longer match it.
+ */
+typedef struct bcmfp_profile_index_s {
+    struct bcmfp_profile_index_s *next;
+    bcmdrd_sid_t sid;
+    int tbl_inst;
+    uint8_t num_profiles;
+    int min_idx;
+    int max_idx;
+    bool valid;
+    size_t data_size;
+    uint32_t *data;
+    shr_hash_dedup_hdl_t dedup;
+} bcmfp_profile_index_t;
+
+static bcmfp_profile_index_t *profile_cidx[BCMDRD_CONFIG_MAX_UNITS];
+
+/* Use content index to find shared profiles. */
+#ifndef BCMFP_PROFILE_INDEX
+#define BCMFP_PROFILE_INDEX 1
+#endif
+
+/* Read the data of a profile entry. */
+static int
+bcmfp_profile_entry_read(int unit,
+                         uint32_t trans_id,
+                         int tbl_inst,
+                         bcmltd_sid_t req_ltid,
+                         bcmdrd_sid_t profile_sid,
+                         int index,
+                         uint32_t *entry_data)
 {
      uint32_t req_flags = 0;
      uint32_t rsp_flags = 0;
@@ -118,14 +151,12 @@ bcmfp_profile_entry_lookup(int unit,
 
      SHR_FUNC_ENTER(unit);
 
-     SHR_NULL_CHECK(profile_data, SHR_E_PARAM);
-
      pt_dyn_info.index = index;
      pt_dyn_info.tbl_inst = tbl_inst;
 
      rsp_entry_wsize = bcmdrd_pt_entry_wsize(unit, profile_sid);
 
-     sal_memset(rsp_ew[unit], 0 , BCMFP_ENTRY_WORDS_MAX * sizeof(uint32_t));
+     sal_memset(entry_data, 0 , rsp_entry_wsize * sizeof(uint32_t));
      SHR_IF_ERR_EXIT(
          bcmptm_ltm_mreq_indexed_lt(unit,
                                     req_flags,
@@ -140,10 +171,41 @@ bcmfp_profile_entry_lookup(int unit,
                                     trans_id,
                                     NULL,
                                     NULL,
-                                    rsp_ew[unit],
+                                    entry_data,
                                     &rsp_ltid,
                                     &rsp_flags));
 
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmfp_profile_entry_lookup(int unit,
+                           uint32_t trans_id,
+                           int tbl_inst,
+                           bcmltd_sid_t req_ltid,
+                           bcmdrd_sid_t profile_sid,
+                           uint32_t *profile_data,
+                           int index)
+{
+     size_t rsp_entry_wsize = 0;
+
+     SHR_FUNC_ENTER(unit);
+
+     SHR_NULL_CHECK(profile_data, SHR_E_PARAM);
+
+     rsp_entry_wsize = bcmdrd_pt_entry_wsize(unit, profile_sid);
+
+     sal_memset(rsp_ew[unit], 0 , BCMFP_ENTRY_WORDS_MAX * sizeof(uint32_t));
+     SHR_IF_ERR_EXIT(
+         bcmfp_profile_entry_read(unit,
+                                  trans_id,
+                                  tbl_inst,
+                                  req_ltid,
+                                  profile_sid,
+                                  index,
+                                  rsp_ew[unit]));
+
     if (sal_memcmp(profile_data, rsp_ew[unit],
             rsp_entry_wsize * sizeof(uint32_t))) {
         SHR_RETURN_VAL_EXIT(SHR_E_NOT_FOUND);
@@ -249,31 +311,205 @@ exit:
     SHR_FUNC_EXIT();
 }
 
-int
-bcmfp_profile_index_alloc(int unit,
+/* Concatenate the data of all profile tables into the index key buffer. */
+static void
+bcmfp_profile_index_data_pack(int unit,
+                              bcmfp_profile_index_t *pidx,
+                              bcmdrd_sid_t *profile_sids,
+                              uint32_t *profile_data[])
+{
+    uint8_t profile = 0;
+    size_t wsize = 0;
+    uint32_t *data = pidx->data;
+
+    for (profile = 0; profile < pidx->num_profiles; profile++) {
+        wsize = bcmdrd_pt_entry_wsize(unit, profile_sids[profile]);
+        sal_memcpy(data, profile_data[profile], wsize * sizeof(uint32_t));
+        data += wsize;
+    }
+}
+
+/* Populate the content index from the in-use profile entries. */
+static int
+bcmfp_profile_index_build(int unit,
                           uint32_t trans_id,
-                          int tbl_inst,
                           bcmltd_sid_t req_ltid,
-                          uint8_t num_profiles,
+                          bcmfp_profile_index_t *pidx,
                           bcmdrd_sid_t *profile_sids,
-                          uint32_t *profile_data[],
-                          uint32_t *profile_ref_count,
-                          int *index)
+                          uint32_t *profile_ref_count)
+{
+    int idx = 0;
+    uint8_t profile = 0;
+    uint32_t *data = NULL;
+
+    SHR_FUNC_ENTER(unit);
+
+    shr_hash_dedup_clear(pidx->dedup);
+
+    for (idx = pidx->min_idx; idx <= pidx->max_idx; idx++) {
+        if (!profile_ref_count[idx]) {
+            continue;
+        }
+        data = pidx->data;
+        for (profile = 0; profile < pidx->num_profiles; profile++) {
+            SHR_IF_ERR_EXIT(
+                bcmfp_profile_entry_read(unit,
+                                         trans_id,
+                                         pidx->tbl_inst,
+                                         req_ltid,
+                                         profile_sids[profile],
+                                         idx,
+                                         data));
+            data += bcmdrd_pt_entry_wsize(unit, profile_sids[profile]);
+        }
+        SHR_IF_ERR_EXIT(
+            shr_hash_dedup_insert(pidx->dedup, idx - pidx->min_idx,
+                                  pidx->data));
+    }
+    pidx->valid = TRUE;
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/*
+ * Get the content index of a set of profile tables, creating and
+ * building it if needed. The index is NULL if it could not be created,
+ * in which case the caller falls back to scanning the profile tables.
+ */
+static int
+bcmfp_profile_index_get(int unit,
+                        uint32_t trans_id,
+                        int tbl_inst,
+                        bcmltd_sid_t req_ltid,
+                        uint8_t num_profiles,
+                        bcmdrd_sid_t *profile_sids,
+                        uint32_t *profile_ref_count,
+                        bcmfp_profile_index_t **pidx_out)
+{
+    int rv = SHR_E_NONE;
+    uint8_t profile = 0;
+    size_t data_size = 0;
+    bcmfp_profile_index_t *pidx = NULL;
+
+    SHR_FUNC_ENTER(unit);
+
+    *pidx_out = NULL;
+    if (!BCMFP_PROFILE_INDEX) {
+        SHR_EXIT();
+    }
+
+    for (pidx = profile_cidx[unit]; pidx != NULL; pidx = pidx->next) {
+        if (pidx->sid == profile_sids[0] && pidx->tbl_inst == tbl_inst) {
+            break;
+        }
+    }
+
+    if (pidx == NULL) {
+        for (profile = 0; profile < num_profiles; profile++) {
+            data_size += bcmdrd_pt_entry_wsize(unit, profile_sids[profile]) *
+                         sizeof(uint32_t);
+        }
+        SHR_ALLOC(pidx, sizeof(*pidx), "bcmfpProfileIndex");
+        if (pidx == NULL) {
+            SHR_EXIT();
+        }
+        sal_memset(pidx, 0, sizeof(*pidx));
+        pidx->sid = profile_sids[0];
+        pidx->tbl_inst = tbl_inst;
+        pidx->num_profiles = num_profiles;
+        pidx->min_idx = bcmdrd_pt_index_min(unit, profile_sids[0]);
+        pidx->max_idx = bcmdrd_pt_index_max(unit, profile_sids[0]);
+        pidx->data_size = data_size;
+        SHR_ALLOC(pidx->data, data_size, "bcmfpProfileIndexData");
+        rv = shr_hash_dedup_create(pidx->max_idx - pidx->min_idx + 1,
+                                   data_size, &pidx->dedup);
+        if (pidx->data == NULL || SHR_FAILURE(rv)) {
+            LOG_WARN(BSL_LOG_MODULE,
+                     (BSL_META_U(unit,
+                                 "Profile index for %s not created.\n"),
+                      bcmdrd_pt_sid_to_name(unit, profile_sids[0])));
+            shr_hash_dedup_destroy(pidx->dedup);
+            SHR_FREE(pidx->data);
+            SHR_FREE(pidx);
+            SHR_EXIT();
+        }
+        pidx->next = profile_cidx[unit];
+        profile_cidx[unit] = pidx;
+    }
+
+    if (pidx->num_profiles != num_profiles) {
+        SHR_RETURN_VAL_EXIT(SHR_E_INTERNAL);
+    }
+
+    if (!pidx->valid) {
+        SHR_IF_ERR_EXIT(
+            bcmfp_profile_index_build(unit,
+                                      trans_id,
+                                      req_ltid,
+                                      pidx,
+                                      profile_sids,
+                                      profile_ref_count));
+    }
+    *pidx_out = pidx;
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmfp_profile_index_invalidate(int unit)
+{
+    bcmfp_profile_index_t *pidx = NULL;
+
+    SHR_FUNC_ENTER(unit);
+
+    for (pidx = profile_cidx[unit]; pidx != NULL; pidx = pidx->next) {
+        pidx->valid = FALSE;
+    }
+
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmfp_profile_index_cleanup(int unit)
+{
+    bcmfp_profile_index_t *pidx = NULL;
+
+    SHR_FUNC_ENTER(unit);
+
+    while (profile_cidx[unit] != NULL) {
+        pidx = profile_cidx[unit];
+        profile_cidx[unit] = pidx->next;
+        shr_hash_dedup_destroy(pidx->dedup);
+        SHR_FREE(pidx->data);
+        SHR_FREE(pidx);
+    }
+
+    SHR_FUNC_EXIT();
+}
+
+/* Find a matching profile by reading back every in-use profile entry. */
+static int
+bcmfp_profile_index_scan(int unit,
+                         uint32_t trans_id,
+                         int tbl_inst,
+                         bcmltd_sid_t req_ltid,
+                         uint8_t num_profiles,
+                         bcmdrd_sid_t *profile_sids,
+                         uint32_t *profile_data[],
+                         uint32_t *profile_ref_count,
+                         int *index)
 {
      int idx = 0;
      int min_idx = 0;
      int max_idx = 0;
-     int free_idx = 0;
+     int free_idx = -1;
      uint8_t profile = 0;
      shr_error_t rv = SHR_E_NONE;
 
      SHR_FUNC_ENTER(unit);
 
-     SHR_NULL_CHECK(index, SHR_E_PARAM);
-     SHR_NULL_CHECK(profile_sids, SHR_E_PARAM);
-     SHR_NULL_CHECK(profile_data, SHR_E_PARAM);
-     SHR_NULL_CHECK(profile_ref_count, SHR_E_PARAM);
-
      min_idx = bcmdrd_pt_index_min(unit, profile_sids[0]);
      max_idx = bcmdrd_pt_index_max(unit, profile_sids[0]);
      for (idx = min_idx; idx <= max_idx; idx++) {
@@ -320,6 +556,120 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+int
+bcmfp_profile_index_alloc(int unit,
+                          uint32_t trans_id,
+                          int tbl_inst,
+                          bcmltd_sid_t req_ltid,
+                          uint8_t num_profiles,
+                          bcmdrd_sid_t *profile_sids,
+                          uint32_t *profile_data[],
+                          uint32_t *profile_ref_count,
+                          int *index)
+{
+     int idx = 0;
+     uint32_t match = 0;
+     shr_error_t rv = SHR_E_NONE;
+     bcmfp_profile_index_t *pidx = NULL;
+
+     SHR_FUNC_ENTER(unit);
+
+     SHR_NULL_CHECK(index, SHR_E_PARAM);
+     SHR_NULL_CHECK(profile_sids, SHR_E_PARAM);
+     SHR_NULL_CHECK(profile_data, SHR_E_PARAM);
+     SHR_NULL_CHECK(profile_ref_count, SHR_E_PARAM);
+
+     SHR_IF_ERR_EXIT(
+         bcmfp_profile_index_get(unit,
+                                 trans_id,
+                                 tbl_inst,
+                                 req_ltid,
+                                 num_profiles,
+                                 profile_sids,
+                                 profile_ref_count,
+                                 &pidx));
+     if (pidx == NULL) {
+         SHR_IF_ERR_EXIT(
+             bcmfp_profile_index_scan(unit,
+                                      trans_id,
+                                      tbl_inst,
+                                      req_ltid,
+                                      num_profiles,
+                                      profile_sids,
+                                      profile_data,
+                                      profile_ref_count,
+                                      index));
+         SHR_EXIT();
+     }
+
+     bcmfp_profile_index_data_pack(unit, pidx, profile_sids, profile_data);
+     rv = shr_hash_dedup_find(pidx->dedup, pidx->data, &match);
+     if (SHR_SUCCESS(rv)) {
+         *index = pidx->min_idx + (int)match;
+         SHR_RETURN_VAL_EXIT(SHR_E_NONE);
+     }
+
+     for (idx = pidx->min_idx; idx <= pidx->max_idx; idx++) {
+         if (!profile_ref_count[idx]) {
+             *index = idx;
+             SHR_RETURN_VAL_EXIT(SHR_E_NONE);
+         }
+     }
+     SHR_RETURN_VAL_EXIT(SHR_E_RESOURCE);
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/* Record the content of a newly installed profile in its content index. */
+static int
+bcmfp_profile_index_insert(int unit,
+                           int tbl_inst,
+                           bcmdrd_sid_t *profile_sids,
+                           uint32_t *profile_data[],
+                           int index)
+{
+    bcmfp_profile_index_t *pidx = NULL;
+
+    SHR_FUNC_ENTER(unit);
+
+    for (pidx = profile_cidx[unit]; pidx != NULL; pidx = pidx->next) {
+        if (pidx->sid == profile_sids[0] && pidx->tbl_inst == tbl_inst) {
+            break;
+        }
+    }
+    if (pidx == NULL || !pidx->valid) {
+        SHR_EXIT();
+    }
+
+    bcmfp_profile_index_data_pack(unit, pidx, profile_sids, profile_data);
+    SHR_IF_ERR_EXIT(
+        shr_hash_dedup_insert(pidx->dedup, index - pidx->min_idx,
+                              pidx->data));
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/* Remove the content of a released profile from its content index. */
+static void
+bcmfp_profile_index_delete(int unit,
+                           int tbl_inst,
+                           bcmdrd_sid_t *profile_sids,
+                           int index)
+{
+    bcmfp_profile_index_t *pidx = NULL;
+
+    for (pidx = profile_cidx[unit]; pidx != NULL; pidx = pidx->next) {
+        if (pidx->sid == profile_sids[0] && pidx->tbl_inst == tbl_inst) {
+            break;
+        }
+    }
+    if (pidx == NULL || !pidx->valid) {
+        return;
+    }
+
+    (void)shr_hash_dedup_delete(pidx->dedup, index - pidx->min_idx);
+}
+
 int
 bcmfp_profile_add(int unit,
                   uint32_t trans_id,
@@ -368,6 +718,12 @@ bcmfp_profile_add(int unit,
                                        profile_data[profile],
                                        index));
     }
+    SHR_IF_ERR_EXIT(
+        bcmfp_profile_index_insert(unit,
+                                   tbl_inst,
+                                   profile_sids,
+                                   profile_data,
+                                   index));
 
     profile_ref_count[index] += 1;
     *profile_index = index;
@@ -399,6 +755,11 @@ bcmfp_profile_delete(int unit,
     }
 
     profile_ref_count[profile_index] -= 1;
+    if (profile_ref_count[profile_index]) {
+        SHR_RETURN_VAL_EXIT(SHR_E_NONE);
+    }
+
+    bcmfp_profile_index_delete(unit, tbl_inst, profile_sids, profile_index);
 
     for (profile = 0; profile < num_profiles; profile++) {
         SHR_IF_ERR_EXIT(
@@ -238,6 +238,11 @@ bcmfp_trans_abort(int unit, bcmfp_stage_id_t stage_id)
 
     SHR_FUNC_ENTER(unit);
 
+    /* Profile reference counts are restored from the back up HA
+     * block, so the profile content indexes are stale.
+     */
+    SHR_IF_ERR_EXIT(bcmfp_profile_index_invalidate(unit));
+
     /* Copy the back up HA block to active HA block
      * corresponding to the given stage.
      */
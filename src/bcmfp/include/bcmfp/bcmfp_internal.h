@@ -741,6 +741,28 @@ bcmfp_profile_index_alloc(int unit,
                           uint32_t *profile_data[],
                           uint32_t *profile_ref_count,
                           int *index);
+/*!
+ * \brief Invalidate the profile content indexes of a unit.
+ *
+ * The indexes are rebuilt from the profile reference counts and the
+ * profile table entries on next use. Must be called whenever the HA
+ * reference counts are restored, e.g. on transaction abort.
+ *
+ * \param [in] unit Logical device id.
+ *
+ * \retval SHR_E_NONE Success.
+ */
+extern int
+bcmfp_profile_index_invalidate(int unit);
+/*!
+ * \brief Free the profile content indexes of a unit.
+ *
+ * \param [in] unit Logical device id.
+ *
+ * \retval SHR_E_NONE Success.
+ */
+extern int
+bcmfp_profile_index_cleanup(int unit);
 extern int
 bcmfp_udf_qual_id_get(int unit,
                       bcmfp_stage_id_t stage_id,
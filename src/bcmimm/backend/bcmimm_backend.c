@@ -126,6 +126,14 @@
 
 #define DATA_TABLE_CTRL_CHUNK   10
 
+/*
+ * Maintain an open addressing entry index for every table. Without the
+ * index the entries are searched through the hash bins of the table.
+ */
+#ifndef BCMIMM_BE_ENTRY_INDEX
+#define BCMIMM_BE_ENTRY_INDEX   1
+#endif
+
 /*
  * per unit we keep all the tables in an array that points to them. The table
  * handle contains the index in this array. This allows us to quickly find
@@ -211,6 +219,44 @@ static bool table_exist(int unit, uint8_t comp_id, uint8_t sub_id)
     return false;
 }
 
+/*!
+ * \brief Add a table entry to the entry index.
+ *
+ * This function is used to build the entry index from the table entries.
+ *
+ * \param [in] user_data The entry index.
+ * \param [in] ent The table entry.
+ *
+ * \return SHR_E_NONE on success and SHR_E_MEMORY otherwise.
+ */
+static int index_build_cb(void *user_data, uint8_t *ent)
+{
+    return bcmimm_be_index_insert((bcmimm_be_index_t *)user_data, ent);
+}
+
+/*!
+ * \brief Add a table entry to the ordered index.
+ *
+ * This function is used to build the ordered index from the table entries.
+ *
+ * \param [in] user_data The ordered index.
+ * \param [in] ent The table entry.
+ *
+ * \return SHR_E_NONE on success and SHR_E_MEMORY otherwise.
+ */
+static int order_build_cb(void *user_data, uint8_t *ent)
+{
+    bcmimm_be_order_t *order = (bcmimm_be_order_t *)user_data;
+    bcmimm_be_order_node_t *node;
+
+    node = bcmimm_be_order_node_alloc(order);
+    if (!node) {
+        return SHR_E_MEMORY;
+    }
+    bcmimm_be_order_insert(order, node, ent);
+    return SHR_E_NONE;
+}
+
 /*******************************************************************************
  * Public functions
  */
@@ -358,6 +404,15 @@ int bcmimm_be_table_create(int unit,
         SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
     }
 
+    if (BCMIMM_BE_ENTRY_INDEX) {
+        t_info->index = bcmimm_be_index_create(key_size);
+        SHR_NULL_CHECK(t_info->index, SHR_E_MEMORY);
+        /* Index the entries recovered from the previous run */
+        SHR_IF_ERR_EXIT
+            (bcmimm_table_entries_traverse(t_info, index_build_cb,
+                                           t_info->index));
+    }
+
     *hdl = (bcmimm_be_tbl_hdl_t)((((uint16_t)(unit & 0xFFFF)) << 16) + idx);
 exit:
     SHR_FUNC_EXIT();
@@ -376,6 +431,8 @@ int bcmimm_be_table_release(bcmimm_be_tbl_hdl_t hdl)
     if (t_info->sorted_fid) {
         sal_free(t_info->sorted_fid);
     }
+    bcmimm_be_index_destroy(t_info->index);
+    bcmimm_be_order_destroy(t_info->order);
     /* Release the table info struct */
     sal_memset(t_info, 0, sizeof(*t_info));
 
@@ -385,6 +442,88 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+int bcmimm_be_table_destroy(bcmimm_be_tbl_hdl_t hdl)
+{
+    bcmimm_tbl_info_t *t_info = &active_tables[hdl >> 16].tbls[hdl & 0xFFFF];
+    tbl_header_t *tbl;
+    int unit;
+
+    SHR_FUNC_ENTER(t_info ? t_info->unit : BSL_UNIT_UNKNOWN);
+
+    VALIDATE_INPUT(t_info, hdl);
+
+    unit = t_info->unit;
+    tbl = t_info->tbl;
+    /* Return the entries and data fields to their free lists */
+    bcmimm_table_content_clear(t_info);
+    SHR_IF_ERR_EXIT(bcmimm_be_table_release(hdl));
+    tbl->signature = 0;
+    SHR_IF_ERR_EXIT(shr_ha_mem_free(unit, tbl));
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int bcmimm_be_table_index_set(bcmimm_be_tbl_hdl_t hdl, bool enable)
+{
+    bcmimm_tbl_info_t *t_info = &active_tables[hdl >> 16].tbls[hdl & 0xFFFF];
+
+    SHR_FUNC_ENTER(t_info ? t_info->unit : BSL_UNIT_UNKNOWN);
+    VALIDATE_INPUT(t_info, hdl);
+
+    /* Take the table lock */
+    SHR_IF_ERR_EXIT(sal_rwlock_wlock(t_info->lock, SAL_RWLOCK_FOREVER));
+    if (enable && !t_info->index) {
+        t_info->index = bcmimm_be_index_create(t_info->tbl->key_len);
+        SHR_NULL_CHECK(t_info->index, SHR_E_MEMORY);
+        if (SHR_FAILURE(bcmimm_table_entries_traverse(t_info,
+                                                      index_build_cb,
+                                                      t_info->index))) {
+            bcmimm_be_index_destroy(t_info->index);
+            t_info->index = NULL;
+            SHR_RETURN_VAL_EXIT(SHR_E_MEMORY);
+        }
+    } else if (!enable && t_info->index) {
+        bcmimm_be_index_destroy(t_info->index);
+        t_info->index = NULL;
+    }
+
+exit:
+    sal_rwlock_give(t_info->lock);
+    SHR_FUNC_EXIT();
+}
+
+int bcmimm_be_table_order_set(bcmimm_be_tbl_hdl_t hdl,
+                              bool enable,
+                              bcmimm_be_key_cmp_f cmp,
+                              void *user_data)
+{
+    bcmimm_tbl_info_t *t_info = &active_tables[hdl >> 16].tbls[hdl & 0xFFFF];
+
+    SHR_FUNC_ENTER(t_info ? t_info->unit : BSL_UNIT_UNKNOWN);
+    VALIDATE_INPUT(t_info, hdl);
+
+    /* Take the table lock */
+    SHR_IF_ERR_EXIT(sal_rwlock_wlock(t_info->lock, SAL_RWLOCK_FOREVER));
+    bcmimm_be_order_destroy(t_info->order);
+    t_info->order = NULL;
+    if (enable) {
+        t_info->order = bcmimm_be_order_create(t_info->tbl->key_len,
+                                               cmp, user_data);
+        SHR_NULL_CHECK(t_info->order, SHR_E_MEMORY);
+        if (SHR_FAILURE(bcmimm_table_entries_traverse(t_info,
+                                                      order_build_cb,
+                                                      t_info->order))) {
+            bcmimm_be_order_destroy(t_info->order);
+            t_info->order = NULL;
+            SHR_RETURN_VAL_EXIT(SHR_E_MEMORY);
+        }
+    }
+
+exit:
+    sal_rwlock_give(t_info->lock);
+    SHR_FUNC_EXIT();
+}
+
 size_t bcmimm_be_table_size_get(bcmimm_be_tbl_hdl_t hdl)
 {
     bcmimm_tbl_info_t *t_info = &active_tables[hdl >> 16].tbls[hdl & 0xFFFF];
@@ -419,10 +558,14 @@ int bcmimm_be_table_ctx_get_first(bcmimm_be_tbl_hdl_t hdl,
 
     /* Take the table lock */
     SHR_IF_ERR_EXIT(sal_rwlock_rlock(t_info->lock, SAL_RWLOCK_FOREVER));
-    ent = bcmimm_next_entry_find(t_info,
-                                 true,
-                                 start_idx,
-                                 &start_ptr);
+    if (t_info->order) {
+        ent = bcmimm_be_order_first(t_info->order);
+    } else {
+        ent = bcmimm_next_entry_find(t_info,
+                                     true,
+                                     start_idx,
+                                     &start_ptr);
+    }
     if (!ent) {
         SHR_RETURN_VAL_EXIT(SHR_E_NOT_FOUND);
     }
@@ -457,19 +600,23 @@ int bcmimm_be_table_ctx_get_next(bcmimm_be_tbl_hdl_t hdl,
 
     /* Take the table lock */
     SHR_IF_ERR_EXIT(sal_rwlock_rlock(t_info->lock, SAL_RWLOCK_FOREVER));
-    /* Find the previous entry and pointer */
-    start_idx = shr_elf_hash(in_key, t_info->tbl->key_len) %
-                    t_info->tbl->num_of_rows;
-    ent = bcmimm_entry_find(t_info, in_key, &ptr , NULL);
-    if (ent) {
-        start_ptr = *ptr;
-    }
-
-    /* Search from the next element */
-    ent = bcmimm_next_entry_find(t_info,
-                                 false,
-                                 start_idx,
-                                 &start_ptr );
+    if (t_info->order) {
+        ent = bcmimm_be_order_next(t_info->order, in_key);
+    } else {
+        /* Find the previous entry and pointer */
+        start_idx = shr_elf_hash(in_key, t_info->tbl->key_len) %
+                        t_info->tbl->num_of_rows;
+        ent = bcmimm_entry_find(t_info, in_key, &ptr , NULL);
+        if (ent) {
+            start_ptr = *ptr;
+        }
+
+        /* Search from the next element */
+        ent = bcmimm_next_entry_find(t_info,
+                                     false,
+                                     start_idx,
+                                     &start_ptr );
+    }
     if (!ent) {
         SHR_RETURN_VAL_EXIT(SHR_E_NOT_FOUND);
     }
@@ -508,7 +655,10 @@ int bcmimm_be_entry_insert(bcmimm_be_tbl_hdl_t hdl,
     uint32_t idx;
     uint8_t *entry;
     uint32_t *ent_ptr;
+    uint32_t *new_ent_ptr;
+    uint32_t link;
     uint16_t *entry_lock_cnt;
+    bcmimm_be_order_node_t *node = NULL;
 
     SHR_FUNC_ENTER(t_info ? t_info->unit : BSL_UNIT_UNKNOWN);
 
@@ -520,7 +670,32 @@ int bcmimm_be_entry_insert(bcmimm_be_tbl_hdl_t hdl,
     /* Take the table lock */
     SHR_IF_ERR_EXIT(sal_rwlock_wlock(t_info->lock, SAL_RWLOCK_FOREVER));
 
-    if (BCMIMM_IS_OCCUPIED(*ent_ptr)) {
+    if (t_info->index && bcmimm_be_index_find(t_info->index, key)) {
+        SHR_RETURN_VAL_EXIT(SHR_E_EXISTS);
+    }
+
+    /* Allocate the ordered index node before the table is modified */
+    if (t_info->order) {
+        node = bcmimm_be_order_node_alloc(t_info->order);
+        SHR_NULL_CHECK(node, SHR_E_MEMORY);
+    }
+
+    if (BCMIMM_IS_OCCUPIED(*ent_ptr) && t_info->index) {
+        /*
+         * The index already verified that the key is not in the table, so
+         * there is no need to go through the bin. Link the new entry right
+         * after the first entry of the bin.
+         */
+        link = 0;
+        entry = bcmimm_free_list_elem_get(t_info->unit,
+                                   t_info->entry_free_list,
+                                   &link);
+        SHR_NULL_CHECK(entry, SHR_E_MEMORY);
+        new_ent_ptr = BCMIMM_ENTRY_PTR_GET(entry, t_info->tbl->ent_len);
+        *new_ent_ptr = *ent_ptr & ~BCMIMM_PTR_CTRL_MASK;
+        BCMIMM_ASSIGN_PTR(*ent_ptr, link);
+        ent_ptr = new_ent_ptr;
+    } else if (BCMIMM_IS_OCCUPIED(*ent_ptr)) {
         /* Verify that the key is not already there */
         if (sal_memcmp(key, entry, t_info->tbl->key_len) == 0) {
             SHR_RETURN_VAL_EXIT(SHR_E_EXISTS);
@@ -551,16 +726,35 @@ int bcmimm_be_entry_insert(bcmimm_be_tbl_hdl_t hdl,
         SHR_NULL_CHECK(entry, SHR_E_MEMORY);
         /* Assigned to the last entry pointer */
         ent_ptr = BCMIMM_ENTRY_PTR_GET(entry, t_info->tbl->ent_len);
+        *ent_ptr = 0;   /* 'NULL' termination */
+    } else {
+        *ent_ptr = 0;   /* 'NULL' termination */
     }
     sal_memcpy(entry, key, t_info->tbl->key_len);
-    *ent_ptr = 0;   /* 'NULL' termination */
     entry_lock_cnt = BCMIMM_ENTRY_LOCK_CNT_GET(entry, t_info->tbl->ent_len);
     *entry_lock_cnt = 0;
     BCMIMM_OCCUPIED_SET(*ent_ptr);
     ent_ptr--;
     SHR_IF_ERR_EXIT(bcmimm_data_field_insert(t_info, ent_ptr, in));
     t_info->tbl->num_of_ent++;
+
+    if (t_info->index &&
+        SHR_FAILURE(bcmimm_be_index_insert(t_info->index, entry))) {
+        /* Keep the table consistent by searching through the bins */
+        LOG_WARN(BSL_LOG_MODULE,
+                 (BSL_META_U(t_info->unit,
+                             "Failed to grow entry index, index disabled\n")));
+        bcmimm_be_index_destroy(t_info->index);
+        t_info->index = NULL;
+    }
+    if (node) {
+        bcmimm_be_order_insert(t_info->order, node, entry);
+        node = NULL;
+    }
 exit:
+    if (node) {
+        bcmimm_be_order_node_free(node);
+    }
     sal_rwlock_give(t_info->lock);
     SHR_FUNC_EXIT();
 }
@@ -590,6 +784,13 @@ int bcmimm_be_entry_delete(bcmimm_be_tbl_hdl_t hdl, const void *key)
         SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
     }
 
+    if (t_info->index) {
+        bcmimm_be_index_delete(t_info->index, key);
+    }
+    if (t_info->order) {
+        bcmimm_be_order_delete(t_info->order, key);
+    }
+
     /* Free the data fields */
     bcmimm_free_list_elem_put(t_info->field_free_list, *(ent_ptr-1));
     t_info->tbl->num_of_ent--;
@@ -616,6 +817,12 @@ int bcmimm_be_entry_delete(bcmimm_be_tbl_hdl_t hdl, const void *key)
              * is pointed by the first entry.
              */
             sal_memcpy(prev_entry, entry, t_info->tbl->ent_len);
+            if (t_info->index) {
+                bcmimm_be_index_move(t_info->index, prev_entry);
+            }
+            if (t_info->order) {
+                bcmimm_be_order_move(t_info->order, prev_entry);
+            }
             /* Last need to set the entry to delete pointer to NULL */
             ent_ptr = (uint32_t *)(entry + ptr_offset);
             *ent_ptr = 0;
@@ -0,0 +1,527 @@
+/*! \file be_index.c
+ *
+ * In-Memory back-end open addressing entry index.
+ *
+ * The index is a Swiss table style hash table which maps the key of an
+ * entry to the location of the entry in HA memory. See \ref bcmimm_be_index_t.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <sal/sal_types.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <shr/shr_error.h>
+#include <shr/shr_hash_alg.h>
+#include "be_index.h"
+
+/*******************************************************************************
+ * Local definitions
+ */
+
+/* Default configuration */
+#ifndef BCMIMM_BE_INDEX_USE_SSE2
+#  if defined(__SSE2__)
+#    define BCMIMM_BE_INDEX_USE_SSE2    1
+#  endif
+#endif
+#ifndef BCMIMM_BE_INDEX_USE_SSE2
+#define BCMIMM_BE_INDEX_USE_SSE2        0
+#endif
+
+#if BCMIMM_BE_INDEX_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+/* Initial number of slots in the index. */
+#define INDEX_MIN_SIZE          32
+
+/* Number of old slot groups migrated with every index modification. */
+#define INDEX_MIGRATE_GROUPS    4
+
+/*
+ * The slot array is considered full when more than 7/8 of its slots are
+ * in use (including deleted slots).
+ */
+#define INDEX_ARR_FULL(_arr) \
+    (((_arr)->used + 1) * 8 > (_arr)->size * 7)
+
+/* Control byte values. A full slot holds the 7-bit tag of the key hash. */
+#define CTRL_EMPTY              0x80
+#define CTRL_DELETED            0xfe
+#define CTRL_IS_FULL(_c)        (((_c) & 0x80) == 0)
+
+/* Split the hash into the slot tag and the home group. */
+#define HASH_TAG(_h)            ((uint8_t)((_h) & 0x7f))
+#define HASH_GRP(_h)            ((_h) >> 7)
+
+#if BCMIMM_BE_INDEX_USE_SSE2
+
+/*
+ * Probe 16 control bytes at a time. The group masks hold one bit per
+ * slot.
+ */
+#define GRP_WIDTH               16
+
+typedef uint32_t grp_mask_t;
+
+static inline grp_mask_t grp_match(const uint8_t *ctrl, uint8_t tag)
+{
+    __m128i grp = _mm_loadu_si128((const __m128i *)ctrl);
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(grp, _mm_set1_epi8(tag)));
+}
+
+static inline grp_mask_t grp_match_empty(const uint8_t *ctrl)
+{
+    __m128i grp = _mm_loadu_si128((const __m128i *)ctrl);
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(grp,
+                                            _mm_set1_epi8((char)CTRL_EMPTY)));
+}
+
+/* Empty or deleted slots are the only ones with the MSB set. */
+static inline grp_mask_t grp_match_free(const uint8_t *ctrl)
+{
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+}
+
+#define GRP_MASK_SLOT(_m)       mask_ctz(_m)
+
+#else
+
+/*
+ * Probe 8 control bytes at a time using 64-bit word operations. The group
+ * masks hold the MSB of every matching control byte. Note that the tag
+ * match may report false positives for slots that follow a true match,
+ * so the callers must verify the control byte of a matching slot.
+ */
+#define GRP_WIDTH               8
+
+#define GRP_LSBS                0x0101010101010101ULL
+#define GRP_MSBS                0x8080808080808080ULL
+
+typedef uint64_t grp_mask_t;
+
+static inline uint64_t grp_load(const uint8_t *ctrl)
+{
+    return (uint64_t)ctrl[0] | (uint64_t)ctrl[1] << 8 |
+           (uint64_t)ctrl[2] << 16 | (uint64_t)ctrl[3] << 24 |
+           (uint64_t)ctrl[4] << 32 | (uint64_t)ctrl[5] << 40 |
+           (uint64_t)ctrl[6] << 48 | (uint64_t)ctrl[7] << 56;
+}
+
+static inline grp_mask_t grp_match(const uint8_t *ctrl, uint8_t tag)
+{
+    uint64_t x = grp_load(ctrl) ^ (GRP_LSBS * tag);
+
+    return (x - GRP_LSBS) & ~x & GRP_MSBS;
+}
+
+/* Empty is the only control value with the MSB set and bit 1 clear. */
+static inline grp_mask_t grp_match_empty(const uint8_t *ctrl)
+{
+    uint64_t grp = grp_load(ctrl);
+
+    return grp & ~(grp << 6) & GRP_MSBS;
+}
+
+/* Empty or deleted slots are the only ones with the MSB set. */
+static inline grp_mask_t grp_match_free(const uint8_t *ctrl)
+{
+    return grp_load(ctrl) & GRP_MSBS;
+}
+
+#define GRP_MASK_SLOT(_m)       (mask_ctz(_m) >> 3)
+
+#endif /* BCMIMM_BE_INDEX_USE_SSE2 */
+
+/*******************************************************************************
+ * Private functions
+ */
+
+/* Number of trailing zero bits of a non-zero mask. */
+static inline uint32_t mask_ctz(uint64_t mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(mask);
+#else
+    uint32_t cnt = 0;
+
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        cnt++;
+    }
+    return cnt;
+#endif
+}
+
+static int arr_alloc(bcmimm_be_index_arr_t *arr, uint32_t size)
+{
+    arr->ctrl = sal_alloc(size, "bcmimmBeIdxCtrl");
+    arr->slot = sal_alloc(size * sizeof(uint8_t *), "bcmimmBeIdxSlot");
+    if (!arr->ctrl || !arr->slot) {
+        if (arr->ctrl) {
+            sal_free(arr->ctrl);
+        }
+        if (arr->slot) {
+            sal_free(arr->slot);
+        }
+        sal_memset(arr, 0, sizeof(*arr));
+        return SHR_E_MEMORY;
+    }
+    sal_memset(arr->ctrl, CTRL_EMPTY, size);
+    sal_memset(arr->slot, 0, size * sizeof(uint8_t *));
+    arr->size = size;
+    arr->used = 0;
+    return SHR_E_NONE;
+}
+
+static void arr_free(bcmimm_be_index_arr_t *arr)
+{
+    if (arr->size) {
+        sal_free(arr->ctrl);
+        sal_free(arr->slot);
+    }
+    sal_memset(arr, 0, sizeof(*arr));
+}
+
+/*
+ * Search a slot array for a key. The groups are probed in triangular
+ * order, which visits every group once since the number of groups is a
+ * power of 2. The search ends at the first group with an empty slot.
+ * Returns the slot number of the key or -1 if not found.
+ */
+static int arr_find(const bcmimm_be_index_arr_t *arr,
+                    uint32_t key_len,
+                    const void *key,
+                    uint32_t hash)
+{
+    uint32_t grp_mask = arr->size / GRP_WIDTH - 1;
+    uint32_t grp = HASH_GRP(hash) & grp_mask;
+    uint8_t tag = HASH_TAG(hash);
+    const uint8_t *ctrl;
+    uint32_t step;
+    uint32_t pos;
+    grp_mask_t match;
+
+    for (step = 1; step <= grp_mask + 1; step++) {
+        ctrl = arr->ctrl + grp * GRP_WIDTH;
+        for (match = grp_match(ctrl, tag); match; match &= match - 1) {
+            pos = grp * GRP_WIDTH + GRP_MASK_SLOT(match);
+            if (arr->ctrl[pos] == tag &&
+                sal_memcmp(arr->slot[pos], key, key_len) == 0) {
+                return pos;
+            }
+        }
+        if (grp_match_empty(ctrl)) {
+            break;
+        }
+        grp = (grp + step) & grp_mask;
+    }
+    return -1;
+}
+
+/*
+ * Add an entry to a slot array. The array must have at least one free
+ * slot.
+ */
+static void arr_insert(bcmimm_be_index_arr_t *arr, uint8_t *ent, uint32_t hash)
+{
+    uint32_t grp_mask = arr->size / GRP_WIDTH - 1;
+    uint32_t grp = HASH_GRP(hash) & grp_mask;
+    uint32_t step;
+    uint32_t pos;
+    grp_mask_t match;
+
+    for (step = 1; step <= grp_mask + 1; step++) {
+        match = grp_match_free(arr->ctrl + grp * GRP_WIDTH);
+        if (match) {
+            pos = grp * GRP_WIDTH + GRP_MASK_SLOT(match);
+            if (arr->ctrl[pos] == CTRL_EMPTY) {
+                arr->used++;
+            }
+            arr->ctrl[pos] = HASH_TAG(hash);
+            arr->slot[pos] = ent;
+            return;
+        }
+        grp = (grp + step) & grp_mask;
+    }
+}
+
+/*
+ * Remove the entry of a slot. A group that has an empty slot was never
+ * full, so no probe sequence went past it and the slot can become empty.
+ * Otherwise the slot is marked as deleted to keep the probe sequences
+ * that pass through this group intact.
+ */
+static void arr_erase(bcmimm_be_index_arr_t *arr, uint32_t pos)
+{
+    if (grp_match_empty(arr->ctrl + (pos & ~(GRP_WIDTH - 1)))) {
+        arr->ctrl[pos] = CTRL_EMPTY;
+        arr->used--;
+    } else {
+        arr->ctrl[pos] = CTRL_DELETED;
+    }
+    arr->slot[pos] = NULL;
+}
+
+/*
+ * Move the entries of up to \c groups groups from the old slot array
+ * into the current one. The migrated slots are marked as deleted rather
+ * than empty so that lookups in the old array still probe past them.
+ */
+static void index_migrate(bcmimm_be_index_t *idx, uint32_t groups)
+{
+    bcmimm_be_index_arr_t *old = &idx->old;
+    uint32_t base;
+    uint32_t j;
+    uint8_t *ent;
+
+    while (old->size && groups-- > 0) {
+        base = idx->migrate_grp * GRP_WIDTH;
+        for (j = base; j < base + GRP_WIDTH; j++) {
+            if (CTRL_IS_FULL(old->ctrl[j])) {
+                ent = old->slot[j];
+                arr_insert(&idx->cur, ent, shr_word_hash(ent, idx->key_len));
+                old->ctrl[j] = CTRL_DELETED;
+                old->slot[j] = NULL;
+            }
+        }
+        if (++idx->migrate_grp == old->size / GRP_WIDTH) {
+            arr_free(old);
+            idx->migrate_grp = 0;
+        }
+    }
+}
+
+/*
+ * Replace the current slot array with a new one. The new array is twice
+ * as large unless most of the used slots are deleted, in which case the
+ * array is only rebuilt to drop the deleted slots. The entries are moved
+ * into the new array incrementally by index_migrate().
+ */
+static int index_grow(bcmimm_be_index_t *idx)
+{
+    uint32_t size = idx->cur.size;
+    int rv;
+
+    /* Complete a pending migration first. */
+    while (idx->old.size) {
+        index_migrate(idx, INDEX_MIGRATE_GROUPS);
+    }
+    if (!INDEX_ARR_FULL(&idx->cur)) {
+        return SHR_E_NONE;
+    }
+
+    if ((idx->count + 1) * 16 > size * 7) {
+        size *= 2;
+    }
+    idx->old = idx->cur;
+    rv = arr_alloc(&idx->cur, size);
+    if (SHR_FAILURE(rv)) {
+        idx->cur = idx->old;
+        sal_memset(&idx->old, 0, sizeof(idx->old));
+        return rv;
+    }
+    idx->migrate_grp = 0;
+    return SHR_E_NONE;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+bcmimm_be_index_t *bcmimm_be_index_create(uint32_t key_len)
+{
+    bcmimm_be_index_t *idx;
+
+    idx = sal_alloc(sizeof(*idx), "bcmimmBeIdx");
+    if (!idx) {
+        return NULL;
+    }
+    sal_memset(idx, 0, sizeof(*idx));
+    idx->key_len = key_len;
+    if (SHR_FAILURE(arr_alloc(&idx->cur, INDEX_MIN_SIZE))) {
+        sal_free(idx);
+        return NULL;
+    }
+    return idx;
+}
+
+void bcmimm_be_index_destroy(bcmimm_be_index_t *idx)
+{
+    if (!idx) {
+        return;
+    }
+    arr_free(&idx->cur);
+    arr_free(&idx->old);
+    sal_free(idx);
+}
+
+void bcmimm_be_index_clear(bcmimm_be_index_t *idx)
+{
+    arr_free(&idx->old);
+    idx->migrate_grp = 0;
+    sal_memset(idx->cur.ctrl, CTRL_EMPTY, idx->cur.size);
+    sal_memset(idx->cur.slot, 0, idx->cur.size * sizeof(uint8_t *));
+    idx->cur.used = 0;
+    idx->count = 0;
+}
+
+uint8_t *bcmimm_be_index_find(bcmimm_be_index_t *idx, const void *key)
+{
+    uint32_t hash = shr_word_hash(key, idx->key_len);
+    int pos;
+
+    pos = arr_find(&idx->cur, idx->key_len, key, hash);
+    if (pos >= 0) {
+        return idx->cur.slot[pos];
+    }
+    if (idx->old.size) {
+        pos = arr_find(&idx->old, idx->key_len, key, hash);
+        if (pos >= 0) {
+            return idx->old.slot[pos];
+        }
+    }
+    return NULL;
+}
+
+int bcmimm_be_index_insert(bcmimm_be_index_t *idx, uint8_t *ent)
+{
+    int rv;
+
+    index_migrate(idx, INDEX_MIGRATE_GROUPS);
+    if (INDEX_ARR_FULL(&idx->cur)) {
+        rv = index_grow(idx);
+        if (SHR_FAILURE(rv)) {
+            return rv;
+        }
+    }
+    arr_insert(&idx->cur, ent, shr_word_hash(ent, idx->key_len));
+    idx->count++;
+    return SHR_E_NONE;
+}
+
+void bcmimm_be_index_delete(bcmimm_be_index_t *idx, const void *key)
+{
+    uint32_t hash = shr_word_hash(key, idx->key_len);
+    int pos;
+
+    index_migrate(idx, INDEX_MIGRATE_GROUPS);
+    pos = arr_find(&idx->cur, idx->key_len, key, hash);
+    if (pos >= 0) {
+        arr_erase(&idx->cur, pos);
+        idx->count--;
+        return;
+    }
+    if (idx->old.size) {
+        pos = arr_find(&idx->old, idx->key_len, key, hash);
+        if (pos >= 0) {
+            arr_erase(&idx->old, pos);
+            idx->count--;
+        }
+    }
+}
+
+void bcmimm_be_index_move(bcmimm_be_index_t *idx, uint8_t *ent)
+{
+    uint32_t hash = shr_word_hash(ent, idx->key_len);
+    int pos;
+
+    pos = arr_find(&idx->cur, idx->key_len, ent, hash);
+    if (pos >= 0) {
+        idx->cur.slot[pos] = ent;
+        return;
+    }
+    if (idx->old.size) {
+        pos = arr_find(&idx->old, idx->key_len, ent, hash);
+        if (pos >= 0) {
+            idx->old.slot[pos] = ent;
+        }
+    }
+}
@@ -922,9 +922,32 @@ uint8_t *bcmimm_entry_find(bcmimm_tbl_info_t *t_info,
 {
     uint32_t idx;
     uint8_t *entry;
+    uint8_t *bin;
     bool found;
     size_t ptr_offset = t_info->tbl->ent_len - BCMIMM_ELEM_PTR_SIZE;
 
+    if (t_info->index) {
+        entry = bcmimm_be_index_find(t_info->index, key);
+        if (!entry) {
+            return NULL;
+        }
+        *ent_ptr = (uint32_t *)(entry + ptr_offset);
+        if (prev_ent) {
+            /* Follow the bin to the entry preceding the one found */
+            *prev_ent = NULL;
+            idx = shr_elf_hash(key, t_info->tbl->key_len) %
+                t_info->tbl->num_of_rows;
+            bin = (uint8_t *)t_info->tbl + sizeof(tbl_header_t) +
+                idx * t_info->tbl->ent_len;
+            while (bin != entry) {
+                *prev_ent = bin;
+                bin = bcmimm_entry_get(t_info->entry_free_list,
+                                       *(uint32_t *)(bin + ptr_offset));
+            }
+        }
+        return entry;
+    }
+
     idx = shr_elf_hash(key, t_info->tbl->key_len) % t_info->tbl->num_of_rows;
     entry = (uint8_t *)t_info->tbl;
     entry += sizeof(tbl_header_t);
@@ -1005,6 +1028,45 @@ void bcmimm_table_content_clear(bcmimm_tbl_info_t *t_info)
     }
 
     t_info->tbl->num_of_ent = 0;    /* Table has no entries */
+    if (t_info->index) {
+        bcmimm_be_index_clear(t_info->index);
+    }
+    if (t_info->order) {
+        bcmimm_be_order_clear(t_info->order);
+    }
+}
+
+int bcmimm_table_entries_traverse(bcmimm_tbl_info_t *t_info,
+                                  bcmimm_table_entry_cb_f cb,
+                                  void *user_data)
+{
+    uint32_t j;
+    uint8_t *ent;
+    uint32_t ptr_val;
+    size_t ptr_offset = t_info->tbl->ent_len - BCMIMM_ELEM_PTR_SIZE;
+    int rv;
+
+    ent = ((uint8_t *)t_info->tbl) + sizeof(tbl_header_t);
+    for (j = 0; j < t_info->tbl->num_of_rows; j++) {
+        ptr_val = *(uint32_t *)(ent + ptr_offset);
+        if (BCMIMM_IS_OCCUPIED(ptr_val)) {
+            rv = cb(user_data, ent);
+            if (SHR_FAILURE(rv)) {
+                return rv;
+            }
+            while (!BCMIMM_IS_NULL_PTR(ptr_val)) {
+                ent = bcmimm_entry_get (t_info->entry_free_list, ptr_val);
+                rv = cb(user_data, ent);
+                if (SHR_FAILURE(rv)) {
+                    return rv;
+                }
+                ptr_val = *(uint32_t *)(ent + ptr_offset);
+            }
+        }
+        ent = ((uint8_t *)t_info->tbl) + sizeof(tbl_header_t) +
+            (j + 1) * t_info->tbl->ent_len;
+    }
+    return SHR_E_NONE;
 }
 
 uint8_t *bcmimm_next_entry_find(bcmimm_tbl_info_t *t_info,
@@ -92,6 +92,9 @@
 #ifndef BE_INTERNALS_H
 #define BE_INTERNALS_H
 
+#include "be_index.h"
+#include "be_order.h"
+
 /*!
  * \brief Element pointer size.
  *
@@ -356,6 +359,10 @@ typedef struct bcmimm_tbl_info_s {
     bcmimm_free_list_t *entry_free_list;
     /*! Table read/write lock. */
     sal_rwlock_t lock;
+    /*! Entry index (NULL if entries are searched through the bins). */
+    bcmimm_be_index_t *index;
+    /*! Key ordered index (NULL if traversed in bin order). */
+    bcmimm_be_order_t *order;
 } bcmimm_tbl_info_t;
 
 /*!
@@ -572,6 +579,29 @@ extern int bcmimm_free_lists_retrieve(int unit, uint8_t sub);
  */
 extern void bcmimm_table_content_clear(bcmimm_tbl_info_t *t_info);
 
+/*!
+ * \brief Table entry callback function.
+ * \param [in] user_data Context given to \ref bcmimm_table_entries_traverse.
+ * \param [in] ent The table entry.
+ * \return SHR_E_NONE to continue the traverse, error code to stop it.
+ */
+typedef int (*bcmimm_table_entry_cb_f)(void *user_data, uint8_t *ent);
+
+/*!
+ * \brief Call a function for every entry of a table.
+ * This function goes through all the bins of the table and calls the
+ * callback function for every entry. It is used to build the entry
+ * indexes of the table from the HA entries.
+ * \param [in] t_info This is a pointer to all the relevant information
+ * associated with the table.
+ * \param [in] cb The function to call for every entry.
+ * \param [in] user_data Context for the callback function.
+ * \return SHR_E_NONE success, the callback error code otherwise.
+ */
+extern int bcmimm_table_entries_traverse(bcmimm_tbl_info_t *t_info,
+                                         bcmimm_table_entry_cb_f cb,
+                                         void *user_data);
+
 /*!
  * \brief Finds the next entry in a table.
  *
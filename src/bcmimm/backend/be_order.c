@@ -0,0 +1,328 @@
+/*! \file be_order.c
+ *
+ * In-Memory back-end key ordered entry index.
+ *
+ * The ordered index is a skip list of the table entries. See
+ * \ref bcmimm_be_order_t.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <sal/sal_types.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include "be_order.h"
+
+/*******************************************************************************
+ * Local definitions
+ */
+
+/* Size of a node with a given number of levels. */
+#define NODE_SIZE(_level) \
+    (sizeof(bcmimm_be_order_node_t) + \
+     ((_level) - 1) * sizeof(bcmimm_be_order_node_t *))
+
+/*******************************************************************************
+ * Private functions
+ */
+
+static inline int key_cmp(bcmimm_be_order_t *order,
+                          const uint8_t *key1,
+                          const uint8_t *key2)
+{
+    uint32_t j;
+
+    if (order->cmp) {
+        return order->cmp(order->user_data, key1, key2);
+    }
+    /* Compare from the most significant byte */
+    for (j = order->key_len; j-- > 0; ) {
+        if (key1[j] != key2[j]) {
+            return (key1[j] < key2[j]) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Find the first node with a key which is not lower than the given key.
+ * If update is not NULL, it receives the last node before the key in
+ * every level.
+ */
+static bcmimm_be_order_node_t *order_seek(bcmimm_be_order_t *order,
+                                          const uint8_t *key,
+                                          bcmimm_be_order_node_t **update)
+{
+    bcmimm_be_order_node_t *node = order->head;
+    uint32_t lvl;
+
+    for (lvl = order->level; lvl-- > 0; ) {
+        while (node->next[lvl] &&
+               key_cmp(order, node->next[lvl]->ent, key) < 0) {
+            node = node->next[lvl];
+        }
+        if (update) {
+            update[lvl] = node;
+        }
+    }
+    return node->next[0];
+}
+
+/* Pick the level of a new node, every level with probability 1/4. */
+static uint32_t order_random_level(bcmimm_be_order_t *order)
+{
+    uint32_t lvl = 1;
+    uint32_t rnd;
+
+    /* Xorshift random generator */
+    rnd = order->seed;
+    rnd ^= rnd << 13;
+    rnd ^= rnd >> 17;
+    rnd ^= rnd << 5;
+    order->seed = rnd;
+
+    while ((rnd & 3) == 0 && lvl < BCMIMM_BE_ORDER_MAX_LEVEL) {
+        lvl++;
+        rnd >>= 2;
+    }
+    return lvl;
+}
+
+static void order_nodes_free(bcmimm_be_order_t *order)
+{
+    bcmimm_be_order_node_t *node = order->head->next[0];
+    bcmimm_be_order_node_t *next;
+
+    while (node) {
+        next = node->next[0];
+        sal_free(node);
+        node = next;
+    }
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+bcmimm_be_order_t *bcmimm_be_order_create(uint32_t key_len,
+                                          bcmimm_be_key_cmp_f cmp,
+                                          void *user_data)
+{
+    bcmimm_be_order_t *order;
+
+    order = sal_alloc(sizeof(*order), "bcmimmBeOrder");
+    if (!order) {
+        return NULL;
+    }
+    sal_memset(order, 0, sizeof(*order));
+    order->head = sal_alloc(NODE_SIZE(BCMIMM_BE_ORDER_MAX_LEVEL),
+                            "bcmimmBeOrderHead");
+    if (!order->head) {
+        sal_free(order);
+        return NULL;
+    }
+    sal_memset(order->head, 0, NODE_SIZE(BCMIMM_BE_ORDER_MAX_LEVEL));
+    order->head->level = BCMIMM_BE_ORDER_MAX_LEVEL;
+    order->key_len = key_len;
+    order->cmp = cmp;
+    order->user_data = user_data;
+    order->level = 1;
+    order->seed = 0x2545f491;
+    return order;
+}
+
+void bcmimm_be_order_destroy(bcmimm_be_order_t *order)
+{
+    if (!order) {
+        return;
+    }
+    order_nodes_free(order);
+    sal_free(order->head);
+    sal_free(order);
+}
+
+void bcmimm_be_order_clear(bcmimm_be_order_t *order)
+{
+    order_nodes_free(order);
+    sal_memset(order->head->next, 0,
+               BCMIMM_BE_ORDER_MAX_LEVEL * sizeof(bcmimm_be_order_node_t *));
+    order->level = 1;
+    order->count = 0;
+}
+
+bcmimm_be_order_node_t *bcmimm_be_order_node_alloc(bcmimm_be_order_t *order)
+{
+    bcmimm_be_order_node_t *node;
+    uint32_t lvl = order_random_level(order);
+
+    node = sal_alloc(NODE_SIZE(lvl), "bcmimmBeOrderNode");
+    if (node) {
+        sal_memset(node, 0, NODE_SIZE(lvl));
+        node->level = lvl;
+    }
+    return node;
+}
+
+void bcmimm_be_order_node_free(bcmimm_be_order_node_t *node)
+{
+    sal_free(node);
+}
+
+void bcmimm_be_order_insert(bcmimm_be_order_t *order,
+                            bcmimm_be_order_node_t *node,
+                            uint8_t *ent)
+{
+    bcmimm_be_order_node_t *update[BCMIMM_BE_ORDER_MAX_LEVEL];
+    uint32_t lvl;
+
+    order_seek(order, ent, update);
+    for (lvl = order->level; lvl < node->level; lvl++) {
+        update[lvl] = order->head;
+    }
+    if (node->level > order->level) {
+        order->level = node->level;
+    }
+
+    node->ent = ent;
+    for (lvl = 0; lvl < node->level; lvl++) {
+        node->next[lvl] = update[lvl]->next[lvl];
+        update[lvl]->next[lvl] = node;
+    }
+    order->count++;
+}
+
+void bcmimm_be_order_delete(bcmimm_be_order_t *order, const void *key)
+{
+    bcmimm_be_order_node_t *update[BCMIMM_BE_ORDER_MAX_LEVEL];
+    bcmimm_be_order_node_t *node;
+    uint32_t lvl;
+
+    node = order_seek(order, key, update);
+    if (!node || key_cmp(order, node->ent, key) != 0) {
+        return;
+    }
+    for (lvl = 0; lvl < node->level; lvl++) {
+        update[lvl]->next[lvl] = node->next[lvl];
+    }
+    while (order->level > 1 && !order->head->next[order->level - 1]) {
+        order->level--;
+    }
+    sal_free(node);
+    order->count--;
+}
+
+void bcmimm_be_order_move(bcmimm_be_order_t *order, uint8_t *ent)
+{
+    bcmimm_be_order_node_t *node;
+
+    node = order_seek(order, ent, NULL);
+    if (node && key_cmp(order, node->ent, ent) == 0) {
+        node->ent = ent;
+    }
+}
+
+uint8_t *bcmimm_be_order_first(bcmimm_be_order_t *order)
+{
+    bcmimm_be_order_node_t *node = order->head->next[0];
+
+    return node ? node->ent : NULL;
+}
+
+uint8_t *bcmimm_be_order_next(bcmimm_be_order_t *order, const void *key)
+{
+    bcmimm_be_order_node_t *node;
+
+    /*
+     * Traverse operations run concurrently under the table read lock, so
+     * the index is not modified here. The key of the caller is its cursor.
+     */
+    node = order_seek(order, key, NULL);
+    if (node && key_cmp(order, node->ent, key) == 0) {
+        node = node->next[0];
+    }
+    return node ? node->ent : NULL;
+}
@@ -0,0 +1,258 @@
+/*! \file be_order.h
+ *
+ * In-Memory back-end key ordered entry index.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#ifndef BE_ORDER_H
+#define BE_ORDER_H
+
+#include <sal/sal_types.h>
+#include <bcmimm/bcmimm_backend.h>
+
+/*! Maximal number of levels of the ordered index. */
+#define BCMIMM_BE_ORDER_MAX_LEVEL   16
+
+/*!
+ * \brief Ordered index node.
+ *
+ * Every node is linked into the lists of levels 0 to \c level - 1. The
+ * level 0 list contains all the nodes in key order.
+ */
+typedef struct bcmimm_be_order_node_s {
+    /*! The entry in HA memory. The key is at the start of the entry. */
+    uint8_t *ent;
+    /*! Number of levels of this node. */
+    uint32_t level;
+    /*! The next node in every level (variable size). */
+    struct bcmimm_be_order_node_s *next[1];
+} bcmimm_be_order_node_t;
+
+/*!
+ * \brief Key ordered entry index of a back-end table.
+ *
+ * The ordered index is a skip list that keeps the table entries sorted
+ * by key. Seeking a key takes O(log n) steps. Traverse operations only
+ * read the index, so they may run concurrently under the table read
+ * lock.
+ *
+ * The index is kept in regular memory and is rebuilt from the HA
+ * entries when it is enabled.
+ */
+typedef struct bcmimm_be_order_s {
+    /*! The key length (in bytes). */
+    uint32_t key_len;
+    /*! Key compare function (NULL for unsigned little endian order). */
+    bcmimm_be_key_cmp_f cmp;
+    /*! Context for the key compare function. */
+    void *user_data;
+    /*! Number of levels in use. */
+    uint32_t level;
+    /*! Random generator state for the node levels. */
+    uint32_t seed;
+    /*! Number of entries in the index. */
+    uint32_t count;
+    /*! List heads node of all levels. */
+    bcmimm_be_order_node_t *head;
+} bcmimm_be_order_t;
+
+/*!
+ * \brief Create ordered index.
+ *
+ * \param [in] key_len The key length (in bytes).
+ * \param [in] cmp Key compare function. If NULL, keys are compared as
+ * unsigned little endian numbers.
+ * \param [in] user_data Context for the key compare function.
+ *
+ * \return Pointer to the new index on success and NULL otherwise.
+ */
+extern bcmimm_be_order_t *bcmimm_be_order_create(uint32_t key_len,
+                                                 bcmimm_be_key_cmp_f cmp,
+                                                 void *user_data);
+
+/*!
+ * \brief Destroy ordered index.
+ *
+ * \param [in] order The index to destroy.
+ *
+ * \return None.
+ */
+extern void bcmimm_be_order_destroy(bcmimm_be_order_t *order);
+
+/*!
+ * \brief Remove all the entries from an ordered index.
+ *
+ * \param [in] order The index to clear.
+ *
+ * \return None.
+ */
+extern void bcmimm_be_order_clear(bcmimm_be_order_t *order);
+
+/*!
+ * \brief Allocate ordered index node.
+ *
+ * The node is allocated ahead of \ref bcmimm_be_order_insert() so that
+ * the caller can fail an operation before it modifies the table.
+ *
+ * \param [in] order The index to allocate the node for.
+ *
+ * \return Pointer to the node on success and NULL otherwise.
+ */
+extern bcmimm_be_order_node_t *bcmimm_be_order_node_alloc(
+    bcmimm_be_order_t *order);
+
+/*!
+ * \brief Free ordered index node that was not inserted.
+ *
+ * \param [in] node The node to free.
+ *
+ * \return None.
+ */
+extern void bcmimm_be_order_node_free(bcmimm_be_order_node_t *node);
+
+/*!
+ * \brief Add entry to the ordered index.
+ *
+ * The caller must verify that the key of the entry is not already in
+ * the index.
+ *
+ * \param [in] order The index to add the entry to.
+ * \param [in] node Node obtained from \ref bcmimm_be_order_node_alloc().
+ * \param [in] ent The entry to add.
+ *
+ * \return None.
+ */
+extern void bcmimm_be_order_insert(bcmimm_be_order_t *order,
+                                   bcmimm_be_order_node_t *node,
+                                   uint8_t *ent);
+
+/*!
+ * \brief Remove entry from the ordered index.
+ *
+ * \param [in] order The index to remove the entry from.
+ * \param [in] key The key of the entry to remove.
+ *
+ * \return None.
+ */
+extern void bcmimm_be_order_delete(bcmimm_be_order_t *order,
+                                   const void *key);
+
+/*!
+ * \brief Update the entry location of a key.
+ *
+ * \param [in] order The index to update.
+ * \param [in] ent The new location of the entry.
+ *
+ * \return None.
+ */
+extern void bcmimm_be_order_move(bcmimm_be_order_t *order, uint8_t *ent);
+
+/*!
+ * \brief Get the entry with the lowest key.
+ *
+ * \param [in] order The index to traverse.
+ *
+ * \return Pointer to the entry or NULL if the index is empty.
+ */
+extern uint8_t *bcmimm_be_order_first(bcmimm_be_order_t *order);
+
+/*!
+ * \brief Get the entry with the lowest key above a given key.
+ *
+ * The given key does not have to be in the index.
+ *
+ * \param [in] order The index to traverse.
+ * \param [in] key The key to start from.
+ *
+ * \return Pointer to the entry or NULL if there is no such entry.
+ */
+extern uint8_t *bcmimm_be_order_next(bcmimm_be_order_t *order,
+                                     const void *key);
+
+#endif /* BE_ORDER_H */
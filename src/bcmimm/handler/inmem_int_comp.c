@@ -109,6 +109,26 @@
 
 #define BSL_LOG_MODULE BSL_LS_BCMIMM_FRONTEND
 
+/*
+ * Compare two keys of a table with multiple key fields. The keys are
+ * compared field by field in the order of the key fields.
+ */
+static int key_compare(void *user_data, const void *key1, const void *key2)
+{
+    table_info_t *tbl = (table_info_t *)user_data;
+    bcmltd_field_t fld1;
+    bcmltd_field_t fld2;
+    int idx;
+
+    for (idx = 0; idx < tbl->key_fld_cnt; idx++) {
+        bcmimm_extract_key_fld(tbl, (uint8_t *)key1, idx, &fld1);
+        bcmimm_extract_key_fld(tbl, (uint8_t *)key2, idx, &fld2);
+        if (fld1.data != fld2.data) {
+            return (fld1.data < fld2.data) ? -1 : 1;
+        }
+    }
+    return 0;
+}
 
 static int setup_key(table_info_t *tbl,
                      uint8_t *key_buf,
@@ -609,6 +629,28 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+int bcmimm_table_ordered_set(int unit, bcmltd_sid_t sid, bool enable)
+{
+    table_info_t *tbl;
+
+    SHR_FUNC_ENTER(unit);
+
+    tbl = bcmimm_tbl_find(unit, sid, NULL);
+    SHR_NULL_CHECK(tbl, SHR_E_PARAM);
+
+    /*
+     * The first key field occupies the low bits of the key buffer, so a
+     * single key field can be compared as a little endian number.
+     */
+    SHR_IF_ERR_EXIT
+        (bcmimm_be_table_order_set(tbl->blk_hdl,
+                                   enable,
+                                   tbl->key_fld_cnt > 1 ? key_compare : NULL,
+                                   tbl));
+exit:
+    SHR_FUNC_EXIT();
+}
+
 int bcmimm_lt_event_reg(int unit,
                         bcmltd_sid_t sid,
                         bcmimm_lt_cb_t *cb,
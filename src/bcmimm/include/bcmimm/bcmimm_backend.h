@@ -99,11 +99,35 @@
  */
 #define BCMIMM_BE_FID_SIZE  sizeof(uint32_t)
 
+/*!
+ * \brief Sub-component ID for temporary back-end tables.
+ *
+ * The back-end element blocks never use sub-component 0, so temporary
+ * tables can be created with the back-end component ID and this
+ * sub-component ID. See \ref bcmimm_be_table_destroy().
+ */
+#define BCMIMM_BE_TEMP_SUB_ID   0
+
 /*!
  * \brief In-Memory backend table handle type.
  */
 typedef uint32_t bcmimm_be_tbl_hdl_t;
 
+/*!
+ * \brief Back-end key compare function.
+ *
+ * \param [in] user_data Context provided together with the function.
+ * \param [in] key1 The first key to compare.
+ * \param [in] key2 The second key to compare.
+ *
+ * \retval Negative value if \c key1 is lower than \c key2.
+ * \retval 0 if the keys are equal.
+ * \retval Positive value if \c key1 is greater than \c key2.
+ */
+typedef int (*bcmimm_be_key_cmp_f)(void *user_data,
+                                   const void *key1,
+                                   const void *key2);
+
 /*!
  * \brief Entry fields set.
  */
@@ -211,6 +235,67 @@ extern int bcmimm_be_table_create(int unit,
  */
 extern int bcmimm_be_table_release(bcmimm_be_tbl_hdl_t hdl);
 
+/*!
+ * \brief Destroy back-end table and free its HA memory.
+ *
+ * Unlike \ref bcmimm_be_table_release(), this function deletes all the
+ * table entries and frees the HA memory of the table, so the table
+ * content is not preserved for warm boot. It is intended for temporary
+ * tables.
+ *
+ * \param [in] hdl This is the table handle.
+ *
+ * \return SHR_E_NONE on success, error code otherwise.
+ */
+extern int bcmimm_be_table_destroy(bcmimm_be_tbl_hdl_t hdl);
+
+/*!
+ * \brief Enable or disable the entry index of a back-end table.
+ *
+ * The entry index is an open addressing hash table kept in regular memory
+ * which maps every key to its entry. It grows with the number of entries
+ * regardless of the number of rows given to \ref bcmimm_be_table_create(),
+ * so lookups remain fast when the hash bins of the table overflow.
+ * Without the index the entries are searched through the hash bins.
+ *
+ * The index is enabled by default and is rebuilt from the table entries
+ * when the table is created during warm boot.
+ *
+ * \param [in] hdl This is the table handle.
+ * \param [in] enable Set to true to build the index and to false to
+ * remove it.
+ *
+ * \return SHR_E_NONE on success, error code otherwise.
+ */
+extern int bcmimm_be_table_index_set(bcmimm_be_tbl_hdl_t hdl, bool enable);
+
+/*!
+ * \brief Enable or disable key ordered traverse of a back-end table.
+ *
+ * When enabled, the back-end keeps the table entries sorted by key in
+ * regular memory. \ref bcmimm_be_table_ctx_get_first() then returns the
+ * entry with the lowest key and \ref bcmimm_be_table_ctx_get_next()
+ * returns the entry with the lowest key above the input key. The input
+ * key does not have to be in the table, so this can also be used to
+ * start a traverse from any point of a key range.
+ *
+ * The ordered index is not preserved across warm boot, so the caller
+ * should enable it every time the table is created.
+ *
+ * \param [in] hdl This is the table handle.
+ * \param [in] enable Set to true to build the ordered index and to false
+ * to remove it.
+ * \param [in] cmp Key compare function. If NULL, keys are compared as
+ * unsigned little endian numbers.
+ * \param [in] user_data Context for the key compare function.
+ *
+ * \return SHR_E_NONE on success, error code otherwise.
+ */
+extern int bcmimm_be_table_order_set(bcmimm_be_tbl_hdl_t hdl,
+                                     bool enable,
+                                     bcmimm_be_key_cmp_f cmp,
+                                     void *user_data);
+
 /*!
  * \brief The number of entries in the table
  *
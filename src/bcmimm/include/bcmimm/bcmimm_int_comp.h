@@ -244,7 +244,8 @@ extern int bcmimm_entry_get_first(int unit,
  * function will start where the previous call to this function was left off.
  * The order of the entries is based on internal oerder maintained by the
  * back-end module hence the caller should not assume anything about the order
- * of entries.
+ * of entries, unless key ordered traverse was enabled for the table using
+ * \ref bcmimm_table_ordered_set().
  *
  * \param [in] unit This is device unit number.
  * \param [in] sid This is the logical table ID.
@@ -263,6 +264,31 @@ extern int bcmimm_entry_get_next(int unit,
                                  const bcmltd_fields_t *in,
                                  bcmltd_fields_t *out);
 
+/*!
+ * \brief Enable or disable key ordered traverse of a table.
+ *
+ * When enabled, \ref bcmimm_entry_get_first() returns the entry with the
+ * lowest key and \ref bcmimm_entry_get_next() returns the entry with the
+ * lowest key above the key given in its input fields. Keys are ordered by
+ * the first key field, then by the second key field and so on. The input
+ * key of \ref bcmimm_entry_get_next() does not have to exist in the
+ * table, so a traverse can start anywhere within a key range.
+ * Key ordered traverse applies to the northbound traverse of the table
+ * as well.
+ *
+ * Every get-next seeks its input key in O(log n) steps, so concurrent
+ * traverses of the table do not modify the index. The ordered index is
+ * kept in regular memory, so the component should enable it during every
+ * initialization, including warm boot.
+ *
+ * \param [in] unit This is device unit number.
+ * \param [in] sid This is the logical table ID.
+ * \param [in] enable Set to true to enable key ordered traverse.
+ *
+ * \return SHR_E_NONE on success, error code otherwise.
+ */
+extern int bcmimm_table_ordered_set(int unit, bcmltd_sid_t sid, bool enable);
+
 /*!
  * \brief In-memory notification reason
  *
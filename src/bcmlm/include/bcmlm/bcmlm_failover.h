@@ -0,0 +1,200 @@
+/*! \file bcmlm_failover.h
+ *
+ * Link Manager fast failover interface.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+#ifndef BCMLM_FAILOVER_H
+#define BCMLM_FAILOVER_H
+
+#include <sal/sal_types.h>
+#include <shr/shr_types.h>
+
+/*!
+ * \brief Link down event for fast failover.
+ *
+ * Published synchronously from the linkscan thread as soon as a port
+ * stops forwarding, before the link state is written to the LM LTs.
+ * Subscribers are expected to do only the minimal hardware updates
+ * needed to steer traffic away from the port.
+ */
+#define BCMLM_EV_LINK_DOWN_FAST         "bcmlmEvLinkDownFast"
+
+/*!
+ * \brief Link up event for fast failover.
+ *
+ * Posted for deferred notification when a port reported through
+ * \ref BCMLM_EV_LINK_DOWN_FAST is forwarding again.
+ */
+#define BCMLM_EV_LINK_UP_FAST           "bcmlmEvLinkUpFast"
+
+/*! Build the event data of a fast failover event. */
+#define BCMLM_FAILOVER_EV_DATA(_port, _seq) \
+    (((uint64_t)(_seq) << 32) | (uint32_t)(_port))
+
+/*! Get the port number from the event data of a fast failover event. */
+#define BCMLM_FAILOVER_EV_PORT(_ev_data) \
+    ((shr_port_t)((_ev_data) & 0xffffffff))
+
+/*!
+ * \brief Get the sequence number from the event data of a fast failover event.
+ *
+ * The sequence number increases with every fast failover event of a
+ * unit. A subscriber may use it to discard a deferred link up event
+ * which was overtaken by a later link down event of the same port.
+ */
+#define BCMLM_FAILOVER_EV_SEQ(_ev_data) \
+    ((uint32_t)((_ev_data) >> 32))
+
+/*!
+ * \brief Fast failover statistics.
+ *
+ * The latency is measured from the start of the link state update in
+ * the linkscan thread until all subscribers of \ref
+ * BCMLM_EV_LINK_DOWN_FAST have returned.
+ */
+typedef struct bcmlm_failover_stats_s {
+
+    /*! Number of link down events published. */
+    uint32_t count;
+
+    /*! Number of events which could not be published. */
+    uint32_t errors;
+
+    /*! Latency of the most recent link down event in usecs. */
+    uint32_t last_usecs;
+
+    /*! Maximum latency in usecs. */
+    uint32_t max_usecs;
+
+    /*! Sum of all latencies in usecs. */
+    uint64_t total_usecs;
+
+} bcmlm_failover_stats_t;
+
+/*!
+ * \brief Enable or disable fast failover notification.
+ *
+ * Fast failover is disabled by default. Ports which were reported down
+ * while fast failover was enabled are still reported up when their
+ * link returns, even if fast failover has been disabled since.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] enable Enable or disable.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_INIT Link control is not initialized.
+ */
+extern int
+bcmlm_failover_enable(int unit, bool enable);
+
+/*!
+ * \brief Get fast failover statistics.
+ *
+ * \param [in] unit Unit number.
+ * \param [out] stats Fast failover statistics.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_PARAM Invalid parameter.
+ * \retval SHR_E_INIT Link control is not initialized.
+ */
+extern int
+bcmlm_failover_stats_get(int unit, bcmlm_failover_stats_t *stats);
+
+/*!
+ * \brief Clear fast failover statistics.
+ *
+ * \param [in] unit Unit number.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_INIT Link control is not initialized.
+ */
+extern int
+bcmlm_failover_stats_clear(int unit);
+
+#endif /* BCMLM_FAILOVER_H */
@@ -97,11 +97,13 @@
 #include <sal/sal_sleep.h>
 #include <sal/sal_thread.h>
 #include <sal/sal_mutex.h>
+#include <sal/sal_time.h>
 
 #include <bcmltd/chip/bcmltd_id.h>
 #include <bcmevm/bcmevm_api.h>
 #include <bcmpc/bcmpc_lport.h>
 #include <bcmlm/bcmlm_drv_internal.h>
+#include <bcmlm/bcmlm_failover.h>
 #include "bcmlm_internal.h"
 
 /******************************************************************************
@@ -182,6 +184,24 @@ typedef struct bcmlm_ctrl_s {
     /* Override link status has changed */
     int             ovr_change;
 
+    /* Fast failover notification enabled */
+    int             ff_enable;
+
+    /* Ports reported down through fast failover */
+    bcmdrd_pbmp_t   pbm_ff_down;
+
+    /* Sequence number of the last fast failover event */
+    uint32_t        ff_seq;
+
+    /* Event ID of fast failover link down event */
+    uint32_t        ff_down_ev;
+
+    /* Event ID of fast failover link up event */
+    uint32_t        ff_up_ev;
+
+    /* Fast failover statistics */
+    bcmlm_failover_stats_t ff_stats;
+
 } bcmlm_ctrl_t;
 
 /* link control database */
@@ -196,6 +216,73 @@ static bcmlm_ctrl_t *bcmlm_ctrl[BCMLM_DEV_NUM_MAX];
 /******************************************************************************
 * Private functions
  */
+/*
+ * Notify fast failover subscribers that a port stopped forwarding.
+ *
+ * Called with the control lock held, before anything else is done
+ * about the link change, so the subscribers can steer traffic away
+ * from the port as early as possible.
+ */
+static void
+bcmlm_failover_link_down(int unit, shr_port_t port, sal_usecs_t start)
+{
+    bcmlm_ctrl_t *lmctrl = bcmlm_ctrl[unit];
+    bcmlm_failover_stats_t *stats = &lmctrl->ff_stats;
+    uint64_t ev_data;
+    uint32_t usecs;
+    int rv;
+
+    ev_data = BCMLM_FAILOVER_EV_DATA(port, ++lmctrl->ff_seq);
+    rv = bcmevm_publish_event_id_notify(unit, lmctrl->ff_down_ev, ev_data);
+    if (SHR_FAILURE(rv)) {
+        stats->errors++;
+        LOG_WARN(BSL_LOG_MODULE,
+                 (BSL_META_UP(unit, port,
+                              "port %d: fast failover notify failed (%d)\n"),
+                  port, rv));
+        return;
+    }
+    BCMDRD_PBMP_PORT_ADD(lmctrl->pbm_ff_down, port);
+
+    usecs = sal_time_usecs() - start;
+    stats->count++;
+    stats->last_usecs = usecs;
+    stats->total_usecs += usecs;
+    if (usecs > stats->max_usecs) {
+        stats->max_usecs = usecs;
+    }
+}
+
+/*
+ * Notify fast failover subscribers that a port is forwarding again.
+ *
+ * Restoring a port is not time critical, so the event is handed to the
+ * event thread. It is only delivered synchronously if it cannot be
+ * queued, as the subscribers would otherwise never restore the port.
+ */
+static void
+bcmlm_failover_link_up(int unit, shr_port_t port)
+{
+    bcmlm_ctrl_t *lmctrl = bcmlm_ctrl[unit];
+    uint64_t ev_data;
+    int rv;
+
+    ev_data = BCMLM_FAILOVER_EV_DATA(port, ++lmctrl->ff_seq);
+    rv = bcmevm_publish_event_post(unit, lmctrl->ff_up_ev, ev_data);
+    if (SHR_FAILURE(rv)) {
+        rv = bcmevm_publish_event_id_notify(unit, lmctrl->ff_up_ev, ev_data);
+    }
+    if (SHR_FAILURE(rv)) {
+        lmctrl->ff_stats.errors++;
+        LOG_WARN(BSL_LOG_MODULE,
+                 (BSL_META_UP(unit, port,
+                              "port %d: fast failover notify failed (%d)\n"),
+                  port, rv));
+        return;
+    }
+    BCMDRD_PBMP_PORT_REMOVE(lmctrl->pbm_ff_down, port);
+}
+
 static int
 bcmlm_link_update(int unit, shr_port_t port)
 {
@@ -203,6 +290,7 @@ bcmlm_link_update(int unit, shr_port_t port)
     int cur_link, new_link, cur_fault, new_fault;
     int lc_locked = 0;
     int logical_link, fault_chk;
+    sal_usecs_t start = 0;
 
     SHR_FUNC_ENTER(unit);
 
@@ -212,6 +300,10 @@ bcmlm_link_update(int unit, shr_port_t port)
         SHR_RETURN_VAL_EXIT(SHR_E_NONE);
     }
 
+    if (lmctrl->ff_enable) {
+        start = sal_time_usecs();
+    }
+
     LC_LOCK(unit);
     lc_locked = 1;
 
@@ -255,6 +347,13 @@ bcmlm_link_update(int unit, shr_port_t port)
         SHR_RETURN_VAL_EXIT(SHR_E_NONE);
     }
 
+    if (lmctrl->ff_enable && cur_link && !cur_fault && !logical_link) {
+        bcmlm_failover_link_down(unit, port, start);
+    } else if (logical_link &&
+               BCMDRD_PBMP_MEMBER(lmctrl->pbm_ff_down, port)) {
+        bcmlm_failover_link_up(unit, port);
+    }
+
     if (!new_link) {
         BCMDRD_PBMP_PORT_REMOVE(lmctrl->pbm_link_up, port);
         BCMDRD_PBMP_PORT_REMOVE(lmctrl->pbm_fault, port);
@@ -877,6 +976,82 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+int
+bcmlm_failover_enable(int unit, bool enable)
+{
+    bcmlm_ctrl_t *lmctrl;
+    uint32_t down_ev, up_ev;
+
+    SHR_FUNC_ENTER(unit);
+
+    if (unit < 0 || unit >= BCMLM_DEV_NUM_MAX) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNIT);
+    }
+    lmctrl = bcmlm_ctrl[unit];
+    SHR_NULL_CHECK(lmctrl, SHR_E_INIT);
+
+    if (enable) {
+        SHR_IF_ERR_EXIT
+            (bcmevm_event_id_get(unit, BCMLM_EV_LINK_DOWN_FAST, &down_ev));
+        SHR_IF_ERR_EXIT
+            (bcmevm_event_id_get(unit, BCMLM_EV_LINK_UP_FAST, &up_ev));
+    }
+
+    LC_LOCK(unit);
+    if (enable) {
+        lmctrl->ff_down_ev = down_ev;
+        lmctrl->ff_up_ev = up_ev;
+    }
+    lmctrl->ff_enable = enable ? 1 : 0;
+    LC_UNLOCK(unit);
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmlm_failover_stats_get(int unit, bcmlm_failover_stats_t *stats)
+{
+    bcmlm_ctrl_t *lmctrl;
+
+    SHR_FUNC_ENTER(unit);
+
+    if (unit < 0 || unit >= BCMLM_DEV_NUM_MAX) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNIT);
+    }
+    SHR_NULL_CHECK(stats, SHR_E_PARAM);
+    lmctrl = bcmlm_ctrl[unit];
+    SHR_NULL_CHECK(lmctrl, SHR_E_INIT);
+
+    LC_LOCK(unit);
+    *stats = lmctrl->ff_stats;
+    LC_UNLOCK(unit);
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmlm_failover_stats_clear(int unit)
+{
+    bcmlm_ctrl_t *lmctrl;
+
+    SHR_FUNC_ENTER(unit);
+
+    if (unit < 0 || unit >= BCMLM_DEV_NUM_MAX) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNIT);
+    }
+    lmctrl = bcmlm_ctrl[unit];
+    SHR_NULL_CHECK(lmctrl, SHR_E_INIT);
+
+    LC_LOCK(unit);
+    sal_memset(&lmctrl->ff_stats, 0, sizeof(lmctrl->ff_stats));
+    LC_UNLOCK(unit);
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
 int
 bcmlm_port_event_register(int unit)
 {
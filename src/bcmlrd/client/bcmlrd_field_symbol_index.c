@@ -0,0 +1,212 @@
+/*! \file bcmlrd_field_symbol_index.c
+ *
+ * Per-unit perfect hash index of enum field symbols.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <shr/shr_error.h>
+#include <shr/shr_mph.h>
+#include <bcmltd/bcmltd_table.h>
+#include <bcmlrd/bcmlrd_internal.h>
+
+/*******************************************************************************
+ * Local definitions
+ */
+
+/*
+ * Symbol index of each unit. Symbols are qualified by their symbol array,
+ * so fields sharing an enum type share index entries.
+ */
+static shr_mph_t *sym_index[BCMDRD_CONFIG_MAX_UNITS];
+
+/*******************************************************************************
+ * Private functions
+ */
+
+/*
+ * Visit all enum fields of a unit configuration. Returns the number of
+ * symbols and fills in keys if not NULL.
+ */
+static uint32_t
+sym_index_keys_get(const bcmlrd_map_conf_rep_t *conf, shr_mph_key_t *keys)
+{
+    const bcmlrd_map_t *map;
+    const bcmlrd_field_data_t *field;
+    uint32_t sid, fid, idx;
+    uint32_t num_keys = 0;
+
+    for (sid = 0; sid < BCMLRD_TABLE_COUNT; sid++) {
+        map = conf->map[sid];
+        if (map == NULL || map->field_data == NULL) {
+            continue;
+        }
+        for (fid = 0; fid < map->field_data->fields; fid++) {
+            field = &map->field_data->field[fid];
+            if (!(field->flags & BCMLRD_FIELD_F_ENUM) || !field->sym) {
+                continue;
+            }
+            for (idx = 0; idx < field->num_sym; idx++) {
+                if (keys) {
+                    keys[num_keys].salt = (uint64_t)(uintptr_t)field->sym;
+                    keys[num_keys].str = field->sym[idx].name;
+                    keys[num_keys].val = idx;
+                }
+                num_keys++;
+            }
+        }
+    }
+    return num_keys;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+bcmlrd_field_symbol_index_create(int unit)
+{
+    const bcmlrd_map_conf_rep_t *conf;
+    shr_mph_key_t *keys;
+    uint32_t num_keys;
+    int rv;
+
+    conf = bcmlrd_unit_conf_get(unit);
+    if (conf == NULL) {
+        return SHR_E_UNAVAIL;
+    }
+
+    bcmlrd_field_symbol_index_destroy(unit);
+
+    num_keys = sym_index_keys_get(conf, NULL);
+    if (num_keys == 0) {
+        return SHR_E_NONE;
+    }
+    keys = sal_alloc(sizeof(*keys) * num_keys, "bcmlrdSymIdx");
+    if (keys == NULL) {
+        return SHR_E_MEMORY;
+    }
+    (void)sym_index_keys_get(conf, keys);
+    rv = shr_mph_create(keys, num_keys, &sym_index[unit]);
+    sal_free(keys);
+
+    return rv;
+}
+
+void
+bcmlrd_field_symbol_index_destroy(int unit)
+{
+    shr_mph_destroy(sym_index[unit]);
+    sym_index[unit] = NULL;
+}
+
+int
+bcmlrd_field_symbol_index_lookup(int unit,
+                                 const bcmlrd_field_data_t *field,
+                                 const char *sym,
+                                 uint32_t *val)
+{
+    uint32_t idx;
+    int rv;
+
+    if (sym_index[unit] == NULL) {
+        return SHR_E_UNAVAIL;
+    }
+    rv = shr_mph_lookup(sym_index[unit], (uint64_t)(uintptr_t)field->sym,
+                        sym, &idx);
+    if (SHR_FAILURE(rv)) {
+        return SHR_E_UNAVAIL;
+    }
+    if (idx >= field->num_sym || sal_strcmp(field->sym[idx].name, sym)) {
+        return SHR_E_NOT_FOUND;
+    }
+    *val = field->sym[idx].val;
+    return SHR_E_NONE;
+}
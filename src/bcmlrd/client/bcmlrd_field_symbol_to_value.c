@@ -92,6 +92,7 @@
 #include <sal/sal_libc.h>
 #include <shr/shr_error.h>
 #include <bcmlrd/bcmlrd_client.h>
+#include <bcmlrd/bcmlrd_internal.h>
 
 int
 bcmlrd_field_symbol_to_value(int unit,
@@ -131,6 +132,12 @@ bcmlrd_field_symbol_to_value(int unit,
             break;
         }
 
+        rv = bcmlrd_field_symbol_index_lookup(unit, field, sym, val);
+        if (rv != SHR_E_UNAVAIL) {
+            break;
+        }
+
+        /* No symbol index, fall back to a linear search */
         for (i=0; i < field->num_sym; i++) {
             if (!sal_strcmp(field->sym[i].name, sym)) {
                 *val = field->sym[i].val;
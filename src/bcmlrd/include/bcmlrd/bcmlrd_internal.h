@@ -242,6 +242,51 @@ bcmlrd_unit_conf_prepare(int unit,
 extern void
 bcmlrd_unit_conf_cleanup(void);
 
+/*!
+ * \brief Create the enum symbol index of a unit.
+ *
+ * Build a perfect hash index of all enum symbols of the unit
+ * configuration. The index allows symbol to value conversion with a
+ * single string compare.
+ *
+ * \param [in]  unit            Unit number.
+ *
+ * \retval SHR_E_NONE           No error.
+ * \retval SHR_E_UNAVAIL        Unit has no configuration.
+ * \retval SHR_E_MEMORY         Insufficient memory.
+ */
+
+extern int
+bcmlrd_field_symbol_index_create(int unit);
+
+/*!
+ * \brief Destroy the enum symbol index of a unit.
+ *
+ * \param [in]  unit            Unit number.
+ */
+
+extern void
+bcmlrd_field_symbol_index_destroy(int unit);
+
+/*!
+ * \brief Look up an enum symbol value in the unit symbol index.
+ *
+ * \param [in]  unit            Unit number.
+ * \param [in]  field           Enum field data.
+ * \param [in]  sym             Symbol name.
+ * \param [out] val             Symbol value.
+ *
+ * \retval SHR_E_NONE           Symbol found.
+ * \retval SHR_E_NOT_FOUND      Symbol is not valid for this field.
+ * \retval SHR_E_UNAVAIL        Unit has no symbol index.
+ */
+
+extern int
+bcmlrd_field_symbol_index_lookup(int unit,
+                                 const bcmlrd_field_data_t *field,
+                                 const char *sym,
+                                 uint32_t *val);
+
 /*!
  * \brief Field data type.
  */
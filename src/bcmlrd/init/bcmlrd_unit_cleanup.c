@@ -91,11 +91,18 @@
 
 #include <sal/sal_libc.h>
 #include <shr/shr_error.h>
+#include <bcmltd/bcmltd_table.h>
 #include <bcmlrd/bcmlrd_internal.h>
 
 int
 bcmlrd_unit_cleanup(void)
 {
+    int unit;
+
+    for (unit = 0; unit < BCMDRD_CONFIG_MAX_UNITS; unit++) {
+        bcmlrd_field_symbol_index_destroy(unit);
+    }
+    bcmltd_table_name_index_destroy();
     sal_memset(bcmlrd_unit_conf, 0, sizeof(bcmlrd_unit_conf));
     bcmlrd_unit_conf_cleanup();
 
@@ -92,6 +92,7 @@
 #include <sal/sal_libc.h>
 #include <shr/shr_error.h>
 #include <bcmdrd/bcmdrd_dev.h>
+#include <bcmltd/bcmltd_table.h>
 #include <bcmlrd/bcmlrd_internal.h>
 
 /* Default LRD device configuration. */
@@ -153,6 +154,12 @@ bcmlrd_unit_init(void)
             break;
         }
 
+        /* Name indexes are an optimization, so failure is not fatal */
+        (void)bcmlrd_field_symbol_index_create(unit);
+    }
+
+    if (SHR_SUCCESS(rv)) {
+        (void)bcmltd_table_name_index_create();
     }
 
     return rv;
@@ -636,6 +636,59 @@ extern int bcmlt_entry_field_array_symbol_get(bcmlt_entry_handle_t entry_hdl,
 extern int bcmlt_entry_field_remove(bcmlt_entry_handle_t entry_hdl,
                                     const char *field_name);
 
+/*!
+ * \brief Add a field to an entry by field ID.
+ *
+ * This function is the field ID equivalent of \ref bcmlt_entry_field_add().
+ * The entry must belong to a logical table.
+ *
+ * \param [in] entry_hdl Handle to the entry for adding the field.
+ * \param [in] fid Field ID obtained via \ref bcmlt_field_id_get().
+ * \param [in] data 64-bit value of the field to be added.
+ *
+ * \return SHR_E_NONE success.
+ * \return SHR_E_PARAM Invalid entry, entry in the wrong state or the
+ * field is not a scalar.
+ * \return SHR_E_NOT_FOUND Invalid field ID.
+ * \return SHR_E_MEMORY Insufficient memory.
+ */
+extern int bcmlt_entry_field_add_by_id(bcmlt_entry_handle_t entry_hdl,
+                                       uint32_t fid,
+                                       uint64_t data);
+
+/*!
+ * \brief Get the field value from an entry by field ID.
+ *
+ * This function is the field ID equivalent of \ref bcmlt_entry_field_get().
+ *
+ * \param [in] entry_hdl Handle to the entry for getting the field.
+ * \param [in] fid Field ID obtained via \ref bcmlt_field_id_get().
+ * \param [out] data Up to 64-bit value of the field to get.
+ *
+ * \return SHR_E_NONE on success.
+ * \return SHR_E_NOT_FOUND Field was not found in the entry.
+ * \return SHR_E_PARAM Wrong entry handle or data is NULL.
+ */
+extern int bcmlt_entry_field_get_by_id(bcmlt_entry_handle_t entry_hdl,
+                                       uint32_t fid,
+                                       uint64_t *data);
+
+/*!
+ * \brief Remove a field from the entry container by field ID.
+ *
+ * This function is the field ID equivalent of
+ * \ref bcmlt_entry_field_remove().
+ *
+ * \param [in] entry_hdl Handle to the entry for removing the field.
+ * \param [in] fid Field ID obtained via \ref bcmlt_field_id_get().
+ *
+ * \return SHR_E_NONE success.
+ * \return SHR_E_NOT_FOUND Field was not found in the entry.
+ * \return SHR_E_PARAM Wrong entry handle.
+ */
+extern int bcmlt_entry_field_remove_by_id(bcmlt_entry_handle_t entry_hdl,
+                                          uint32_t fid);
+
 /*!
  * \brief Retrieves all valid symbol names for a field.
  *
@@ -768,6 +821,29 @@ extern int bcmlt_entry_info_get(bcmlt_entry_handle_t entry_hdl,
 extern int bcmlt_entry_allocate(int unit, const char *table_name,
                                 bcmlt_entry_handle_t *entry_hdl);
 
+/*!
+ * \brief Allocate new table entry by table ID.
+ *
+ * This function is the table ID equivalent of \ref bcmlt_entry_allocate().
+ * Entries allocated this way can use both the name based and the ID based
+ * field APIs.
+ *
+ * \param [in] unit The device number for which the entry is associated.
+ * \param [in] tid Logical table ID obtained via \ref bcmlt_table_id_get().
+ * \param [out] entry_hdl Pointer to return value of the allocated entry
+ * handle.
+ *
+ * \return SHR_E_NONE success, otherwise failure in allocating the new entry.
+ * Failure error codes:
+ * SHR_E_INIT - The API layer has not initialized yet.
+ * SHR_E_UNIT - The unit has not initialized yet.
+ * SHR_E_PARAM - Null of entry_hdl.
+ * SHR_E_NOT_FOUND - Table not found.
+ * SHR_E_MEMORY - Failed to allocate memory.
+ */
+extern int bcmlt_entry_allocate_by_id(int unit, uint32_t tid,
+                                      bcmlt_entry_handle_t *entry_hdl);
+
 /*!
  * \brief Free allocated entry.
  *
@@ -1219,6 +1295,46 @@ extern int bcmlt_table_field_defs_get(int unit,
                                       bcmlt_field_def_t *field_defs_array,
                                       uint32_t *require_array_size);
 
+/*!
+ * \brief Resolve a logical table name into its table ID.
+ *
+ * The table ID can be used with the ID based entry APIs, such as
+ * \ref bcmlt_entry_allocate_by_id(), to avoid resolving the table name
+ * on every operation. The table ID is stable for the lifetime of the unit.
+ *
+ * \param [in] unit Device number for the table of interest.
+ * \param [in] table_name Logical table name.
+ * \param [out] tid Logical table ID.
+ *
+ * \return SHR_E_NONE success.
+ * \return SHR_E_PARAM Invalid table name or NULL \c tid.
+ * \return SHR_E_UNAVAIL The table is a physical table.
+ */
+extern int bcmlt_table_id_get(int unit,
+                              const char *table_name,
+                              uint32_t *tid);
+
+/*!
+ * \brief Resolve a field name into its field ID.
+ *
+ * The field ID can be used with the ID based field APIs, such as
+ * \ref bcmlt_entry_field_add_by_id(), to avoid resolving the field name
+ * on every operation.
+ *
+ * \param [in] unit Device number for the table of interest.
+ * \param [in] tid Logical table ID obtained via \ref bcmlt_table_id_get().
+ * \param [in] field_name Field name.
+ * \param [out] fid Field ID.
+ *
+ * \return SHR_E_NONE success.
+ * \return SHR_E_NOT_FOUND Invalid table ID.
+ * \return SHR_E_PARAM Invalid field name or NULL \c fid.
+ */
+extern int bcmlt_field_id_get(int unit,
+                              uint32_t tid,
+                              const char *field_name,
+                              uint32_t *fid);
+
 /*
  * Table Notification APIs
  */
@@ -1257,6 +1373,69 @@ extern int bcmlt_table_subscribe(int unit,
  */
 extern int bcmlt_table_unsubscribe(int unit, const char *table_name);
 
+/*!
+ * \brief Create the table change feed of a unit.
+ *
+ * The table change feed is an alternative to the per-entry table
+ * notifications of \ref bcmlt_table_subscribe() for tables with high
+ * change rates. Changes of the tables that were added to the feed via
+ * \ref bcmlt_table_chg_feed_subscribe() are recorded as compact change
+ * records (table ID, opcode and key fields) in a ring. The records are
+ * delivered to the callback function in batches from a dedicated thread
+ * of the unit.
+ *
+ * If the ring overflows, new changes are dropped and the number of
+ * dropped changes is reported with the next batch.
+ *
+ * If coalescing is enabled, a change of an entry that still has an
+ * undelivered record in the ring is merged into this record.
+ *
+ * \param [in] unit The device number.
+ * \param [in] cfg Change feed configuration. Zero values of ring_size,
+ * batch_size and flush_usecs select the defaults.
+ *
+ * \return SHR_E_NONE success.
+ * \return SHR_E_PARAM Invalid configuration.
+ * \return SHR_E_EXISTS The unit already has a change feed.
+ */
+extern int bcmlt_table_chg_feed_create(int unit,
+                                       const bcmlt_table_chg_feed_cfg_t *cfg);
+
+/*!
+ * \brief Destroy the table change feed of a unit.
+ *
+ * The records that are pending in the ring are delivered before the
+ * function returns. Tables remain subscribed to the change feed of the
+ * unit, so a new change feed can be created without subscribing again.
+ *
+ * \param [in] unit The device number.
+ *
+ * \return SHR_E_NONE success.
+ * \return SHR_E_NOT_FOUND The unit has no change feed.
+ */
+extern int bcmlt_table_chg_feed_destroy(int unit);
+
+/*!
+ * \brief Add a table to the change feed of a unit.
+ *
+ * \param [in] unit The device number for the table of interest.
+ * \param [in] table_name The logical table name.
+ *
+ * \return SHR_E_NONE success, otherwise failure in subscribing the table.
+ */
+extern int bcmlt_table_chg_feed_subscribe(int unit, const char *table_name);
+
+/*!
+ * \brief Remove a table from the change feed of a unit.
+ *
+ * \param [in] unit The device number for the table of interest.
+ * \param [in] table_name The logical table name.
+ *
+ * \return SHR_E_NONE success, otherwise failure in unsubscribing the
+ * table.
+ */
+extern int bcmlt_table_chg_feed_unsubscribe(int unit, const char *table_name);
+
 /********************************************************************/
 /*        T R A N S A C T I O N S   F U N C T I O N A L I T Y       */
 /********************************************************************/
@@ -1555,6 +1734,8 @@ typedef struct bcmlt_capture_cb_s {
       * Write function to write a number of bytes (nbyte) from the buffer into
       * the file using the file descriptor fd. The function returns the number
       * of bytes that were actually written.
+      * The function is called from a background capture thread. Every call
+      * carries whole capture records of a single unit.
       */
     uint32_t (*write)(void *fd, void *buffer, uint32_t nbyte);
 } bcmlt_capture_cb_t;
@@ -1591,6 +1772,12 @@ typedef struct bcmlt_replay_cb_s {
  * a file the application should make sure to truncate older file content.
  * Note that the content of the file will be binary data.
  *
+ * The commit path only serializes the operations into a per-unit memory
+ * ring in a compact versioned record format. A background thread drains
+ * the ring into the application write function. Commits only wait for
+ * the capture when the ring is full because the application IO cannot
+ * keep up.
+ *
  * \param [in] unit The unit number of the device for which to start
  * capturing.
  * \param [in] app_cb A data structure that provides the IO
@@ -1686,6 +1873,69 @@ extern int bcmlt_capture_replay(bool timing,
                                 bool view_only,
                                 bcmlt_replay_cb_t *app_cb);
 
+/*!
+ * \brief Replay performance statistics.
+ *
+ * Latencies are measured per replayed operation (entry or transaction)
+ * from the request to the transaction manager until its completion.
+ */
+typedef struct bcmlt_replay_stats_s {
+    /*! Number of replayed operations. */
+    uint32_t num_ops;
+
+    /*! Number of replayed entries, including transaction entries. */
+    uint32_t num_entries;
+
+    /*! Number of operations which failed. */
+    uint32_t num_failed;
+
+    /*! Duration of the replay in usecs. */
+    uint64_t elapsed_usecs;
+
+    /*! Replay throughput in operations per second. */
+    uint32_t ops_per_sec;
+
+    /*! Minimum operation latency in usecs. */
+    uint32_t lat_min;
+
+    /*! Average operation latency in usecs. */
+    uint32_t lat_avg;
+
+    /*! Median operation latency in usecs. */
+    uint32_t lat_p50;
+
+    /*! 90th percentile operation latency in usecs. */
+    uint32_t lat_p90;
+
+    /*! 99th percentile operation latency in usecs. */
+    uint32_t lat_p99;
+
+    /*! Maximum operation latency in usecs. */
+    uint32_t lat_max;
+} bcmlt_replay_stats_t;
+
+/*!
+ * \brief Play back captured operations at the maximal rate.
+ *
+ * This function submits the captured operations back to back, ignoring
+ * the original timing, and reports the replay throughput and latency
+ * percentiles. This turns a captured workload into a repeatable
+ * benchmark. Unlike \ref bcmlt_capture_replay(), operations which fail
+ * are counted in \c stats and do not stop the replay.
+ *
+ * \param [in] cb Optional callback function to be called for every entry or
+ * transaction after it was executed. See \ref replay_action_f.
+ * \param [in] app_cb The application IO to read the captured data.
+ * \param [out] stats Replay statistics.
+ *
+ * \return SHR_E_NONE success, error code otherwise. Potential error codes:
+ * SHR_E_PARAM - Invalid parameter.
+ * SHR_E_MEMORY - Not enough memory to record the latencies.
+ */
+extern int bcmlt_capture_replay_max_rate(replay_action_f *cb,
+                                         bcmlt_replay_cb_t *app_cb,
+                                         bcmlt_replay_stats_t *stats);
+
 /*!
  * \brief Retrieve physical table names associated with a given LT.
  *
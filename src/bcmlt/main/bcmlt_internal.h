@@ -322,6 +322,47 @@ extern int bcmlt_db_field_info_get(int unit,
                                    bcmlt_field_def_t **f_attr,
                                    uint32_t *field_id);
 
+/*!
+ * \brief Obtain specific LT attributes by table ID.
+ *
+ * This function is the table ID equivalent of
+ * \ref bcmlt_db_table_info_get(). Only logical tables can be found by ID.
+ *
+ * \param [in] unit Is the device unit.
+ * \param [in] table_id Is the logical table ID.
+ * \param [out] attrib Is a double pointer pointing to returned attributes.
+ * \param [out] fld_array_hdl Is the memory handle to use for field array
+ * allocation.
+ * \param [out] hdl Is a double pointer pointing to returned context.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+extern int bcmlt_db_table_info_get_by_id(int unit,
+                                         uint32_t table_id,
+                                         bcmlt_table_attrib_t **attrib,
+                                         shr_lmm_hdl_t *fld_array_hdl,
+                                         void **hdl);
+
+/*!
+ * \brief Obtain specific field attributes by field ID.
+ *
+ * This function is the field ID equivalent of
+ * \ref bcmlt_db_field_info_get(). Only logical table fields can be found
+ * by ID.
+ *
+ * \param [in] unit Is the device unit.
+ * \param [in] hdl Is the table database handle.
+ * \param [in] field_id Is the field ID.
+ * \param [out] f_attr Is a double pointer pointing to returned field
+ *              attributes.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+extern int bcmlt_db_field_info_get_by_id(int unit,
+                                         void *hdl,
+                                         uint32_t field_id,
+                                         bcmlt_field_def_t **f_attr);
+
 /*!
  * \brief Start table enumeration
  *
@@ -126,6 +126,8 @@ typedef struct table_start_s {
     bcmlt_table_attrib_t attrib;
     shr_hash_str_hdl field_db;
     field_struct_t *fields;
+    /* LT fields indexed by field ID (NULL for PT) */
+    field_struct_t **fid_map;
     struct table_start_s *next;
 } table_start_t;
 
@@ -134,6 +136,9 @@ typedef struct device_tables_db_s {
     shr_hash_str_hdl table_db;
     sal_rwlock_t  rwlock;
     table_start_t *tables;
+    /* LTs indexed by table ID */
+    table_start_t **lt_by_id;
+    uint32_t lt_by_id_size;
 } device_tables_db_t;
 
 typedef struct device_table_db_width_s {
@@ -194,6 +199,33 @@ static uint64_t field_tag_to_u64(bcmlt_field_data_t field_data,
     }
 }
 
+/*!
+ *\brief Build the field ID map of a LT.
+ *
+ * This function creates an array indexed by field ID that points to the
+ * field structures of the table. The array allows field lookup by ID
+ * without going through the field name hash.
+ *
+ * \param [in] table Is a pointer to the logical table DB.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+static int lt_fid_map_build(table_start_t *table)
+{
+    field_struct_t *field;
+    size_t len = sizeof(field_struct_t *) * (table->attrib.max_fid + 1);
+
+    table->fid_map = sal_alloc(len, "bcmltFidMap");
+    if (!table->fid_map) {
+        return SHR_E_MEMORY;
+    }
+    sal_memset(table->fid_map, 0, len);
+    for (field = table->fields; field; field = field->next) {
+        table->fid_map[field->field_id] = field;
+    }
+    return SHR_E_NONE;
+}
+
 /*!
  *\brief Update the local DB with a LT fields.
  *
@@ -288,6 +320,10 @@ static int obtain_lt_fields(int unit,
     }
     sal_free((void *)field_array);
 
+    if (rv == SHR_E_NONE) {
+        rv = lt_fid_map_build(table);
+    }
+
     if (table->attrib.interactive) {
         if (max_fields > table_db_interact_tbl_max_fields[unit]) {
             table_db_interact_tbl_max_fields[unit] = max_fields;
@@ -427,10 +463,54 @@ static int local_db_fields_prep(int unit,
     }
     if (0 != rv) {
         shr_hash_str_dict_free(table->field_db);
+        if (table->fid_map) {
+            sal_free(table->fid_map);
+            table->fid_map = NULL;
+        }
     }
     return rv;
 }
 
+/*!
+ *\brief Build the table ID map of all the LTs of this unit.
+ *
+ * This function creates an array indexed by LT ID that points to the
+ * table structures. It is called once all the LTs were added to the
+ * table list.
+ *
+ * \param [in] unit Is the unit of this table.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+static int lt_id_map_build(int unit)
+{
+    table_start_t *table;
+    uint32_t size = 0;
+    size_t len;
+
+    for (table = table_db[unit].tables; table; table = table->next) {
+        if (!table->attrib.pt && table->attrib.table_id >= size) {
+            size = table->attrib.table_id + 1;
+        }
+    }
+    if (size == 0) {
+        return SHR_E_NONE;
+    }
+    len = sizeof(table_start_t *) * size;
+    table_db[unit].lt_by_id = sal_alloc(len, "bcmltTblIdMap");
+    if (!table_db[unit].lt_by_id) {
+        return SHR_E_MEMORY;
+    }
+    sal_memset(table_db[unit].lt_by_id, 0, len);
+    for (table = table_db[unit].tables; table; table = table->next) {
+        if (!table->attrib.pt) {
+            table_db[unit].lt_by_id[table->attrib.table_id] = table;
+        }
+    }
+    table_db[unit].lt_by_id_size = size;
+    return SHR_E_NONE;
+}
+
 static int comp_func(const void *a, const void *b)
 {
     return (int)(*(int16_t *)a - *(int16_t *)b);
@@ -497,6 +577,7 @@ static int get_lt_table_list(int unit)
             break;
         }
         table->fields = NULL;
+        table->fid_map = NULL;
         table->attrib.pt = false;
         table->attrib.name = *tbl_name;
         table->attrib.table_id = lattrib.id;
@@ -525,6 +606,10 @@ static int get_lt_table_list(int unit)
         table_db[unit].tables = table;
     }
 
+    if (rv == SHR_E_NONE) {
+        rv = lt_id_map_build(unit);
+    }
+
     if (rv == SHR_E_NONE) {
         /* Sort the table width so we can find the median value. */
         sal_qsort(tables_width, num_of_tables, sizeof(uint16_t), comp_func);
@@ -616,6 +701,7 @@ static int get_pt_table_list(int unit)
             break;
         }
         table->fields = NULL;
+        table->fid_map = NULL;
         table->attrib.pt = true;
         table->attrib.name = info.name;
         table->attrib.table_id = *table_id;
@@ -711,6 +797,7 @@ static int search_for_dynamic_tbl(int unit,
             break;
         }
         table->fields = NULL;
+        table->fid_map = NULL;
         table->attrib.pt = false;
         table->attrib.num_of_fields = lattrib.number_of_fields;
         table->attrib.name = table_name;
@@ -726,6 +813,9 @@ static int search_for_dynamic_tbl(int unit,
         /* Add the table to the table list */
         table->next = table_db[unit].tables;
         table_db[unit].tables = table;
+        if (table->attrib.table_id < table_db[unit].lt_by_id_size) {
+            table_db[unit].lt_by_id[table->attrib.table_id] = table;
+        }
     } while (0);
 
     sal_rwlock_give(table_db[unit].rwlock);
@@ -773,6 +863,36 @@ static int table_fields_retrieve(int unit, table_start_t *table)
     return rv;
 }
 
+/*!
+ *\brief Select the field array memory handle of a table.
+ *
+ * \param [in] unit Is the unit of this table.
+ * \param [in] table Is the table to select the field array memory for.
+ * \param [out] fld_array_hdl Is the memory handle of the field array or 0
+ * if the table doesn't use field array.
+ *
+ * \return None.
+ */
+static void table_fld_array_hdl_get(int unit,
+                                    table_start_t *table,
+                                    shr_lmm_hdl_t *fld_array_hdl)
+{
+    if (table->attrib.pt) {  /* PT field IDs are not consequtive */
+        *fld_array_hdl = 0;  /* So don't bother to allocate array. */
+    } else {
+        if (table->attrib.max_fid + 1 <= table_db_width[unit].mid_size) {
+            *fld_array_hdl = table_db_width[unit].mid_size_hdl;
+        } else if (table->attrib.max_fid + 1 <=
+                   table_db_width[unit].max_size){
+            *fld_array_hdl = table_db_width[unit].max_size_hdl;
+        } else {
+            LOG_ERROR(BSL_LOG_MODULE,
+                      (BSL_META("Unsuported table width %d\n"),
+                       table->attrib.num_of_fields));
+        }
+    }
+}
+
 /*!
  *\brief Search for the next table that matches the desired attributes.
  *
@@ -824,6 +944,8 @@ int bcmlt_db_init()
     if (rv != SHR_E_NONE) {
         return SHR_E_MEMORY;
     }
+    /* The thread cache is an optimization, so failure is not fatal */
+    (void)shr_lmm_cache_enable(field_elements, 0, 0);
 
     /* Init the table element pool */
     LMEM_MGR_INIT(table_start_t,
@@ -834,6 +956,7 @@ int bcmlt_db_init()
     if (rv != SHR_E_NONE) {
         return SHR_E_MEMORY;
     }
+    (void)shr_lmm_cache_enable(table_elements, 0, 0);
     return SHR_E_NONE;
 }
 
@@ -871,6 +994,8 @@ int bcmlt_tables_db_init (int unit)
     }
     table_db[unit].unit = unit;
     table_db[unit].tables = NULL;
+    table_db[unit].lt_by_id = NULL;
+    table_db[unit].lt_by_id_size = 0;
 
     return table_db_update(unit);
 }
@@ -896,6 +1021,9 @@ int bcmlt_tables_db_delete (int unit)
         }
         /* Release the field DB */
         shr_hash_str_dict_free(table->field_db);
+        if (table->fid_map) {
+            sal_free(table->fid_map);
+        }
         /* Free the table element to the free list */
         shr_lmm_free (table_elements, table);
     }
@@ -912,6 +1040,12 @@ int bcmlt_tables_db_delete (int unit)
         table_db_width[unit].mid_size_hdl = 0;
     }
 
+    if (table_db[unit].lt_by_id) {
+        sal_free(table_db[unit].lt_by_id);
+        table_db[unit].lt_by_id = NULL;
+        table_db[unit].lt_by_id_size = 0;
+    }
+
     sal_rwlock_destroy(table_db[unit].rwlock);
     table_db[unit].rwlock = NULL;
     shr_hash_str_dict_free(table_db[unit].table_db);
@@ -959,23 +1093,48 @@ int bcmlt_db_table_info_get(int unit,
     }
 
     if (rv == 0 && fld_array_hdl) {
-        if (table->attrib.pt) {  /* PT field IDs are not consequtive */
-            *fld_array_hdl = 0;  /* So don't bother to allocate array. */
-        } else {
-            if (table->attrib.max_fid + 1 <= table_db_width[unit].mid_size) {
-                *fld_array_hdl = table_db_width[unit].mid_size_hdl;
-            } else if (table->attrib.max_fid + 1 <=
-                       table_db_width[unit].max_size){
-                *fld_array_hdl = table_db_width[unit].max_size_hdl;
-            } else {
-                LOG_ERROR(BSL_LOG_MODULE,
-                          (BSL_META("Unsuported table width %d\n"),
-                           table->attrib.num_of_fields));
+        table_fld_array_hdl_get(unit, table, fld_array_hdl);
+    }
+
+    return rv;
+}
+
+int bcmlt_db_table_info_get_by_id(int unit,
+                                  uint32_t table_id,
+                                  bcmlt_table_attrib_t **attrib,
+                                  shr_lmm_hdl_t *fld_array_hdl,
+                                  void **hdl)
+{
+    table_start_t *table = NULL;
+
+    if (!table_db[unit].rwlock) {
+        return SHR_E_INIT;
+    }
+    sal_rwlock_rlock(table_db[unit].rwlock, SAL_RWLOCK_FOREVER);
+    if (table_id < table_db[unit].lt_by_id_size) {
+        table = table_db[unit].lt_by_id[table_id];
+    } else {
+        /* Dynamic tables beyond the map are only on the table list */
+        for (table = table_db[unit].tables; table; table = table->next) {
+            if (!table->attrib.pt && table->attrib.table_id == table_id) {
+                break;
             }
         }
     }
+    sal_rwlock_give(table_db[unit].rwlock);
+    if (!table) {
+        LOG_VERBOSE(BSL_LOG_MODULE,
+                    (BSL_META_U(unit, "Can't find table ID %u\n"),
+                     table_id));
+        return SHR_E_NOT_FOUND;
+    }
 
-    return rv;
+    *attrib = &table->attrib;
+    *hdl = (void *)table;
+    if (fld_array_hdl) {
+        table_fld_array_hdl_get(unit, table, fld_array_hdl);
+    }
+    return SHR_E_NONE;
 }
 
 
@@ -1060,6 +1219,42 @@ int bcmlt_db_field_info_get(int unit,
     return rv;
 }
 
+int bcmlt_db_field_info_get_by_id(int unit,
+                                  void *hdl,
+                                  uint32_t field_id,
+                                  bcmlt_field_def_t **f_attr)
+{
+    int rv;
+    table_start_t *table = (table_start_t *)hdl;
+    field_struct_t *field = NULL;
+
+    if (table == NULL) {
+        return SHR_E_INTERNAL;
+    }
+    if (!table_db[unit].rwlock) {
+        return SHR_E_UNIT;
+    }
+    if (table->fields == NULL) {
+        rv = table_fields_retrieve(unit, table);
+        if (rv != 0) {
+            return SHR_E_PARAM;
+        }
+    }
+    if (table->fid_map && field_id <= table->attrib.max_fid) {
+        field = table->fid_map[field_id];
+    }
+    if (!field) {
+        LOG_VERBOSE(BSL_LOG_MODULE,
+                    (BSL_META_U(unit, "field ID %u is not part of table %s\n"),
+                     field_id, table->attrib.name));
+        return SHR_E_NOT_FOUND;
+    }
+    if (f_attr) {
+        *f_attr = &field->field_def;
+    }
+    return SHR_E_NONE;
+}
+
 int bcmlt_db_table_name_get_first(int unit, uint32_t flags, char **name)
 {
     int rv;
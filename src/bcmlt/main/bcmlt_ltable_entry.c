@@ -105,6 +105,55 @@
  */
 #define BSL_LOG_MODULE BSL_LS_BCMLT_ENTRY
 
+/*******************************************************************************
+ * Private functions
+ */
+/*!
+ *\brief Allocates an entry for a table.
+ *
+ * This function allocates a new entry for a table that was already
+ * resolved in the table DB and returns its handle.
+ *
+ * \param [in] unit Is the unit of the table.
+ * \param [in] table_attr Is the table attributes.
+ * \param [in] fld_array_hdl Is the field array memory handle (can be 0).
+ * \param [in] hdl Is the table DB handle.
+ * \param [out] entry_hdl Is the allocated entry handle.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+static int entry_alloc(int unit,
+                       bcmlt_table_attrib_t *table_attr,
+                       shr_lmm_hdl_t fld_array_hdl,
+                       void *hdl,
+                       bcmlt_entry_handle_t *entry_hdl)
+{
+    bcmtrm_entry_t *entry;
+
+    SHR_FUNC_ENTER(unit);
+    entry = bcmtrm_entry_alloc(unit,
+                               table_attr->table_id,
+                               table_attr->interactive,
+                               table_attr->pt,
+                               fld_array_hdl,
+                               table_attr->name);
+    SHR_NULL_CHECK(entry, SHR_E_MEMORY);
+    entry->db_hdl = hdl;
+    /* Clean the fields array */
+    if (fld_array_hdl) {
+        sal_memset(entry->fld_arr, 0, sizeof(void *) * (table_attr->max_fid+1));
+        entry->max_fid = table_attr->max_fid;
+    } else {
+        entry->max_fid = 0;
+    }
+
+    SHR_IF_ERR_EXIT(bcmlt_hdl_alloc(entry, entry_hdl));
+
+    entry->info.entry_hdl = *entry_hdl;
+exit:
+    SHR_FUNC_EXIT();
+}
+
 /*******************************************************************************
  * Public functions
  */
@@ -164,7 +213,6 @@ int bcmlt_entry_allocate(int unit,
                          const char *table_name,
                          bcmlt_entry_handle_t *entry_hdl)
 {
-    bcmtrm_entry_t *entry;
     bcmlt_table_attrib_t *table_attr;
     void *hdl;
     shr_lmm_hdl_t fld_array_hdl;
@@ -191,25 +239,39 @@ int bcmlt_entry_allocate(int unit,
                                             &fld_array_hdl,
                                             &hdl));
 
-    entry = bcmtrm_entry_alloc(unit,
-                               table_attr->table_id,
-                               table_attr->interactive,
-                               table_attr->pt,
-                               fld_array_hdl,
-                               table_attr->name);
-    SHR_NULL_CHECK(entry, SHR_E_MEMORY);
-    entry->db_hdl = hdl;
-    /* Clean the fields array */
-    if (fld_array_hdl) {
-        sal_memset(entry->fld_arr, 0, sizeof(void *) * (table_attr->max_fid+1));
-        entry->max_fid = table_attr->max_fid;
-    } else {
-        entry->max_fid = 0;
-    }
+    SHR_IF_ERR_EXIT(entry_alloc(unit, table_attr, fld_array_hdl,
+                                hdl, entry_hdl));
+exit:
+    SHR_FUNC_EXIT();
+}
 
-    SHR_IF_ERR_EXIT(bcmlt_hdl_alloc(entry, entry_hdl));
+int bcmlt_entry_allocate_by_id(int unit,
+                               uint32_t tid,
+                               bcmlt_entry_handle_t *entry_hdl)
+{
+    bcmlt_table_attrib_t *table_attr;
+    void *hdl;
+    shr_lmm_hdl_t fld_array_hdl;
 
-    entry->info.entry_hdl = *entry_hdl;
+    SHR_FUNC_ENTER(unit);
+    if (!bcmlt_is_initialized()) {
+        LOG_VERBOSE(BSL_LOG_MODULE,
+                    (BSL_META_U(unit,
+                                "BCMLT was not initialized yet\n")));
+        SHR_RETURN_VAL_EXIT(SHR_E_INIT);
+    }
+    UNIT_VALIDATION(unit);
+    if (!entry_hdl) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    SHR_IF_ERR_VERBOSE_EXIT(bcmlt_db_table_info_get_by_id(unit,
+                                                          tid,
+                                                          &table_attr,
+                                                          &fld_array_hdl,
+                                                          &hdl));
+
+    SHR_IF_ERR_EXIT(entry_alloc(unit, table_attr, fld_array_hdl,
+                                hdl, entry_hdl));
 exit:
     SHR_FUNC_EXIT();
 }
@@ -144,6 +144,115 @@
 /*******************************************************************************
  * Private functions
  */
+/*!
+ *\brief Finds or allocates a field of the entry by field ID.
+ *
+ * This function returns the field of the entry that matches \c field_id.
+ * If the entry doesn't have such a field a new field is allocated and
+ * added to the entry.
+ *
+ * \param [in] entry is the entry to add the field into.
+ * \param [in] field_id is the ID of the field.
+ * \param [out] field is a pointer to the newly created/existed field.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+static int field_attach(bcmtrm_entry_t *entry,
+                        uint32_t field_id,
+                        shr_fmm_t **field)
+{
+    shr_fmm_t *loc_field;
+
+    SHR_FUNC_ENTER(entry->info.unit);
+
+    if (entry->fld_arr) {
+        loc_field = entry->fld_arr[field_id];
+    } else {
+        loc_field = bcmlt_find_field_in_entry(entry, field_id, NULL);
+    }
+    if (!loc_field) {
+        loc_field = shr_fmm_alloc();
+        SHR_NULL_CHECK(loc_field, SHR_E_MEMORY);
+        loc_field->id = field_id;
+        loc_field->idx = 0;
+        loc_field->flags = 0;
+        loc_field->next = entry->l_field;
+        entry->l_field = loc_field;
+        if (entry->fld_arr) {
+            entry->fld_arr[field_id] = loc_field;
+        }
+    }
+    *field = loc_field;
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/*!
+ *\brief Removes a field from the entry by field ID.
+ *
+ * \param [in] entry is the entry to remove the field from.
+ * \param [in] field_id is the ID of the field to remove.
+ *
+ * \return SHR_E_NONE on success and SHR_E_NOT_FOUND if the entry doesn't
+ * contain the field.
+ */
+static int field_detach(bcmtrm_entry_t *entry, uint32_t field_id)
+{
+    shr_fmm_t *p_field;
+    shr_fmm_t *p_field_tmp;
+
+    if (entry->fld_arr) {
+        entry->fld_arr[field_id] = NULL;    /* Clean up the field array */
+    }
+
+    p_field = entry->l_field;
+    if (!p_field) {
+        return SHR_E_NOT_FOUND;
+    }
+    /* If the field is the first in the list */
+    if (p_field->id == field_id) {
+        entry->l_field = p_field->next;
+        shr_fmm_free(p_field);
+        return SHR_E_NONE;
+    }
+    /* Search the rest of the field list */
+    for (; p_field->next && (p_field->next->id != field_id);
+         p_field = p_field->next);
+    if (!p_field->next) {
+        return SHR_E_NOT_FOUND;
+    }
+    p_field_tmp = p_field->next;
+    p_field->next = p_field_tmp->next; /* Remove the field from the list */
+    shr_fmm_free(p_field_tmp);
+    return SHR_E_NONE;
+}
+
+/*!
+ *\brief Validates a field ID against the entry table.
+ *
+ * \param [in] entry is the entry of the field.
+ * \param [in] field_id is the field ID to validate.
+ * \param [out] attr is the field attributes (can be NULL).
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+static int field_id_validate(bcmtrm_entry_t *entry,
+                             uint32_t field_id,
+                             bcmlt_field_def_t **attr)
+{
+    /* Do not allow ID access for notification or PT entries */
+    if (!entry->db_hdl || entry->pt) {
+        return SHR_E_UNAVAIL;
+    }
+    if (entry->fld_arr && field_id > entry->max_fid) {
+        return SHR_E_NOT_FOUND;
+    }
+    return bcmlt_db_field_info_get_by_id(entry->info.unit,
+                                         entry->db_hdl,
+                                         field_id,
+                                         attr);
+}
+
 /*!
  *\brief Allocates new field and adds it to the entry.
  *
@@ -162,7 +271,6 @@ static int alloc_new_field(bcmtrm_entry_t *entry,
                            bool sym,
                            shr_fmm_t **field)
 {
-    shr_fmm_t *loc_field;
     uint32_t field_id;
     bcmlt_field_def_t *attr;
 
@@ -187,24 +295,7 @@ static int alloc_new_field(bcmtrm_entry_t *entry,
                      field_name));
         SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
     }
-    if (entry->fld_arr) {
-        loc_field = entry->fld_arr[field_id];
-    } else {
-        loc_field = bcmlt_find_field_in_entry(entry, field_id, NULL);
-    }
-    if (!loc_field) {
-        loc_field = shr_fmm_alloc();
-        SHR_NULL_CHECK(loc_field, SHR_E_MEMORY);
-        loc_field->id = field_id;
-        loc_field->idx = 0;
-        loc_field->flags = 0;
-        loc_field->next = entry->l_field;
-        entry->l_field = loc_field;
-        if (entry->fld_arr) {
-            entry->fld_arr[field_id] = loc_field;
-        }
-    }
-    *field = loc_field;
+    SHR_IF_ERR_EXIT(field_attach(entry, field_id, field));
 exit:
     SHR_FUNC_EXIT();
 }
@@ -531,8 +622,6 @@ exit:
 int bcmlt_entry_field_remove(bcmlt_entry_handle_t entry_hdl,
                              const char *field_name)
 {
-    shr_fmm_t *p_field;
-    shr_fmm_t *p_field_tmp;
     int rv;
     uint32_t field_id;
     bcmtrm_entry_t *entry = bcmlt_hdl_data_get(entry_hdl);
@@ -552,28 +641,68 @@ int bcmlt_entry_field_remove(bcmlt_entry_handle_t entry_hdl,
         SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
     }
 
-    if (entry->fld_arr) {
-        entry->fld_arr[field_id] = NULL;    /* Clean up the field array */
+    SHR_RETURN_VAL_EXIT(field_detach(entry, field_id));
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int bcmlt_entry_field_add_by_id(bcmlt_entry_handle_t entry_hdl,
+                                uint32_t fid,
+                                uint64_t data)
+{
+    shr_fmm_t *field;
+    bcmlt_field_def_t *attr;
+    bcmtrm_entry_t *entry = bcmlt_hdl_data_get(entry_hdl);
+
+    SHR_FUNC_ENTER(entry ? entry->info.unit : BSL_UNIT_UNKNOWN);
+    ENTRY_VALIDATE(entry);
+    SHR_IF_ERR_VERBOSE_EXIT(field_id_validate(entry, fid, &attr));
+    if (attr->symbol || (attr->depth > 0) || (attr->elements > 1)) {
+        LOG_VERBOSE(BSL_LOG_MODULE,
+                    (BSL_META_U(entry->info.unit, "Field %s is not a scalar\n"),
+                     attr->name));
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
     }
+    SHR_IF_ERR_EXIT(field_attach(entry, fid, &field));
+    field->data = data;
+exit:
+    SHR_FUNC_EXIT();
+}
 
-    p_field = entry->l_field;
-    /* If the field is the first in the list */
-    if (p_field->id == field_id) {
-        entry->l_field = p_field->next;
-        shr_fmm_free(p_field);
-        SHR_RETURN_VAL_EXIT(SHR_E_NONE);
+int bcmlt_entry_field_get_by_id(bcmlt_entry_handle_t entry_hdl,
+                                uint32_t fid,
+                                uint64_t *data)
+{
+    shr_fmm_t *field;
+    bcmtrm_entry_t *entry = bcmlt_hdl_data_get(entry_hdl);
+
+    SHR_FUNC_ENTER(entry ? entry->info.unit : BSL_UNIT_UNKNOWN);
+    if (!entry || (entry->state == E_IDLE) || !data) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
     }
-    /* Search the rest of the field list */
-    p_field_tmp = NULL;
-    for (; p_field->next && (p_field->next->id != field_id);
-         p_field = p_field->next);
-    if (!p_field->next) {
-        SHR_RETURN_VAL_EXIT(SHR_E_NOT_FOUND);
+    if (entry->fld_arr) {
+        field = (fid <= entry->max_fid) ? entry->fld_arr[fid] : NULL;
+    } else {
+        field = bcmlt_find_field_in_entry(entry, fid, NULL);
     }
-    p_field_tmp = p_field->next;
-    p_field->next = p_field_tmp->next; /* Remove the field from the list */
-    shr_fmm_free(p_field_tmp);
+    SHR_NULL_VERBOSE_CHECK(field, SHR_E_NOT_FOUND);
+    *data = field->data;
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int bcmlt_entry_field_remove_by_id(bcmlt_entry_handle_t entry_hdl,
+                                   uint32_t fid)
+{
+    bcmtrm_entry_t *entry = bcmlt_hdl_data_get(entry_hdl);
 
+    SHR_FUNC_ENTER(entry ? entry->info.unit : BSL_UNIT_UNKNOWN);
+    ENTRY_VALIDATE(entry);
+    if (entry->fld_arr && fid > entry->max_fid) {
+        SHR_RETURN_VAL_EXIT(SHR_E_NOT_FOUND);
+    }
+    SHR_RETURN_VAL_EXIT(field_detach(entry, fid));
 exit:
     SHR_FUNC_EXIT();
 }
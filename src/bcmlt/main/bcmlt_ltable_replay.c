@@ -94,8 +94,12 @@
 #include <sal/sal_alloc.h>
 #include <sal/sal_sleep.h>
 #include <sal/sal_time.h>
+#include <sal/sal_sem.h>
+#include <sal/sal_thread.h>
+#include <sal/sal_spinlock.h>
 #include <shr/shr_error.h>
 #include <shr/shr_fmm.h>
+#include <bsl/bsl.h>
 #include <bcmdrd_config.h>
 #include <bcmlt/bcmlt.h>
 #include <bcmtrm/trm_api.h>
@@ -104,56 +108,402 @@
 /*******************************************************************************
  * Local definitions
  */
+#define BSL_LOG_MODULE BSL_LS_BCMLT_TABLE
+
 #define ENTRY_TYPE    1
 #define TRANS_TYPE    2
 
-static bcmlt_capture_cb_t replay_fh[BCMDRD_CONFIG_MAX_UNITS];
+/* Capture ring size per unit (power of 2). */
+#ifndef BCMLT_CAPTURE_RING_SIZE
+#define BCMLT_CAPTURE_RING_SIZE     (1024 * 1024)
+#endif
+
+/* Writer thread polling interval. */
+#define CAPTURE_WRITER_USECS        10000
+
+/* Producer back off while the capture ring is full. */
+#define CAPTURE_RING_WAIT_USECS     100
+
+/*
+ * Capture record format.
+ *
+ * Every record starts with a fixed header followed by a type specific
+ * body. All the fields are stored in host byte order. A capture starts
+ * with a START record, which also identifies the format on replay. The
+ * format carries no pointers or in-memory SDK structures.
+ *
+ * ENTRY: cap_entry_t, table name (padded to 4 bytes), cap_field_t array.
+ * TRANS: cap_trans_t followed by the ENTRY bodies of its entries.
+ */
+#define CAP_REC_MAGIC       0x4c54
+#define CAP_REC_VERSION     1
+#define CAP_START_MAGIC     "BCMLTCAP"
+
+#define CAP_TYPE_ENTRY      ENTRY_TYPE
+#define CAP_TYPE_TRANS      TRANS_TYPE
+#define CAP_TYPE_START      3
+
+#define CAP_ALIGN4(_len)    (((uint32_t)(_len) + 3U) & ~3U)
+
+typedef struct cap_rec_hdr_s {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t type;
+    uint32_t len;          /* Record length including this header. */
+    uint32_t seq;          /* Record sequence number of the unit. */
+    uint32_t rsvd;
+    uint64_t ts;           /* Capture time in usecs. */
+} cap_rec_hdr_t;
+
+typedef struct cap_start_s {
+    char magic[8];
+    int32_t unit;
+    uint32_t rsvd;
+} cap_start_t;
+
+typedef struct cap_entry_s {
+    int32_t unit;
+    uint32_t opcode;
+    uint32_t attrib;
+    uint32_t num_fields;
+    uint16_t name_len;     /* Table name length including the NUL. */
+    uint8_t pt;
+    uint8_t priority;
+    uint8_t notif_opt;
+    uint8_t rsvd[3];
+} cap_entry_t;
+
+typedef struct cap_field_s {
+    uint32_t id;
+    uint32_t idx;
+    uint32_t flags;
+    uint32_t rsvd;
+    uint64_t data;
+} cap_field_t;
+
+typedef struct cap_trans_s {
+    int32_t unit;
+    uint32_t num_entries;
+    uint8_t type;
+    uint8_t pt_trans;
+    uint8_t priority;
+    uint8_t notif_opt;
+} cap_trans_t;
+
+/*
+ * Per-unit capture control.
+ *
+ * The commit path serializes records into the ring and never calls the
+ * application IO. A writer thread drains whole records from the ring
+ * and hands them to the application write function. The ring is not
+ * lock-free: records are variable length and come from any number of
+ * committing threads, so the producers serialize on a spinlock. The
+ * spinlock is only held while a record is copied into the ring or the
+ * ring indexes are updated. The commit path only waits for the writer
+ * when the ring is full, i.e. when the application IO cannot keep up.
+ *
+ * The producers only touch the semaphores and the ring while they hold
+ * the lock and see the capture active. Clearing \c active under the lock
+ * therefore fences all the producers before the capture is freed.
+ */
+typedef struct capture_ctrl_s {
+    bcmlt_capture_cb_t app_cb;
+    volatile bool active;
+    volatile bool running;
+    sal_spinlock_t lock;
+    uint8_t *ring;
+    uint8_t *stage;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t seq;
+    uint32_t dropped;
+    uint32_t io_errors;
+    sal_sem_t wake;
+    sal_sem_t done;
+} capture_ctrl_t;
+
+static capture_ctrl_t capture_ctrl[BCMDRD_CONFIG_MAX_UNITS];
+
+/* Replay IO with a small push back buffer for format detection. */
+typedef struct replay_io_s {
+    bcmlt_replay_cb_t *app_cb;
+    uint8_t pb[sizeof(cap_rec_hdr_t)];
+    uint32_t pb_len;
+    uint32_t pb_pos;
+} replay_io_t;
+
+/* Replay latency statistics context. */
+typedef struct replay_stats_ctx_s {
+    bcmlt_replay_stats_t *stats;
+    uint32_t *lat;
+    uint32_t lat_size;
+    uint64_t lat_sum;
+} replay_stats_ctx_t;
 
 /*******************************************************************************
  * Private functions
  */
 /*!
- *\brief Allocates new field and adds it to the entry.
+ *\brief Copy data into the capture ring.
+ *
+ * \param [in] ctrl Capture control.
+ * \param [in,out] pos Ring position, advanced by \c len.
+ * \param [in] data Data to copy.
+ * \param [in] len Number of bytes to copy.
  *
- * This function saves an entry using an application callback into the IO
- * provided via the parameter \c fd. The entry saved as the basic entry
- * structure followed by saving every field of the entry.
+ * \return None.
+ */
+static void ring_put(capture_ctrl_t *ctrl, uint32_t *pos,
+                     const void *data, uint32_t len)
+{
+    uint32_t off = *pos & (BCMLT_CAPTURE_RING_SIZE - 1);
+    uint32_t part = BCMLT_CAPTURE_RING_SIZE - off;
+
+    if (part >= len) {
+        sal_memcpy(ctrl->ring + off, data, len);
+    } else {
+        sal_memcpy(ctrl->ring + off, data, part);
+        sal_memcpy(ctrl->ring, (const uint8_t *)data + part, len - part);
+    }
+    *pos += len;
+}
+
+/*!
+ *\brief Get the capture body size of an entry.
  *
- * \param [in] fd is the IO handle to be used by the application callback.
- * \param [in] entry is the entry to save.
- * \param [in] app_cb is the application supplied callback structure that
- * contain read and write functions that actually perform the saving of
- * the data into non-volatile memory that can be replay later.
+ * \param [in] entry The entry to capture.
+ * \param [out] num_fields Number of fields of the entry.
  *
- * \return SHR_E_NONE on success and error code otherwise.
+ * \return Number of bytes of the entry body.
  */
-static int record_entry(void *fd,
-                        bcmtrm_entry_t *entry,
-                        bcmlt_capture_cb_t *app_cb)
+static uint32_t entry_rec_size(bcmtrm_entry_t *entry, uint32_t *num_fields)
 {
     shr_fmm_t *field;
-    int rv;
-    uint8_t tbl_name_len = sal_strlen(entry->info.table_name) + 1;
+    uint32_t cnt = 0;
 
-    if ((app_cb->write(fd, &tbl_name_len, 1) != 1)  ||
-        (app_cb->write(fd, (void *)entry->info.table_name, tbl_name_len) !=
-             tbl_name_len)) {
-        return SHR_E_INTERNAL;
-    }
-    if (app_cb->write(fd, entry, sizeof(*entry)) != sizeof(*entry)) {
-        return SHR_E_INTERNAL;
+    for (field = entry->l_field; field; field = field->next) {
+        cnt++;
     }
+    *num_fields = cnt;
+    return sizeof(cap_entry_t) +
+           CAP_ALIGN4(sal_strlen(entry->info.table_name) + 1) +
+           cnt * sizeof(cap_field_t);
+}
 
-    /* save all the fields */
+/*!
+ *\brief Serialize an entry into the capture ring.
+ *
+ * \param [in] ctrl Capture control.
+ * \param [in,out] pos Ring position.
+ * \param [in] entry The entry to capture.
+ * \param [in] num_fields Number of fields of the entry.
+ *
+ * \return None.
+ */
+static void entry_rec_put(capture_ctrl_t *ctrl, uint32_t *pos,
+                          bcmtrm_entry_t *entry, uint32_t num_fields)
+{
+    static const uint8_t pad[4];
+    cap_entry_t rec;
+    cap_field_t frec;
+    shr_fmm_t *field;
+    uint32_t name_len = sal_strlen(entry->info.table_name) + 1;
+
+    sal_memset(&rec, 0, sizeof(rec));
+    rec.unit = entry->info.unit;
+    rec.opcode = entry->pt ? (uint32_t)entry->opcode.pt_opcode :
+                             (uint32_t)entry->opcode.lt_opcode;
+    rec.attrib = entry->attrib;
+    rec.num_fields = num_fields;
+    rec.name_len = name_len;
+    rec.pt = entry->pt;
+    rec.priority = entry->priority;
+    rec.notif_opt = entry->info.notif_opt;
+    ring_put(ctrl, pos, &rec, sizeof(rec));
+    ring_put(ctrl, pos, entry->info.table_name, name_len);
+    ring_put(ctrl, pos, pad, CAP_ALIGN4(name_len) - name_len);
+
+    sal_memset(&frec, 0, sizeof(frec));
     for (field = entry->l_field; field; field = field->next) {
-        rv = app_cb->write(fd, field, sizeof(*field));
-        if (rv != sizeof(*field)) {
-            return SHR_E_INTERNAL;
-        }
+        frec.id = field->id;
+        frec.idx = field->idx;
+        frec.flags = field->flags;
+        frec.data = field->data;
+        ring_put(ctrl, pos, &frec, sizeof(frec));
     }
+}
+
+/*!
+ *\brief Reserve ring space for a record and write its header.
+ *
+ * Must be called with the capture lock held. On success the caller
+ * writes the record body from the returned position and then calls
+ * \ref rec_commit().
+ *
+ * \param [in] ctrl Capture control.
+ * \param [in] type Record type.
+ * \param [in] body_len Record body length.
+ * \param [out] pos Ring position of the record body.
+ *
+ * \return SHR_E_NONE on success, SHR_E_FULL if the ring has no room at
+ * the moment, SHR_E_RESOURCE if the record can never fit.
+ */
+static int rec_reserve(capture_ctrl_t *ctrl, uint8_t type,
+                       uint32_t body_len, uint32_t *pos)
+{
+    cap_rec_hdr_t hdr;
+    uint32_t len = sizeof(hdr) + body_len;
+
+    if (len > BCMLT_CAPTURE_RING_SIZE) {
+        ctrl->dropped++;
+        ctrl->seq++;
+        return SHR_E_RESOURCE;
+    }
+    if (len > BCMLT_CAPTURE_RING_SIZE - (ctrl->head - ctrl->tail)) {
+        return SHR_E_FULL;
+    }
+
+    sal_memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = CAP_REC_MAGIC;
+    hdr.version = CAP_REC_VERSION;
+    hdr.type = type;
+    hdr.len = len;
+    hdr.seq = ctrl->seq++;
+    hdr.ts = sal_time_usecs();
+    *pos = ctrl->head;
+    ring_put(ctrl, pos, &hdr, sizeof(hdr));
     return SHR_E_NONE;
 }
 
+/*!
+ *\brief Publish a record written after \ref rec_reserve().
+ *
+ * \param [in] ctrl Capture control.
+ * \param [in] pos Ring position after the record.
+ *
+ * \return None.
+ */
+static void rec_commit(capture_ctrl_t *ctrl, uint32_t pos)
+{
+    ctrl->head = pos;
+    if (ctrl->head - ctrl->tail > BCMLT_CAPTURE_RING_SIZE / 2) {
+        sal_sem_give(ctrl->wake);
+    }
+}
+
+/*!
+ *\brief Wait for the writer to make room in the ring.
+ *
+ * Must be called with the capture lock held and the capture active. The
+ * lock is released while waiting, so the caller must check that the
+ * capture is still active before it touches the ring again.
+ *
+ * \param [in] ctrl Capture control.
+ *
+ * \return None.
+ */
+static void ring_wait(capture_ctrl_t *ctrl)
+{
+    /* Kick the writer before the capture may be stopped and freed */
+    sal_sem_give(ctrl->wake);
+    sal_spinlock_unlock(ctrl->lock);
+    sal_usleep(CAPTURE_RING_WAIT_USECS);
+    sal_spinlock_lock(ctrl->lock);
+}
+
+/*!
+ *\brief Write the captured records to the application IO.
+ *
+ * The records are copied into a linear staging buffer so that each
+ * application write call carries whole records only. This keeps the
+ * records of several units sharing one file from interleaving.
+ *
+ * \param [in] ctrl Capture control.
+ *
+ * \return None.
+ */
+static void capture_drain(capture_ctrl_t *ctrl)
+{
+    uint32_t head, tail, len, off, part;
+
+    sal_spinlock_lock(ctrl->lock);
+    head = ctrl->head;
+    tail = ctrl->tail;
+    sal_spinlock_unlock(ctrl->lock);
+
+    len = head - tail;
+    if (len == 0) {
+        return;
+    }
+
+    /* The producers never write the [tail, head) range. */
+    off = tail & (BCMLT_CAPTURE_RING_SIZE - 1);
+    part = BCMLT_CAPTURE_RING_SIZE - off;
+    if (part >= len) {
+        sal_memcpy(ctrl->stage, ctrl->ring + off, len);
+    } else {
+        sal_memcpy(ctrl->stage, ctrl->ring + off, part);
+        sal_memcpy(ctrl->stage + part, ctrl->ring, len - part);
+    }
+
+    sal_spinlock_lock(ctrl->lock);
+    ctrl->tail = head;
+    sal_spinlock_unlock(ctrl->lock);
+
+    if (ctrl->app_cb.write(ctrl->app_cb.fd, ctrl->stage, len) != len) {
+        ctrl->io_errors++;
+    }
+}
+
+/*!
+ *\brief Capture writer thread.
+ *
+ * \param [in] arg Capture control.
+ *
+ * \return None.
+ */
+static void capture_writer(void *arg)
+{
+    capture_ctrl_t *ctrl = (capture_ctrl_t *)arg;
+
+    while (ctrl->running) {
+        sal_sem_take(ctrl->wake, CAPTURE_WRITER_USECS);
+        capture_drain(ctrl);
+    }
+    capture_drain(ctrl);
+    sal_sem_give(ctrl->done);
+}
+
+/*!
+ *\brief Free the resources of a capture.
+ *
+ * The lock is kept since the commit path may still be spinning on it.
+ *
+ * \param [in] ctrl Capture control.
+ *
+ * \return None.
+ */
+static void capture_free(capture_ctrl_t *ctrl)
+{
+    if (ctrl->wake) {
+        sal_sem_destroy(ctrl->wake);
+        ctrl->wake = NULL;
+    }
+    if (ctrl->done) {
+        sal_sem_destroy(ctrl->done);
+        ctrl->done = NULL;
+    }
+    if (ctrl->ring) {
+        sal_free(ctrl->ring);
+        ctrl->ring = NULL;
+    }
+    if (ctrl->stage) {
+        sal_free(ctrl->stage);
+        ctrl->stage = NULL;
+    }
+    sal_memset(&ctrl->app_cb, 0, sizeof(ctrl->app_cb));
+}
+
 /*!
  *\brief Delays the execution to replay at the same timing as original.
  *
@@ -280,32 +630,148 @@ static bcmtrm_entry_t* create_entry(bcmlt_replay_cb_t *app_cb)
 }
 
 /*!
- *\brief Replay an entry operation.
+ *\brief Read from the replay IO.
  *
- * This function replay one entry operation. It first ceates the entry
- * by reading its content from the IO and then posting it to the transaction
- * manager for processing.
+ * Bytes pushed back during the format detection are returned first.
  *
- * \param [in] app_cb is the application provided IO structure to perform
- * read and write operations from/to the replay log.
+ * \param [in] fd The replay IO structure.
+ * \param [out] buffer Buffer for the data.
+ * \param [in] nbyte Number of bytes to read.
+ *
+ * \return Number of bytes read.
+ */
+static uint32_t replay_io_read(void *fd, void *buffer, uint32_t nbyte)
+{
+    replay_io_t *io = (replay_io_t *)fd;
+    uint32_t len = 0;
+
+    if (io->pb_pos < io->pb_len) {
+        len = io->pb_len - io->pb_pos;
+        if (len > nbyte) {
+            len = nbyte;
+        }
+        sal_memcpy(buffer, io->pb + io->pb_pos, len);
+        io->pb_pos += len;
+        if (len == nbyte) {
+            return len;
+        }
+    }
+    return len + io->app_cb->read(io->app_cb->fd,
+                                  (uint8_t *)buffer + len, nbyte - len);
+}
+
+/*!
+ *\brief Record the latency of a replayed operation.
+ *
+ * \param [in] ctx Statistics context (may be NULL).
+ * \param [in] usecs Latency of the operation.
+ * \param [in] num_entries Number of entries of the operation.
+ * \param [in] failed True if the operation failed.
  *
  * \return SHR_E_NONE on success and error code otherwise.
  */
-static int replay_entry(bcmlt_replay_cb_t *app_cb,
+static int stats_op_record(replay_stats_ctx_t *ctx, uint32_t usecs,
+                           uint32_t num_entries, bool failed)
+{
+    bcmlt_replay_stats_t *stats;
+    uint32_t *lat;
+    uint32_t size;
+
+    if (!ctx) {
+        return SHR_E_NONE;
+    }
+    stats = ctx->stats;
+    if (stats->num_ops == ctx->lat_size) {
+        size = ctx->lat_size ? ctx->lat_size * 2 : 1024;
+        lat = sal_alloc(size * sizeof(*lat), "bcmltReplayLat");
+        if (!lat) {
+            return SHR_E_MEMORY;
+        }
+        if (ctx->lat) {
+            sal_memcpy(lat, ctx->lat, ctx->lat_size * sizeof(*lat));
+            sal_free(ctx->lat);
+        }
+        ctx->lat = lat;
+        ctx->lat_size = size;
+    }
+    ctx->lat[stats->num_ops++] = usecs;
+    ctx->lat_sum += usecs;
+    stats->num_entries += num_entries;
+    if (failed) {
+        stats->num_failed++;
+    }
+    return SHR_E_NONE;
+}
+
+/*!
+ *\brief Compare two latencies for sorting.
+ */
+static int lat_cmp(const void *a, const void *b)
+{
+    uint32_t la = *(const uint32_t *)a;
+    uint32_t lb = *(const uint32_t *)b;
+
+    return (la > lb) - (la < lb);
+}
+
+/*!
+ *\brief Compute the latency summary of the replay.
+ *
+ * \param [in] ctx Statistics context.
+ * \param [in] elapsed Replay duration in usecs.
+ *
+ * \return None.
+ */
+static void stats_summarize(replay_stats_ctx_t *ctx, uint64_t elapsed)
+{
+    bcmlt_replay_stats_t *stats = ctx->stats;
+    uint32_t n = stats->num_ops;
+
+    stats->elapsed_usecs = elapsed;
+    if (n == 0) {
+        return;
+    }
+    if (elapsed > 0) {
+        stats->ops_per_sec = (uint32_t)((uint64_t)n * 1000000 / elapsed);
+    }
+    sal_qsort(ctx->lat, n, sizeof(*ctx->lat), lat_cmp);
+    stats->lat_min = ctx->lat[0];
+    stats->lat_avg = (uint32_t)(ctx->lat_sum / n);
+    stats->lat_p50 = ctx->lat[(n - 1) * 50 / 100];
+    stats->lat_p90 = ctx->lat[(n - 1) * 90 / 100];
+    stats->lat_p99 = ctx->lat[(n - 1) * 99 / 100];
+    stats->lat_max = ctx->lat[n - 1];
+}
+
+/*!
+ *\brief Submit a replayed entry.
+ *
+ * \param [in] entry The entry to submit. The entry is freed.
+ * \param [in] cb Application replay action callback.
+ * \param [in] view_only Only notify the application if true.
+ * \param [in] ctx Statistics context (may be NULL).
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+static int entry_submit(bcmtrm_entry_t *entry,
                         replay_action_f *cb,
-                        bool view_only)
+                        bool view_only,
+                        replay_stats_ctx_t *ctx)
 {
-    bcmtrm_entry_t *entry;
     int rv = SHR_E_NONE;
     bcmlt_object_hdl_t obj;
+    sal_usecs_t start;
 
-    entry = create_entry(app_cb);
-    if (!entry) {
-        return SHR_E_INTERNAL;
-    }
     entry->asynch = false;
     if (!view_only) {
+        start = sal_time_usecs();
         rv = bcmtrm_entry_req(entry);
+        /* Failed operations are counted rather than ending a benchmark */
+        if (ctx) {
+            rv = stats_op_record(ctx, sal_time_usecs() - start, 1,
+                                 SHR_FAILURE(rv) ||
+                                 SHR_FAILURE(entry->info.status));
+        }
     }
     if (cb) {
         obj.entry = true;
@@ -317,24 +783,79 @@ static int replay_entry(bcmlt_replay_cb_t *app_cb,
 }
 
 /*!
- *\brief Adds an entry to a transaction.
+ *\brief Submit a replayed transaction.
  *
- * This function creates a new entry and adds it to a given transaction.
+ * \param [in] trans The transaction to submit. The transaction is freed.
+ * \param [in] cb Application replay action callback.
+ * \param [in] view_only Only notify the application if true.
+ * \param [in] ctx Statistics context (may be NULL).
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+static int trans_submit(bcmtrm_trans_t *trans,
+                        replay_action_f *cb,
+                        bool view_only,
+                        replay_stats_ctx_t *ctx)
+{
+    int rv = SHR_E_NONE;
+    bcmlt_object_hdl_t obj;
+    sal_usecs_t start;
+
+    if (!view_only) {
+        start = sal_time_usecs();
+        rv = bcmtrm_trans_req(trans);
+        if (ctx) {
+            rv = stats_op_record(ctx, sal_time_usecs() - start,
+                                 trans->info.num_entries,
+                                 SHR_FAILURE(rv) ||
+                                 SHR_FAILURE(trans->info.status));
+        }
+    }
+    if (cb) {
+        obj.entry = false;
+        obj.hdl.trans = trans->info.trans_hdl;
+        cb(trans->unit, &obj);
+    }
+    bcmtrm_trans_free(trans);
+    return rv;
+}
+
+/*!
+ *\brief Replay an entry operation.
+ *
+ * This function replay one entry operation. It first ceates the entry
+ * by reading its content from the IO and then posting it to the transaction
+ * manager for processing.
  *
- * \param [in] trans is the transaction to add the entry to.
  * \param [in] app_cb is the application provided IO structure to perform
  * read and write operations from/to the replay log.
  *
  * \return SHR_E_NONE on success and error code otherwise.
  */
-static int add_entry(bcmtrm_trans_t *trans, bcmlt_replay_cb_t *app_cb)
+static int replay_entry(bcmlt_replay_cb_t *app_cb,
+                        replay_action_f *cb,
+                        bool view_only,
+                        replay_stats_ctx_t *ctx)
 {
     bcmtrm_entry_t *entry;
 
     entry = create_entry(app_cb);
     if (!entry) {
-        return SHR_E_MEMORY;
+        return SHR_E_INTERNAL;
     }
+    return entry_submit(entry, cb, view_only, ctx);
+}
+
+/*!
+ *\brief Adds an entry to a transaction.
+ *
+ * \param [in] trans is the transaction to add the entry to.
+ * \param [in] entry is the entry to add.
+ *
+ * \return None.
+ */
+static void trans_entry_add(bcmtrm_trans_t *trans, bcmtrm_entry_t *entry)
+{
     /* Entry should be kept in the same order so add to the end */
     entry->next = NULL;
     if (!trans->l_entries) {
@@ -344,6 +865,28 @@ static int add_entry(bcmtrm_trans_t *trans, bcmlt_replay_cb_t *app_cb)
     }
     trans->last_entry = entry;
     entry->p_trans = trans;
+}
+
+/*!
+ *\brief Adds an entry to a transaction.
+ *
+ * This function creates a new entry and adds it to a given transaction.
+ *
+ * \param [in] trans is the transaction to add the entry to.
+ * \param [in] app_cb is the application provided IO structure to perform
+ * read and write operations from/to the replay log.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+static int add_entry(bcmtrm_trans_t *trans, bcmlt_replay_cb_t *app_cb)
+{
+    bcmtrm_entry_t *entry;
+
+    entry = create_entry(app_cb);
+    if (!entry) {
+        return SHR_E_MEMORY;
+    }
+    trans_entry_add(trans, entry);
     return SHR_E_NONE;
 }
 
@@ -360,14 +903,14 @@ static int add_entry(bcmtrm_trans_t *trans, bcmlt_replay_cb_t *app_cb)
  */
 static int replay_trans(bcmlt_replay_cb_t *app_cb,
                         replay_action_f *cb,
-                        bool view_only)
+                        bool view_only,
+                        replay_stats_ctx_t *ctx)
 {
     bcmtrm_trans_t *trans;
     bcmtrm_trans_t recovered_trans;
     uint32_t j;
     int rv;
     void *fd = app_cb->fd;
-    bcmlt_object_hdl_t obj;
 
     if (app_cb->read(fd, &recovered_trans, sizeof(*trans)) != sizeof(*trans)) {
         return SHR_E_INTERNAL;
@@ -390,15 +933,270 @@ static int replay_trans(bcmlt_replay_cb_t *app_cb,
             return rv;
         }
     }
-    if (!view_only) {
-        rv = bcmtrm_trans_req(trans);
+    return trans_submit(trans, cb, view_only, ctx);
+}
+
+/*!
+ *\brief Create an entry from a captured entry record.
+ *
+ * \param [in] buf Record body buffer.
+ * \param [in] len Record body length.
+ * \param [in,out] off Offset of the entry in \c buf, advanced past it.
+ *
+ * \return On success a pointer to the newly created entry. NULL on
+ * failure.
+ */
+static bcmtrm_entry_t *cap_entry_create(const uint8_t *buf, uint32_t len,
+                                        uint32_t *off)
+{
+    cap_entry_t rec;
+    cap_field_t frec;
+    const char *tbl_name;
+    bcmlt_table_attrib_t *table_attr;
+    bcmtrm_entry_t *entry;
+    shr_fmm_t *field, *last = NULL;
+    void *hdl;
+    uint32_t pos = *off;
+    uint32_t j;
+
+    if (len - pos < sizeof(rec)) {
+        return NULL;
     }
-    if (cb) {
-        obj.entry = false;
-        obj.hdl.trans = trans->info.trans_hdl;
-        cb(trans->unit, &obj);
+    sal_memcpy(&rec, buf + pos, sizeof(rec));
+    pos += sizeof(rec);
+    if (rec.name_len == 0 ||
+        len - pos < CAP_ALIGN4(rec.name_len) ||
+        (len - pos - CAP_ALIGN4(rec.name_len)) / sizeof(frec) <
+        rec.num_fields) {
+        return NULL;
+    }
+    tbl_name = (const char *)buf + pos;
+    if (tbl_name[rec.name_len - 1] != '\0') {
+        return NULL;
+    }
+    pos += CAP_ALIGN4(rec.name_len);
+
+    /* Table ID may change so retrieve it again */
+    if (bcmlt_db_table_info_get(rec.unit, tbl_name, &table_attr,
+                                NULL, &hdl) != SHR_E_NONE) {
+        return NULL;
+    }
+    entry = bcmtrm_entry_alloc(rec.unit,
+                               table_attr->table_id,
+                               table_attr->interactive,
+                               table_attr->pt,
+                               NULL,
+                               table_attr->name);
+    if (!entry) {
+        return NULL;
+    }
+    entry->db_hdl = hdl;
+    entry->asynch = false;
+    entry->attrib = rec.attrib;
+    entry->info.unit = rec.unit;
+    entry->info.notif_opt = rec.notif_opt;
+    if (rec.pt) {
+        entry->opcode.pt_opcode = (bcmlt_pt_opcode_t)rec.opcode;
+    } else {
+        entry->opcode.lt_opcode = (bcmlt_opcode_t)rec.opcode;
+    }
+    entry->priority = rec.priority;
+    entry->max_fid = 0;
+    entry->fld_arr = NULL;
+
+    if (bcmlt_hdl_alloc(entry, &entry->info.entry_hdl) != SHR_E_NONE) {
+        bcmtrm_entry_free(entry);
+        return NULL;
+    }
+
+    /* Keep the captured field order */
+    for (j = 0; j < rec.num_fields; j++) {
+        field = shr_fmm_alloc();
+        if (!field) {
+            bcmtrm_entry_free(entry);
+            return NULL;
+        }
+        sal_memcpy(&frec, buf + pos, sizeof(frec));
+        pos += sizeof(frec);
+        field->id = frec.id;
+        field->idx = frec.idx;
+        field->flags = frec.flags;
+        field->data = frec.data;
+        field->next = NULL;
+        if (last) {
+            last->next = field;
+        } else {
+            entry->l_field = field;
+        }
+        last = field;
+    }
+
+    *off = pos;
+    return entry;
+}
+
+/*!
+ *\brief Replay a captured record.
+ *
+ * \param [in] type Record type.
+ * \param [in] buf Record body buffer.
+ * \param [in] len Record body length.
+ * \param [in] cb Application replay action callback.
+ * \param [in] view_only Only notify the application if true.
+ * \param [in] ctx Statistics context (may be NULL).
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+static int cap_replay_rec(uint8_t type, const uint8_t *buf, uint32_t len,
+                          replay_action_f *cb, bool view_only,
+                          replay_stats_ctx_t *ctx)
+{
+    bcmtrm_entry_t *entry;
+    bcmtrm_trans_t *trans;
+    cap_trans_t rec;
+    uint32_t off = 0;
+    uint32_t j;
+    int rv;
+
+    if (type == CAP_TYPE_START) {
+        return SHR_E_NONE;
+    }
+    if (type == CAP_TYPE_ENTRY) {
+        entry = cap_entry_create(buf, len, &off);
+        if (!entry) {
+            return SHR_E_INTERNAL;
+        }
+        return entry_submit(entry, cb, view_only, ctx);
+    }
+    if (type != CAP_TYPE_TRANS || len < sizeof(rec)) {
+        return SHR_E_INTERNAL;
+    }
+
+    sal_memcpy(&rec, buf, sizeof(rec));
+    off = sizeof(rec);
+    trans = bcmtrm_trans_alloc((bcmlt_trans_type_t)rec.type);
+    if (!trans) {
+        return SHR_E_MEMORY;
+    }
+    rv = bcmlt_hdl_alloc(trans, &trans->info.trans_hdl);
+    if (rv != SHR_E_NONE) {
+        bcmtrm_trans_free(trans);
+        return rv;
+    }
+    trans->unit = rec.unit;
+    trans->info.num_entries = rec.num_entries;
+    trans->info.notif_opt = rec.notif_opt;
+    trans->syncronous = true;
+    trans->pt_trans = rec.pt_trans;
+    trans->priority = rec.priority;
+    trans->l_entries = NULL;
+    for (j = 0; j < rec.num_entries; j++) {
+        entry = cap_entry_create(buf, len, &off);
+        if (!entry) {
+            bcmtrm_trans_free(trans);
+            return SHR_E_INTERNAL;
+        }
+        trans_entry_add(trans, entry);
+    }
+    return trans_submit(trans, cb, view_only, ctx);
+}
+
+/*!
+ *\brief Replay a capture.
+ *
+ * The capture format is detected from its first record. Captures
+ * without a START record are replayed as raw structure dumps written by
+ * earlier versions.
+ *
+ * \param [in] timing Maintain the original timing if true.
+ * \param [in] cb Application replay action callback.
+ * \param [in] view_only Only notify the application if true.
+ * \param [in] app_cb Application replay IO.
+ * \param [in] ctx Statistics context (may be NULL).
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+static int replay_run(bool timing,
+                      replay_action_f *cb,
+                      bool view_only,
+                      bcmlt_replay_cb_t *app_cb,
+                      replay_stats_ctx_t *ctx)
+{
+    int rv = SHR_E_NONE;
+    replay_io_t io;
+    bcmlt_replay_cb_t io_cb;
+    cap_rec_hdr_t hdr;
+    sal_usecs_t *ts;
+    sal_usecs_t current_ts = 0;
+    uint8_t buffer[sizeof(sal_usecs_t) + 1];
+    uint8_t *body = NULL;
+    uint32_t body_size = 0;
+    uint32_t len;
+
+    sal_memset(&io, 0, sizeof(io));
+    io.app_cb = app_cb;
+    io_cb.fd = &io;
+    io_cb.read = replay_io_read;
+
+    /* Detect the capture format */
+    io.pb_len = app_cb->read(app_cb->fd, io.pb, sizeof(io.pb));
+    sal_memcpy(&hdr, io.pb, sizeof(hdr));
+    if (io.pb_len != sizeof(hdr) || hdr.magic != CAP_REC_MAGIC ||
+        hdr.version != CAP_REC_VERSION || hdr.type != CAP_TYPE_START) {
+        ts = (sal_usecs_t *)buffer;
+        while (io_cb.read(io_cb.fd, buffer, sizeof(buffer)) ==
+               sizeof(buffer)) {
+            if (timing) {
+                wait_till_ready(*ts, &current_ts);
+            }
+            if (buffer[sizeof(sal_usecs_t)] == TRANS_TYPE) {
+                rv = replay_trans(&io_cb, cb, view_only, ctx);
+            } else if (buffer[sizeof(sal_usecs_t)] == ENTRY_TYPE) {
+                rv = replay_entry(&io_cb, cb, view_only, ctx);
+            } else {
+                rv = SHR_E_INTERNAL;
+            }
+            if (rv != SHR_E_NONE) {
+                return rv;
+            }
+        }
+        return SHR_E_NONE;
+    }
+
+    while (io_cb.read(io_cb.fd, &hdr, sizeof(hdr)) == sizeof(hdr)) {
+        if (hdr.magic != CAP_REC_MAGIC || hdr.version != CAP_REC_VERSION ||
+            hdr.len < sizeof(hdr)) {
+            rv = SHR_E_INTERNAL;
+            break;
+        }
+        len = hdr.len - sizeof(hdr);
+        if (len > body_size) {
+            if (body) {
+                sal_free(body);
+            }
+            body_size = len;
+            body = sal_alloc(body_size, "bcmltReplayRec");
+            if (!body) {
+                rv = SHR_E_MEMORY;
+                break;
+            }
+        }
+        if (len && io_cb.read(io_cb.fd, body, len) != len) {
+            rv = SHR_E_INTERNAL;
+            break;
+        }
+        if (timing) {
+            wait_till_ready((sal_usecs_t)hdr.ts, &current_ts);
+        }
+        rv = cap_replay_rec(hdr.type, body, len, cb, view_only, ctx);
+        if (rv != SHR_E_NONE) {
+            break;
+        }
+    }
+
+    if (body) {
+        sal_free(body);
     }
-    bcmtrm_trans_free(trans);
     return rv;
 }
 
@@ -408,81 +1206,178 @@ static int replay_trans(bcmlt_replay_cb_t *app_cb,
  */
 int bcmlt_capture_start(int unit, bcmlt_capture_cb_t *app_cb)
 {
+    capture_ctrl_t *ctrl;
+    cap_start_t rec;
+    uint32_t pos;
+
     if ((unit < 0) || unit >= BCMDRD_CONFIG_MAX_UNITS) {
         return SHR_E_UNIT;
     }
-    if (replay_fh[unit].write) {
+    if (!app_cb || !app_cb->write) {
+        return SHR_E_PARAM;
+    }
+    ctrl = &capture_ctrl[unit];
+    if (ctrl->active || ctrl->running) {
         return SHR_E_BUSY;
     }
-    replay_fh[unit] = *app_cb;
+
+    if (!ctrl->lock) {
+        ctrl->lock = sal_spinlock_create("bcmltCaptureLock");
+        if (!ctrl->lock) {
+            return SHR_E_MEMORY;
+        }
+    }
+    ctrl->ring = sal_alloc(BCMLT_CAPTURE_RING_SIZE, "bcmltCaptureRing");
+    ctrl->stage = sal_alloc(BCMLT_CAPTURE_RING_SIZE, "bcmltCaptureStage");
+    ctrl->wake = sal_sem_create("bcmltCaptureWake", SAL_SEM_BINARY, 0);
+    ctrl->done = sal_sem_create("bcmltCaptureDone", SAL_SEM_BINARY, 0);
+    if (!ctrl->ring || !ctrl->stage || !ctrl->wake || !ctrl->done) {
+        capture_free(ctrl);
+        return SHR_E_MEMORY;
+    }
+    ctrl->app_cb = *app_cb;
+    ctrl->head = 0;
+    ctrl->tail = 0;
+    ctrl->seq = 0;
+    ctrl->dropped = 0;
+    ctrl->io_errors = 0;
+
+    /* The START record identifies the capture format */
+    sal_memset(&rec, 0, sizeof(rec));
+    sal_memcpy(rec.magic, CAP_START_MAGIC, sizeof(rec.magic));
+    rec.unit = unit;
+    if (rec_reserve(ctrl, CAP_TYPE_START, sizeof(rec), &pos) == SHR_E_NONE) {
+        ring_put(ctrl, &pos, &rec, sizeof(rec));
+        rec_commit(ctrl, pos);
+    }
+
+    ctrl->running = true;
+    if (sal_thread_create("bcmltCapture", SAL_THREAD_STKSZ,
+                          SAL_THREAD_PRIO_DEFAULT,
+                          capture_writer, ctrl) == SAL_THREAD_ERROR) {
+        ctrl->running = false;
+        capture_free(ctrl);
+        return SHR_E_FAIL;
+    }
+    sal_spinlock_lock(ctrl->lock);
+    ctrl->active = true;
+    sal_spinlock_unlock(ctrl->lock);
     return SHR_E_NONE;
 }
 
 int bcmlt_capture_stop(int unit)
 {
+    capture_ctrl_t *ctrl;
+
     if ((unit < 0) || unit >= BCMDRD_CONFIG_MAX_UNITS) {
         return SHR_E_UNIT;
     }
-    replay_fh[unit].write = 0;
+    ctrl = &capture_ctrl[unit];
+    if (!ctrl->running) {
+        return SHR_E_NONE;
+    }
+
+    /*
+     * No new records once the lock is released. A producer waiting in
+     * ring_wait() has already left the ring and the semaphores alone and
+     * re-checks the flag when it takes the lock again.
+     */
+    sal_spinlock_lock(ctrl->lock);
+    ctrl->active = false;
+    sal_spinlock_unlock(ctrl->lock);
+
+    /* Let the writer drain the ring and exit */
+    ctrl->running = false;
+    sal_sem_give(ctrl->wake);
+    sal_sem_take(ctrl->done, SAL_SEM_FOREVER);
+
+    if (ctrl->dropped || ctrl->io_errors) {
+        LOG_WARN(BSL_LOG_MODULE,
+                 (BSL_META_U(unit,
+                             "Capture dropped %"PRIu32" oversized records "
+                             "and failed %"PRIu32" writes.\n"),
+                  ctrl->dropped, ctrl->io_errors));
+    }
+    capture_free(ctrl);
     return SHR_E_NONE;
 }
 
 int bcmlt_replay_entry_record(bcmtrm_entry_t *entry)
 {
-    void *fd;
-    sal_usecs_t *ts;
-    sal_usecs_t cur_time;
-    uint8_t buffer[sizeof(sal_usecs_t) + 1];
-    bcmlt_capture_cb_t *app_cb = &replay_fh[entry->info.unit];
+    capture_ctrl_t *ctrl = &capture_ctrl[entry->info.unit];
+    uint32_t num_fields;
+    uint32_t body_len;
+    uint32_t pos;
+    int rv;
 
-    if (!app_cb->write) {
+    if (!ctrl->active) {
         return SHR_E_INIT;
     }
-    fd = app_cb->fd;
-    ts = (sal_usecs_t *)buffer;
-    cur_time = sal_time_usecs();
-    *ts = cur_time;
-    buffer[sizeof(sal_usecs_t)] = ENTRY_TYPE;
-    if (app_cb->write(fd, buffer, sizeof(buffer)) != sizeof(buffer)) {
-        return SHR_E_INTERNAL;
-    }
-    return record_entry(fd, entry, app_cb);
+    body_len = entry_rec_size(entry, &num_fields);
+
+    sal_spinlock_lock(ctrl->lock);
+    do {
+        if (!ctrl->active) {
+            rv = SHR_E_INIT;
+            break;
+        }
+        rv = rec_reserve(ctrl, CAP_TYPE_ENTRY, body_len, &pos);
+        if (rv == SHR_E_NONE) {
+            entry_rec_put(ctrl, &pos, entry, num_fields);
+            rec_commit(ctrl, pos);
+        } else if (rv == SHR_E_FULL) {
+            ring_wait(ctrl);
+        }
+    } while (rv == SHR_E_FULL);
+    sal_spinlock_unlock(ctrl->lock);
+    return rv;
 }
 
 int bcmlt_replay_trans_record(bcmtrm_trans_t *trans)
 {
-    void *fd;
-    sal_usecs_t *ts;
-    sal_usecs_t cur_time;
-    uint8_t buffer[sizeof(sal_usecs_t) + 1];
+    capture_ctrl_t *ctrl = &capture_ctrl[trans->unit];
     bcmtrm_entry_t *entry;
+    cap_trans_t rec;
+    uint32_t num_fields;
+    uint32_t body_len = sizeof(rec);
+    uint32_t pos;
     int rv;
-    bcmlt_capture_cb_t *app_cb = &replay_fh[trans->unit];
 
-    if (!app_cb->write) {
+    if (!ctrl->active) {
         return SHR_E_INIT;
     }
 
-    fd = app_cb->fd;
-    ts = (sal_usecs_t *)buffer;
-    cur_time = sal_time_usecs();
-    *ts = cur_time;
-    buffer[sizeof(sal_usecs_t)] = TRANS_TYPE;
-    rv = app_cb->write(fd, buffer, sizeof(buffer));
-    if (rv != sizeof(buffer)) {
-        return SHR_E_INTERNAL;
-    }
-    rv = app_cb->write(fd, trans, sizeof(*trans));
-    if (rv != sizeof(*trans)) {
-        return SHR_E_INTERNAL;
-    }
+    sal_memset(&rec, 0, sizeof(rec));
+    rec.unit = trans->unit;
+    rec.type = trans->info.type;
+    rec.pt_trans = trans->pt_trans;
+    rec.priority = trans->priority;
+    rec.notif_opt = trans->info.notif_opt;
     for (entry = trans->l_entries; entry; entry = entry->next) {
-        rv = record_entry(fd, entry, app_cb);
-        if (rv != SHR_E_NONE) {
-            return rv;
-        }
+        body_len += entry_rec_size(entry, &num_fields);
+        rec.num_entries++;
     }
-    return SHR_E_NONE;
+
+    sal_spinlock_lock(ctrl->lock);
+    do {
+        if (!ctrl->active) {
+            rv = SHR_E_INIT;
+            break;
+        }
+        rv = rec_reserve(ctrl, CAP_TYPE_TRANS, body_len, &pos);
+        if (rv == SHR_E_NONE) {
+            ring_put(ctrl, &pos, &rec, sizeof(rec));
+            for (entry = trans->l_entries; entry; entry = entry->next) {
+                entry_rec_size(entry, &num_fields);
+                entry_rec_put(ctrl, &pos, entry, num_fields);
+            }
+            rec_commit(ctrl, pos);
+        } else if (rv == SHR_E_FULL) {
+            ring_wait(ctrl);
+        }
+    } while (rv == SHR_E_FULL);
+    sal_spinlock_unlock(ctrl->lock);
+    return rv;
 }
 
 int bcmlt_capture_replay(bool timing,
@@ -490,31 +1385,33 @@ int bcmlt_capture_replay(bool timing,
                          bool view_only,
                          bcmlt_replay_cb_t *app_cb)
 {
+    if (!app_cb || !app_cb->read || !app_cb->fd) {
+        return SHR_E_PARAM;
+    }
+    return replay_run(timing, cb, view_only, app_cb, NULL);
+}
+
+int bcmlt_capture_replay_max_rate(replay_action_f *cb,
+                                  bcmlt_replay_cb_t *app_cb,
+                                  bcmlt_replay_stats_t *stats)
+{
+    replay_stats_ctx_t ctx;
+    sal_usecs_t start;
     int rv;
-    void *fd;
-    sal_usecs_t *ts;
-    sal_usecs_t current_ts = 0;
-    uint8_t buffer[sizeof(sal_usecs_t) + 1];
 
-    if (!app_cb || !app_cb->read || !app_cb->fd) {
+    if (!app_cb || !app_cb->read || !app_cb->fd || !stats) {
         return SHR_E_PARAM;
     }
-    fd = app_cb->fd;
-    ts = (sal_usecs_t *)buffer;
-    while (app_cb->read(fd, buffer, sizeof(buffer)) == sizeof(buffer)) {
-        if (timing) {
-            wait_till_ready(*ts, &current_ts);
-        }
-        if (buffer[sizeof(sal_usecs_t)] == TRANS_TYPE) {
-            rv = replay_trans(app_cb, cb, view_only);
-        } else if (buffer[sizeof(sal_usecs_t)] == ENTRY_TYPE) {
-            rv = replay_entry(app_cb, cb, view_only);
-        } else {
-            rv = SHR_E_INTERNAL;
-        }
-        if (rv != SHR_E_NONE) {
-            return rv;
-        }
+    sal_memset(stats, 0, sizeof(*stats));
+    sal_memset(&ctx, 0, sizeof(ctx));
+    ctx.stats = stats;
+
+    start = sal_time_usecs();
+    rv = replay_run(false, cb, false, app_cb, &ctx);
+    stats_summarize(&ctx, sal_time_usecs() - start);
+
+    if (ctx.lat) {
+        sal_free(ctx.lat);
     }
-    return SHR_E_NONE;
+    return rv;
 }
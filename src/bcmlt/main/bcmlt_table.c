@@ -152,6 +152,50 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+int bcmlt_table_id_get(int unit,
+                       const char *table_name,
+                       uint32_t *tid)
+{
+    bcmlt_table_attrib_t *tbl_attr;
+    void *hdl;
+
+    SHR_FUNC_ENTER(unit);
+    UNIT_VALIDATION(unit);
+    if (!table_name || !tid) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    SHR_IF_ERR_VERBOSE_EXIT(
+        bcmlt_db_table_info_get(unit, table_name, &tbl_attr, NULL, &hdl));
+    if (tbl_attr->pt) {
+        /* PT IDs share no ID space with LT IDs */
+        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
+    }
+    *tid = tbl_attr->table_id;
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int bcmlt_field_id_get(int unit,
+                       uint32_t tid,
+                       const char *field_name,
+                       uint32_t *fid)
+{
+    bcmlt_table_attrib_t *tbl_attr;
+    void *hdl;
+
+    SHR_FUNC_ENTER(unit);
+    UNIT_VALIDATION(unit);
+    if (!field_name || !fid) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    SHR_IF_ERR_VERBOSE_EXIT(
+        bcmlt_db_table_info_get_by_id(unit, tid, &tbl_attr, NULL, &hdl));
+    SHR_IF_ERR_VERBOSE_EXIT(
+        bcmlt_db_field_info_get(unit, field_name, hdl, NULL, fid));
+exit:
+    SHR_FUNC_EXIT();
+}
+
 int bcmlt_table_subscribe(int unit,
                           const char *table_name,
                           bcmlt_table_sub_cb callback,
@@ -214,6 +258,66 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+int bcmlt_table_chg_feed_create(int unit,
+                                const bcmlt_table_chg_feed_cfg_t *cfg)
+{
+    SHR_FUNC_ENTER(unit);
+    UNIT_VALIDATION(unit);
+    if (!cfg || !cfg->cb) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    SHR_IF_ERR_EXIT(bcmtrm_chg_feed_create(unit, cfg));
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int bcmlt_table_chg_feed_destroy(int unit)
+{
+    SHR_FUNC_ENTER(unit);
+    UNIT_VALIDATION(unit);
+    SHR_IF_ERR_EXIT(bcmtrm_chg_feed_destroy(unit));
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/*
+ * Add or remove a table from the change feed of the unit.
+ */
+static int table_chg_feed_set(int unit, const char *table_name, bool enable)
+{
+    bcmlt_table_attrib_t *tbl_attr;
+    void *tbl_hdl;
+
+    SHR_FUNC_ENTER(unit);
+    UNIT_VALIDATION(unit);
+    if (!table_name) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    SHR_IF_ERR_EXIT(bcmlt_db_table_info_get(unit,
+                                            table_name,
+                                            &tbl_attr,
+                                            NULL,
+                                            &tbl_hdl));
+
+    if (tbl_attr->pt) { /* Not events for PT tables */
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+
+    SHR_IF_ERR_EXIT(bcmtrm_table_feed_set(unit, tbl_attr->table_id, enable));
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int bcmlt_table_chg_feed_subscribe(int unit, const char *table_name)
+{
+    return table_chg_feed_set(unit, table_name, true);
+}
+
+int bcmlt_table_chg_feed_unsubscribe(int unit, const char *table_name)
+{
+    return table_chg_feed_set(unit, table_name, false);
+}
+
 int
 bcmlt_table_pt_name_get(int unit, const char *tbl_name,
                         uint32_t *pt_count_ptr, const char *pt_names[])
@@ -449,4 +449,90 @@ typedef void (*bcmlt_table_sub_cb)(bcmlt_table_notif_info_t *table_notify_info,
                                    void *user_data);
 
 
+/*! Maximum number of key fields in a table change record. */
+#define BCMLT_TABLE_CHG_KEYS_MAX    4
+
+/*!
+ * \brief Table change record flag indicating that the entry has more
+ * key fields than a change record can hold.
+ *
+ * Only the first \ref BCMLT_TABLE_CHG_KEYS_MAX key fields (in field ID
+ * order) are recorded and such records are never coalesced.
+ */
+#define BCMLT_TABLE_CHG_F_KEYS_PARTIAL  0x1
+
+/*!
+ * \brief Key field of a table change record.
+ */
+typedef struct bcmlt_table_chg_key_s {
+    uint32_t fid;   /*!< Field ID                        */
+    uint32_t idx;   /*!< Array index of the field        */
+    uint64_t data;  /*!< Field value                     */
+} bcmlt_table_chg_key_t;
+
+/*!
+ * \brief Table change record.
+ *
+ * A change record identifies a changed entry of a logical table by its
+ * key fields. The application can use a lookup operation to obtain the
+ * current content of the entry.
+ */
+typedef struct bcmlt_table_chg_rec_s {
+    uint32_t table_id;      /*!< Logical table ID                        */
+    bcmlt_opcode_t opcode;  /*!< Insert, update or delete                */
+    uint32_t flags;         /*!< BCMLT_TABLE_CHG_F_xxx flags             */
+    uint32_t coalesced;     /*!< Number of changes merged into the record */
+    uint32_t num_keys;      /*!< Number of valid key fields              */
+    bcmlt_table_chg_key_t key[BCMLT_TABLE_CHG_KEYS_MAX]; /*!< Key fields */
+} bcmlt_table_chg_rec_t;
+
+/*!
+ * \brief Batched table change callback.
+ *
+ * The signature of the callback function that processes a batch of table
+ * change records of the tables that are subscribed to the change feed
+ * of the unit.
+ *
+ * \param [in] unit Device number of the changed tables.
+ * \param [in] recs Array of change records. The array is only valid for
+ * the duration of the callback.
+ * \param [in] num_recs Number of change records in the array.
+ * \param [in] dropped Number of changes that were dropped since the
+ * previous callback, because the change feed ring was full. The
+ * application should resynchronize the affected tables.
+ * \param [in] user_data The application context provided at the time of
+ * the change feed creation.
+ *
+ * \return none
+ */
+typedef void (*bcmlt_table_chg_batch_cb)(int unit,
+                                         const bcmlt_table_chg_rec_t *recs,
+                                         uint32_t num_recs,
+                                         uint32_t dropped,
+                                         void *user_data);
+
+/*!
+ * \brief Table change feed configuration.
+ */
+typedef struct bcmlt_table_chg_feed_cfg_s {
+    /*! Number of records in the ring (rounded up to a power of 2). */
+    uint32_t ring_size;
+
+    /*! Maximum number of records per callback. */
+    uint32_t batch_size;
+
+    /*! Maximum time in microseconds a record waits for delivery. */
+    uint32_t flush_usecs;
+
+    /*! Merge repeated changes of an entry that was not delivered yet. */
+    bool coalesce;
+
+    /*! Batch callback function. */
+    bcmlt_table_chg_batch_cb cb;
+
+    /*! Application context for the callback. */
+    void *user_data;
+} bcmlt_table_chg_feed_cfg_t;
+
+
 #endif /* BCMLTD_LT_TYPES_H */
@@ -133,5 +133,25 @@ bcmltd_field_idx_count_get(uint32_t width);
 
 extern int bcmltd_table_name_to_idx(const char *table_name);
 
+/*!
+ * \brief Create the table name index.
+ *
+ * Build a perfect hash index of the table names of the active table
+ * configuration, which allows \ref bcmltd_table_name_to_idx to resolve a
+ * name with a single string compare. Without an index (or if the table
+ * configuration changes) table names are resolved by binary search.
+ *
+ * \retval SHR_E_NONE     No errors.
+ * \retval SHR_E_MEMORY   Insufficient memory.
+ */
+extern int bcmltd_table_name_index_create(void);
+
+/*!
+ * \brief Destroy the table name index.
+ *
+ * \return Nothing.
+ */
+extern void bcmltd_table_name_index_destroy(void);
+
 
 #endif /* BCMLTD_TABLE_H */
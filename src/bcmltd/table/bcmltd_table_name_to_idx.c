@@ -90,15 +90,71 @@
  */
 
 #include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
 #include <shr/shr_error.h>
+#include <shr/shr_mph.h>
 #include <bcmltd/bcmltd_internal.h>
 #include <bcmltd/bcmltd_table.h>
 
+/*******************************************************************************
+ * Local definitions
+ */
+
+/* Table name index and the table configuration it was built for. */
+static shr_mph_t *name_index;
+static const bcmltd_table_conf_t *name_index_conf;
+
 /*******************************************************************************
  * Public functions
  */
 
-/* Binary search table to return index */
+int
+bcmltd_table_name_index_create(void)
+{
+    shr_mph_key_t *keys;
+    const bcmltd_table_rep_t *tbl;
+    uint32_t idx, num_keys = 0;
+    int rv;
+
+    if (name_index_conf == bcmltd_table_conf) {
+        return SHR_E_NONE;
+    }
+    bcmltd_table_name_index_destroy();
+    if (bcmltd_table_conf->tables == 0) {
+        return SHR_E_NONE;
+    }
+
+    keys = sal_alloc(sizeof(*keys) * bcmltd_table_conf->tables,
+                     "bcmltdNameIdx");
+    if (keys == NULL) {
+        return SHR_E_MEMORY;
+    }
+    sal_memset(keys, 0, sizeof(*keys) * bcmltd_table_conf->tables);
+    for (idx = 0; idx < bcmltd_table_conf->tables; idx++) {
+        tbl = bcmltd_table_get(idx);
+        if (tbl == NULL || tbl->name == NULL) {
+            continue;
+        }
+        keys[num_keys].str = tbl->name;
+        keys[num_keys++].val = idx;
+    }
+    rv = shr_mph_create(keys, num_keys, &name_index);
+    sal_free(keys);
+    if (SHR_SUCCESS(rv)) {
+        name_index_conf = bcmltd_table_conf;
+    }
+    return rv;
+}
+
+void
+bcmltd_table_name_index_destroy(void)
+{
+    shr_mph_destroy(name_index);
+    name_index = NULL;
+    name_index_conf = NULL;
+}
+
+/* Perfect hash lookup with binary search fallback to return index */
 int
 bcmltd_table_name_to_idx(const char *table_name)
 {
@@ -107,6 +163,17 @@ bcmltd_table_name_to_idx(const char *table_name)
     int idx = 0;
     int v = 0;
     const bcmltd_table_rep_t *tbl;
+    uint32_t sid;
+
+    /* The index is only valid for the configuration it was built for */
+    if (name_index_conf == bcmltd_table_conf &&
+        shr_mph_lookup(name_index, 0, table_name, &sid) == SHR_E_NONE) {
+        tbl = bcmltd_table_get(sid);
+        if (tbl && sal_strcmp(table_name, tbl->name) == 0) {
+            return (int)sid;
+        }
+        return SHR_E_NOT_FOUND;
+    }
 
     while (top >= bot) {
         idx = (bot+top)/2; /* pick midpoint */
@@ -121,6 +121,12 @@ typedef struct bcmltm_lt_op_md_s {
 
     /*! Size of the Working Buffer (in bytes) for this operation on this LT. */
     uint32_t working_buffer_size;
+
+    /*!
+     * Flat execution program compiled from the FA and EE trees,
+     * or NULL when the trees must be traversed.
+     */
+    struct bcmltm_op_prog_s *prog;
 } bcmltm_lt_op_md_t;
 
 /*!
@@ -1369,6 +1375,80 @@ typedef struct bcmltm_ee_node_s {
     void *node_cookie;
 } bcmltm_ee_node_t;
 
+/*!
+ * \brief Operation program step callback.
+ *
+ * FA and EE node functions share this signature, so a compiled
+ * operation program stores both kinds of node functions in the same
+ * step array.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] lt_md LTM information for this LT.
+ * \param [in,out] lt_state Runtime state for this LT.
+ * \param [in,out] lt_entry Specification of this LT operation.
+ * \param [in,out] ltm_buffer Pointer to Working Buffer for this op.
+ * \param [in] node_cookie Context data for the node function.
+ */
+typedef int (*bcmltm_op_step_f)(int unit,
+                                bcmltm_lt_md_t *lt_md,
+                                bcmltm_lt_state_t *lt_state,
+                                bcmltm_entry_t *lt_entry,
+                                uint32_t *ltm_buffer,
+                                void *node_cookie);
+
+/*!
+ * \brief Operation program step.
+ *
+ * A single FA or EE node lifted out of its binary tree.
+ */
+typedef struct bcmltm_op_step_s {
+    /*! The node function. */
+    bcmltm_op_step_f node_function;
+
+    /*! Context information for the node function. */
+    void *node_cookie;
+} bcmltm_op_step_t;
+
+/*!
+ * \brief Operation program segment.
+ *
+ * A run of consecutive steps which were compiled from one FA or EE
+ * tree root.  Segments are kept so that the per-stage latency
+ * accounting of the tree walk is preserved.
+ */
+typedef struct bcmltm_op_seg_s {
+    /*! TRUE if the steps belong to the EE stage, FALSE for FA. */
+    bool ee;
+
+    /*! Index of the first step of this segment. */
+    uint32_t start;
+
+    /*! Number of steps in this segment. */
+    uint32_t count;
+} bcmltm_op_seg_t;
+
+/*!
+ * \brief Operation program.
+ *
+ * The FA and EE trees of an operation lowered at metadata creation
+ * time into one linear array of steps, in the same order as the
+ * post-order tree traversal and the root interleaving of
+ * ltm_entry_operation (FA root 0, EE root 0, FA root 1, ...).
+ */
+typedef struct bcmltm_op_prog_s {
+    /*! Number of segments. */
+    uint32_t num_segs;
+
+    /*! Array of segments. */
+    bcmltm_op_seg_t *segs;
+
+    /*! Total number of steps. */
+    uint32_t num_steps;
+
+    /*! Array of steps. */
+    bcmltm_op_step_t *steps;
+} bcmltm_op_prog_t;
+
 /*
  * Working buffer layout for PT passthru
  */
@@ -1610,5 +1690,75 @@ extern int
 bcmltm_md_logical_retrieve(int unit,
                            bcmltm_md_t **ltm_md_ptr);
 
+/*!
+ * \brief Compile the operation program for given operation metadata.
+ *
+ * Lower the FA and EE trees of the given operation into a flat array
+ * of (function, cookie) steps and attach it to the operation metadata.
+ * The trees are left in place.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] op_md Operation metadata, may be NULL.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval !SHR_E_NONE Failure.
+ */
+extern int
+bcmltm_md_op_prog_create(int unit, bcmltm_lt_op_md_t *op_md);
+
+/*!
+ * \brief Destroy the operation program of given operation metadata.
+ *
+ * \param [in] op_md Operation metadata, may be NULL.
+ */
+extern void
+bcmltm_md_op_prog_destroy(bcmltm_lt_op_md_t *op_md);
+
+/*!
+ * \brief Execute one segment of an operation program.
+ *
+ * Run the steps of the segment in order, stopping at the first
+ * failing step.  This is equivalent to the FA or EE stage traversal
+ * of the tree root the segment was compiled from.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] prog Operation program.
+ * \param [in] seg Segment to execute.
+ * \param [in] lt_md LTM information for this LT.
+ * \param [in,out] lt_state Runtime state for this LT.
+ * \param [in,out] lt_entry Specification of this LT operation.
+ * \param [in,out] ltm_buffer Pointer to Working Buffer for this op.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval !SHR_E_NONE Failure returned by a step.
+ */
+extern int
+bcmltm_md_op_prog_seg_exec(int unit,
+                           const bcmltm_op_prog_t *prog,
+                           const bcmltm_op_seg_t *seg,
+                           bcmltm_lt_md_t *lt_md,
+                           bcmltm_lt_state_t *lt_state,
+                           bcmltm_entry_t *lt_entry,
+                           uint32_t *ltm_buffer);
+
+/*!
+ * \brief Compare tree traversal with compiled program execution.
+ *
+ * Build a synthetic FA tree of \c num_nodes counting nodes, compile it
+ * and run both the tree walk and the flat program \c loops times.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] num_nodes Number of tree nodes.
+ * \param [in] loops Number of executions of each variant.
+ * \param [out] tree_usecs Time spent in tree traversal.
+ * \param [out] prog_usecs Time spent in program execution.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_FAIL The two variants did not execute the same steps.
+ * \retval !SHR_E_NONE Failure.
+ */
+extern int
+bcmltm_md_op_prog_bench(int unit, uint32_t num_nodes, uint32_t loops,
+                        uint32_t *tree_usecs, uint32_t *prog_usecs);
 
 #endif /* BCMLTM_MD_INTERNAL_H */
@@ -94,8 +94,67 @@
 
 #include <bcmdrd_config.h>
 
+#include <sal/sal_types.h>
+#include <sal/sal_mutex.h>
+#include <bcmltd/bcmltd_lt_types.h>
+#include <bcmltd/chip/bcmltd_limits.h>
 #include <bcmltm/bcmltm_types.h>
 
+/*!
+ * \brief Number of linear sub-buckets per power of two in a latency
+ * histogram, as a power of two.
+ */
+#define BCMLTM_STATS_LAT_SUB_BITS       2
+
+/*!
+ * \brief Number of buckets in a latency histogram.
+ *
+ * Latencies below 4 usecs have a bucket each. Every power of two range
+ * above is split into 4 equal buckets, up to the full 32-bit range.
+ */
+#define BCMLTM_STATS_LAT_BUCKETS        124
+
+/*!
+ * \brief Log-linear latency histogram.
+ *
+ * Latencies are recorded in usecs. Each counter is updated atomically,
+ * but a histogram is not updated as a whole, so a snapshot taken during
+ * concurrent updates may be slightly inconsistent between counters.
+ */
+typedef struct bcmltm_stats_lat_s {
+    /*! Number of recorded latencies. */
+    uint32_t count;
+
+    /*! Largest recorded latency. */
+    uint32_t max;
+
+    /*! Sum of recorded latencies. */
+    uint64_t sum;
+
+    /*! Number of recorded latencies in each bucket. */
+    uint32_t bucket[BCMLTM_STATS_LAT_BUCKETS];
+} bcmltm_stats_lat_t;
+
+/*!
+ * \brief Timed stages of LT operation processing.
+ */
+typedef enum bcmltm_stats_stage_e {
+    /*! Field Adaptation stage of an entry operation. */
+    BCMLTM_STATS_STAGE_FA = 0,
+
+    /*! Execution Engine stage of an entry operation. */
+    BCMLTM_STATS_STAGE_EE = 1,
+
+    /*! Table Commit handlers of a transaction commit. */
+    BCMLTM_STATS_STAGE_TABLE_COMMIT = 2,
+
+    /*! PTM commit of a transaction, which hands the WAL over to the HW. */
+    BCMLTM_STATS_STAGE_PTM_COMMIT = 3,
+
+    /*! Total number of stages. */
+    BCMLTM_STATS_STAGE_COUNT
+} bcmltm_stats_stage_t;
+
 /*!
  * \brief Define format to retrieve statistics array of a LT
  *
@@ -132,6 +191,32 @@ typedef struct bcmltm_stats_mgmt_s {
      * the LT info for a given Logical Table.
      */
     bcmltm_stats_lt_get_f stats_lt_get_cb;
+
+    /*!
+     * Latency recording is enabled.
+     */
+    bool lat_enable;
+
+    /*!
+     * Lock to create the per-LT latency histograms.
+     */
+    sal_mutex_t lat_lock;
+
+    /*!
+     * Latency histograms of LT operations, indexed by
+     * (ltid * BCMLT_OPCODE_NUM + opcode). Created on first use.
+     */
+    bcmltm_stats_lat_t **lt_lat;
+
+    /*!
+     * Latency histograms of PT pass through operations, indexed by opcode.
+     */
+    bcmltm_stats_lat_t *pt_lat;
+
+    /*!
+     * Latency histograms of the processing stages, indexed by stage.
+     */
+    bcmltm_stats_lat_t *stage_lat;
 } bcmltm_stats_mgmt_t;
 
 /*!
@@ -184,4 +269,156 @@ extern void
 bcmltm_stats_increment(uint32_t *lt_stats,
                        uint32_t stat_field);
 
+/*!
+ * \brief Initialize latency statistics of a unit.
+ *
+ * Latency recording is enabled after initialization.
+ *
+ * \param [in] unit Logical device id.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_MEMORY Out of memory.
+ */
+extern int
+bcmltm_stats_lat_init(int unit);
+
+/*!
+ * \brief Free latency statistics of a unit.
+ *
+ * \param [in] unit Logical device id.
+ */
+extern void
+bcmltm_stats_lat_cleanup(int unit);
+
+/*!
+ * \brief Enable or disable latency recording.
+ *
+ * \param [in] unit Logical device id.
+ * \param [in] enable TRUE to enable latency recording.
+ */
+extern void
+bcmltm_stats_lat_enable_set(int unit, bool enable);
+
+/*!
+ * \brief Check if latency recording is enabled.
+ *
+ * \param [in] unit Logical device id.
+ *
+ * \retval TRUE Latency recording is enabled.
+ * \retval FALSE Latency recording is disabled or not initialized.
+ */
+extern bool
+bcmltm_stats_lat_enabled(int unit);
+
+/*!
+ * \brief Record the latency of one entry operation.
+ *
+ * \param [in] unit Logical device id.
+ * \param [in] pthru TRUE for a PT pass through operation.
+ * \param [in] sid Logical Table ID, ignored for PT pass through.
+ * \param [in] opcode LT or PT opcode.
+ * \param [in] usecs Latency of the operation.
+ */
+extern void
+bcmltm_stats_lat_op_record(int unit,
+                           bool pthru,
+                           uint32_t sid,
+                           uint32_t opcode,
+                           uint32_t usecs);
+
+/*!
+ * \brief Record the latency of one processing stage.
+ *
+ * \param [in] unit Logical device id.
+ * \param [in] stage Processing stage.
+ * \param [in] usecs Latency of the stage.
+ */
+extern void
+bcmltm_stats_lat_stage_record(int unit,
+                              bcmltm_stats_stage_t stage,
+                              uint32_t usecs);
+
+/*!
+ * \brief Get the latency histogram of a LT operation.
+ *
+ * \param [in] unit Logical device id.
+ * \param [in] ltid Logical Table ID.
+ * \param [in] opcode LT opcode.
+ * \param [out] lat Copy of the latency histogram.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_PARAM Invalid parameters.
+ * \retval SHR_E_NOT_FOUND No operation was recorded.
+ * \retval SHR_E_UNAVAIL Latency statistics are not initialized.
+ */
+extern int
+bcmltm_stats_lat_lt_get(int unit,
+                        uint32_t ltid,
+                        bcmlt_opcode_t opcode,
+                        bcmltm_stats_lat_t *lat);
+
+/*!
+ * \brief Get the latency histogram of PT pass through operations.
+ *
+ * \param [in] unit Logical device id.
+ * \param [in] opcode PT opcode.
+ * \param [out] lat Copy of the latency histogram.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_PARAM Invalid parameters.
+ * \retval SHR_E_UNAVAIL Latency statistics are not initialized.
+ */
+extern int
+bcmltm_stats_lat_pt_get(int unit,
+                        bcmlt_pt_opcode_t opcode,
+                        bcmltm_stats_lat_t *lat);
+
+/*!
+ * \brief Get the latency histogram of a processing stage.
+ *
+ * \param [in] unit Logical device id.
+ * \param [in] stage Processing stage.
+ * \param [out] lat Copy of the latency histogram.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval SHR_E_PARAM Invalid parameters.
+ * \retval SHR_E_UNAVAIL Latency statistics are not initialized.
+ */
+extern int
+bcmltm_stats_lat_stage_get(int unit,
+                           bcmltm_stats_stage_t stage,
+                           bcmltm_stats_lat_t *lat);
+
+/*!
+ * \brief Clear all latency histograms of a unit.
+ *
+ * \param [in] unit Logical device id.
+ */
+extern void
+bcmltm_stats_lat_clear(int unit);
+
+/*!
+ * \brief Get the smallest latency recorded in a histogram bucket.
+ *
+ * \param [in] bucket Bucket number.
+ *
+ * \return Smallest latency of the bucket in usecs.
+ */
+extern uint32_t
+bcmltm_stats_lat_bucket_min(uint32_t bucket);
+
+/*!
+ * \brief Get a latency percentile from a histogram.
+ *
+ * The result is the largest latency of the bucket containing the
+ * percentile, capped by the largest recorded latency.
+ *
+ * \param [in] lat Latency histogram.
+ * \param [in] pct Percentile, from 0 to 100.
+ *
+ * \return Latency percentile in usecs, 0 if the histogram is empty.
+ */
+extern uint32_t
+bcmltm_stats_lat_percentile(const bcmltm_stats_lat_t *lat, uint32_t pct);
+
 #endif /* BCMLTM_STATS_INTERNAL_H */
@@ -99,6 +99,8 @@
 #include <shr/shr_debug.h>
 #include <bsl/bsl.h>
 
+#include <sal/sal_time.h>
+
 #include <bcmbd/bcmbd.h>
 #include <bcmdrd/bcmdrd_pt.h>
 #include <bcmptm/bcmptm.h>
@@ -718,6 +720,8 @@ ltm_entry_operation(bcmltm_entry_t *ltm_entry)
     bcmltm_lt_state_t *lt_state = NULL;
     bcmltm_ha_ptr_t lt_state_hap;
     bcmltm_lt_op_md_t *op_md;
+    const bcmltm_op_prog_t *prog;
+    const bcmltm_op_seg_t *seg;
     uint32_t trix, opix;
     bcmltm_table_catg_t table_catg;
     bcmltm_field_stats_t op_stat, op_err_stat;
@@ -732,9 +736,19 @@ ltm_entry_operation(bcmltm_entry_t *ltm_entry)
     const char *table_catg_str = "";
     const char *table_name = "";
     const char *opcode_str = "";
+    bool lat_enable;
+    sal_usecs_t op_start = 0;
+    sal_usecs_t stage_start = 0;
+    uint32_t fa_usecs = 0;
+    uint32_t ee_usecs = 0;
 
     SHR_FUNC_ENTER(unit);
 
+    lat_enable = bcmltm_stats_lat_enabled(unit);
+    if (lat_enable) {
+        op_start = sal_time_usecs();
+    }
+
     /*
      * Determine metadata relevant to the selected table
      */
@@ -894,28 +908,67 @@ ltm_entry_operation(bcmltm_entry_t *ltm_entry)
     /* Clear Working Buffer */
     sal_memset(working_buffer, 0, op_md->working_buffer_size);
 
-    for (trix = 0; trix < op_md->num_roots; trix++) {
+    prog = op_md->prog;
+    for (trix = 0; (prog != NULL) && (trix < prog->num_segs); trix++) {
+        seg = &prog->segs[trix];
+        if (lat_enable) {
+            stage_start = sal_time_usecs();
+        }
+        SHR_IF_ERR_VERBOSE_EXIT
+            (bcmltm_md_op_prog_seg_exec(unit, prog, seg,
+                                        lt_md,
+                                        lt_state,
+                                        ltm_entry,
+                                        working_buffer));
+        if (lat_enable) {
+            if (seg->ee) {
+                ee_usecs += sal_time_usecs() - stage_start;
+            } else {
+                fa_usecs += sal_time_usecs() - stage_start;
+            }
+        }
+    }
+
+    /* Walk the trees of operations without a compiled program */
+    for (trix = 0; (prog == NULL) && (trix < op_md->num_roots); trix++) {
         /* Field Adaptation stage */
         if (op_md->fa_node_roots[trix] != NULL) {
+            if (lat_enable) {
+                stage_start = sal_time_usecs();
+            }
             SHR_IF_ERR_VERBOSE_EXIT
                 (bcmltm_fa_stage(unit, op_md->fa_node_roots[trix],
                                  lt_md,
                                  lt_state,
                                  ltm_entry,
                                  working_buffer));
+            if (lat_enable) {
+                fa_usecs += sal_time_usecs() - stage_start;
+            }
         }
 
         /* Execution Engine stage */
         if (op_md->ee_node_roots[trix] != NULL) {
+            if (lat_enable) {
+                stage_start = sal_time_usecs();
+            }
             SHR_IF_ERR_VERBOSE_EXIT
                 (bcmltm_ee_stage(unit, op_md->ee_node_roots[trix],
                                  lt_md,
                                  lt_state,
                                  ltm_entry,
                                  working_buffer));
+            if (lat_enable) {
+                ee_usecs += sal_time_usecs() - stage_start;
+            }
         }
     }
 
+    if (lat_enable) {
+        bcmltm_stats_lat_stage_record(unit, BCMLTM_STATS_STAGE_FA, fa_usecs);
+        bcmltm_stats_lat_stage_record(unit, BCMLTM_STATS_STAGE_EE, ee_usecs);
+    }
+
  exit:
     if (lt_md != NULL) {
         lt_stats = BCMLTM_STATS_ARRAY(lt_md);
@@ -960,6 +1013,13 @@ ltm_entry_operation(bcmltm_entry_t *ltm_entry)
             bcmltm_stats_increment(lt_stats,
                                    BCMLRD_FIELD_LT_ERROR_COUNT);
         }
+
+        if (lat_enable) {
+            bcmltm_stats_lat_op_record(unit,
+                                   (table_catg == BCMLTM_TABLE_CATG_PTHRU),
+                                   table_id, opix,
+                                   sal_time_usecs() - op_start);
+        }
     }
 
     /*
@@ -1103,6 +1163,9 @@ bcmltm_init(int unit, bool warm)
     /* Initialize transaction management and state rollback buffers */
     SHR_IF_ERR_EXIT(bcmltm_transaction_init(unit));
 
+    /* Initialize LT operation latency statistics */
+    SHR_IF_ERR_EXIT(bcmltm_stats_lat_init(unit));
+
     /* Register LTM internal callbacks. */
     bcmltm_stats_lt_get_register(unit, bcmltm_internal_stats_lt_get);
     bcmltm_state_lt_get_register(unit, bcmltm_internal_state_lt_get);
@@ -1123,6 +1186,9 @@ bcmltm_cleanup(int unit)
 
     /* Cleanup of state data is not needed */
 
+    /* Cleanup LT operation latency statistics */
+    bcmltm_stats_lat_cleanup(unit);
+
     /* Cleanup transaction management and state rollback buffers */
     bcmltm_transaction_cleanup(unit);
 
@@ -1269,13 +1335,21 @@ bcmltm_commit(int unit,
     uint32_t ltid, ltix;
     uint32_t rsp_flags;
     const bcmltd_table_handler_t *cth_handler = NULL;
+    bool lat_enable;
+    sal_usecs_t stage_start = 0;
 
     SHR_FUNC_ENTER(unit);
 
+    lat_enable = bcmltm_stats_lat_enabled(unit);
+
     if (trans_id == LTM_TRANS_STATUS(unit)->trans_id) {
         trans_status = LTM_TRANS_STATUS(unit);
         /* In process transaction matches transaction ID, clean up state */
 
+        if (lat_enable) {
+            stage_start = sal_time_usecs();
+        }
+
         for (ltix = 0; ltix < trans_status->lt_num; ltix++) {
             ltid = trans_status->ltid_list[ltix];
 
@@ -1317,6 +1391,16 @@ bcmltm_commit(int unit,
 
         /* Clear transaction record */
         bcmltm_transaction_clear(unit);
+
+        if (lat_enable) {
+            bcmltm_stats_lat_stage_record(unit,
+                                          BCMLTM_STATS_STAGE_TABLE_COMMIT,
+                                          sal_time_usecs() - stage_start);
+        }
+    }
+
+    if (lat_enable) {
+        stage_start = sal_time_usecs();
     }
 
     /* Whether we found the record or not, we must pass this
@@ -1339,6 +1423,11 @@ bcmltm_commit(int unit,
                                 NULL,
                                 &rsp_flags));
 
+    if (lat_enable) {
+        bcmltm_stats_lat_stage_record(unit, BCMLTM_STATS_STAGE_PTM_COMMIT,
+                                      sal_time_usecs() - stage_start);
+    }
+
 exit:
 
     /*
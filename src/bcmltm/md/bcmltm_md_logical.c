@@ -1250,6 +1250,10 @@ logical_lt_create(int unit,
         SHR_IF_ERR_EXIT
             (logical_op_md_create(unit, sid, lt_drv, opcode, &op_md));
         lt_md->op[opcode] = op_md;
+
+        /* Lower FA and EE trees into a flat step program */
+        SHR_IF_ERR_EXIT
+            (bcmltm_md_op_prog_create(unit, op_md));
     }
 
     /* Set Table Commit handler list */
@@ -327,7 +327,8 @@ bcmltm_md_op_destroy(bcmltm_lt_op_md_t *op_md)
         return;
     }
 
-    /* Destroy EE and FA trees */
+    /* Destroy compiled program and the EE and FA trees */
+    bcmltm_md_op_prog_destroy(op_md);
     bcmltm_md_ee_node_roots_destroy(op_md->num_roots, op_md->ee_node_roots);
     bcmltm_md_fa_node_roots_destroy(op_md->num_roots, op_md->fa_node_roots);
 
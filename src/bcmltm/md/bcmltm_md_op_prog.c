@@ -0,0 +1,477 @@
+/*! \file bcmltm_md_op_prog.c
+ *
+ * Logical Table Manager - Operation Programs.
+ *
+ * Lowering of the FA and EE binary trees of an operation into
+ * a flat array of node steps.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <shr/shr_types.h>
+#include <shr/shr_debug.h>
+
+#include <sal/sal_libc.h>
+#include <sal/sal_time.h>
+
+#include <bsl/bsl.h>
+
+#include <bcmltm/lt_types.h>
+#include <bcmltm/bcmltm_tree.h>
+#include <bcmltm/bcmltm_fa_tree_nodes_internal.h>
+#include <bcmltm/bcmltm_md_internal.h>
+
+#include "bcmltm_md_op.h"
+
+
+/*******************************************************************************
+ * Local definitions
+ */
+
+/* Debug log target definition */
+#define BSL_LOG_MODULE BSL_LS_BCMLTM_METADATA
+
+/*******************************************************************************
+ * Private functions
+ */
+
+/*!
+ * \brief Count the nodes of a tree which carry node data.
+ *
+ * \param [in] node Tree root, may be NULL.
+ *
+ * \retval Number of executable nodes.
+ */
+static uint32_t
+prog_tree_count(bcmltm_node_t *node)
+{
+    if (node == NULL) {
+        return 0;
+    }
+
+    return prog_tree_count(node->left) + prog_tree_count(node->right) +
+        ((node->node_data != NULL) ? 1 : 0);
+}
+
+
+/*!
+ * \brief Append the nodes of a tree to a step array.
+ *
+ * The nodes are emitted in the same post-order as
+ * bcmltm_tree_traverse() visits them.
+ *
+ * \param [in] node Tree root, may be NULL.
+ * \param [in] ee TRUE for an EE tree, FALSE for an FA tree.
+ * \param [out] steps Step array.
+ * \param [in,out] idx Next free step index.
+ */
+static void
+prog_tree_flatten(bcmltm_node_t *node, bool ee,
+                  bcmltm_op_step_t *steps, uint32_t *idx)
+{
+    bcmltm_fa_node_t *fa_node;
+    bcmltm_ee_node_t *ee_node;
+
+    if (node == NULL) {
+        return;
+    }
+
+    prog_tree_flatten(node->left, ee, steps, idx);
+    prog_tree_flatten(node->right, ee, steps, idx);
+
+    if (node->node_data == NULL) {
+        return;
+    }
+
+    if (ee) {
+        ee_node = (bcmltm_ee_node_t *)node->node_data;
+        steps[*idx].node_function = ee_node->node_function;
+        steps[*idx].node_cookie = ee_node->node_cookie;
+    } else {
+        fa_node = (bcmltm_fa_node_t *)node->node_data;
+        steps[*idx].node_function = fa_node->node_function;
+        steps[*idx].node_cookie = fa_node->node_cookie;
+    }
+    (*idx)++;
+}
+
+
+/*!
+ * \brief Add the segment of one tree root to a program.
+ *
+ * \param [in] prog Program being built.
+ * \param [in] root Tree root, may be NULL.
+ * \param [in] ee TRUE for an EE tree, FALSE for an FA tree.
+ */
+static void
+prog_seg_add(bcmltm_op_prog_t *prog, bcmltm_node_t *root, bool ee)
+{
+    bcmltm_op_seg_t *seg;
+    uint32_t idx = prog->num_steps;
+
+    if (root == NULL) {
+        return;
+    }
+
+    seg = &prog->segs[prog->num_segs++];
+    seg->ee = ee;
+    seg->start = idx;
+    prog_tree_flatten(root, ee, prog->steps, &idx);
+    seg->count = idx - seg->start;
+    prog->num_steps = idx;
+}
+
+
+/*!
+ * \brief FA node function of the benchmark tree.
+ *
+ * Count the number of invocations in the node cookie.
+ */
+static int
+prog_bench_node(int unit,
+                bcmltm_lt_md_t *lt_md,
+                bcmltm_lt_state_t *lt_state,
+                bcmltm_entry_t *lt_entry,
+                uint32_t *ltm_buffer,
+                void *node_cookie)
+{
+    (*(uint32_t *)node_cookie)++;
+
+    return SHR_E_NONE;
+}
+
+
+/*!
+ * \brief Attach a balanced subtree of benchmark nodes.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] parent Parent node.
+ * \param [in] count Number of nodes to attach below the parent.
+ * \param [in] counter Invocation counter used as node cookie.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval !SHR_E_NONE Failure.
+ */
+static int
+prog_bench_subtree(int unit, bcmltm_node_t *parent, uint32_t count,
+                   uint32_t *counter)
+{
+    bcmltm_fa_node_t *fa_node = NULL;
+    bcmltm_node_t *node;
+    uint32_t left = count / 2;
+    uint32_t right = count - left;
+
+    SHR_FUNC_ENTER(unit);
+
+    if (left > 0) {
+        SHR_IF_ERR_EXIT
+            (bcmltm_md_fa_node_data_create(unit, prog_bench_node, counter,
+                                           &fa_node));
+        node = bcmltm_tree_left_node_create(parent, fa_node);
+        if (node == NULL) {
+            bcmltm_md_fa_node_data_destroy(fa_node);
+            SHR_RETURN_VAL_EXIT(SHR_E_MEMORY);
+        }
+        SHR_IF_ERR_EXIT
+            (prog_bench_subtree(unit, node, left - 1, counter));
+    }
+
+    if (right > 0) {
+        SHR_IF_ERR_EXIT
+            (bcmltm_md_fa_node_data_create(unit, prog_bench_node, counter,
+                                           &fa_node));
+        node = bcmltm_tree_right_node_create(parent, fa_node);
+        if (node == NULL) {
+            bcmltm_md_fa_node_data_destroy(fa_node);
+            SHR_RETURN_VAL_EXIT(SHR_E_MEMORY);
+        }
+        SHR_IF_ERR_EXIT
+            (prog_bench_subtree(unit, node, right - 1, counter));
+    }
+
+ exit:
+    SHR_FUNC_EXIT();
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+bcmltm_md_op_prog_create(int unit, bcmltm_lt_op_md_t *op_md)
+{
+    bcmltm_op_prog_t *prog = NULL;
+    uint32_t trix;
+    uint32_t num_segs = 0;
+    uint32_t num_steps = 0;
+
+    SHR_FUNC_ENTER(unit);
+
+    if (op_md == NULL) {
+        SHR_EXIT();
+    }
+
+    bcmltm_md_op_prog_destroy(op_md);
+
+    for (trix = 0; trix < op_md->num_roots; trix++) {
+        if (op_md->fa_node_roots[trix] != NULL) {
+            num_segs++;
+            num_steps += prog_tree_count(op_md->fa_node_roots[trix]);
+        }
+        if (op_md->ee_node_roots[trix] != NULL) {
+            num_segs++;
+            num_steps += prog_tree_count(op_md->ee_node_roots[trix]);
+        }
+    }
+
+    SHR_ALLOC(prog, sizeof(*prog), "LTM operation program");
+    SHR_NULL_CHECK(prog, SHR_E_MEMORY);
+    sal_memset(prog, 0, sizeof(*prog));
+
+    if (num_segs > 0) {
+        SHR_ALLOC(prog->segs, sizeof(*prog->segs) * num_segs,
+                  "LTM operation program segments");
+        SHR_NULL_CHECK(prog->segs, SHR_E_MEMORY);
+    }
+    if (num_steps > 0) {
+        SHR_ALLOC(prog->steps, sizeof(*prog->steps) * num_steps,
+                  "LTM operation program steps");
+        SHR_NULL_CHECK(prog->steps, SHR_E_MEMORY);
+    }
+
+    /* Keep the FA/EE interleaving of the tree walk */
+    for (trix = 0; trix < op_md->num_roots; trix++) {
+        prog_seg_add(prog, op_md->fa_node_roots[trix], FALSE);
+        prog_seg_add(prog, op_md->ee_node_roots[trix], TRUE);
+    }
+
+    op_md->prog = prog;
+
+ exit:
+    if (SHR_FUNC_ERR() && (prog != NULL)) {
+        SHR_FREE(prog->segs);
+        SHR_FREE(prog->steps);
+        SHR_FREE(prog);
+    }
+    SHR_FUNC_EXIT();
+}
+
+
+void
+bcmltm_md_op_prog_destroy(bcmltm_lt_op_md_t *op_md)
+{
+    bcmltm_op_prog_t *prog;
+
+    if ((op_md == NULL) || (op_md->prog == NULL)) {
+        return;
+    }
+
+    prog = op_md->prog;
+    SHR_FREE(prog->segs);
+    SHR_FREE(prog->steps);
+    SHR_FREE(prog);
+    op_md->prog = NULL;
+
+    return;
+}
+
+
+int
+bcmltm_md_op_prog_seg_exec(int unit,
+                           const bcmltm_op_prog_t *prog,
+                           const bcmltm_op_seg_t *seg,
+                           bcmltm_lt_md_t *lt_md,
+                           bcmltm_lt_state_t *lt_state,
+                           bcmltm_entry_t *lt_entry,
+                           uint32_t *ltm_buffer)
+{
+    const bcmltm_op_step_t *step = &prog->steps[seg->start];
+    const bcmltm_op_step_t *end = step + seg->count;
+    int rv;
+
+    for (; step < end; step++) {
+        rv = step->node_function(unit, lt_md, lt_state, lt_entry,
+                                 ltm_buffer, step->node_cookie);
+        if (SHR_FAILURE(rv)) {
+            return rv;
+        }
+    }
+
+    return SHR_E_NONE;
+}
+
+
+int
+bcmltm_md_op_prog_bench(int unit, uint32_t num_nodes, uint32_t loops,
+                        uint32_t *tree_usecs, uint32_t *prog_usecs)
+{
+    bcmltm_lt_op_md_t *op_md = NULL;
+    bcmltm_fa_node_t *fa_node = NULL;
+    bcmltm_node_t *root;
+    uint32_t tree_count = 0;
+    uint32_t prog_count = 0;
+    uint32_t loop;
+    sal_usecs_t start;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_NULL_CHECK(tree_usecs, SHR_E_PARAM);
+    SHR_NULL_CHECK(prog_usecs, SHR_E_PARAM);
+    if (num_nodes == 0) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+
+    SHR_ALLOC(op_md, sizeof(*op_md), "LTM operation program bench");
+    SHR_NULL_CHECK(op_md, SHR_E_MEMORY);
+    sal_memset(op_md, 0, sizeof(*op_md));
+
+    SHR_ALLOC(op_md->fa_node_roots, sizeof(bcmltm_node_t *),
+              "LTM operation program bench roots");
+    SHR_NULL_CHECK(op_md->fa_node_roots, SHR_E_MEMORY);
+    op_md->fa_node_roots[0] = NULL;
+    op_md->num_roots = 1;
+
+    /* The benchmark tree counts its node invocations in tree_count */
+    SHR_IF_ERR_EXIT
+        (bcmltm_md_fa_node_data_create(unit, prog_bench_node, &tree_count,
+                                       &fa_node));
+    root = bcmltm_tree_node_create(fa_node);
+    if (root == NULL) {
+        bcmltm_md_fa_node_data_destroy(fa_node);
+        SHR_RETURN_VAL_EXIT(SHR_E_MEMORY);
+    }
+    op_md->fa_node_roots[0] = root;
+    SHR_IF_ERR_EXIT
+        (prog_bench_subtree(unit, root, num_nodes - 1, &tree_count));
+
+    /*
+     * The EE roots array is not needed by the benchmark; point the
+     * program compiler at an array of NULL roots.
+     */
+    SHR_ALLOC(op_md->ee_node_roots, sizeof(bcmltm_node_t *),
+              "LTM operation program bench roots");
+    SHR_NULL_CHECK(op_md->ee_node_roots, SHR_E_MEMORY);
+    op_md->ee_node_roots[0] = NULL;
+
+    SHR_IF_ERR_EXIT(bcmltm_md_op_prog_create(unit, op_md));
+
+    start = sal_time_usecs();
+    for (loop = 0; loop < loops; loop++) {
+        SHR_IF_ERR_EXIT
+            (bcmltm_fa_stage(unit, root, NULL, NULL, NULL, NULL));
+    }
+    *tree_usecs = sal_time_usecs() - start;
+
+    /* Redirect the compiled steps to a separate counter */
+    for (loop = 0; loop < op_md->prog->num_steps; loop++) {
+        op_md->prog->steps[loop].node_cookie = &prog_count;
+    }
+
+    start = sal_time_usecs();
+    for (loop = 0; loop < loops; loop++) {
+        SHR_IF_ERR_EXIT
+            (bcmltm_md_op_prog_seg_exec(unit, op_md->prog,
+                                        &op_md->prog->segs[0],
+                                        NULL, NULL, NULL, NULL));
+    }
+    *prog_usecs = sal_time_usecs() - start;
+
+    if (tree_count != prog_count ||
+        op_md->prog->num_steps != num_nodes) {
+        LOG_ERROR(BSL_LOG_MODULE,
+                  (BSL_META_U(unit,
+                              "Operation program mismatch: "
+                              "tree=%u program=%u steps=%u\n"),
+                   tree_count, prog_count, op_md->prog->num_steps));
+        SHR_RETURN_VAL_EXIT(SHR_E_FAIL);
+    }
+
+ exit:
+    bcmltm_md_op_destroy(op_md);
+    SHR_FUNC_EXIT();
+}
@@ -93,6 +93,8 @@
  */
 
 #include <shr/shr_debug.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_libc.h>
 #include <bcmltm/bcmltm_stats_internal.h>
 #include <bsl/bsl.h>
 
@@ -101,8 +103,11 @@
  * Local definitions
  */
 
-/* Debug log target definition */
-#define BSL_LOG_MODULE BSL_LS_BCMLTM_STATS
+/*
+ * Debug log target definition. The BSL has no statistics source for the
+ * LTM, so statistics are logged with the entry operations they count.
+ */
+#define BSL_LOG_MODULE BSL_LS_BCMLTM_ENTRY
 
 static bcmltm_stats_mgmt_t lt_stats_mgmt[BCMDRD_CONFIG_MAX_UNITS];
 
@@ -114,10 +119,124 @@ static bcmltm_stats_mgmt_t lt_stats_mgmt[BCMDRD_CONFIG_MAX_UNITS];
 
 #define LT_STATS_GET_CB(_u)       (LT_STATS_MGMT(_u).stats_lt_get_cb)
 
+#define LT_LAT_ENABLE(_u)         (LT_STATS_MGMT(_u).lat_enable)
+#define LT_LAT_LOCK(_u)           (LT_STATS_MGMT(_u).lat_lock)
+#define LT_LAT_LT(_u)             (LT_STATS_MGMT(_u).lt_lat)
+#define LT_LAT_PT(_u)             (LT_STATS_MGMT(_u).pt_lat)
+#define LT_LAT_STAGE(_u)          (LT_STATS_MGMT(_u).stage_lat)
+
+/* Number of per-LT latency histogram slots. */
+#define LT_LAT_LT_COUNT           (BCMLTD_TABLE_COUNT * BCMLT_OPCODE_NUM)
+
+/* Atomic access helpers */
+#define ATOMIC_LOAD(_p)           __atomic_load_n(_p, __ATOMIC_RELAXED)
+#define ATOMIC_ADD(_p, _v)        __atomic_fetch_add(_p, _v, __ATOMIC_RELAXED)
+#define ATOMIC_CAS(_p, _e, _v) \
+    __atomic_compare_exchange_n(_p, _e, _v, true, \
+                                __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+
 /*******************************************************************************
  * Private functions
  */
 
+/*!
+ * \brief Get the histogram bucket of a latency.
+ *
+ * \param [in] usecs Latency in usecs.
+ *
+ * \return Bucket number.
+ */
+static inline uint32_t
+stats_lat_bucket(uint32_t usecs)
+{
+    uint32_t msb = 0;
+    uint32_t v = usecs;
+
+    if (usecs < (1 << BCMLTM_STATS_LAT_SUB_BITS)) {
+        return usecs;
+    }
+
+    if (v & 0xffff0000) {
+        msb += 16;
+        v >>= 16;
+    }
+    if (v & 0xff00) {
+        msb += 8;
+        v >>= 8;
+    }
+    if (v & 0xf0) {
+        msb += 4;
+        v >>= 4;
+    }
+    if (v & 0xc) {
+        msb += 2;
+        v >>= 2;
+    }
+    if (v & 0x2) {
+        msb += 1;
+    }
+
+    return ((msb - BCMLTM_STATS_LAT_SUB_BITS + 1)
+            << BCMLTM_STATS_LAT_SUB_BITS) |
+           ((usecs >> (msb - BCMLTM_STATS_LAT_SUB_BITS)) &
+            ((1 << BCMLTM_STATS_LAT_SUB_BITS) - 1));
+}
+
+/*!
+ * \brief Add one latency to a histogram.
+ *
+ * \param [in] lat Latency histogram.
+ * \param [in] usecs Latency in usecs.
+ */
+static inline void
+stats_lat_add(bcmltm_stats_lat_t *lat, uint32_t usecs)
+{
+    uint32_t max;
+
+    /*
+     * Operations on different transactions record concurrently, so every
+     * counter is updated atomically. The counters of a histogram are not
+     * updated together, so a reader may see a count that is one or two
+     * operations ahead of the buckets.
+     */
+    ATOMIC_ADD(&lat->count, 1);
+    ATOMIC_ADD(&lat->sum, usecs);
+    max = ATOMIC_LOAD(&lat->max);
+    while (usecs > max && !ATOMIC_CAS(&lat->max, &max, usecs)) {
+        /* max has been reloaded by the failed exchange. */
+    }
+    ATOMIC_ADD(&lat->bucket[stats_lat_bucket(usecs)], 1);
+}
+
+/*!
+ * \brief Get the histogram of a LT operation, creating it if needed.
+ *
+ * \param [in] unit Logical device id.
+ * \param [in] slot Histogram slot of the LT operation.
+ *
+ * \return Pointer to histogram, or NULL if it can not be created.
+ */
+static bcmltm_stats_lat_t *
+stats_lat_lt_create(int unit, uint32_t slot)
+{
+    bcmltm_stats_lat_t *lat;
+
+    sal_mutex_take(LT_LAT_LOCK(unit), SAL_MUTEX_FOREVER);
+
+    lat = LT_LAT_LT(unit)[slot];
+    if (lat == NULL) {
+        lat = sal_alloc(sizeof(*lat), "bcmltmStatsLtLat");
+        if (lat != NULL) {
+            sal_memset(lat, 0, sizeof(*lat));
+            LT_LAT_LT(unit)[slot] = lat;
+        }
+    }
+
+    sal_mutex_give(LT_LAT_LOCK(unit));
+
+    return lat;
+}
+
 /*******************************************************************************
  * Public functions
  */
@@ -159,3 +278,272 @@ bcmltm_stats_lt_get(int unit,
 
     return LT_STATS_GET_CB(unit)(unit, ltid, lt_stats_p);
 }
+
+int
+bcmltm_stats_lat_init(int unit)
+{
+    size_t size;
+
+    SHR_FUNC_ENTER(unit);
+
+    if (LT_LAT_LT(unit) != NULL) {
+        /* Already initialized */
+        SHR_EXIT();
+    }
+
+    LT_LAT_LOCK(unit) = sal_mutex_create("bcmltmStatsLatLock");
+    SHR_NULL_CHECK(LT_LAT_LOCK(unit), SHR_E_MEMORY);
+
+    size = sizeof(bcmltm_stats_lat_t *) * LT_LAT_LT_COUNT;
+    SHR_ALLOC(LT_LAT_LT(unit), size, "bcmltmStatsLtLatList");
+    SHR_NULL_CHECK(LT_LAT_LT(unit), SHR_E_MEMORY);
+    sal_memset(LT_LAT_LT(unit), 0, size);
+
+    size = sizeof(bcmltm_stats_lat_t) * BCMLT_PT_OPCODE_NUM;
+    SHR_ALLOC(LT_LAT_PT(unit), size, "bcmltmStatsPtLat");
+    SHR_NULL_CHECK(LT_LAT_PT(unit), SHR_E_MEMORY);
+    sal_memset(LT_LAT_PT(unit), 0, size);
+
+    size = sizeof(bcmltm_stats_lat_t) * BCMLTM_STATS_STAGE_COUNT;
+    SHR_ALLOC(LT_LAT_STAGE(unit), size, "bcmltmStatsStageLat");
+    SHR_NULL_CHECK(LT_LAT_STAGE(unit), SHR_E_MEMORY);
+    sal_memset(LT_LAT_STAGE(unit), 0, size);
+
+    LT_LAT_ENABLE(unit) = TRUE;
+
+ exit:
+    if (SHR_FUNC_ERR()) {
+        bcmltm_stats_lat_cleanup(unit);
+    }
+    SHR_FUNC_EXIT();
+}
+
+void
+bcmltm_stats_lat_cleanup(int unit)
+{
+    uint32_t slot;
+
+    LT_LAT_ENABLE(unit) = FALSE;
+
+    if (LT_LAT_LT(unit) != NULL) {
+        for (slot = 0; slot < LT_LAT_LT_COUNT; slot++) {
+            SHR_FREE(LT_LAT_LT(unit)[slot]);
+        }
+    }
+    SHR_FREE(LT_LAT_LT(unit));
+    SHR_FREE(LT_LAT_PT(unit));
+    SHR_FREE(LT_LAT_STAGE(unit));
+
+    if (LT_LAT_LOCK(unit) != NULL) {
+        sal_mutex_destroy(LT_LAT_LOCK(unit));
+        LT_LAT_LOCK(unit) = NULL;
+    }
+}
+
+void
+bcmltm_stats_lat_enable_set(int unit, bool enable)
+{
+    if (LT_LAT_LT(unit) == NULL) {
+        /* Not initialized */
+        return;
+    }
+
+    LT_LAT_ENABLE(unit) = enable;
+}
+
+bool
+bcmltm_stats_lat_enabled(int unit)
+{
+    return LT_LAT_ENABLE(unit);
+}
+
+void
+bcmltm_stats_lat_op_record(int unit,
+                           bool pthru,
+                           uint32_t sid,
+                           uint32_t opcode,
+                           uint32_t usecs)
+{
+    bcmltm_stats_lat_t *lat;
+    uint32_t slot;
+
+    if (!LT_LAT_ENABLE(unit)) {
+        return;
+    }
+
+    if (pthru) {
+        if (opcode < BCMLT_PT_OPCODE_NUM) {
+            stats_lat_add(&LT_LAT_PT(unit)[opcode], usecs);
+        }
+        return;
+    }
+
+    if ((sid >= BCMLTD_TABLE_COUNT) || (opcode >= BCMLT_OPCODE_NUM)) {
+        return;
+    }
+
+    slot = sid * BCMLT_OPCODE_NUM + opcode;
+    lat = LT_LAT_LT(unit)[slot];
+    if (lat == NULL) {
+        lat = stats_lat_lt_create(unit, slot);
+        if (lat == NULL) {
+            return;
+        }
+    }
+    stats_lat_add(lat, usecs);
+}
+
+void
+bcmltm_stats_lat_stage_record(int unit,
+                              bcmltm_stats_stage_t stage,
+                              uint32_t usecs)
+{
+    if (!LT_LAT_ENABLE(unit) || (stage >= BCMLTM_STATS_STAGE_COUNT)) {
+        return;
+    }
+
+    stats_lat_add(&LT_LAT_STAGE(unit)[stage], usecs);
+}
+
+int
+bcmltm_stats_lat_lt_get(int unit,
+                        uint32_t ltid,
+                        bcmlt_opcode_t opcode,
+                        bcmltm_stats_lat_t *lat)
+{
+    bcmltm_stats_lat_t *lt_lat;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_NULL_CHECK(lat, SHR_E_PARAM);
+    if ((ltid >= BCMLTD_TABLE_COUNT) || (opcode >= BCMLT_OPCODE_NUM)) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    if (LT_LAT_LT(unit) == NULL) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
+    }
+
+    lt_lat = LT_LAT_LT(unit)[ltid * BCMLT_OPCODE_NUM + opcode];
+    if (lt_lat == NULL) {
+        SHR_RETURN_VAL_EXIT(SHR_E_NOT_FOUND);
+    }
+    sal_memcpy(lat, lt_lat, sizeof(*lat));
+
+ exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmltm_stats_lat_pt_get(int unit,
+                        bcmlt_pt_opcode_t opcode,
+                        bcmltm_stats_lat_t *lat)
+{
+    SHR_FUNC_ENTER(unit);
+
+    SHR_NULL_CHECK(lat, SHR_E_PARAM);
+    if (opcode >= BCMLT_PT_OPCODE_NUM) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    if (LT_LAT_PT(unit) == NULL) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
+    }
+
+    sal_memcpy(lat, &LT_LAT_PT(unit)[opcode], sizeof(*lat));
+
+ exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmltm_stats_lat_stage_get(int unit,
+                           bcmltm_stats_stage_t stage,
+                           bcmltm_stats_lat_t *lat)
+{
+    SHR_FUNC_ENTER(unit);
+
+    SHR_NULL_CHECK(lat, SHR_E_PARAM);
+    if (stage >= BCMLTM_STATS_STAGE_COUNT) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    if (LT_LAT_STAGE(unit) == NULL) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
+    }
+
+    sal_memcpy(lat, &LT_LAT_STAGE(unit)[stage], sizeof(*lat));
+
+ exit:
+    SHR_FUNC_EXIT();
+}
+
+void
+bcmltm_stats_lat_clear(int unit)
+{
+    uint32_t slot;
+
+    if (LT_LAT_LT(unit) == NULL) {
+        /* Not initialized */
+        return;
+    }
+
+    for (slot = 0; slot < LT_LAT_LT_COUNT; slot++) {
+        if (LT_LAT_LT(unit)[slot] != NULL) {
+            sal_memset(LT_LAT_LT(unit)[slot], 0, sizeof(bcmltm_stats_lat_t));
+        }
+    }
+    sal_memset(LT_LAT_PT(unit), 0,
+               sizeof(bcmltm_stats_lat_t) * BCMLT_PT_OPCODE_NUM);
+    sal_memset(LT_LAT_STAGE(unit), 0,
+               sizeof(bcmltm_stats_lat_t) * BCMLTM_STATS_STAGE_COUNT);
+}
+
+uint32_t
+bcmltm_stats_lat_bucket_min(uint32_t bucket)
+{
+    uint32_t shift;
+    uint32_t sub;
+
+    if (bucket < (1 << BCMLTM_STATS_LAT_SUB_BITS)) {
+        return bucket;
+    }
+
+    shift = (bucket >> BCMLTM_STATS_LAT_SUB_BITS) - 1;
+    sub = bucket & ((1 << BCMLTM_STATS_LAT_SUB_BITS) - 1);
+
+    return ((1 << BCMLTM_STATS_LAT_SUB_BITS) | sub) << shift;
+}
+
+uint32_t
+bcmltm_stats_lat_percentile(const bcmltm_stats_lat_t *lat, uint32_t pct)
+{
+    uint64_t target;
+    uint64_t cum = 0;
+    uint32_t bucket;
+    uint32_t usecs;
+
+    if ((lat == NULL) || (lat->count == 0)) {
+        return 0;
+    }
+    if (pct > 100) {
+        pct = 100;
+    }
+
+    /* Rank of the percentile, rounded up and at least 1. */
+    target = ((uint64_t)lat->count * pct + 99) / 100;
+    if (target == 0) {
+        target = 1;
+    }
+
+    for (bucket = 0; bucket < BCMLTM_STATS_LAT_BUCKETS; bucket++) {
+        cum += lat->bucket[bucket];
+        if (cum >= target) {
+            break;
+        }
+    }
+    if (bucket >= BCMLTM_STATS_LAT_BUCKETS - 1) {
+        return lat->max;
+    }
+
+    usecs = bcmltm_stats_lat_bucket_min(bucket + 1) - 1;
+
+    return (usecs < lat->max) ? usecs : lat->max;
+}
@@ -441,6 +441,10 @@ bcmpkt_packet_claim(int unit, bcmpkt_packet_t *pkt, bcmpkt_packet_t **new_pkt)
     /* Copy packet structure information and metadata. */
     bcmpkt_pmd_format(npkt);
     sal_memcpy(npkt->pmd.data, pkt->pmd.data, sizeof(npkt->pmd.data));
+    if (pkt->pmd.rxpmd != NULL && pkt->pmd.rxpmd != pkt->pmd.data) {
+        /* RXPMD of a received packet may live in its data buffer. */
+        sal_memcpy(npkt->pmd.rxpmd, pkt->pmd.rxpmd, BCMPKT_RCPU_RXPMD_SIZE);
+    }
     npkt->unit = unit;
     npkt->flags = pkt->flags;
     npkt->type = pkt->type;
@@ -488,6 +492,10 @@ bcmpkt_packet_clone(int unit, bcmpkt_packet_t *pkt, bcmpkt_packet_t **new_pkt)
     /* Copy packet structure information and metadata. */
     bcmpkt_pmd_format(npkt);
     sal_memcpy(npkt->pmd.data, pkt->pmd.data, sizeof(npkt->pmd.data));
+    if (pkt->pmd.rxpmd != NULL && pkt->pmd.rxpmd != pkt->pmd.data) {
+        /* RXPMD of a received packet may live in its data buffer. */
+        sal_memcpy(npkt->pmd.rxpmd, pkt->pmd.rxpmd, BCMPKT_RCPU_RXPMD_SIZE);
+    }
     npkt->unit = pkt->unit;
     npkt->flags = pkt->flags;
     npkt->type = pkt->type;
@@ -149,6 +149,43 @@ static int dev_enabled[BCMDRD_CONFIG_MAX_UNITS];
 /* Each unit supports one callback. */
 bcmpkt_rx_cb_info_t rx_cb_info[BCMDRD_CONFIG_MAX_UNITS];
 
+/*! Packet vector of an RX queue. */
+typedef struct rx_burst_vec_s {
+
+    /*! Number of packets in the vector. */
+    int num;
+
+    /*! Packet handles. */
+    bcmpkt_packet_t *vec[BCMPKT_RX_BURST_MAX];
+
+    /*! Packets. */
+    bcmpkt_packet_t pkts[BCMPKT_RX_BURST_MAX];
+
+} rx_burst_vec_t;
+
+/*! RX burst callback information. */
+typedef struct rx_burst_info_s {
+
+    /*! Callback flags. */
+    uint32_t flags;
+
+    /*! Callback function. */
+    bcmpkt_rx_burst_cb_f cb_func;
+
+    /*! Callback application contex. */
+    void *cb_data;
+
+    /*! True: Pending in callback unregistering state. */
+    bool cb_pending;
+
+    /*! Packet vectors of RX queues. */
+    rx_burst_vec_t *vecs;
+
+} rx_burst_info_t;
+
+/* Each unit supports one burst callback. */
+static rx_burst_info_t rx_burst_info[BCMDRD_CONFIG_MAX_UNITS];
+
 static bool
 unet_dev_inited(int unit) {
     if (bcmdrd_dev_exists(unit) && dev_inited[unit] == 1) {
@@ -157,41 +194,142 @@ unet_dev_inited(int unit) {
     return false;
 }
 
+/*
+ * Set up a packet for a received data buffer. The RXPMD is referenced in
+ * place within the data buffer instead of being copied.
+ */
 static int
-rx_packet_handle(int unit, int queue, bcmpkt_data_buf_t *dbuf, void *ck)
+rx_packet_init(int unit, bcmpkt_data_buf_t *dbuf, bcmpkt_packet_t *packet)
 {
-    bcmpkt_packet_t pkt;
-    bcmpkt_packet_t *packet = &pkt;
     bcmpkt_rcpu_hdr_t *rhdr;
 
-    SHR_FUNC_ENTER(unit);
-    SHR_NULL_CHECK(dbuf, SHR_E_PARAM);
-    SHR_NULL_CHECK(dbuf->data, SHR_E_PARAM);
-
-    sal_memset(packet, 0, sizeof(*packet));
-    bcmpkt_pmd_format(packet);
-    packet->data_buf = dbuf;
+    packet->next = NULL;
+    packet->prev = NULL;
+    packet->flags = 0;
+    packet->type = 0;
     packet->unit = unit;
+    packet->data_buf = dbuf;
+    bcmpkt_pmd_format(packet);
+    sal_memset(packet->pmd.txpmd, 0,
+               sizeof(packet->pmd.data) - BCMPKT_RCPU_RXPMD_SIZE);
 
-    /* Copy RXPMD data. */
     rhdr = (bcmpkt_rcpu_hdr_t *)dbuf->data;
-    sal_memcpy(packet->pmd.rxpmd, dbuf->data + sizeof(*rhdr), rhdr->meta_len);
+    packet->pmd.rxpmd = (uint32_t *)(dbuf->data + sizeof(*rhdr));
 
     /* Remove RCPU header and meta data from head of packet. */
     if (!bcmpkt_pull(dbuf, sizeof(*rhdr) + rhdr->meta_len)) {
-        SHR_RETURN_VAL_EXIT(SHR_E_FAIL);
+        return SHR_E_FAIL;
+    }
+
+    return SHR_E_NONE;
+}
+
+static void
+rx_burst_flush(int unit, int queue, rx_burst_vec_t *bv)
+{
+    rx_burst_info_t *bi = &rx_burst_info[unit];
+    int i;
+
+    if (bv->num == 0) {
+        return;
+    }
+
+    if (bi->cb_func && !bi->cb_pending) {
+        bi->cb_func(unit, queue + 1, bv->vec, bv->num, bi->cb_data);
+    }
+
+    for (i = 0; i < bv->num; i++) {
+        if (bv->pkts[i].data_buf) {
+            bcmpkt_data_buf_free(unit, bv->pkts[i].data_buf);
+            bv->pkts[i].data_buf = NULL;
+        }
+    }
+    bv->num = 0;
+}
+
+static void
+rx_burst_vecs_free(int unit, rx_burst_vec_t *vecs)
+{
+    int queue, i;
+
+    for (queue = 0; queue < NUM_QUE_MAX; queue++) {
+        for (i = 0; i < vecs[queue].num; i++) {
+            if (vecs[queue].pkts[i].data_buf) {
+                bcmpkt_data_buf_free(unit, vecs[queue].pkts[i].data_buf);
+            }
+        }
+    }
+    sal_free(vecs);
+}
+
+static void
+rx_burst_done(int unit, int queue, void *ck)
+{
+    rx_burst_vec_t *vecs = rx_burst_info[unit].vecs;
+
+    if (vecs != NULL && queue >= 0 && queue < NUM_QUE_MAX) {
+        rx_burst_flush(unit, queue, &vecs[queue]);
+    }
+}
+
+static int
+rx_burst_collect(int unit, int queue, rx_burst_vec_t *vecs,
+                 bcmpkt_data_buf_t *dbuf)
+{
+    rx_burst_vec_t *bv;
+    bcmpkt_packet_t *packet;
+    int rv;
+
+    if (queue < 0 || queue >= NUM_QUE_MAX) {
+        return SHR_E_PARAM;
+    }
+
+    bv = &vecs[queue];
+    packet = &bv->pkts[bv->num];
+    rv = rx_packet_init(unit, dbuf, packet);
+    if (SHR_FAILURE(rv)) {
+        return rv;
+    }
+    bv->vec[bv->num++] = packet;
+
+    if (bv->num == BCMPKT_RX_BURST_MAX) {
+        rx_burst_flush(unit, queue, bv);
+    }
+
+    return SHR_E_NONE;
+}
+
+static int
+rx_packet_handle(int unit, int queue, bcmpkt_data_buf_t *dbuf, void *ck)
+{
+    bcmpkt_packet_t pkt;
+    bcmpkt_packet_t *packet = &pkt;
+    rx_burst_vec_t *vecs = rx_burst_info[unit].vecs;
+
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(dbuf, SHR_E_PARAM);
+    SHR_NULL_CHECK(dbuf->data, SHR_E_PARAM);
+
+    /* Burst callback collects packets until the end of polling pass. */
+    if (vecs != NULL) {
+        SHR_RETURN_VAL_EXIT
+            (rx_burst_collect(unit, queue, vecs, dbuf));
     }
 
+    SHR_IF_ERR_EXIT
+        (rx_packet_init(unit, dbuf, packet));
+
     /* BCMPKT API only supports one callback. */
     if (rx_cb_info[unit].cb_func && !rx_cb_info[unit].cb_pending) {
         rx_cb_info[unit].cb_func(unit, queue + 1, packet,
                                  rx_cb_info[unit].cb_data);
     }
 
-exit:
-    if (!SHR_FUNC_ERR() && packet->data_buf) {
+    if (packet->data_buf) {
         bcmpkt_data_buf_free(packet->unit, packet->data_buf);
     }
+
+exit:
     SHR_FUNC_EXIT();
 }
 
@@ -325,6 +463,10 @@ bcmpkt_cnet_dev_cleanup(int unit)
 {
     if (unet_dev_inited(unit)) {
         bcmcnet_rx_cb_unregister(unit, rx_packet_handle, NULL);
+        if (rx_burst_info[unit].vecs != NULL) {
+            rx_burst_vecs_free(unit, rx_burst_info[unit].vecs);
+        }
+        sal_memset(&rx_burst_info[unit], 0, sizeof(rx_burst_info[unit]));
 
         bcmpkt_cnet_dev_disable(unit);
         dev_inited[unit] = 0;
@@ -624,7 +766,7 @@ bcmpkt_cnet_rx_register(int unit, int netif_id, uint32_t flags,
 
     SHR_NULL_CHECK(cb_func, SHR_E_PARAM);
 
-    if (rx_cb_info[unit].cb_func) {
+    if (rx_cb_info[unit].cb_func || rx_burst_info[unit].cb_func) {
         SHR_IF_ERR_MSG_EXIT
             (SHR_E_EXISTS,
              (BSL_META_U(unit, "Exists: Support only one callback function\n")));
@@ -676,6 +818,107 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+/*!
+ * The netif_id is network interface ID. For CNET driver, DMA queue (channel)
+ * ID is the network interface ID. (ID is start from 1.)
+ *
+ * CNET driver doesn't support RX DMA channel base callback register.
+ */
+static int
+bcmpkt_cnet_rx_burst_register(int unit, int netif_id, uint32_t flags,
+                              bcmpkt_rx_burst_cb_f cb_func, void *cb_data)
+{
+    rx_burst_vec_t *vecs = NULL;
+
+    SHR_FUNC_ENTER(unit);
+    if (!unet_dev_inited(unit)) {
+        SHR_RETURN_VAL_EXIT(SHR_E_CONFIG);
+    }
+
+    SHR_NULL_CHECK(cb_func, SHR_E_PARAM);
+
+    if (rx_cb_info[unit].cb_func || rx_burst_info[unit].cb_func) {
+        SHR_IF_ERR_MSG_EXIT
+            (SHR_E_EXISTS,
+             (BSL_META_U(unit, "Exists: Support only one callback function\n")));
+    }
+
+    SHR_ALLOC(vecs, sizeof(*vecs) * NUM_QUE_MAX, "bcmpktRxBurstVecs");
+    SHR_NULL_CHECK(vecs, SHR_E_MEMORY);
+    sal_memset(vecs, 0, sizeof(*vecs) * NUM_QUE_MAX);
+
+    rx_burst_info[unit].cb_func = cb_func;
+    rx_burst_info[unit].cb_data = cb_data;
+    rx_burst_info[unit].flags = flags;
+    rx_burst_info[unit].cb_pending = FALSE;
+
+    SHR_IF_ERR_EXIT
+        (bcmcnet_rx_done_cb_set(unit, rx_packet_handle, rx_burst_done, NULL));
+
+    /* Start collecting packets. */
+    rx_burst_info[unit].vecs = vecs;
+    vecs = NULL;
+
+exit:
+    if (SHR_FUNC_ERR()) {
+        SHR_FREE(vecs);
+        if (rx_burst_info[unit].vecs == NULL) {
+            rx_burst_info[unit].cb_func = NULL;
+            rx_burst_info[unit].cb_data = NULL;
+        }
+    }
+    SHR_FUNC_EXIT();
+}
+
+/*!
+ * The netif_id is network interface ID. For CNET driver, DMA queue (channel)
+ * ID is the network interface ID. (ID is start from 1.)
+ *
+ * CNET driver doesn't support RX DMA channel base callback register.
+ */
+static int
+bcmpkt_cnet_rx_burst_unregister(int unit, int netif_id,
+                                bcmpkt_rx_burst_cb_f cb_func, void *cb_data)
+{
+    rx_burst_vec_t *vecs;
+
+    SHR_FUNC_ENTER(unit);
+    if (!bcmdrd_dev_exists(unit)) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNIT);
+    }
+
+    if (rx_burst_info[unit].cb_func == NULL) {
+        LOG_WARN(BSL_LOG_MODULE,
+                 (BSL_META_U(unit, "RX burst callback not registered\n")));
+        SHR_RETURN_VAL_EXIT(SHR_E_NONE);
+    }
+
+    if (rx_burst_info[unit].cb_func != cb_func) {
+        LOG_WARN(BSL_LOG_MODULE,
+                 (BSL_META_U(unit, "RX burst callback doesn't match\n")));
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+
+    /* Stop collecting, then wait for the RX thread to leave the vectors. */
+    rx_burst_info[unit].cb_pending = TRUE;
+    vecs = rx_burst_info[unit].vecs;
+    rx_burst_info[unit].vecs = NULL;
+    if (unet_dev_inited(unit)) {
+        bcmcnet_rx_done_cb_set(unit, rx_packet_handle, NULL, NULL);
+    }
+    sal_usleep(100000);
+
+    if (vecs != NULL) {
+        rx_burst_vecs_free(unit, vecs);
+    }
+    rx_burst_info[unit].cb_func = NULL;
+    rx_burst_info[unit].cb_data = NULL;
+    rx_burst_info[unit].flags = 0;
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
 static int
 header_generate(int unit, bcmpkt_packet_t *packet)
 {
@@ -868,6 +1111,87 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+static int
+bcmpkt_cnet_tx_burst(int unit, int netif_id, bcmpkt_packet_t **packets,
+                     int num, int *num_sent)
+{
+    bcmpkt_data_buf_t *bufs[BCMPKT_TX_BURST_MAX];
+    uint32_t hdr_len[BCMPKT_TX_BURST_MAX];
+    bcmpkt_packet_t *packet;
+    int sent = 0, cnt, done = 0, ready = 0, i, rv;
+    uint32_t len;
+
+    SHR_FUNC_ENTER(unit);
+    if (!bcmdrd_dev_exists(unit)) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNIT);
+    }
+
+    SHR_NULL_CHECK(packets, SHR_E_PARAM);
+    SHR_NULL_CHECK(num_sent, SHR_E_PARAM);
+
+    while (sent < num) {
+        cnt = num - sent;
+        if (cnt > BCMPKT_TX_BURST_MAX) {
+            cnt = BCMPKT_TX_BURST_MAX;
+        }
+
+        /* Encapsulate a chunk of packets before placing them on the ring. */
+        done = 0;
+        for (ready = 0; ready < cnt; ) {
+            packet = packets[sent + ready];
+            SHR_NULL_CHECK(packet, SHR_E_PARAM);
+            SHR_NULL_CHECK(BCMPKT_PACKET_DATA(packet), SHR_E_PARAM);
+
+            if (BCMPKT_PACKET_LEN(packet) < BCMPKT_FRAME_SIZE_MIN) {
+                SHR_IF_ERR_VERBOSE_MSG_EXIT
+                    (SHR_E_PARAM,
+                     (BSL_META_U(unit,
+                                 "Packet size %"PRIu32" is underrun\n"),
+                      BCMPKT_PACKET_LEN(packet)));
+            }
+
+            hdr_len[ready] = 0;
+            rv = SHR_E_NONE;
+            if (packet->type == BCMPKT_FWD_T_NORMAL) {
+                len = BCMPKT_PACKET_LEN(packet);
+                rv = header_generate(unit, packet);
+                hdr_len[ready] = BCMPKT_PACKET_LEN(packet) - len;
+            }
+            bufs[ready++] = packet->data_buf;
+            SHR_IF_ERR_EXIT(rv);
+        }
+
+        rv = bcmcnet_tx_burst(unit, netif_id - 1, bufs, cnt);
+        SHR_IF_ERR_EXIT(SHR_FAILURE(rv) ? rv : SHR_E_NONE);
+
+        for (i = 0; i < rv; i++) {
+            packets[sent + i]->data_buf = NULL;
+        }
+        done = rv;
+        if (rv < cnt) {
+            SHR_RETURN_VAL_EXIT(SHR_E_FAIL);
+        }
+        sent += rv;
+        done = 0;
+        ready = 0;
+    }
+
+exit:
+    /*
+     * Strip the headers from the packets that were not consumed, so the
+     * caller can retry them.
+     */
+    for (i = done; i < ready; i++) {
+        if (hdr_len[i] > 0) {
+            bcmpkt_pull(packets[sent + i]->data_buf, hdr_len[i]);
+        }
+    }
+    if (num_sent != NULL) {
+        *num_sent = sent + done;
+    }
+    SHR_FUNC_EXIT();
+}
+
 int
 bcmpkt_dev_drv_cnet_attach(void)
 {
@@ -895,7 +1219,10 @@ bcmpkt_dev_drv_cnet_attach(void)
         .driver_type = BCMPKT_NET_DRV_T_CNET,
         .rx_register = bcmpkt_cnet_rx_register,
         .rx_unregister = bcmpkt_cnet_rx_unregister,
-        .tx = bcmpkt_cnet_tx
+        .tx = bcmpkt_cnet_tx,
+        .rx_burst_register = bcmpkt_cnet_rx_burst_register,
+        .rx_burst_unregister = bcmpkt_cnet_rx_burst_unregister,
+        .tx_burst = bcmpkt_cnet_tx_burst
     };
 
     SHR_FUNC_ENTER(BSL_UNIT_UNKNOWN);
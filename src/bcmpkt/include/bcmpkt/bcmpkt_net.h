@@ -138,6 +138,12 @@
  */
 #define BCMPKT_TX_HDR_RSV           BCMPKT_RCPU_MAX_ENCAP_SIZE
 
+/*! Maximum number of packets delivered in one RX burst callback. */
+#define BCMPKT_RX_BURST_MAX         32
+
+/*! Maximum number of packets placed on a TX ring in one burst. */
+#define BCMPKT_TX_BURST_MAX         32
+
 /*! Packet data handle. */
 #define BCMPKT_PACKET_DATA(_pkt)    (_pkt)->data_buf->data
 
@@ -345,6 +351,83 @@ typedef int (*bcmpkt_rx_unregister_f)(int unit, int netif_id,
  */
 typedef int (*bcmpkt_tx_f)(int unit, int netif_id, bcmpkt_packet_t *packet);
 
+/*!
+ * \brief Packet burst receive callback function type.
+ *
+ * Callback function type for applications receiving packets in vectors.
+ *
+ * Up to \ref BCMPKT_RX_BURST_MAX packets received on the same network
+ * interface are delivered per call. The packets and their data buffers
+ * are owned by the driver and are only valid during the callback. The
+ * RXPMD handle of each packet points into the packet data buffer and is
+ * not a copy.
+ *
+ * \param [in] unit Switch unit number.
+ * \param [in] netif_id Network interface ID.
+ * \param [in] packets Array of packet handles.
+ * \param [in] num Number of packets.
+ * \param [in] cb_data Application-provided context.
+ *
+ * \return SHR_E_XXX Leave for future.
+ */
+typedef int (*bcmpkt_rx_burst_cb_f)(int unit, int netif_id,
+                                    bcmpkt_packet_t **packets, int num,
+                                    void *cb_data);
+
+/*!
+ * \brief Packet burst receive callback register function.
+ *
+ * \param [in] unit Switch unit number.
+ * \param [in] netif_id Network interface ID.
+ * \param [in] flags Reserved for future.
+ * \param [in] cb_func Packet burst receive callback function.
+ * \param [in] cb_data Application-provided context.
+ *
+ * \retval SHR_E_NONE success.
+ * \retval SHR_E_PARAM Check parameters failed.
+ * \retval SHR_E_MEMORY Allocate buffer failed.
+ * \retval SHR_E_EXISTS Callback already exists.
+ */
+typedef int (*bcmpkt_rx_burst_register_f)(int unit, int netif_id,
+                                          uint32_t flags,
+                                          bcmpkt_rx_burst_cb_f cb_func,
+                                          void *cb_data);
+
+/*!
+ * \brief Packet burst receive callback deregister function.
+ *
+ * \param [in] unit Switch unit number.
+ * \param [in] netif_id Network interface ID.
+ * \param [in] cb_func Packet burst receive callback function.
+ * \param [in] cb_data Application-provided context.
+ *
+ * \retval SHR_E_NONE success.
+ * \retval SHR_E_PARAM Check parameters failed.
+ */
+typedef int (*bcmpkt_rx_burst_unregister_f)(int unit, int netif_id,
+                                            bcmpkt_rx_burst_cb_f cb_func,
+                                            void *cb_data);
+
+/*!
+ * \brief Packet burst transmit function.
+ *
+ * Send an array of packets through one network interface. The packets
+ * are consumed in order; \c num_sent returns how many were consumed.
+ *
+ * \param [in] unit Switch unit number.
+ * \param [in] netif_id Network interface number.
+ * \param [in] packets Array of packet handles.
+ * \param [in] num Number of packets.
+ * \param [out] num_sent Number of packets consumed.
+ *
+ * \retval SHR_E_NONE success.
+ * \retval SHR_E_PARAM Check parameters failed.
+ * \retval SHR_E_FAIL Transmit failed.
+ */
+typedef int (*bcmpkt_tx_burst_f)(int unit, int netif_id,
+                                 bcmpkt_packet_t **packets, int num,
+                                 int *num_sent);
+
 /*!
  * \brief NET operation vector.
  */
@@ -368,6 +451,15 @@ typedef struct bcmpkt_net_s {
     /*! Transmit function. */
     bcmpkt_tx_f tx;
 
+    /*! Register RX burst callback (optional). */
+    bcmpkt_rx_burst_register_f rx_burst_register;
+
+    /*! Unregister RX burst callback (optional). */
+    bcmpkt_rx_burst_unregister_f rx_burst_unregister;
+
+    /*! Burst transmit function (optional). */
+    bcmpkt_tx_burst_f tx_burst;
+
 } bcmpkt_net_t;
 
 /*!
@@ -583,4 +675,74 @@ bcmpkt_rx_unregister(int unit, int netif_id, bcmpkt_rx_cb_f cb_func,
 extern int
 bcmpkt_tx(int unit, int netif_id, bcmpkt_packet_t *packet);
 
+/*!
+ * \brief Packet burst receive callback register function.
+ *
+ * Register a callback which receives packets in vectors of up to
+ * \ref BCMPKT_RX_BURST_MAX packets. A unit supports either a packet
+ * receive callback or a burst receive callback.
+ *
+ * The 'netif_id' is not used for CNET driver and would be ignored.
+ *
+ * \param [in] unit Switch unit number.
+ * \param [in] netif_id Network interface ID.
+ * \param [in] flags Reserved for future.
+ * \param [in] cb_func Packet burst receive callback function.
+ * \param [in] cb_data Application-provided context.
+ *
+ * \retval SHR_E_NONE success.
+ * \retval SHR_E_UNIT Invalid unit.
+ * \retval SHR_E_PARAM Check parameters failed.
+ * \retval SHR_E_MEMORY Allocate buffer failed.
+ * \retval SHR_E_EXISTS Callback already exists.
+ * \retval SHR_E_UNAVAIL Not supported by the NET driver.
+ */
+extern int
+bcmpkt_rx_burst_register(int unit, int netif_id, uint32_t flags,
+                         bcmpkt_rx_burst_cb_f cb_func, void *cb_data);
+
+/*!
+ * \brief Packet burst receive callback deregister function.
+ *
+ * \param [in] unit Switch unit number.
+ * \param [in] netif_id Network interface ID.
+ * \param [in] cb_func Packet burst receive callback function.
+ * \param [in] cb_data Application-provided context.
+ *
+ * \retval SHR_E_NONE success.
+ * \retval SHR_E_UNIT Invalid unit.
+ * \retval SHR_E_PARAM Check parameters failed.
+ * \retval SHR_E_UNAVAIL Not supported by the NET driver.
+ */
+extern int
+bcmpkt_rx_burst_unregister(int unit, int netif_id,
+                           bcmpkt_rx_burst_cb_f cb_func, void *cb_data);
+
+/*!
+ * \brief Packet burst transmit function.
+ *
+ * Send an array of packets through one network interface. Drivers with
+ * burst support place all the packets on the DMA ring before starting
+ * the DMA once; other drivers send the packets one by one.
+ *
+ * The packets are consumed in order. On failure, \c num_sent tells how
+ * many packets were consumed before the failing one.
+ *
+ * For CNET driver mode, 'netif_id' is TX DMA queue index (starts from 1).
+ *
+ * \param [in] unit Switch unit number.
+ * \param [in] netif_id Network interface number.
+ * \param [in] packets Array of packet handles.
+ * \param [in] num Number of packets.
+ * \param [out] num_sent Number of packets consumed.
+ *
+ * \retval SHR_E_NONE success.
+ * \retval SHR_E_UNIT Invalid unit.
+ * \retval SHR_E_PARAM Check parameters failed.
+ * \retval SHR_E_FAIL Transmit failed.
+ */
+extern int
+bcmpkt_tx_burst(int unit, int netif_id, bcmpkt_packet_t **packets, int num,
+                int *num_sent);
+
 #endif  /* !BCMPKT_NET_H */
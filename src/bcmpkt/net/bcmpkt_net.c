@@ -366,6 +366,79 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+int
+bcmpkt_rx_burst_register(int unit, int netif_id, uint32_t flags,
+                         bcmpkt_rx_burst_cb_f cb_func, void *cb_data)
+{
+    bcmpkt_net_t *net;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_IF_ERR_EXIT
+        (bcmpkt_net_drv_get(unit, &net));
+    SHR_NULL_CHECK(net, SHR_E_CONFIG);
+    SHR_NULL_CHECK(net->rx_burst_register, SHR_E_UNAVAIL);
+    SHR_IF_ERR_EXIT
+        (net->rx_burst_register(unit, netif_id, flags, cb_func, cb_data));
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmpkt_rx_burst_unregister(int unit, int netif_id,
+                           bcmpkt_rx_burst_cb_f cb_func, void *cb_data)
+{
+    bcmpkt_net_t *net;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_IF_ERR_EXIT
+        (bcmpkt_net_drv_get(unit, &net));
+    SHR_NULL_CHECK(net, SHR_E_CONFIG);
+    SHR_NULL_CHECK(net->rx_burst_unregister, SHR_E_UNAVAIL);
+    SHR_IF_ERR_EXIT
+        (net->rx_burst_unregister(unit, netif_id, cb_func, cb_data));
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmpkt_tx_burst(int unit, int netif_id, bcmpkt_packet_t **packets, int num,
+                int *num_sent)
+{
+    bcmpkt_net_t *net;
+    int sent = 0;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_NULL_CHECK(packets, SHR_E_PARAM);
+    SHR_NULL_CHECK(num_sent, SHR_E_PARAM);
+    *num_sent = 0;
+
+    SHR_IF_ERR_EXIT
+        (bcmpkt_net_drv_get(unit, &net));
+    SHR_NULL_CHECK(net, SHR_E_CONFIG);
+
+    if (net->tx_burst != NULL) {
+        SHR_IF_ERR_EXIT
+            (net->tx_burst(unit, netif_id, packets, num, num_sent));
+        SHR_EXIT();
+    }
+
+    /* Fall back to one packet per call. */
+    SHR_NULL_CHECK(net->tx, SHR_E_CONFIG);
+    for (sent = 0; sent < num; sent++) {
+        SHR_IF_ERR_EXIT
+            (net->tx(unit, netif_id, packets[sent]));
+        *num_sent = sent + 1;
+    }
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
 int
 bcmpkt_net_drv_type_get(int unit, bcmpkt_net_drv_types_t *type)
 {
@@ -520,7 +520,7 @@ bcmptm_cci_config_get(int unit, cci_config_t *config)
     SHR_NULL_CHECK(config, SHR_E_PARAM);
 
     sal_memset(config, 0, sizeof(cci_config_t));
-    config->nthreads = 1;
+    config->nthreads = con->nthreads ? con->nthreads : CCI_COL_THREADS_DEFAULT;
     psim = bcmdrd_feature_enabled(unit, BCMDRD_FT_PASSIVE_SIM);
     /* Non DMA mode only in case of passive sim */
     if (psim) {
@@ -1202,6 +1202,59 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+/*!
+ * Set the number of counter collection threads
+ */
+int
+bcmptm_cci_col_threads_set(int unit, int nthreads)
+{
+    cci_context_t   *con;
+
+    SHR_FUNC_ENTER(unit);
+    con = cci_context[unit];
+    SHR_NULL_CHECK(con, SHR_E_INIT);
+
+    if ((nthreads < 1) || (nthreads > CCI_COL_MAX_THREADS)) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    con->nthreads = nthreads;
+
+    if (con->info->state == CCI_STATE_RUN) {
+        /* Restart the collection threads to re-partition the ports */
+        SHR_IF_ERR_EXIT(
+            bcmptm_cci_col_stop(unit, con->hcol));
+        SHR_IF_ERR_EXIT(
+            bcmptm_cci_col_run(unit, con->hcol));
+    }
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/*!
+ * Get sweep statistics of a counter collection thread
+ */
+int
+bcmptm_cci_col_sweep_stats_get(int unit, int thread,
+                               bcmptm_cci_col_sweep_stats_t *stats)
+{
+    cci_context_t   *con;
+    cci_handle_t hpol;
+
+    SHR_FUNC_ENTER(unit);
+    con = cci_context[unit];
+    SHR_NULL_CHECK(con, SHR_E_INIT);
+    SHR_NULL_CHECK(stats, SHR_E_PARAM);
+
+    SHR_IF_ERR_EXIT(
+        bcmptm_cci_poll_handle_get(unit, con->hcol, &hpol));
+    SHR_IF_ERR_EXIT(
+        bcmptm_cci_col_poll_stats_get(unit, hpol, thread, stats));
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
 /*!
  * Clean up CCI software resources
  */
@@ -1222,6 +1275,24 @@ exit:
     SHR_FUNC_EXIT();
 
 }
+/*!
+ * Get CCI cache Handle of a unit
+ */
+int
+bcmptm_cci_unit_cache_handle_get(int unit,
+                                 cci_handle_t *handle)
+{
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(cci_context[unit], SHR_E_INIT);
+    SHR_NULL_CHECK(handle, SHR_E_PARAM);
+
+    *handle = cci_context[unit]->hcache;
+    SHR_NULL_CHECK(*handle, SHR_E_INIT);
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
 /*!
  * Get CCI cache Handle
  */
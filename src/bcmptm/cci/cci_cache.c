@@ -145,7 +145,8 @@
             (uint32_t)(((map)->ctr_table_offset) + \
                 (((map)->index_max) - ((map)->index_min) + (1)) \
                   * (uint32_t)(inst) * (uint32_t)((map)->field_num) + \
-                  (uint32_t)(index) * (uint32_t)((map)->field_num) + \
+                  ((uint32_t)(index) - ((map)->index_min)) * \
+                  (uint32_t)((map)->field_num) + \
                   (uint32_t)(field))
 
 
@@ -1633,3 +1634,145 @@ exit:
     }
     SHR_FUNC_EXIT();
 }
+
+/*****************************************************************************
+* bcmptm_cci_cache_snap_map_get
+ */
+int
+bcmptm_cci_cache_snap_map_get(int unit,
+                              cci_handle_t handle,
+                              bcmptm_cci_ctr_map_id mapid,
+                              bcmptm_cci_snap_map_t *smap)
+{
+    cci_ctr_cache_t *cache = (cci_ctr_cache_t *)handle;
+    cci_ctr_cache_map_t *map;
+
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(cache, SHR_E_PARAM);
+    SHR_NULL_CHECK(smap, SHR_E_PARAM);
+
+    if (mapid >= cache->ctr_map_size) {
+        SHR_IF_ERR_EXIT(SHR_E_NOT_FOUND);
+    }
+    map = &cache->ctr_map_table[mapid];
+
+    smap->sid = map->sid;
+    smap->base = map->ctr_table_offset;
+    smap->num_ctrs = map->size;
+    /* The counter table holds tbl_inst + 1 instances per symbol */
+    smap->num_inst = map->tbl_inst + 1;
+    smap->index_min = map->index_min;
+    smap->num_index = map->index_max - map->index_min + 1;
+    smap->num_fields = map->field_num;
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/*****************************************************************************
+* bcmptm_cci_cache_sw_count_add
+ */
+int
+bcmptm_cci_cache_sw_count_add(int unit,
+                              cci_handle_t handle,
+                              bcmptm_cci_ctr_map_id mapid,
+                              int tbl_inst,
+                              uint32_t index,
+                              uint32_t field,
+                              uint64_t inc)
+{
+    cci_ctr_cache_t *cache = (cci_ctr_cache_t *)handle;
+    cci_ctr_cache_map_t *map;
+    uint32_t offset;
+
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(cache, SHR_E_PARAM);
+
+    if (mapid >= cache->ctr_map_size) {
+        SHR_IF_ERR_EXIT(SHR_E_NOT_FOUND);
+    }
+    map = &cache->ctr_map_table[mapid];
+    if (index < map->index_min || index > map->index_max ||
+        tbl_inst < 0 || tbl_inst > map->tbl_inst ||
+        field >= map->field_num) {
+        SHR_IF_ERR_EXIT(SHR_E_PARAM);
+    }
+
+    offset = CTR_INDEX(map, tbl_inst, index, field);
+    if (sal_mutex_take(cache->mlock, CFG_CCI_TIME_OUT) != 0) {
+        SHR_IF_ERR_EXIT(SHR_E_TIMEOUT);
+    }
+    cache->ctr_table[offset].sw_count += inc;
+    sal_mutex_give(cache->mlock);
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/*****************************************************************************
+* bcmptm_cci_cache_snapshot
+ */
+int
+bcmptm_cci_cache_snapshot(int unit,
+                          cci_handle_t handle,
+                          const bcmptm_cci_cache_range_t *range,
+                          uint32_t num_range,
+                          uint64_t *buf,
+                          uint32_t max_deltas,
+                          bcmptm_cci_snap_delta_t *deltas,
+                          uint32_t *num_changed)
+{
+    cci_ctr_cache_t *cache = (cci_ctr_cache_t *)handle;
+    const cci_count_t *ctr;
+    uint32_t r, i, pos = 0;
+    uint32_t changed = 0;
+    uint64_t val;
+    bool diff = (deltas != NULL) || (num_changed != NULL);
+
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(cache, SHR_E_PARAM);
+    SHR_NULL_CHECK(buf, SHR_E_PARAM);
+    if (num_range > 0) {
+        SHR_NULL_CHECK(range, SHR_E_PARAM);
+    }
+
+    if (sal_mutex_take(cache->mlock, CFG_CCI_TIME_OUT) != 0) {
+        SHR_IF_ERR_EXIT(SHR_E_TIMEOUT);
+    }
+    for (r = 0; r < num_range; r++) {
+        if (range[r].offset + range[r].size > cache->ctr_table_size) {
+            break;
+        }
+        ctr = &cache->ctr_table[range[r].offset];
+        if (!diff) {
+            for (i = 0; i < range[r].size; i++) {
+                buf[pos++] = ctr[i].sw_count;
+            }
+            continue;
+        }
+        for (i = 0; i < range[r].size; i++, pos++) {
+            val = ctr[i].sw_count;
+            if (val != buf[pos]) {
+                if (deltas && changed < max_deltas) {
+                    deltas[changed].pos = pos;
+                    deltas[changed].value = val;
+                    deltas[changed].delta = val - buf[pos];
+                }
+                changed++;
+                buf[pos] = val;
+            }
+        }
+    }
+    sal_mutex_give(cache->mlock);
+
+    if (r < num_range) {
+        /* Counter table changed under the snapshot */
+        SHR_IF_ERR_EXIT(SHR_E_INTERNAL);
+    }
+    if (num_changed) {
+        *num_changed = changed;
+    }
+
+exit:
+    SHR_FUNC_EXIT();
+}
@@ -101,6 +101,7 @@
 #include <bcmdrd/bcmdrd_types.h>
 #include "cci_internal.h"
 #include <bcmptm/bcmptm_cci_internal.h>
+#include <bcmptm/bcmptm_cci.h>
 
 /*******************************************************************************
  * Defines
@@ -456,4 +457,78 @@ bcmptm_cci_cache_lport_to_pport(int unit,
                                 cci_handle_t handle,
                                 bcmptm_cci_ctr_info_t *info);
 
+/*!
+ * \brief Range of the counter table
+ */
+typedef struct bcmptm_cci_cache_range_s {
+    uint32_t offset;    /*!< offset, first counter in counter table */
+    uint32_t size;      /*!< size, number of counters */
+} bcmptm_cci_cache_range_t;
+
+/*!
+ * \brief Get the snapshot layout of a counter map entry
+ *
+ * The base of the layout is the offset of the symbol in the counter table.
+ *
+ * \param [in] unit Logical device id
+ * \param [in] handle of the current cache Instance
+ * \param [in] mapid Counter map id
+ * \param [out] smap Snapshot layout
+ *
+ * \retval SHR_E_NONE Success
+ */
+extern int
+bcmptm_cci_cache_snap_map_get(int unit,
+                              cci_handle_t handle,
+                              bcmptm_cci_ctr_map_id mapid,
+                              bcmptm_cci_snap_map_t *smap);
+
+/*!
+ * \brief Add to the software count of one counter
+ *
+ * Used by the snapshot self test to change counters at known positions.
+ *
+ * \param [in] unit Logical device id
+ * \param [in] handle of the current cache Instance
+ * \param [in] mapid Counter map id
+ * \param [in] tbl_inst Table instance
+ * \param [in] index Entry index
+ * \param [in] field Counter field number
+ * \param [in] inc Value added, modulo 2^64
+ *
+ * \retval SHR_E_NONE Success
+ */
+extern int
+bcmptm_cci_cache_sw_count_add(int unit,
+                              cci_handle_t handle,
+                              bcmptm_cci_ctr_map_id mapid,
+                              int tbl_inst,
+                              uint32_t index,
+                              uint32_t field,
+                              uint64_t inc);
+
+/*!
+ * \brief Copy counter table ranges under the cache lock
+ *
+ * \param [in] unit Logical device id
+ * \param [in] handle of the current cache Instance
+ * \param [in] range Counter table ranges
+ * \param [in] num_range Number of ranges
+ * \param [in,out] buf Snapshot buffer, holds the previous values
+ * \param [in] max_deltas Size of deltas
+ * \param [out] deltas Changed counters, may be NULL
+ * \param [out] num_changed Number of changed counters, may be NULL
+ *
+ * \retval SHR_E_NONE Success
+ */
+extern int
+bcmptm_cci_cache_snapshot(int unit,
+                          cci_handle_t handle,
+                          const bcmptm_cci_cache_range_t *range,
+                          uint32_t num_range,
+                          uint64_t *buf,
+                          uint32_t max_deltas,
+                          bcmptm_cci_snap_delta_t *deltas,
+                          uint32_t *num_changed);
+
 #endif /* CCI_CACHE_H */
@@ -249,6 +249,23 @@ bcmptm_cci_col_poll_config(int unit,
                        cci_pol_cmd_t cmd,
                        cci_config_t *config);
 
+/*!
+ * \brief Get sweep statistics of a poll collection thread
+ *
+ * \param [in] unit Logical device id
+ * \param [in] handle of the current poll Instance
+ * \param [in] thread Collection thread index
+ * \param [out] stats Sweep statistics
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_PARAM Thread is not running
+ */
+extern int
+bcmptm_cci_col_poll_stats_get(int unit,
+                              cci_handle_t handle,
+                              int thread,
+                              bcmptm_cci_col_sweep_stats_t *stats);
+
 /*!
  * \brief Get CCI  poll Handle
  *
@@ -107,6 +107,8 @@
 #include <bcmdrd/bcmdrd_pt.h>
 #include <bcmdrd/bcmdrd_hal.h>
 #include <sal/sal_thread.h>
+#include <sal/sal_mutex.h>
+#include <sal/sal_spinlock.h>
 #include <bcmpc/bcmpc_lport.h>
 #include <bcmptm/bcmptm_cci_internal.h>
 #include <bcmdrd/bcmdrd_feature.h>
@@ -144,6 +146,9 @@ typedef struct cci_col_poll_s {
 
     /*! Context of thread instance */
     cci_handle_t *hthreads;
+
+    /*! Lock protecting the thread instances */
+    sal_mutex_t lock;
 } cci_col_poll_t;
 
 /*!
@@ -190,6 +195,9 @@ typedef struct col_ctr_work_s {
     /*! Virtual address of collection buffer */
     uint32_t *vaddr;
 
+    /*! DMA work already executed outside of cache lock */
+    bool dma_done;
+
    /*! Next work Node */
     struct col_ctr_work_s *next;
 }col_ctr_work_t;
@@ -269,6 +277,24 @@ typedef struct col_thread_handle_s {
 
     /*!Counter  collection meta data list */
     col_ctr_list_t *ctr_mem_col_list[CCI_CTR_TYPE_NUM];
+
+    /*! Partition of the active ports collected by this thread */
+    int part;
+
+    /*! Number of partitions */
+    int num_parts;
+
+    /*! Execute DMA work outside of cache lock */
+    bool dma_staged;
+
+    /*! Port reg DMA work already executed outside of cache lock */
+    bool dma_done;
+
+    /*! Lock protecting sweep statistics */
+    sal_spinlock_t stats_lock;
+
+    /*! Sweep statistics */
+    bcmptm_cci_col_sweep_stats_t stats;
 }  col_thread_handle_t;
 
 
@@ -374,18 +400,25 @@ bcmptm_cci_col_poll_config(int unit,
     col_thread_handle_t *th;
     col_thread_msg_t msg;
 
+    int i;
+    bool locked = FALSE;
+
     SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(pol, SHR_E_PARAM);
 
-    if (pol->hthreads) {
+    sal_mutex_take(pol->lock, SAL_MUTEX_FOREVER);
+    locked = TRUE;
 
-        th = (col_thread_handle_t *)pol->hthreads[0];
-        SHR_NULL_CHECK(th, SHR_E_PARAM);
+    sal_memset(&msg, 0, sizeof(msg));
+    msg.cmd = cmd;
+    SHR_IF_ERR_EXIT(
+        col_poll_config_copy(unit, config, &msg, false));
 
-        sal_memset(&msg, 0, sizeof(msg));
-        msg.cmd = cmd;
+    /* Every thread keeps its own copy of the configuration */
+    for (i = 0; i < pol->nthreads; i++) {
+        th = (col_thread_handle_t *)pol->hthreads[i];
+        SHR_NULL_CHECK(th, SHR_E_PARAM);
 
-        SHR_IF_ERR_EXIT(
-            col_poll_config_copy(unit, config, &msg, false));
         if (sal_msgq_post(th->msgq_hdl, (void *)&msg, SAL_MSGQ_NORMAL_PRIORITY,
              MSGQ_TIME_OUT) == SAL_MSGQ_E_TIMEOUT) {
             SHR_RETURN_VAL_EXIT(SHR_E_TIMEOUT);
@@ -393,6 +426,9 @@ bcmptm_cci_col_poll_config(int unit,
     }
 
 exit:
+    if (locked) {
+        sal_mutex_give(pol->lock);
+    }
     SHR_FUNC_EXIT();
 }
 
@@ -1140,6 +1176,36 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+/*!
+ * Execute DMA work into the collection buffer of the thread
+ * without holding the counter cache lock.
+ * The threads use separate SBUSDMA channels, only the cache
+ * update which follows is serialized.
+ */
+static int
+col_poll_dma_staged_execute(int unit,
+                            bcmbd_sbusdma_work_t *work)
+{
+    int retry = CFG_SER_RETRY_COUNT;
+    int rv = SHR_E_NONE;
+
+    if (work->items == 0) {
+        return SHR_E_NONE;
+    }
+    while (retry--) {
+        rv = bcmbd_sbusdma_work_execute(unit, work);
+        if (SHR_SUCCESS(rv)) {
+            break;
+        }
+    }
+    if (SHR_FAILURE(rv)) {
+        LOG_VERBOSE(BSL_LOG_MODULE,
+            (BSL_META_U(unit,"DMA work [%p] failed rv=%d\n"),
+             (void *)work, rv));
+    }
+    return rv;
+}
+
 /*!
  * Collect the block of contiguous port counters for specified port using SBUS DMA
  */
@@ -1170,8 +1236,10 @@ col_poll_ctr_port_reg_block_dma(int unit,
     if (work->items == 0) {
         SHR_EXIT();
     }
-    SHR_IF_ERR_EXIT(
-        bcmbd_sbusdma_work_execute(unit, work));
+    if (!th->dma_done) {
+        SHR_IF_ERR_EXIT(
+            bcmbd_sbusdma_work_execute(unit, work));
+    }
     /* Update the cache with values collected using DMA */
     if (update_cache) {
         for(j = 0; j < work->items; j++) {
@@ -1223,6 +1291,7 @@ col_poll_ctr_port_reg_dma(int unit,
     int i;
     int tbl_inst;
     uint64_t buff_offset = 0;
+    int rv;
 
     SHR_FUNC_ENTER(unit);
     SHR_NULL_CHECK(handle, SHR_E_PARAM);
@@ -1245,11 +1314,21 @@ col_poll_ctr_port_reg_dma(int unit,
                 }
                 LOG_VERBOSE(BSL_LOG_MODULE,
                     (BSL_META_U(unit,"tbl_inst = %d\n"), tbl_inst));
+                if (th->dma_staged) {
+                    rv = col_poll_dma_staged_execute(unit,
+                                                th->port_reg_work[tbl_inst]);
+                    if (SHR_FAILURE(rv)) {
+                        /* Collected in next sweep */
+                        continue;
+                    }
+                    th->dma_done = TRUE;
+                }
                 /* Collect the couter and update the Counter cache */
-                SHR_IF_ERR_EXIT(
-                    bcmptm_cci_cache_hw_sync(unit, th->hcache,
-                                             col_poll_ctr_port_reg_block_dma,
-                                             th, TRUE));
+                rv = bcmptm_cci_cache_hw_sync(unit, th->hcache,
+                                              col_poll_ctr_port_reg_block_dma,
+                                              th, TRUE);
+                th->dma_done = FALSE;
+                SHR_IF_ERR_EXIT(rv);
             }
         }
     }
@@ -1292,8 +1371,10 @@ col_poll_ctr_port_mem_block_dma(int unit,
                                            &index_min, &index_max));
 
     if(work->items) {
-        SHR_IF_ERR_EXIT(
+        if (!ctr_work->dma_done) {
+            SHR_IF_ERR_EXIT(
                 bcmbd_sbusdma_work_execute(unit, work));
+        }
         /* Update the cache with values collected using DMA */
         if (update_cache) {
             LOG_VERBOSE(BSL_LOG_MODULE,
@@ -1336,6 +1417,7 @@ col_poll_ctr_port_mem_dma(int unit,
 {
     col_thread_handle_t *th;
     col_ctr_list_t *port_mem;
+    int rv;
 
     SHR_FUNC_ENTER(unit);
     SHR_NULL_CHECK(handle, SHR_E_PARAM);
@@ -1348,11 +1430,22 @@ col_poll_ctr_port_mem_dma(int unit,
         /* Iterate over all enabled ports */
         while(ctr_work) {
             ctr_work->vaddr = th->vaddr_buf;
+            if (th->dma_staged && ctr_work->sbusdma_work.items) {
+                rv = col_poll_dma_staged_execute(unit,
+                                                 &ctr_work->sbusdma_work);
+                if (SHR_FAILURE(rv)) {
+                    /* Collected in next sweep */
+                    ctr_work = ctr_work->next;
+                    continue;
+                }
+                ctr_work->dma_done = TRUE;
+            }
             /* Collect the couter and update the Counter cache */
-            SHR_IF_ERR_EXIT(
-                bcmptm_cci_cache_hw_sync(unit, th->hcache,
-                                         col_poll_ctr_port_mem_block_dma,
-                                         ctr_work, TRUE));
+            rv = bcmptm_cci_cache_hw_sync(unit, th->hcache,
+                                          col_poll_ctr_port_mem_block_dma,
+                                          ctr_work, TRUE);
+            ctr_work->dma_done = FALSE;
+            SHR_IF_ERR_EXIT(rv);
             ctr_work = ctr_work->next;
         }
         port_mem = port_mem->next;
@@ -1629,6 +1722,64 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+/*
+ * Account one collection sweep
+ */
+static void
+col_poll_sweep_stats_update(col_thread_handle_t *th,
+                            sal_usecs_t usecs)
+{
+    bcmptm_cci_col_sweep_stats_t *stats = &th->stats;
+
+    sal_spinlock_lock(th->stats_lock);
+    if (stats->sweeps == 0 || usecs < stats->min_usecs) {
+        stats->min_usecs = usecs;
+    }
+    if (usecs > stats->max_usecs) {
+        stats->max_usecs = usecs;
+    }
+    stats->last_usecs = usecs;
+    stats->total_usecs += usecs;
+    stats->sweeps++;
+    sal_spinlock_unlock(th->stats_lock);
+}
+
+/*
+ * Restrict the active ports to the partition of the thread.
+ * Active ports are split in contiguous ranges of equal size,
+ * which keeps the ports of a port block in the same partition.
+ */
+static void
+col_poll_port_partition(col_thread_handle_t *th)
+{
+    bcmdrd_pbmp_t pbmp;
+    int port;
+    int count = 0;
+    int k = 0;
+
+    if (th->num_parts > 1) {
+        BCMDRD_PBMP_ITER(th->config.pbmp, port) {
+            count++;
+        }
+        BCMDRD_PBMP_CLEAR(pbmp);
+        BCMDRD_PBMP_ITER(th->config.pbmp, port) {
+            if ((k * th->num_parts) / count == th->part) {
+                BCMDRD_PBMP_PORT_ADD(pbmp, port);
+            }
+            k++;
+        }
+        BCMDRD_PBMP_ASSIGN(th->config.pbmp, pbmp);
+    }
+
+    count = 0;
+    BCMDRD_PBMP_ITER(th->config.pbmp, port) {
+        count++;
+    }
+    sal_spinlock_lock(th->stats_lock);
+    th->stats.nports = count;
+    sal_spinlock_unlock(th->stats_lock);
+}
+
 /*
  * Counter collection dispatch function
  */
@@ -1636,6 +1787,8 @@ static int
 col_poll_ctr_dispatch(int unit, cci_handle_t handle)
 {
     col_thread_handle_t *th = (col_thread_handle_t *)handle;
+    bool port_col, evict_col;
+    sal_usecs_t start;
 
     SHR_FUNC_ENTER(unit);
     SHR_NULL_CHECK(handle, SHR_E_PARAM);
@@ -1645,9 +1798,19 @@ col_poll_ctr_dispatch(int unit, cci_handle_t handle)
         SHR_RETURN_VAL_EXIT(SHR_E_NONE);
     }
 
+    port_col = (th->config.multiplier[CCI_CTR_TYPE_PORT] != 0) &&
+               COL_TIME(th, CCI_CTR_TYPE_PORT);
+    /* Eviction counters are collected by first thread only */
+    evict_col = (th->part == 0) &&
+                (th->config.multiplier[CCI_CTR_TYPE_EVICT] != 0) &&
+                COL_TIME(th, CCI_CTR_TYPE_EVICT);
+    if (!port_col && !evict_col) {
+        SHR_EXIT();
+    }
+    start = sal_time_usecs();
+
     /* Port Counters */
-    if ((th->config.multiplier[CCI_CTR_TYPE_PORT] != 0) &&
-                      COL_TIME(th, CCI_CTR_TYPE_PORT)) {
+    if (port_col) {
         if (th->config.dma) {
             SHR_IF_ERR_EXIT(
                 col_poll_ctr_port_reg_dma(unit, handle));
@@ -1662,12 +1825,13 @@ col_poll_ctr_dispatch(int unit, cci_handle_t handle)
     }
 
     /* Eviction Counters */
-    if ((th->config.multiplier[CCI_CTR_TYPE_EVICT] != 0) &&
-                      COL_TIME(th, CCI_CTR_TYPE_EVICT)) {
+    if (evict_col) {
         SHR_IF_ERR_EXIT(
             col_poll_ctr_evict_nodma(unit, handle));
     }
 
+    col_poll_sweep_stats_update(th, CCI_DELAY_TIME(start));
+
 exit:
     SHR_FUNC_EXIT();
 }
@@ -1717,12 +1881,17 @@ poll_col_init(int unit,
     SHR_FUNC_ENTER(unit);
     SHR_NULL_CHECK(thrd, SHR_E_PARAM);
 
+    /* Collect only the ports of own partition */
+    col_poll_port_partition(thrd);
+
     /* Initialize Port collection DMA buffers and meta data */
     SHR_IF_ERR_EXIT(
          poll_col_ctr_port_init(unit, thrd));
     /* Initialize Eviction collection DMA buffers and meta data */
-    SHR_IF_ERR_EXIT(
-        poll_col_ctr_evict_init(unit, thrd));
+    if (thrd->part == 0) {
+        SHR_IF_ERR_EXIT(
+            poll_col_ctr_evict_init(unit, thrd));
+    }
 
    /* Allocate buffer */
     thrd->vaddr_buf = NULL;
@@ -1835,6 +2004,8 @@ static int
 col_poll_thread_init(int unit,
                         cci_col_poll_t *col_pol,
                         int prio,
+                        int part,
+                        int num_parts,
                         cci_handle_t *handle)
 {
     col_thread_handle_t    *thrd = NULL;
@@ -1856,9 +2027,16 @@ col_poll_thread_init(int unit,
     thrd->wait_sem = sal_sem_create("WAIT SEM", 0, 0);
     SHR_NULL_CHECK(thrd->wait_sem, SHR_E_MEMORY);
 
+    /* Create statistics lock */
+    thrd->stats_lock = sal_spinlock_create("POLL_STATS");
+    SHR_NULL_CHECK(thrd->stats_lock, SHR_E_MEMORY);
+
     thrd->unit = unit;
     thrd->col_pol = col_pol;
     thrd->state = POL_STATE_STOP;
+    thrd->part = part;
+    thrd->num_parts = num_parts;
+    thrd->dma_staged = (num_parts > 1);
 
     /* Configure the thread properties */
     sal_memset(&thrd->config, 0, sizeof(cci_config_t));
@@ -1891,6 +2069,10 @@ exit:
                 sal_msgq_destroy(thrd->msgq_hdl);
                 thrd->msgq_hdl = NULL;
             }
+            if (thrd->stats_lock) {
+                sal_spinlock_destroy(thrd->stats_lock);
+                thrd->stats_lock = NULL;
+            }
             SHR_FREE(thrd);
         }
     }
@@ -1944,6 +2126,11 @@ col_poll_thread_cleanup(int unit, cci_col_poll_t *col_pol,
         sal_msgq_destroy(thread_handle->msgq_hdl);
     }
 
+    /* Destroy statistics lock */
+    if (thread_handle->stats_lock) {
+        sal_spinlock_destroy(thread_handle->stats_lock);
+    }
+
     /* clean up the thread context */
     SHR_FREE(handle);
 exit:
@@ -1962,7 +2149,8 @@ cci_col_poll_stop(int unit,
     int i;
 
     SHR_FUNC_ENTER(unit);
-    for (i = 0; i < pol->nthreads; i++) {
+    while (pol->nthreads > 0) {
+        i = pol->nthreads - 1;
         SHR_IF_ERR_EXIT(
             col_poll_thread_cleanup(unit, pol, pol->hthreads[i]));
         pol->nthreads--;
@@ -1989,9 +2177,14 @@ bcmptm_cci_col_poll_init(int unit,
     SHR_NULL_CHECK(pol, SHR_E_MEMORY);
     sal_memset(pol, 0, sizeof(cci_col_poll_t));
     pol->parent = con_col;
+    pol->lock = sal_mutex_create("CCI Poll");
+    SHR_NULL_CHECK(pol->lock, SHR_E_MEMORY);
     *handle = pol;
 
 exit:
+    if (SHR_FUNC_ERR()) {
+        SHR_FREE(pol);
+    }
     SHR_FUNC_EXIT();
 
 }
@@ -2008,6 +2201,9 @@ bcmptm_cci_col_poll_cleanup(int unit,
     SHR_FUNC_ENTER(unit);
     SHR_NULL_CHECK(pol, SHR_E_PARAM);
 
+    if (pol->lock) {
+        sal_mutex_destroy(pol->lock);
+    }
     SHR_FREE(pol);
 
 exit:
@@ -2023,12 +2219,25 @@ bcmptm_cci_col_poll_run(int unit,
                         cci_handle_t handle)
 {
     cci_col_poll_t   *pol = (cci_col_poll_t *)handle;
-    int th = 1;
+    cci_config_t config;
+    int th;
     int i;
+    bool locked = FALSE;
 
     SHR_FUNC_ENTER(unit);
     SHR_NULL_CHECK(pol, SHR_E_PARAM);
 
+    SHR_IF_ERR_EXIT(
+        bcmptm_cci_config_get(unit, &config));
+    th = config.nthreads;
+    if (th < 1) {
+        th = 1;
+    } else if (th > CCI_COL_MAX_THREADS) {
+        th = CCI_COL_MAX_THREADS;
+    }
+
+    sal_mutex_take(pol->lock, SAL_MUTEX_FOREVER);
+    locked = TRUE;
     pol->nthreads = 0;
 
     if (th) {
@@ -2042,14 +2251,17 @@ bcmptm_cci_col_poll_run(int unit,
     for (i = 0; i < th; i++) {
         SHR_IF_ERR_EXIT(
             col_poll_thread_init(unit, pol, SAL_THREAD_PRIO_DEFAULT,
-                                 &pol->hthreads[i]));
+                                 i, th, &pol->hthreads[i]));
         pol->nthreads++;
     }
 
 exit:
-    if (SHR_FUNC_ERR()) {
+    if (SHR_FUNC_ERR() && pol) {
         cci_col_poll_stop(unit, pol);
     }
+    if (locked) {
+        sal_mutex_give(pol->lock);
+    }
     SHR_FUNC_EXIT();
 }
 
@@ -2061,14 +2273,50 @@ bcmptm_cci_col_poll_stop(int unit,
                          cci_handle_t handle)
 {
     cci_col_poll_t   *pol = (cci_col_poll_t *)handle;
+    int rv;
 
     SHR_FUNC_ENTER(unit);
     SHR_NULL_CHECK(pol, SHR_E_PARAM);
-    SHR_IF_ERR_EXIT(
-        cci_col_poll_stop(unit, pol));
+    sal_mutex_take(pol->lock, SAL_MUTEX_FOREVER);
+    rv = cci_col_poll_stop(unit, pol);
+    sal_mutex_give(pol->lock);
+    SHR_IF_ERR_EXIT(rv);
 
  exit:
     SHR_FUNC_EXIT();
 
 }
 
+/*
+ * Get sweep statistics of a poll collection thread.
+ */
+int
+bcmptm_cci_col_poll_stats_get(int unit,
+                              cci_handle_t handle,
+                              int thread,
+                              bcmptm_cci_col_sweep_stats_t *stats)
+{
+    cci_col_poll_t   *pol = (cci_col_poll_t *)handle;
+    col_thread_handle_t *th;
+    int rv = SHR_E_PARAM;
+
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(pol, SHR_E_PARAM);
+    SHR_NULL_CHECK(stats, SHR_E_PARAM);
+
+    sal_mutex_take(pol->lock, SAL_MUTEX_FOREVER);
+    if ((thread >= 0) && (thread < pol->nthreads)) {
+        th = (col_thread_handle_t *)pol->hthreads[thread];
+        sal_spinlock_lock(th->stats_lock);
+        *stats = th->stats;
+        sal_spinlock_unlock(th->stats_lock);
+        stats->nthreads = pol->nthreads;
+        rv = SHR_E_NONE;
+    }
+    sal_mutex_give(pol->lock);
+    SHR_IF_ERR_EXIT(rv);
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
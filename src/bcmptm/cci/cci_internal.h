@@ -136,7 +136,15 @@
 
 /*! Maximum number of threads that can be used for counter collection
  */
-#define CCI_COL_MAX_THREADS     (1)
+#ifndef CCI_COL_MAX_THREADS
+#define CCI_COL_MAX_THREADS     (8)
+#endif
+
+/*! Default number of counter collection threads
+ */
+#ifndef CCI_COL_THREADS_DEFAULT
+#define CCI_COL_THREADS_DEFAULT (1)
+#endif
 
 
 /*! If configuration is needed, in case of cold boot or
@@ -291,6 +299,9 @@ typedef struct cci_context_s {
 
     /*! In memory configuration initialized */
     bool init_config;
+
+    /*! Number of counter collection threads, 0 for default */
+    uint8_t nthreads;
 } cci_context_t;
 
 
@@ -307,6 +318,19 @@ bcmptm_cci_config_get(int unit,
                       cci_config_t *config);
 
 
+/*!
+ * \brief Get CCI cache Handle of a unit
+ *
+ * \param [in] unit Logical device id
+ * \param [out] handle of CCI Cache Instance
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_INIT CCI is not initialized
+ */
+extern int
+bcmptm_cci_unit_cache_handle_get(int unit,
+                                 cci_handle_t *handle);
+
 /*!
  * \brief Get CCI cache Handle
  *
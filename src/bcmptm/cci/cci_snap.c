@@ -0,0 +1,594 @@
+/*! \file cci_snap.c
+ *
+ * Bulk counter snapshot
+ *
+ * This file contains the snapshot API, which copies a set of counters
+ * from the counter cache into a flat buffer with a fixed layout.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+/******************************************************************************
+ * Includes
+ */
+#include <bsl/bsl.h>
+#include <sal/sal_types.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_time.h>
+#include <shr/shr_error.h>
+#include <shr/shr_debug.h>
+#include <bcmdrd/bcmdrd_pt.h>
+#include <bcmptm/bcmptm_cci.h>
+#include "cci_cache.h"
+
+/******************************************************************************
+ * Defines
+ */
+
+/*! BSL Module */
+#define BSL_LOG_MODULE BSL_LS_BCMPTM_CCI
+
+/*! Number of symbols changed by the self test */
+#define SNAP_TEST_SYMS      3
+
+/*! Number of counters changed by the self test, two per symbol */
+#define SNAP_TEST_POINTS    (2 * SNAP_TEST_SYMS)
+
+/*! Size of the delta list of the self test */
+#define SNAP_TEST_DELTAS    64
+
+/******************************************************************************
+ * Typedefs
+ */
+
+/*!
+ * \brief Counter changed by the snapshot self test
+ */
+typedef struct snap_test_point_s {
+    /*! Counter map id */
+    bcmptm_cci_ctr_map_id mapid;
+
+    /*! Table instance */
+    int inst;
+
+    /*! Entry index */
+    uint32_t index;
+
+    /*! Counter field */
+    uint32_t field;
+
+    /*! Position in the snapshot buffer */
+    uint32_t pos;
+
+    /*! Value added */
+    uint64_t inc;
+} snap_test_point_t;
+
+/*!
+ * \brief Counter snapshot object
+ */
+struct bcmptm_cci_snap_s {
+    /*! Logical device id */
+    int unit;
+
+    /*! Handle of counter cache */
+    cci_handle_t hcache;
+
+    /*! Number of counter symbols */
+    uint32_t num_maps;
+
+    /*! Layout of counter symbols in buffer */
+    bcmptm_cci_snap_map_t *maps;
+
+    /*! Number of counter table ranges */
+    uint32_t num_ranges;
+
+    /*! Counter table ranges, in buffer order */
+    bcmptm_cci_cache_range_t *ranges;
+
+    /*! Snapshot buffer */
+    uint64_t *buf;
+
+    /*! Number of counters in buffer */
+    uint32_t num_ctrs;
+
+    /*! Buffer is allocated by the snapshot */
+    bool buf_alloc;
+};
+
+/******************************************************************************
+ * Private Functions
+ */
+
+/*!
+ * Find the counter map entry of a symbol
+ */
+static int
+snap_map_find(int unit,
+              cci_handle_t hcache,
+              bcmdrd_sid_t sid,
+              bcmptm_cci_snap_map_t *smap)
+{
+    bcmptm_cci_ctr_map_id mapid, max;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_IF_ERR_EXIT(
+        bcmptm_cci_cache_ctr_map_size(unit, hcache, &max));
+    for (mapid = 0; mapid < max; mapid++) {
+        SHR_IF_ERR_EXIT(
+            bcmptm_cci_cache_snap_map_get(unit, hcache, mapid, smap));
+        if (smap->sid == sid) {
+            SHR_EXIT();
+        }
+    }
+    SHR_IF_ERR_EXIT(SHR_E_NOT_FOUND);
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/*!
+ * Build the snapshot layout.
+ * Only the counts are returned if maps and ranges are NULL.
+ * Adjacent symbols in the counter table share one copy range.
+ */
+static int
+snap_layout_build(int unit,
+                  cci_handle_t hcache,
+                  const bcmdrd_sid_t *sids,
+                  uint32_t num_sids,
+                  bcmptm_cci_snap_map_t *maps,
+                  bcmptm_cci_cache_range_t *ranges,
+                  uint32_t *num_maps,
+                  uint32_t *num_ranges,
+                  uint32_t *num_ctrs)
+{
+    bcmptm_cci_snap_map_t smap;
+    bcmptm_cci_ctr_map_id max;
+    uint32_t i, n;
+    uint32_t nr = 0, nc = 0;
+    uint32_t end = 0;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_IF_ERR_EXIT(
+        bcmptm_cci_cache_ctr_map_size(unit, hcache, &max));
+    n = sids ? num_sids : max;
+
+    for (i = 0; i < n; i++) {
+        if (sids) {
+            SHR_IF_ERR_EXIT(
+                snap_map_find(unit, hcache, sids[i], &smap));
+        } else {
+            SHR_IF_ERR_EXIT(
+                bcmptm_cci_cache_snap_map_get(unit, hcache, i, &smap));
+        }
+        if (nr > 0 && smap.base == end) {
+            if (ranges) {
+                ranges[nr - 1].size += smap.num_ctrs;
+            }
+        } else {
+            if (ranges) {
+                ranges[nr].offset = smap.base;
+                ranges[nr].size = smap.num_ctrs;
+            }
+            nr++;
+        }
+        end = smap.base + smap.num_ctrs;
+        if (maps) {
+            maps[i] = smap;
+            maps[i].base = nc;
+        }
+        nc += smap.num_ctrs;
+    }
+
+    *num_maps = n;
+    *num_ranges = nr;
+    *num_ctrs = nc;
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/*!
+ * Add to the test counters, take the snapshot and check that exactly the
+ * added values are reported as deltas.
+ */
+static int
+snap_test_step(int unit, bcmptm_cci_snap_t *sn,
+               snap_test_point_t *pts, uint32_t num_pts, bool undo,
+               bcmptm_cci_snap_delta_t *deltas,
+               bcmptm_cci_snap_test_t *result)
+{
+    uint32_t i, d, num_changed, found;
+    uint64_t inc;
+
+    SHR_FUNC_ENTER(unit);
+
+    for (i = 0; i < num_pts; i++) {
+        inc = undo ? (0 - pts[i].inc) : pts[i].inc;
+        SHR_IF_ERR_EXIT(
+            bcmptm_cci_cache_sw_count_add(unit, sn->hcache, pts[i].mapid,
+                                          pts[i].inst, pts[i].index,
+                                          pts[i].field, inc));
+    }
+    SHR_IF_ERR_EXIT(
+        bcmptm_cci_snap_take(unit, sn, SNAP_TEST_DELTAS, deltas,
+                             &num_changed));
+    if (num_changed > SNAP_TEST_DELTAS) {
+        num_changed = SNAP_TEST_DELTAS;
+    }
+
+    found = 0;
+    for (i = 0; i < num_pts; i++) {
+        inc = undo ? (0 - pts[i].inc) : pts[i].inc;
+        for (d = 0; d < num_changed; d++) {
+            if (deltas[d].pos == pts[i].pos) {
+                break;
+            }
+        }
+        if (d == num_changed) {
+            LOG_ERROR(BSL_LOG_MODULE,
+                      (BSL_META_U(unit, "Snapshot test: no delta at %u "
+                                  "(%s inst %d index %u field %u)\n"),
+                       pts[i].pos,
+                       bcmdrd_pt_sid_to_name(unit, sn->maps[pts[i].mapid].sid),
+                       pts[i].inst, pts[i].index, pts[i].field));
+            result->mismatches++;
+            continue;
+        }
+        found++;
+        if (deltas[d].delta != inc || deltas[d].value != sn->buf[pts[i].pos]) {
+            LOG_ERROR(BSL_LOG_MODULE,
+                      (BSL_META_U(unit, "Snapshot test: wrong delta at %u\n"),
+                       pts[i].pos));
+            result->mismatches++;
+        }
+    }
+    result->others += num_changed - found;
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/******************************************************************************
+ * Public Functions
+ */
+
+int
+bcmptm_cci_snap_size_get(int unit, const bcmdrd_sid_t *sids,
+                         uint32_t num_sids, uint32_t *num_ctrs)
+{
+    cci_handle_t hcache;
+    uint32_t num_maps, num_ranges;
+
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(num_ctrs, SHR_E_PARAM);
+
+    SHR_IF_ERR_EXIT(
+        bcmptm_cci_unit_cache_handle_get(unit, &hcache));
+    SHR_IF_ERR_EXIT(
+        snap_layout_build(unit, hcache, sids, num_sids, NULL, NULL,
+                          &num_maps, &num_ranges, num_ctrs));
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmptm_cci_snap_create(int unit, const bcmptm_cci_snap_cfg_t *cfg,
+                       bcmptm_cci_snap_t **snap)
+{
+    bcmptm_cci_snap_t *sn = NULL;
+    cci_handle_t hcache;
+    uint32_t num_maps, num_ranges, num_ctrs;
+
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(cfg, SHR_E_PARAM);
+    SHR_NULL_CHECK(snap, SHR_E_PARAM);
+
+    SHR_IF_ERR_EXIT(
+        bcmptm_cci_unit_cache_handle_get(unit, &hcache));
+    SHR_IF_ERR_EXIT(
+        snap_layout_build(unit, hcache, cfg->sids, cfg->num_sids, NULL, NULL,
+                          &num_maps, &num_ranges, &num_ctrs));
+    if (cfg->buf && cfg->buf_ctrs < num_ctrs) {
+        SHR_IF_ERR_EXIT(SHR_E_PARAM);
+    }
+
+    SHR_ALLOC(sn, sizeof(*sn), "bcmptmCciSnap");
+    SHR_NULL_CHECK(sn, SHR_E_MEMORY);
+    sal_memset(sn, 0, sizeof(*sn));
+    sn->unit = unit;
+    sn->hcache = hcache;
+
+    if (num_maps > 0) {
+        SHR_ALLOC(sn->maps, num_maps * sizeof(bcmptm_cci_snap_map_t),
+                  "bcmptmCciSnapMaps");
+        SHR_NULL_CHECK(sn->maps, SHR_E_MEMORY);
+        SHR_ALLOC(sn->ranges, num_ranges * sizeof(bcmptm_cci_cache_range_t),
+                  "bcmptmCciSnapRanges");
+        SHR_NULL_CHECK(sn->ranges, SHR_E_MEMORY);
+    }
+    SHR_IF_ERR_EXIT(
+        snap_layout_build(unit, hcache, cfg->sids, cfg->num_sids,
+                          sn->maps, sn->ranges,
+                          &sn->num_maps, &sn->num_ranges, &sn->num_ctrs));
+
+    if (cfg->buf) {
+        sn->buf = cfg->buf;
+    } else if (sn->num_ctrs > 0) {
+        SHR_ALLOC(sn->buf, sn->num_ctrs * sizeof(uint64_t),
+                  "bcmptmCciSnapBuf");
+        SHR_NULL_CHECK(sn->buf, SHR_E_MEMORY);
+        sn->buf_alloc = TRUE;
+    }
+
+    /* Initial values, deltas are reported against these */
+    if (sn->num_ctrs > 0) {
+        SHR_IF_ERR_EXIT(
+            bcmptm_cci_cache_snapshot(unit, hcache, sn->ranges,
+                                      sn->num_ranges, sn->buf,
+                                      0, NULL, NULL));
+    }
+    *snap = sn;
+
+exit:
+    if (SHR_FUNC_ERR() && sn) {
+        bcmptm_cci_snap_destroy(unit, sn);
+    }
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmptm_cci_snap_destroy(int unit, bcmptm_cci_snap_t *snap)
+{
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(snap, SHR_E_PARAM);
+
+    if (snap->buf_alloc) {
+        SHR_FREE(snap->buf);
+    }
+    SHR_FREE(snap->ranges);
+    SHR_FREE(snap->maps);
+    SHR_FREE(snap);
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmptm_cci_snap_layout_get(int unit, bcmptm_cci_snap_t *snap,
+                           uint32_t max_maps, bcmptm_cci_snap_map_t *maps,
+                           uint32_t *num_maps, const uint64_t **buf,
+                           uint32_t *num_ctrs)
+{
+    uint32_t n;
+
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(snap, SHR_E_PARAM);
+    SHR_NULL_CHECK(num_maps, SHR_E_PARAM);
+
+    if (maps) {
+        n = (max_maps < snap->num_maps) ? max_maps : snap->num_maps;
+        if (n > 0) {
+            sal_memcpy(maps, snap->maps, n * sizeof(bcmptm_cci_snap_map_t));
+        }
+    }
+    *num_maps = snap->num_maps;
+    if (buf) {
+        *buf = snap->buf;
+    }
+    if (num_ctrs) {
+        *num_ctrs = snap->num_ctrs;
+    }
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmptm_cci_snap_take(int unit, bcmptm_cci_snap_t *snap,
+                     uint32_t max_deltas, bcmptm_cci_snap_delta_t *deltas,
+                     uint32_t *num_changed)
+{
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(snap, SHR_E_PARAM);
+
+    if (num_changed) {
+        *num_changed = 0;
+    }
+    if (snap->num_ctrs == 0) {
+        SHR_EXIT();
+    }
+    SHR_IF_ERR_EXIT(
+        bcmptm_cci_cache_snapshot(unit, snap->hcache, snap->ranges,
+                                  snap->num_ranges, snap->buf,
+                                  max_deltas, deltas, num_changed));
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmptm_cci_snap_test(int unit, bcmptm_cci_snap_test_t *result)
+{
+    bcmptm_cci_snap_t *sn = NULL;
+    bcmptm_cci_snap_cfg_t cfg;
+    bcmptm_cci_snap_delta_t *deltas = NULL;
+    bcmptm_cci_snap_map_t *map;
+    snap_test_point_t pts[SNAP_TEST_POINTS];
+    uint32_t i, k, last, num_pts = 0;
+    sal_usecs_t start;
+
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(result, SHR_E_PARAM);
+    sal_memset(result, 0, sizeof(*result));
+
+    sal_memset(&cfg, 0, sizeof(cfg));
+    SHR_IF_ERR_EXIT(
+        bcmptm_cci_snap_create(unit, &cfg, &sn));
+    result->num_ctrs = sn->num_ctrs;
+
+    /* Layout of every symbol must cover exactly its counters */
+    for (i = 0; i < sn->num_maps; i++) {
+        map = &sn->maps[i];
+        if (map->num_inst * map->num_index * map->num_fields !=
+            map->num_ctrs) {
+            LOG_ERROR(BSL_LOG_MODULE,
+                      (BSL_META_U(unit, "Snapshot test: layout of %s "
+                                  "covers %u of %u counters\n"),
+                       bcmdrd_pt_sid_to_name(unit, map->sid),
+                       map->num_inst * map->num_index * map->num_fields,
+                       map->num_ctrs));
+            result->mismatches++;
+        }
+    }
+
+    /*
+     * First and last counter of the first, middle and last symbol.
+     * Map i of a snapshot of all counters is counter map id i.
+     */
+    last = sn->num_maps;
+    for (k = 0; k < SNAP_TEST_SYMS && sn->num_maps > 0; k++) {
+        i = (sn->num_maps - 1) * k / (SNAP_TEST_SYMS - 1);
+        map = &sn->maps[i];
+        if (map->num_ctrs == 0 || i == last) {
+            continue;
+        }
+        last = i;
+        pts[num_pts].mapid = i;
+        pts[num_pts].inst = 0;
+        pts[num_pts].index = map->index_min;
+        pts[num_pts].field = 0;
+        pts[num_pts].pos = map->base;
+        pts[num_pts].inc = 1 + num_pts;
+        num_pts++;
+        if (map->num_ctrs == 1) {
+            continue;
+        }
+        pts[num_pts].mapid = i;
+        pts[num_pts].inst = map->num_inst - 1;
+        pts[num_pts].index = map->index_min + map->num_index - 1;
+        pts[num_pts].field = map->num_fields - 1;
+        pts[num_pts].pos = map->base + map->num_ctrs - 1;
+        pts[num_pts].inc = (uint64_t)0x100000000ULL + num_pts;
+        num_pts++;
+    }
+    result->num_checked = num_pts;
+    if (num_pts == 0) {
+        SHR_EXIT();
+    }
+
+    SHR_ALLOC(deltas, SNAP_TEST_DELTAS * sizeof(bcmptm_cci_snap_delta_t),
+              "bcmptmCciSnapTestDeltas");
+    SHR_NULL_CHECK(deltas, SHR_E_MEMORY);
+
+    start = sal_time_usecs();
+    SHR_IF_ERR_EXIT(
+        bcmptm_cci_snap_take(unit, sn, 0, NULL, NULL));
+    result->take_usecs = sal_time_usecs() - start;
+
+    SHR_IF_ERR_EXIT(
+        snap_test_step(unit, sn, pts, num_pts, FALSE, deltas, result));
+    SHR_IF_ERR_EXIT(
+        snap_test_step(unit, sn, pts, num_pts, TRUE, deltas, result));
+
+    if (result->mismatches > 0) {
+        SHR_IF_ERR_EXIT(SHR_E_FAIL);
+    }
+
+exit:
+    SHR_FREE(deltas);
+    if (sn) {
+        bcmptm_cci_snap_destroy(unit, sn);
+    }
+    SHR_FUNC_EXIT();
+}
@@ -294,6 +294,35 @@ bcmptm_mreq_unlock(int unit)
     return tmp_rv;
 }
 
+int
+bcmptm_mreq_idle_lock(int unit, int wait_usecs)
+{
+    int tmp_rv;
+    SHR_FUNC_ENTER(unit);
+
+    if (sal_mutex_take(mreq_mutex[unit], wait_usecs) != SHR_E_NONE) {
+        SHR_RETURN_VAL_EXIT(SHR_E_BUSY);
+    }
+    LOG_VERBOSE(BSL_LOG_MODULE,
+        (BSL_META_U(unit, "!! idle mreq_path got mreq_mutex \n")));
+
+    /* Wait for wal_empty */
+    tmp_rv = bcmptm_wal_drain(unit, FALSE); /* stop = FALSE */
+    if (SHR_FAILURE(tmp_rv)) {
+        (void)bcmptm_mreq_unlock(unit);
+    }
+    SHR_IF_ERR_EXIT(tmp_rv);
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmptm_mreq_idle_unlock(int unit)
+{
+    return bcmptm_mreq_unlock(unit);
+}
+
 int
 bcmptm_scor_read(int unit,
                  uint32_t flags,
@@ -300,6 +300,9 @@ bcmptm_ser_init(int unit, bool warm)
     /* space for slice mode information */
     bcmptm_ser_slice_mode_info_init(unit, warm);
 
+    rv = bcmptm_ser_scan_sched_unit_init(unit);
+    SHR_IF_ERR_EXIT(rv);
+
     if (!bcmptm_ser_checking_enable(unit)) {
         rv = SHR_E_NONE;
         SHR_RETURN_VAL_EXIT(rv);
@@ -343,6 +346,8 @@ bcmptm_ser_cleanup(int unit, bool warm)
     /* space for slice mode information */
     bcmptm_ser_slice_mode_info_deinit(unit, warm);
 
+    bcmptm_ser_scan_sched_unit_cleanup(unit);
+
     if (!bcmptm_ser_checking_enable(unit)) {
         rv = SHR_E_NONE;
         SHR_RETURN_VAL_EXIT(rv);
@@ -117,4 +117,193 @@ int bcmptm_cci_flex_counter_pool_enable(int unit,
                                         bcmdrd_sid_t sid,
                                         bool enable);
 
+/*!
+ * \brief Counter snapshot object.
+ */
+typedef struct bcmptm_cci_snap_s bcmptm_cci_snap_t;
+
+/*!
+ * \brief Layout of the counters of one symbol in a snapshot buffer.
+ *
+ * The counter of field \c f of entry \c index in table instance \c inst
+ * is at buf[base + (inst * num_index + index - index_min) * num_fields + f],
+ * and num_ctrs is num_inst * num_index * num_fields.
+ * The layout does not change while the snapshot object exists.
+ */
+typedef struct bcmptm_cci_snap_map_s {
+    /*! Counter symbol ID */
+    bcmdrd_sid_t sid;
+
+    /*! Position of the first counter of the symbol in the buffer */
+    uint32_t base;
+
+    /*! Number of counters of the symbol in the buffer */
+    uint32_t num_ctrs;
+
+    /*! Number of table instances */
+    uint32_t num_inst;
+
+    /*! First entry index of a table instance */
+    uint32_t index_min;
+
+    /*! Number of entries per table instance */
+    uint32_t num_index;
+
+    /*! Number of counter fields per entry */
+    uint32_t num_fields;
+} bcmptm_cci_snap_map_t;
+
+/*!
+ * \brief Counter changed since the previous snapshot.
+ */
+typedef struct bcmptm_cci_snap_delta_s {
+    /*! Position of the counter in the snapshot buffer */
+    uint32_t pos;
+
+    /*! New counter value */
+    uint64_t value;
+
+    /*! Difference to the previous value, modulo 2^64 */
+    uint64_t delta;
+} bcmptm_cci_snap_delta_t;
+
+/*!
+ * \brief Counter snapshot configuration.
+ */
+typedef struct bcmptm_cci_snap_cfg_s {
+    /*! Counter symbols to include, NULL for all counters */
+    const bcmdrd_sid_t *sids;
+
+    /*! Number of symbols in \c sids */
+    uint32_t num_sids;
+
+    /*! Caller provided snapshot buffer, NULL to allocate one */
+    uint64_t *buf;
+
+    /*! Number of counters \c buf can hold */
+    uint32_t buf_ctrs;
+} bcmptm_cci_snap_cfg_t;
+
+/*!
+ * \brief Get the number of counters in a snapshot
+ *
+ * \param [in] unit Logical device id
+ * \param [in] sids Counter symbols, NULL for all counters
+ * \param [in] num_sids Number of symbols
+ * \param [out] num_ctrs Number of 64-bit counters in the snapshot
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_NOT_FOUND A symbol is not a counter
+ */
+extern int
+bcmptm_cci_snap_size_get(int unit, const bcmdrd_sid_t *sids,
+                         uint32_t num_sids, uint32_t *num_ctrs);
+
+/*!
+ * \brief Create a counter snapshot
+ *
+ * The snapshot buffer is filled with the current counter values.
+ *
+ * \param [in] unit Logical device id
+ * \param [in] cfg Snapshot configuration
+ * \param [out] snap Snapshot object
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_PARAM Caller buffer is too small
+ * \retval SHR_E_NOT_FOUND A symbol is not a counter
+ */
+extern int
+bcmptm_cci_snap_create(int unit, const bcmptm_cci_snap_cfg_t *cfg,
+                       bcmptm_cci_snap_t **snap);
+
+/*!
+ * \brief Destroy a counter snapshot
+ *
+ * \param [in] unit Logical device id
+ * \param [in] snap Snapshot object
+ *
+ * \retval SHR_E_NONE Success
+ */
+extern int
+bcmptm_cci_snap_destroy(int unit, bcmptm_cci_snap_t *snap);
+
+/*!
+ * \brief Get the layout of a counter snapshot
+ *
+ * \param [in] unit Logical device id
+ * \param [in] snap Snapshot object
+ * \param [in] max_maps Size of \c maps
+ * \param [out] maps Symbol layouts, may be NULL
+ * \param [out] num_maps Number of symbols in the snapshot
+ * \param [out] buf Snapshot buffer, may be NULL
+ * \param [out] num_ctrs Number of counters in the buffer, may be NULL
+ *
+ * \retval SHR_E_NONE Success
+ */
+extern int
+bcmptm_cci_snap_layout_get(int unit, bcmptm_cci_snap_t *snap,
+                           uint32_t max_maps, bcmptm_cci_snap_map_t *maps,
+                           uint32_t *num_maps, const uint64_t **buf,
+                           uint32_t *num_ctrs);
+
+/*!
+ * \brief Take a counter snapshot
+ *
+ * All counters of the snapshot are copied from the counter cache in one
+ * step under the cache lock. Counters that differ from the previous
+ * snapshot are reported in \c deltas, in buffer order.
+ *
+ * \param [in] unit Logical device id
+ * \param [in] snap Snapshot object
+ * \param [in] max_deltas Size of \c deltas
+ * \param [out] deltas Changed counters, NULL if not needed
+ * \param [out] num_changed Number of changed counters, may be larger
+ *                          than \c max_deltas, may be NULL
+ *
+ * \retval SHR_E_NONE Success
+ */
+extern int
+bcmptm_cci_snap_take(int unit, bcmptm_cci_snap_t *snap,
+                     uint32_t max_deltas, bcmptm_cci_snap_delta_t *deltas,
+                     uint32_t *num_changed);
+
+/*!
+ * \brief Results of the counter snapshot self test.
+ */
+typedef struct bcmptm_cci_snap_test_s {
+    /*! Number of counters in the snapshot */
+    uint32_t num_ctrs;
+
+    /*! Number of counters changed by the test */
+    uint32_t num_checked;
+
+    /*! Number of wrong layouts, missing or wrong deltas */
+    uint32_t mismatches;
+
+    /*! Number of changes not made by the test */
+    uint32_t others;
+
+    /*! Time of the last take of all counters, in usecs */
+    uint32_t take_usecs;
+} bcmptm_cci_snap_test_t;
+
+/*!
+ * \brief Counter snapshot self test
+ *
+ * A snapshot of all counters is created and the layout of every symbol
+ * is checked. Known values are added to the first and the last counter
+ * of a few symbols in the counter cache, and a take must report exactly
+ * these deltas at the positions given by the layout. The values are
+ * then subtracted again and checked the same way.
+ * Counters must not change otherwise while the test runs.
+ *
+ * \param [in] unit Logical device id
+ * \param [out] result Test results
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_FAIL Wrong layout or deltas
+ */
+extern int
+bcmptm_cci_snap_test(int unit, bcmptm_cci_snap_test_t *result);
+
 #endif /* BCMPTM_CCI_H */
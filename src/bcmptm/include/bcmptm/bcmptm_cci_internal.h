@@ -149,6 +149,32 @@ typedef struct bcmptm_cci_ser_req_info_s {
     bcmbd_pt_dyn_info_t dyn_info;   /* Dynamic info associated with SID */
 } bcmptm_cci_ser_req_info_t;
 
+/*!
+ * \brief Counter collection sweep statistics of one collection thread.
+ */
+typedef struct bcmptm_cci_col_sweep_stats_s {
+    /*! Number of running collection threads */
+    int nthreads;
+
+    /*! Number of ports collected by this thread */
+    int nports;
+
+    /*! Number of completed collection sweeps */
+    uint64_t sweeps;
+
+    /*! Duration of the last sweep in usecs */
+    uint32_t last_usecs;
+
+    /*! Shortest sweep in usecs */
+    uint32_t min_usecs;
+
+    /*! Longest sweep in usecs */
+    uint32_t max_usecs;
+
+    /*! Total time spent in sweeps in usecs */
+    uint64_t total_usecs;
+} bcmptm_cci_col_sweep_stats_t;
+
 /******************************************************************************
  * Function prototypes
  */
@@ -384,6 +410,36 @@ bcmptm_pt_cci_ser_array_req(int unit,
                             bcmptm_cci_ser_req_info_t *ser_req_info,
                             int array_count);
 
+/*!
+ * \brief Set the number of counter collection threads
+ *
+ * The active ports are partitioned between the threads, and each thread
+ * owns the DMA work of its ports. If collection is running, the
+ * collection threads are restarted with the new count.
+ *
+ * \param [in] unit Logical device id
+ * \param [in] nthreads Number of threads, 1 to CCI_COL_MAX_THREADS
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_PARAM Invalid number of threads
+ */
+extern int
+bcmptm_cci_col_threads_set(int unit, int nthreads);
+
+/*!
+ * \brief Get sweep statistics of a counter collection thread
+ *
+ * \param [in] unit Logical device id
+ * \param [in] thread Collection thread index
+ * \param [out] stats Sweep statistics
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_PARAM Thread is not running
+ */
+extern int
+bcmptm_cci_col_sweep_stats_get(int unit, int thread,
+                               bcmptm_cci_col_sweep_stats_t *stats);
+
 /*!
  * \brief Stop (terminate thread , free resources)
  *
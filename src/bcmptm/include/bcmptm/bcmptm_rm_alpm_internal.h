@@ -190,6 +190,34 @@ typedef struct bcmptm_rm_alpm_rsp_info_s {
     uint8_t rsp_entry_count;
 } bcmptm_rm_alpm_rsp_info_t;
 
+/*! \brief Route churn benchmark results of one trie representation. */
+typedef struct bcmptm_rm_alpm_trie_bench_s {
+
+/*! \brief Number of routes inserted. */
+    uint32_t routes;
+
+/*! \brief Time to insert all routes, in usecs. */
+    uint32_t insert_usecs;
+
+/*! \brief Number of LPM lookups. */
+    uint32_t lookups;
+
+/*! \brief Time of all LPM lookups, in usecs. */
+    uint32_t lpm_usecs;
+
+/*! \brief Number of churn operations, each a delete and an insert. */
+    uint32_t churns;
+
+/*! \brief Time of all churn operations, in usecs. */
+    uint32_t churn_usecs;
+
+/*! \brief Time to delete all routes, in usecs. */
+    uint32_t delete_usecs;
+
+/*! \brief Number of LPM results different from the binary trie. */
+    uint32_t mismatches;
+} bcmptm_rm_alpm_trie_bench_t;
+
 /*******************************************************************************
   Function prototypes
  */
@@ -337,5 +365,33 @@ bcmptm_rm_alpm_global_init(void);
 extern int
 bcmptm_rm_alpm_global_cleanup(void);
 
+/*!
+ * \brief Run the route churn benchmark of the ALPM tries.
+ *
+ * The same random route set is run on the binary trie and on the stride
+ * trie: insert all routes, LPM lookups of addresses covered by the routes,
+ * churn (delete a random route and insert a new one), then delete all.
+ * The LPM results of the stride trie are checked against the binary trie.
+ *
+ * \param [in] v6 Use IPv6 routes, otherwise IPv4.
+ * \param [in] routes Number of routes.
+ * \param [in] churns Number of churn operations.
+ * \param [in] lookups Number of LPM lookups.
+ * \param [in] seed Random seed.
+ * \param [out] binary Results of the binary trie.
+ * \param [out] stride Results of the stride trie.
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_MEMORY Out of memory, or ALPM global resources not ready.
+ */
+extern int
+bcmptm_rm_alpm_trie_bench(bool v6,
+                          uint32_t routes,
+                          uint32_t churns,
+                          uint32_t lookups,
+                          uint32_t seed,
+                          bcmptm_rm_alpm_trie_bench_t *binary,
+                          bcmptm_rm_alpm_trie_bench_t *stride);
+
 #endif /* BCMPTM_RM_ALPM_INTERNAL_H */
 
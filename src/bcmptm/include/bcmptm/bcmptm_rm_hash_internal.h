@@ -635,6 +635,25 @@ typedef struct bcmptm_rm_hash_rhash_cfg_s {
     uint64_t action_data_b[BCMPTM_RM_HASH_RHASH_ACTION_TABLE_DEPTH];
 } bcmptm_rm_hash_rhash_cfg_t;
 
+/*! \brief Results of the hash vector CRC self test. */
+typedef struct bcmptm_rm_hash_crc_test_s {
+
+/*! \brief Number of random keys checked. */
+    uint32_t keys;
+
+/*! \brief Number of CRC16 results different from the reference. */
+    uint32_t crc16_mismatches;
+
+/*! \brief Number of CRC32 results different from the reference. */
+    uint32_t crc32_mismatches;
+
+/*! \brief Time of the reference CRC16 and CRC32 of all keys, in usecs. */
+    uint32_t ref_usecs;
+
+/*! \brief Time of the SDK CRC16 and CRC32 of all keys, in usecs. */
+    uint32_t shr_usecs;
+} bcmptm_rm_hash_crc_test_t;
+
 /*******************************************************************************
  * Global variables
  */
@@ -849,5 +868,25 @@ extern int
 bcmptm_rm_hash_pt_info_update(int unit,
                               bcmptm_rm_hash_pt_chg_t *pt_chg);
 
+/*!
+ * \brief Check the hash vector CRCs against a reference implementation.
+ *
+ * Random keys of random bit lengths up to a full PT entry are hashed by
+ * \ref shr_crc16b and \ref shr_crc32b, and by a bitwise table CRC which
+ * is the reference the hardware hash vectors are defined by. Trailing
+ * partial bytes are covered by the random bit lengths.
+ *
+ * \param [in] keys Number of random keys.
+ * \param [in] seed Random seed.
+ * \param [out] result Test results.
+ *
+ * \retval SHR_E_NONE All the CRC values match the reference.
+ * \retval SHR_E_FAIL Some CRC values do not match the reference.
+ * \retval SHR_E_PARAM Invalid parameters.
+ */
+extern int
+bcmptm_rm_hash_crc_test(int keys, int seed,
+                        bcmptm_rm_hash_crc_test_t *result);
+
 #endif /* BCMPTM_RM_HASH_INTERNAL_H */
 
@@ -888,6 +888,38 @@ typedef struct bcmptm_rm_tcam_trans_info_s {
     uint32_t sign_word;
 } bcmptm_rm_tcam_trans_info_t;
 
+/*! \brief Results of one run of the TCAM slot allocation benchmark.
+ */
+typedef struct bcmptm_rm_tcam_prio_bench_s {
+
+/*! \brief Number of TCAM entries. */
+    uint32_t entries;
+
+/*! \brief Number of entries inserted into the empty TCAM. */
+    uint32_t inserts;
+
+/*! \brief Time to insert the entries, in usecs. */
+    uint32_t insert_usecs;
+
+/*! \brief Number of churn operations, each a delete and an insert. */
+    uint32_t churns;
+
+/*! \brief Time of all churn operations, in usecs. */
+    uint32_t churn_usecs;
+
+/*! \brief Number of target slot lookups without insert. */
+    uint32_t lookups;
+
+/*! \brief Time of all target slot lookups, in usecs. */
+    uint32_t lookup_usecs;
+
+/*! \brief Number of entry moves done to make room for inserts. */
+    uint32_t moves;
+
+/*! \brief Number of target slots different from the linear scan. */
+    uint32_t mismatches;
+} bcmptm_rm_tcam_prio_bench_t;
+
 /*******************************************************************************
  * Global variables
  */
@@ -1068,4 +1100,33 @@ bcmptm_rm_tcam_memreg_update(int unit,
                         bcmptm_rm_tcam_sid_t sid_enum,
                         bcmptm_rm_tcam_sid_info_t *sid_info);
 
+/*!
+ * \brief Run the slot allocation benchmark of priority TCAMs.
+ *
+ * The same random entry sequence is run on a simulated entry id based
+ * TCAM twice: once finding target slots with the linear scan, and once with
+ * the priority index. The TCAM is filled to 90% and then churned (delete a
+ * random entry and insert one of random priority). Target slots of random
+ * priorities are then looked up without inserting. Target slots found by
+ * the index are checked against the linear scan.
+ *
+ * \param [in] unit Logical device id
+ * \param [in] num_entries Number of TCAM entries.
+ * \param [in] churns Number of churn operations.
+ * \param [in] seed Random seed.
+ * \param [out] scan Results of the linear scan.
+ * \param [out] indexed Results of the priority index.
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_PARAM Invalid parameters
+ * \retval SHR_E_MEMORY Out of memory
+ */
+extern int
+bcmptm_rm_tcam_prio_bench(int unit,
+                          uint32_t num_entries,
+                          uint32_t churns,
+                          uint32_t seed,
+                          bcmptm_rm_tcam_prio_bench_t *scan,
+                          bcmptm_rm_tcam_prio_bench_t *indexed);
+
 #endif /* BCMPTM_RM_TCAM_INTERNAL_H */
@@ -387,4 +387,30 @@ bcmptm_mreq_lock(int unit);
 extern int
 bcmptm_mreq_unlock(int unit);
 
+/*!
+  \brief Take lock for modeled path writer to update PTs outside of a trans
+  - Fails right away, or after wait_usecs, if a trans holds the lock.
+  - Waits for the WAL to drain, so PTcache and HW hold the same data until
+  bcmptm_mreq_idle_unlock() is called. Interactive writes issued in between
+  update both and are not reordered with modeled path writes.
+
+  \param [in] unit Logical device id
+  \param [in] wait_usecs Time to wait for the lock, or SAL_MUTEX_NOWAIT
+
+  \retval SHR_E_NONE Success
+  \retval SHR_E_BUSY Lock is held by a trans */
+
+extern int
+bcmptm_mreq_idle_lock(int unit, int wait_usecs);
+
+/*!
+  \brief Release lock taken with bcmptm_mreq_idle_lock()
+
+  \param [in] unit Logical device id
+
+  \retval SHR_E_NONE Success */
+
+extern int
+bcmptm_mreq_idle_unlock(int unit);
+
 #endif /* BCMPTM_SCOR_INTERNAL_H */
@@ -120,6 +120,67 @@
 /*! All PTs need to be cleared, don't care whether SER parity or ecc checking of PTs is enable. */
 #define PT_CLEAR_ALL     (PT_CLEAR_BEFORE_SER_ENABLE | PT_CLEAR_AFTER_SER_ENABLE)
 
+/*******************************************************************************
+ * Typedefs
+ */
+/*! S/W memory scan threads */
+typedef enum bcmptm_ser_scan_type_e {
+    /*! SRAM scan thread */
+    BCMPTM_SER_SCAN_SRAM = 0,
+    /*! TCAM scan thread */
+    BCMPTM_SER_SCAN_TCAM,
+    /*! Must be last one */
+    BCMPTM_SER_SCAN_COUNT
+} bcmptm_ser_scan_type_t;
+
+/*! Coverage statistics of S/W memory scan for one PT */
+typedef struct bcmptm_ser_scan_stats_s {
+    /*! Num of completed scans of all entries and instances of the PT */
+    uint32_t rounds;
+    /*! Time spent by last complete scan of the PT, in usecs */
+    uint64_t scan_usecs;
+    /*! Time between last two complete scans of the PT, in usecs */
+    uint64_t period_usecs;
+    /*! Maximum of period_usecs */
+    uint64_t period_max_usecs;
+    /*! Num of periods longer than the scan SLA */
+    uint32_t sla_misses;
+} bcmptm_ser_scan_stats_t;
+
+/*! Statistics of bandwidth budget of one S/W memory scan thread */
+typedef struct bcmptm_ser_scan_sched_stats_s {
+    /*! Num of entries read */
+    uint64_t entries;
+    /*! Num of times scan yielded to WAL traffic */
+    uint32_t backoffs;
+    /*! Time spent yielding to WAL traffic, in usecs */
+    uint64_t backoff_usecs;
+    /*! Num of chunks read at minimum rate while yielding */
+    uint32_t throttled;
+    /*! Maximum of period_usecs in \ref bcmptm_ser_scan_stats_t over all PTs */
+    uint64_t period_max_usecs;
+    /*! Sum of sla_misses in \ref bcmptm_ser_scan_stats_t over all PTs */
+    uint32_t sla_misses;
+} bcmptm_ser_scan_sched_stats_t;
+
+/*! Results of the self test of S/W memory scan pacing */
+typedef struct bcmptm_ser_scan_sched_test_s {
+    /*! Budget of the test, in entries per scan interval */
+    uint32_t entries;
+    /*! Entries read per scan interval while WAL is idle */
+    uint32_t idle_entries;
+    /*! Entries read per scan interval while WAL is busy */
+    uint32_t busy_entries;
+    /*! Entries read without sleeping once WAL is idle again */
+    uint32_t catchup_entries;
+    /*! Num of times scan yielded to WAL traffic */
+    uint32_t backoffs;
+    /*! Time spent yielding to WAL traffic, in usecs */
+    uint64_t backoff_usecs;
+    /*! Num of failed checks */
+    uint32_t failures;
+} bcmptm_ser_scan_sched_test_t;
+
 /*!
  * \brief clear some PTs before or after enabling SER parity or ecc checking
  * \n If some PTs are not cleared, those PTs can trigger SER interrupt by mistakes.
@@ -342,6 +403,77 @@ bcmptm_ser_sram_scan_start(int unit, bcmdrd_sid_t beginning_sid);
 extern int
 bcmptm_ser_sram_scan_stop(int unit, int free_resource);
 
+/*!
+ * \brief Get coverage statistics of S/W memory scan for one PT.
+ *
+ * Period of a PT is the longest time any of its entries stays unscanned,
+ * so it is compared against the scan SLA.
+ *
+ * \param [in] unit                        Logical device id.
+ * \param [in] sid                         PT ID.
+ * \param [out] stats                      Coverage statistics.
+ *
+ * \retval SHR_E_NONE for success
+ * \retval SHR_E_UNAVAIL no scan thread has been started
+ */
+extern int
+bcmptm_ser_scan_stats_get(int unit, bcmdrd_sid_t sid,
+                          bcmptm_ser_scan_stats_t *stats);
+
+/*!
+ * \brief Get bandwidth budget statistics of one S/W memory scan thread.
+ *
+ * \param [in] unit                        Logical device id.
+ * \param [in] type                        Scan thread.
+ * \param [out] stats                      Budget statistics.
+ *
+ * \retval SHR_E_NONE for success
+ * \retval SHR_E_UNAVAIL no scan thread has been started
+ */
+extern int
+bcmptm_ser_scan_sched_stats_get(int unit, bcmptm_ser_scan_type_t type,
+                                bcmptm_ser_scan_sched_stats_t *stats);
+
+/*!
+ * \brief Create the lock of S/W memory scan statistics.
+ *
+ * \param [in] unit                        Logical device id.
+ *
+ * \retval SHR_E_NONE for success
+ */
+extern int
+bcmptm_ser_scan_sched_unit_init(int unit);
+
+/*!
+ * \brief Free S/W memory scan statistics and their lock.
+ *
+ * Called after the scan threads have been stopped.
+ *
+ * \param [in] unit                        Logical device id.
+ *
+ * \retval NONE
+ */
+extern void
+bcmptm_ser_scan_sched_unit_cleanup(int unit);
+
+/*!
+ * \brief Self test of S/W memory scan pacing.
+ *
+ * The pacing of one scan thread is run on a simulated clock with a fixed
+ * budget. The test checks that scan reads at the budget while WAL is idle,
+ * backs off once and reads at the minimum rate while WAL is busy, and
+ * spends the saved credit once WAL is idle again. The WAL watermarks are
+ * checked as well. Scan threads are not affected.
+ *
+ * \param [in] unit                        Logical device id.
+ * \param [out] result                     Test results.
+ *
+ * \retval SHR_E_NONE for success
+ * \retval SHR_E_FAIL a check failed
+ */
+extern int
+bcmptm_ser_scan_sched_test(int unit, bcmptm_ser_scan_sched_test_t *result);
+
 /*!
  * \brief Register callback routines in CTH, SER needs to use them.
  *
@@ -448,4 +448,23 @@ extern void
 bcmptm_wal_dma_avail(int unit, bool read_op, uint32_t entry_count,
                      bool *wal_dma_avail);
 
+/*!
+ * \brief Get snapshot of WAL occupancy.
+ *
+ * Used by background HW readers (eg. SER memory scan) to yield SCHAN/DMA
+ * bandwidth to table writes. Values are read without taking WAL locks.
+ *
+ * \param [in] unit Logical device id
+ * \param [out] msg_count Num of msgs not yet released by WAL reader.
+ * \param [out] msg_max_count Max num of msgs in WAL.
+ * \param [out] scf_busy_chans Num of schanfifo channels holding WAL ops.
+ *
+ * Returns:
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_UNAVAIL WAL is not initialized
+ */
+extern int
+bcmptm_wal_occupancy_get(int unit, uint32_t *msg_count,
+                         uint32_t *msg_max_count, uint32_t *scf_busy_chans);
+
 #endif /* BCMPTM_WAL_INTERNAL_H */
@@ -574,6 +574,8 @@ bcmptm_rm_alpm_pvt_trie_create(int u, int db, int ln, int ipv, int w_vrf)
     rm_alpm_trie_t *pivot_trie;
     uint32_t mkl = trie_mkl(u, ipv);
     bcmptm_rm_alpm_trie_create(mkl, &pivot_trie);
+    /* Pivot lookups are served by the stride trie, if it can be allocated. */
+    (void)bcmptm_rm_alpm_trie_stride_set(pivot_trie, TRUE);
     VRF_HDL_PTRIE(u, db, ipv, w_vrf, ln) = pivot_trie;
     return SHR_E_NONE;
 }
@@ -120,6 +120,7 @@
 
 #include "rm_alpm_trie.h"
 #include "rm_alpm_trie_util.h"
+#include "rm_alpm_trie_stride.h"
 
 
 /*******************************************************************************
@@ -138,6 +139,15 @@
 #define PARTIAL_MATCH       3
 #define MIN(a, b)           ((a) < (b) ? (a) : (b))
 
+/*
+ * Number of updates without a lookup after which the stride trie is left
+ * stale for the next lookup to rebuild. Rebuilding takes about as long as
+ * keeping the stride trie in sync with half as many updates as it has
+ * prefixes. A stride trie dropped after a failed rebuild is created again
+ * after as many updates.
+ */
+#define STRIE_SYNC_RUN(count)   ((count) / 2 + 64)
+
 #define SPLIT_FURTHER        0
 #define SPLIT_GOOD           1
 #define SPLIT_LEN_EXCEED     2
@@ -3342,10 +3352,139 @@ exit:
 static void
 trie_destroy(rm_alpm_trie_t *trie)
 {
+    if (trie->strie) {
+        bcmptm_rm_alpm_strie_destroy(trie->strie);
+        trie->strie = NULL;
+    }
     shr_lmm_free(all_tries, trie);
 }
 
 
+/*
+ * Function:
+ *     trie_stride_build
+ * Purpose:
+ *     Recursive routine to insert all payload nodes into the stride trie
+ */
+static int
+trie_stride_build(uint32_t            mkl,
+                  rm_alpm_trie_node_t *trie,
+                  uint32_t            *key,
+                  uint32_t            key_len,
+                  rm_alpm_strie_t     *strie)
+{
+    uint32_t node_key[RM_ALPM_MAX_KEY_SIZE_WORDS];
+    uint32_t node_len = key_len;
+    int bit, rv;
+
+    sal_memcpy(node_key, key, sizeof(node_key));
+    rv = bcmptm_rm_alpm_key_append(mkl, node_key, &node_len,
+                                   trie->skip_addr, trie->skip_len);
+    if (SHR_FAILURE(rv)) {
+        return rv;
+    }
+    if (trie->type == PAYLOAD) {
+        rv = bcmptm_rm_alpm_strie_insert(strie, node_key, node_len, trie);
+        if (SHR_FAILURE(rv)) {
+            return rv;
+        }
+    }
+    for (bit = 0; bit < MAX_CHILD; bit++) {
+        uint32_t child_key[RM_ALPM_MAX_KEY_SIZE_WORDS];
+        uint32_t child_len = node_len;
+
+        if (trie->child[bit].child_node == NULL) {
+            continue;
+        }
+        sal_memcpy(child_key, node_key, sizeof(child_key));
+        rv = bcmptm_rm_alpm_key_append(mkl, child_key, &child_len, bit, 1);
+        if (SHR_FAILURE(rv)) {
+            return rv;
+        }
+        rv = trie_stride_build(mkl, trie->child[bit].child_node,
+                               child_key, child_len, strie);
+        if (SHR_FAILURE(rv)) {
+            return rv;
+        }
+    }
+    return SHR_E_NONE;
+}
+
+
+/*
+ * Function:
+ *     trie_stride_ready
+ * Purpose:
+ *     Check if the stride trie can serve lookups, rebuild it if stale.
+ *     If the rebuild fails, the stride trie is dropped and lookups walk the
+ *     binary trie, rather than retrying the rebuild on every lookup.
+ */
+static bool
+trie_stride_ready(rm_alpm_trie_t *trie)
+{
+    uint32_t key[RM_ALPM_MAX_KEY_SIZE_WORDS] = {0};
+    int rv = SHR_E_NONE;
+
+    if (trie->strie == NULL) {
+        return FALSE;
+    }
+    trie->strie_updates = 0;
+    if (trie->strie_stale) {
+        bcmptm_rm_alpm_strie_clear(trie->strie);
+        if (trie->trie) {
+            rv = trie_stride_build(trie->mkl, trie->trie, key, 0, trie->strie);
+        }
+        if (SHR_FAILURE(rv)) {
+            bcmptm_rm_alpm_strie_destroy(trie->strie);
+            trie->strie = NULL;
+            trie->strie_failed = TRUE;
+            return FALSE;
+        }
+        trie->strie_stale = FALSE;
+    }
+    return TRUE;
+}
+
+
+/*
+ * Function:
+ *     trie_stride_sync
+ * Purpose:
+ *     Check if an update is to be applied to the stride trie. A long run of
+ *     updates without a lookup, such as a bulk add or delete, leaves the
+ *     stride trie stale instead, so the update only pays for the binary trie.
+ *     A stride trie dropped after a failed rebuild is created again once
+ *     the binary trie has seen as many updates, for the next lookup to
+ *     rebuild.
+ */
+static bool
+trie_stride_sync(rm_alpm_trie_t *trie)
+{
+    if (trie->strie == NULL) {
+        if (trie->strie_failed &&
+            ++trie->strie_updates >
+            STRIE_SYNC_RUN((uint32_t)bcmptm_rm_alpm_trie_count(trie))) {
+            trie->strie_updates = 0;
+            if (SHR_SUCCESS(bcmptm_rm_alpm_strie_create(trie->mkl,
+                                                        &trie->strie))) {
+                trie->strie_failed = FALSE;
+                trie->strie_stale = TRUE;
+            }
+        }
+        return FALSE;
+    }
+    if (trie->strie_stale) {
+        return FALSE;
+    }
+    if (++trie->strie_updates >
+        STRIE_SYNC_RUN((uint32_t)bcmptm_rm_alpm_trie_count(trie))) {
+        trie->strie_stale = TRUE;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+
 /* Compare whether two tries are identical */
 static int
 trie_compare(rm_alpm_trie_node_t              *ptrie,
@@ -3502,6 +3641,9 @@ int bcmptm_rm_alpm_trie_repartition(rm_alpm_trie_t                  *trie,
     if (trie == NULL) {
         return SHR_E_NONE;
     } else {
+        if (trie->strie) {
+            trie->strie_stale = TRUE;
+        }
         return trie_repartition(NULL, trie->trie, &state,
                                 cb, user_data, NULL, 0, NULL, NULL);
     }
@@ -3563,6 +3705,10 @@ int bcmptm_rm_alpm_trie_search(rm_alpm_trie_t      *trie,
                                rm_alpm_trie_node_t **payload)
 {
     if (trie->trie) {
+        if (trie_stride_ready(trie)) {
+            return bcmptm_rm_alpm_strie_search(trie->strie,
+                                               key, length, payload);
+        }
         return trie_fast_search(trie->mkl,
                                  trie->trie, key, length, payload);
     } else {
@@ -3619,6 +3765,10 @@ int bcmptm_rm_alpm_trie_find_lpm(rm_alpm_trie_t      *trie,
             sal_memset(lpm_pfx, 0,
                        sizeof(uint32_t) * RM_ALPM_MAX_KEY_SIZE_WORDS);
         }
+        if (trie_stride_ready(trie)) {
+            return bcmptm_rm_alpm_strie_find_lpm(trie->strie, key, length,
+                                                 payload, lpm_pfx, lpm_len);
+        }
         rv = trie_find_lpm(trie->mkl,
                            trie->trie, key, length, payload,
                            NULL, NULL, 0, lpm_pfx, lpm_len, &cut);
@@ -3775,6 +3925,12 @@ int bcmptm_rm_alpm_trie_insert(rm_alpm_trie_t      *trie,
         }
     }
 
+    if (SHR_SUCCESS(rv) && trie_stride_sync(trie)) {
+        if (SHR_FAILURE(bcmptm_rm_alpm_strie_insert(trie->strie, key, length,
+                                                    payload))) {
+            trie->strie_stale = TRUE;
+        }
+    }
     return rv;
 }
 
@@ -3805,6 +3961,13 @@ int bcmptm_rm_alpm_trie_delete(rm_alpm_trie_t      *trie,
     } else {
         rv = SHR_E_NOT_FOUND;
     }
+
+    if (SHR_SUCCESS(rv) && trie_stride_sync(trie)) {
+        if (SHR_FAILURE(bcmptm_rm_alpm_strie_delete(trie->strie, key,
+                                                    length))) {
+            trie->strie_stale = TRUE;
+        }
+    }
     return rv;
 }
 
@@ -3840,6 +4003,9 @@ int bcmptm_rm_alpm_trie_split(rm_alpm_trie_t      *trie,
 
     *length = 0;
 
+    if (trie->strie) {
+        trie->strie_stale = TRUE;
+    }
     if (trie->trie) {
 
         if (payload_node_split) {
@@ -3943,6 +4109,9 @@ int bcmptm_rm_alpm_trie_merge(rm_alpm_trie_t      *parent_trie,
         return SHR_E_NONE;
     }
 
+    if (parent_trie->strie) {
+        parent_trie->strie_stale = TRUE;
+    }
     if (parent_trie->trie == NULL) {
         parent_trie->trie = child_trie;
     } else {
@@ -3990,6 +4159,9 @@ int bcmptm_rm_alpm_trie_split2(rm_alpm_trie_t      *trie,
     *split_trie_root = NULL;
     *pivot_len = 0;
 
+    if (trie->strie) {
+        trie->strie_stale = TRUE;
+    }
     if (trie->trie) {
         rm_alpm_trie_node_t *payload;
         sal_memset(pivot, 0, sizeof(uint32_t) * BITS2WORDS(trie->mkl));
@@ -4212,6 +4384,33 @@ int bcmptm_rm_alpm_trie_destroy(rm_alpm_trie_t *trie)
 }
 
 
+int
+bcmptm_rm_alpm_trie_stride_set(rm_alpm_trie_t *trie, bool enable)
+{
+    int rv;
+
+    if (!trie) {
+        return SHR_E_PARAM;
+    }
+    trie->strie_failed = FALSE;
+    if (!enable) {
+        if (trie->strie) {
+            bcmptm_rm_alpm_strie_destroy(trie->strie);
+            trie->strie = NULL;
+        }
+        return SHR_E_NONE;
+    }
+    if (trie->strie == NULL) {
+        rv = bcmptm_rm_alpm_strie_create(trie->mkl, &trie->strie);
+        if (SHR_FAILURE(rv)) {
+            return rv;
+        }
+        trie->strie_stale = TRUE;
+    }
+    return SHR_E_NONE;
+}
+
+
 int
 bcmptm_rm_alpm_trie_count(rm_alpm_trie_t *trie)
 {
@@ -175,6 +175,10 @@ typedef struct rm_alpm_trie_s {
     rm_alpm_trie_node_t *trie;     /* trie root pointer */
     uint32_t    v6_key;    /* support 144 bits key, otherwise expect 48 bits key */
     uint32_t    mkl;       /* max_key_len*/
+    struct rm_alpm_strie_s *strie; /* stride trie index, NULL if disabled */
+    uint32_t    strie_stale; /* stride trie to be rebuilt before use */
+    uint32_t    strie_updates; /* updates since the last stride lookup */
+    uint32_t    strie_failed; /* stride trie dropped after a failed rebuild */
     struct rm_alpm_trie_s *next;
 } rm_alpm_trie_t;
 
@@ -433,6 +437,23 @@ extern void
 bcmptm_rm_alpm_trie_clone_destroy(rm_alpm_trie_t *trie,
                                   shr_lmm_hdl_t clone_hdl);
 
+/*!
+ * \brief Enable or disable the stride trie index of a trie
+ *
+ * The stride trie mirrors the payload nodes of the trie and serves
+ * bcmptm_rm_alpm_trie_search and bcmptm_rm_alpm_trie_find_lpm with one
+ * node access per RM_ALPM_STRIE_STRIDE key bits. It is kept in sync on
+ * insert and delete, and rebuilt on next use after the trie is split or
+ * merged, or after a long run of inserts and deletes without a lookup.
+ *
+ * \param [in] trie Trie
+ * \param [in] enable Enable the stride trie
+ *
+ * \return SHR_E_XXX
+ */
+extern int
+bcmptm_rm_alpm_trie_stride_set(rm_alpm_trie_t *trie, bool enable);
+
 /*!
  * \brief Return payload count of a trie
  *
@@ -0,0 +1,430 @@
+/*! \file rm_alpm_trie_bench.c
+ *
+ * Route churn benchmark for ALPM tries
+ *
+ * This file contains a benchmark which compares the insert, delete, churn
+ * and LPM rates of the binary trie with the stride trie index.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+/*******************************************************************************
+ * Includes
+ */
+#include <bsl/bsl.h>
+#include <sal/sal_types.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_time.h>
+#include <shr/shr_error.h>
+#include <shr/shr_debug.h>
+#include <bcmptm/bcmptm_rm_alpm_internal.h>
+
+#include "rm_alpm_trie.h"
+#include "rm_alpm_trie_util.h"
+
+
+/*******************************************************************************
+ * Defines
+ */
+#define BSL_LOG_MODULE  BSL_LS_BCMPTM_RMALPMTRIE
+
+#define BENCH_KEY_WORDS RM_ALPM_MAX_KEY_SIZE_WORDS
+
+/*******************************************************************************
+ * Typedefs
+ */
+typedef struct trie_bench_ctrl_s {
+    /* IPv6 routes */
+    bool v6;
+
+    /* Trie max key length */
+    uint32_t mkl;
+
+    /* Max prefix length */
+    uint32_t max_len;
+
+    /* Random number state */
+    uint32_t rand;
+
+    /* Route payloads, keys and lengths */
+    rm_alpm_trie_node_t *payloads;
+    uint32_t *keys;
+    uint32_t *lens;
+
+    /* Lookup keys and LPM results (route index, or -1) */
+    uint32_t *lookup_keys;
+    int *results;
+} trie_bench_ctrl_t;
+
+/*******************************************************************************
+ * Private Functions
+ */
+static inline uint32_t
+trie_bench_rand(trie_bench_ctrl_t *ctrl)
+{
+    /* xorshift32 */
+    ctrl->rand ^= ctrl->rand << 13;
+    ctrl->rand ^= ctrl->rand >> 17;
+    ctrl->rand ^= ctrl->rand << 5;
+    return ctrl->rand;
+}
+
+/*
+ * Function:
+ *     trie_bench_key_gen
+ * Purpose:
+ *     Generate a random prefix of given length in trie key format.
+ */
+static void
+trie_bench_key_gen(trie_bench_ctrl_t *ctrl, uint32_t len, uint32_t *key)
+{
+    uint32_t words = BITS2WORDS(ctrl->mkl);
+    uint32_t i, bits;
+
+    sal_memset(key, 0, sizeof(uint32_t) * BENCH_KEY_WORDS);
+    for (i = 0; i < words && len > 0; i++) {
+        bits = (len > NUM_WORD_BITS) ? NUM_WORD_BITS : len;
+        key[words - 1 - i] = trie_bench_rand(ctrl) & BITMASK(bits);
+        len -= bits;
+    }
+}
+
+/*
+ * Function:
+ *     trie_bench_len_gen
+ * Purpose:
+ *     Generate a prefix length following a typical routing table mix.
+ */
+static uint32_t
+trie_bench_len_gen(trie_bench_ctrl_t *ctrl)
+{
+    uint32_t r = trie_bench_rand(ctrl) % 100;
+
+    if (!ctrl->v6) {
+        if (r < 60) {
+            return 24;
+        } else if (r < 85) {
+            return 16 + trie_bench_rand(ctrl) % 8;
+        }
+        return 25 + trie_bench_rand(ctrl) % 8;
+    }
+    if (r < 50) {
+        return 48;
+    } else if (r < 90) {
+        return 32 + trie_bench_rand(ctrl) % 33;
+    }
+    return 65 + trie_bench_rand(ctrl) % 64;
+}
+
+/*
+ * Function:
+ *     trie_bench_route_add
+ * Purpose:
+ *     Insert a new unique random route into slot idx.
+ */
+static int
+trie_bench_route_add(trie_bench_ctrl_t *ctrl, rm_alpm_trie_t *trie, int idx)
+{
+    uint32_t *key = &ctrl->keys[idx * BENCH_KEY_WORDS];
+    int rv;
+
+    do {
+        ctrl->lens[idx] = trie_bench_len_gen(ctrl);
+        trie_bench_key_gen(ctrl, ctrl->lens[idx], key);
+        sal_memset(&ctrl->payloads[idx], 0, sizeof(rm_alpm_trie_node_t));
+        rv = bcmptm_rm_alpm_trie_insert(trie, key, NULL, ctrl->lens[idx],
+                                        &ctrl->payloads[idx]);
+    } while (rv == SHR_E_EXISTS);
+
+    return rv;
+}
+
+/*
+ * Function:
+ *     trie_bench_lookup_gen
+ * Purpose:
+ *     Generate full length lookup keys, each extending a random route with
+ *     random host bits.
+ */
+static int
+trie_bench_lookup_gen(trie_bench_ctrl_t *ctrl, uint32_t routes,
+                      uint32_t lookups)
+{
+    uint32_t host[BENCH_KEY_WORDS];
+    uint32_t *key;
+    uint32_t i, w, idx, len;
+    int rv;
+
+    for (i = 0; i < lookups; i++) {
+        key = &ctrl->lookup_keys[i * BENCH_KEY_WORDS];
+        if (routes == 0) {
+            trie_bench_key_gen(ctrl, ctrl->max_len, key);
+            continue;
+        }
+        idx = trie_bench_rand(ctrl) % routes;
+        len = ctrl->lens[idx];
+        sal_memcpy(key, &ctrl->keys[idx * BENCH_KEY_WORDS],
+                   sizeof(uint32_t) * BENCH_KEY_WORDS);
+        rv = bcmptm_rm_alpm_key_shift(ctrl->mkl, key, len,
+                                      (int)len - (int)ctrl->max_len);
+        if (SHR_FAILURE(rv)) {
+            return rv;
+        }
+        trie_bench_key_gen(ctrl, ctrl->max_len - len, host);
+        for (w = 0; w < BENCH_KEY_WORDS; w++) {
+            key[w] |= host[w];
+        }
+    }
+    return SHR_E_NONE;
+}
+
+/*
+ * Function:
+ *     trie_bench_run
+ * Purpose:
+ *     Run the benchmark on one trie representation.
+ */
+static int
+trie_bench_run(trie_bench_ctrl_t *ctrl,
+               bool stride,
+               uint32_t seed,
+               uint32_t routes,
+               uint32_t churns,
+               uint32_t lookups,
+               bool check,
+               bcmptm_rm_alpm_trie_bench_t *bench)
+{
+    rm_alpm_trie_t *trie = NULL;
+    rm_alpm_trie_node_t *payload;
+    uint32_t i, idx, lpm_len, rand;
+    uint32_t lpm_pfx[BENCH_KEY_WORDS];
+    sal_usecs_t start;
+    int result;
+
+    SHR_FUNC_ENTER(BSL_UNIT_UNKNOWN);
+
+    sal_memset(bench, 0, sizeof(*bench));
+    ctrl->rand = seed ? seed : 1;
+
+    SHR_IF_ERR_EXIT
+        (bcmptm_rm_alpm_trie_create(ctrl->mkl, &trie));
+    SHR_IF_ERR_EXIT
+        (bcmptm_rm_alpm_trie_stride_set(trie, stride));
+
+    start = sal_time_usecs();
+    for (i = 0; i < routes; i++) {
+        SHR_IF_ERR_EXIT
+            (trie_bench_route_add(ctrl, trie, i));
+    }
+    bench->insert_usecs = sal_time_usecs() - start;
+    bench->routes = routes;
+
+    if (!check) {
+        /*
+         * Lookup keys are generated once and reused by the next run, from
+         * a separate random sequence so that both runs churn the same routes.
+         */
+        rand = ctrl->rand;
+        ctrl->rand = ~ctrl->rand ? ~ctrl->rand : 1;
+        SHR_IF_ERR_EXIT
+            (trie_bench_lookup_gen(ctrl, routes, lookups));
+        ctrl->rand = rand;
+    }
+
+    start = sal_time_usecs();
+    for (i = 0; i < lookups; i++) {
+        result = -1;
+        if (SHR_SUCCESS
+                (bcmptm_rm_alpm_trie_find_lpm(trie,
+                                              &ctrl->lookup_keys[i *
+                                                  BENCH_KEY_WORDS],
+                                              ctrl->max_len,
+                                              &payload,
+                                              lpm_pfx,
+                                              &lpm_len))) {
+            result = payload - ctrl->payloads;
+        }
+        if (check) {
+            if (ctrl->results[i] != result) {
+                bench->mismatches++;
+            }
+        } else {
+            ctrl->results[i] = result;
+        }
+    }
+    bench->lpm_usecs = sal_time_usecs() - start;
+    bench->lookups = lookups;
+
+    start = sal_time_usecs();
+    for (i = 0; i < churns && routes > 0; i++) {
+        idx = trie_bench_rand(ctrl) % routes;
+        SHR_IF_ERR_EXIT
+            (bcmptm_rm_alpm_trie_delete(trie,
+                                        &ctrl->keys[idx * BENCH_KEY_WORDS],
+                                        ctrl->lens[idx],
+                                        &payload));
+        SHR_IF_ERR_EXIT
+            (trie_bench_route_add(ctrl, trie, idx));
+    }
+    bench->churn_usecs = sal_time_usecs() - start;
+    bench->churns = churns;
+
+    start = sal_time_usecs();
+    for (i = 0; i < routes; i++) {
+        SHR_IF_ERR_EXIT
+            (bcmptm_rm_alpm_trie_delete(trie,
+                                        &ctrl->keys[i * BENCH_KEY_WORDS],
+                                        ctrl->lens[i],
+                                        &payload));
+    }
+    bench->delete_usecs = sal_time_usecs() - start;
+
+exit:
+    if (trie) {
+        bcmptm_rm_alpm_trie_destroy(trie);
+    }
+    SHR_FUNC_EXIT();
+}
+
+/*******************************************************************************
+ * Public Functions
+ */
+int
+bcmptm_rm_alpm_trie_bench(bool v6,
+                          uint32_t routes,
+                          uint32_t churns,
+                          uint32_t lookups,
+                          uint32_t seed,
+                          bcmptm_rm_alpm_trie_bench_t *binary,
+                          bcmptm_rm_alpm_trie_bench_t *stride)
+{
+    trie_bench_ctrl_t ctrl;
+
+    SHR_FUNC_ENTER(BSL_UNIT_UNKNOWN);
+
+    SHR_NULL_CHECK(binary, SHR_E_PARAM);
+    SHR_NULL_CHECK(stride, SHR_E_PARAM);
+
+    sal_memset(&ctrl, 0, sizeof(ctrl));
+    ctrl.v6 = v6;
+    ctrl.mkl = v6 ? RM_ALPM_IPV6_KEY_SIZE : RM_ALPM_IPV4_KEY_SIZE;
+    ctrl.max_len = v6 ? RM_ALPM_IPV6_PFX_SIZE : RM_ALPM_IPV4_PFX_SIZE;
+
+    SHR_ALLOC(ctrl.payloads, sizeof(rm_alpm_trie_node_t) * (routes + 1),
+              "bcmptmRmalpmBenchPayload");
+    SHR_NULL_CHECK(ctrl.payloads, SHR_E_MEMORY);
+    SHR_ALLOC(ctrl.keys, sizeof(uint32_t) * BENCH_KEY_WORDS * (routes + 1),
+              "bcmptmRmalpmBenchKey");
+    SHR_NULL_CHECK(ctrl.keys, SHR_E_MEMORY);
+    SHR_ALLOC(ctrl.lens, sizeof(uint32_t) * (routes + 1),
+              "bcmptmRmalpmBenchLen");
+    SHR_NULL_CHECK(ctrl.lens, SHR_E_MEMORY);
+    SHR_ALLOC(ctrl.lookup_keys,
+              sizeof(uint32_t) * BENCH_KEY_WORDS * (lookups + 1),
+              "bcmptmRmalpmBenchLookup");
+    SHR_NULL_CHECK(ctrl.lookup_keys, SHR_E_MEMORY);
+    SHR_ALLOC(ctrl.results, sizeof(int) * (lookups + 1),
+              "bcmptmRmalpmBenchResult");
+    SHR_NULL_CHECK(ctrl.results, SHR_E_MEMORY);
+
+    SHR_IF_ERR_EXIT
+        (trie_bench_run(&ctrl, FALSE, seed, routes, churns, lookups,
+                        FALSE, binary));
+    SHR_IF_ERR_EXIT
+        (trie_bench_run(&ctrl, TRUE, seed, routes, churns, lookups,
+                        TRUE, stride));
+
+exit:
+    SHR_FREE(ctrl.payloads);
+    SHR_FREE(ctrl.keys);
+    SHR_FREE(ctrl.lens);
+    SHR_FREE(ctrl.lookup_keys);
+    SHR_FREE(ctrl.results);
+    SHR_FUNC_EXIT();
+}
@@ -0,0 +1,812 @@
+/*! \file rm_alpm_trie_stride.c
+ *
+ * Multibit stride trie for ALPM prefix lookup
+ *
+ * This file contains the implementation of the stride trie that indexes the
+ * payload nodes of a binary ALPM trie for fast exact and LPM lookups.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+/*
+ * The stride trie is a Tree Bitmap: every node consumes
+ * RM_ALPM_STRIE_STRIDE key bits and is described by two bitmaps.
+ * The internal bitmap holds the prefixes that end inside the node
+ * (local length 0 to stride-1) and the external bitmap holds the children.
+ * Children of a node are stored contiguously in the node arena, and the
+ * payloads of a node are stored contiguously in the result arena, both
+ * indexed by the popcount of the bitmap bits below the target bit.
+ *
+ * A lookup therefore touches one small node per stride instead of one
+ * node per branching bit, and never follows a pointer to reach a sibling.
+ * Arenas are addressed by index so that they can grow by reallocation.
+ *
+ * The binary trie stays the owner of the payload nodes and is still used
+ * for split, merge and propagation. The stride trie only mirrors its
+ * payload nodes.
+ */
+
+/*******************************************************************************
+ * Includes
+ */
+#include <bsl/bsl.h>
+#include <sal/sal_types.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <shr/shr_error.h>
+
+#include "rm_alpm_trie_stride.h"
+#include "rm_alpm_trie_util.h"
+
+
+/*******************************************************************************
+ * Defines
+ */
+#define STRIE_STRIDE            RM_ALPM_STRIE_STRIDE
+#define STRIE_FANOUT            (1 << STRIE_STRIDE)
+#define STRIE_NIBBLE_MASK       (STRIE_FANOUT - 1)
+/* Deepest node for 144 bits key */
+#define STRIE_MAX_DEPTH         (RM_ALPM_MAX_KEY_SIZE / STRIE_STRIDE + 1)
+/* Normalized key has a trailing zero word for nibble extraction. */
+#define STRIE_KEY_WORDS         (RM_ALPM_MAX_KEY_SIZE_WORDS + 1)
+/* Blocks are allocated in power of 2 sizes, 1 to STRIE_FANOUT. */
+#define STRIE_CLASSES           (STRIE_STRIDE + 1)
+#define STRIE_NODES_MIN         16
+#define STRIE_RESULTS_MIN       16
+/* Index 0 is never on a free list: root node, reserved result. */
+#define STRIE_NONE              0
+
+/* Internal bitmap position for a local prefix of length len. */
+#define STRIE_IBM_POS(nib, len) \
+    ((1U << (len)) | ((nib) >> (STRIE_STRIDE - (len))))
+
+#define STRIE_BIT(pos)          (((strie_bmp_t)1) << (pos))
+
+/* Bits below pos. */
+#define STRIE_BELOW(pos)        (STRIE_BIT(pos) - 1)
+
+/*******************************************************************************
+ * Typedefs
+ */
+/* One bit per child, or per local prefix position 1 to STRIE_FANOUT - 1. */
+typedef uint64_t strie_bmp_t;
+
+typedef struct strie_node_s {
+    /* Prefixes ending in this node, bit STRIE_IBM_POS() */
+    strie_bmp_t ibm;
+
+    /* Children of this node, bit nibble */
+    strie_bmp_t ebm;
+
+    /* Node arena index of the first child */
+    uint32_t child;
+
+    /* Result arena index of the first payload */
+    uint32_t result;
+} strie_node_t;
+
+struct rm_alpm_strie_s {
+    /* Max key length */
+    uint32_t mkl;
+
+    /* Number of key words */
+    uint32_t words;
+
+    /* Node arena, node 0 is the root */
+    strie_node_t *nodes;
+    uint32_t nodes_used;
+    uint32_t nodes_max;
+    uint32_t nodes_free[STRIE_CLASSES];
+
+    /* Result arena, result 0 is reserved */
+    rm_alpm_trie_node_t **results;
+    uint32_t results_used;
+    uint32_t results_max;
+    uint32_t results_free[STRIE_CLASSES];
+
+    /* Number of prefixes */
+    uint32_t count;
+};
+
+/*******************************************************************************
+ * Private Functions
+ */
+static inline uint32_t
+strie_popcount(strie_bmp_t n)
+{
+    n = n - ((n >> 1) & 0x5555555555555555ULL);
+    n = (n & 0x3333333333333333ULL) + ((n >> 2) & 0x3333333333333333ULL);
+    n = (n + (n >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (uint32_t)((n * 0x0101010101010101ULL) >> 56);
+}
+
+/*
+ * Function:
+ *     strie_class
+ * Purpose:
+ *     Get the block size class for num entries, block size is 1 << class.
+ */
+static inline uint32_t
+strie_class(uint32_t num)
+{
+    uint32_t cls = 0;
+
+    while ((1U << cls) < num) {
+        cls++;
+    }
+    return cls;
+}
+
+/*
+ * Function:
+ *     strie_key_normalize
+ * Purpose:
+ *     Left align a key of the binary trie format, so that the first bit of
+ *     the prefix is bit 31 of word 0. Bits beyond length are zero.
+ */
+static inline void
+strie_key_normalize(rm_alpm_strie_t *strie,
+                    uint32_t *key,
+                    uint32_t length,
+                    uint32_t *nkey)
+{
+    uint32_t shift, ws, bs, i;
+
+    sal_memset(nkey, 0, sizeof(uint32_t) * STRIE_KEY_WORDS);
+    if (length == 0) {
+        return;
+    }
+    shift = (strie->words << 5) - length;
+    ws = shift >> 5;
+    bs = shift & NUM_WORD_MASK;
+    for (i = 0; i + ws < strie->words; i++) {
+        nkey[i] = SHL(key[i + ws], bs, NUM_WORD_BITS);
+        if (bs && (i + ws + 1) < strie->words) {
+            nkey[i] |= key[i + ws + 1] >> (NUM_WORD_BITS - bs);
+        }
+    }
+}
+
+/*
+ * Function:
+ *     strie_key_denormalize
+ * Purpose:
+ *     Reverse of strie_key_normalize for the first length bits.
+ */
+static inline void
+strie_key_denormalize(rm_alpm_strie_t *strie,
+                      uint32_t *nkey,
+                      uint32_t length,
+                      uint32_t *key)
+{
+    uint32_t shift, ws, bs, i, j;
+
+    sal_memset(key, 0, sizeof(uint32_t) * RM_ALPM_MAX_KEY_SIZE_WORDS);
+    if (length == 0) {
+        return;
+    }
+    shift = (strie->words << 5) - length;
+    ws = shift >> 5;
+    bs = shift & NUM_WORD_MASK;
+    for (i = ws; i < strie->words; i++) {
+        j = i - ws;
+        key[i] = nkey[j] >> bs;
+        if (bs && j > 0) {
+            key[i] |= nkey[j - 1] << (NUM_WORD_BITS - bs);
+        }
+    }
+}
+
+/*
+ * Function:
+ *     strie_nibble
+ * Purpose:
+ *     Get the STRIE_STRIDE bits at bit offset of a normalized key.
+ */
+static inline uint32_t
+strie_nibble(uint32_t *nkey, uint32_t offset)
+{
+    uint32_t w = offset >> 5;
+    uint64_t bits = ((uint64_t)nkey[w] << 32) | nkey[w + 1];
+
+    return (uint32_t)(bits >> (64 - STRIE_STRIDE - (offset & NUM_WORD_MASK))) &
+           STRIE_NIBBLE_MASK;
+}
+
+/*
+ * Function:
+ *     strie_node_alloc
+ * Purpose:
+ *     Allocate a block of size class cls. May move the node arena.
+ */
+static int
+strie_node_alloc(rm_alpm_strie_t *strie, uint32_t cls, uint32_t *idx)
+{
+    strie_node_t *nodes;
+    uint32_t max, num = 1U << cls;
+
+    if (strie->nodes_free[cls] != STRIE_NONE) {
+        *idx = strie->nodes_free[cls];
+        strie->nodes_free[cls] = strie->nodes[*idx].child;
+        return SHR_E_NONE;
+    }
+    if (strie->nodes_used + num > strie->nodes_max) {
+        max = strie->nodes_max * 2;
+        nodes = sal_alloc(sizeof(strie_node_t) * max, "bcmptmRmalpmStrieNode");
+        if (nodes == NULL) {
+            return SHR_E_MEMORY;
+        }
+        sal_memcpy(nodes, strie->nodes,
+                   sizeof(strie_node_t) * strie->nodes_used);
+        sal_free(strie->nodes);
+        strie->nodes = nodes;
+        strie->nodes_max = max;
+    }
+    *idx = strie->nodes_used;
+    strie->nodes_used += num;
+    return SHR_E_NONE;
+}
+
+static inline void
+strie_node_free(rm_alpm_strie_t *strie, uint32_t idx, uint32_t cls)
+{
+    strie->nodes[idx].child = strie->nodes_free[cls];
+    strie->nodes_free[cls] = idx;
+}
+
+/*
+ * Function:
+ *     strie_result_alloc
+ * Purpose:
+ *     Allocate a block of size class cls. May move the result arena.
+ */
+static int
+strie_result_alloc(rm_alpm_strie_t *strie, uint32_t cls, uint32_t *idx)
+{
+    rm_alpm_trie_node_t **results;
+    uint32_t max, num = 1U << cls;
+
+    if (strie->results_free[cls] != STRIE_NONE) {
+        *idx = strie->results_free[cls];
+        strie->results_free[cls] =
+            (uint32_t)(uintptr_t)strie->results[*idx];
+        return SHR_E_NONE;
+    }
+    if (strie->results_used + num > strie->results_max) {
+        max = strie->results_max * 2;
+        results = sal_alloc(sizeof(rm_alpm_trie_node_t *) * max,
+                            "bcmptmRmalpmStrieResult");
+        if (results == NULL) {
+            return SHR_E_MEMORY;
+        }
+        sal_memcpy(results, strie->results,
+                   sizeof(rm_alpm_trie_node_t *) * strie->results_used);
+        sal_free(strie->results);
+        strie->results = results;
+        strie->results_max = max;
+    }
+    *idx = strie->results_used;
+    strie->results_used += num;
+    return SHR_E_NONE;
+}
+
+static inline void
+strie_result_free(rm_alpm_strie_t *strie, uint32_t idx, uint32_t cls)
+{
+    strie->results[idx] =
+        (rm_alpm_trie_node_t *)(uintptr_t)strie->results_free[cls];
+    strie->results_free[cls] = idx;
+}
+
+/*
+ * Function:
+ *     strie_child_add
+ * Purpose:
+ *     Add an empty child nib to node nidx and return its index.
+ */
+static int
+strie_child_add(rm_alpm_strie_t *strie,
+                uint32_t nidx,
+                uint32_t nib,
+                uint32_t *cidx)
+{
+    strie_node_t *node;
+    uint32_t num, pos, old, blk, cls;
+    int rv;
+
+    node = &strie->nodes[nidx];
+    num = strie_popcount(node->ebm);
+    pos = strie_popcount(node->ebm & STRIE_BELOW(nib));
+    cls = strie_class(num + 1);
+    old = node->child;
+
+    if (num && cls == strie_class(num)) {
+        /* Room left in the block. */
+        sal_memmove(&strie->nodes[old + pos + 1], &strie->nodes[old + pos],
+                    sizeof(strie_node_t) * (num - pos));
+        blk = old;
+    } else {
+        rv = strie_node_alloc(strie, cls, &blk);
+        if (SHR_FAILURE(rv)) {
+            return rv;
+        }
+        node = &strie->nodes[nidx];
+        if (num) {
+            sal_memcpy(&strie->nodes[blk], &strie->nodes[old],
+                       sizeof(strie_node_t) * pos);
+            sal_memcpy(&strie->nodes[blk + pos + 1], &strie->nodes[old + pos],
+                       sizeof(strie_node_t) * (num - pos));
+            strie_node_free(strie, old, strie_class(num));
+        }
+    }
+    sal_memset(&strie->nodes[blk + pos], 0, sizeof(strie_node_t));
+    node->child = blk;
+    node->ebm |= STRIE_BIT(nib);
+    *cidx = blk + pos;
+    return SHR_E_NONE;
+}
+
+/*
+ * Function:
+ *     strie_child_del
+ * Purpose:
+ *     Remove the empty child nib of node nidx.
+ */
+static void
+strie_child_del(rm_alpm_strie_t *strie, uint32_t nidx, uint32_t nib)
+{
+    strie_node_t *node;
+    uint32_t num, pos, old, cls;
+
+    node = &strie->nodes[nidx];
+    num = strie_popcount(node->ebm);
+    pos = strie_popcount(node->ebm & STRIE_BELOW(nib));
+    old = node->child;
+
+    if (num == 1) {
+        strie_node_free(strie, old, 0);
+        node->child = STRIE_NONE;
+    } else {
+        sal_memmove(&strie->nodes[old + pos], &strie->nodes[old + pos + 1],
+                    sizeof(strie_node_t) * (num - pos - 1));
+        cls = strie_class(num - 1);
+        if (cls < strie_class(num)) {
+            /* Shrink the block by freeing its upper half. */
+            strie_node_free(strie, old + (1U << cls), cls);
+        }
+    }
+    node->ebm &= ~STRIE_BIT(nib);
+}
+
+/*
+ * Function:
+ *     strie_result_add
+ * Purpose:
+ *     Add or replace the payload at internal bitmap position bit of node nidx.
+ */
+static int
+strie_result_add(rm_alpm_strie_t *strie,
+                 uint32_t nidx,
+                 uint32_t bit,
+                 rm_alpm_trie_node_t *payload)
+{
+    strie_node_t *node;
+    uint32_t num, pos, old, blk, cls;
+    int rv;
+
+    node = &strie->nodes[nidx];
+    pos = strie_popcount(node->ibm & STRIE_BELOW(bit));
+    old = node->result;
+    if (node->ibm & STRIE_BIT(bit)) {
+        strie->results[old + pos] = payload;
+        return SHR_E_NONE;
+    }
+    num = strie_popcount(node->ibm);
+    cls = strie_class(num + 1);
+
+    if (num && cls == strie_class(num)) {
+        /* Room left in the block. */
+        sal_memmove(&strie->results[old + pos + 1], &strie->results[old + pos],
+                    sizeof(rm_alpm_trie_node_t *) * (num - pos));
+        blk = old;
+    } else {
+        rv = strie_result_alloc(strie, cls, &blk);
+        if (SHR_FAILURE(rv)) {
+            return rv;
+        }
+        if (num) {
+            sal_memcpy(&strie->results[blk], &strie->results[old],
+                       sizeof(rm_alpm_trie_node_t *) * pos);
+            sal_memcpy(&strie->results[blk + pos + 1],
+                       &strie->results[old + pos],
+                       sizeof(rm_alpm_trie_node_t *) * (num - pos));
+            strie_result_free(strie, old, strie_class(num));
+        }
+    }
+    strie->results[blk + pos] = payload;
+    node->result = blk;
+    node->ibm |= STRIE_BIT(bit);
+    strie->count++;
+    return SHR_E_NONE;
+}
+
+/*
+ * Function:
+ *     strie_result_del
+ * Purpose:
+ *     Remove the payload at internal bitmap position bit of node nidx.
+ */
+static int
+strie_result_del(rm_alpm_strie_t *strie, uint32_t nidx, uint32_t bit)
+{
+    strie_node_t *node;
+    uint32_t num, pos, old, cls;
+
+    node = &strie->nodes[nidx];
+    if (!(node->ibm & STRIE_BIT(bit))) {
+        return SHR_E_NOT_FOUND;
+    }
+    num = strie_popcount(node->ibm);
+    pos = strie_popcount(node->ibm & STRIE_BELOW(bit));
+    old = node->result;
+
+    if (num == 1) {
+        strie_result_free(strie, old, 0);
+        node->result = STRIE_NONE;
+    } else {
+        sal_memmove(&strie->results[old + pos], &strie->results[old + pos + 1],
+                    sizeof(rm_alpm_trie_node_t *) * (num - pos - 1));
+        cls = strie_class(num - 1);
+        if (cls < strie_class(num)) {
+            /* Shrink the block by freeing its upper half. */
+            strie_result_free(strie, old + (1U << cls), cls);
+        }
+    }
+    node->ibm &= ~STRIE_BIT(bit);
+    strie->count--;
+    return SHR_E_NONE;
+}
+
+/*
+ * Function:
+ *     strie_arena_init
+ * Purpose:
+ *     Allocate the initial arenas with an empty root.
+ */
+static int
+strie_arena_init(rm_alpm_strie_t *strie)
+{
+    strie->nodes = sal_alloc(sizeof(strie_node_t) * STRIE_NODES_MIN,
+                             "bcmptmRmalpmStrieNode");
+    strie->results = sal_alloc(sizeof(rm_alpm_trie_node_t *) *
+                               STRIE_RESULTS_MIN,
+                               "bcmptmRmalpmStrieResult");
+    if (strie->nodes == NULL || strie->results == NULL) {
+        return SHR_E_MEMORY;
+    }
+    strie->nodes_max = STRIE_NODES_MIN;
+    strie->results_max = STRIE_RESULTS_MIN;
+    bcmptm_rm_alpm_strie_clear(strie);
+    return SHR_E_NONE;
+}
+
+static void
+strie_arena_free(rm_alpm_strie_t *strie)
+{
+    if (strie->nodes) {
+        sal_free(strie->nodes);
+        strie->nodes = NULL;
+    }
+    if (strie->results) {
+        sal_free(strie->results);
+        strie->results = NULL;
+    }
+}
+
+/*******************************************************************************
+ * Public Functions
+ */
+int
+bcmptm_rm_alpm_strie_create(uint32_t mkl, rm_alpm_strie_t **pstrie)
+{
+    rm_alpm_strie_t *strie;
+    int rv;
+
+    if (pstrie == NULL || mkl == 0 || mkl > RM_ALPM_MAX_KEY_SIZE) {
+        return SHR_E_PARAM;
+    }
+    strie = sal_alloc(sizeof(*strie), "bcmptmRmalpmStrie");
+    if (strie == NULL) {
+        return SHR_E_MEMORY;
+    }
+    sal_memset(strie, 0, sizeof(*strie));
+    strie->mkl = mkl;
+    strie->words = BITS2WORDS(mkl);
+    rv = strie_arena_init(strie);
+    if (SHR_FAILURE(rv)) {
+        strie_arena_free(strie);
+        sal_free(strie);
+        return rv;
+    }
+    *pstrie = strie;
+    return SHR_E_NONE;
+}
+
+void
+bcmptm_rm_alpm_strie_destroy(rm_alpm_strie_t *strie)
+{
+    if (strie) {
+        strie_arena_free(strie);
+        sal_free(strie);
+    }
+}
+
+void
+bcmptm_rm_alpm_strie_clear(rm_alpm_strie_t *strie)
+{
+    sal_memset(strie->nodes_free, 0, sizeof(strie->nodes_free));
+    sal_memset(strie->results_free, 0, sizeof(strie->results_free));
+    sal_memset(&strie->nodes[0], 0, sizeof(strie_node_t));
+    strie->nodes_used = 1;
+    strie->results_used = 1;
+    strie->count = 0;
+}
+
+int
+bcmptm_rm_alpm_strie_insert(rm_alpm_strie_t *strie,
+                            uint32_t *key,
+                            uint32_t length,
+                            rm_alpm_trie_node_t *payload)
+{
+    uint32_t nkey[STRIE_KEY_WORDS];
+    uint32_t nidx = 0, cidx, offset = 0, nib;
+    int rv;
+
+    if (length > strie->mkl) {
+        return SHR_E_PARAM;
+    }
+    strie_key_normalize(strie, key, length, nkey);
+
+    while (length - offset >= STRIE_STRIDE) {
+        nib = strie_nibble(nkey, offset);
+        if (strie->nodes[nidx].ebm & STRIE_BIT(nib)) {
+            cidx = strie->nodes[nidx].child +
+                   strie_popcount(strie->nodes[nidx].ebm &
+                                  (STRIE_BELOW(nib)));
+        } else {
+            rv = strie_child_add(strie, nidx, nib, &cidx);
+            if (SHR_FAILURE(rv)) {
+                return rv;
+            }
+        }
+        nidx = cidx;
+        offset += STRIE_STRIDE;
+    }
+
+    nib = (length > offset) ? strie_nibble(nkey, offset) : 0;
+    return strie_result_add(strie, nidx,
+                            STRIE_IBM_POS(nib, length - offset), payload);
+}
+
+int
+bcmptm_rm_alpm_strie_delete(rm_alpm_strie_t *strie,
+                            uint32_t *key,
+                            uint32_t length)
+{
+    uint32_t nkey[STRIE_KEY_WORDS];
+    uint32_t path[STRIE_MAX_DEPTH], nibs[STRIE_MAX_DEPTH];
+    uint32_t nidx = 0, offset = 0, nib, depth = 0;
+    strie_node_t *node;
+    int rv;
+
+    if (length > strie->mkl) {
+        return SHR_E_PARAM;
+    }
+    strie_key_normalize(strie, key, length, nkey);
+
+    while (length - offset >= STRIE_STRIDE) {
+        nib = strie_nibble(nkey, offset);
+        node = &strie->nodes[nidx];
+        if (!(node->ebm & STRIE_BIT(nib))) {
+            return SHR_E_NOT_FOUND;
+        }
+        path[depth] = nidx;
+        nibs[depth] = nib;
+        depth++;
+        nidx = node->child + strie_popcount(node->ebm & STRIE_BELOW(nib));
+        offset += STRIE_STRIDE;
+    }
+
+    nib = (length > offset) ? strie_nibble(nkey, offset) : 0;
+    rv = strie_result_del(strie, nidx, STRIE_IBM_POS(nib, length - offset));
+    if (SHR_FAILURE(rv)) {
+        return rv;
+    }
+
+    /* Prune the nodes left empty, bottom up. */
+    while (depth > 0) {
+        node = &strie->nodes[nidx];
+        if (node->ibm || node->ebm) {
+            break;
+        }
+        depth--;
+        nidx = path[depth];
+        strie_child_del(strie, nidx, nibs[depth]);
+    }
+    return SHR_E_NONE;
+}
+
+int
+bcmptm_rm_alpm_strie_search(rm_alpm_strie_t *strie,
+                            uint32_t *key,
+                            uint32_t length,
+                            rm_alpm_trie_node_t **payload)
+{
+    uint32_t nkey[STRIE_KEY_WORDS];
+    uint32_t offset = 0, nib, bit;
+    strie_node_t *node = &strie->nodes[0];
+
+    if (length > strie->mkl) {
+        return SHR_E_PARAM;
+    }
+    strie_key_normalize(strie, key, length, nkey);
+
+    while (length - offset >= STRIE_STRIDE) {
+        nib = strie_nibble(nkey, offset);
+        if (!(node->ebm & STRIE_BIT(nib))) {
+            return SHR_E_NOT_FOUND;
+        }
+        node = &strie->nodes[node->child +
+                             strie_popcount(node->ebm & STRIE_BELOW(nib))];
+        offset += STRIE_STRIDE;
+    }
+
+    nib = (length > offset) ? strie_nibble(nkey, offset) : 0;
+    bit = STRIE_IBM_POS(nib, length - offset);
+    if (!(node->ibm & STRIE_BIT(bit))) {
+        return SHR_E_NOT_FOUND;
+    }
+    *payload = strie->results[node->result +
+                              strie_popcount(node->ibm & STRIE_BELOW(bit))];
+    return SHR_E_NONE;
+}
+
+int
+bcmptm_rm_alpm_strie_find_lpm(rm_alpm_strie_t *strie,
+                              uint32_t *key,
+                              uint32_t length,
+                              rm_alpm_trie_node_t **payload,
+                              uint32_t *lpm_pfx,
+                              uint32_t *lpm_len)
+{
+    uint32_t nkey[STRIE_KEY_WORDS];
+    uint32_t offset = 0, nib, bit, rem, len;
+    uint32_t best = STRIE_NONE, best_len = 0;
+    strie_node_t *node = &strie->nodes[0];
+    int l;
+
+    if (length > strie->mkl) {
+        return SHR_E_PARAM;
+    }
+    strie_key_normalize(strie, key, length, nkey);
+
+    while (1) {
+        rem = length - offset;
+        nib = (rem > 0) ? strie_nibble(nkey, offset) : 0;
+        if (node->ibm) {
+            len = (rem < STRIE_STRIDE) ? rem : (STRIE_STRIDE - 1);
+            for (l = len; l >= 0; l--) {
+                bit = STRIE_IBM_POS(nib, l);
+                if (node->ibm & STRIE_BIT(bit)) {
+                    best = node->result +
+                           strie_popcount(node->ibm & STRIE_BELOW(bit));
+                    best_len = offset + l;
+                    break;
+                }
+            }
+        }
+        if (rem < STRIE_STRIDE || !(node->ebm & STRIE_BIT(nib))) {
+            break;
+        }
+        node = &strie->nodes[node->child +
+                             strie_popcount(node->ebm & STRIE_BELOW(nib))];
+        offset += STRIE_STRIDE;
+    }
+
+    if (best == STRIE_NONE) {
+        return SHR_E_NOT_FOUND;
+    }
+    *payload = strie->results[best];
+    if (lpm_len) {
+        *lpm_len = best_len;
+    }
+    if (lpm_pfx) {
+        strie_key_denormalize(strie, nkey, best_len, lpm_pfx);
+    }
+    return SHR_E_NONE;
+}
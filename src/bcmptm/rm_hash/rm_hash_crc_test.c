@@ -0,0 +1,292 @@
+/*! \file rm_hash_crc_test.c
+ *
+ * Self test of the hash vector CRCs.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+#include <sal/sal_types.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_time.h>
+#include <shr/shr_error.h>
+#include <shr/shr_crc.h>
+#include <bcmptm/bcmptm_internal.h>
+#include <bcmptm/bcmptm_rm_hash_internal.h>
+
+
+/*******************************************************************************
+ * Defines
+ */
+/* Largest key in bytes. */
+#define CRC_TEST_KEY_BYTES (BCMPTM_MAX_PT_ENTRY_WORDS * 4)
+
+/*******************************************************************************
+ * Private variables
+ */
+static uint32_t crc_test_tbl32[256];
+static uint16_t crc_test_tbl16[256];
+
+/*******************************************************************************
+ * Private Functions
+ */
+static inline uint32_t
+crc_test_rand(uint32_t *state)
+{
+    /* xorshift32 */
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static uint32_t
+crc_test_swap32(uint32_t i)
+{
+    i = (i << 16) | (i >> 16);
+
+    return (i & 0xff00ffff) >> 8 | (i & 0xffff00ff) << 8;
+}
+
+/*
+ * Build the byte tables of the reference CRCs.
+ */
+static void
+crc_test_tbl_init(void)
+{
+    uint32_t accum;
+    int i, j;
+
+    for (i = 0; i < 256; i++) {
+        accum = i;
+        for (j = 0; j < 8; j++) {
+            accum = (accum & 1) ? (accum >> 1 ^ 0xedb88320UL) : (accum >> 1);
+        }
+        crc_test_tbl32[i] = crc_test_swap32(accum);
+
+        accum = i;
+        for (j = 0; j < 8; j++) {
+            accum = (accum & 1) ? (accum >> 1 ^ 0xa001) : (accum >> 1);
+        }
+        crc_test_tbl16[i] = accum;
+    }
+}
+
+/*
+ * Reference CRC32 of a key, one byte per step. This is the scalar
+ * implementation shr_crc32b() replaced.
+ */
+static uint32_t
+crc_test_ref32(uint32_t crc, uint8_t *data, int nbits)
+{
+    uint32_t accum;
+    int i, j, last_nbits;
+
+    for (i = 0; i < (nbits / 8); i++) {
+        crc = (crc << 8) ^ crc_test_tbl32[data[i] ^ ((crc >> 24) & 0xff)];
+    }
+
+    last_nbits = nbits % 8;
+    if (last_nbits) {
+        accum = ((crc >> (32 - last_nbits)) & ((1 << last_nbits) - 1)) ^
+                (data[i] & ((1 << last_nbits) - 1));
+        for (j = 0; j < last_nbits; j++) {
+            accum = (accum & 1) ? (accum >> 1 ^ 0xedb88320UL) : (accum >> 1);
+        }
+        crc = (crc << last_nbits) ^ crc_test_swap32(accum);
+    }
+
+    return crc;
+}
+
+/*
+ * Reference CRC16 of a key, one byte per step. This is the scalar
+ * implementation shr_crc16b() replaced.
+ */
+static uint16_t
+crc_test_ref16(int crc, uint8_t *data, int nbits)
+{
+    uint32_t accum;
+    int i, j, last_nbits;
+
+    for (i = 0; i < (nbits / 8); i++) {
+        crc = (crc >> 8) ^ crc_test_tbl16[data[i] ^ (crc & 0xff)];
+    }
+
+    last_nbits = nbits % 8;
+    if (last_nbits) {
+        accum = (crc & ((1 << last_nbits) - 1)) ^
+                (data[i] & ((1 << last_nbits) - 1));
+        for (j = 0; j < last_nbits; j++) {
+            accum = (accum & 1) ? (accum >> 1 ^ 0xa001) : (accum >> 1);
+        }
+        crc = (crc >> last_nbits) ^ accum;
+    }
+
+    return crc;
+}
+
+/*******************************************************************************
+ * Public Functions
+ */
+int
+bcmptm_rm_hash_crc_test(int keys, int seed,
+                        bcmptm_rm_hash_crc_test_t *result)
+{
+    uint8_t *key_buf, *key;
+    int *key_bits;
+    uint32_t rand = seed ? (uint32_t)seed : 1;
+    uint32_t *ref32, crc32;
+    uint16_t *ref16, crc16;
+    sal_usecs_t start;
+    int idx, byte, rv;
+
+    if (keys <= 0 || result == NULL) {
+        return SHR_E_PARAM;
+    }
+    sal_memset(result, 0, sizeof(*result));
+
+    key_buf = sal_alloc((size_t)keys * CRC_TEST_KEY_BYTES,
+                        "bcmptmRmHashCrcKey");
+    key_bits = sal_alloc(keys * sizeof(*key_bits), "bcmptmRmHashCrcBits");
+    ref32 = sal_alloc(keys * sizeof(*ref32), "bcmptmRmHashCrcRef32");
+    ref16 = sal_alloc(keys * sizeof(*ref16), "bcmptmRmHashCrcRef16");
+    if (!key_buf || !key_bits || !ref32 || !ref16) {
+        rv = SHR_E_MEMORY;
+        goto exit;
+    }
+
+    for (idx = 0; idx < keys; idx++) {
+        key = key_buf + (size_t)idx * CRC_TEST_KEY_BYTES;
+        for (byte = 0; byte < CRC_TEST_KEY_BYTES; byte++) {
+            key[byte] = crc_test_rand(&rand);
+        }
+        key_bits[idx] = 1 + crc_test_rand(&rand) % (CRC_TEST_KEY_BYTES * 8);
+    }
+    crc_test_tbl_init();
+
+    start = sal_time_usecs();
+    for (idx = 0; idx < keys; idx++) {
+        key = key_buf + (size_t)idx * CRC_TEST_KEY_BYTES;
+        ref16[idx] = crc_test_ref16(0, key, key_bits[idx]);
+        ref32[idx] = crc_test_ref32(0, key, key_bits[idx]);
+    }
+    result->ref_usecs = sal_time_usecs() - start;
+
+    start = sal_time_usecs();
+    for (idx = 0; idx < keys; idx++) {
+        key = key_buf + (size_t)idx * CRC_TEST_KEY_BYTES;
+        crc16 = shr_crc16b(0, key, key_bits[idx]);
+        crc32 = shr_crc32b(0, key, key_bits[idx]);
+        if (crc16 != ref16[idx]) {
+            result->crc16_mismatches++;
+        }
+        if (crc32 != ref32[idx]) {
+            result->crc32_mismatches++;
+        }
+    }
+    result->shr_usecs = sal_time_usecs() - start;
+    result->keys = keys;
+
+    rv = (result->crc16_mismatches || result->crc32_mismatches) ?
+         SHR_E_FAIL : SHR_E_NONE;
+
+exit:
+    if (key_buf) {
+        sal_free(key_buf);
+    }
+    if (key_bits) {
+        sal_free(key_bits);
+    }
+    if (ref32) {
+        sal_free(ref32);
+    }
+    if (ref16) {
+        sal_free(ref16);
+    }
+    return rv;
+}
@@ -110,6 +110,9 @@
  */
 #define BSL_LOG_MODULE BSL_LS_BCMPTM_RMHASH
 
+/*! Length of the runs insertion-sorted before merging the snapshot. */
+#define RM_HASH_TRAVS_SORT_RUN      8
+
 /*******************************************************************************
  * Typedefs
  */
@@ -148,8 +151,7 @@ rm_hash_travs_key_compare(const uint32_t *ent_words_a,
 
     for (idx = 0; idx < key_fields->num_fields; idx++) {
         uint16_t num_words, word;
-        sal_memset(key_field_a, 0, sizeof(key_field_a));
-        sal_memset(key_field_b, 0, sizeof(key_field_b));
+        /* bcmdrd_field_get() writes every word covering the field. */
         sbit = key_fields->field_start_bit[idx];
         ebit = key_fields->field_start_bit[idx] + key_fields->field_width[idx] - 1;
         bcmdrd_field_get(ent_words_a, sbit, ebit, key_field_a);
@@ -287,10 +289,6 @@ rm_hash_travs_snapshot_free(int unit,
 
     SHR_FUNC_ENTER(unit);
 
-    if (lt_ctrl->lt_info.rm_more_info->num_bank_sid > 1) {
-        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
-    }
-
     if (travs_info != NULL) {
         if (travs_info->tbl_snap_array[tbl_snap_idx] != NULL) {
             sal_free(travs_info->tbl_snap_array[tbl_snap_idx]);
@@ -311,7 +309,6 @@ rm_hash_travs_snapshot_free(int unit,
         }
     }
 
-exit:
     SHR_FUNC_EXIT();
 }
 
@@ -335,11 +332,12 @@ rm_hash_travs_snapshot_alloc(int unit,
                              rm_hash_grp_info_t *grp_info,
                              int tbl_snap_idx)
 {
-    uint8_t idx;
+    uint8_t idx, bank;
     const bcmptm_rm_hash_hw_entry_info_t *ent_info = NULL, *nent_info = NULL;
+    const bcmptm_rm_hash_more_info_t *more_info = lt_ctrl->lt_info.rm_more_info;
     bcmdrd_sid_t sid;
     int tbl_inst_cnt = 0;
-    uint32_t ent_idx_cnt, travs_info_size;
+    uint32_t ent_idx_cnt = 0, travs_info_size;
     uint32_t tbl_snap_size;
     rm_hash_lt_travs_info_t *travs_info = NULL;
     rm_hash_tbl_snap_t * tbl_snap = NULL;
@@ -347,9 +345,6 @@ rm_hash_travs_snapshot_alloc(int unit,
 
     SHR_FUNC_ENTER(unit);
 
-    if (lt_ctrl->lt_info.rm_more_info->num_bank_sid > 1) {
-        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
-    }
     nent_info = lt_ctrl->lt_info.hw_entry_info + grp_info->vhei_idx[0];
     /*
      * Try to find the narrowest memory view, as it has the maximum
@@ -377,12 +372,14 @@ rm_hash_travs_snapshot_alloc(int unit,
         lt_ctrl->travs_info = travs_info;
         lt_ctrl->travs_info->tbl_snap_cnt = tbl_inst_cnt;
     }
-    index_min = bcmdrd_pt_index_min(unit, sid);
-    index_max = bcmdrd_pt_index_max(unit, sid);
-    if ((index_min) < 0 || (index_max < 0) || (index_min > index_max)) {
-        ent_idx_cnt = 0;
-    } else {
-        ent_idx_cnt = (1 + index_max - index_min);
+    /* Each bank with a separate SID contributes its own entries. */
+    for (bank = 0; bank < more_info->num_bank_sid; bank++) {
+        sid = nent_info->sid[bank];
+        index_min = bcmdrd_pt_index_min(unit, sid);
+        index_max = bcmdrd_pt_index_max(unit, sid);
+        if ((index_min >= 0) && (index_max >= 0) && (index_min <= index_max)) {
+            ent_idx_cnt += (1 + index_max - index_min);
+        }
     }
     
     tbl_snap_size = (sizeof(rm_hash_ent_snap_t) + sizeof(rm_hash_ent_snap_t *)) *
@@ -404,60 +401,161 @@ exit:
 }
 
 /*!
- * \brief Insert an entry snapshot into the lt snapshot structure
+ * \brief Add an entry snapshot into the lt snapshot structure
  *
- * This function get the first element of sorted entry list.
+ * This function appends the entry to the entry snapshot array. The sorted
+ * list is built by rm_hash_travs_ent_snap_sort once all the entries have
+ * been collected.
  *
  * \param [in] unit Unit number.
  * \param [in] lt_ctrl Pointer to rm_hash_lt_ctrl_t structure corresponding
  *             to a LT.
  * \param [in] ent_info Pointer to bcmptm_rm_hash_hw_entry_info_t structure.
- * \param [in] tbl_inst Table instance.
+ * \param [in] tbl_snap_idx Table instance.
  * \param [in] ent_words Entry key words.
  *
  * \retval SHR_E_NONE No errors.
  * \retval !SHR_E_NONE Failure.
  */
 static int
-rm_hash_travs_ent_snap_insert(int unit,
-                              rm_hash_lt_ctrl_t *lt_ctrl,
-                              const bcmptm_rm_hash_hw_entry_info_t *ent_info,
-                              int tbl_snap_idx,
-                              uint32_t *ent_words)
+rm_hash_travs_ent_snap_add(int unit,
+                           rm_hash_lt_ctrl_t *lt_ctrl,
+                           const bcmptm_rm_hash_hw_entry_info_t *ent_info,
+                           int tbl_snap_idx,
+                           uint32_t *ent_words)
 {
-    rm_hash_lt_travs_info_t *travs_info = NULL;
     rm_hash_tbl_snap_t *tbl_snap = NULL;
     rm_hash_ent_snap_t *ent_snap = NULL;
-    uint32_t *ent_snap_words = NULL, idx, num_move, k;
-    rm_hash_ent_snap_t **ent_snap_base = NULL;
 
     SHR_FUNC_ENTER(unit);
 
-    travs_info = lt_ctrl->travs_info;
-    tbl_snap = travs_info->tbl_snap_array[tbl_snap_idx];
+    tbl_snap = lt_ctrl->travs_info->tbl_snap_array[tbl_snap_idx];
+    if (tbl_snap->ent_snap_cnt >= tbl_snap->ent_snap_max) {
+        SHR_RETURN_VAL_EXIT(SHR_E_INTERNAL);
+    }
     ent_snap = &tbl_snap->ent_snap_array[tbl_snap->ent_snap_cnt];
-    ent_snap_words = ent_snap->ent_words;
-    sal_memcpy(ent_snap_words, ent_words, (ent_info->entry_bitsize + 7) / 8);
-    SHR_IF_ERR_EXIT
-        (rm_hash_travs_sorted_ent_snap_base_get(unit,
-                                                lt_ctrl->travs_info,
-                                                tbl_snap_idx,
-                                                &ent_snap_base));
-    for (idx = 0; idx < tbl_snap->ent_snap_cnt; idx++) {
-        if (rm_hash_travs_key_compare(ent_snap->ent_words,
-                                      ent_snap_base[idx]->ent_words,
-                                      lt_ctrl->lt_info.rm_more_info) < 0) {
-            break;
+    sal_memcpy(ent_snap->ent_words, ent_words, (ent_info->entry_bitsize + 7) / 8);
+    tbl_snap->sorted_ent_snap_base[tbl_snap->ent_snap_cnt] = ent_snap;
+    tbl_snap->ent_snap_cnt++;
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/*!
+ * \brief Merge two adjacent sorted runs of entry snapshot pointers.
+ *
+ * \param [in] src Source pointer array containing runs [lo, mid) and [mid, hi).
+ * \param [out] dst Destination pointer array for the merged run [lo, hi).
+ * \param [in] lo Start of the first run.
+ * \param [in] mid Start of the second run.
+ * \param [in] hi End of the second run.
+ * \param [in] more_info Pointer to bcmptm_rm_hash_more_info_t structure.
+ */
+static void
+rm_hash_travs_ent_snap_merge(rm_hash_ent_snap_t **src,
+                             rm_hash_ent_snap_t **dst,
+                             uint32_t lo,
+                             uint32_t mid,
+                             uint32_t hi,
+                             const bcmptm_rm_hash_more_info_t *more_info)
+{
+    uint32_t i = lo, j = mid, k = lo;
+
+    while ((i < mid) && (j < hi)) {
+        /* Take from the first run on ties to keep the sort stable. */
+        if (rm_hash_travs_key_compare(src[j]->ent_words,
+                                      src[i]->ent_words,
+                                      more_info) < 0) {
+            dst[k++] = src[j++];
+        } else {
+            dst[k++] = src[i++];
         }
     }
-    num_move = tbl_snap->ent_snap_cnt - idx;
-    for (k = tbl_snap->ent_snap_cnt - 1; num_move > 0; k--, num_move--) {
-        ent_snap_base[k + 1] = ent_snap_base[k];
+    while (i < mid) {
+        dst[k++] = src[i++];
+    }
+    while (j < hi) {
+        dst[k++] = src[j++];
+    }
+}
+
+/*!
+ * \brief Sort the entry snapshot list of a table instance.
+ *
+ * This function sorts the collected entry snapshot pointers in ascending
+ * key order. Short runs are insertion sorted in place, and then merged
+ * bottom-up through a temporary pointer array.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] lt_ctrl Pointer to rm_hash_lt_ctrl_t structure corresponding
+ *             to a LT.
+ * \param [in] tbl_snap_idx Table instance.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval !SHR_E_NONE Failure.
+ */
+static int
+rm_hash_travs_ent_snap_sort(int unit,
+                            rm_hash_lt_ctrl_t *lt_ctrl,
+                            int tbl_snap_idx)
+{
+    const bcmptm_rm_hash_more_info_t *more_info = lt_ctrl->lt_info.rm_more_info;
+    rm_hash_tbl_snap_t *tbl_snap = NULL;
+    rm_hash_ent_snap_t **base = NULL, **tmp = NULL, **src, **dst, **swap;
+    rm_hash_ent_snap_t *ent_snap = NULL;
+    uint32_t num, lo, mid, hi, width, idx, k;
+
+    SHR_FUNC_ENTER(unit);
+
+    tbl_snap = lt_ctrl->travs_info->tbl_snap_array[tbl_snap_idx];
+    base = tbl_snap->sorted_ent_snap_base;
+    num = tbl_snap->ent_snap_cnt;
+
+    for (lo = 0; lo < num; lo += RM_HASH_TRAVS_SORT_RUN) {
+        hi = lo + RM_HASH_TRAVS_SORT_RUN;
+        if (hi > num) {
+            hi = num;
+        }
+        for (idx = lo + 1; idx < hi; idx++) {
+            ent_snap = base[idx];
+            for (k = idx; k > lo; k--) {
+                if (rm_hash_travs_key_compare(ent_snap->ent_words,
+                                              base[k - 1]->ent_words,
+                                              more_info) >= 0) {
+                    break;
+                }
+                base[k] = base[k - 1];
+            }
+            base[k] = ent_snap;
+        }
+    }
+    if (num <= RM_HASH_TRAVS_SORT_RUN) {
+        SHR_EXIT();
+    }
+
+    tmp = sal_alloc(sizeof(rm_hash_ent_snap_t *) * num, "rmHashTravsSort");
+    SHR_NULL_CHECK(tmp, SHR_E_MEMORY);
+    src = base;
+    dst = tmp;
+    for (width = RM_HASH_TRAVS_SORT_RUN; width < num; width *= 2) {
+        for (lo = 0; lo < num; lo += 2 * width) {
+            mid = (lo + width < num) ? (lo + width) : num;
+            hi = (mid + width < num) ? (mid + width) : num;
+            rm_hash_travs_ent_snap_merge(src, dst, lo, mid, hi, more_info);
+        }
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != base) {
+        sal_memcpy(base, src, sizeof(rm_hash_ent_snap_t *) * num);
     }
-    ent_snap_base[idx] = ent_snap;
-    tbl_snap->ent_snap_cnt++;
 
 exit:
+    if (tmp != NULL) {
+        sal_free(tmp);
+    }
     SHR_FUNC_EXIT();
 }
 
@@ -480,25 +578,27 @@ rm_hash_travs_snapshot_build(int unit,
                              rm_hash_grp_info_t *grp_info,
                              bcmbd_pt_dyn_info_t *pt_dyn_info)
 {
-    uint8_t idx;
+    uint32_t idx;
+    uint8_t bank;
     const bcmptm_rm_hash_hw_entry_info_t *ent_info = NULL;
     bcmdrd_sid_t sid;
     int index_min, index_max, ent_index;
-    int tbl_inst_cnt = 0, tbl_snap_idx;
+    int tbl_inst_cnt = 0, tbl_snap_idx = 0;
     uint32_t entry[BCMPTM_MAX_PT_ENTRY_WORDS];
     rm_hash_lt_travs_info_t *travs_info = lt_ctrl->travs_info;
+    uint8_t num_bank_sid = lt_ctrl->lt_info.rm_more_info->num_bank_sid;
 
     SHR_FUNC_ENTER(unit);
 
-    if (lt_ctrl->lt_info.rm_more_info->num_bank_sid > 1) {
-        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
-    }
     if (travs_info == NULL) {
         SHR_RETURN_VAL_EXIT(SHR_E_INTERNAL);
     }
-    for (idx = 0; idx < grp_info->num_vhei; idx++) {
-        ent_info = lt_ctrl->lt_info.hw_entry_info + grp_info->vhei_idx[idx];
-        sid = ent_info->sid[0];
+    /* Walk every bank SID of every valid hardware entry view. */
+    for (idx = 0; idx < (uint32_t)(grp_info->num_vhei * num_bank_sid); idx++) {
+        ent_info = lt_ctrl->lt_info.hw_entry_info +
+                   grp_info->vhei_idx[idx / num_bank_sid];
+        bank = idx % num_bank_sid;
+        sid = ent_info->sid[bank];
         index_min = bcmdrd_pt_index_min(unit, sid);
         index_max = bcmdrd_pt_index_max(unit, sid);
         tbl_inst_cnt = bcmdrd_pt_num_tbl_inst(unit, sid);
@@ -536,14 +636,16 @@ rm_hash_travs_snapshot_build(int unit,
                                      &rsp_flags));
             if ((cache_valid == TRUE) && (ltid == lt_ctrl->ltid)) {
                 SHR_IF_ERR_EXIT
-                    (rm_hash_travs_ent_snap_insert(unit,
-                                                   lt_ctrl,
-                                                   ent_info,
-                                                   tbl_snap_idx,
-                                                   entry));
+                    (rm_hash_travs_ent_snap_add(unit,
+                                                lt_ctrl,
+                                                ent_info,
+                                                tbl_snap_idx,
+                                                entry));
             }
         }
     }
+    SHR_IF_ERR_EXIT
+        (rm_hash_travs_ent_snap_sort(unit, lt_ctrl, tbl_snap_idx));
 
 exit:
     SHR_FUNC_EXIT();
@@ -603,9 +705,6 @@ rm_hash_travs_get_first_op_proc(int unit,
     SHR_IF_ERR_EXIT
         (bcmptm_rm_hash_lt_ctrl_get(unit, req_ltid, &lt_ctrl));
     SHR_NULL_CHECK(lt_ctrl, SHR_E_PARAM);
-    if (lt_ctrl->lt_info.rm_more_info->num_bank_sid > 1) {
-        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
-    }
     /* Get more info based on req_info */
     SHR_IF_ERR_EXIT
         (bcmptm_rm_hash_ent_more_info_get(unit,
@@ -754,9 +853,6 @@ rm_hash_travs_get_next_op_proc(int unit,
     SHR_IF_ERR_EXIT
         (bcmptm_rm_hash_lt_ctrl_get(unit, req_ltid, &lt_ctrl));
     SHR_NULL_CHECK(lt_ctrl, SHR_E_PARAM);
-    if (lt_ctrl->lt_info.rm_more_info->num_bank_sid > 1) {
-        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
-    }
 
     /* Get more info based on req_info */
     SHR_IF_ERR_EXIT
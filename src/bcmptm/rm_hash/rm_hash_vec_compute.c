@@ -111,10 +111,43 @@
 #define BSL_LOG_MODULE BSL_LS_BCMPTM_RMHASH
 
 
+/*! CRC16 of key a is valid. */
+#define RM_HASH_CRC16_A                         (1 << 0)
+
+/*! CRC16 of key b is valid. */
+#define RM_HASH_CRC16_B                         (1 << 1)
+
+/*! CRC32 of key a is valid. */
+#define RM_HASH_CRC32_A                         (1 << 2)
+
+/*! CRC32 of key b is valid. */
+#define RM_HASH_CRC32_B                         (1 << 3)
+
 /*******************************************************************************
  * Typedefs
  */
+/*!
+ * \brief CRC values of the keys of an entry.
+ *
+ * The CRC values of a key do not depend on the bank, so each of them is
+ * computed at most once for an entry and shared by all the banks.
+ */
+typedef struct rm_hash_crc_val_s {
+    /*! Bitmap of RM_HASH_CRCxx_x flags for the valid values. */
+    uint32_t valid;
+
+    /*! Bit reversed CRC16 of key a. */
+    uint16_t crc16_a;
+
+    /*! Bit reversed CRC16 of key b. */
+    uint16_t crc16_b;
 
+    /*! Byte reversed CRC32 of key a. */
+    uint32_t crc32_a;
+
+    /*! Byte reversed CRC32 of key b. */
+    uint32_t crc32_b;
+} rm_hash_crc_val_t;
 
 /*******************************************************************************
  * Private variables
@@ -149,40 +182,91 @@ rm_hash_crc32b(uint8_t *data, int data_nbits)
     return rv;
 }
 
-/*******************************************************************************
- * Public Functions
+/*!
+ * \brief Get the CRC16 of a key, computing it on first use.
+ *
+ * \param [in] key Pointer to the buffer that contains the key.
+ * \param [in] key_size Key size in unit of bit.
+ * \param [in] flag RM_HASH_CRC16_A or RM_HASH_CRC16_B.
+ * \param [in,out] crc_val Pointer to the CRC values of the entry.
  */
-int
-bcmptm_rm_hash_vector_compute(int unit,
-                              uint32_t *entry,
-                              uint8_t *key_a,
-                              uint8_t *key_b,
-                              int key_size,
-                              uint8_t *bank_list,
-                              uint8_t num_banks,
-                              const bcmptm_rm_hash_more_info_t *more_info,
-                              rm_hash_pt_info_t *pt_info,
-                              uint32_t *bucket)
+static uint16_t
+rm_hash_crc16_get(uint8_t *key, int key_size, uint32_t flag,
+                  rm_hash_crc_val_t *crc_val)
+{
+    uint16_t *val;
+
+    val = (flag == RM_HASH_CRC16_A) ? &crc_val->crc16_a : &crc_val->crc16_b;
+    if ((crc_val->valid & flag) == 0) {
+        *val = rm_hash_crc16b(key, key_size);
+        crc_val->valid |= flag;
+    }
+    return *val;
+}
+
+/*!
+ * \brief Get the CRC32 of a key, computing it on first use.
+ *
+ * \param [in] key Pointer to the buffer that contains the key.
+ * \param [in] key_size Key size in unit of bit.
+ * \param [in] flag RM_HASH_CRC32_A or RM_HASH_CRC32_B.
+ * \param [in,out] crc_val Pointer to the CRC values of the entry.
+ */
+static uint32_t
+rm_hash_crc32_get(uint8_t *key, int key_size, uint32_t flag,
+                  rm_hash_crc_val_t *crc_val)
+{
+    uint32_t *val;
+
+    val = (flag == RM_HASH_CRC32_A) ? &crc_val->crc32_a : &crc_val->crc32_b;
+    if ((crc_val->valid & flag) == 0) {
+        *val = rm_hash_crc32b(key, key_size);
+        crc_val->valid |= flag;
+    }
+    return *val;
+}
+
+/*!
+ * \brief Compute the hash vector of an entry from its CRC values.
+ *
+ * The CRC values which are not yet valid in \c crc_val are computed on
+ * demand.
+ *
+ * \param [in] entry Pointer to entry.
+ * \param [in] key_a Pointer to entry key a.
+ * \param [in] key_b Pointer to entry key b.
+ * \param [in] key_size Key size.
+ * \param [in] bank_list Pointer to bank list.
+ * \param [in] num_banks Number of banks to compute vector.
+ * \param [in] e_bm Entry bucket mode.
+ * \param [in] table_attr Hash vector attribute of the table.
+ * \param [in] pt_info Pointer to rm_hash_pt_info_t structure.
+ * \param [in,out] crc_val CRC values of the entry.
+ * \param [out] bucket Pointer to hash vector.
+ *
+ * \retval SHR_E_NONE No errors.
+ * \retval !SHR_E_NONE Failure.
+ */
+static int
+rm_hash_bucket_compute(uint32_t *entry,
+                       uint8_t *key_a,
+                       uint8_t *key_b,
+                       int key_size,
+                       uint8_t *bank_list,
+                       uint8_t num_banks,
+                       rm_hash_bm_t e_bm,
+                       const bcmptm_rm_hash_vector_attr_t *table_attr,
+                       rm_hash_pt_info_t *pt_info,
+                       rm_hash_crc_val_t *crc_val,
+                       uint32_t *bucket)
 {
     uint32_t lsb_val = 0, crc16_val = 0, crc32_val = 0;
     uint32_t vector, upper_half = 0, lower_half = 0;
     uint16_t sbit, ebit, uppermost = 0;
     uint8_t idx;
-    const bcmptm_rm_hash_vector_attr_t *table_attr = NULL;
     rm_hash_vector_info_t *vec_info = NULL;
-    rm_hash_bm_t e_bm;
-    bool upper_half_computed = FALSE;
-    bool lower_half_computed = FALSE;
     uint64_t hash_vector, hash_mask;
 
-    SHR_FUNC_ENTER(unit);
-
-    table_attr = more_info->hash_vector_attr;
-    SHR_IF_ERR_EXIT
-        (bcmptm_rm_hash_ent_bkt_mode_get(unit,
-                                         more_info,
-                                         pt_info,
-                                         &e_bm));
     for (idx = 0; idx < num_banks; idx++) {
         bcmptm_rm_hash_vector_type_t type;
         uint16_t offset;
@@ -208,23 +292,27 @@ bcmptm_rm_hash_vector_compute(int unit,
             mask = (vec_info->mask + 1) / 4 - 1;
             break;
         default:
-            SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+            return SHR_E_PARAM;
         }
 
         switch (type) {
         case BCMPTM_RM_HASH_VEC_CRC16:
             if (bank == 0) {
-                crc16_val = rm_hash_crc16b(key_a, key_size);
+                crc16_val = rm_hash_crc16_get(key_a, key_size,
+                                              RM_HASH_CRC16_A, crc_val);
             } else {
-                crc16_val = rm_hash_crc16b(key_b, key_size);
+                crc16_val = rm_hash_crc16_get(key_b, key_size,
+                                              RM_HASH_CRC16_B, crc_val);
             }
             bucket[bank] = (crc16_val >> offset) & mask;
             break;
         case BCMPTM_RM_HASH_VEC_CRC32:
             if (bank == 0) {
-                crc32_val = rm_hash_crc32b(key_a, key_size);
+                crc32_val = rm_hash_crc32_get(key_a, key_size,
+                                              RM_HASH_CRC32_A, crc_val);
             } else {
-                crc32_val = rm_hash_crc32b(key_b, key_size);
+                crc32_val = rm_hash_crc32_get(key_b, key_size,
+                                              RM_HASH_CRC32_B, crc_val);
             }
             bucket[bank] = (crc32_val >> offset) & mask;
             break;
@@ -252,26 +340,20 @@ bcmptm_rm_hash_vector_compute(int unit,
                 }
                 bucket[bank] = vector & mask;
             } else if (offset >= 32) {
-                if (upper_half_computed == FALSE) {
-                    upper_half = rm_hash_crc16b(key_a, key_size) |
+                upper_half = rm_hash_crc16_get(key_a, key_size,
+                                               RM_HASH_CRC16_A, crc_val) |
                              (uppermost << 16);
-                    upper_half_computed = TRUE;
-                }
                 vector = upper_half;
                 if (offset > 32) {
                     vector >>= offset - 32;
                 }
                 bucket[bank] = vector & mask;
             } else {
-                if (lower_half_computed == FALSE) {
-                    lower_half = rm_hash_crc32b(key_a, key_size);
-                    lower_half_computed = TRUE;
-                }
-                if (upper_half_computed == FALSE) {
-                    upper_half = rm_hash_crc16b(key_a, key_size) |
+                lower_half = rm_hash_crc32_get(key_a, key_size,
+                                               RM_HASH_CRC32_A, crc_val);
+                upper_half = rm_hash_crc16_get(key_a, key_size,
+                                               RM_HASH_CRC16_A, crc_val) |
                              (uppermost << 16);
-                    upper_half_computed = TRUE;
-                }
                 vector = lower_half;
                 if (offset > 0) {
                     vector >>= offset;
@@ -282,8 +364,10 @@ bcmptm_rm_hash_vector_compute(int unit,
             break;
         case BCMPTM_RM_HASH_VEC_CRC32A_CRC32B:
             /*  64 vector {crc32_B[31:0], crc32_A[31:0]} */
-            upper_half = rm_hash_crc32b(key_b, key_size);
-            lower_half = rm_hash_crc32b(key_a, key_size);
+            upper_half = rm_hash_crc32_get(key_b, key_size,
+                                           RM_HASH_CRC32_B, crc_val);
+            lower_half = rm_hash_crc32_get(key_a, key_size,
+                                           RM_HASH_CRC32_A, crc_val);
             COMPILER_64_SET(hash_vector, upper_half, lower_half);
             COMPILER_64_SET(hash_mask, 0, mask);
             COMPILER_64_SHR(hash_vector, offset);
@@ -295,7 +379,48 @@ bcmptm_rm_hash_vector_compute(int unit,
         }
     }
 
+    return SHR_E_NONE;
+}
+
+/*******************************************************************************
+ * Public Functions
+ */
+int
+bcmptm_rm_hash_vector_compute(int unit,
+                              uint32_t *entry,
+                              uint8_t *key_a,
+                              uint8_t *key_b,
+                              int key_size,
+                              uint8_t *bank_list,
+                              uint8_t num_banks,
+                              const bcmptm_rm_hash_more_info_t *more_info,
+                              rm_hash_pt_info_t *pt_info,
+                              uint32_t *bucket)
+{
+    rm_hash_bm_t e_bm;
+    rm_hash_crc_val_t crc_val;
+
+    SHR_FUNC_ENTER(unit);
+
+    sal_memset(&crc_val, 0, sizeof(crc_val));
+
+    SHR_IF_ERR_EXIT
+        (bcmptm_rm_hash_ent_bkt_mode_get(unit,
+                                         more_info,
+                                         pt_info,
+                                         &e_bm));
+    SHR_IF_ERR_EXIT
+        (rm_hash_bucket_compute(entry,
+                                key_a,
+                                key_b,
+                                key_size,
+                                bank_list,
+                                num_banks,
+                                e_bm,
+                                more_info->hash_vector_attr,
+                                pt_info,
+                                &crc_val,
+                                bucket));
 exit:
     SHR_FUNC_EXIT();
 }
-
@@ -108,6 +108,7 @@
 #include "rm_tcam_prio_atomicity.h"
 #include "rm_tcam_fp.h"
 #include "rm_tcam_fp_entry_mgmt.h"
+#include "rm_tcam_prio_index.h"
 
 
 /*******************************************************************************
@@ -674,6 +675,9 @@ bcmptm_rm_tcam_fp_entry_segment_clear(int unit,
         entry_hash[idx] = BCMPTM_RM_TCAM_OFFSET_INVALID;
     }
 
+    /* Segment layout changed, priority indexes must be rebuilt. */
+    bcmptm_rm_tcam_prio_index_destroy_all(unit);
+
 exit:
     SHR_FUNC_EXIT();
 
@@ -736,6 +740,9 @@ bcmptm_rm_tcam_fp_entry_segment_move(int unit,
                (num_entries_per_slice
                * sizeof(int)));
 
+    /* Segment layout changed, priority indexes must be rebuilt. */
+    bcmptm_rm_tcam_prio_index_destroy_all(unit);
+
 exit:
     SHR_FUNC_EXIT();
 
@@ -1517,6 +1524,7 @@ bcmptm_rm_tcam_fp_presel_entries_clear(int unit,
         entry_info[index].entry_id = BCMPTM_RM_TCAM_EID_INVALID;
         entry_info[index].entry_pri = BCMPTM_RM_TCAM_PRIO_INVALID;
         entry_info[index].offset = BCMPTM_RM_TCAM_OFFSET_INVALID;
+        bcmptm_rm_tcam_prio_index_sync(unit, entry_info, index);
 
     }
 exit:
@@ -110,6 +110,7 @@
 #include "rm_tcam_fp.h"
 #include "rm_tcam_fp_entry_mgmt.h"
 #include "rm_tcam_traverse.h"
+#include "rm_tcam_prio_index.h"
 #include <bcmptm/bcmptm_cmdproc_internal.h>
 #include <bcmltd/chip/bcmltd_id.h>
 #include <bcmltd/chip/bcmltd_limits.h>
@@ -272,6 +273,8 @@ bcmptm_rm_tcam_cleanup(int unit)
     SHR_IF_ERR_VERBOSE_EXIT(
         bcmptm_rm_tcam_traverse_info_delete_all(unit));
 
+    bcmptm_rm_tcam_prio_index_destroy_all(unit);
+
 exit:
     SHR_FUNC_EXIT();
 }
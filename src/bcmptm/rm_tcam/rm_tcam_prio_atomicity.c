@@ -107,6 +107,7 @@
 #include "rm_tcam_prio_only.h"
 #include "rm_tcam_prio_eid.h"
 #include "rm_tcam_prio_atomicity.h"
+#include "rm_tcam_prio_index.h"
 #include "rm_tcam_fp.h"
 #include "rm_tcam_fp_utils.h"
 #include <bcmptm/bcmptm_cmdproc_internal.h>
@@ -226,6 +227,7 @@ rm_tcam_prio_only_entry_update_prio(int unit,
         entry_info[idx].entry_pri = req_info->entry_pri;
         entry_info[idx].offset = BCMPTM_RM_TCAM_OFFSET_INVALID;
         entry_info[idx].entry_type = entry_type;
+        bcmptm_rm_tcam_prio_index_sync(unit, entry_info, idx);
     }
 
     /* 2. Update the TCAM SW hash table. */
@@ -336,6 +338,7 @@ rm_tcam_prio_entry_update_prio(int unit,
     entry_info[target_index].entry_id = req_info->entry_id;
     entry_info[target_index].entry_pri = req_info->entry_pri;
     entry_info[target_index].offset = BCMPTM_RM_TCAM_OFFSET_INVALID;
+    bcmptm_rm_tcam_prio_index_sync(unit, entry_info, target_index);
 
     /* 2. Update the TCAM SW hash table. */
     hash_val = (entry_info[target_index].entry_id)
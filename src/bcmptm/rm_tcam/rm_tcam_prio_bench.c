@@ -0,0 +1,418 @@
+/*! \file rm_tcam_prio_bench.c
+ *
+ * Benchmark of TCAM target slot allocation, comparing the linear
+ * priority scan with the priority index.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+
+/*******************************************************************************
+ * Includes
+ */
+#include <bsl/bsl.h>
+#include <sal/sal_types.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_time.h>
+#include <shr/shr_error.h>
+#include <shr/shr_debug.h>
+#include <bcmdrd_config.h>
+#include <bcmptm/bcmptm_rm_tcam_internal.h>
+#include "rm_tcam.h"
+#include "rm_tcam_prio_eid.h"
+#include "rm_tcam_prio_index.h"
+
+
+/*******************************************************************************
+ * Defines
+ */
+#define BSL_LOG_MODULE BSL_LS_BCMPTM_RMTCAM
+
+/* Number of distinct entry priorities. */
+#define PRIO_BENCH_PRI_RANGE 1024
+
+/* Percentage of TCAM entries installed before churning. */
+#define PRIO_BENCH_FILL_PCT 90
+
+/*******************************************************************************
+ * Typedefs
+ */
+typedef struct prio_bench_ctrl_s {
+    /* Logical device id */
+    int unit;
+
+    /* Number of TCAM entries */
+    uint32_t num_entries;
+
+    /* Number of free TCAM entries */
+    uint32_t free_entries;
+
+    /* Random number state */
+    uint32_t rand;
+
+    /* Simulated TCAM entry information */
+    bcmptm_rm_tcam_prio_entry_info_t *entry_info;
+
+    /* Target slots of the reference run */
+    int *targets;
+} prio_bench_ctrl_t;
+
+/*******************************************************************************
+ * Private Functions
+ */
+static inline uint32_t
+prio_bench_rand(prio_bench_ctrl_t *ctrl)
+{
+    /* xorshift32 */
+    ctrl->rand ^= ctrl->rand << 13;
+    ctrl->rand ^= ctrl->rand >> 17;
+    ctrl->rand ^= ctrl->rand << 5;
+    return ctrl->rand;
+}
+
+/*
+ * Function:
+ *     prio_bench_entry_set
+ * Purpose:
+ *     Update one slot of the simulated entry information.
+ */
+static void
+prio_bench_entry_set(prio_bench_ctrl_t *ctrl, uint32_t idx,
+                     int entry_id, int entry_pri)
+{
+    ctrl->entry_info[idx].entry_id = entry_id;
+    ctrl->entry_info[idx].entry_pri = entry_pri;
+    bcmptm_rm_tcam_prio_index_sync(ctrl->unit, ctrl->entry_info, idx);
+}
+
+/*
+ * Function:
+ *     prio_bench_target_get
+ * Purpose:
+ *     Find the target slot of a new entry the way
+ *     bcmptm_rm_tcam_prio_entry_index_allocate does.
+ */
+static int
+prio_bench_target_get(prio_bench_ctrl_t *ctrl, bool indexed, int entry_pri,
+                      int *target_idx, int *from_idx, int *to_idx)
+{
+    bcmptm_rm_tcam_prio_index_t *prio_index = NULL;
+
+    SHR_FUNC_ENTER(ctrl->unit);
+
+    if (ctrl->free_entries == 0) {
+        SHR_RETURN_VAL_EXIT(SHR_E_FULL);
+    }
+
+    if (ctrl->free_entries == ctrl->num_entries) {
+        *target_idx = *from_idx = *to_idx = 0;
+    } else if (indexed) {
+        SHR_IF_ERR_EXIT
+            (bcmptm_rm_tcam_prio_index_get(ctrl->unit,
+                                           BCMPTM_RM_TCAM_PRIO_INDEX_EID,
+                                           ctrl->entry_info,
+                                           ctrl->num_entries,
+                                           ctrl->free_entries,
+                                           &prio_index));
+        SHR_IF_ERR_EXIT
+            (bcmptm_rm_tcam_prio_index_target_get(ctrl->unit, prio_index,
+                                                  entry_pri, target_idx,
+                                                  from_idx, to_idx));
+    } else {
+        SHR_IF_ERR_EXIT
+            (bcmptm_rm_tcam_prio_slot_scan(ctrl->unit, ctrl->entry_info,
+                                           ctrl->num_entries, entry_pri,
+                                           target_idx, from_idx, to_idx));
+    }
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/*
+ * Function:
+ *     prio_bench_insert
+ * Purpose:
+ *     Insert one entry, shifting entries in software only.
+ */
+static int
+prio_bench_insert(prio_bench_ctrl_t *ctrl, bool indexed,
+                  int entry_id, int entry_pri,
+                  int *target, uint32_t *moves)
+{
+    bcmptm_rm_tcam_prio_entry_info_t *entry_info = ctrl->entry_info;
+    int target_idx = 0;
+    int from_idx = 0;
+    int to_idx = 0;
+    int idx;
+
+    SHR_FUNC_ENTER(ctrl->unit);
+
+    SHR_IF_ERR_EXIT
+        (prio_bench_target_get(ctrl, indexed, entry_pri,
+                               &target_idx, &from_idx, &to_idx));
+
+    /* Shift the entries in [from_idx, to_idx) toward to_idx. */
+    if (to_idx > from_idx) {
+        for (idx = to_idx; idx > from_idx; idx--) {
+            prio_bench_entry_set(ctrl, idx, entry_info[idx - 1].entry_id,
+                                 entry_info[idx - 1].entry_pri);
+        }
+        *moves += to_idx - from_idx;
+    } else {
+        for (idx = to_idx; idx < from_idx; idx++) {
+            prio_bench_entry_set(ctrl, idx, entry_info[idx + 1].entry_id,
+                                 entry_info[idx + 1].entry_pri);
+        }
+        *moves += from_idx - to_idx;
+    }
+
+    prio_bench_entry_set(ctrl, target_idx, entry_id, entry_pri);
+    ctrl->free_entries--;
+    *target = target_idx;
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/*
+ * Function:
+ *     prio_bench_delete
+ * Purpose:
+ *     Delete a random installed entry.
+ */
+static void
+prio_bench_delete(prio_bench_ctrl_t *ctrl)
+{
+    uint32_t idx;
+
+    do {
+        idx = prio_bench_rand(ctrl) % ctrl->num_entries;
+    } while (ctrl->entry_info[idx].entry_id == BCMPTM_RM_TCAM_EID_INVALID);
+
+    prio_bench_entry_set(ctrl, idx, BCMPTM_RM_TCAM_EID_INVALID,
+                         BCMPTM_RM_TCAM_PRIO_INVALID);
+    ctrl->free_entries++;
+}
+
+/*
+ * Function:
+ *     prio_bench_check
+ * Purpose:
+ *     Record the target slot in the reference run, or count a mismatch
+ *     against it in the indexed run.
+ */
+static void
+prio_bench_check(prio_bench_ctrl_t *ctrl, bool indexed, uint32_t op,
+                 int target, bcmptm_rm_tcam_prio_bench_t *bench)
+{
+    if (!indexed) {
+        ctrl->targets[op] = target;
+    } else if (ctrl->targets[op] != target) {
+        bench->mismatches++;
+    }
+}
+
+/*
+ * Function:
+ *     prio_bench_run
+ * Purpose:
+ *     Run the benchmark with one slot allocation method.
+ */
+static int
+prio_bench_run(prio_bench_ctrl_t *ctrl,
+               bool indexed,
+               uint32_t seed,
+               uint32_t churns,
+               bcmptm_rm_tcam_prio_bench_t *bench)
+{
+    uint32_t idx, op = 0;
+    uint32_t inserts;
+    int target, from_idx, to_idx;
+    sal_usecs_t start;
+
+    SHR_FUNC_ENTER(ctrl->unit);
+
+    sal_memset(bench, 0, sizeof(*bench));
+    ctrl->rand = seed ? seed : 1;
+    ctrl->free_entries = ctrl->num_entries;
+    for (idx = 0; idx < ctrl->num_entries; idx++) {
+        ctrl->entry_info[idx].entry_id = BCMPTM_RM_TCAM_EID_INVALID;
+        ctrl->entry_info[idx].entry_pri = BCMPTM_RM_TCAM_PRIO_INVALID;
+        ctrl->entry_info[idx].offset = BCMPTM_RM_TCAM_OFFSET_INVALID;
+    }
+    bcmptm_rm_tcam_prio_index_destroy(ctrl->unit, ctrl->entry_info);
+
+    inserts = (uint64_t)ctrl->num_entries * PRIO_BENCH_FILL_PCT / 100;
+
+    start = sal_time_usecs();
+    for (idx = 0; idx < inserts; idx++, op++) {
+        SHR_IF_ERR_EXIT
+            (prio_bench_insert(ctrl, indexed, op,
+                               prio_bench_rand(ctrl) % PRIO_BENCH_PRI_RANGE,
+                               &target, &bench->moves));
+        prio_bench_check(ctrl, indexed, op, target, bench);
+    }
+    bench->insert_usecs = sal_time_usecs() - start;
+    bench->entries = ctrl->num_entries;
+    bench->inserts = inserts;
+
+    start = sal_time_usecs();
+    for (idx = 0; idx < churns && inserts > 0; idx++, op++) {
+        prio_bench_delete(ctrl);
+        SHR_IF_ERR_EXIT
+            (prio_bench_insert(ctrl, indexed, op,
+                               prio_bench_rand(ctrl) % PRIO_BENCH_PRI_RANGE,
+                               &target, &bench->moves));
+        prio_bench_check(ctrl, indexed, op, target, bench);
+    }
+    bench->churn_usecs = sal_time_usecs() - start;
+    bench->churns = churns;
+
+    /* Target slot lookups only, on the churned TCAM. */
+    start = sal_time_usecs();
+    for (idx = 0; idx < churns && inserts > 0; idx++, op++) {
+        SHR_IF_ERR_EXIT
+            (prio_bench_target_get(ctrl, indexed,
+                                   prio_bench_rand(ctrl) %
+                                   PRIO_BENCH_PRI_RANGE,
+                                   &target, &from_idx, &to_idx));
+        prio_bench_check(ctrl, indexed, op, target, bench);
+    }
+    bench->lookup_usecs = sal_time_usecs() - start;
+    bench->lookups = churns;
+
+exit:
+    bcmptm_rm_tcam_prio_index_destroy(ctrl->unit, ctrl->entry_info);
+    SHR_FUNC_EXIT();
+}
+
+/*******************************************************************************
+ * Public Functions
+ */
+int
+bcmptm_rm_tcam_prio_bench(int unit,
+                          uint32_t num_entries,
+                          uint32_t churns,
+                          uint32_t seed,
+                          bcmptm_rm_tcam_prio_bench_t *scan,
+                          bcmptm_rm_tcam_prio_bench_t *indexed)
+{
+    prio_bench_ctrl_t ctrl;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_NULL_CHECK(scan, SHR_E_PARAM);
+    SHR_NULL_CHECK(indexed, SHR_E_PARAM);
+    if (unit < 0 || unit >= BCMDRD_CONFIG_MAX_UNITS || num_entries == 0) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+
+    sal_memset(&ctrl, 0, sizeof(ctrl));
+    ctrl.unit = unit;
+    ctrl.num_entries = num_entries;
+
+    SHR_ALLOC(ctrl.entry_info,
+              sizeof(bcmptm_rm_tcam_prio_entry_info_t) * num_entries,
+              "bcmptmRmtcamBenchEntryInfo");
+    SHR_NULL_CHECK(ctrl.entry_info, SHR_E_MEMORY);
+    SHR_ALLOC(ctrl.targets, sizeof(int) * (num_entries + 2 * churns),
+              "bcmptmRmtcamBenchTarget");
+    SHR_NULL_CHECK(ctrl.targets, SHR_E_MEMORY);
+
+    SHR_IF_ERR_EXIT
+        (prio_bench_run(&ctrl, FALSE, seed, churns, scan));
+    SHR_IF_ERR_EXIT
+        (prio_bench_run(&ctrl, TRUE, seed, churns, indexed));
+
+exit:
+    SHR_FREE(ctrl.entry_info);
+    SHR_FREE(ctrl.targets);
+    SHR_FUNC_EXIT();
+}
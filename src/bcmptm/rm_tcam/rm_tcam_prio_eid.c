@@ -105,6 +105,7 @@
 #include "rm_tcam.h"
 #include "rm_tcam_prio_atomicity.h"
 #include "rm_tcam_prio_eid.h"
+#include "rm_tcam_prio_index.h"
 #include "rm_tcam_traverse.h"
 #include <bcmptm/bcmptm_cmdproc_internal.h>
 #include <bcmltd/chip/bcmltd_id.h>
@@ -918,6 +919,8 @@ bcmptm_rm_tcam_prio_entry_move(int unit,
     entry_info[from_idx].entry_pri = BCMPTM_RM_TCAM_PRIO_INVALID;
     entry_info[from_idx].offset = BCMPTM_RM_TCAM_OFFSET_INVALID;
     entry_info[from_idx].global_to_all_pipes = 0;
+    bcmptm_rm_tcam_prio_index_sync(unit, entry_info, to_idx);
+    bcmptm_rm_tcam_prio_index_sync(unit, entry_info, from_idx);
 
     if (LOG_CHECK_DEBUG(BSL_LOG_MODULE)) {
         SHR_IF_ERR_VERBOSE_EXIT(rm_tcam_prio_find_loops(unit, ltid, ltid_info,
@@ -1024,6 +1027,7 @@ bcmptm_rm_tcam_prio_entry_write(int unit, bcmltd_sid_t ltid,
     } else {
         entry_info[index].global_to_all_pipes = 0;
     }
+    bcmptm_rm_tcam_prio_index_sync(unit, entry_info, index);
 
     /* 2. Update the TCAM SW hash table. */
     SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_prio_entry_hash_size_get(
@@ -1281,6 +1285,7 @@ bcmptm_rm_tcam_prio_entry_clear(int unit,
     entry_info[index].entry_pri = BCMPTM_RM_TCAM_PRIO_INVALID;
     entry_info[index].offset = BCMPTM_RM_TCAM_OFFSET_INVALID;
     entry_info[index].global_to_all_pipes = FALSE;
+    bcmptm_rm_tcam_prio_index_sync(unit, entry_info, index);
 
     if (LOG_CHECK_DEBUG(BSL_LOG_MODULE)) {
         SHR_IF_ERR_VERBOSE_EXIT(rm_tcam_prio_find_loops(unit, ltid, ltid_info,
@@ -1452,20 +1457,18 @@ exit:
     SHR_FUNC_EXIT();
 }
 
-/* Create a new free slot to insert an entry. */
-
+/*
+ * Find the slot for a new entry of the given priority by a linear scan
+ * of the TCAM entry information.
+ */
 int
-bcmptm_rm_tcam_prio_entry_index_allocate(int unit,
-                                 uint32_t req_flags,
-                                 bcmltd_sid_t ltid,
-                                 bcmptm_rm_tcam_lt_info_t *ltid_info,
-                                 uint8_t prio_change,
-                                 bcmbd_pt_dyn_info_t *pt_dyn_info,
-                                 bcmptm_rm_tcam_req_t *req_info,
-                                 bcmptm_rm_tcam_rsp_t *rsp_info,
-                                 bcmltd_sid_t *rsp_ltid,
-                                 uint32_t *rsp_flags,
-                                 uint16_t *target_index)
+bcmptm_rm_tcam_prio_slot_scan(int unit,
+                              bcmptm_rm_tcam_prio_entry_info_t *entry_info,
+                              uint32_t num_entries,
+                              int entry_pri,
+                              int *target_index,
+                              int *from_index,
+                              int *to_index)
 {
     int target_idx = -1;
     uint32_t idx = -1;
@@ -1474,70 +1477,10 @@ bcmptm_rm_tcam_prio_entry_index_allocate(int unit,
     int down_free_idx = -1;
     int from_idx = -1;
     int to_idx = -1;
-    bcmptm_rm_tcam_prio_entry_info_t *entry_info = NULL;
-    uint32_t free_entries = 0;
-    uint32_t num_entries = 0;
-    uint8_t mode = 0;
-    int num_parts = -1;
-    bcmptm_rm_tcam_entry_attrs_t *entry_attrs = NULL;
 
     /* Log the  function entry. */
     SHR_FUNC_ENTER(unit);
 
-    /* Input parameter check. */
-    SHR_NULL_CHECK(ltid_info, SHR_E_PARAM);
-
-    if (ltid_info->pt_type == LT_PT_TYPE_FP) {
-        entry_attrs = (bcmptm_rm_tcam_entry_attrs_t *)req_info->entry_attrs;
-        mode = entry_attrs->group_mode;
-    } else {
-        mode = BCMPTM_RM_TCAM_GRP_MODE_SINGLE;
-    }
-
-    num_parts = ltid_info->hw_entry_info[mode].num_key_rows;
-
-    /* Fetch the TCAM information for the given ltid. */
-    SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_prio_entry_free_count_get(unit, ltid,
-                                            ltid_info,
-                                            req_info->entry_attrs,
-                                            &free_entries));
-
-    SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_prio_entry_valid_count_get(unit, ltid,
-                                            ltid_info,
-                                            req_info->entry_attrs,
-                                            &num_entries));
-
-    /*
-     * If free entries are not available, entry cannot be inserted.
-     * If HW atomicity is supported then full range can be used.
-     * For entries which require more than one key row atomicity
-     * can't be achieved even if HW supports.
-     */
-    if ((prio_change == 0) &&
-        ((ltid_info->rm_more_info->hw_atomicity_support == 0) ||
-         (num_parts > 1) || ltid_info->non_aggr) && (free_entries == 1)) {
-        SHR_IF_ERR_VERBOSE_EXIT(SHR_E_FULL);
-    }
-
-    if (free_entries == 0) {
-        SHR_IF_ERR_VERBOSE_EXIT(SHR_E_FULL);
-    }
-
-    /* If no valid entries allocate the very first entry in TCAM. */
-    if (free_entries == num_entries) {
-        *target_index = 0;
-        SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_prio_entry_free_count_decr(unit,
-                                                     ltid, ltid_info,
-                                                     0,
-                                                     req_info->entry_attrs));
-        SHR_FUNC_EXIT();
-    }
-
-    SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_prio_entry_info_get(unit,
-                                                       ltid, ltid_info,
-                                                       req_info->entry_attrs,
-                                                       &entry_info));
-
     for (idx = 0; idx < num_entries; idx++) {
 
         /* Record the last free tcam index before target index is found. */
@@ -1554,7 +1497,7 @@ bcmptm_rm_tcam_prio_entry_index_allocate(int unit,
 
         /* Record the target index for the given prioirty. */
         if (target_idx == BCMPTM_RM_TCAM_INDEX_INVALID) {
-            if (entry_info[idx].entry_pri < req_info->entry_pri) {
+            if (entry_info[idx].entry_pri < entry_pri) {
                 target_idx = idx;
                 /* If free entries block is just above the target index
                  * up_free_block_first_idx is the target index
@@ -1566,7 +1509,7 @@ bcmptm_rm_tcam_prio_entry_index_allocate(int unit,
             } else if (up_free_block_first_idx != -1) {
                 /* Free entries block is just before entry with same prio.
                  * use up_free_block_first_idx as the target index*/
-                if (entry_info[idx].entry_pri == req_info->entry_pri) {
+                if (entry_info[idx].entry_pri == entry_pri) {
                     break;
                 }
                 up_free_block_first_idx = -1;
@@ -1603,7 +1546,7 @@ bcmptm_rm_tcam_prio_entry_index_allocate(int unit,
          * target entry.
          */
         else if (target_idx == BCMPTM_RM_TCAM_INDEX_INVALID) {
-            target_idx =  num_entries - 1;
+            target_idx = num_entries - 1;
         } else {
             target_idx--;
         }
@@ -1641,6 +1584,119 @@ bcmptm_rm_tcam_prio_entry_index_allocate(int unit,
         }
     }
 
+    *target_index = target_idx;
+    *from_index = from_idx;
+    *to_index = to_idx;
+
+exit:
+    /* Log the function exit. */
+    SHR_FUNC_EXIT();
+}
+
+/* Create a new free slot to insert an entry. */
+
+int
+bcmptm_rm_tcam_prio_entry_index_allocate(int unit,
+                                 uint32_t req_flags,
+                                 bcmltd_sid_t ltid,
+                                 bcmptm_rm_tcam_lt_info_t *ltid_info,
+                                 uint8_t prio_change,
+                                 bcmbd_pt_dyn_info_t *pt_dyn_info,
+                                 bcmptm_rm_tcam_req_t *req_info,
+                                 bcmptm_rm_tcam_rsp_t *rsp_info,
+                                 bcmltd_sid_t *rsp_ltid,
+                                 uint32_t *rsp_flags,
+                                 uint16_t *target_index)
+{
+    int rv;
+    int target_idx = -1;
+    int from_idx = -1;
+    int to_idx = -1;
+    bcmptm_rm_tcam_prio_entry_info_t *entry_info = NULL;
+    bcmptm_rm_tcam_prio_index_t *prio_index = NULL;
+    uint32_t free_entries = 0;
+    uint32_t num_entries = 0;
+    uint8_t mode = 0;
+    int num_parts = -1;
+    bcmptm_rm_tcam_entry_attrs_t *entry_attrs = NULL;
+
+    /* Log the  function entry. */
+    SHR_FUNC_ENTER(unit);
+
+    /* Input parameter check. */
+    SHR_NULL_CHECK(ltid_info, SHR_E_PARAM);
+
+    if (ltid_info->pt_type == LT_PT_TYPE_FP) {
+        entry_attrs = (bcmptm_rm_tcam_entry_attrs_t *)req_info->entry_attrs;
+        mode = entry_attrs->group_mode;
+    } else {
+        mode = BCMPTM_RM_TCAM_GRP_MODE_SINGLE;
+    }
+
+    num_parts = ltid_info->hw_entry_info[mode].num_key_rows;
+
+    /* Fetch the TCAM information for the given ltid. */
+    SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_prio_entry_free_count_get(unit, ltid,
+                                            ltid_info,
+                                            req_info->entry_attrs,
+                                            &free_entries));
+
+    SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_prio_entry_valid_count_get(unit, ltid,
+                                            ltid_info,
+                                            req_info->entry_attrs,
+                                            &num_entries));
+
+    /*
+     * If free entries are not available, entry cannot be inserted.
+     * If HW atomicity is supported then full range can be used.
+     * For entries which require more than one key row atomicity
+     * can't be achieved even if HW supports.
+     */
+    if ((prio_change == 0) &&
+        ((ltid_info->rm_more_info->hw_atomicity_support == 0) ||
+         (num_parts > 1) || ltid_info->non_aggr) && (free_entries == 1)) {
+        SHR_IF_ERR_VERBOSE_EXIT(SHR_E_FULL);
+    }
+
+    if (free_entries == 0) {
+        SHR_IF_ERR_VERBOSE_EXIT(SHR_E_FULL);
+    }
+
+    /* If no valid entries allocate the very first entry in TCAM. */
+    if (free_entries == num_entries) {
+        *target_index = 0;
+        SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_prio_entry_free_count_decr(unit,
+                                                     ltid, ltid_info,
+                                                     0,
+                                                     req_info->entry_attrs));
+        SHR_FUNC_EXIT();
+    }
+
+    SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_prio_entry_info_get(unit,
+                                                       ltid, ltid_info,
+                                                       req_info->entry_attrs,
+                                                       &entry_info));
+
+    /*
+     * Find the target slot through the priority index. Fall back to a
+     * linear scan if the index cannot be allocated.
+     */
+    rv = bcmptm_rm_tcam_prio_index_get(unit, BCMPTM_RM_TCAM_PRIO_INDEX_EID,
+                                       entry_info, num_entries,
+                                       free_entries, &prio_index);
+    if (SHR_SUCCESS(rv)) {
+        SHR_IF_ERR_EXIT(
+            bcmptm_rm_tcam_prio_index_target_get(unit, prio_index,
+                                                 req_info->entry_pri,
+                                                 &target_idx, &from_idx,
+                                                 &to_idx));
+    } else {
+        SHR_IF_ERR_EXIT(
+            bcmptm_rm_tcam_prio_slot_scan(unit, entry_info, num_entries,
+                                          req_info->entry_pri,
+                                          &target_idx, &from_idx, &to_idx));
+    }
+
     /* Move entries either up or down ward direction. */
     SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_entry_move_range(unit,
                                                     ltid, ltid_info,
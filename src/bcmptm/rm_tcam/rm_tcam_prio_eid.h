@@ -399,6 +399,29 @@ bcmptm_rm_tcam_prio_entry_info_get(int unit, bcmltd_sid_t ltid,
                                    bcmptm_rm_tcam_lt_info_t *ltid_info,
                                    void *entry_attrs,
                                    bcmptm_rm_tcam_prio_entry_info_t **entry_info);
+/*!
+ * \brief Find the slot for a new entry of the given priority by
+ * \n scanning the TCAM entry information linearly.
+ *
+ * \param [in] unit Logical device id
+ * \param [in] entry_info Start address of the TCAM entry information.
+ * \param [in] num_entries Number of TCAM entries.
+ * \param [in] entry_pri Priority of the new entry.
+ * \param [out] target_index TCAM index for the new entry.
+ * \param [out] from_index First TCAM index to be shifted.
+ * \param [out] to_index Free TCAM index the shift ends at.
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_INTERNAL No free slot found
+ */
+extern int
+bcmptm_rm_tcam_prio_slot_scan(int unit,
+                              bcmptm_rm_tcam_prio_entry_info_t *entry_info,
+                              uint32_t num_entries,
+                              int entry_pri,
+                              int *target_index,
+                              int *from_index,
+                              int *to_index);
 /*!
  * \brief Find the index for the new TCAM entry info
  * \n priority based TCAMs.
@@ -0,0 +1,602 @@
+/*! \file rm_tcam_prio_index.c
+ *
+ * Priority index for RM-TCAM target slot allocation.
+ *
+ * Priority based TCAMs keep valid entries in descending priority order, and
+ * a new entry is placed by finding the priority boundary and the nearest
+ * free slots around it. This file keeps, for every TCAM entry information
+ * array in use, a segment tree holding the free entry count and the lowest
+ * valid priority of each index range, so that these searches take
+ * O(log N) instead of a scan of the whole array.
+ *
+ * The index lives in regular (non-HA) memory and is rebuilt from the TCAM
+ * entry information on demand, e.g. after warm boot or transaction abort.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+/*******************************************************************************
+ * Includes
+ */
+#include <bsl/bsl.h>
+#include <sal/sal_types.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <shr/shr_error.h>
+#include <shr/shr_debug.h>
+#include "rm_tcam.h"
+#include "rm_tcam_prio_eid.h"
+#include "rm_tcam_prio_only.h"
+#include "rm_tcam_prio_index.h"
+
+/*******************************************************************************
+ * Defines
+ */
+#define BSL_LOG_MODULE BSL_LS_BCMPTM_RMTCAM
+
+/*! Number of hash buckets used to find the index of an entry info array. */
+#define RM_TCAM_PRIO_INDEX_HASH_SIZE 64
+
+/*! Hash bucket of an entry info array. */
+#define RM_TCAM_PRIO_INDEX_HASH(_ei) \
+    ((((uintptr_t)(_ei)) >> 4) % RM_TCAM_PRIO_INDEX_HASH_SIZE)
+
+/*! Lowest valid priority of a range without valid entries. */
+#define RM_TCAM_PRIO_INDEX_PRI_NONE 0x7fffffff
+
+/*******************************************************************************
+ * Typedefs
+ */
+struct bcmptm_rm_tcam_prio_index_s {
+
+    /*! Next index in the same hash bucket. */
+    struct bcmptm_rm_tcam_prio_index_s *next;
+
+    /*! Layout of the entry information array. */
+    bcmptm_rm_tcam_prio_index_type_t type;
+
+    /*! Start address of the entry information array. */
+    void *entry_info;
+
+    /*! Number of TCAM entries covered. */
+    uint32_t num_entries;
+
+    /*! Number of leaves, power of two not less than num_entries. */
+    uint32_t size;
+
+    /*! Number of valid TCAM rows that belong to multi-row entries. */
+    uint32_t multi_rows;
+
+    /*!
+     * Free entry count of each node. Leaves beyond num_entries count as
+     * free, but searches never return them.
+     */
+    uint32_t *free_cnt;
+
+    /*! Lowest priority of the valid entries of each node. */
+    int *min_pri;
+
+    /*! Per entry flag to mark valid rows of multi-row entries. */
+    uint8_t *multi;
+};
+
+/*******************************************************************************
+ * Private variables
+ */
+static bcmptm_rm_tcam_prio_index_t *
+prio_index_hash[BCMDRD_CONFIG_MAX_UNITS][RM_TCAM_PRIO_INDEX_HASH_SIZE];
+
+/*******************************************************************************
+ * Private Functions
+ */
+/*
+ * Read the state of one TCAM entry from the entry information array.
+ * The free checks match the ones used by the linear slot scans.
+ */
+static void
+rm_tcam_prio_index_entry_get(bcmptm_rm_tcam_prio_index_t *index,
+                             uint32_t idx,
+                             bool *free,
+                             int *pri,
+                             uint8_t *rows)
+{
+    bcmptm_rm_tcam_prio_entry_info_t *eid_info = NULL;
+    bcmptm_rm_tcam_prio_only_entry_info_t *only_info = NULL;
+
+    if (index->type == BCMPTM_RM_TCAM_PRIO_INDEX_EID) {
+        eid_info = (bcmptm_rm_tcam_prio_entry_info_t *)index->entry_info;
+        *free = (eid_info[idx].entry_id == BCMPTM_RM_TCAM_EID_INVALID);
+        *pri = eid_info[idx].entry_pri;
+        *rows = 1;
+    } else {
+        only_info = (bcmptm_rm_tcam_prio_only_entry_info_t *)index->entry_info;
+        *free = (only_info[idx].entry_pri == BCMPTM_RM_TCAM_EID_INVALID);
+        *pri = only_info[idx].entry_pri;
+        *rows = only_info[idx].entry_type;
+    }
+}
+
+/*
+ * Recompute the internal node n from its children.
+ * Return TRUE if the node has changed.
+ */
+static inline bool
+rm_tcam_prio_index_node_update(bcmptm_rm_tcam_prio_index_t *index, uint32_t n)
+{
+    uint32_t l = 2 * n, r = 2 * n + 1;
+    uint32_t free_cnt;
+    int min_pri;
+
+    free_cnt = index->free_cnt[l] + index->free_cnt[r];
+    min_pri = (index->min_pri[l] < index->min_pri[r]) ?
+              index->min_pri[l] : index->min_pri[r];
+    if (index->free_cnt[n] == free_cnt && index->min_pri[n] == min_pri) {
+        return FALSE;
+    }
+    index->free_cnt[n] = free_cnt;
+    index->min_pri[n] = min_pri;
+    return TRUE;
+}
+
+/*
+ * Load the leaf of TCAM index idx from the entry information array.
+ */
+static void
+rm_tcam_prio_index_leaf_load(bcmptm_rm_tcam_prio_index_t *index, uint32_t idx)
+{
+    bool free;
+    int pri;
+    uint8_t rows;
+    uint8_t multi;
+    uint32_t n = index->size + idx;
+
+    rm_tcam_prio_index_entry_get(index, idx, &free, &pri, &rows);
+    multi = (!free && rows > 1) ? 1 : 0;
+    index->multi_rows += multi;
+    index->multi_rows -= index->multi[idx];
+    index->multi[idx] = multi;
+    index->free_cnt[n] = free ? 1 : 0;
+    index->min_pri[n] = free ? RM_TCAM_PRIO_INDEX_PRI_NONE : pri;
+}
+
+/*
+ * Build the whole index from the entry information array.
+ */
+static void
+rm_tcam_prio_index_build(bcmptm_rm_tcam_prio_index_t *index)
+{
+    uint32_t idx;
+
+    index->multi_rows = 0;
+    sal_memset(index->multi, 0, index->num_entries);
+    for (idx = 0; idx < index->num_entries; idx++) {
+        rm_tcam_prio_index_leaf_load(index, idx);
+    }
+    for (idx = index->size + index->num_entries;
+         idx < 2 * index->size; idx++) {
+        index->free_cnt[idx] = 1;
+        index->min_pri[idx] = RM_TCAM_PRIO_INDEX_PRI_NONE;
+    }
+    for (idx = index->size - 1; idx > 0; idx--) {
+        rm_tcam_prio_index_node_update(index, idx);
+    }
+}
+
+/*
+ * Number of free (want_free) or valid entries below node n of width len.
+ */
+static inline uint32_t
+rm_tcam_prio_index_count(bcmptm_rm_tcam_prio_index_t *index,
+                         uint32_t n, uint32_t len, bool want_free)
+{
+    return want_free ? index->free_cnt[n] : (len - index->free_cnt[n]);
+}
+
+/*
+ * Find the first free (want_free) or valid TCAM index at or after idx.
+ * Returns BCMPTM_RM_TCAM_INDEX_INVALID if there is none.
+ */
+static int
+rm_tcam_prio_index_next(bcmptm_rm_tcam_prio_index_t *index,
+                        uint32_t idx, bool want_free)
+{
+    uint32_t n, len = 1;
+
+    if (idx >= index->num_entries) {
+        return BCMPTM_RM_TCAM_INDEX_INVALID;
+    }
+    n = index->size + idx;
+    if (rm_tcam_prio_index_count(index, n, len, want_free)) {
+        return idx;
+    }
+    /* Climb until a right sibling holds a match. */
+    while (n > 1) {
+        if (((n & 1) == 0) &&
+            rm_tcam_prio_index_count(index, n + 1, len, want_free)) {
+            n++;
+            break;
+        }
+        n >>= 1;
+        len <<= 1;
+    }
+    if (n == 1) {
+        return BCMPTM_RM_TCAM_INDEX_INVALID;
+    }
+    /* Descend to the leftmost match. */
+    while (n < index->size) {
+        len >>= 1;
+        n = rm_tcam_prio_index_count(index, 2 * n, len, want_free) ?
+            (2 * n) : (2 * n + 1);
+    }
+    idx = n - index->size;
+    return (idx < index->num_entries) ? (int)idx : BCMPTM_RM_TCAM_INDEX_INVALID;
+}
+
+/*
+ * Find the last free (want_free) or valid TCAM index before idx.
+ * Returns BCMPTM_RM_TCAM_INDEX_INVALID if there is none.
+ */
+static int
+rm_tcam_prio_index_prev(bcmptm_rm_tcam_prio_index_t *index,
+                        uint32_t idx, bool want_free)
+{
+    uint32_t n, len = 1;
+
+    if (idx == 0) {
+        return BCMPTM_RM_TCAM_INDEX_INVALID;
+    }
+    if (idx > index->num_entries) {
+        idx = index->num_entries;
+    }
+    n = index->size + idx - 1;
+    if (rm_tcam_prio_index_count(index, n, len, want_free)) {
+        return idx - 1;
+    }
+    /* Climb until a left sibling holds a match. */
+    while (n > 1) {
+        if ((n & 1) &&
+            rm_tcam_prio_index_count(index, n - 1, len, want_free)) {
+            n--;
+            break;
+        }
+        n >>= 1;
+        len <<= 1;
+    }
+    if (n == 1) {
+        return BCMPTM_RM_TCAM_INDEX_INVALID;
+    }
+    /* Descend to the rightmost match. */
+    while (n < index->size) {
+        len >>= 1;
+        n = rm_tcam_prio_index_count(index, 2 * n + 1, len, want_free) ?
+            (2 * n + 1) : (2 * n);
+    }
+    return n - index->size;
+}
+
+/*
+ * Find the first valid TCAM index whose priority is lower than entry_pri,
+ * or also equal to it if or_equal is set.
+ * Returns BCMPTM_RM_TCAM_INDEX_INVALID if there is none.
+ */
+static int
+rm_tcam_prio_index_first_lower(bcmptm_rm_tcam_prio_index_t *index,
+                               int entry_pri, bool or_equal)
+{
+    uint32_t n = 1;
+
+    if (or_equal) {
+        if (entry_pri == RM_TCAM_PRIO_INDEX_PRI_NONE) {
+            /* Every valid entry qualifies. */
+            return rm_tcam_prio_index_next(index, 0, FALSE);
+        }
+        entry_pri++;
+    }
+    if (index->min_pri[1] >= entry_pri) {
+        return BCMPTM_RM_TCAM_INDEX_INVALID;
+    }
+    while (n < index->size) {
+        n = (index->min_pri[2 * n] < entry_pri) ? (2 * n) : (2 * n + 1);
+    }
+    return n - index->size;
+}
+
+/*
+ * Find the index of the given entry info array.
+ */
+static bcmptm_rm_tcam_prio_index_t *
+rm_tcam_prio_index_find(int unit, void *entry_info)
+{
+    bcmptm_rm_tcam_prio_index_t *index;
+
+    index = prio_index_hash[unit][RM_TCAM_PRIO_INDEX_HASH(entry_info)];
+    while (index != NULL && index->entry_info != entry_info) {
+        index = index->next;
+    }
+    return index;
+}
+
+/*******************************************************************************
+ * Public Functions
+ */
+int
+bcmptm_rm_tcam_prio_index_get(int unit,
+                              bcmptm_rm_tcam_prio_index_type_t type,
+                              void *entry_info,
+                              uint32_t num_entries,
+                              uint32_t free_entries,
+                              bcmptm_rm_tcam_prio_index_t **index)
+{
+    bcmptm_rm_tcam_prio_index_t *pidx = NULL;
+    uint32_t size = 1, bucket;
+    size_t alloc_size;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_NULL_CHECK(entry_info, SHR_E_PARAM);
+    SHR_NULL_CHECK(index, SHR_E_PARAM);
+    if (num_entries == 0) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+
+    pidx = rm_tcam_prio_index_find(unit, entry_info);
+    if (pidx != NULL && pidx->type == type &&
+        pidx->num_entries == num_entries) {
+        if (pidx->free_cnt[1] - (pidx->size - num_entries) != free_entries) {
+            /* Out of step with the SW state, reload it. */
+            rm_tcam_prio_index_build(pidx);
+        }
+        *index = pidx;
+        SHR_EXIT();
+    }
+    if (pidx != NULL) {
+        bcmptm_rm_tcam_prio_index_destroy(unit, entry_info);
+        pidx = NULL;
+    }
+
+    while (size < num_entries) {
+        size <<= 1;
+    }
+    alloc_size = sizeof(*pidx) +
+                 2 * size * (sizeof(uint32_t) + sizeof(int)) +
+                 num_entries;
+    pidx = sal_alloc(alloc_size, "bcmptmRmTcamPrioIndex");
+    SHR_NULL_CHECK(pidx, SHR_E_MEMORY);
+    sal_memset(pidx, 0, sizeof(*pidx));
+    pidx->type = type;
+    pidx->entry_info = entry_info;
+    pidx->num_entries = num_entries;
+    pidx->size = size;
+    pidx->free_cnt = (uint32_t *)(pidx + 1);
+    pidx->min_pri = (int *)(pidx->free_cnt + 2 * size);
+    pidx->multi = (uint8_t *)(pidx->min_pri + 2 * size);
+    rm_tcam_prio_index_build(pidx);
+
+    bucket = RM_TCAM_PRIO_INDEX_HASH(entry_info);
+    pidx->next = prio_index_hash[unit][bucket];
+    prio_index_hash[unit][bucket] = pidx;
+    *index = pidx;
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+void
+bcmptm_rm_tcam_prio_index_sync(int unit, void *entry_info, uint32_t idx)
+{
+    bcmptm_rm_tcam_prio_index_t *index;
+    uint32_t n;
+
+    index = rm_tcam_prio_index_find(unit, entry_info);
+    if (index == NULL || idx >= index->num_entries) {
+        return;
+    }
+    rm_tcam_prio_index_leaf_load(index, idx);
+    /* Ancestors above an unchanged node are up to date. */
+    for (n = (index->size + idx) >> 1; n > 0; n >>= 1) {
+        if (!rm_tcam_prio_index_node_update(index, n)) {
+            break;
+        }
+    }
+}
+
+int
+bcmptm_rm_tcam_prio_index_target_get(int unit,
+                                     bcmptm_rm_tcam_prio_index_t *index,
+                                     int entry_pri,
+                                     int *target_idx,
+                                     int *from_idx,
+                                     int *to_idx)
+{
+    int num_entries;
+    int lower_eq_idx, lower_idx, higher_idx;
+    int up_free_idx, down_free_idx;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_NULL_CHECK(index, SHR_E_PARAM);
+    num_entries = index->num_entries;
+
+    /* First entry with lower priority, the target of the linear scan. */
+    lower_idx = rm_tcam_prio_index_first_lower(index, entry_pri, FALSE);
+    /* Last entry with higher priority, just before the first lower or equal. */
+    lower_eq_idx = rm_tcam_prio_index_first_lower(index, entry_pri, TRUE);
+    higher_idx = rm_tcam_prio_index_prev(index,
+                     (lower_eq_idx == BCMPTM_RM_TCAM_INDEX_INVALID) ?
+                     (uint32_t)num_entries : (uint32_t)lower_eq_idx,
+                     FALSE);
+    /*
+     * A free block after the last higher priority entry and before the
+     * first lower priority entry takes the new entry without any move.
+     */
+    down_free_idx = rm_tcam_prio_index_next(index, higher_idx + 1, TRUE);
+    if (down_free_idx != BCMPTM_RM_TCAM_INDEX_INVALID &&
+        (lower_idx == BCMPTM_RM_TCAM_INDEX_INVALID ||
+         down_free_idx < lower_idx)) {
+        *target_idx = down_free_idx;
+        *from_idx = down_free_idx;
+        *to_idx = down_free_idx;
+        SHR_EXIT();
+    }
+
+    up_free_idx = rm_tcam_prio_index_prev(index,
+                      (lower_idx == BCMPTM_RM_TCAM_INDEX_INVALID) ?
+                      (uint32_t)num_entries : (uint32_t)lower_idx,
+                      TRUE);
+
+    /* All existing valid entries have greater priority than target entry. */
+    if (lower_idx == BCMPTM_RM_TCAM_INDEX_INVALID) {
+        if (up_free_idx == BCMPTM_RM_TCAM_INDEX_INVALID) {
+            SHR_RETURN_VAL_EXIT(SHR_E_INTERNAL);
+        }
+        *target_idx = num_entries - 1;
+        *from_idx = num_entries - 1;
+        *to_idx = up_free_idx;
+        SHR_EXIT();
+    }
+
+    if (up_free_idx == BCMPTM_RM_TCAM_INDEX_INVALID &&
+        down_free_idx == BCMPTM_RM_TCAM_INDEX_INVALID) {
+        SHR_RETURN_VAL_EXIT(SHR_E_INTERNAL);
+    }
+
+    if (up_free_idx == BCMPTM_RM_TCAM_INDEX_INVALID ||
+        (down_free_idx != BCMPTM_RM_TCAM_INDEX_INVALID &&
+         (lower_idx - up_free_idx) >= (down_free_idx - lower_idx))) {
+        /* Move entries down ward direction. */
+        *target_idx = lower_idx;
+        *from_idx = lower_idx;
+        *to_idx = down_free_idx;
+    } else {
+        /* Move entries up ward direction. */
+        *target_idx = lower_idx - 1;
+        *from_idx = lower_idx - 1;
+        *to_idx = up_free_idx;
+    }
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+bool
+bcmptm_rm_tcam_prio_index_single_row(bcmptm_rm_tcam_prio_index_t *index)
+{
+    return (index->multi_rows == 0);
+}
+
+void
+bcmptm_rm_tcam_prio_index_destroy(int unit, void *entry_info)
+{
+    bcmptm_rm_tcam_prio_index_t **pp;
+    bcmptm_rm_tcam_prio_index_t *index;
+
+    pp = &prio_index_hash[unit][RM_TCAM_PRIO_INDEX_HASH(entry_info)];
+    while (*pp != NULL) {
+        index = *pp;
+        if (index->entry_info == entry_info) {
+            *pp = index->next;
+            sal_free(index);
+            return;
+        }
+        pp = &index->next;
+    }
+}
+
+void
+bcmptm_rm_tcam_prio_index_destroy_all(int unit)
+{
+    uint32_t bucket;
+    bcmptm_rm_tcam_prio_index_t *index;
+
+    for (bucket = 0; bucket < RM_TCAM_PRIO_INDEX_HASH_SIZE; bucket++) {
+        while ((index = prio_index_hash[unit][bucket]) != NULL) {
+            prio_index_hash[unit][bucket] = index->next;
+            sal_free(index);
+        }
+    }
+}
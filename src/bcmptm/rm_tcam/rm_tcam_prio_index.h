@@ -0,0 +1,214 @@
+/*! \file rm_tcam_prio_index.h
+ *
+ * Priority index for RM-TCAM target slot allocation.
+ * This file contains defines and APIs of the per-TCAM priority index.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#ifndef RM_TCAM_PRIO_INDEX_H
+#define RM_TCAM_PRIO_INDEX_H
+
+/*******************************************************************************
+ * Includes
+ */
+#include <sal/sal_types.h>
+
+/*******************************************************************************
+ * Typedefs
+ */
+/*! Layout of the TCAM entry information covered by a priority index. */
+typedef enum bcmptm_rm_tcam_prio_index_type_e {
+
+    /*! Array of bcmptm_rm_tcam_prio_entry_info_t. */
+    BCMPTM_RM_TCAM_PRIO_INDEX_EID = 0,
+
+    /*! Array of bcmptm_rm_tcam_prio_only_entry_info_t. */
+    BCMPTM_RM_TCAM_PRIO_INDEX_ONLY,
+
+} bcmptm_rm_tcam_prio_index_type_t;
+
+/*! Priority index of one TCAM entry information array. */
+typedef struct bcmptm_rm_tcam_prio_index_s bcmptm_rm_tcam_prio_index_t;
+
+/*******************************************************************************
+ * Function declarations (prototypes)
+ */
+/*!
+ * \brief Get the priority index of a TCAM entry information array.
+ * \n The index is created and built from the entry information on first
+ * \n use. It is rebuilt if the number of entries changed, or if its free
+ * \n entry count disagrees with free_entries.
+ *
+ * \param [in] unit Logical device id
+ * \param [in] type Layout of the entry information array.
+ * \param [in] entry_info Start address of the TCAM entry information.
+ * \param [in] num_entries Number of TCAM entries.
+ * \param [in] free_entries Number of free TCAM entries.
+ * \param [out] index Priority index.
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_PARAM Invalid parameters
+ * \retval SHR_E_MEMORY Index could not be allocated
+ */
+extern int
+bcmptm_rm_tcam_prio_index_get(int unit,
+                              bcmptm_rm_tcam_prio_index_type_t type,
+                              void *entry_info,
+                              uint32_t num_entries,
+                              uint32_t free_entries,
+                              bcmptm_rm_tcam_prio_index_t **index);
+
+/*!
+ * \brief Update the priority index after the TCAM entry information at
+ * \n idx has changed. Nothing is done if entry_info is not indexed.
+ *
+ * \param [in] unit Logical device id
+ * \param [in] entry_info Start address of the TCAM entry information.
+ * \param [in] idx TCAM index that has changed.
+ */
+extern void
+bcmptm_rm_tcam_prio_index_sync(int unit, void *entry_info, uint32_t idx);
+
+/*!
+ * \brief Find the slot for a new entry of the given priority.
+ * \n Gives the same result as the linear scan of
+ * \n bcmptm_rm_tcam_prio_slot_scan, relying on valid entries being in
+ * \n descending priority order. Entries in [from_idx, to_idx) or
+ * \n (to_idx, from_idx] must be shifted by one toward to_idx before the
+ * \n new entry is written at target_idx.
+ *
+ * \param [in] unit Logical device id
+ * \param [in] index Priority index.
+ * \param [in] entry_pri Priority of the new entry.
+ * \param [out] target_idx TCAM index for the new entry.
+ * \param [out] from_idx First TCAM index to be shifted.
+ * \param [out] to_idx Free TCAM index the shift ends at.
+ *
+ * \retval SHR_E_NONE Success
+ * \retval SHR_E_INTERNAL No free slot found
+ */
+extern int
+bcmptm_rm_tcam_prio_index_target_get(int unit,
+                                     bcmptm_rm_tcam_prio_index_t *index,
+                                     int entry_pri,
+                                     int *target_idx,
+                                     int *from_idx,
+                                     int *to_idx);
+
+/*!
+ * \brief Check if all valid entries in the index occupy a single TCAM row.
+ *
+ * \param [in] index Priority index.
+ *
+ * \retval TRUE No multi-row entries are installed.
+ * \retval FALSE Some multi-row entries are installed.
+ */
+extern bool
+bcmptm_rm_tcam_prio_index_single_row(bcmptm_rm_tcam_prio_index_t *index);
+
+/*!
+ * \brief Destroy the priority index of a TCAM entry information array.
+ *
+ * \param [in] unit Logical device id
+ * \param [in] entry_info Start address of the TCAM entry information.
+ */
+extern void
+bcmptm_rm_tcam_prio_index_destroy(int unit, void *entry_info);
+
+/*!
+ * \brief Destroy all priority indexes of the given unit.
+ * \n Used when TCAM entry information is rewritten in bulk, e.g. on
+ * \n transaction abort or FP segment moves. Indexes are rebuilt on demand.
+ *
+ * \param [in] unit Logical device id
+ */
+extern void
+bcmptm_rm_tcam_prio_index_destroy_all(int unit);
+
+#endif /* RM_TCAM_PRIO_INDEX_H */
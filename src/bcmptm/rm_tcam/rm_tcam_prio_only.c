@@ -105,6 +105,7 @@
 #include <bcmdrd/bcmdrd_types.h>
 #include "rm_tcam.h"
 #include "rm_tcam_prio_only.h"
+#include "rm_tcam_prio_index.h"
 #include "rm_tcam_prio_atomicity.h"
 #include "rm_tcam_traverse.h"
 #include <bcmdrd/bcmdrd_field.h>
@@ -812,6 +813,10 @@ bcmptm_rm_tcam_prio_only_entry_move(int unit,
         entry_info[idx].entry_pri = BCMPTM_RM_TCAM_PRIO_INVALID;
         entry_info[idx].offset = BCMPTM_RM_TCAM_OFFSET_INVALID;
     }
+    for (idx = 0; idx < entry_type; idx++) {
+        bcmptm_rm_tcam_prio_index_sync(unit, entry_info, to_idx + idx);
+        bcmptm_rm_tcam_prio_index_sync(unit, entry_info, from_idx + idx);
+    }
 
     if (LOG_CHECK_DEBUG(BSL_LOG_MODULE)) {
         SHR_IF_ERR_VERBOSE_EXIT(rm_tcam_prio_only_find_loops(unit, ltid,
@@ -933,6 +938,7 @@ bcmptm_rm_tcam_prio_only_entry_write(int unit, bcmltd_sid_t ltid,
     for (idx = index; idx < (index + entry_type); idx++) {
         entry_info[idx].entry_pri = req_info->entry_pri;
         entry_info[idx].entry_type = entry_type;
+        bcmptm_rm_tcam_prio_index_sync(unit, entry_info, idx);
     }
 
     if (LOG_CHECK_DEBUG(BSL_LOG_MODULE)) {
@@ -1184,6 +1190,7 @@ bcmptm_rm_tcam_prio_only_entry_clear(int unit,
         entry_info[idx].entry_pri = BCMPTM_RM_TCAM_OFFSET_INVALID;
         entry_info[idx].offset = BCMPTM_RM_TCAM_OFFSET_INVALID;
         entry_info[idx].entry_type = 1;
+        bcmptm_rm_tcam_prio_index_sync(unit, entry_info, idx);
     }
 
     if (LOG_CHECK_DEBUG(BSL_LOG_MODULE)) {
@@ -1554,19 +1561,20 @@ exit:
     SHR_FUNC_EXIT();
 }
 
-/* Create a new free slot to insert an entry. */
-int
-bcmptm_rm_tcam_prio_only_entry_index_allocate(int unit,
-                                 uint32_t req_flags,
-                                 bcmltd_sid_t ltid,
-                                 bcmptm_rm_tcam_lt_info_t *ltid_info,
-                                 uint8_t prio_change,
-                                 bcmbd_pt_dyn_info_t *pt_dyn_info,
-                                 bcmptm_rm_tcam_req_t *req_info,
-                                 bcmptm_rm_tcam_rsp_t *rsp_info,
-                                 bcmltd_sid_t *rsp_ltid,
-                                 uint32_t *rsp_flags,
-                                 uint32_t *target_index)
+/*
+ * Find the slot for a new entry of the given priority and entry type
+ * by a linear scan of the TCAM entry information.
+ */
+static int
+rm_tcam_prio_only_slot_scan(int unit,
+                            bcmptm_rm_tcam_prio_only_entry_info_t *entry_info,
+                            uint16_t num_entries,
+                            uint32_t num_key_rows,
+                            uint32_t entry_start_boundary,
+                            int entry_pri,
+                            int *target_index,
+                            int *from_index,
+                            int *to_index)
 {
     int target_idx = -1;
     int idx = -1;
@@ -1576,62 +1584,13 @@ bcmptm_rm_tcam_prio_only_entry_index_allocate(int unit,
     int down_free_idx = -1;
     int from_idx = -1;
     int to_idx = -1;
-    bcmptm_rm_tcam_prio_only_info_t *tcam_info = NULL;
-    bcmptm_rm_tcam_prio_only_entry_info_t *entry_info = NULL;
-    uint32_t num_key_rows;
     uint32_t count = 0;
-    uint32_t entry_start_boundary = 0;
     int last_higher_prio_entry_type_idx = -1;
 
     /* Log the  function entry. */
     SHR_FUNC_ENTER(unit);
 
-    /* Input parameter check. */
-    SHR_NULL_CHECK(ltid_info, SHR_E_PARAM);
-
-    /* Fetch the TCAM information for the given ltid, pipe_id. */
-    SHR_IF_ERR_VERBOSE_EXIT(
-        bcmptm_rm_tcam_prio_only_tcam_info_get(unit, ltid, ltid_info,
-                                               pt_dyn_info->tbl_inst,
-                                               &tcam_info));
-
-    entry_start_boundary = ltid_info->hw_entry_info->entry_boundary;
-    /* Fetch the entry type details */
-    SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_num_index_required_get(unit,
-                                                       ltid, ltid_info,
-                                                       &num_key_rows));
-
-
-    /*
-     * If free entries are not available, entry cannot be inserted.
-     * If HW atomicity is supported then full range can be used.
-     * For entries which require more than one key row atomicity
-     * can't be achieved even if HW supports.
-     */
-    if ((prio_change == 0) &&
-        ((ltid_info->rm_more_info->hw_atomicity_support == 0) ||
-         (tcam_info->unused_entries > 1) || ltid_info->non_aggr) &&
-        (tcam_info->free_entries < (tcam_info->unused_entries + num_key_rows))) {
-        SHR_IF_ERR_EXIT(SHR_E_FULL);
-    }
-
-    if (tcam_info->free_entries < num_key_rows) {
-        SHR_IF_ERR_EXIT(SHR_E_FULL);
-    }
-
-    /* If no valid entries allocate the very first entry in TCAM. */
-    if (tcam_info->free_entries == tcam_info->num_entries) {
-        *target_index = 0;
-        SHR_FUNC_EXIT();
-    }
-
-    SHR_IF_ERR_VERBOSE_EXIT(
-                bcmptm_rm_tcam_prio_only_entry_info_get(unit,
-                                                        ltid, ltid_info,
-                                                        pt_dyn_info->tbl_inst,
-                                                        &entry_info));
-
-    for (idx = 0; idx < tcam_info->num_entries; idx += num_key_rows) {
+    for (idx = 0; idx < num_entries; idx += num_key_rows) {
 
         /* Record the last free tcam index before target index is found. */
         if (target_idx == BCMPTM_RM_TCAM_INDEX_INVALID) {
@@ -1679,7 +1638,7 @@ bcmptm_rm_tcam_prio_only_entry_index_allocate(int unit,
         /* Record the target index for the given prioirty. */
         if (target_idx == BCMPTM_RM_TCAM_INDEX_INVALID) {
             if(entry_info[idx].entry_type == num_key_rows) {
-                if (entry_info[idx].entry_pri < req_info->entry_pri) {
+                if (entry_info[idx].entry_pri < entry_pri) {
                     target_idx = idx;
                     /* If free entries block is just above the target index
                      * up_free_block_first_idx is the target index
@@ -1692,7 +1651,7 @@ bcmptm_rm_tcam_prio_only_entry_index_allocate(int unit,
                     /* Free entries block is just before entry with same prio.
                      * use up_free_block_first_idx as the target index*/
                     if ((up_free_block_first_idx != -1) &&
-                        (entry_info[idx].entry_pri == req_info->entry_pri)) {
+                        (entry_info[idx].entry_pri == entry_pri)) {
                         break;
                     }
                     up_free_block_first_idx = -1;
@@ -1837,9 +1796,125 @@ bcmptm_rm_tcam_prio_only_entry_index_allocate(int unit,
             to_idx = up_free_idx;
         }
     }
+    *target_index = target_idx;
+    *from_index = from_idx;
+    *to_index = to_idx;
+
+exit:
+    /* Log the function exit. */
+    SHR_FUNC_EXIT();
+}
+
+/* Create a new free slot to insert an entry. */
+int
+bcmptm_rm_tcam_prio_only_entry_index_allocate(int unit,
+                                 uint32_t req_flags,
+                                 bcmltd_sid_t ltid,
+                                 bcmptm_rm_tcam_lt_info_t *ltid_info,
+                                 uint8_t prio_change,
+                                 bcmbd_pt_dyn_info_t *pt_dyn_info,
+                                 bcmptm_rm_tcam_req_t *req_info,
+                                 bcmptm_rm_tcam_rsp_t *rsp_info,
+                                 bcmltd_sid_t *rsp_ltid,
+                                 uint32_t *rsp_flags,
+                                 uint32_t *target_index)
+{
+    int rv;
+    int target_idx = -1;
+    int idx = -1;
+    int from_idx = -1;
+    int to_idx = -1;
+    bcmptm_rm_tcam_prio_only_info_t *tcam_info = NULL;
+    bcmptm_rm_tcam_prio_only_entry_info_t *entry_info = NULL;
+    bcmptm_rm_tcam_prio_index_t *prio_index = NULL;
+    bool indexed = FALSE;
+    uint32_t num_key_rows;
+    uint32_t entry_start_boundary = 0;
+
+    /* Log the  function entry. */
+    SHR_FUNC_ENTER(unit);
+
+    /* Input parameter check. */
+    SHR_NULL_CHECK(ltid_info, SHR_E_PARAM);
+
+    /* Fetch the TCAM information for the given ltid, pipe_id. */
+    SHR_IF_ERR_VERBOSE_EXIT(
+        bcmptm_rm_tcam_prio_only_tcam_info_get(unit, ltid, ltid_info,
+                                               pt_dyn_info->tbl_inst,
+                                               &tcam_info));
+
+    entry_start_boundary = ltid_info->hw_entry_info->entry_boundary;
+    /* Fetch the entry type details */
+    SHR_IF_ERR_VERBOSE_EXIT(bcmptm_rm_tcam_num_index_required_get(unit,
+                                                       ltid, ltid_info,
+                                                       &num_key_rows));
+
+
+    /*
+     * If free entries are not available, entry cannot be inserted.
+     * If HW atomicity is supported then full range can be used.
+     * For entries which require more than one key row atomicity
+     * can't be achieved even if HW supports.
+     */
+    if ((prio_change == 0) &&
+        ((ltid_info->rm_more_info->hw_atomicity_support == 0) ||
+         (tcam_info->unused_entries > 1) || ltid_info->non_aggr) &&
+        (tcam_info->free_entries < (tcam_info->unused_entries + num_key_rows))) {
+        SHR_IF_ERR_EXIT(SHR_E_FULL);
+    }
+
+    if (tcam_info->free_entries < num_key_rows) {
+        SHR_IF_ERR_EXIT(SHR_E_FULL);
+    }
+
+    /* If no valid entries allocate the very first entry in TCAM. */
+    if (tcam_info->free_entries == tcam_info->num_entries) {
+        *target_index = 0;
+        SHR_FUNC_EXIT();
+    }
+
+    SHR_IF_ERR_VERBOSE_EXIT(
+                bcmptm_rm_tcam_prio_only_entry_info_get(unit,
+                                                        ltid, ltid_info,
+                                                        pt_dyn_info->tbl_inst,
+                                                        &entry_info));
+
+    /*
+     * Single row entries are placed through the priority index, as long as
+     * the TCAM holds no multi-row entries. Everything else is scanned.
+     */
+    if (num_key_rows == 1 && entry_start_boundary == 0) {
+        rv = bcmptm_rm_tcam_prio_index_get(unit,
+                                           BCMPTM_RM_TCAM_PRIO_INDEX_ONLY,
+                                           entry_info,
+                                           tcam_info->num_entries,
+                                           tcam_info->free_entries,
+                                           &prio_index);
+        if (SHR_SUCCESS(rv) &&
+            bcmptm_rm_tcam_prio_index_single_row(prio_index)) {
+            indexed = TRUE;
+        }
+    }
+    if (indexed) {
+        SHR_IF_ERR_EXIT(
+            bcmptm_rm_tcam_prio_index_target_get(unit, prio_index,
+                                                 req_info->entry_pri,
+                                                 &target_idx, &from_idx,
+                                                 &to_idx));
+    } else {
+        SHR_IF_ERR_VERBOSE_EXIT(
+            rm_tcam_prio_only_slot_scan(unit, entry_info,
+                                        tcam_info->num_entries,
+                                        num_key_rows,
+                                        entry_start_boundary,
+                                        req_info->entry_pri,
+                                        &target_idx, &from_idx, &to_idx));
+    }
+
     /* update the entry_type at target_idx */
     for (idx = 0; idx < (int) num_key_rows; idx++) {
         entry_info[to_idx + idx].entry_type = num_key_rows;
+        bcmptm_rm_tcam_prio_index_sync(unit, entry_info, to_idx + idx);
     }
     if (from_idx != to_idx) {
         /* Move entries either up or down ward direction. */
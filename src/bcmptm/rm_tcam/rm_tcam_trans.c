@@ -109,6 +109,7 @@
 #include "rm_tcam_prio_eid.h"
 #include "rm_tcam_fp.h"
 #include "rm_tcam_fp_entry_mgmt.h"
+#include "rm_tcam_prio_index.h"
 #include <bcmptm/bcmptm_cmdproc_internal.h>
 #include <bcmltd/chip/bcmltd_id.h>
 #include <bcmltd/chip/bcmltd_limits.h>
@@ -204,6 +205,8 @@ bcmptm_rm_tcam_um_trans_complete(int unit,
                         } else {
                             sal_memcpy(ltid_start_ptr, ltid_bkp_start_ptr,
                                           trans_info->ltid_size);
+                            /* Restored entries are not known to the index. */
+                            bcmptm_rm_tcam_prio_index_destroy_all(unit);
                         }
                         /* change the transaction state to Idle */
                         trans_info->trans_state = BCMPTM_RM_TCAM_STATE_IDLE;
@@ -0,0 +1,821 @@
+/*! \file ser_scan_sched.c
+ *
+ * Bandwidth budget of SER S/W memory scan
+ *
+ * SRAM and TCAM scan threads read entries at the rate configured in
+ * LT SER_CONTROLt. Unused credit is saved while WAL is busy with table
+ * writes, and spent once WAL traffic goes away. Coverage time of every
+ * scanned PT is recorded to check scan SLA.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+/******************************************************************************
+ * Includes
+ */
+#include <sal/sal_types.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_sem.h>
+#include <sal/sal_mutex.h>
+#include <sal/sal_time.h>
+#include <bsl/bsl.h>
+#include <shr/shr_debug.h>
+#include <bcmdrd/bcmdrd_pt.h>
+#include <bcmptm/bcmptm_wal_internal.h>
+#include <bcmptm/bcmptm_ser_internal.h>
+#include <bcmptm/bcmptm_ser_cth_internal.h>
+
+#include "ser_config.h"
+#include "ser_scan_sched.h"
+
+/******************************************************************************
+ * Defines
+ */
+#define  BSL_LOG_MODULE  BSL_LS_BCMPTM_SER
+
+/*! Serialize scan_sched_info against init, cleanup and statistics readers */
+#define SCAN_SCHED_LOCK(_u) \
+    (void)sal_mutex_take(scan_sched_mutex[_u], SAL_MUTEX_FOREVER)
+
+/*! Release lock taken by SCAN_SCHED_LOCK */
+#define SCAN_SCHED_UNLOCK(_u) \
+    (void)sal_mutex_give(scan_sched_mutex[_u])
+
+/*! Budget of the self test, in entries per interval */
+#define SCAN_SCHED_TEST_ENTRIES     256
+
+/*! Scan interval of the self test, in usecs */
+#define SCAN_SCHED_TEST_INTERVAL    10000
+
+/*! Entries read per chunk in the self test */
+#define SCAN_SCHED_TEST_CHUNK       16
+
+/*! Duration of each phase of the self test, in scan intervals */
+#define SCAN_SCHED_TEST_INTERVALS   100
+
+/*! Time to read one chunk in the self test, in usecs */
+#define SCAN_SCHED_TEST_READ_USECS  10
+
+/******************************************************************************
+ * Typedefs
+ */
+/*! Coverage information of one PT */
+typedef struct scan_pt_info_s {
+    /*! Statistics reported to user */
+    bcmptm_ser_scan_stats_t stats;
+    /*! Time when last complete scan of the PT is done */
+    sal_usecs_t done_time;
+    /*! Scan thread which scans the PT */
+    uint8_t type;
+} scan_pt_info_t;
+
+/*! Bandwidth budget of one scan thread */
+typedef struct scan_sched_s {
+    /*! Scan thread is using the budget */
+    bool active;
+    /*! ENTRIES_READ_PER_INTERVAL used to compute credit */
+    uint32_t entries;
+    /*! SCAN_INTERVAL used to compute credit, in usecs */
+    uint32_t interval;
+    /*! Credit in entries * usecs, negative value is debt */
+    int64_t credit;
+    /*! Time when credit is refilled */
+    sal_usecs_t refill_time;
+    /*! Scan is yielding to WAL traffic */
+    bool deferring;
+    /*! Time when scan began to yield */
+    sal_usecs_t defer_time;
+    /*! Num of entries read by last chunk */
+    uint32_t charged;
+    /*! Time when last chunk is read */
+    sal_usecs_t charge_time;
+    /*! PT being scanned */
+    bcmdrd_sid_t pt_sid;
+    /*! Time when scan of pt_sid began */
+    sal_usecs_t pt_begin_time;
+    /*! Statistics reported to user */
+    bcmptm_ser_scan_sched_stats_t stats;
+} scan_sched_t;
+
+/*! Scan budget information of one unit */
+typedef struct scan_sched_info_s {
+    /*! Budget of every scan thread */
+    scan_sched_t sched[BCMPTM_SER_SCAN_COUNT];
+    /*! Num of PTs */
+    size_t sid_count;
+    /*! Coverage information indexed by SID */
+    scan_pt_info_t *pt_info;
+} scan_sched_info_t;
+
+/******************************************************************************
+ * Private variables
+ */
+static scan_sched_info_t *scan_sched_info[BCMDRD_CONFIG_MAX_UNITS];
+
+static sal_mutex_t scan_sched_mutex[BCMDRD_CONFIG_MAX_UNITS];
+
+/******************************************************************************
+ * Private Functions
+ */
+/******************************************************************************
+ * scan_budget_get, get budget of scan thread from LT SER_CONTROLt
+ */
+static void
+scan_budget_get(int unit, bcmptm_ser_scan_type_t type,
+                uint32_t *entries, uint32_t *interval)
+{
+    if (type == BCMPTM_SER_SCAN_TCAM) {
+        *entries = BCMPTM_SER_CONTROL_TCAM_ENTRIES_READ_PER_INTERVAL(unit);
+        *interval = BCMPTM_SER_CONTROL_TCAM_SCAN_INTERVAL(unit);
+    } else {
+        *entries = BCMPTM_SER_CONTROL_SRAM_ENTRIES_READ_PER_INTERVAL(unit);
+        *interval = BCMPTM_SER_CONTROL_SRAM_SCAN_INTERVAL(unit);
+    }
+    /* Read at least one chunk per interval */
+    if (*entries == 0) {
+        *entries = 1;
+    }
+}
+
+/******************************************************************************
+ * scan_wal_busy_check, check WAL occupancy against the watermarks
+ */
+static bool
+scan_wal_busy_check(bool deferring, uint32_t msg_count,
+                    uint32_t msg_max_count, uint32_t scf_busy_chans)
+{
+    uint32_t pct;
+
+    if (scf_busy_chans >= BCMPTM_SER_SCAN_SCHED_SCF_BUSY_CHANS) {
+        return TRUE;
+    }
+    /* Lower watermark to resume, so that scan does not flap */
+    pct = deferring ? BCMPTM_SER_SCAN_SCHED_WAL_LOW_PCT :
+                      BCMPTM_SER_SCAN_SCHED_WAL_HIGH_PCT;
+    if (deferring) {
+        return ((uint64_t)msg_count * 100 > (uint64_t)msg_max_count * pct);
+    }
+    return ((uint64_t)msg_count * 100 >= (uint64_t)msg_max_count * pct);
+}
+
+/******************************************************************************
+ * scan_wal_busy, check whether WAL is busy with table writes
+ */
+static bool
+scan_wal_busy(int unit, bool deferring)
+{
+    uint32_t msg_count = 0, msg_max_count = 0, scf_busy_chans = 0;
+
+    if (SHR_FAILURE(bcmptm_wal_occupancy_get(unit, &msg_count, &msg_max_count,
+                                             &scf_busy_chans))) {
+        return FALSE;
+    }
+    return scan_wal_busy_check(deferring, msg_count, msg_max_count,
+                               scf_busy_chans);
+}
+
+/******************************************************************************
+ * scan_credit_refill, add credit earned since last refill
+ */
+static void
+scan_credit_refill(scan_sched_t *sched, uint32_t entries, uint32_t interval,
+                   sal_usecs_t now)
+{
+    int64_t cap = (int64_t)entries * interval *
+                  BCMPTM_SER_SCAN_SCHED_BURST_INTERVALS;
+    uint64_t elapsed;
+
+    if (entries != sched->entries || interval != sched->interval) {
+        /* New budget, start with credit of one interval */
+        sched->entries = entries;
+        sched->interval = interval;
+        sched->credit = (int64_t)entries * interval;
+    } else {
+        elapsed = (uint64_t)(now - sched->refill_time);
+        if (elapsed > (uint64_t)interval * BCMPTM_SER_SCAN_SCHED_BURST_INTERVALS) {
+            elapsed = (uint64_t)interval * BCMPTM_SER_SCAN_SCHED_BURST_INTERVALS;
+        }
+        sched->credit += (int64_t)elapsed * entries;
+    }
+    if (sched->credit > cap) {
+        sched->credit = cap;
+    }
+    sched->refill_time = now;
+}
+
+/******************************************************************************
+ * scan_defer_end, scan stops yielding to WAL traffic
+ */
+static void
+scan_defer_end(scan_sched_t *sched, sal_usecs_t now)
+{
+    if (sched->deferring) {
+        sched->stats.backoff_usecs += (uint64_t)(now - sched->defer_time);
+        sched->deferring = FALSE;
+    }
+}
+
+/******************************************************************************
+ * scan_sched_next, decide whether scan can read next chunk at time now
+ * Return 0 if it can, otherwise the time to sleep before asking again.
+ */
+static uint64_t
+scan_sched_next(scan_sched_t *sched, uint32_t entries, uint32_t interval,
+                sal_usecs_t now, bool wal_busy)
+{
+    uint64_t sleep_usecs, min_gap, elapsed;
+    uint32_t min_rate_pct;
+
+    scan_credit_refill(sched, entries, interval, now);
+
+    if (sched->credit <= 0) {
+        /* Sleep until debt is paid */
+        return (uint64_t)(-sched->credit) / entries + 1;
+    }
+    if (!wal_busy) {
+        scan_defer_end(sched, now);
+        return 0;
+    }
+    if (!sched->deferring) {
+        sched->deferring = TRUE;
+        sched->defer_time = now;
+        sched->stats.backoffs++;
+    }
+    /* Keep reading at minimum rate, so that coverage still progresses */
+    sleep_usecs = BCMPTM_SER_SCAN_SCHED_BACKOFF_USECS;
+    min_rate_pct = BCMPTM_SER_SCAN_SCHED_MIN_RATE_PCT;
+    if (min_rate_pct > 0) {
+        min_gap = (uint64_t)sched->charged * interval * 100 /
+                  ((uint64_t)entries * min_rate_pct);
+        elapsed = (uint64_t)(now - sched->charge_time);
+        if (elapsed >= min_gap) {
+            sched->stats.throttled++;
+            return 0;
+        }
+        if (min_gap - elapsed < sleep_usecs) {
+            sleep_usecs = min_gap - elapsed;
+        }
+    }
+    return sleep_usecs;
+}
+
+/******************************************************************************
+ * scan_sched_charge, charge entries read at time now
+ */
+static void
+scan_sched_charge(scan_sched_t *sched, uint32_t entries, sal_usecs_t now)
+{
+    sched->credit -= (int64_t)entries * sched->interval;
+    sched->charged = entries;
+    sched->charge_time = now;
+    sched->stats.entries += entries;
+}
+
+/******************************************************************************
+ * scan_sched_test_run, run scan on simulated clock for a number of usecs
+ * Return num of entries read, and num of entries read before first sleep
+ * in \c burst.
+ */
+static uint32_t
+scan_sched_test_run(scan_sched_t *sched, sal_usecs_t *now, uint64_t usecs,
+                    bool wal_busy, uint32_t *burst)
+{
+    sal_usecs_t end = *now + usecs;
+    uint64_t sleep_usecs;
+    uint32_t read = 0;
+    bool slept = FALSE;
+
+    *burst = 0;
+    while ((int64_t)(end - *now) > 0) {
+        sleep_usecs = scan_sched_next(sched, SCAN_SCHED_TEST_ENTRIES,
+                                      SCAN_SCHED_TEST_INTERVAL, *now,
+                                      wal_busy);
+        if (sleep_usecs > 0) {
+            slept = TRUE;
+            *now += sleep_usecs;
+            continue;
+        }
+        *now += SCAN_SCHED_TEST_READ_USECS;
+        scan_sched_charge(sched, SCAN_SCHED_TEST_CHUNK, *now);
+        read += SCAN_SCHED_TEST_CHUNK;
+        if (!slept) {
+            *burst += SCAN_SCHED_TEST_CHUNK;
+        }
+    }
+    return read;
+}
+
+/******************************************************************************
+ * scan_sched_test_check, count a failed check of the self test
+ */
+static void
+scan_sched_test_check(int unit, bcmptm_ser_scan_sched_test_t *result,
+                      bool ok, const char *what)
+{
+    if (!ok) {
+        LOG_ERROR(BSL_LOG_MODULE,
+                  (BSL_META_U(unit, "Scan pacing test: %s\n"), what));
+        result->failures++;
+    }
+}
+
+/******************************************************************************
+ * Public Functions
+ */
+/******************************************************************************
+ * bcmptm_ser_scan_sched_init
+ */
+int
+bcmptm_ser_scan_sched_init(int unit, bcmptm_ser_scan_type_t type)
+{
+    scan_sched_info_t *info;
+    size_t sid_count = 0, alloc_size;
+    int rv = SHR_E_NONE;
+    bool locked = FALSE;
+
+    SHR_FUNC_ENTER(unit);
+
+    if (scan_sched_mutex[unit] == NULL) {
+        SHR_RETURN_VAL_EXIT(SHR_E_INIT);
+    }
+    SCAN_SCHED_LOCK(unit);
+    locked = TRUE;
+    info = scan_sched_info[unit];
+    if (info == NULL) {
+        rv = bcmdrd_pt_sid_list_get(unit, 0, NULL, &sid_count);
+        SHR_IF_ERR_EXIT(rv);
+
+        info = sal_alloc(sizeof(*info), "ser scan sched info");
+        SHR_NULL_CHECK(info, SHR_E_MEMORY);
+        sal_memset(info, 0, sizeof(*info));
+
+        alloc_size = sid_count * sizeof(scan_pt_info_t);
+        info->pt_info = sal_alloc(alloc_size, "ser scan pt info");
+        if (info->pt_info == NULL) {
+            sal_free(info);
+            SHR_NULL_CHECK(NULL, SHR_E_MEMORY);
+        }
+        sal_memset(info->pt_info, 0, alloc_size);
+        info->sid_count = sid_count;
+        scan_sched_info[unit] = info;
+    }
+    /* Keep statistics, restart budget */
+    info->sched[type].active = TRUE;
+    info->sched[type].entries = 0;
+    info->sched[type].interval = 0;
+    info->sched[type].credit = 0;
+    info->sched[type].deferring = FALSE;
+    info->sched[type].charged = 0;
+    info->sched[type].pt_sid = INVALIDm;
+
+exit:
+    if (locked) {
+        SCAN_SCHED_UNLOCK(unit);
+    }
+    SHR_FUNC_EXIT();
+}
+
+/******************************************************************************
+ * bcmptm_ser_scan_sched_cleanup
+ */
+void
+bcmptm_ser_scan_sched_cleanup(int unit, bcmptm_ser_scan_type_t type)
+{
+    scan_sched_info_t *info;
+    int i;
+
+    if (scan_sched_mutex[unit] == NULL) {
+        return;
+    }
+    SCAN_SCHED_LOCK(unit);
+    info = scan_sched_info[unit];
+    if (info == NULL) {
+        SCAN_SCHED_UNLOCK(unit);
+        return;
+    }
+    info->sched[type].active = FALSE;
+    for (i = 0; i < BCMPTM_SER_SCAN_COUNT; i++) {
+        if (info->sched[i].active) {
+            SCAN_SCHED_UNLOCK(unit);
+            return;
+        }
+    }
+    scan_sched_info[unit] = NULL;
+    SCAN_SCHED_UNLOCK(unit);
+
+    sal_free(info->pt_info);
+    sal_free(info);
+}
+
+/******************************************************************************
+ * bcmptm_ser_scan_sched_wait
+ */
+bool
+bcmptm_ser_scan_sched_wait(int unit, bcmptm_ser_scan_type_t type,
+                           sal_sem_t wakeup)
+{
+    scan_sched_t *sched;
+    uint32_t entries, interval;
+    uint64_t sleep_usecs;
+    bool wal_busy;
+
+    /* Info is freed only after the scan thread has exited */
+    if (scan_sched_info[unit] == NULL) {
+        return FALSE;
+    }
+    sched = &scan_sched_info[unit]->sched[type];
+
+    while (1) {
+        scan_budget_get(unit, type, &entries, &interval);
+        if (interval == 0) {
+            /* No limit */
+            return FALSE;
+        }
+        SCAN_SCHED_LOCK(unit);
+        wal_busy = scan_wal_busy(unit, sched->deferring);
+        sleep_usecs = scan_sched_next(sched, entries, interval,
+                                      sal_time_usecs(), wal_busy);
+        SCAN_SCHED_UNLOCK(unit);
+        if (sleep_usecs == 0) {
+            return FALSE;
+        }
+        if (sal_sem_take(wakeup, (int)sleep_usecs) == 0) {
+            SCAN_SCHED_LOCK(unit);
+            scan_defer_end(sched, sal_time_usecs());
+            SCAN_SCHED_UNLOCK(unit);
+            return TRUE;
+        }
+    }
+}
+
+/******************************************************************************
+ * bcmptm_ser_scan_sched_charge
+ */
+void
+bcmptm_ser_scan_sched_charge(int unit, bcmptm_ser_scan_type_t type,
+                             uint32_t entries)
+{
+    if (scan_sched_info[unit] == NULL) {
+        return;
+    }
+    SCAN_SCHED_LOCK(unit);
+    scan_sched_charge(&scan_sched_info[unit]->sched[type], entries,
+                      sal_time_usecs());
+    SCAN_SCHED_UNLOCK(unit);
+}
+
+/******************************************************************************
+ * bcmptm_ser_scan_sched_pt_begin
+ */
+void
+bcmptm_ser_scan_sched_pt_begin(int unit, bcmptm_ser_scan_type_t type,
+                               bcmdrd_sid_t sid)
+{
+    scan_sched_t *sched;
+
+    if (scan_sched_info[unit] == NULL) {
+        return;
+    }
+    sched = &scan_sched_info[unit]->sched[type];
+    sched->pt_sid = sid;
+    sched->pt_begin_time = sal_time_usecs();
+}
+
+/******************************************************************************
+ * bcmptm_ser_scan_sched_pt_done
+ */
+void
+bcmptm_ser_scan_sched_pt_done(int unit, bcmptm_ser_scan_type_t type,
+                              bcmdrd_sid_t sid)
+{
+    scan_sched_info_t *info = scan_sched_info[unit];
+    scan_pt_info_t *pt_info;
+    sal_usecs_t now;
+    uint64_t period;
+
+    if (info == NULL || sid >= info->sid_count) {
+        return;
+    }
+    SCAN_SCHED_LOCK(unit);
+    now = sal_time_usecs();
+    pt_info = &info->pt_info[sid];
+    pt_info->type = (uint8_t)type;
+    pt_info->stats.rounds++;
+    if (info->sched[type].pt_sid == sid) {
+        pt_info->stats.scan_usecs =
+            (uint64_t)(now - info->sched[type].pt_begin_time);
+    }
+    if (pt_info->done_time != 0) {
+        period = (uint64_t)(now - pt_info->done_time);
+        pt_info->stats.period_usecs = period;
+        if (period > pt_info->stats.period_max_usecs) {
+            pt_info->stats.period_max_usecs = period;
+        }
+        if (period > BCMPTM_SER_SCAN_SCHED_SLA_USECS) {
+            pt_info->stats.sla_misses++;
+            LOG_VERBOSE(BSL_LOG_MODULE,
+                        (BSL_META_U(unit,
+                                    "Scan period of %s is %"PRIu64" usecs,"
+                                    " exceeds SLA\n"),
+                         bcmdrd_pt_sid_to_name(unit, sid), period));
+        }
+    }
+    pt_info->done_time = now;
+    SCAN_SCHED_UNLOCK(unit);
+}
+
+/******************************************************************************
+ * bcmptm_ser_scan_stats_get
+ */
+int
+bcmptm_ser_scan_stats_get(int unit, bcmdrd_sid_t sid,
+                          bcmptm_ser_scan_stats_t *stats)
+{
+    scan_sched_info_t *info;
+    bool locked = FALSE;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_NULL_CHECK(stats, SHR_E_PARAM);
+    if (scan_sched_mutex[unit] == NULL) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
+    }
+    SCAN_SCHED_LOCK(unit);
+    locked = TRUE;
+    info = scan_sched_info[unit];
+    if (info == NULL) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
+    }
+    if (sid >= info->sid_count) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    *stats = info->pt_info[sid].stats;
+
+exit:
+    if (locked) {
+        SCAN_SCHED_UNLOCK(unit);
+    }
+    SHR_FUNC_EXIT();
+}
+
+/******************************************************************************
+ * bcmptm_ser_scan_sched_stats_get
+ */
+int
+bcmptm_ser_scan_sched_stats_get(int unit, bcmptm_ser_scan_type_t type,
+                                bcmptm_ser_scan_sched_stats_t *stats)
+{
+    scan_sched_info_t *info;
+    scan_pt_info_t *pt_info;
+    size_t sid;
+    bool locked = FALSE;
+
+    SHR_FUNC_ENTER(unit);
+
+    SHR_NULL_CHECK(stats, SHR_E_PARAM);
+    if (type < 0 || type >= BCMPTM_SER_SCAN_COUNT) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    if (scan_sched_mutex[unit] == NULL) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
+    }
+    SCAN_SCHED_LOCK(unit);
+    locked = TRUE;
+    info = scan_sched_info[unit];
+    if (info == NULL) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
+    }
+    *stats = info->sched[type].stats;
+    stats->period_max_usecs = 0;
+    stats->sla_misses = 0;
+    for (sid = 0; sid < info->sid_count; sid++) {
+        pt_info = &info->pt_info[sid];
+        if (pt_info->stats.rounds == 0 || pt_info->type != type) {
+            continue;
+        }
+        if (pt_info->stats.period_max_usecs > stats->period_max_usecs) {
+            stats->period_max_usecs = pt_info->stats.period_max_usecs;
+        }
+        stats->sla_misses += pt_info->stats.sla_misses;
+    }
+
+exit:
+    if (locked) {
+        SCAN_SCHED_UNLOCK(unit);
+    }
+    SHR_FUNC_EXIT();
+}
+
+/******************************************************************************
+ * bcmptm_ser_scan_sched_unit_init
+ */
+int
+bcmptm_ser_scan_sched_unit_init(int unit)
+{
+    SHR_FUNC_ENTER(unit);
+
+    if (scan_sched_mutex[unit] == NULL) {
+        scan_sched_mutex[unit] = sal_mutex_create("ser scan sched");
+        SHR_NULL_CHECK(scan_sched_mutex[unit], SHR_E_MEMORY);
+    }
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+/******************************************************************************
+ * bcmptm_ser_scan_sched_unit_cleanup
+ */
+void
+bcmptm_ser_scan_sched_unit_cleanup(int unit)
+{
+    scan_sched_info_t *info = scan_sched_info[unit];
+
+    /* Scan threads have been stopped */
+    scan_sched_info[unit] = NULL;
+    if (info != NULL) {
+        sal_free(info->pt_info);
+        sal_free(info);
+    }
+    if (scan_sched_mutex[unit] != NULL) {
+        sal_mutex_destroy(scan_sched_mutex[unit]);
+        scan_sched_mutex[unit] = NULL;
+    }
+}
+
+/******************************************************************************
+ * bcmptm_ser_scan_sched_test
+ */
+int
+bcmptm_ser_scan_sched_test(int unit, bcmptm_ser_scan_sched_test_t *result)
+{
+    scan_sched_t sched;
+    sal_usecs_t now = 1000000;
+    uint64_t usecs = (uint64_t)SCAN_SCHED_TEST_INTERVAL *
+                     SCAN_SCHED_TEST_INTERVALS;
+    uint32_t budget = SCAN_SCHED_TEST_ENTRIES * SCAN_SCHED_TEST_INTERVALS;
+    uint32_t min_rate, read, burst;
+
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(result, SHR_E_PARAM);
+    sal_memset(result, 0, sizeof(*result));
+    sal_memset(&sched, 0, sizeof(sched));
+    result->entries = SCAN_SCHED_TEST_ENTRIES;
+
+    /* Watermarks, with lower watermark to resume */
+    scan_sched_test_check(unit, result,
+                          scan_wal_busy_check(FALSE, 25, 100, 0),
+                          "25% of WAL msgs does not start backoff");
+    scan_sched_test_check(unit, result,
+                          !scan_wal_busy_check(FALSE, 10, 100, 0),
+                          "10% of WAL msgs starts backoff");
+    scan_sched_test_check(unit, result,
+                          scan_wal_busy_check(TRUE, 10, 100, 0),
+                          "10% of WAL msgs ends backoff");
+    scan_sched_test_check(unit, result,
+                          !scan_wal_busy_check(TRUE, 5, 100, 0),
+                          "5% of WAL msgs does not end backoff");
+    scan_sched_test_check(unit, result,
+                          scan_wal_busy_check(FALSE, 0, 100,
+                              BCMPTM_SER_SCAN_SCHED_SCF_BUSY_CHANS),
+                          "busy schanfifo channels do not start backoff");
+
+    /* WAL idle, reads are paced at the budget */
+    read = scan_sched_test_run(&sched, &now, usecs, FALSE, &burst);
+    result->idle_entries = read / SCAN_SCHED_TEST_INTERVALS;
+    scan_sched_test_check(unit, result,
+                          read >= budget - SCAN_SCHED_TEST_CHUNK &&
+                          read <= budget + SCAN_SCHED_TEST_ENTRIES +
+                                  SCAN_SCHED_TEST_CHUNK,
+                          "idle rate is not the budget");
+    scan_sched_test_check(unit, result,
+                          burst <= SCAN_SCHED_TEST_ENTRIES +
+                                   SCAN_SCHED_TEST_CHUNK,
+                          "first burst exceeds one interval");
+
+    /* WAL busy, reads slow down to the minimum rate */
+    min_rate = budget / 100 * BCMPTM_SER_SCAN_SCHED_MIN_RATE_PCT;
+    read = scan_sched_test_run(&sched, &now, usecs, TRUE, &burst);
+    result->busy_entries = read / SCAN_SCHED_TEST_INTERVALS;
+    result->backoffs = sched.stats.backoffs;
+    scan_sched_test_check(unit, result,
+                          read >= min_rate - min_rate / 10 &&
+                          read <= min_rate + min_rate / 10 +
+                                  SCAN_SCHED_TEST_CHUNK,
+                          "busy rate is not the minimum rate");
+    scan_sched_test_check(unit, result, sched.stats.backoffs == 1,
+                          "scan did not back off once");
+
+    /* WAL idle again, saved credit is spent at once */
+    read = scan_sched_test_run(&sched, &now, usecs, FALSE, &burst);
+    result->catchup_entries = burst;
+    result->backoff_usecs = sched.stats.backoff_usecs;
+    scan_sched_test_check(unit, result,
+                          burst >= SCAN_SCHED_TEST_ENTRIES *
+                                   (BCMPTM_SER_SCAN_SCHED_BURST_INTERVALS - 1) &&
+                          burst <= SCAN_SCHED_TEST_ENTRIES *
+                                   (BCMPTM_SER_SCAN_SCHED_BURST_INTERVALS + 1),
+                          "saved credit is not spent once WAL is idle");
+    scan_sched_test_check(unit, result,
+                          sched.stats.backoff_usecs + SCAN_SCHED_TEST_INTERVAL >=
+                              usecs &&
+                          sched.stats.backoff_usecs <= usecs +
+                              BCMPTM_SER_SCAN_SCHED_BACKOFF_USECS,
+                          "backoff time is not the busy time");
+    scan_sched_test_check(unit, result,
+                          read <= budget + SCAN_SCHED_TEST_ENTRIES *
+                                  (BCMPTM_SER_SCAN_SCHED_BURST_INTERVALS + 1),
+                          "scan exceeds budget after catch up");
+
+    if (result->failures > 0) {
+        SHR_RETURN_VAL_EXIT(SHR_E_FAIL);
+    }
+
+exit:
+    SHR_FUNC_EXIT();
+}
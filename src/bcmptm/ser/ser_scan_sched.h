@@ -0,0 +1,238 @@
+/*! \file ser_scan_sched.h
+ *
+ * Bandwidth budget of SER S/W memory scan
+ *
+ * Paces SRAM and TCAM scan threads, yields to WAL traffic
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+#ifndef SER_SCAN_SCHED_H
+#define SER_SCAN_SCHED_H
+
+/*******************************************************************************
+ * Includes
+ */
+#include <sal/sal_types.h>
+#include <sal/sal_sem.h>
+#include <bcmdrd/bcmdrd_types.h>
+#include <bcmptm/bcmptm_ser_internal.h>
+
+/*******************************************************************************
+ * Defines
+ */
+/*!
+ * \brief Max credit saved while scan yields, in scan intervals.
+ * Saved credit is spent without sleeping once WAL traffic goes away,
+ * so that scan catches up with its budget.
+ */
+#ifndef BCMPTM_SER_SCAN_SCHED_BURST_INTERVALS
+#define BCMPTM_SER_SCAN_SCHED_BURST_INTERVALS    4
+#endif
+
+/*!
+ * \brief Scan rate while WAL is busy, in percentage of the budget.
+ * Scan keeps progressing under sustained WAL traffic.
+ */
+#ifndef BCMPTM_SER_SCAN_SCHED_MIN_RATE_PCT
+#define BCMPTM_SER_SCAN_SCHED_MIN_RATE_PCT       25
+#endif
+
+/*! Scan yields when this percentage of WAL msgs is in use. */
+#ifndef BCMPTM_SER_SCAN_SCHED_WAL_HIGH_PCT
+#define BCMPTM_SER_SCAN_SCHED_WAL_HIGH_PCT       25
+#endif
+
+/*! Scan resumes when WAL msgs in use drop to this percentage. */
+#ifndef BCMPTM_SER_SCAN_SCHED_WAL_LOW_PCT
+#define BCMPTM_SER_SCAN_SCHED_WAL_LOW_PCT        5
+#endif
+
+/*! Scan yields when this many schanfifo channels hold WAL ops. */
+#ifndef BCMPTM_SER_SCAN_SCHED_SCF_BUSY_CHANS
+#define BCMPTM_SER_SCAN_SCHED_SCF_BUSY_CHANS     2
+#endif
+
+/*! Polling period of WAL occupancy while scan yields, in usecs. */
+#ifndef BCMPTM_SER_SCAN_SCHED_BACKOFF_USECS
+#define BCMPTM_SER_SCAN_SCHED_BACKOFF_USECS      1000
+#endif
+
+/*! Every entry of a PT should be scanned at least once in this time. */
+#ifndef BCMPTM_SER_SCAN_SCHED_SLA_USECS
+#define BCMPTM_SER_SCAN_SCHED_SLA_USECS          (600 * 1000000ULL)
+#endif
+
+/*******************************************************************************
+ * Function declarations
+ */
+/*!
+ * \brief Reset bandwidth budget of one scan thread.
+ *
+ * Called before the scan thread is created.
+ *
+ * \param [in] unit                        Logical device id.
+ * \param [in] type                        Scan thread.
+ *
+ * \retval SHR_E_NONE for success
+ */
+extern int
+bcmptm_ser_scan_sched_init(int unit, bcmptm_ser_scan_type_t type);
+
+/*!
+ * \brief Release resources used by bandwidth budget of one scan thread.
+ *
+ * Coverage statistics are freed with the last scan thread.
+ *
+ * \param [in] unit                        Logical device id.
+ * \param [in] type                        Scan thread.
+ *
+ * \retval NONE
+ */
+extern void
+bcmptm_ser_scan_sched_cleanup(int unit, bcmptm_ser_scan_type_t type);
+
+/*!
+ * \brief Wait until scan thread can read next chunk.
+ *
+ * Scan reads at the rate of ENTRIES_READ_PER_INTERVAL per SCAN_INTERVAL
+ * of LT SER_CONTROLt. It slows down to \ref BCMPTM_SER_SCAN_SCHED_MIN_RATE_PCT
+ * while WAL is busy with table writes, and catches up with saved credit
+ * after that.
+ *
+ * \param [in] unit                        Logical device id.
+ * \param [in] type                        Scan thread.
+ * \param [in] wakeup                      Semaphore used to stop or resume
+ *                                         scan thread.
+ *
+ * \retval TRUE scan thread is woken up by \c wakeup
+ * \retval FALSE scan thread can read next chunk
+ */
+extern bool
+bcmptm_ser_scan_sched_wait(int unit, bcmptm_ser_scan_type_t type,
+                           sal_sem_t wakeup);
+
+/*!
+ * \brief Charge entries read by scan thread against its budget.
+ *
+ * \param [in] unit                        Logical device id.
+ * \param [in] type                        Scan thread.
+ * \param [in] entries                     Num of entries read.
+ *
+ * \retval NONE
+ */
+extern void
+bcmptm_ser_scan_sched_charge(int unit, bcmptm_ser_scan_type_t type,
+                             uint32_t entries);
+
+/*!
+ * \brief Scan thread begins to scan a PT.
+ *
+ * \param [in] unit                        Logical device id.
+ * \param [in] type                        Scan thread.
+ * \param [in] sid                         PT ID.
+ *
+ * \retval NONE
+ */
+extern void
+bcmptm_ser_scan_sched_pt_begin(int unit, bcmptm_ser_scan_type_t type,
+                               bcmdrd_sid_t sid);
+
+/*!
+ * \brief Scan thread has scanned all entries and instances of a PT.
+ *
+ * \param [in] unit                        Logical device id.
+ * \param [in] type                        Scan thread.
+ * \param [in] sid                         PT ID.
+ *
+ * \retval NONE
+ */
+extern void
+bcmptm_ser_scan_sched_pt_done(int unit, bcmptm_ser_scan_type_t type,
+                              bcmdrd_sid_t sid);
+
+#endif /* SER_SCAN_SCHED_H */
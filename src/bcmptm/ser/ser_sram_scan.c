@@ -113,6 +113,7 @@
 #include "ser_tcam_scan.h"
 #include "ser_bd.h"
 #include "ser_config.h"
+#include "ser_scan_sched.h"
 /******************************************************************************
  * Defines
  */
@@ -207,6 +208,7 @@ bcmptm_ser_sram_scan_info_deinit(int unit)
         return;
     }
     sram_scan_info[unit] = NULL;
+    bcmptm_ser_scan_sched_cleanup(unit, BCMPTM_SER_SCAN_SRAM);
     if (scan_info->sram_scan_interval != NULL) {
         sal_sem_destroy(scan_info->sram_scan_interval);
         scan_info->sram_scan_interval = NULL;
@@ -374,7 +376,6 @@ bcmptm_ser_sram_scan_thread(void *unit_vp)
     uint64_t buf_paddr = 0;
     int inst = 0, inst_num = 0, is_port_reg = FALSE;
     int begin_index = 0, max_index = 0, min_index = 0, index_num = 0;
-    int index_num_not_scanned = 0, interval = 0;
     bool sram_scan_stopped = FALSE;
     bcmptm_ser_sram_scan_info_t *scan_info_ptr = sram_scan_info[unit];
     int min_port = 0, max_port = 0;
@@ -386,8 +387,6 @@ bcmptm_ser_sram_scan_thread(void *unit_vp)
     if (sram_scan_stopped) {
         SHR_RETURN_VAL_EXIT(rv);
     }
-    index_num_not_scanned = BCMPTM_SER_CONTROL_SRAM_ENTRIES_READ_PER_INTERVAL(unit);
-
     chunk_size_old = BCMPTM_SER_CONTROL_SRAM_SCAN_CHUNK_SIZE(unit);
     chunk_byte_size = chunk_size_old * sizeof(uint32_t) * BCMDRD_MAX_PT_WSIZE;
     /* allocate dma read buffer */
@@ -429,6 +428,7 @@ bcmptm_ser_sram_scan_thread(void *unit_vp)
             begin_index = min_index;
         }
         inst = 0;
+        bcmptm_ser_scan_sched_pt_begin(unit, BCMPTM_SER_SCAN_SRAM, sid);
         while (inst < inst_num) {
             if (is_port_reg) {
                 index_num = ((begin_index + chunk_size_old) < max_port) ?
@@ -446,6 +446,7 @@ bcmptm_ser_sram_scan_thread(void *unit_vp)
             rv = bcmptm_ser_sram_scan(unit, sid, inst, begin_index,
                                       index_num, buf_paddr, is_port_reg);
             SHR_IF_ERR_EXIT(rv);
+            bcmptm_ser_scan_sched_charge(unit, BCMPTM_SER_SCAN_SRAM, index_num);
             begin_index += index_num;
 
             sram_scan_stopped = scan_info_ptr->sram_scan_stopped;
@@ -453,36 +454,31 @@ bcmptm_ser_sram_scan_thread(void *unit_vp)
                 rv = SHR_E_NONE;
                 SHR_RETURN_VAL_EXIT(rv);
             }
-            index_num_not_scanned -= index_num;
-            if (index_num_not_scanned <= 0) {
-                /* interval should be more than 1000000, refer to definition of LT SER_CONTROLt */
-                interval = BCMPTM_SER_CONTROL_SRAM_SCAN_INTERVAL(unit);
-                /* Fall asleep */
-                (void)sal_sem_take(scan_info_ptr->sram_scan_interval, interval);
-                /* wake up */
-                /* update latest data from LT SER_CONTROLt */
-                chunk_size_new = BCMPTM_SER_CONTROL_SRAM_SCAN_CHUNK_SIZE(unit);
-                if (chunk_size_new != (uint32_t)chunk_size_old) {
-                    chunk_byte_size = chunk_size_new * sizeof(uint32_t) * BCMDRD_MAX_PT_WSIZE;
-                    /* adjust size of dma read buffer */
-                    bcmptm_ser_sram_scan_buff_adjust(unit, chunk_byte_size);
-                    buf_paddr = scan_info_ptr->sram_scan_buf_paddr;
-                    /* Fail to re-allocate DMA read buffer */
-                    if (buf_paddr == 0) {
-                        rv = SHR_E_MEMORY;
-                        SHR_RETURN_VAL_EXIT(rv);
-                    }
-                    chunk_size_old = chunk_size_new;
-                }
-                index_num_not_scanned = BCMPTM_SER_CONTROL_SRAM_ENTRIES_READ_PER_INTERVAL(unit);
-                /* Maybe need to exit */
-                sram_scan_stopped = scan_info_ptr->sram_scan_stopped;
-                if (sram_scan_stopped) {
-                    rv = SHR_E_NONE;
+            /* Yield to WAL traffic, keep budget of LT SER_CONTROLt */
+            (void)bcmptm_ser_scan_sched_wait(unit, BCMPTM_SER_SCAN_SRAM,
+                                             scan_info_ptr->sram_scan_interval);
+            /* update latest data from LT SER_CONTROLt */
+            chunk_size_new = BCMPTM_SER_CONTROL_SRAM_SCAN_CHUNK_SIZE(unit);
+            if (chunk_size_new != (uint32_t)chunk_size_old) {
+                chunk_byte_size = chunk_size_new * sizeof(uint32_t) * BCMDRD_MAX_PT_WSIZE;
+                /* adjust size of dma read buffer */
+                bcmptm_ser_sram_scan_buff_adjust(unit, chunk_byte_size);
+                buf_paddr = scan_info_ptr->sram_scan_buf_paddr;
+                /* Fail to re-allocate DMA read buffer */
+                if (buf_paddr == 0) {
+                    rv = SHR_E_MEMORY;
                     SHR_RETURN_VAL_EXIT(rv);
                 }
+                chunk_size_old = chunk_size_new;
+            }
+            /* Maybe need to exit */
+            sram_scan_stopped = scan_info_ptr->sram_scan_stopped;
+            if (sram_scan_stopped) {
+                rv = SHR_E_NONE;
+                SHR_RETURN_VAL_EXIT(rv);
             }
         }
+        bcmptm_ser_scan_sched_pt_done(unit, BCMPTM_SER_SCAN_SRAM, sid);
     }
 exit:
     if (0 == SHR_FUNC_VAL_IS(SHR_E_NONE)) {
@@ -541,6 +537,10 @@ bcmptm_ser_sram_scan_start(int unit, bcmdrd_sid_t beginning_sid)
                              " SRAM scan thread is exiting!\n")));
         return SHR_E_NONE;
     }
+    rv = bcmptm_ser_scan_sched_init(unit, BCMPTM_SER_SCAN_SRAM);
+    if (SHR_FAILURE(rv)) {
+        return rv;
+    }
     scan_info->sram_scan_stopped = FALSE;
     if (beginning_sid != 0) {
         scan_info->begin_sid = beginning_sid;
@@ -112,6 +112,7 @@
 #include "ser_tcam_scan.h"
 #include "ser_bd.h"
 #include "ser_config.h"
+#include "ser_scan_sched.h"
 /******************************************************************************
  * Defines
  */
@@ -403,6 +404,7 @@ bcmptm_ser_tcam_scan_info_deinit(int unit)
     }
     scan_info_ptr = tcam_scan_info[unit];
     tcam_scan_info[unit] = NULL;
+    bcmptm_ser_scan_sched_cleanup(unit, BCMPTM_SER_SCAN_TCAM);
 
     if (scan_info_ptr->table_info != NULL) {
         sal_free(scan_info_ptr->table_info);
@@ -499,8 +501,7 @@ static void
 bcmptm_ser_tcam_scan_thread(void *unit_vp)
 {
     int unit = PTR_TO_INT(unit_vp);
-    uint32_t interval = 0;
-    int index_num_not_scanned, index_num_scanned;
+    int index_num_scanned;
     uint32_t chunk_size_old = 0, chunk_size_new, chunk_byte_size = 0;
     int num_tables = 0, ser_idx = 0;
     bcmptm_ser_mem_scan_table_info_t *table_info = NULL;
@@ -520,7 +521,6 @@ bcmptm_ser_tcam_scan_thread(void *unit_vp)
     if (tcam_scan_stopped) {
         SHR_RETURN_VAL_EXIT(rv);
     }
-    index_num_not_scanned = BCMPTM_SER_CONTROL_TCAM_ENTRIES_READ_PER_INTERVAL(unit);
     chunk_size_old = BCMPTM_SER_CONTROL_TCAM_SCAN_CHUNK_SIZE(unit);
     chunk_byte_size = chunk_size_old * sizeof(uint32_t) * BCMDRD_MAX_PT_WSIZE;
     /* allocate dma read buffer */
@@ -570,6 +570,7 @@ bcmptm_ser_tcam_scan_thread(void *unit_vp)
         }
         begin_index = table_info->index_min;
         pipe_no = 0;
+        bcmptm_ser_scan_sched_pt_begin(unit, BCMPTM_SER_SCAN_TCAM, mem);
         while(pipe_no < pipe_num) {
             SLICE_MODE_MUTEX_TAKE(slice_mode_mutex);
 
@@ -585,34 +586,30 @@ bcmptm_ser_tcam_scan_thread(void *unit_vp)
                 rv = SHR_E_NONE;
                 SHR_RETURN_VAL_EXIT(rv);
             }
-            index_num_not_scanned -= index_num_scanned;
-            if (index_num_not_scanned <= 0) {
-                /* interval should be more than 1000000, refer to definition of LT SER_CONTROLt */
-                interval = BCMPTM_SER_CONTROL_TCAM_SCAN_INTERVAL(unit);
-                /* Fall asleep */
-                (void)sal_sem_take(scan_info_ptr->tcam_scan_interval, interval);
-                /* wake up */
-                /* update latest data from LT SER_CONTROLt */
-                chunk_size_new = BCMPTM_SER_CONTROL_TCAM_SCAN_CHUNK_SIZE(unit);
-                if (chunk_size_new != chunk_size_old) {
-                    chunk_byte_size = chunk_size_new * sizeof(uint32_t) * BCMDRD_MAX_PT_WSIZE;
-                    /* adjust size of dma read buffer */
-                    bcmptm_ser_tcam_scan_buff_adjust(unit, chunk_byte_size);
-                    buf_paddr = scan_info_ptr->tcam_scan_buf_paddr;
-                    /* Fail to re-allocate DMA read buffer */
-                    if (buf_paddr == 0) {
-                        rv = SHR_E_MEMORY;
-                        SHR_IF_ERR_EXIT(rv);
-                    }
-                    chunk_size_old = chunk_size_new;
-                }
-                index_num_not_scanned = BCMPTM_SER_CONTROL_TCAM_ENTRIES_READ_PER_INTERVAL(unit);
-                /* Maybe need to exit */
-                tcam_scan_stopped = scan_info_ptr->tcam_scan_stopped;
-                if (tcam_scan_stopped) {
-                    rv = SHR_E_NONE;
-                    SHR_RETURN_VAL_EXIT(rv);
+            bcmptm_ser_scan_sched_charge(unit, BCMPTM_SER_SCAN_TCAM,
+                                         index_num_scanned);
+            /* Yield to WAL traffic, keep budget of LT SER_CONTROLt */
+            (void)bcmptm_ser_scan_sched_wait(unit, BCMPTM_SER_SCAN_TCAM,
+                                             scan_info_ptr->tcam_scan_interval);
+            /* update latest data from LT SER_CONTROLt */
+            chunk_size_new = BCMPTM_SER_CONTROL_TCAM_SCAN_CHUNK_SIZE(unit);
+            if (chunk_size_new != chunk_size_old) {
+                chunk_byte_size = chunk_size_new * sizeof(uint32_t) * BCMDRD_MAX_PT_WSIZE;
+                /* adjust size of dma read buffer */
+                bcmptm_ser_tcam_scan_buff_adjust(unit, chunk_byte_size);
+                buf_paddr = scan_info_ptr->tcam_scan_buf_paddr;
+                /* Fail to re-allocate DMA read buffer */
+                if (buf_paddr == 0) {
+                    rv = SHR_E_MEMORY;
+                    SHR_IF_ERR_EXIT(rv);
                 }
+                chunk_size_old = chunk_size_new;
+            }
+            /* Maybe need to exit */
+            tcam_scan_stopped = scan_info_ptr->tcam_scan_stopped;
+            if (tcam_scan_stopped) {
+                rv = SHR_E_NONE;
+                SHR_RETURN_VAL_EXIT(rv);
             }
             begin_index = begin_index_next;
             if (begin_index > table_info->index_max) {
@@ -620,6 +617,7 @@ bcmptm_ser_tcam_scan_thread(void *unit_vp)
                 begin_index = table_info->index_min;
             }
         }
+        bcmptm_ser_scan_sched_pt_done(unit, BCMPTM_SER_SCAN_TCAM, mem);
     }
 
 exit:
@@ -679,6 +677,10 @@ bcmptm_ser_tcam_scan_start(int unit)
                              " TCAM scan thread is exiting!\n")));
         return SHR_E_NONE;
     }
+    rv = bcmptm_ser_scan_sched_init(unit, BCMPTM_SER_SCAN_TCAM);
+    if (SHR_FAILURE(rv)) {
+        return rv;
+    }
     scan_info->tcam_scan_stopped = FALSE;
     thread_id = sal_thread_create("SER TCAM thread",
                                   SAL_THREAD_STKSZ,
@@ -3215,3 +3215,25 @@ bcmptm_wal_dma_avail(int unit, bool read_op, uint32_t entry_count,
         }
     }
 }
+
+int
+bcmptm_wal_occupancy_get(int unit, uint32_t *msg_count,
+                         uint32_t *msg_max_count, uint32_t *scf_busy_chans)
+{
+    uint32_t avail_msg_count;
+    SHR_FUNC_ENTER(unit);
+    SHR_NULL_CHECK(msg_count, SHR_E_PARAM);
+    SHR_NULL_CHECK(msg_max_count, SHR_E_PARAM);
+    SHR_NULL_CHECK(scf_busy_chans, SHR_E_PARAM);
+    if (!WSTATE_BPTR || !cfg_wal_msg_max_count[unit]) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNAVAIL);
+    }
+    /* Single read - writer and reader update avail_msg_count concurrently */
+    avail_msg_count = WSTATE(avail_msg_count);
+    *msg_max_count = cfg_wal_msg_max_count[unit];
+    *msg_count = (avail_msg_count < *msg_max_count) ?
+                 (*msg_max_count - avail_msg_count) : 0;
+    *scf_busy_chans = bcmptm_walr_scf_busy_chans(unit);
+exit:
+    SHR_FUNC_EXIT();
+}
@@ -206,6 +206,8 @@ static bool walr_has_scf_mutex[BCMDRD_CONFIG_MAX_UNITS];
 static bool serc_needs_scf_mutex[BCMDRD_CONFIG_MAX_UNITS];
 static bool serc_has_scf_mutex[BCMDRD_CONFIG_MAX_UNITS];
 static shr_thread_ctrl_t *walr_tc[BCMDRD_CONFIG_MAX_UNITS];
+/* Num of schanfifo channels holding ops - read by SER scan without locks */
+static volatile uint32_t walr_scf_busy_chans[BCMDRD_CONFIG_MAX_UNITS];
 
 
 /*******************************************************************************
@@ -242,6 +244,21 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+/* Num of schanfifo channels holding ops in cmd_state */
+static uint32_t
+walr_scf_busy_chans_get(cmd_state_t cmd_state)
+{
+    switch (cmd_state) {
+    case CMD_STATE_CH_A_BUSY:
+        return 1; /* busy_ch */
+    case CMD_STATE_CH_A_BUSY_CH_B_WAIT:
+        return 2; /* busy_ch and wait_ch */
+    case CMD_STATE_IDLE:
+    default:
+        return 0;
+    }
+}
+
 static int
 retry_prep(int unit)
 {
@@ -856,9 +873,12 @@ scf_thread_func(shr_thread_ctrl_t *tc, void *arg)
             thread_done = TRUE;
             break; /* unknown cmd_state */
         } /* cmd_state */
+
+        walr_scf_busy_chans[unit] = walr_scf_busy_chans_get(cmd_state);
     } /* while (!thread_done) */
 
     /* Can be here only if we exit while loop */
+    walr_scf_busy_chans[unit] = 0;
     th_info_p->state = SCF_THREAD_STATE_STOP;
     LOG_VERBOSE(BSL_LOG_MODULE,
         (BSL_META_U(unit, "WAL reader thread function exited !!\n")));
@@ -890,6 +910,12 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+uint32_t
+bcmptm_walr_scf_busy_chans(int unit)
+{
+    return walr_scf_busy_chans[unit];
+}
+
 /* Following will execute in SERC context */
 int
 bcmptm_walr_lock_req_serc(int unit)
@@ -137,4 +137,16 @@ bcmptm_walr_run_check(int unit);
 extern int
 bcmptm_walr_wake(int unit);
 
+/*!
+ * \brief Num of schanfifo channels currently holding WAL ops.
+ *
+ * \param [in] unit Logical device ID.
+ *
+ * Returns:
+ * \retval 0 WAL reader is idle or not using schanfifo.
+ * \retval 1, 2 Num of busy or waiting schanfifo channels.
+ */
+extern uint32_t
+bcmptm_walr_scf_busy_chans(int unit);
+
 #endif /* BCMPTM_WALR_LOCAL_H */
@@ -395,7 +395,8 @@ extern int bcmtrm_entry_free(bcmtrm_entry_t *entry);
  * posts the entry request onto a message queue to be processed by a
  * dedicated thread associated with the unit. Once that was done the function
  * blocks until the operation completed and the entry callback (TRM internal
- * function) was called.
+ * function) was called. Interactive and PT entries may be processed directly
+ * on the caller thread (see \ref bcmtrm_inline_sync_set()).
  *
  * \param [in] entry Entry to be processed.
  *
@@ -436,6 +437,57 @@ extern int bcmtrm_interactive_table_init(int unit,
                                          bool warm,
                                          uint32_t max_fields);
 
+/*!
+ * \brief Synchronous interactive entry statistics.
+ */
+typedef struct bcmtrm_sync_stats_s {
+    uint64_t inline_cnt;  /*!< Entries processed on the caller thread  */
+    uint64_t queued_cnt;  /*!< Entries processed by the unit thread    */
+} bcmtrm_sync_stats_t;
+
+/*!
+ * \brief Enable/disable inline processing of synchronous entries.
+ *
+ * When enabled, synchronous interactive and PT entries are processed
+ * directly on the caller thread whenever the interactive thread of the unit
+ * is idle. This avoids the message queue round trip to the interactive
+ * thread and the notification thread. If there are pending elements in the
+ * interactive queue the entry is queued behind them as usual, so the order
+ * of the operations is maintained.
+ *
+ * The initial value of this mode is set from the configuration variable
+ * trm_resources.inline_sync_commit.
+ *
+ * \param [in] unit The unit number.
+ * \param [in] enable Set to true to enable inline processing.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+extern int bcmtrm_inline_sync_set(int unit, bool enable);
+
+/*!
+ * \brief Get inline processing mode of synchronous entries.
+ *
+ * \param [in] unit The unit number.
+ * \param [out] enable Indicates if inline processing is enabled.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+extern int bcmtrm_inline_sync_get(int unit, bool *enable);
+
+/*!
+ * \brief Get synchronous interactive entry statistics.
+ *
+ * \param [in] unit The unit number.
+ * \param [in] clear Clear the statistics after reading them.
+ * \param [out] stats The statistics of the unit.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+extern int bcmtrm_sync_stats_get(int unit,
+                                 bool clear,
+                                 bcmtrm_sync_stats_t *stats);
+
 /*
  * Table callback functions
  */
@@ -462,6 +514,62 @@ extern int bcmtrm_table_event_subscribe(int unit,
                                         bcmlt_table_sub_cb event_func,
                                         void *user_data);
 
+/*!
+ * \brief Add or remove a table from the change feed of a unit.
+ *
+ * Changes of a table that was added are appended to the change feed of
+ * the unit (see \ref bcmtrm_chg_feed_create). This is independent of
+ * the table change callback set by \ref bcmtrm_table_event_subscribe.
+ *
+ * \param [in] unit Indicates the interested unit.
+ * \param [in] table_id Indicates the table of interest.
+ * \param [in] enable Set to add and clear to remove the table.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+extern int bcmtrm_table_feed_set(int unit, uint32_t table_id, bool enable);
+
+/*!
+ * \brief Create the table change feed of a unit.
+ *
+ * The change feed collects change records of the subscribed tables in
+ * a ring and delivers them in batches from a dedicated thread of the
+ * unit. A batch is delivered once it is full or when the oldest record
+ * waited for the configured flush time.
+ *
+ * \param [in] unit Indicates the interested unit.
+ * \param [in] cfg Change feed configuration. Zero ring_size, batch_size
+ * or flush_usecs select the default values.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+extern int bcmtrm_chg_feed_create(int unit,
+                                  const bcmlt_table_chg_feed_cfg_t *cfg);
+
+/*!
+ * \brief Destroy the table change feed of a unit.
+ *
+ * Pending change records are delivered before the function returns.
+ *
+ * \param [in] unit Indicates the interested unit.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+extern int bcmtrm_chg_feed_destroy(int unit);
+
+/*!
+ * \brief Test the coalescing rules of the table change feed.
+ *
+ * This function feeds sequences of changes of several entries through
+ * a private change feed with coalescing enabled and verifies the net
+ * change records. The change feed of the unit is not affected.
+ *
+ * \param [in] unit Unit number used for logging.
+ *
+ * \return SHR_E_NONE if all checks passed and error code otherwise.
+ */
+extern int bcmtrm_chg_feed_coalesce_test(int unit);
+
 /*!
  * \brief Callback to allocate entry.
  *
@@ -98,6 +98,7 @@
 #include <sal/sal_alloc.h>
 #include <sal/sal_assert.h>
 #include <sal/sal_sleep.h>
+#include <sal/sal_spinlock.h>
 #include <sal/sal_thread.h>
 #include <shr/shr_error.h>
 #include <shr/shr_debug.h>
@@ -176,12 +177,26 @@ typedef struct {
     trn_info_t *ha_mem; /* HA memory pointer */
     trn_interact_info_t *inter_ha_mem; /* HA memory for interactive tables */
     uint32_t active_sync_trans; /* Counts the active synchronous transactions */
+    /*
+     * Inline synchronous processing of interactive entries. The inter_mtx
+     * serializes the processing of interactive entries between the
+     * interactive thread and callers that process their synchronous entry
+     * inline. The inter_pending counts the elements that were posted into
+     * the interactive queue and were not yet fully processed. It is
+     * protected by the inter_lock spinlock so posting never blocks on an
+     * ongoing interactive operation.
+     */
+    bool inline_sync;   /* Process sync entries on the caller thread */
+    sal_mutex_t inter_mtx;
+    sal_spinlock_t inter_lock;
+    uint32_t inter_pending;
+    uint32_t inter_op_id;   /* Interactive operation ID */
+    bcmtrm_sync_stats_t sync_stats; /* Synchronous entry statistics */
 } trm_unit_resources_t;
 
 /*
  * Global variables to the TRM module.
  */
-sal_msgq_t bcmtrm_hw_notif_q;
 
 bcmtrm_trans_state_t bcmtrm_trans_ha_state;
 
@@ -226,8 +241,17 @@ static sal_mutex_t sync_obj_free_list_mtx;
  */
 static sal_mutex_t entry_state_mtx;
 
-/* count the number of running notification thread */
-static int notify_thread_running = 0;
+/*
+ * Notification thread control of every unit. It is kept apart from the
+ * unit resources as the thread may outlive a failed unit shutdown.
+ */
+static bcmtrm_notif_ctrl_t notif_ctrl[BCMDRD_CONFIG_MAX_UNITS];
+
+/*
+ * Protects the queue pointer and the poster count of every notification
+ * control, so a queue is not destroyed while it is being posted to.
+ */
+static sal_mutex_t notif_mtx;
 
 /*
  * Keep lists of committed entries and transactions. Since it is a global
@@ -279,6 +303,44 @@ static void queue_drain(sal_msgq_t q)
     }
 }
 
+/*
+ * Post an element into the interactive queue of the unit. The element is
+ * accounted as pending until the interactive thread completes its
+ * processing. Synchronous entries can only bypass the queue when nothing
+ * is pending, which maintains the order of the interactive operations.
+ */
+static int interactive_q_post(trm_unit_resources_t *unit_res,
+                              trans_instruct_t *q_element,
+                              sal_msgq_priority_t pri)
+{
+    int rv;
+
+    sal_spinlock_lock(unit_res->inter_lock);
+    unit_res->inter_pending++;
+    sal_spinlock_unlock(unit_res->inter_lock);
+
+    rv = sal_msgq_post(unit_res->interact_queue,
+                       q_element,
+                       pri,
+                       SAL_MSGQ_FOREVER);
+    if (rv != 0) {
+        sal_spinlock_lock(unit_res->inter_lock);
+        unit_res->inter_pending--;
+        sal_spinlock_unlock(unit_res->inter_lock);
+    }
+    return rv;
+}
+
+/*
+ * Mark an element that was received from the interactive queue as done.
+ */
+static void interactive_q_done(trm_unit_resources_t *unit_res)
+{
+    sal_spinlock_lock(unit_res->inter_lock);
+    unit_res->inter_pending--;
+    sal_spinlock_unlock(unit_res->inter_lock);
+}
+
 sal_mutex_t bcmtrm_unit_mutex_get(int unit)
 {
     return unit_resources[unit].mtx;
@@ -308,17 +370,13 @@ void bcmtrm_q_interactive_entry(bcmtrm_entry_t *entry,
     entry->state = E_COMMITTING;
     q_element.element = (void *)entry;
     q_element.type = ENTRY_OP;
-    sal_msgq_post(unit_resources[unit].interact_queue,
-                  &q_element,
-                  pri,
-                  SAL_MSGQ_FOREVER);
+    interactive_q_post(&unit_resources[unit], &q_element, pri);
 }
 
 static void interactive_unit_thread(void *arg) {
     trm_unit_resources_t *unit_res = (trm_unit_resources_t * )arg;
     trans_instruct_t q_element;
     int rv;
-    uint32_t op_id = 0;
     bool running = true;
 
     while (running) {
@@ -337,24 +395,25 @@ static void interactive_unit_thread(void *arg) {
                          "Failed to receive interactive message rv=%d\n"), rv));
             break;     /* add some log message as this should not happen */
         }
+        sal_mutex_take(unit_res->inter_mtx, SAL_MUTEX_FOREVER);
         switch (q_element.type) {
         case ENTRY_OP:
             bcmtrm_process_interactive_entry_req(
                                 (bcmtrm_entry_t *)q_element.element,
-                                op_id,
+                                unit_res->inter_op_id,
                                 unit_res->inter_ha_mem);
             bcmtrm_entry_complete((bcmtrm_entry_t *)q_element.element);
             break;
         case TRANSACTION_OP:
             rv = bcmtrm_handle_interactive_transaction(
                                     (bcmtrm_trans_t * )q_element.element,
-                                    &op_id,
+                                    &unit_res->inter_op_id,
                                     unit_res->inter_ha_mem);
             if (rv != SHR_E_NONE) {
                 LOG_WARN(BSL_LOG_MODULE,
                          (BSL_META_U(unit_res->unit,
                                      "Inter trans failed op_id=%d error=%d\n"),
-                          op_id, rv));
+                          unit_res->inter_op_id, rv));
             }
             bcmtrm_trans_complete((bcmtrm_trans_t *)q_element.element);
             break;
@@ -365,6 +424,8 @@ static void interactive_unit_thread(void *arg) {
             running = false;
             break;
         }
+        sal_mutex_give(unit_res->inter_mtx);
+        interactive_q_done(unit_res);
     }
     sal_mutex_take(unit_res->mtx, SAL_MUTEX_FOREVER);
     unit_res->thread_stopped++;
@@ -786,10 +847,7 @@ int bcmtrm_stop(int unit, bool graceful)
     if (0 != rc) {
         return SHR_E_INTERNAL;
     }
-    rc = sal_msgq_post(unit_res->interact_queue,
-                       &q_element,
-                       pri,
-                       SAL_MSGQ_FOREVER);
+    rc = interactive_q_post(unit_res, &q_element, pri);
     if (0 != rc) {
         return SHR_E_INTERNAL;
     }
@@ -915,6 +973,13 @@ int bcmtrm_init(void)
         if (rv != 0) {
             SHR_RETURN_VAL_EXIT(SHR_E_MEMORY);
         }
+        /*
+         * Transactions and entries are allocated by the application
+         * threads and freed by the notification thread. Use thread caches
+         * to avoid contention on the pool lock. The thread cache is an
+         * optimization, so failure is not fatal.
+         */
+        (void)shr_lmm_cache_enable(trans_mem_hdl, 0, 0);
     }
 
     if (!entry_mem_hdl) {
@@ -933,6 +998,7 @@ int bcmtrm_init(void)
         if (rv != 0) {
             SHR_RETURN_VAL_EXIT(SHR_E_MEMORY);
         }
+        (void)shr_lmm_cache_enable(entry_mem_hdl, 0, 0);
     }
 
     if (!ltm_prot_obj_hdl) {
@@ -949,26 +1015,15 @@ int bcmtrm_init(void)
     active_trans_mutex = sal_mutex_create("trnActTrans");
     sync_obj_free_list_mtx = sal_mutex_create("trnSyncObjList");
     entry_state_mtx = sal_mutex_create("trnEntryStateMtx");
+    if (!notif_mtx) {
+        notif_mtx = sal_mutex_create("trnNotif");
+        SHR_NULL_CHECK(notif_mtx, SHR_E_MEMORY);
+    }
 
     active_entry_list = NULL;
     active_trans_list = NULL;
 
     bcmevm_register_cb(bcmtrm_sb_table_notify);
-    if (1 /*internal_thread_mode*/) {
-        sal_thread_t t_hdl;
-        bcmtrm_hw_notif_q = sal_msgq_create(sizeof(bcmtrm_hw_notif_struct_t),
-                                    MAX_PENDING_TRANSACTIONS,
-                                    "");
-
-        t_hdl = sal_thread_create("",
-                                  2 * SAL_THREAD_STKSZ,
-                                  50,
-                                  bcmtrm_notify_thread,
-                                  &notify_thread_running);
-        if (!t_hdl) {
-            SHR_RETURN_VAL_EXIT(SHR_E_MEMORY);
-        }
-    }
 
     feature_conf = bcmcfg_feature_ctl_config_get();
     if (feature_conf == NULL || feature_conf->dis_stomic_trans == 0) {
@@ -990,8 +1045,6 @@ exit:
 
 int bcmtrm_delete()
 {
-    bcmtrm_hw_notif_struct_t hw_notif;
-    int rc;
     int j;
 
     SHR_FUNC_ENTER(BSL_UNIT_UNKNOWN);
@@ -1006,28 +1059,6 @@ int bcmtrm_delete()
         SHR_RETURN_VAL_EXIT(SHR_E_BUSY);
     }
 
-    hw_notif.type = NOTIF_EXIT;
-    rc = sal_msgq_post(bcmtrm_hw_notif_q,
-                       &hw_notif,
-                       SAL_MSGQ_HIGH_PRIORITY,
-                       SAL_MSGQ_FOREVER);
-    if (0 != rc) {
-        SHR_RETURN_VAL_EXIT(SHR_E_INTERNAL);
-    }
-    /* Wait for the threads to exit */
-    for (j = 0; j < 1000; j++) {
-        if (!notify_thread_running) {
-            break;
-        }
-        sal_usleep(1000);
-    }
-    if (j >= 1000) {
-        LOG_WARN(BSL_LOG_MODULE,
-                 (BSL_META("Notify thread failed to exit\n")));
-    } else {
-        sal_msgq_destroy(bcmtrm_hw_notif_q);
-    }
-
     if (ltm_sync_hdl) {
         /* Free all the semaphores from the free list */
         while (sync_obj_free_list) {
@@ -1072,17 +1103,159 @@ int bcmtrm_delete()
         sal_mutex_destroy(entry_state_mtx);
         entry_state_mtx = NULL;
     }
+    if (notif_mtx) {
+        sal_mutex_destroy(notif_mtx);
+        notif_mtx = NULL;
+    }
 
 exit:
     SHR_FUNC_EXIT();
 }
 
+/*
+ * Start the notification thread of a unit. Completions and table change
+ * events of the unit are processed by this thread, so a busy unit does
+ * not delay the notifications of other units.
+ */
+static int notify_thread_start(int unit)
+{
+    bcmtrm_notif_ctrl_t *ctrl = &notif_ctrl[unit];
+    sal_thread_t t_hdl;
+
+    if (ctrl->running || ctrl->rx_queue) {
+        return SHR_E_BUSY;
+    }
+    ctrl->rx_queue = sal_msgq_create(sizeof(bcmtrm_hw_notif_struct_t),
+                                     MAX_PENDING_TRANSACTIONS,
+                                     "");
+    if (!ctrl->rx_queue) {
+        return SHR_E_MEMORY;
+    }
+    /* Mark as running before the thread starts to avoid a stop race */
+    ctrl->running = 1;
+    t_hdl = sal_thread_create("",
+                              2 * SAL_THREAD_STKSZ,
+                              50,
+                              bcmtrm_notify_thread,
+                              ctrl);
+    if (!t_hdl) {
+        ctrl->running = 0;
+        sal_msgq_destroy(ctrl->rx_queue);
+        ctrl->rx_queue = NULL;
+        return SHR_E_MEMORY;
+    }
+    /* Accept posts only once the thread is there to receive them. */
+    sal_mutex_take(notif_mtx, SAL_MUTEX_FOREVER);
+    ctrl->queue = ctrl->rx_queue;
+    sal_mutex_give(notif_mtx);
+    return SHR_E_NONE;
+}
+
+/*
+ * Stop the notification thread of a unit. New posts are turned away
+ * first, and the posts in progress are drained by the thread. The exit
+ * request is then queued behind the pending notifications so they are
+ * all processed before the queue is destroyed.
+ */
+static void notify_thread_stop(int unit)
+{
+    bcmtrm_notif_ctrl_t *ctrl = &notif_ctrl[unit];
+    bcmtrm_hw_notif_struct_t hw_notif;
+    int posters;
+    int j;
+
+    if (!ctrl->rx_queue) {
+        return;
+    }
+    sal_mutex_take(notif_mtx, SAL_MUTEX_FOREVER);
+    ctrl->queue = NULL;
+    posters = ctrl->posters;
+    sal_mutex_give(notif_mtx);
+
+    /* Wait for the posters that still hold the queue */
+    while (posters > 0) {
+        sal_usleep(1000);
+        sal_mutex_take(notif_mtx, SAL_MUTEX_FOREVER);
+        posters = ctrl->posters;
+        sal_mutex_give(notif_mtx);
+    }
+
+    if (ctrl->running) {
+        hw_notif.type = NOTIF_EXIT;
+        if (sal_msgq_post(ctrl->rx_queue,
+                          &hw_notif,
+                          SAL_MSGQ_NORMAL_PRIORITY,
+                          SAL_MSGQ_FOREVER) != 0) {
+            LOG_WARN(BSL_LOG_MODULE,
+                     (BSL_META_U(unit, "Failed to stop notify thread\n")));
+            return;
+        }
+        /* Wait for the thread to exit */
+        for (j = 0; j < 1000; j++) {
+            if (!ctrl->running) {
+                break;
+            }
+            sal_usleep(1000);
+        }
+        if (j >= 1000) {
+            LOG_WARN(BSL_LOG_MODULE,
+                     (BSL_META_U(unit, "Notify thread failed to exit\n")));
+            return;
+        }
+    }
+    sal_msgq_destroy(ctrl->rx_queue);
+    ctrl->rx_queue = NULL;
+}
+
+int bcmtrm_hw_notif_post(int unit,
+                         bcmtrm_hw_notif_struct_t *hw_notif,
+                         sal_msgq_priority_t pri)
+{
+    sal_msgq_t queue;
+    int rv = SHR_E_NONE;
+
+    if (unit < 0 || unit >= BCMDRD_CONFIG_MAX_UNITS) {
+        return SHR_E_UNIT;
+    }
+    queue = NULL;
+    if (notif_mtx) {
+        sal_mutex_take(notif_mtx, SAL_MUTEX_FOREVER);
+        queue = notif_ctrl[unit].queue;
+        if (queue) {
+            notif_ctrl[unit].posters++;
+        }
+        sal_mutex_give(notif_mtx);
+    }
+    if (!queue) {
+        rv = SHR_E_INIT;
+    } else {
+        /* The queue is not destroyed while this post holds it. */
+        if (sal_msgq_post(queue, hw_notif, pri, SAL_MSGQ_FOREVER) != 0) {
+            rv = SHR_E_INTERNAL;
+        }
+        sal_mutex_take(notif_mtx, SAL_MUTEX_FOREVER);
+        notif_ctrl[unit].posters--;
+        sal_mutex_give(notif_mtx);
+    }
+    if (SHR_FAILURE(rv) &&
+        (hw_notif->type == ENTRY_CB || hw_notif->type == TRANS_CB)) {
+        /*
+         * Completions must not be lost, as synchronous callers wait for
+         * them. Complete them in the caller context instead.
+         */
+        bcmtrm_hw_notif_process(hw_notif);
+        rv = SHR_E_NONE;
+    }
+    return rv;
+}
+
 int bcmtrm_unit_init(int unit, bool warm)
 {
     sal_thread_t t_hdl;
     trm_unit_resources_t *unit_res = NULL;
     trn_info_t *ha_mem = NULL;
     uint32_t ha_blk_len;
+    const bcmcfg_trm_resources_config_t *trm_conf;
 
     SHR_FUNC_ENTER(BSL_UNIT_UNKNOWN);
 
@@ -1123,11 +1296,23 @@ int bcmtrm_unit_init(int unit, bool warm)
     unit_res->mtx = sal_mutex_create("trmUnit");
     SHR_NULL_CHECK(unit_res->mtx, SHR_E_MEMORY);
 
+    unit_res->inter_mtx = sal_mutex_create("trmUnitInter");
+    SHR_NULL_CHECK(unit_res->inter_mtx, SHR_E_MEMORY);
+
+    unit_res->inter_lock = sal_spinlock_create("trmUnitInterPend");
+    SHR_NULL_CHECK(unit_res->inter_lock, SHR_E_MEMORY);
+
+    trm_conf = bcmcfg_trm_resources_config_get();
+    if (trm_conf && trm_conf->inline_sync_commit) {
+        unit_res->inline_sync = true;
+    }
+
     unit_res->unit = unit;
     unit_res->initialized = true;
     unit_res->terminate = false;
     unit_res->stop_api = false;
     INIT_OP_ID(unit_res->trans_id, unit, false);
+    unit_res->inter_op_id = 0;
 
     t_hdl = sal_thread_create("",
                               2 * SAL_THREAD_STKSZ,
@@ -1143,8 +1328,12 @@ int bcmtrm_unit_init(int unit, bool warm)
                                 (void *)unit_res);
     SHR_NULL_CHECK(t_hdl, SHR_E_MEMORY);
 
+    SHR_IF_ERR_EXIT(notify_thread_start(unit));
+
     SHR_IF_ERR_EXIT(bcmtrm_table_event_alloc(unit));
 
+    SHR_IF_ERR_EXIT(bcmtrm_chg_feed_unit_init(unit));
+
 exit:
     if (SHR_FUNC_ERR() && unit_res) {
         unit_res->initialized = true;
@@ -1171,6 +1360,9 @@ int bcmtrm_unit_delete(int unit)
         return SHR_E_INIT;
     }
 
+    /* Process the pending notifications before cleaning up */
+    notify_thread_stop(unit);
+
     /* Clean existing API resources */
     bcmtrm_clean_uncommitted(unit);
 
@@ -1184,6 +1376,12 @@ int bcmtrm_unit_delete(int unit)
     if (unit_res->mtx) {
         sal_mutex_destroy(unit_res->mtx);
     }
+    if (unit_res->inter_mtx) {
+        sal_mutex_destroy(unit_res->inter_mtx);
+    }
+    if (unit_res->inter_lock) {
+        sal_spinlock_destroy(unit_res->inter_lock);
+    }
 
     if (unit_res->ha_mem && unit_res->ha_mem->sync_obj) {
         sal_mutex_destroy(unit_res->ha_mem->sync_obj);
@@ -1192,6 +1390,8 @@ int bcmtrm_unit_delete(int unit)
 
     sal_memset(unit_res, 0, sizeof(*unit_res));
 
+    bcmtrm_chg_feed_unit_cleanup(unit);
+
     bcmtrm_table_event_free(unit);
 
 exit:
@@ -1328,10 +1528,7 @@ int bcmtrm_asynch_trans_req(bcmtrm_trans_t *trans)
     trans->commit_success = 0;
 
     if (trans->pt_trans) {
-        rc = sal_msgq_post(unit_resources[trans->unit].interact_queue,
-                           &q_element,
-                           pri,
-                           SAL_MSGQ_FOREVER);
+        rc = interactive_q_post(&unit_resources[trans->unit], &q_element, pri);
     } else {
         rc = sal_msgq_post(unit_resources[trans->unit].model_queue,
                            &q_element,
@@ -1393,10 +1590,7 @@ int bcmtrm_trans_req(bcmtrm_trans_t *trans)
         */
         q_element.element = (void *)trans;
         q_element.type = TRANSACTION_OP;
-        rc = sal_msgq_post(unit_res->interact_queue,
-                           &q_element,
-                           pri,
-                           SAL_MSGQ_FOREVER);
+        rc = interactive_q_post(unit_res, &q_element, pri);
     } else {
         rc = bcmtrm_handle_transaction(trans,
                                        &unit_res->op_id,
@@ -1579,10 +1773,9 @@ int bcmtrm_asynch_entry_req(bcmtrm_entry_t *entry)
                          entry->info.table_name,
                          bcmtrm_ltopcode_to_str(entry->opcode.lt_opcode)));
         }
-        rc = sal_msgq_post(unit_resources[entry->info.unit].interact_queue,
-                           &q_element,
-                           pri,
-                           SAL_MSGQ_FOREVER);
+        rc = interactive_q_post(&unit_resources[entry->info.unit],
+                                &q_element,
+                                pri);
     } else {
         LOG_VERBOSE(BSL_LOG_MODULE,
                     (BSL_META_U(entry->info.unit,
@@ -1714,18 +1907,51 @@ static int interactive_entry_req(bcmtrm_entry_t *entry,
 
     q_element.element = (void *)entry;
     q_element.type = ENTRY_OP;
-    rc = sal_msgq_post(unit_res->interact_queue,
-                       &q_element,
-                       pri,
-                       SAL_MSGQ_FOREVER);
+    rc = interactive_q_post(unit_res, &q_element, pri);
     return (rc == 0 ? SHR_E_NONE : SHR_E_INTERNAL);
 }
 
+/*
+ * Process synchronous interactive entry on the caller thread. This is only
+ * possible when the interactive thread of the unit is idle, that is, when
+ * there are no pending elements in the interactive queue. Otherwise, the
+ * entry has to be queued behind the pending elements to maintain the order
+ * of the operations.
+ * The function returns true if the entry was processed. In this case the
+ * entry status and output fields are ready upon return.
+ */
+static bool interactive_entry_inline(bcmtrm_entry_t *entry,
+                                     trm_unit_resources_t *unit_res)
+{
+    bool idle;
+
+    sal_mutex_take(unit_res->inter_mtx, SAL_MUTEX_FOREVER);
+    sal_spinlock_lock(unit_res->inter_lock);
+    idle = (unit_res->inter_pending == 0);
+    if (idle) {
+        unit_res->sync_stats.inline_cnt++;
+    } else {
+        unit_res->sync_stats.queued_cnt++;
+    }
+    sal_spinlock_unlock(unit_res->inter_lock);
+    if (!idle) {
+        sal_mutex_give(unit_res->inter_mtx);
+        return false;
+    }
+
+    bcmtrm_inline_interactive_entry_req(entry,
+                                        unit_res->inter_op_id,
+                                        unit_res->inter_ha_mem);
+    sal_mutex_give(unit_res->inter_mtx);
+    return true;
+}
+
 int bcmtrm_entry_req(bcmtrm_entry_t *entry)
 {
     int rv;
-    trm_sync_object_t *sync_obj;
+    trm_sync_object_t *sync_obj = NULL;
     trm_unit_resources_t *unit_res = &unit_resources[entry->info.unit];
+    bool inline_done = false;
 
     if (unit_res->stop_api) {
         return SHR_E_UNAVAIL;
@@ -1734,11 +1960,6 @@ int bcmtrm_entry_req(bcmtrm_entry_t *entry)
     entry->asynch = false;
     entry->state = E_COMMITTING;
 
-    sync_obj = sync_obj_alloc();
-    if (!sync_obj) {
-        return SHR_E_MEMORY;
-    }
-
     /* Increment the synchronous counter */
     sal_mutex_take(unit_res->mtx, SAL_SEM_FOREVER);
     unit_res->active_sync_trans++;
@@ -1753,6 +1974,30 @@ int bcmtrm_entry_req(bcmtrm_entry_t *entry)
                          entry->info.table_name,
                          bcmtrm_ltopcode_to_str(entry->opcode.lt_opcode)));
         }
+        if (unit_res->inline_sync) {
+            inline_done = interactive_entry_inline(entry, unit_res);
+        }
+    }
+
+    if (!inline_done) {
+        sync_obj = sync_obj_alloc();
+        if (!sync_obj) {
+            sal_mutex_take(unit_res->mtx, SAL_SEM_FOREVER);
+            unit_res->active_sync_trans--;
+            sal_mutex_give(unit_res->mtx);
+            entry->state = E_ACTIVE;
+            return SHR_E_MEMORY;
+        }
+    }
+
+    if (inline_done) {
+        rv = SHR_E_NONE;
+    } else if (entry->interactive || entry->pt) {
+        if (!unit_res->inline_sync) {
+            sal_spinlock_lock(unit_res->inter_lock);
+            unit_res->sync_stats.queued_cnt++;
+            sal_spinlock_unlock(unit_res->inter_lock);
+        }
         rv = interactive_entry_req(entry, sync_obj, unit_res);
     } else {
         entry->cb.entry_cb = entry_sync_lt_comp;
@@ -1770,7 +2015,7 @@ int bcmtrm_entry_req(bcmtrm_entry_t *entry)
         sal_mutex_give(unit_res->mtx);
     }
 
-    if (rv == SHR_E_NONE) {
+    if (rv == SHR_E_NONE && !inline_done) {
         sal_sem_take(sync_obj->sem, SAL_SEM_FOREVER);
     }
 
@@ -1779,13 +2024,15 @@ int bcmtrm_entry_req(bcmtrm_entry_t *entry)
     sal_mutex_give(unit_res->mtx);
 
     /* Clean up */
-    sync_obj_free(sync_obj);
+    if (sync_obj) {
+        sync_obj_free(sync_obj);
+    }
     entry->cb.entry_cb = NULL;
     entry->usr_data = NULL;
 
     /*
      * Interactive entries will be processed via the interactive and
-     * notification threads.
+     * notification threads or had been processed inline.
      */
     if (!entry->interactive && !entry->pt) {
         if (entry->ltm_entry) {
@@ -1802,5 +2049,58 @@ int bcmtrm_entry_req(bcmtrm_entry_t *entry)
     return SHR_E_NONE;
 }
 
+int bcmtrm_inline_sync_set(int unit, bool enable)
+{
+    trm_unit_resources_t *unit_res;
+
+    if (unit < 0 || unit >= BCMDRD_CONFIG_MAX_UNITS) {
+        return SHR_E_UNIT;
+    }
+    unit_res = &unit_resources[unit];
+    if (!unit_res->initialized) {
+        return SHR_E_INIT;
+    }
+    unit_res->inline_sync = enable;
+    return SHR_E_NONE;
+}
+
+int bcmtrm_inline_sync_get(int unit, bool *enable)
+{
+    trm_unit_resources_t *unit_res;
 
+    if (unit < 0 || unit >= BCMDRD_CONFIG_MAX_UNITS) {
+        return SHR_E_UNIT;
+    }
+    if (!enable) {
+        return SHR_E_PARAM;
+    }
+    unit_res = &unit_resources[unit];
+    if (!unit_res->initialized) {
+        return SHR_E_INIT;
+    }
+    *enable = unit_res->inline_sync;
+    return SHR_E_NONE;
+}
 
+int bcmtrm_sync_stats_get(int unit, bool clear, bcmtrm_sync_stats_t *stats)
+{
+    trm_unit_resources_t *unit_res;
+
+    if (unit < 0 || unit >= BCMDRD_CONFIG_MAX_UNITS) {
+        return SHR_E_UNIT;
+    }
+    if (!stats) {
+        return SHR_E_PARAM;
+    }
+    unit_res = &unit_resources[unit];
+    if (!unit_res->initialized) {
+        return SHR_E_INIT;
+    }
+    sal_spinlock_lock(unit_res->inter_lock);
+    *stats = unit_res->sync_stats;
+    if (clear) {
+        sal_memset(&unit_res->sync_stats, 0, sizeof(unit_res->sync_stats));
+    }
+    sal_spinlock_unlock(unit_res->inter_lock);
+    return SHR_E_NONE;
+}
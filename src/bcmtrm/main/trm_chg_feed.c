@@ -0,0 +1,660 @@
+/*! \file trm_chg_feed.c
+ *
+ * This module implements the batched table change feed. Change records
+ * of the subscribed tables are collected in a per-unit ring and delivered
+ * to the application in batches from a per-unit feed thread.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+#include <sal/sal_types.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_spinlock.h>
+#include <bsl/bsl.h>
+#include <shr/shr_error.h>
+#include <shr/shr_debug.h>
+#include <shr/shr_thread.h>
+#include <bcmdrd_config.h>
+#include <bcmlrd/bcmlrd_table.h>
+#include <bcmtrm/trm_api.h>
+#include "trm_internal.h"
+
+#define BSL_LOG_MODULE BSL_LS_BCMTRM_ENTRY
+
+/* Default number of records in the change feed ring. */
+#define CHG_FEED_RING_SIZE_DEFAULT      4096
+
+/* Default number of records per batch. */
+#define CHG_FEED_BATCH_SIZE_DEFAULT     256
+
+/* Default maximal delivery delay of a record. */
+#define CHG_FEED_FLUSH_USECS_DEFAULT    10000
+
+/* Time to wait for the feed thread to deliver the last batches. */
+#define CHG_FEED_STOP_USECS             2000000
+
+/*
+ * The change feed of a unit.
+ *
+ * The ring is a bounded FIFO of change records, indexed by free running
+ * head and tail counters. Producers (the threads that complete table
+ * operations) append records at the tail and the feed thread removes
+ * batches of records from the head. Both sides hold the unit feed lock
+ * only to copy records in or out of the ring.
+ *
+ * If coalescing is enabled, the coalescing index maps the hash of a
+ * record key to the ring position of the last record with this hash.
+ * A new change of an entry which still has a record in the ring (i.e.
+ * between head and tail) is merged into that record. The index is not
+ * cleaned up when records leave the ring, as stale positions are
+ * detected by the ring range check and the key comparison.
+ */
+typedef struct chg_feed_s {
+    int unit;
+    bcmlt_table_chg_feed_cfg_t cfg;
+    sal_spinlock_t lock;
+    bcmlt_table_chg_rec_t *ring;
+    uint32_t ring_mask;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t *coal;
+    uint32_t coal_mask;
+    uint32_t dropped;
+    bcmlt_table_chg_rec_t *batch;
+    shr_thread_ctrl_t *tc;
+} chg_feed_t;
+
+/* Protects the change feed pointer and the ring of each unit. */
+static sal_spinlock_t feed_lock[BCMDRD_CONFIG_MAX_UNITS];
+
+static chg_feed_t *chg_feed[BCMDRD_CONFIG_MAX_UNITS];
+
+/*******************************************************************************
+ * Private functions
+ */
+
+static uint32_t chg_rec_hash(const bcmlt_table_chg_rec_t *rec)
+{
+    uint32_t hval = 2166136261U ^ rec->table_id;
+    uint32_t j;
+
+    hval *= 16777619U;
+    for (j = 0; j < rec->num_keys; j++) {
+        hval = (hval ^ rec->key[j].fid) * 16777619U;
+        hval = (hval ^ rec->key[j].idx) * 16777619U;
+        hval = (hval ^ (uint32_t)rec->key[j].data) * 16777619U;
+        hval = (hval ^ (uint32_t)(rec->key[j].data >> 32)) * 16777619U;
+    }
+    return hval;
+}
+
+static bool chg_rec_key_eq(const bcmlt_table_chg_rec_t *a,
+                           const bcmlt_table_chg_rec_t *b)
+{
+    uint32_t j;
+
+    if (a->table_id != b->table_id || a->num_keys != b->num_keys ||
+        (a->flags & BCMLT_TABLE_CHG_F_KEYS_PARTIAL)) {
+        return false;
+    }
+    for (j = 0; j < a->num_keys; j++) {
+        if (a->key[j].fid != b->key[j].fid ||
+            a->key[j].idx != b->key[j].idx ||
+            a->key[j].data != b->key[j].data) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Merge a new change of an entry into its pending change record. The
+ * resulting opcode describes the net change since the last delivery.
+ * An entry which was inserted and deleted again has no net change, which
+ * is indicated by BCMLT_OPCODE_NOP. Such records are not delivered.
+ */
+static bcmlt_opcode_t chg_opcode_merge(bcmlt_opcode_t prev,
+                                       bcmlt_opcode_t cur)
+{
+    if (prev == BCMLT_OPCODE_INSERT && cur == BCMLT_OPCODE_UPDATE) {
+        return BCMLT_OPCODE_INSERT;
+    }
+    if (prev == BCMLT_OPCODE_INSERT && cur == BCMLT_OPCODE_DELETE) {
+        return BCMLT_OPCODE_NOP;
+    }
+    if (prev == BCMLT_OPCODE_DELETE && cur == BCMLT_OPCODE_INSERT) {
+        return BCMLT_OPCODE_UPDATE;
+    }
+    return cur;
+}
+
+/*
+ * Build the change record of an entry. The key fields are stored in
+ * field ID order, so the same entry always yields the same record.
+ */
+static void chg_rec_build(bcmtrm_entry_t *entry, bcmlt_table_chg_rec_t *rec)
+{
+    const bcmlrd_table_rep_t *tbl;
+    shr_fmm_t *fld;
+    bcmlt_table_chg_key_t key;
+    uint32_t j;
+
+    rec->table_id = entry->table_id;
+    rec->opcode = entry->opcode.lt_opcode;
+    rec->flags = 0;
+    rec->coalesced = 0;
+    rec->num_keys = 0;
+
+    tbl = bcmlrd_table_get(entry->table_id);
+    if (!tbl) {
+        return;
+    }
+    for (fld = entry->l_field; fld; fld = fld->next) {
+        if (fld->id >= tbl->fields ||
+            !(tbl->field[fld->id].flags & BCMLRD_FIELD_F_KEY)) {
+            continue;
+        }
+        key.fid = fld->id;
+        key.idx = fld->idx;
+        key.data = fld->data;
+        /* Insertion sort by (fid, idx) */
+        j = rec->num_keys;
+        while (j > 0 &&
+               (rec->key[j - 1].fid > key.fid ||
+                (rec->key[j - 1].fid == key.fid &&
+                 rec->key[j - 1].idx > key.idx))) {
+            if (j < BCMLT_TABLE_CHG_KEYS_MAX) {
+                rec->key[j] = rec->key[j - 1];
+            }
+            j--;
+        }
+        if (j < BCMLT_TABLE_CHG_KEYS_MAX) {
+            rec->key[j] = key;
+        }
+        if (rec->num_keys < BCMLT_TABLE_CHG_KEYS_MAX) {
+            rec->num_keys++;
+        } else {
+            rec->flags |= BCMLT_TABLE_CHG_F_KEYS_PARTIAL;
+        }
+    }
+}
+
+/*
+ * Move up to one batch of records from the ring into the batch buffer.
+ * Returns the number of records removed from the ring. The records that
+ * were cancelled by coalescing are not copied to the batch buffer, so
+ * num_recs may be smaller.
+ */
+static uint32_t chg_feed_fetch(chg_feed_t *feed, uint32_t *num_recs,
+                               uint32_t *dropped)
+{
+    uint32_t num, first, pos, j, n;
+
+    sal_spinlock_lock(feed->lock);
+    num = feed->tail - feed->head;
+    if (num > feed->cfg.batch_size) {
+        num = feed->cfg.batch_size;
+    }
+    pos = feed->head & feed->ring_mask;
+    first = feed->ring_mask + 1 - pos;
+    if (first > num) {
+        first = num;
+    }
+    sal_memcpy(feed->batch, &feed->ring[pos], first * sizeof(*feed->batch));
+    sal_memcpy(&feed->batch[first], feed->ring,
+               (num - first) * sizeof(*feed->batch));
+    feed->head += num;
+    *dropped = feed->dropped;
+    feed->dropped = 0;
+    sal_spinlock_unlock(feed->lock);
+
+    for (j = 0, n = 0; j < num; j++) {
+        if (feed->batch[j].opcode == BCMLT_OPCODE_NOP) {
+            continue;
+        }
+        if (n != j) {
+            feed->batch[n] = feed->batch[j];
+        }
+        n++;
+    }
+    *num_recs = n;
+
+    return num;
+}
+
+static void chg_feed_thread(shr_thread_ctrl_t *tc, void *arg)
+{
+    chg_feed_t *feed = (chg_feed_t *)arg;
+    uint32_t taken, num, dropped;
+    bool stopping;
+
+    while (1) {
+        shr_thread_sleep(tc, feed->cfg.flush_usecs);
+        stopping = shr_thread_stopping(tc);
+        do {
+            taken = chg_feed_fetch(feed, &num, &dropped);
+            if (num > 0 || dropped > 0) {
+                feed->cfg.cb(feed->unit, feed->batch, num, dropped,
+                             feed->cfg.user_data);
+            }
+        } while (taken == feed->cfg.batch_size);
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+static void chg_feed_free(chg_feed_t *feed)
+{
+    if (feed->ring) {
+        sal_free(feed->ring);
+    }
+    if (feed->coal) {
+        sal_free(feed->coal);
+    }
+    if (feed->batch) {
+        sal_free(feed->batch);
+    }
+    sal_free(feed);
+}
+
+/*
+ * Add a change record to the ring of a feed, or merge it into the
+ * pending record of the same entry. The caller must hold the feed lock.
+ */
+static void chg_feed_rec_add(chg_feed_t *feed,
+                             const bcmlt_table_chg_rec_t *rec)
+{
+    bcmlt_table_chg_rec_t *pend;
+    uint32_t hidx = 0, pos;
+
+    if (feed->coal) {
+        hidx = chg_rec_hash(rec) & feed->coal_mask;
+        pos = feed->coal[hidx];
+        if (pos - feed->head < feed->tail - feed->head) {
+            pend = &feed->ring[pos & feed->ring_mask];
+            if (chg_rec_key_eq(pend, rec)) {
+                pend->opcode = chg_opcode_merge(pend->opcode, rec->opcode);
+                pend->coalesced++;
+                return;
+            }
+        }
+    }
+    if (feed->tail - feed->head > feed->ring_mask) {
+        /* Ring is full */
+        feed->dropped++;
+    } else {
+        feed->ring[feed->tail & feed->ring_mask] = *rec;
+        if (feed->coal) {
+            feed->coal[hidx] = feed->tail;
+        }
+        feed->tail++;
+        if (feed->tc && feed->tail - feed->head == feed->cfg.batch_size) {
+            /* A full batch is ready, no need to wait for the timer */
+            shr_thread_wake(feed->tc);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Internal functions
+ */
+
+void bcmtrm_chg_feed_push(bcmtrm_entry_t *entry)
+{
+    int unit = entry->info.unit;
+    bcmlt_table_chg_rec_t rec;
+
+    if (!feed_lock[unit]) {
+        return;
+    }
+
+    chg_rec_build(entry, &rec);
+
+    sal_spinlock_lock(feed_lock[unit]);
+    if (chg_feed[unit]) {
+        chg_feed_rec_add(chg_feed[unit], &rec);
+    }
+    sal_spinlock_unlock(feed_lock[unit]);
+}
+
+int bcmtrm_chg_feed_unit_init(int unit)
+{
+    if (!feed_lock[unit]) {
+        feed_lock[unit] = sal_spinlock_create("trmChgFeed");
+        if (!feed_lock[unit]) {
+            return SHR_E_MEMORY;
+        }
+    }
+    return SHR_E_NONE;
+}
+
+void bcmtrm_chg_feed_unit_cleanup(int unit)
+{
+    if (feed_lock[unit]) {
+        bcmtrm_chg_feed_destroy(unit);
+        sal_spinlock_destroy(feed_lock[unit]);
+        feed_lock[unit] = NULL;
+    }
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int bcmtrm_chg_feed_create(int unit, const bcmlt_table_chg_feed_cfg_t *cfg)
+{
+    chg_feed_t *feed = NULL;
+    uint32_t ring_size;
+    size_t size;
+
+    SHR_FUNC_ENTER(unit);
+
+    if (unit < 0 || unit >= BCMDRD_CONFIG_MAX_UNITS) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNIT);
+    }
+    if (!feed_lock[unit]) {
+        SHR_RETURN_VAL_EXIT(SHR_E_INIT);
+    }
+    SHR_NULL_CHECK(cfg, SHR_E_PARAM);
+    SHR_NULL_CHECK(cfg->cb, SHR_E_PARAM);
+    if (chg_feed[unit]) {
+        SHR_RETURN_VAL_EXIT(SHR_E_EXISTS);
+    }
+
+    SHR_ALLOC(feed, sizeof(*feed), "bcmtrmChgFeed");
+    SHR_NULL_CHECK(feed, SHR_E_MEMORY);
+    sal_memset(feed, 0, sizeof(*feed));
+    feed->unit = unit;
+    feed->cfg = *cfg;
+    feed->lock = feed_lock[unit];
+
+    ring_size = cfg->ring_size ? cfg->ring_size : CHG_FEED_RING_SIZE_DEFAULT;
+    if (ring_size > 0x40000000) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+    feed->ring_mask = 1;
+    while (feed->ring_mask < ring_size) {
+        feed->ring_mask <<= 1;
+    }
+    ring_size = feed->ring_mask;
+    feed->ring_mask--;
+
+    if (feed->cfg.batch_size == 0) {
+        feed->cfg.batch_size = CHG_FEED_BATCH_SIZE_DEFAULT;
+    }
+    if (feed->cfg.batch_size > ring_size) {
+        feed->cfg.batch_size = ring_size;
+    }
+    if (feed->cfg.flush_usecs == 0) {
+        feed->cfg.flush_usecs = CHG_FEED_FLUSH_USECS_DEFAULT;
+    }
+
+    size = ring_size * sizeof(bcmlt_table_chg_rec_t);
+    SHR_ALLOC(feed->ring, size, "bcmtrmChgFeedRing");
+    SHR_NULL_CHECK(feed->ring, SHR_E_MEMORY);
+
+    size = feed->cfg.batch_size * sizeof(bcmlt_table_chg_rec_t);
+    SHR_ALLOC(feed->batch, size, "bcmtrmChgFeedBatch");
+    SHR_NULL_CHECK(feed->batch, SHR_E_MEMORY);
+
+    if (feed->cfg.coalesce) {
+        /* Twice the ring size keeps index collisions low */
+        size = 2 * ring_size * sizeof(uint32_t);
+        SHR_ALLOC(feed->coal, size, "bcmtrmChgFeedCoal");
+        SHR_NULL_CHECK(feed->coal, SHR_E_MEMORY);
+        sal_memset(feed->coal, 0, size);
+        feed->coal_mask = 2 * ring_size - 1;
+    }
+
+    feed->tc = shr_thread_start("bcmtrmChgFeed", -1, chg_feed_thread, feed);
+    SHR_NULL_CHECK(feed->tc, SHR_E_FAIL);
+
+    sal_spinlock_lock(feed_lock[unit]);
+    chg_feed[unit] = feed;
+    sal_spinlock_unlock(feed_lock[unit]);
+    feed = NULL;
+
+exit:
+    if (feed) {
+        chg_feed_free(feed);
+    }
+    SHR_FUNC_EXIT();
+}
+
+int bcmtrm_chg_feed_destroy(int unit)
+{
+    chg_feed_t *feed;
+
+    SHR_FUNC_ENTER(unit);
+
+    if (unit < 0 || unit >= BCMDRD_CONFIG_MAX_UNITS) {
+        SHR_RETURN_VAL_EXIT(SHR_E_UNIT);
+    }
+    if (!feed_lock[unit]) {
+        SHR_RETURN_VAL_EXIT(SHR_E_INIT);
+    }
+
+    /* Detach the feed, so no new records are added */
+    sal_spinlock_lock(feed_lock[unit]);
+    feed = chg_feed[unit];
+    chg_feed[unit] = NULL;
+    sal_spinlock_unlock(feed_lock[unit]);
+    if (!feed) {
+        SHR_RETURN_VAL_EXIT(SHR_E_NOT_FOUND);
+    }
+
+    /* The thread delivers the pending records before it exits */
+    if (SHR_FAILURE(shr_thread_stop(feed->tc, CHG_FEED_STOP_USECS))) {
+        LOG_WARN(BSL_LOG_MODULE,
+                 (BSL_META_U(unit, "Change feed thread failed to exit\n")));
+        /* The thread still references the feed */
+        SHR_RETURN_VAL_EXIT(SHR_E_TIMEOUT);
+    }
+    chg_feed_free(feed);
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+int bcmtrm_chg_feed_coalesce_test(int unit)
+{
+    /* Sequences of changes of one entry and their expected net change. */
+    static const struct {
+        bcmlt_opcode_t op[4];
+        bcmlt_opcode_t net;
+    } seq[] = {
+        { { BCMLT_OPCODE_INSERT }, BCMLT_OPCODE_INSERT },
+        { { BCMLT_OPCODE_UPDATE }, BCMLT_OPCODE_UPDATE },
+        { { BCMLT_OPCODE_DELETE }, BCMLT_OPCODE_DELETE },
+        { { BCMLT_OPCODE_INSERT, BCMLT_OPCODE_UPDATE },
+          BCMLT_OPCODE_INSERT },
+        { { BCMLT_OPCODE_INSERT, BCMLT_OPCODE_DELETE },
+          BCMLT_OPCODE_NOP },
+        { { BCMLT_OPCODE_INSERT, BCMLT_OPCODE_UPDATE, BCMLT_OPCODE_DELETE },
+          BCMLT_OPCODE_NOP },
+        { { BCMLT_OPCODE_INSERT, BCMLT_OPCODE_DELETE, BCMLT_OPCODE_INSERT },
+          BCMLT_OPCODE_INSERT },
+        { { BCMLT_OPCODE_UPDATE, BCMLT_OPCODE_UPDATE },
+          BCMLT_OPCODE_UPDATE },
+        { { BCMLT_OPCODE_UPDATE, BCMLT_OPCODE_DELETE },
+          BCMLT_OPCODE_DELETE },
+        { { BCMLT_OPCODE_DELETE, BCMLT_OPCODE_INSERT },
+          BCMLT_OPCODE_UPDATE },
+        { { BCMLT_OPCODE_DELETE, BCMLT_OPCODE_INSERT, BCMLT_OPCODE_DELETE },
+          BCMLT_OPCODE_DELETE },
+    };
+    const uint32_t num_seq = (uint32_t)COUNTOF(seq);
+    chg_feed_t *feed = NULL;
+    bcmlt_table_chg_rec_t rec;
+    uint32_t s, j, num, dropped, exp;
+
+    SHR_FUNC_ENTER(unit);
+
+    /* A private feed without a thread, which is drained explicitly. */
+    SHR_ALLOC(feed, sizeof(*feed), "bcmtrmChgFeedTest");
+    SHR_NULL_CHECK(feed, SHR_E_MEMORY);
+    sal_memset(feed, 0, sizeof(*feed));
+    feed->unit = unit;
+    feed->cfg.batch_size = 64;
+    feed->cfg.coalesce = true;
+    feed->ring_mask = feed->cfg.batch_size - 1;
+    feed->coal_mask = 2 * feed->cfg.batch_size - 1;
+    SHR_ALLOC(feed->ring, feed->cfg.batch_size * sizeof(rec),
+              "bcmtrmChgFeedTestRing");
+    SHR_NULL_CHECK(feed->ring, SHR_E_MEMORY);
+    SHR_ALLOC(feed->batch, feed->cfg.batch_size * sizeof(rec),
+              "bcmtrmChgFeedTestBatch");
+    SHR_NULL_CHECK(feed->batch, SHR_E_MEMORY);
+    SHR_ALLOC(feed->coal, 2 * feed->cfg.batch_size * sizeof(uint32_t),
+              "bcmtrmChgFeedTestCoal");
+    SHR_NULL_CHECK(feed->coal, SHR_E_MEMORY);
+    sal_memset(feed->coal, 0, 2 * feed->cfg.batch_size * sizeof(uint32_t));
+    feed->lock = sal_spinlock_create("bcmtrmChgFeedTest");
+    SHR_NULL_CHECK(feed->lock, SHR_E_MEMORY);
+
+    /* The changes of all sequences are interleaved on distinct entries. */
+    sal_memset(&rec, 0, sizeof(rec));
+    rec.num_keys = 1;
+    for (j = 0; j < (uint32_t)COUNTOF(seq[0].op); j++) {
+        for (s = 0; s < num_seq; s++) {
+            if (seq[s].op[j] == BCMLT_OPCODE_NOP) {
+                continue;
+            }
+            rec.opcode = seq[s].op[j];
+            rec.key[0].data = s;
+            chg_feed_rec_add(feed, &rec);
+        }
+    }
+
+    /* Entries with partial keys are never coalesced. */
+    rec.flags = BCMLT_TABLE_CHG_F_KEYS_PARTIAL;
+    rec.key[0].data = num_seq;
+    rec.opcode = BCMLT_OPCODE_INSERT;
+    chg_feed_rec_add(feed, &rec);
+    rec.opcode = BCMLT_OPCODE_DELETE;
+    chg_feed_rec_add(feed, &rec);
+
+    (void)chg_feed_fetch(feed, &num, &dropped);
+
+    exp = 0;
+    for (s = 0; s < num_seq; s++) {
+        if (seq[s].net == BCMLT_OPCODE_NOP) {
+            continue;
+        }
+        if (exp >= num || feed->batch[exp].key[0].data != s ||
+            feed->batch[exp].opcode != seq[s].net) {
+            LOG_ERROR(BSL_LOG_MODULE,
+                      (BSL_META_U(unit,
+                                  "Change sequence %"PRIu32" "
+                                  "not coalesced to opcode %d\n"),
+                       s, seq[s].net));
+            SHR_RETURN_VAL_EXIT(SHR_E_FAIL);
+        }
+        exp++;
+    }
+    if (num != exp + 2 || dropped != 0 ||
+        feed->batch[exp].opcode != BCMLT_OPCODE_INSERT ||
+        feed->batch[exp + 1].opcode != BCMLT_OPCODE_DELETE) {
+        LOG_ERROR(BSL_LOG_MODULE,
+                  (BSL_META_U(unit,
+                              "Unexpected change records (%"PRIu32" of "
+                              "%"PRIu32")\n"),
+                   num, exp + 2));
+        SHR_RETURN_VAL_EXIT(SHR_E_FAIL);
+    }
+
+exit:
+    if (feed) {
+        if (feed->lock) {
+            sal_spinlock_destroy(feed->lock);
+        }
+        chg_feed_free(feed);
+    }
+    SHR_FUNC_EXIT();
+}
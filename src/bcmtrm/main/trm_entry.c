@@ -443,8 +443,8 @@ static void trm_entry_cb(uint32_t trans_id,
     hw_notif.ltm_entry = entry;
     hw_notif.status = status;
     /* Post the event to the notification thread */
-    sal_msgq_post(bcmtrm_hw_notif_q, &hw_notif, SAL_MSGQ_NORMAL_PRIORITY,
-                  SAL_MSGQ_FOREVER);
+    bcmtrm_hw_notif_post(entry->info.unit, &hw_notif,
+                         SAL_MSGQ_NORMAL_PRIORITY);
 }
 
 static void sync_entry_cb(uint32_t trans_id,
@@ -735,8 +735,8 @@ int bcmtrm_process_entry_req(bcmtrm_entry_t *entry,
             hw_notif.type = ENTRY_CB;
         }
         /* Post the event to the notification thread */
-        sal_msgq_post(bcmtrm_hw_notif_q, &hw_notif, SAL_MSGQ_NORMAL_PRIORITY,
-                      SAL_MSGQ_FOREVER);
+        bcmtrm_hw_notif_post(entry->info.unit, &hw_notif,
+                             SAL_MSGQ_NORMAL_PRIORITY);
     }
 
     INCREMENT_OP_ID((*trans_id));
@@ -744,12 +744,15 @@ int bcmtrm_process_entry_req(bcmtrm_entry_t *entry,
     return rv;
 }
 
-int bcmtrm_process_interactive_entry_req(bcmtrm_entry_t *entry,
-                                         uint32_t op_id,
-                                         trn_interact_info_t *ha_mem)
+/*
+ * Stage interactive entry. Interactive entries are completed by the time
+ * the LTM returns so there is no commit phase.
+ */
+static int interactive_entry_stage(bcmtrm_entry_t *entry,
+                                   uint32_t op_id,
+                                   trn_interact_info_t *ha_mem)
 {
     int rv;
-    bcmtrm_hw_notif_struct_t hw_notif;
 
     /* Keep the entry in HA memory for recovery */
     interactive_ha_record(entry, op_id, ha_mem);
@@ -768,6 +771,18 @@ int bcmtrm_process_interactive_entry_req(bcmtrm_entry_t *entry,
                              "Stage failed rv=%d e_id=%d pt_opcode=%d\n"),
                   rv, op_id, entry->opcode.pt_opcode));
     }
+    return rv;
+}
+
+int bcmtrm_process_interactive_entry_req(bcmtrm_entry_t *entry,
+                                         uint32_t op_id,
+                                         trn_interact_info_t *ha_mem)
+{
+    int rv;
+    bcmtrm_hw_notif_struct_t hw_notif;
+
+    rv = interactive_entry_stage(entry, op_id, ha_mem);
+
     /* Everything is done. Inform the notifier thread to do the rest */
     entry->state = E_COMMITTED;
 
@@ -786,8 +801,34 @@ int bcmtrm_process_interactive_entry_req(bcmtrm_entry_t *entry,
         hw_notif.type = ENTRY_CB;
     }
     /* Post the event to the notification thread */
-    sal_msgq_post(bcmtrm_hw_notif_q, &hw_notif, SAL_MSGQ_NORMAL_PRIORITY,
-                  SAL_MSGQ_FOREVER);
+    bcmtrm_hw_notif_post(entry->info.unit, &hw_notif,
+                         SAL_MSGQ_NORMAL_PRIORITY);
+
+    return rv;
+}
+
+int bcmtrm_inline_interactive_entry_req(bcmtrm_entry_t *entry,
+                                        uint32_t op_id,
+                                        trn_interact_info_t *ha_mem)
+{
+    int rv;
+
+    rv = interactive_entry_stage(entry, op_id, ha_mem);
+
+    /*
+     * Complete the entry the same way the notification thread completes
+     * a synchronous interactive entry.
+     */
+    entry->state = E_COMMITTED;
+    if (rv == SHR_E_NONE) {
+        bcmtrm_tbl_chg_event(entry);
+    }
+    /*
+     * Set the status. The function bcmtrm_proc_entry_results() may override
+     * the status.
+     */
+    entry->info.status = rv;
+    bcmtrm_proc_entry_results(entry, entry->ltm_entry);
 
     return rv;
 }
@@ -172,7 +172,15 @@ typedef struct {
 
 extern shr_lmm_hdl_t bcmtrm_ltm_entry_hdl;   /*!< used to obtain ltm entries */
 
-extern sal_msgq_t bcmtrm_hw_notif_q;
+/*!
+ * \brief Notification thread control of a unit.
+ */
+typedef struct bcmtrm_notif_ctrl_s {
+    sal_msgq_t queue;   /*!< Queue accepting posts, NULL while stopped */
+    sal_msgq_t rx_queue; /*!< Queue received by the thread */
+    int posters;        /*!< Number of posts in progress on the queue */
+    int running;        /*!< Non-zero while the thread is running */
+} bcmtrm_notif_ctrl_t;
 
 extern bool bcmltm_notify_units[];
 
@@ -240,6 +248,27 @@ extern int bcmtrm_process_interactive_entry_req(bcmtrm_entry_t *entry,
                                                 uint32_t op_id,
                                                 trn_interact_info_t *ha_mem);
 
+/*!
+ * \brief Process single interactive entry on the caller thread.
+ *
+ * This function processes a single synchronous interactive entry the same
+ * way as \ref bcmtrm_process_interactive_entry_req(). However, instead of
+ * handing the completion to the notification thread, the entry results are
+ * processed before the function returns. The caller must have exclusive
+ * access to the interactive processing of the unit.
+ *
+ * \param [in] entry Entry is the table entry to process.
+ * \param [in] op_id Entry operation ID to use for this request.
+ * \param [in] ha_mem Is the HA memory to store the operation in case
+ * of HA event.
+ *
+ * \retval SHR_E_NONE on success and error code for failure. The entry
+ * status contains the final status of the operation.
+ */
+extern int bcmtrm_inline_interactive_entry_req(bcmtrm_entry_t *entry,
+                                               uint32_t op_id,
+                                               trn_interact_info_t *ha_mem);
+
 /*!
  * \brief Memory allocator for entry field.
  *
@@ -460,18 +489,49 @@ extern void bcmtrm_trans_done(bcmtrm_trans_t *trans, bool exclusive);
 /*!
  * \brief Notification thread.
  *
- * This threads handles the application notification for all units.
+ * This threads handles the application notification for a single unit.
  * Notification can be made for asynchronous operation as well as table
  * change notifications.
  *
- * \param [in] arg Arg is used to communicate between the thread and the
- * thread creator. It is used as a counter to signal that the thread is
- * running or existing.
+ * \param [in] arg Arg is the notification thread control
+ * (\ref bcmtrm_notif_ctrl_t) of the unit. The thread clears the running
+ * field when it exits.
  *
  * \retval none.
  */
 extern void bcmtrm_notify_thread(void *arg);
 
+/*!
+ * \brief Process a notification.
+ *
+ * This function processes an entry or transaction completion or a table
+ * change notification. It is called by the notification thread.
+ *
+ * \param [in] hw_notif Notification to process.
+ *
+ * \return None.
+ */
+extern void bcmtrm_hw_notif_process(bcmtrm_hw_notif_struct_t *hw_notif);
+
+/*!
+ * \brief Post a notification to the notification thread of a unit.
+ *
+ * Entry and transaction completions which can not be posted, for
+ * example after the notification thread was stopped, are processed in
+ * the context of the caller, so they are never lost.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] hw_notif Notification to post.
+ * \param [in] pri Notification priority.
+ *
+ * \retval SHR_E_NONE on success.
+ * \retval SHR_E_INIT The unit has no notification thread.
+ * \retval SHR_E_INTERNAL Failed to post the notification.
+ */
+extern int bcmtrm_hw_notif_post(int unit,
+                                bcmtrm_hw_notif_struct_t *hw_notif,
+                                sal_msgq_priority_t pri);
+
 /*!
  * \brief Allocates table event vector.
  *
@@ -651,4 +711,47 @@ extern int bcmtrm_sb_table_notify(int unit,
  */
 extern void bcmtrm_tbl_chg_event(bcmtrm_entry_t *entry);
 
+/*!
+ * \brief Check if a table is subscribed to the change feed.
+ *
+ * \param [in] unit Unit number.
+ * \param [in] table_id Logical table ID.
+ *
+ * \return true if changes of the table go to the change feed.
+ */
+extern bool bcmtrm_table_feed_get(int unit, uint32_t table_id);
+
+/*!
+ * \brief Append a changed entry to the change feed of the unit.
+ *
+ * This function adds a change record of the entry to the change feed
+ * ring of the unit. The record may be merged with a pending record of
+ * the same entry if the feed coalesces updates.
+ *
+ * \param [in] entry Is the changed entry in the table.
+ *
+ * \return None.
+ */
+extern void bcmtrm_chg_feed_push(bcmtrm_entry_t *entry);
+
+/*!
+ * \brief Initialize the change feed resources of a unit.
+ *
+ * \param [in] unit Unit number.
+ *
+ * \return SHR_E_NONE on success and error code otherwise.
+ */
+extern int bcmtrm_chg_feed_unit_init(int unit);
+
+/*!
+ * \brief Release the change feed resources of a unit.
+ *
+ * Any existing change feed of the unit is destroyed as well.
+ *
+ * \param [in] unit Unit number.
+ *
+ * \return None.
+ */
+extern void bcmtrm_chg_feed_unit_cleanup(int unit);
+
 #endif /* TRM_INTERNAL_H */
@@ -114,6 +114,7 @@
 typedef struct {
     bcmlt_table_sub_cb cb;
     void *user_data;
+    bool feed;  /* Changes go to the change feed of the unit */
 } table_event_info;
 
 static table_event_info *trm_unit_tbl_event[BCMDRD_CONFIG_MAX_UNITS];
@@ -124,16 +125,22 @@ static size_t max_tbl_id[BCMDRD_CONFIG_MAX_UNITS];
 void bcmtrm_tbl_chg_event(bcmtrm_entry_t *p_entry)
 {
     bcmlt_opcode_t opcode = p_entry->opcode.lt_opcode;
+    table_event_info *p_table_event;
+
     if (p_entry->pt) {    /* no change events for PT tables */
         return;
     }
-    if (((opcode == BCMLT_OPCODE_INSERT) ||
-         (opcode == BCMLT_OPCODE_UPDATE) ||
-         (opcode == BCMLT_OPCODE_DELETE)) &&
-        (max_tbl_id[p_entry->info.unit] > (size_t)p_entry->table_id) &&
-        trm_unit_tbl_event[p_entry->info.unit][p_entry->table_id].cb) {
-        table_event_info *p_table_event =
-            &trm_unit_tbl_event[p_entry->info.unit][p_entry->table_id];
+    if (((opcode != BCMLT_OPCODE_INSERT) &&
+         (opcode != BCMLT_OPCODE_UPDATE) &&
+         (opcode != BCMLT_OPCODE_DELETE)) ||
+        (max_tbl_id[p_entry->info.unit] <= (size_t)p_entry->table_id)) {
+        return;
+    }
+    p_table_event = &trm_unit_tbl_event[p_entry->info.unit][p_entry->table_id];
+    if (p_table_event->feed) {
+        bcmtrm_chg_feed_push(p_entry);
+    }
+    if (p_table_event->cb) {
         bcmlt_table_notif_info_t table_info;
         table_info.unit = p_entry->info.unit;
         table_info.entry_hdl = p_entry->info.entry_hdl;
@@ -144,178 +151,183 @@ void bcmtrm_tbl_chg_event(bcmtrm_entry_t *p_entry)
 
 
 
-void bcmtrm_notify_thread(void *arg)
+void bcmtrm_hw_notif_process(bcmtrm_hw_notif_struct_t *hw_notif)
 {
-#define ONE_SEC_WAIT    1000000
-    bool running = true;
-    bcmtrm_hw_notif_struct_t hw_notif;
-    int rv;
-    int *notify_thread_running = (int *)arg;
-
-    (*notify_thread_running)++;
-    while (running) {
-        rv = sal_msgq_recv(bcmtrm_hw_notif_q, (void *)&hw_notif, ONE_SEC_WAIT);
-        if (rv == SAL_MSGQ_E_TIMEOUT) {
-            continue;
-        }
-        if (rv != 0) {
-            LOG_WARN(BSL_LOG_MODULE,
-                     (BSL_META("Failed to receive hw notify message rv=%d\n"),
-                      rv));
+    switch (hw_notif->type) {
+    case ENTRY_CB:
+        {
+            bcmtrm_entry_t *entry = hw_notif->ltm_entry;
+            bool entry_complete;
+            /* Don't process invalid units */
+            if (!bcmltm_notify_units[entry->info.unit]) {
+                break;
+            }
+            if (hw_notif->status == SHR_E_NONE) {
+                bcmtrm_tbl_chg_event(entry);
+            }
+            /*
+             * Set the status. The function
+             * bcmtrm_proc_entry_results() may override the status.
+             */
+            entry->info.status = hw_notif->status;
+            bcmtrm_proc_entry_results(entry, entry->ltm_entry);
+            if (entry->asynch) {
+                entry_complete = true;
+            } else {
+                entry_complete = false;
+                entry->state = E_ACTIVE;   /* The entry is done */
+            }
+            /* Inform the application if needed */
+            bcmtrm_appl_entry_inform(entry,
+                                     hw_notif->status,
+                                     BCMLT_NOTIF_OPTION_HW);
+            if (entry_complete) {
+                bcmtrm_entry_complete(entry);
+            }
             break;
         }
-        switch (hw_notif.type) {
-        case NOTIF_EXIT:
-            running = false;
-            break;
-        case ENTRY_CB:
-            {
-                bcmtrm_entry_t *entry = hw_notif.ltm_entry;
-                bool entry_complete;
-                /* Don't process invalid units */
-                if (!bcmltm_notify_units[entry->info.unit]) {
-                    break;
+    case TRANS_CB:
+        {
+            bcmtrm_entry_t *entry = hw_notif->ltm_entry;
+            bcmtrm_trans_t *trans = entry->p_trans;
+            bool trans_complete = false;
+            /* Don't process invalid units */
+            if (!bcmltm_notify_units[entry->info.unit]) {
+                break;
+            }
+            if (trans->info.type == BCMLT_TRANS_TYPE_ATOMIC) {
+                /*
+                 * This is the only notification. Update the status of each
+                 * entry with this status - maybe not necessary
+                 */
+                bcmtrm_entry_t *entry_it;
+                for (entry_it = trans->l_entries;
+                      entry_it;
+                      entry_it = entry_it->next) {
+                    /*
+                     * Set the status. The function
+                     * bcmtrm_proc_entry_results() may override the status.
+                     */
+                    entry_it->info.status = hw_notif->status;
+                    if (entry_it->ltm_entry) {
+                        bcmtrm_proc_entry_results(entry_it,
+                                                  entry_it->ltm_entry);
+                    }
+                    if (hw_notif->status == SHR_E_NONE) {
+                        bcmtrm_tbl_chg_event(entry_it);
+                    }
                 }
-                if (hw_notif.status == SHR_E_NONE) {
-                    bcmtrm_tbl_chg_event(entry);
+                trans->info.status = hw_notif->status;
+                if (trans->syncronous) {
+                    trans->state = T_ACTIVE;
+                    trans_complete = false;
+                } else {
+                    trans_complete = true;
                 }
+                bcmtrn_trans_cb_and_clean(trans,
+                                          BCMLT_NOTIF_OPTION_HW,
+                                          hw_notif->status);
+            } else {
+                uint32_t processed_entries;
                 /*
                  * Set the status. The function
                  * bcmtrm_proc_entry_results() may override the status.
                  */
-                entry->info.status = hw_notif.status;
-                bcmtrm_proc_entry_results(entry, entry->ltm_entry);
-                if (entry->asynch) {
-                    entry_complete = true;
-                } else {
-                    entry_complete = false;
-                    entry->state = E_ACTIVE;   /* The entry is done */
-                }
-                /* Inform the application if needed */
-                bcmtrm_appl_entry_inform(entry,
-                                         hw_notif.status,
-                                         BCMLT_NOTIF_OPTION_HW);
-                if (entry_complete) {
-                    bcmtrm_entry_complete(entry);
+                entry->info.status = hw_notif->status;
+                if (entry->ltm_entry) {
+                    bcmtrm_proc_entry_results(entry,
+                                              entry->ltm_entry);
                 }
-                break;
-            }
-        case TRANS_CB:
-            {
-                bcmtrm_entry_t *entry = hw_notif.ltm_entry;
-                bcmtrm_trans_t *trans = entry->p_trans;
-                bool trans_complete = false;
-                /* Don't process invalid units */
-                if (!bcmltm_notify_units[entry->info.unit]) {
-                    break;
+                if (hw_notif->status == SHR_E_NONE) {
+                    bcmtrm_tbl_chg_event(entry);
                 }
-                if (trans->info.type == BCMLT_TRANS_TYPE_ATOMIC) {
-                    /*
-                     * This is the only notification. Update the status of each
-                     * entry with this status - maybe not necessary
-                     */
-                    bcmtrm_entry_t *entry_it;
-                    for (entry_it = trans->l_entries;
-                          entry_it;
-                          entry_it = entry_it->next) {
+                /* Lock transaction db */
+                sal_mutex_take(trans->lock_obj->mutex, SAL_MUTEX_FOREVER);
+                processed_entries = ++trans->processed_entries;
+                sal_mutex_give(trans->lock_obj->mutex);
+                if (processed_entries == trans->info.num_entries) {
+                    if (trans->syncronous) {
                         /*
-                         * Set the status. The function
-                         * bcmtrm_proc_entry_results() may override the status.
+                         * For synchronous we can set it all here. We know
+                         * that nothing can change the status or
+                         * delete flag values. We have to be sure that the
+                         * callback is the last thing since after that
+                         * the entry can be deleted under our feet (since
+                         * the state changes to T_ACTIVE (required for
+                         * synchronous operations before calling the
+                         * callback)).
                          */
-                        entry_it->info.status = hw_notif.status;
-                        if (entry_it->ltm_entry) {
-                            bcmtrm_proc_entry_results(entry_it,
-                                                      entry_it->ltm_entry);
-                        }
-                        if (hw_notif.status == SHR_E_NONE) {
-                            bcmtrm_tbl_chg_event(entry_it);
-                        }
-                    }
-                    trans->info.status = hw_notif.status;
-                    if (trans->syncronous) {
                         trans->state = T_ACTIVE;
                         trans_complete = false;
                     } else {
+                        /*
+                         * In asynchronous mode we simply set the
+                         * transaction complete, so it can be cleaned up
+                         * at the end. Here the state is not necessarily
+                         * has to be T_ACTIVE to free the transaction.
+                        */
                         trans_complete = true;
                     }
+                    if (trans->commit_success == processed_entries) {
+                        trans->info.status = SHR_E_NONE;
+                    } else if (trans->commit_success == 0) {
+                        trans->info.status = SHR_E_FAIL;
+                    } else {
+                        trans->info.status = SHR_E_PARTIAL;
+                    }
                     bcmtrn_trans_cb_and_clean(trans,
                                               BCMLT_NOTIF_OPTION_HW,
-                                              hw_notif.status);
-                } else {
-                    uint32_t processed_entries;
-                    /*
-                     * Set the status. The function
-                     * bcmtrm_proc_entry_results() may override the status.
-                     */
-                    entry->info.status = hw_notif.status;
-                    if (entry->ltm_entry) {
-                        bcmtrm_proc_entry_results(entry,
-                                                  entry->ltm_entry);
-                    }
-                    if (hw_notif.status == SHR_E_NONE) {
-                        bcmtrm_tbl_chg_event(entry);
-                    }
-                    /* Lock transaction db */
-                    sal_mutex_take(trans->lock_obj->mutex, SAL_MUTEX_FOREVER);
-                    processed_entries = ++trans->processed_entries;
-                    sal_mutex_give(trans->lock_obj->mutex);
-                    if (processed_entries == trans->info.num_entries) {
-                        if (trans->syncronous) {
-                            /*
-                             * For synchronous we can set it all here. We know
-                             * that nothing can change the status or
-                             * delete flag values. We have to be sure that the
-                             * callback is the last thing since after that
-                             * the entry can be deleted under our feet (since
-                             * the state changes to T_ACTIVE (required for
-                             * synchronous operations before calling the
-                             * callback)).
-                             */
-                            trans->state = T_ACTIVE;
-                            trans_complete = false;
-                        } else {
-                            /*
-                             * In asynchronous mode we simply set the
-                             * transaction complete, so it can be cleaned up
-                             * at the end. Here the state is not necessarily
-                             * has to be T_ACTIVE to free the transaction.
-                            */
-                            trans_complete = true;
-                        }
-                        if (trans->commit_success == processed_entries) {
-                            trans->info.status = SHR_E_NONE;
-                        } else if (trans->commit_success == 0) {
-                            trans->info.status = SHR_E_FAIL;
-                        } else {
-                            trans->info.status = SHR_E_PARTIAL;
-                        }
-                        bcmtrn_trans_cb_and_clean(trans,
-                                                  BCMLT_NOTIF_OPTION_HW,
-                                                  hw_notif.status);
-                    }
-                }
-                if (trans_complete) {
-                    bcmtrm_trans_complete(trans);
+                                              hw_notif->status);
                 }
-
-                break;
             }
-        case ENTRY_NOTIF:
-            {
-                bcmtrm_entry_t *entry = hw_notif.ltm_entry;  /* Entry can't be NULL */
-                const bcmlrd_table_rep_t *lrd_tbl = bcmlrd_table_get(entry->table_id);
-                if (lrd_tbl) {
-                    entry->info.table_name = lrd_tbl->name;
-                    bcmtrm_tbl_chg_event(entry);
-                }
-                bcmtrm_entry_done(entry, true);
-                break;
+            if (trans_complete) {
+                bcmtrm_trans_complete(trans);
+            }
+
+            break;
+        }
+    case ENTRY_NOTIF:
+        {
+            bcmtrm_entry_t *entry = hw_notif->ltm_entry;  /* Entry can't be NULL */
+            const bcmlrd_table_rep_t *lrd_tbl = bcmlrd_table_get(entry->table_id);
+            if (lrd_tbl) {
+                entry->info.table_name = lrd_tbl->name;
+                bcmtrm_tbl_chg_event(entry);
             }
-        default:
-            assert(0);
+            bcmtrm_entry_done(entry, true);
+            break;
         }
+    default:
+        assert(0);
     }
-    (*notify_thread_running)--;
+}
+
+void bcmtrm_notify_thread(void *arg)
+{
+#define ONE_SEC_WAIT    1000000
+    bool running = true;
+    bcmtrm_hw_notif_struct_t hw_notif;
+    int rv;
+    bcmtrm_notif_ctrl_t *ctrl = (bcmtrm_notif_ctrl_t *)arg;
+
+    while (running) {
+        rv = sal_msgq_recv(ctrl->rx_queue, (void *)&hw_notif, ONE_SEC_WAIT);
+        if (rv == SAL_MSGQ_E_TIMEOUT) {
+            continue;
+        }
+        if (rv != 0) {
+            LOG_WARN(BSL_LOG_MODULE,
+                     (BSL_META("Failed to receive hw notify message rv=%d\n"),
+                      rv));
+            break;
+        }
+        if (hw_notif.type == NOTIF_EXIT) {
+            running = false;
+        } else {
+            bcmtrm_hw_notif_process(&hw_notif);
+        }
+    }
+    ctrl->running = 0;
 }
 
 int bcmtrm_table_event_subscribe(int unit,
@@ -330,6 +342,23 @@ int bcmtrm_table_event_subscribe(int unit,
     return SHR_E_NONE;
 }
 
+int bcmtrm_table_feed_set(int unit, uint32_t table_id, bool enable)
+{
+    if (!trm_unit_tbl_event[unit] || (size_t)table_id >= max_tbl_id[unit]) {
+        return SHR_E_PARAM;
+    }
+    trm_unit_tbl_event[unit][table_id].feed = enable;
+    return SHR_E_NONE;
+}
+
+bool bcmtrm_table_feed_get(int unit, uint32_t table_id)
+{
+    if (!trm_unit_tbl_event[unit] || (size_t)table_id >= max_tbl_id[unit]) {
+        return false;
+    }
+    return trm_unit_tbl_event[unit][table_id].feed;
+}
+
 int bcmtrm_table_event_alloc(int unit)
 {
     size_t num_of_tables;
@@ -385,7 +414,9 @@ int bcmtrm_sb_table_notify(int unit,
         return SHR_E_INIT;
     }
 
-    if (!trm_unit_tbl_event[unit] || !trm_unit_tbl_event[unit][table_id].cb) {
+    if (!trm_unit_tbl_event[unit] ||
+        (!trm_unit_tbl_event[unit][table_id].cb &&
+         !trm_unit_tbl_event[unit][table_id].feed)) {
         /* No callback */
         bcmltm_field_list_t *tmp_f;
         bcmltm_field_list_t *working_fld = fields;
@@ -407,11 +438,14 @@ int bcmtrm_sb_table_notify(int unit,
     hw_notif.ltm_entry = entry;
     hw_notif.status = SHR_E_NONE;
     /* post the event to the notification thread */
-    sal_msgq_post(
-        bcmtrm_hw_notif_q,
-        &hw_notif,
-        (high_pri ? SAL_MSGQ_HIGH_PRIORITY : SAL_MSGQ_NORMAL_PRIORITY),
-        SAL_MSGQ_FOREVER);
+    if (bcmtrm_hw_notif_post(
+            unit,
+            &hw_notif,
+            (high_pri ? SAL_MSGQ_HIGH_PRIORITY : SAL_MSGQ_NORMAL_PRIORITY))
+        != SHR_E_NONE) {
+        bcmtrm_entry_done(entry, true);
+        return SHR_E_INIT;
+    }
 
     return SHR_E_NONE;
 }
@@ -141,8 +141,8 @@ static void trm_async_trans_cb(uint32_t trans_id,
     hw_notif.ltm_entry = entry;
     hw_notif.status = status;
     /* Post the event to the notification thread */
-    sal_msgq_post(bcmtrm_hw_notif_q, &hw_notif, SAL_MSGQ_NORMAL_PRIORITY,
-                  SAL_MSGQ_FOREVER);
+    bcmtrm_hw_notif_post(entry->info.unit, &hw_notif,
+                         SAL_MSGQ_NORMAL_PRIORITY);
 }
 
 /*
@@ -107,6 +107,7 @@
 #include <bcmdrd/bcmdrd_field.h>
 #include <bcmltd/chip/bcmltd_id.h>
 #include <bcmtrunk/bcmtrunk_util.h>
+#include <bcmtrunk/bcmtrunk_prune.h>
 #include "../bcmtrunk_common.h"
 
 
@@ -260,6 +261,9 @@ bcm56960_a0_trunk_grp_add(int unit,
     int trunk_id, px, seed;
     uint32_t base_ptr;
     bcmtrunk_group_t *grp;
+    uint8_t hw_modid[BCMTRUNK_MAX_MEMBERS];
+    uint8_t hw_modport[BCMTRUNK_MAX_MEMBERS];
+    uint16_t hw_cnt;
 
     SHR_FUNC_ENTER(unit);
 
@@ -274,11 +278,15 @@ bcm56960_a0_trunk_grp_add(int unit,
     BCMDRD_PBMP_CLEAR(new_trunk_bmp);
 
     if (param->uc_cnt > 0) {
-        /* Write TRUNK_MEMBERm. */
+        /* Write TRUNK_MEMBERm, excluding members on ports which are down. */
+        hw_cnt = bcmtrunk_prune_members_get(unit, param->uc_cnt,
+                                            param->uc_modid,
+                                            param->uc_modport,
+                                            hw_modid, hw_modport);
         TRUNK_MEMBERm_CLR(mem_buf);
-        for (px = 0; px < param->uc_cnt; px++) {
-            TRUNK_MEMBERm_MODULE_IDf_SET(mem_buf, param->uc_modid[px]);
-            TRUNK_MEMBERm_PORT_NUMf_SET(mem_buf, param->uc_modport[px]);
+        for (px = 0; px < hw_cnt; px++) {
+            TRUNK_MEMBERm_MODULE_IDf_SET(mem_buf, hw_modid[px]);
+            TRUNK_MEMBERm_PORT_NUMf_SET(mem_buf, hw_modport[px]);
             SHR_IF_ERR_EXIT
                 (bcmtrunk_hw_write(unit, trans_id,
                                    lt_id, TRUNK_MEMBERm,
@@ -308,7 +316,7 @@ bcm56960_a0_trunk_grp_add(int unit,
         TRUNK_GROUPm_CLR(grp_buf);
         TRUNK_GROUPm_TRUNK_MODEf_SET(grp_buf, param->lb_mode);
         TRUNK_GROUPm_RTAGf_SET(grp_buf, param->uc_rtag);
-        TRUNK_GROUPm_TG_SIZEf_SET(grp_buf, (param->uc_cnt - 1));
+        TRUNK_GROUPm_TG_SIZEf_SET(grp_buf, (hw_cnt - 1));
         TRUNK_GROUPm_BASE_PTRf_SET(grp_buf, base_ptr);
         TRUNK_GROUPm_AGM_MONITOR_IDf_SET(grp_buf, param->uc_agm_id);
         SHR_IF_ERR_EXIT
@@ -432,10 +440,14 @@ bcm56960_a0_trunk_grp_update(int unit,
     uint32_t trunk_id, px;
     uint32_t old_max, old_cnt, old_base;
     uint32_t new_max, new_base;
-    uint8_t old_modid, old_modport;
     uint32_t min_cnt;
     int seed;
     bcmtrunk_group_t *grp;
+    uint8_t old_modid[BCMTRUNK_MAX_MEMBERS];
+    uint8_t old_modport[BCMTRUNK_MAX_MEMBERS];
+    uint8_t hw_modid[BCMTRUNK_MAX_MEMBERS];
+    uint8_t hw_modport[BCMTRUNK_MAX_MEMBERS];
+    uint16_t hw_cnt;
 
     SHR_FUNC_ENTER(unit);
 
@@ -444,7 +456,13 @@ bcm56960_a0_trunk_grp_update(int unit,
     SHR_IF_ERR_EXIT
         (bcmtrunk_param_update(unit, param, grp));
 
-    old_cnt  = grp->uc_cnt;
+    /* Member lists as written to hardware. */
+    old_cnt  = bcmtrunk_prune_members_get(unit, grp->uc_cnt,
+                                          grp->uc_modid, grp->uc_modport,
+                                          old_modid, old_modport);
+    hw_cnt   = bcmtrunk_prune_members_get(unit, param->uc_cnt,
+                                          param->uc_modid, param->uc_modport,
+                                          hw_modid, hw_modport);
     old_base = grp->uc_base_ptr;
     old_max  = grp->uc_max_members;
     new_base = old_base;
@@ -459,10 +477,8 @@ bcm56960_a0_trunk_grp_update(int unit,
                                          new_max, &new_base));
         if (new_base != old_base) {
             for (px = 0; px < old_cnt; px++) {
-                old_modid = grp->uc_modid[px];
-                old_modport = grp->uc_modport[px];
-                TRUNK_MEMBERm_MODULE_IDf_SET(mem_buf, old_modid);
-                TRUNK_MEMBERm_PORT_NUMf_SET(mem_buf, old_modport);
+                TRUNK_MEMBERm_MODULE_IDf_SET(mem_buf, old_modid[px]);
+                TRUNK_MEMBERm_PORT_NUMf_SET(mem_buf, old_modport[px]);
                 SHR_IF_ERR_EXIT
                     (bcmtrunk_hw_write(unit, trans_id, lt_id, TRUNK_MEMBERm,
                                        (new_base + px), &mem_buf));
@@ -476,27 +492,25 @@ bcm56960_a0_trunk_grp_update(int unit,
     if (param->uc_cnt > 0) {
         /* Update TRUNK_MEMBERm. */
         TRUNK_MEMBERm_CLR(mem_buf);
-        if (old_cnt < param->uc_cnt) {
+        if (old_cnt < hw_cnt) {
             min_cnt = old_cnt;
         } else {
-            min_cnt = param->uc_cnt;
+            min_cnt = hw_cnt;
         }
         for (px = 0; px < min_cnt; px++) {
-            old_modid = grp->uc_modid[px];
-            old_modport = grp->uc_modport[px];
-            if ((param->uc_modid[px] != old_modid) ||
-                (param->uc_modport[px] != old_modport)) {
-                TRUNK_MEMBERm_MODULE_IDf_SET(mem_buf, param->uc_modid[px]);
-                TRUNK_MEMBERm_PORT_NUMf_SET(mem_buf, param->uc_modport[px]);
+            if ((hw_modid[px] != old_modid[px]) ||
+                (hw_modport[px] != old_modport[px])) {
+                TRUNK_MEMBERm_MODULE_IDf_SET(mem_buf, hw_modid[px]);
+                TRUNK_MEMBERm_PORT_NUMf_SET(mem_buf, hw_modport[px]);
                 SHR_IF_ERR_EXIT
                     (bcmtrunk_hw_write(unit, trans_id, lt_id, TRUNK_MEMBERm,
                                        (new_base + px), &mem_buf));
             }
         }
 
-        for (px = min_cnt; px < param->uc_cnt; px++) {
-            TRUNK_MEMBERm_MODULE_IDf_SET(mem_buf, param->uc_modid[px]);
-            TRUNK_MEMBERm_PORT_NUMf_SET(mem_buf, param->uc_modport[px]);
+        for (px = min_cnt; px < hw_cnt; px++) {
+            TRUNK_MEMBERm_MODULE_IDf_SET(mem_buf, hw_modid[px]);
+            TRUNK_MEMBERm_PORT_NUMf_SET(mem_buf, hw_modport[px]);
             SHR_IF_ERR_EXIT
                 (bcmtrunk_hw_write(unit, trans_id, lt_id, TRUNK_MEMBERm,
                                   (new_base + px), &mem_buf));
@@ -527,7 +541,7 @@ bcm56960_a0_trunk_grp_update(int unit,
         TRUNK_GROUPm_BASE_PTRf_SET(grp_buf, new_base);
         TRUNK_GROUPm_TRUNK_MODEf_SET(grp_buf, param->lb_mode);
         TRUNK_GROUPm_RTAGf_SET(grp_buf, param->uc_rtag);
-        TRUNK_GROUPm_TG_SIZEf_SET(grp_buf, (param->uc_cnt - 1));
+        TRUNK_GROUPm_TG_SIZEf_SET(grp_buf, (hw_cnt - 1));
         TRUNK_GROUPm_AGM_MONITOR_IDf_SET(grp_buf, param->uc_agm_id);
         SHR_IF_ERR_EXIT
             (bcmtrunk_hw_write(unit, trans_id,
@@ -590,6 +604,56 @@ exit:
     SHR_FUNC_EXIT();
 }
 
+static int
+bcm56960_a0_trunk_grp_members_set(int unit,
+                                  bcmltd_sid_t lt_id,
+                                  uint32_t trunk_id,
+                                  uint32_t base_ptr,
+                                  uint16_t old_cnt,
+                                  const uint8_t *old_modid,
+                                  const uint8_t *old_modport,
+                                  uint16_t cnt,
+                                  const uint8_t *modid,
+                                  const uint8_t *modport)
+{
+    TRUNK_GROUPm_t   grp_buf;
+    TRUNK_MEMBERm_t  mem_buf;
+    bool full = (old_modid == NULL || old_modport == NULL);
+    uint32_t px;
+
+    SHR_FUNC_ENTER(unit);
+
+    if (cnt == 0) {
+        SHR_RETURN_VAL_EXIT(SHR_E_PARAM);
+    }
+
+    /* Fill in the members before the group size may shrink or grow. */
+    TRUNK_MEMBERm_CLR(mem_buf);
+    for (px = 0; px < cnt; px++) {
+        if (!full && px < old_cnt &&
+            modid[px] == old_modid[px] && modport[px] == old_modport[px]) {
+            continue;
+        }
+        TRUNK_MEMBERm_MODULE_IDf_SET(mem_buf, modid[px]);
+        TRUNK_MEMBERm_PORT_NUMf_SET(mem_buf, modport[px]);
+        SHR_IF_ERR_EXIT
+            (bcmtrunk_ireq_write(unit, lt_id, TRUNK_MEMBERm,
+                                 (base_ptr + px), &mem_buf));
+    }
+
+    if (full || cnt != old_cnt) {
+        SHR_IF_ERR_EXIT
+            (bcmtrunk_ireq_read(unit, lt_id, TRUNK_GROUPm,
+                                trunk_id, &grp_buf));
+        TRUNK_GROUPm_TG_SIZEf_SET(grp_buf, (cnt - 1));
+        SHR_IF_ERR_EXIT
+            (bcmtrunk_ireq_write(unit, lt_id, TRUNK_GROUPm,
+                                 trunk_id, &grp_buf));
+    }
+
+exit:
+    SHR_FUNC_EXIT();
+}
 
 static int
 bcm56960_a0_trunk_grp_init(int unit, bcmtrunk_lth_grp_bk_t *grp_bk)
@@ -1023,6 +1087,7 @@ bcm56960_a0_trunk_drv_attach(bcmtrunk_drv_t *trunk_drv)
     trunk_drv->fn_grp_update       = &bcm56960_a0_trunk_grp_update;
     trunk_drv->fn_grp_del          = &bcm56960_a0_trunk_grp_del;
     trunk_drv->fn_grp_init         = &bcm56960_a0_trunk_grp_init;
+    trunk_drv->fn_grp_members_set  = &bcm56960_a0_trunk_grp_members_set;
     trunk_drv->fn_fast_grp_add     = &bcm56960_a0_trunk_fast_grp_add;
     trunk_drv->fn_fast_grp_del     = &bcm56960_a0_trunk_fast_grp_del;
     trunk_drv->fn_fast_grp_update  = &bcm56960_a0_trunk_fast_grp_update;
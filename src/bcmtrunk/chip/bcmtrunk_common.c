@@ -249,6 +249,29 @@ bcmtrunk_grp_del(int unit,
     }
 }
 
+int
+bcmtrunk_grp_members_set(int unit,
+                         bcmltd_sid_t lt_id,
+                         uint32_t trunk_id,
+                         uint32_t base_ptr,
+                         uint16_t old_cnt,
+                         const uint8_t *old_modid,
+                         const uint8_t *old_modport,
+                         uint16_t cnt,
+                         const uint8_t *modid,
+                         const uint8_t *modport)
+{
+    fn_grp_members_set_t my_fn;
+
+    if ((my_fn = trunk_drv[unit]->fn_grp_members_set) == NULL) {
+        return SHR_E_UNAVAIL;
+    } else {
+        return my_fn(unit, lt_id, trunk_id, base_ptr,
+                     old_cnt, old_modid, old_modport,
+                     cnt, modid, modport);
+    }
+}
+
 int
 bcmtrunk_grp_init(int unit, bcmtrunk_lth_grp_bk_t *grp_bk)
 {
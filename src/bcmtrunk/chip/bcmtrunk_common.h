@@ -128,6 +128,17 @@ typedef int (*fn_grp_del_t)(int unit,
 
 typedef int (*fn_grp_init_t)(int unit, bcmtrunk_lth_grp_bk_t *grp_bk);
 
+typedef int (*fn_grp_members_set_t)(int unit,
+                                    bcmltd_sid_t lt_id,
+                                    uint32_t trunk_id,
+                                    uint32_t base_ptr,
+                                    uint16_t old_cnt,
+                                    const uint8_t *old_modid,
+                                    const uint8_t *old_modport,
+                                    uint16_t cnt,
+                                    const uint8_t *modid,
+                                    const uint8_t *modport);
+
 
 typedef int (*fn_fast_grp_add_t)(int unit,
                                  uint32_t trans_id,
@@ -174,6 +185,7 @@ typedef struct bcmtrunk_drv_s {
     fn_grp_update_t                 fn_grp_update;
     fn_grp_del_t                    fn_grp_del;
     fn_grp_init_t                   fn_grp_init;
+    fn_grp_members_set_t            fn_grp_members_set;
     fn_fast_grp_add_t               fn_fast_grp_add;
     fn_fast_grp_update_t            fn_fast_grp_update;
     fn_fast_grp_del_t               fn_fast_grp_del;
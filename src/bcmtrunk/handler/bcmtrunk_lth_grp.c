@@ -102,6 +102,7 @@
 #include <bcmtrunk/bcmtrunk_util.h>
 #include <bcmtrunk/bcmtrunk_db.h>
 #include <bcmtrunk/bcmtrunk_chips.h>
+#include <bcmtrunk/bcmtrunk_prune.h>
 
 
 /*******************************************************************************
@@ -815,11 +816,14 @@ bcmtrunk_lth_grp_commit(int unit,
         SHR_RETURN_VAL_EXIT(SHR_E_NONE);
     }
 
+    bcmtrunk_prune_lock(unit);
     for (idx = 0; idx < BCMTRUNK_MAX_TRUNK; idx++) {
         if (SHR_BITGET(GRP_DIFF(unit), idx)) {
             GRP_HA(unit)->grp[idx] = GRP_TEMP(unit)->grp[idx];
+            bcmtrunk_prune_grp_sync(unit, idx);
         }
     }
+    bcmtrunk_prune_unlock(unit);
     sal_memcpy(GRP_HA(unit)->mbmp, GRP_TEMP(unit)->mbmp,
                SHR_BITALLOCSIZE(GRP_TEMP(unit)->member_size));
 
@@ -957,6 +961,8 @@ bcmtrunk_lth_grp_init(int unit, bool warm)
         SHR_ALLOC(GRP_DIFF(unit), alloc_size, "trunk bitmap diff");
         SHR_NULL_CHECK(GRP_DIFF(unit), SHR_E_MEMORY);
         sal_memset(GRP_DIFF(unit), 0, alloc_size);
+
+        SHR_IF_ERR_EXIT(bcmtrunk_prune_init(unit, GRP_HA(unit), warm));
     }
 
 exit:
@@ -971,6 +977,8 @@ bcmtrunk_lth_grp_cleanup(int unit)
 {
     SHR_FUNC_ENTER(unit);
 
+    (void) bcmtrunk_prune_cleanup(unit);
+
     if (GRP_HA(unit) != NULL) {
         if (GRP_HA(unit)->grp != NULL) {
             shr_ha_mem_free(unit, GRP_HA(unit)->grp);
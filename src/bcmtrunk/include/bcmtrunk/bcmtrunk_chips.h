@@ -188,6 +188,43 @@ bcmtrunk_grp_del(int unit,
                  bcmtrunk_lth_grp_bk_t *grp_bk,
                  bcmtrunk_group_param_t *param);
 
+/*!
+ * \brief Rewrite the unicast members of a trunk group in place.
+ *
+ * Used by member pruning to exclude ports outside of an LT transaction.
+ * The entries are written through interactive requests, which update
+ * PTcache as well. The caller must hold the lock taken with
+ * bcmptm_mreq_idle_lock(), so no modeled path write is pending. Only the
+ * member entries which differ from the old member list are written,
+ * followed by the group size if it changed. All member entries and the
+ * group size are written if \c old_modid or \c old_modport is NULL.
+ *
+ * \param [in] unit Logical device id.
+ * \param [in] lt_id Logical table id.
+ * \param [in] trunk_id Trunk id.
+ * \param [in] base_ptr Base pointer of the group in the member table.
+ * \param [in] old_cnt Number of members currently in hardware.
+ * \param [in] old_modid Module ids currently in hardware.
+ * \param [in] old_modport Module ports currently in hardware.
+ * \param [in] cnt Number of members to write.
+ * \param [in] modid Module ids to write.
+ * \param [in] modport Module ports to write.
+ *
+ * \retval SHR_E_NONE Success.
+ * \retval SHR_E_UNAVAIL Not supported by the device.
+ */
+extern int
+bcmtrunk_grp_members_set(int unit,
+                         bcmltd_sid_t lt_id,
+                         uint32_t trunk_id,
+                         uint32_t base_ptr,
+                         uint16_t old_cnt,
+                         const uint8_t *old_modid,
+                         const uint8_t *old_modport,
+                         uint16_t cnt,
+                         const uint8_t *modid,
+                         const uint8_t *modport);
+
 
 
 /*!
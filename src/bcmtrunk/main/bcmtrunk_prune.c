@@ -0,0 +1,587 @@
+/*! \file bcmtrunk_prune.c
+ *
+ * TRUNK member pruning on link down.
+ *
+ * The unicast member lists of trunk groups are rewritten with interactive
+ * writes when the Link Manager reports a port down through its fast
+ * failover event, without going through an LT transaction. The writes
+ * are only issued while the modeled path is idle and the WAL is empty,
+ * so PTcache is updated along with the hardware. The LT state is left
+ * untouched, and the member lists written by the LT handlers are pruned
+ * the same way while the port stays down.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+#include <bsl/bsl.h>
+#include <shr/shr_debug.h>
+#include <shr/shr_bitop.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_libc.h>
+#include <sal/sal_mutex.h>
+#include <bcmdrd_config.h>
+#include <bcmdrd/bcmdrd_types.h>
+#include <bcmltd/chip/bcmltd_id.h>
+#include <bcmevm/bcmevm_api.h>
+#include <bcmlm/bcmlm_failover.h>
+#include <bcmptm/bcmptm_scor_internal.h>
+#include <bcmtrunk/bcmtrunk_types.h>
+#include <bcmtrunk/bcmtrunk_chips.h>
+#include <bcmtrunk/bcmtrunk_prune.h>
+
+/*******************************************************************************
+ * Defines
+ */
+#define BSL_LOG_MODULE BSL_LS_BCMTRUNK_TABLE
+
+/* Event to resync pruned member lists from the event thread. */
+#define PRUNE_EV_RESYNC                 "bcmtrunkEvPruneResync"
+
+/* Time to wait for an LT transaction to complete from the event thread. */
+#define PRUNE_IDLE_WAIT_USECS           1000000
+
+/* Number of ports tracked by pruning. */
+#define PRUNE_PORT_MAX                  BCMDRD_CONFIG_MAX_PORTS
+
+/* Trunk groups which reference a port. */
+#define PRUNE_PORT_GRP(_tp, _port) \
+    ((_tp)->port_grp + (_port) * SHR_BITALLOCSIZE(BCMTRUNK_MAX_TRUNK) / \
+                                 sizeof(SHR_BITDCL))
+
+
+/*******************************************************************************
+ * Typedefs
+ */
+typedef struct trunk_prune_s {
+    /*! Protect pruning state and committed trunk groups. */
+    sal_mutex_t             lock;
+
+    /*! Committed trunk groups. */
+    bcmtrunk_lth_grp_bk_t   *grp_bk;
+
+    /*! Trunk groups referencing each port. */
+    SHR_BITDCL              *port_grp;
+
+    /*! Ports which are down. */
+    bcmdrd_pbmp_t           down;
+
+    /*! Ports which have been reported through fast failover. */
+    bcmdrd_pbmp_t           seen;
+
+    /*! Sequence number of the last link down event of each port. */
+    uint32_t                down_seq[PRUNE_PORT_MAX];
+
+    /*! Trunk groups to be rewritten from the event thread. */
+    SHR_BITDCLNAME(resync, BCMTRUNK_MAX_TRUNK);
+
+    /*! Resync event has been posted. */
+    bool                    resync_posted;
+
+    /*! Event ID of the resync event. */
+    uint32_t                resync_ev;
+} trunk_prune_t;
+
+
+/*******************************************************************************
+ * Private variables
+ */
+static trunk_prune_t *trunk_prune[BCMDRD_CONFIG_MAX_UNITS];
+
+
+/*******************************************************************************
+ * Private Functions
+ */
+static uint16_t
+prune_members(const bcmdrd_pbmp_t *down, uint16_t cnt,
+              const uint8_t *modid, const uint8_t *modport,
+              uint8_t *hw_modid, uint8_t *hw_modport)
+{
+    uint16_t head, tail;
+
+    sal_memcpy(hw_modid, modid, cnt);
+    sal_memcpy(hw_modport, modport, cnt);
+
+    for (head = 0; head < cnt; head++) {
+        if (!BCMDRD_PBMP_MEMBER(*down, modport[head])) {
+            break;
+        }
+    }
+    if (head == cnt) {
+        /* Nothing better to forward to. */
+        return cnt;
+    }
+
+    /* Fill the holes with the members at the end of the list. */
+    head = 0;
+    tail = cnt;
+    while (head < tail) {
+        if (!BCMDRD_PBMP_MEMBER(*down, hw_modport[head])) {
+            head++;
+            continue;
+        }
+        tail--;
+        hw_modid[head] = hw_modid[tail];
+        hw_modport[head] = hw_modport[tail];
+    }
+
+    return tail;
+}
+
+static void
+prune_resync_post(int unit, trunk_prune_t *tp)
+{
+    if (tp->resync_posted) {
+        return;
+    }
+    if (SHR_SUCCESS(bcmevm_publish_event_post(unit, tp->resync_ev, 0))) {
+        tp->resync_posted = TRUE;
+    }
+}
+
+/*
+ * Rewrite the trunk groups referencing a port after its state changed
+ * from old_down to the current down set. Unless the caller holds the
+ * idle modeled path lock, as indicated by hw, the groups are only queued
+ * for a resync from the event thread.
+ */
+static void
+prune_port_update(int unit, trunk_prune_t *tp, shr_port_t port,
+                  const bcmdrd_pbmp_t *old_down, bool hw)
+{
+    bcmtrunk_group_t *grp;
+    uint8_t old_modid[BCMTRUNK_MAX_MEMBERS];
+    uint8_t old_modport[BCMTRUNK_MAX_MEMBERS];
+    uint8_t modid[BCMTRUNK_MAX_MEMBERS];
+    uint8_t modport[BCMTRUNK_MAX_MEMBERS];
+    uint16_t old_cnt, cnt;
+    uint32_t trunk_id;
+    int rv;
+
+    SHR_BIT_ITER(PRUNE_PORT_GRP(tp, port), BCMTRUNK_MAX_TRUNK, trunk_id) {
+        grp = tp->grp_bk->grp + trunk_id;
+        if (!grp->inserted || grp->uc_cnt == 0) {
+            continue;
+        }
+        if (!hw) {
+            SHR_BITSET(tp->resync, trunk_id);
+            prune_resync_post(unit, tp);
+            continue;
+        }
+        old_cnt = prune_members(old_down, grp->uc_cnt,
+                                grp->uc_modid, grp->uc_modport,
+                                old_modid, old_modport);
+        cnt = prune_members(&tp->down, grp->uc_cnt,
+                            grp->uc_modid, grp->uc_modport,
+                            modid, modport);
+        if (old_cnt == cnt &&
+            sal_memcmp(old_modid, modid, cnt) == 0 &&
+            sal_memcmp(old_modport, modport, cnt) == 0) {
+            continue;
+        }
+        rv = bcmtrunk_grp_members_set(unit, TRUNKt, trunk_id,
+                                      grp->uc_base_ptr,
+                                      old_cnt, old_modid, old_modport,
+                                      cnt, modid, modport);
+        if (SHR_FAILURE(rv)) {
+            LOG_WARN(BSL_LOG_MODULE,
+                     (BSL_META_U(unit,
+                                 "Failed to prune port %d from trunk %u "
+                                 "(%d).\n"),
+                      port, trunk_id, rv));
+        }
+    }
+}
+
+/* Update the port to trunk group index for one trunk group. */
+static void
+prune_grp_index(trunk_prune_t *tp, uint32_t trunk_id)
+{
+    bcmtrunk_group_t *grp = tp->grp_bk->grp + trunk_id;
+    shr_port_t port;
+    uint16_t px;
+
+    for (port = 0; port < PRUNE_PORT_MAX; port++) {
+        SHR_BITCLR(PRUNE_PORT_GRP(tp, port), trunk_id);
+    }
+    if (!grp->inserted) {
+        return;
+    }
+    for (px = 0; px < grp->uc_cnt; px++) {
+        port = grp->uc_modport[px];
+        if (port < PRUNE_PORT_MAX) {
+            SHR_BITSET(PRUNE_PORT_GRP(tp, port), trunk_id);
+        }
+    }
+}
+
+/*
+ * Called synchronously from linkscan. The hardware is only written if no
+ * LT transaction is in progress, as waiting for one here would stall
+ * linkscan. Otherwise the affected groups are left to the resync.
+ */
+static void
+prune_link_down_hdl(int unit, const char *event, uint64_t ev_data)
+{
+    trunk_prune_t *tp = trunk_prune[unit];
+    shr_port_t port = BCMLM_FAILOVER_EV_PORT(ev_data);
+    bcmdrd_pbmp_t old_down;
+    bool hw;
+
+    if (tp == NULL || port >= PRUNE_PORT_MAX) {
+        return;
+    }
+
+    hw = SHR_SUCCESS(bcmptm_mreq_idle_lock(unit, SAL_MUTEX_NOWAIT));
+    sal_mutex_take(tp->lock, SAL_MUTEX_FOREVER);
+    tp->down_seq[port] = BCMLM_FAILOVER_EV_SEQ(ev_data);
+    if (!BCMDRD_PBMP_MEMBER(tp->down, port)) {
+        old_down = tp->down;
+        BCMDRD_PBMP_PORT_ADD(tp->down, port);
+        BCMDRD_PBMP_PORT_ADD(tp->seen, port);
+        prune_port_update(unit, tp, port, &old_down, hw);
+    }
+    sal_mutex_give(tp->lock);
+    if (hw) {
+        (void)bcmptm_mreq_idle_unlock(unit);
+    }
+}
+
+static void
+prune_link_up_hdl(int unit, const char *event, uint64_t ev_data)
+{
+    trunk_prune_t *tp = trunk_prune[unit];
+    shr_port_t port = BCMLM_FAILOVER_EV_PORT(ev_data);
+    uint32_t seq = BCMLM_FAILOVER_EV_SEQ(ev_data);
+    bcmdrd_pbmp_t old_down;
+    bool hw;
+
+    if (tp == NULL || port >= PRUNE_PORT_MAX) {
+        return;
+    }
+
+    hw = SHR_SUCCESS(bcmptm_mreq_idle_lock(unit, PRUNE_IDLE_WAIT_USECS));
+    sal_mutex_take(tp->lock, SAL_MUTEX_FOREVER);
+    /* Ignore if the port went down again after this event was posted. */
+    if ((int32_t)(seq - tp->down_seq[port]) > 0 &&
+        BCMDRD_PBMP_MEMBER(tp->down, port)) {
+        old_down = tp->down;
+        BCMDRD_PBMP_PORT_REMOVE(tp->down, port);
+        prune_port_update(unit, tp, port, &old_down, hw);
+    }
+    sal_mutex_give(tp->lock);
+    if (hw) {
+        (void)bcmptm_mreq_idle_unlock(unit);
+    }
+}
+
+/*
+ * Rewrite the member lists of queued trunk groups from the committed
+ * LT state. Member lists written through an LT transaction are pruned
+ * against the ports that were down when the LT operation was handled,
+ * so they may be stale by the time the transaction is committed. Link
+ * changes seen while a transaction was in progress are also applied
+ * here.
+ */
+static void
+prune_resync_hdl(int unit, const char *event, uint64_t ev_data)
+{
+    trunk_prune_t *tp = trunk_prune[unit];
+    bcmtrunk_group_t *grp;
+    uint8_t modid[BCMTRUNK_MAX_MEMBERS];
+    uint8_t modport[BCMTRUNK_MAX_MEMBERS];
+    uint32_t trunk_id;
+    uint16_t cnt;
+    int rv;
+
+    if (tp == NULL) {
+        return;
+    }
+
+    rv = bcmptm_mreq_idle_lock(unit, PRUNE_IDLE_WAIT_USECS);
+    sal_mutex_take(tp->lock, SAL_MUTEX_FOREVER);
+    tp->resync_posted = FALSE;
+    if (SHR_FAILURE(rv)) {
+        /* Try again once the transaction in progress is done. */
+        prune_resync_post(unit, tp);
+        sal_mutex_give(tp->lock);
+        return;
+    }
+    SHR_BIT_ITER(tp->resync, BCMTRUNK_MAX_TRUNK, trunk_id) {
+        SHR_BITCLR(tp->resync, trunk_id);
+        grp = tp->grp_bk->grp + trunk_id;
+        if (!grp->inserted || grp->uc_cnt == 0) {
+            continue;
+        }
+        cnt = prune_members(&tp->down, grp->uc_cnt,
+                            grp->uc_modid, grp->uc_modport,
+                            modid, modport);
+        rv = bcmtrunk_grp_members_set(unit, TRUNKt, trunk_id,
+                                      grp->uc_base_ptr,
+                                      0, NULL, NULL,
+                                      cnt, modid, modport);
+        if (SHR_FAILURE(rv)) {
+            LOG_WARN(BSL_LOG_MODULE,
+                     (BSL_META_U(unit,
+                                 "Failed to resync members of trunk %u "
+                                 "(%d).\n"),
+                      trunk_id, rv));
+        }
+    }
+    sal_mutex_give(tp->lock);
+    (void)bcmptm_mreq_idle_unlock(unit);
+}
+
+
+/*******************************************************************************
+ * Public Functions
+ */
+int
+bcmtrunk_prune_init(int unit, bcmtrunk_lth_grp_bk_t *grp_bk, bool warm)
+{
+    trunk_prune_t *tp = NULL;
+    uint32_t trunk_id;
+    size_t size;
+
+    SHR_FUNC_ENTER(unit);
+
+    if (trunk_prune[unit] != NULL) {
+        SHR_EXIT();
+    }
+
+    SHR_ALLOC(tp, sizeof(*tp), "bcmtrunk prune info");
+    SHR_NULL_CHECK(tp, SHR_E_MEMORY);
+    sal_memset(tp, 0, sizeof(*tp));
+    tp->grp_bk = grp_bk;
+
+    size = PRUNE_PORT_MAX * SHR_BITALLOCSIZE(BCMTRUNK_MAX_TRUNK);
+    SHR_ALLOC(tp->port_grp, size, "bcmtrunk prune port index");
+    SHR_NULL_CHECK(tp->port_grp, SHR_E_MEMORY);
+    sal_memset(tp->port_grp, 0, size);
+
+    tp->lock = sal_mutex_create("bcmtrunk prune lock");
+    SHR_NULL_CHECK(tp->lock, SHR_E_MEMORY);
+
+    SHR_IF_ERR_EXIT
+        (bcmevm_event_id_get(unit, PRUNE_EV_RESYNC, &tp->resync_ev));
+
+    for (trunk_id = 0; trunk_id < BCMTRUNK_MAX_TRUNK; trunk_id++) {
+        prune_grp_index(tp, trunk_id);
+        /*
+         * Hardware may still hold pruned member lists from before the
+         * warmboot, while no port is known to be down.
+         */
+        if (warm && grp_bk->grp[trunk_id].inserted) {
+            SHR_BITSET(tp->resync, trunk_id);
+        }
+    }
+    trunk_prune[unit] = tp;
+
+    SHR_IF_ERR_EXIT
+        (bcmevm_register_published_event(unit, PRUNE_EV_RESYNC,
+                                         prune_resync_hdl));
+    SHR_IF_ERR_EXIT
+        (bcmevm_register_published_event(unit, BCMLM_EV_LINK_DOWN_FAST,
+                                         prune_link_down_hdl));
+    SHR_IF_ERR_EXIT
+        (bcmevm_register_published_event(unit, BCMLM_EV_LINK_UP_FAST,
+                                         prune_link_up_hdl));
+
+    if (warm) {
+        prune_resync_post(unit, tp);
+    }
+
+exit:
+    if (SHR_FUNC_ERR() && tp != NULL) {
+        if (trunk_prune[unit] == tp) {
+            (void)bcmtrunk_prune_cleanup(unit);
+        } else {
+            if (tp->lock != NULL) {
+                sal_mutex_destroy(tp->lock);
+            }
+            SHR_FREE(tp->port_grp);
+            SHR_FREE(tp);
+        }
+    }
+    SHR_FUNC_EXIT();
+}
+
+int
+bcmtrunk_prune_cleanup(int unit)
+{
+    trunk_prune_t *tp = trunk_prune[unit];
+
+    SHR_FUNC_ENTER(unit);
+
+    if (tp == NULL) {
+        SHR_EXIT();
+    }
+
+    (void)bcmevm_unregister_published_event(unit, BCMLM_EV_LINK_DOWN_FAST,
+                                            prune_link_down_hdl);
+    (void)bcmevm_unregister_published_event(unit, BCMLM_EV_LINK_UP_FAST,
+                                            prune_link_up_hdl);
+    (void)bcmevm_unregister_published_event(unit, PRUNE_EV_RESYNC,
+                                            prune_resync_hdl);
+
+    trunk_prune[unit] = NULL;
+    if (tp->lock != NULL) {
+        sal_mutex_destroy(tp->lock);
+    }
+    SHR_FREE(tp->port_grp);
+    SHR_FREE(tp);
+
+exit:
+    SHR_FUNC_EXIT();
+}
+
+void
+bcmtrunk_prune_lock(int unit)
+{
+    trunk_prune_t *tp = trunk_prune[unit];
+
+    if (tp != NULL) {
+        sal_mutex_take(tp->lock, SAL_MUTEX_FOREVER);
+    }
+}
+
+void
+bcmtrunk_prune_unlock(int unit)
+{
+    trunk_prune_t *tp = trunk_prune[unit];
+
+    if (tp != NULL) {
+        sal_mutex_give(tp->lock);
+    }
+}
+
+void
+bcmtrunk_prune_grp_sync(int unit, uint32_t trunk_id)
+{
+    trunk_prune_t *tp = trunk_prune[unit];
+    bcmtrunk_group_t *grp;
+    uint16_t px;
+
+    if (tp == NULL || trunk_id >= BCMTRUNK_MAX_TRUNK) {
+        return;
+    }
+
+    prune_grp_index(tp, trunk_id);
+
+    grp = tp->grp_bk->grp + trunk_id;
+    if (!grp->inserted) {
+        SHR_BITCLR(tp->resync, trunk_id);
+        return;
+    }
+    for (px = 0; px < grp->uc_cnt; px++) {
+        if (BCMDRD_PBMP_MEMBER(tp->seen, grp->uc_modport[px])) {
+            SHR_BITSET(tp->resync, trunk_id);
+            prune_resync_post(unit, tp);
+            break;
+        }
+    }
+}
+
+uint16_t
+bcmtrunk_prune_members_get(int unit, uint16_t cnt,
+                           const uint8_t *modid, const uint8_t *modport,
+                           uint8_t *hw_modid, uint8_t *hw_modport)
+{
+    trunk_prune_t *tp = trunk_prune[unit];
+    bcmdrd_pbmp_t down;
+
+    if (tp == NULL) {
+        sal_memcpy(hw_modid, modid, cnt);
+        sal_memcpy(hw_modport, modport, cnt);
+        return cnt;
+    }
+
+    sal_mutex_take(tp->lock, SAL_MUTEX_FOREVER);
+    down = tp->down;
+    sal_mutex_give(tp->lock);
+
+    return prune_members(&down, cnt, modid, modport, hw_modid, hw_modport);
+}
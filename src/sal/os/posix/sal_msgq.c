@@ -99,8 +99,429 @@
 #include <sal/sal_time.h>
 #include <sal/sal_msgq.h>
 
+/*
+ * Default configuration
+ *
+ * The lock-free ring requires Linux futexes and GCC atomics. It must be
+ * enabled explicitly, e.g. -DSAL_MSGQ_USE_MPSC_RING=1, until it has seen
+ * the same exposure as the mutex based queue.
+ */
+#ifndef SAL_MSGQ_USE_MPSC_RING
+#define SAL_MSGQ_USE_MPSC_RING          0
+#endif
+#if SAL_MSGQ_USE_MPSC_RING && \
+    !(defined(__linux__) && defined(__ATOMIC_SEQ_CST))
+#error "SAL_MSGQ_USE_MPSC_RING requires Linux and GCC atomics"
+#endif
+
+/* Optionally dump configuration */
+#include <sal/sal_internal.h>
+#if SAL_INT_DUMP_CONFIG
+#pragma message(SAL_INT_VAR_VALUE(SAL_MSGQ_USE_MPSC_RING))
+#endif
+
 #define SAL_MSGQ_SIGNATURE   0x8532b9d0
 
+#if SAL_MSGQ_USE_MPSC_RING
+
+/*
+ * Lock-free implementation of the message queue.
+ *
+ * Every priority level has its own bounded ring of message cells. Each
+ * cell carries a sequence number which indicates whether the cell is free
+ * for the producer at a given ring position or holds a message for the
+ * consumer at that position. Producers claim a position by advancing the
+ * ring tail and consumers claim a position by advancing the ring head, so
+ * posting and receiving never take a lock. Although the queue is optimized
+ * for a single consumer, multiple consumers are safe as well.
+ *
+ * The total number of messages is limited to max_elements across all
+ * priorities. A producer reserves room in the queue before it claims a
+ * ring position, and a consumer releases the room only after the cell was
+ * made available again. Therefore every ring (sized to hold max_elements)
+ * always has a free cell for a producer that has reserved room.
+ *
+ * Threads only enter the kernel (futex) when they need to block, i.e. the
+ * receiver when the queue is empty and the sender when the queue is full.
+ * A thread that is about to block sets the parked flag of its side before
+ * it checks the queue one last time. The other side clears the flag and
+ * issues the wake-up call only if the flag was set, so a parked thread
+ * costs a single system call regardless of the number of messages that
+ * are exchanged while it is waking up.
+ */
+
+#include <limits.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/* Keep the producer and consumer indices in separate cache lines */
+#define RING_CACHE_LINE         64
+
+/* Atomic access helpers */
+#define ATOMIC_LOAD(_p, _mo)            __atomic_load_n(_p, _mo)
+#define ATOMIC_STORE(_p, _v, _mo)       __atomic_store_n(_p, _v, _mo)
+#define ATOMIC_ADD(_p, _v)              __atomic_fetch_add(_p, _v, __ATOMIC_SEQ_CST)
+#define ATOMIC_SUB(_p, _v)              __atomic_fetch_sub(_p, _v, __ATOMIC_SEQ_CST)
+#define ATOMIC_CAS(_p, _exp, _v) \
+    __atomic_compare_exchange_n(_p, _exp, _v, true, \
+                                __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)
+#define ATOMIC_FENCE()                  __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+typedef struct ring_cell_s {
+    size_t seq;
+    uint8_t data[];
+} ring_cell_t;
+
+typedef struct ring_s {
+    uint8_t *cells;
+    size_t cell_size;
+    size_t mask;
+    uint8_t pad0[RING_CACHE_LINE];
+    size_t tail;    /* Next position to produce into */
+    uint8_t pad1[RING_CACHE_LINE - sizeof(size_t)];
+    size_t head;    /* Next position to consume from */
+    uint8_t pad2[RING_CACHE_LINE - sizeof(size_t)];
+} ring_t;
+
+typedef struct ring_ctrl_s {
+    uint32_t signature;
+    size_t element_size;
+    size_t max_elements;
+    ring_t rings[SAL_MSGQ_PRIORITIES];
+    size_t num_of_element;      /* Reserved and queued elements */
+    uint32_t recv_parked;       /* Receivers are (about to be) parked */
+    uint32_t post_parked;       /* Senders are (about to be) parked */
+    const char *desc;
+} ring_ctrl_t;
+
+#define RING_CELL(_r, _pos) \
+    ((ring_cell_t *)((_r)->cells + ((_pos) & (_r)->mask) * (_r)->cell_size))
+
+static int
+ring_init(ring_t *ring, size_t element_size, size_t max_elements)
+{
+    size_t size = 1;
+    size_t j;
+
+    while (size < max_elements) {
+        size <<= 1;
+    }
+    /* Keep the sequence numbers naturally aligned */
+    ring->cell_size = (sizeof(ring_cell_t) + element_size +
+                       sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+    ring->cells = (uint8_t *)malloc(ring->cell_size * size);
+    if (!ring->cells) {
+        return -1;
+    }
+    ring->mask = size - 1;
+    for (j = 0; j < size; j++) {
+        RING_CELL(ring, j)->seq = j;
+    }
+    ring->head = 0;
+    ring->tail = 0;
+    return 0;
+}
+
+static bool
+ring_push(ring_t *ring, void *element, size_t element_size)
+{
+    ring_cell_t *cell;
+    size_t pos = ATOMIC_LOAD(&ring->tail, __ATOMIC_RELAXED);
+    intptr_t diff;
+
+    while (1) {
+        cell = RING_CELL(ring, pos);
+        diff = (intptr_t)ATOMIC_LOAD(&cell->seq, __ATOMIC_ACQUIRE) -
+               (intptr_t)pos;
+        if (diff == 0) {
+            if (ATOMIC_CAS(&ring->tail, &pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The ring is full */
+            return false;
+        } else {
+            pos = ATOMIC_LOAD(&ring->tail, __ATOMIC_RELAXED);
+        }
+    }
+    memcpy(cell->data, element, element_size);
+    /* Publish the message to the consumer */
+    ATOMIC_STORE(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static bool
+ring_pop(ring_t *ring, void *element, size_t element_size)
+{
+    ring_cell_t *cell;
+    size_t pos = ATOMIC_LOAD(&ring->head, __ATOMIC_RELAXED);
+    intptr_t diff;
+
+    while (1) {
+        cell = RING_CELL(ring, pos);
+        diff = (intptr_t)ATOMIC_LOAD(&cell->seq, __ATOMIC_ACQUIRE) -
+               (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (ATOMIC_CAS(&ring->head, &pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The ring is empty (or the next message is not published yet) */
+            return false;
+        } else {
+            pos = ATOMIC_LOAD(&ring->head, __ATOMIC_RELAXED);
+        }
+    }
+    memcpy(element, cell->data, element_size);
+    /* Return the cell to the producers for the next lap */
+    ATOMIC_STORE(&cell->seq, pos + ring->mask + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static bool
+ring_pop_pri(ring_ctrl_t *mq, void *element)
+{
+    int j;
+
+    for (j = SAL_MSGQ_MAX_PRIORITY; j >= SAL_MSGQ_MIN_PRIORITY; j--) {
+        if (ring_pop(&mq->rings[j], element, mq->element_size)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint64_t
+_now_usecs(void)
+{
+    struct timespec ts;
+
+#if defined(CLOCK_MONOTONIC)
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+    return (uint64_t)ts.tv_sec * SECOND_USEC + ts.tv_nsec / 1000;
+}
+
+/*
+ * Park the calling thread as long as the parked flag is still set.
+ * Returns SAL_MSGQ_E_TIMEOUT if the deadline passed, otherwise 0 (which
+ * includes spurious wake-ups).
+ */
+static int
+_park(uint32_t *parked, uint32_t usec, uint64_t deadline)
+{
+    struct timespec ts, *pts = NULL;
+    uint64_t now;
+
+    if (usec != SAL_MSGQ_FOREVER) {
+        now = _now_usecs();
+        if (now >= deadline) {
+            return SAL_MSGQ_E_TIMEOUT;
+        }
+        ts.tv_sec = (deadline - now) / SECOND_USEC;
+        ts.tv_nsec = ((deadline - now) % SECOND_USEC) * 1000;
+        pts = &ts;
+    }
+    if (syscall(SYS_futex, parked, FUTEX_WAIT_PRIVATE, 1,
+                pts, NULL, 0) != 0) {
+        if (errno == ETIMEDOUT) {
+            return SAL_MSGQ_E_TIMEOUT;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Wake up all the threads that are parked on the flag. The caller must
+ * issue a full memory barrier between updating the queue and calling
+ * this function.
+ */
+static void
+_unpark(uint32_t *parked)
+{
+    if (ATOMIC_LOAD(parked, __ATOMIC_RELAXED) &&
+        __atomic_exchange_n(parked, 0, __ATOMIC_SEQ_CST)) {
+        syscall(SYS_futex, parked, FUTEX_WAKE_PRIVATE, INT_MAX,
+                NULL, NULL, 0);
+    }
+}
+
+sal_msgq_t
+sal_msgq_create(size_t element_size, size_t max_elements, const char *desc)
+{
+    ring_ctrl_t *mq;
+    int j;
+
+    if (max_elements == 0) {
+        return NULL;
+    }
+    mq = (ring_ctrl_t *)malloc(sizeof(ring_ctrl_t));
+    if (!mq) {
+        return NULL;
+    }
+    memset(mq, 0, sizeof(*mq));
+    for (j = 0; j < SAL_MSGQ_PRIORITIES; j++) {
+        if (ring_init(&mq->rings[j], element_size, max_elements) != 0) {
+            break;
+        }
+    }
+    if (j < SAL_MSGQ_PRIORITIES) {
+        /* Free all allocated resources and return failure */
+        while (--j >= 0) {
+            free(mq->rings[j].cells);
+        }
+        free(mq);
+        return NULL;
+    }
+    mq->desc = desc;
+    mq->element_size = element_size;
+    mq->max_elements = max_elements;
+    mq->signature = SAL_MSGQ_SIGNATURE;
+    return (sal_msgq_t)mq;
+}
+
+void
+sal_msgq_destroy(sal_msgq_t msgq_hdl)
+{
+    ring_ctrl_t *mq = (ring_ctrl_t *)msgq_hdl;
+    int j;
+
+    /* Input validation */
+    if (!mq || (mq->signature != SAL_MSGQ_SIGNATURE)) {
+        return;
+    }
+
+    /* Release Q resources */
+    for (j = 0; j < SAL_MSGQ_PRIORITIES; j++) {
+        free(mq->rings[j].cells);
+    }
+    free(mq);
+}
+
+int
+sal_msgq_post(sal_msgq_t msgq_hdl,
+              void *element,
+              sal_msgq_priority_t pri,
+              uint32_t usec)
+{
+    ring_ctrl_t *mq = (ring_ctrl_t *)msgq_hdl;
+    uint64_t deadline = 0;
+    size_t cnt;
+    int rv;
+
+    /* Input validation */
+    if (!mq || (mq->signature != SAL_MSGQ_SIGNATURE) ||
+        (pri < SAL_MSGQ_MIN_PRIORITY) || (pri > SAL_MSGQ_MAX_PRIORITY)) {
+        return SAL_MSGQ_E_INVALID_PARAM;
+    }
+
+    if (usec != SAL_MSGQ_FOREVER && usec != SAL_MSGQ_NOWAIT) {
+        deadline = _now_usecs() + usec;
+    }
+
+    /* Reserve room in the queue */
+    cnt = ATOMIC_LOAD(&mq->num_of_element, __ATOMIC_RELAXED);
+    while (1) {
+        if (cnt < mq->max_elements) {
+            if (ATOMIC_CAS(&mq->num_of_element, &cnt, cnt + 1)) {
+                break;
+            }
+            continue;
+        }
+        /* Need to wait until there is room */
+        if (usec == SAL_MSGQ_NOWAIT) { /* Return error if can't wait */
+            return SAL_MSGQ_E_TIMEOUT;
+        }
+        ATOMIC_STORE(&mq->post_parked, 1, __ATOMIC_RELAXED);
+        ATOMIC_FENCE();
+        /* Check again now that the receivers can see us */
+        if (ATOMIC_LOAD(&mq->num_of_element, __ATOMIC_RELAXED) >=
+            mq->max_elements) {
+            rv = _park(&mq->post_parked, usec, deadline);
+            if (rv != 0 &&
+                ATOMIC_LOAD(&mq->num_of_element, __ATOMIC_RELAXED) >=
+                mq->max_elements) {
+                return rv;
+            }
+        }
+        cnt = ATOMIC_LOAD(&mq->num_of_element, __ATOMIC_RELAXED);
+    }
+
+    if (!ring_push(&mq->rings[pri], element, mq->element_size)) {
+        /* Should never happen since room was reserved */
+        ATOMIC_SUB(&mq->num_of_element, 1);
+        rv = __LINE__;
+        return -rv;
+    }
+
+    /* Wake up pending receivers (if any) */
+    ATOMIC_FENCE();
+    _unpark(&mq->recv_parked);
+    return 0;
+}
+
+int
+sal_msgq_recv(sal_msgq_t msgq_hdl, void *element, uint32_t usec)
+{
+    ring_ctrl_t *mq = (ring_ctrl_t *)msgq_hdl;
+    uint64_t deadline = 0;
+    int rv;
+
+    /* Input validation */
+    if (!mq || (mq->signature != SAL_MSGQ_SIGNATURE)) {
+        return SAL_MSGQ_E_INVALID_PARAM;
+    }
+
+    if (usec != SAL_MSGQ_FOREVER && usec != SAL_MSGQ_NOWAIT) {
+        deadline = _now_usecs() + usec;
+    }
+
+    while (!ring_pop_pri(mq, element)) {
+        /* Need to wait, does the caller willing too? */
+        if (usec == SAL_MSGQ_NOWAIT) { /* Return error if can't wait */
+            rv = __LINE__;
+            return -rv;
+        }
+        ATOMIC_STORE(&mq->recv_parked, 1, __ATOMIC_RELAXED);
+        ATOMIC_FENCE();
+        /* Check again now that the senders can see us */
+        if (ring_pop_pri(mq, element)) {
+            break;
+        }
+        rv = _park(&mq->recv_parked, usec, deadline);
+        if (rv != 0) {
+            return rv;
+        }
+    }
+
+    /*
+     * Release the room and wake up pending senders (if any). A sender
+     * with a timeout must not time out while there is room in the queue.
+     * The wake-up costs a system call only if a sender is parked.
+     */
+    ATOMIC_SUB(&mq->num_of_element, 1);
+    ATOMIC_FENCE();
+    _unpark(&mq->post_parked);
+    return 0;
+}
+
+size_t
+sal_msgq_count_get(sal_msgq_t msgq_hdl)
+{
+    ring_ctrl_t *mq = (ring_ctrl_t *)msgq_hdl;
+
+    /* Input validation */
+    if (!mq || (mq->signature != SAL_MSGQ_SIGNATURE)) {
+        return 0;
+    }
+    return ATOMIC_LOAD(&mq->num_of_element, __ATOMIC_RELAXED);
+}
+
+#else
+
+
 typedef struct basic_element_s {
     struct basic_element_s *next;
     uint8_t data[];
@@ -498,3 +919,5 @@ sal_msgq_count_get(sal_msgq_t msgq_hdl)
     /* No need to lock the queue as this value being updated atomically */
     return mq->num_of_element;
 }
+
+#endif /* SAL_MSGQ_USE_MPSC_RING */
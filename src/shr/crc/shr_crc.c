@@ -92,6 +92,46 @@
 #include <sal/sal_libc.h>
 #include <shr/shr_crc.h>
 
+/*
+ * The CRC32 functions use the reflected CRC32 (polynomial 0xedb88320)
+ * with the CRC value held in byte-swapped form, and the CRC16 functions
+ * use the reflected CRC16 (polynomial 0xa001). The byte-aligned part of
+ * the data is processed eight bytes at a time using slicing-by-8 tables,
+ * where table k holds the CRC of a byte value followed by k zero bytes.
+ *
+ * On x86-64 processors that support carry-less multiplication, long
+ * CRC32 buffers are folded 16 bytes at a time using PCLMULQDQ. The
+ * instruction set is detected at run time.
+ */
+
+/* Default configuration */
+#ifndef SHR_CRC_USE_PCLMUL
+#  if defined(__x86_64__) && \
+      ((defined(__GNUC__) && (__GNUC__ >= 5)) || defined(__clang__))
+#    define SHR_CRC_USE_PCLMUL          1
+#  endif
+#endif
+#ifndef SHR_CRC_USE_PCLMUL
+#define SHR_CRC_USE_PCLMUL              0
+#endif
+
+#if SHR_CRC_USE_PCLMUL
+#include <immintrin.h>
+#endif
+
+/* Minimum number of bytes for the carry-less multiplication path */
+#define CRC32_PCLMUL_MIN_BYTES          64
+
+#define CRC32_POLY                      0xedb88320UL
+#define CRC16_POLY                      0xa001
+
+static int shr_crc_slice_inited;
+static uint32_t crc32_slice[8][256];
+static uint16_t crc16_slice[8][256];
+#if SHR_CRC_USE_PCLMUL
+static int crc32_pclmul;
+#endif
+
 static uint32_t
 shr_swap32(uint32_t i)
 {
@@ -119,76 +159,238 @@ shr_bit_rev_by_byte_word32(uint32_t n)
     return n;
 }
 
-
-static int shr_crc_table_inited;
-static uint32_t shr_crc_table[256];
-
-uint32_t
-shr_crc32(uint32_t crc, uint8_t *data, int len)
+static void
+crc_slice_init(void)
 {
-    int i;
+    int i, k;
+    int j;
+    uint32_t accum;
 
-    if (!shr_crc_table_inited) {
-        int j;
-        uint32_t accum;
+    for (i = 0; i < 256; i++) {
+        accum = i;
+        for (j = 0; j < 8; j++) {
+            accum = (accum & 1) ? (accum >> 1 ^ CRC32_POLY) : (accum >> 1);
+        }
+        crc32_slice[0][i] = accum;
 
+        accum = i;
+        for (j = 0; j < 8; j++) {
+            accum = (accum & 1) ? (accum >> 1 ^ CRC16_POLY) : (accum >> 1);
+        }
+        crc16_slice[0][i] = accum;
+    }
+    for (k = 1; k < 8; k++) {
         for (i = 0; i < 256; i++) {
-            accum = i;
+            accum = crc32_slice[k - 1][i];
+            crc32_slice[k][i] = (accum >> 8) ^ crc32_slice[0][accum & 0xff];
+            accum = crc16_slice[k - 1][i];
+            crc16_slice[k][i] = (accum >> 8) ^ crc16_slice[0][accum & 0xff];
+        }
+    }
+#if SHR_CRC_USE_PCLMUL
+    __builtin_cpu_init();
+    crc32_pclmul = __builtin_cpu_supports("pclmul") &&
+                   __builtin_cpu_supports("sse4.1");
+#endif
+    shr_crc_slice_inited = 1;
+}
 
-            for (j = 0; j < 8; j++) {
-                if (accum & 1) {
-                    accum = accum >> 1 ^ 0xedb88320UL;
-                } else {
-                    accum = accum >> 1;
-                }
-            }
+#define CRC_SLICE_INIT()                \
+    do {                                \
+        if (!shr_crc_slice_inited) {    \
+            crc_slice_init();           \
+        }                               \
+    } while (0)
 
-            shr_crc_table[i] = shr_swap32(accum);
-        }
+#define LOAD32_LE(_p) \
+    ((uint32_t)(_p)[0] | (uint32_t)(_p)[1] << 8 | \
+     (uint32_t)(_p)[2] << 16 | (uint32_t)(_p)[3] << 24)
+
+/* Process eight bytes of reflected CRC32 */
+static inline uint32_t
+crc32_slice8(uint32_t r, const uint8_t *p)
+{
+    uint32_t lo = r ^ LOAD32_LE(p);
+    uint32_t hi = LOAD32_LE(p + 4);
 
-        shr_crc_table_inited = 1;
+    return crc32_slice[7][lo & 0xff] ^ crc32_slice[6][(lo >> 8) & 0xff] ^
+           crc32_slice[5][(lo >> 16) & 0xff] ^ crc32_slice[4][lo >> 24] ^
+           crc32_slice[3][hi & 0xff] ^ crc32_slice[2][(hi >> 8) & 0xff] ^
+           crc32_slice[1][(hi >> 16) & 0xff] ^ crc32_slice[0][hi >> 24];
+}
+
+/* Process eight bytes of reflected CRC16 */
+static inline uint32_t
+crc16_slice8(uint32_t r, const uint8_t *p)
+{
+    uint32_t lo = r ^ ((uint32_t)p[0] | (uint32_t)p[1] << 8);
+
+    return crc16_slice[7][lo & 0xff] ^ crc16_slice[6][lo >> 8] ^
+           crc16_slice[5][p[2]] ^ crc16_slice[4][p[3]] ^
+           crc16_slice[3][p[4]] ^ crc16_slice[2][p[5]] ^
+           crc16_slice[1][p[6]] ^ crc16_slice[0][p[7]];
+}
+
+#if SHR_CRC_USE_PCLMUL
+/*
+ * Fold the reflected CRC32 over a buffer of (len >= 16) bytes where len
+ * is a multiple of 16, using carry-less multiplication and a final
+ * Barrett reduction.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t
+crc32_pclmul_update(uint32_t r, const uint8_t *p, size_t len)
+{
+    const __m128i k4k3 = _mm_set_epi64x(0x00ccaa009eULL, 0x01751997d0ULL);
+    const __m128i k5 = _mm_set_epi64x(0, 0x0163cd6124ULL);
+    const __m128i poly_u = _mm_set_epi64x(0x01f7011641ULL, 0x01db710641ULL);
+    const __m128i mask32 = _mm_set_epi32(0, 0, 0, -1);
+    __m128i x, t;
+
+    x = _mm_loadu_si128((const __m128i *)p);
+    x = _mm_xor_si128(x, _mm_cvtsi32_si128((int)r));
+    p += 16;
+    len -= 16;
+
+    /* Fold 128 bits at a time */
+    while (len >= 16) {
+        t = _mm_clmulepi64_si128(x, k4k3, 0x11);
+        x = _mm_clmulepi64_si128(x, k4k3, 0x00);
+        x = _mm_xor_si128(x, t);
+        x = _mm_xor_si128(x, _mm_loadu_si128((const __m128i *)p));
+        p += 16;
+        len -= 16;
     }
 
-    for (i = 0; i < len; i++) {
-        crc = crc << 8 ^ shr_crc_table[crc >> 24 ^ data[i]];
+    /* Fold 128 bits to 64 bits */
+    t = _mm_clmulepi64_si128(x, k4k3, 0x10);
+    x = _mm_xor_si128(_mm_srli_si128(x, 8), t);
+    t = _mm_srli_si128(x, 4);
+    x = _mm_and_si128(x, mask32);
+    x = _mm_clmulepi64_si128(x, k5, 0x00);
+    x = _mm_xor_si128(x, t);
+
+    /* Barrett reduction 64 bits to 32 bits */
+    t = x;
+    x = _mm_and_si128(x, mask32);
+    x = _mm_clmulepi64_si128(x, poly_u, 0x10);
+    x = _mm_and_si128(x, mask32);
+    x = _mm_clmulepi64_si128(x, poly_u, 0x00);
+    x = _mm_xor_si128(x, t);
+
+    return (uint32_t)_mm_extract_epi32(x, 1);
+}
+#endif
+
+/* Update the reflected CRC32 with a byte-aligned buffer */
+static uint32_t
+crc32_refl_update(uint32_t r, const uint8_t *p, size_t len)
+{
+#if SHR_CRC_USE_PCLMUL
+    size_t n;
+
+    if (crc32_pclmul && len >= CRC32_PCLMUL_MIN_BYTES) {
+        n = len & ~(size_t)15;
+        r = crc32_pclmul_update(r, p, n);
+        p += n;
+        len -= n;
+    }
+#endif
+    while (len >= 8) {
+        r = crc32_slice8(r, p);
+        p += 8;
+        len -= 8;
     }
+    if (len >= 4) {
+        r ^= LOAD32_LE(p);
+        r = crc32_slice[3][r & 0xff] ^ crc32_slice[2][(r >> 8) & 0xff] ^
+            crc32_slice[1][(r >> 16) & 0xff] ^ crc32_slice[0][r >> 24];
+        p += 4;
+        len -= 4;
+    }
+    while (len--) {
+        r = (r >> 8) ^ crc32_slice[0][(r ^ *p++) & 0xff];
+    }
+    return r;
+}
 
-    return crc;
+/* Update the reflected CRC16 with a byte-aligned buffer */
+static uint32_t
+crc16_refl_update(uint32_t r, const uint8_t *p, size_t len)
+{
+    while (len >= 8) {
+        r = crc16_slice8(r, p);
+        p += 8;
+        len -= 8;
+    }
+    if (len >= 4) {
+        r ^= (uint32_t)p[0] | (uint32_t)p[1] << 8;
+        r = crc16_slice[3][r & 0xff] ^ crc16_slice[2][r >> 8] ^
+            crc16_slice[1][p[2]] ^ crc16_slice[0][p[3]];
+        p += 4;
+        len -= 4;
+    }
+    while (len--) {
+        r = (r >> 8) ^ crc16_slice[0][(r ^ *p++) & 0xff];
+    }
+    return r;
 }
 
-uint32_t
-shr_crc32b(uint32_t crc, uint8_t *data, int nbits)
+/* Process the last (less than 8) bits of the CRC32 data */
+static uint32_t
+crc32b_last_bits(uint32_t crc, uint8_t data, int last_nbits)
 {
-    int i;
-    int j;
     uint32_t accum;
-    uint32_t poly = 0xedb88320UL;
-    int last_nbits;
+    int j;
 
-    if (!shr_crc_table_inited) {
-        for (i = 0; i < 256; i++) {
-            accum = i;
+    accum = ((crc >> (32 - last_nbits)) & ((1 << last_nbits) - 1)) ^
+            (data & ((1 << last_nbits) - 1));
+    for (j = 0; j < last_nbits; j++) {
+        accum = (accum & 1) ? (accum >> 1 ^ CRC32_POLY) : (accum >> 1);
+    }
+    return (crc << last_nbits) ^ shr_swap32(accum);
+}
 
-            for (j = 0; j < 8; j++) {
-                accum = (accum & 1) ? (accum >> 1 ^ poly) : (accum >> 1);
-            }
-            shr_crc_table[i] = shr_swap32(accum);
-        }
-        shr_crc_table_inited = 1;
+/* Process the last (less than 8) bits of the CRC16 data */
+static int
+crc16b_last_bits(int crc, uint8_t data, int last_nbits)
+{
+    uint32_t accum;
+    int j;
+
+    accum = (crc & ((1 << last_nbits) - 1)) ^
+            (data & ((1 << last_nbits) - 1));
+    for (j = 0; j < last_nbits; j++) {
+        accum = (accum & 1) ? (accum >> 1 ^ CRC16_POLY) : (accum >> 1);
     }
+    return (crc >> last_nbits) ^ accum;
+}
+
+uint32_t
+shr_crc32(uint32_t crc, uint8_t *data, int len)
+{
+    CRC_SLICE_INIT();
 
-    for (i = 0; i < (nbits / 8); i++) {
-        crc = (crc << 8) ^ shr_crc_table[data[i] ^ ((crc >> 24) & 0x000FF)];
+    if (len <= 0) {
+        return crc;
     }
+    return shr_swap32(crc32_refl_update(shr_swap32(crc), data, len));
+}
 
-    last_nbits =  nbits % 8;
-    if (last_nbits) {
-        accum = ((crc >> (32 - last_nbits)) & ((1 << last_nbits) - 1)) ^
-                (data[i]  & ((1 << last_nbits) - 1));
-        for (j = 0; j < last_nbits; j++) {
-            accum = (accum & 1) ? (accum >> 1 ^ poly) : (accum >> 1);
-        }
-        crc = (crc << last_nbits) ^ shr_swap32(accum);
+uint32_t
+shr_crc32b(uint32_t crc, uint8_t *data, int nbits)
+{
+    int nbytes;
+
+    CRC_SLICE_INIT();
+
+    if (nbits <= 0) {
+        return crc;
+    }
+    nbytes = nbits / 8;
+    crc = shr_swap32(crc32_refl_update(shr_swap32(crc), data, nbytes));
+    if (nbits % 8) {
+        crc = crc32b_last_bits(crc, data[nbytes], nbits % 8);
     }
 
     return crc;
@@ -225,43 +427,27 @@ shr_crc16(int start, uint8_t *p, int n)
     return(crc);
 }
 
-static int shr_crc16b_table_inited;
-static uint32_t shr_crc_16btable[256];
-
 uint16_t
 shr_crc16b(int crc, uint8_t *data, int nbits)
 {
     int i;
-    int j;
-    uint32_t accum;
-    uint32_t poly = 0xa001;
-    int last_nbits;
-
-    if (!shr_crc16b_table_inited) {
-        for (i = 0; i < 256; i++) {
-            accum = i;
+    int nbytes;
 
-            for (j = 0; j < 8; j++) {
-                accum = (accum & 1) ? (accum >> 1 ^ poly) : (accum >> 1);
-            }
-            shr_crc_16btable[i] = accum;
-        }
-        shr_crc16b_table_inited = 1;
-    }
+    CRC_SLICE_INIT();
 
-    for (i = 0; i < (nbits / 8); i++) {
-        crc = (crc >> 8) ^ shr_crc_16btable[((data[i] & 0x000000FF) << 0) ^
-                                             (crc & 0x000000FF)];
+    if (nbits <= 0) {
+        return crc;
     }
-
-    last_nbits =  nbits % 8;
-    if (last_nbits) {
-        accum = (crc & ((1 << last_nbits) - 1)) ^
-                (data[i]  & ((1 << last_nbits) - 1));
-        for (j = 0; j < last_nbits; j++) {
-            accum = (accum & 1) ? (accum >> 1 ^ poly) : (accum >> 1);
+    nbytes = nbits / 8;
+    if ((crc & ~0xffff) == 0) {
+        crc = crc16_refl_update(crc, data, nbytes);
+    } else {
+        for (i = 0; i < nbytes; i++) {
+            crc = (crc >> 8) ^ crc16_slice[0][data[i] ^ (crc & 0x000000FF)];
         }
-        crc = (crc >> last_nbits) ^ accum;
+    }
+    if (nbits % 8) {
+        crc = crc16b_last_bits(crc, data[nbytes], nbits % 8);
     }
 
     return crc;
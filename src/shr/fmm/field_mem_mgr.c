@@ -112,6 +112,12 @@ int shr_fmm_init(void)
     if (0 != rv) {
         return SHR_E_MEMORY;
     }
+    /*
+     * Fields are allocated by every application thread that builds
+     * entries. Use thread caches to avoid contention on the pool lock.
+     * The thread cache is an optimization, so failure is not fatal.
+     */
+    (void)shr_lmm_cache_enable(field_mem_hdl, 0, 0);
     module_initialized = true;
     return SHR_E_NONE;
 }
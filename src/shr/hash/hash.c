@@ -93,6 +93,21 @@
 #include <sal/sal_types.h>
 #include <shr/shr_hash_alg.h>
 
+/* Multipliers of the word hash (64-bit golden ratio and SplitMix64). */
+#define WORD_HASH_M0    0x9e3779b97f4a7c15ULL
+#define WORD_HASH_M1    0xbf58476d1ce4e5b9ULL
+#define WORD_HASH_M2    0x94d049bb133111ebULL
+
+static inline uint64_t word_hash_mix(uint64_t h)
+{
+    h ^= h >> 30;
+    h *= WORD_HASH_M1;
+    h ^= h >> 27;
+    h *= WORD_HASH_M2;
+    h ^= h >> 31;
+    return h;
+}
+
 uint32_t shr_elf_hash(const uint8_t *key, size_t key_len)
 {
     uint32_t hash = 0;
@@ -115,3 +130,29 @@ uint32_t shr_elf_hash(const uint8_t *key, size_t key_len)
     return hash;
 }
 
+uint32_t shr_word_hash(const uint8_t *key, size_t key_len)
+{
+    uint64_t hash = key_len * WORD_HASH_M0;
+    uint64_t word;
+    size_t j;
+
+    while (key_len >= 8) {
+        word = (uint64_t)key[0] | (uint64_t)key[1] << 8 |
+               (uint64_t)key[2] << 16 | (uint64_t)key[3] << 24 |
+               (uint64_t)key[4] << 32 | (uint64_t)key[5] << 40 |
+               (uint64_t)key[6] << 48 | (uint64_t)key[7] << 56;
+        hash = word_hash_mix(hash ^ word);
+        key += 8;
+        key_len -= 8;
+    }
+
+    if (key_len > 0) {
+        word = 0;
+        for (j = 0; j < key_len; j++) {
+            word |= (uint64_t)key[j] << (j * 8);
+        }
+        hash = word_hash_mix(hash ^ word);
+    }
+
+    return (uint32_t)(hash ^ (hash >> 32));
+}
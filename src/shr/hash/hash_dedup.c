@@ -0,0 +1,268 @@
+/*! \file hash_dedup.c
+ *
+ * Content deduplication index.
+ *
+ * The index is a chained hash table over the table indexes. Every table
+ * index is a node of at most one chain, so the memory needed is fixed at
+ * creation time and no allocation takes place on insert.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <shr/shr_error.h>
+#include <shr/shr_hash_alg.h>
+#include <shr/shr_hash_dedup.h>
+
+/* End of chain marker. */
+#define DEDUP_NONE      (-1)
+
+typedef struct shr_hash_dedup_s {
+    uint32_t num_idx;
+    size_t data_size;
+    uint32_t bucket_mask;
+    int32_t *bucket;        /* First table index of every chain */
+    int32_t *next;          /* Next table index in the chain */
+    uint32_t *hash;         /* Hash of the content of every table index */
+    uint8_t *used;          /* Table index holds content */
+    uint8_t *data;          /* Content of every table index */
+} shr_hash_dedup_t;
+
+static inline uint8_t *
+dedup_data(shr_hash_dedup_t *dd, uint32_t idx)
+{
+    return dd->data + (size_t)idx * dd->data_size;
+}
+
+int
+shr_hash_dedup_create(uint32_t num_idx, size_t data_size,
+                      shr_hash_dedup_hdl_t *hdl)
+{
+    shr_hash_dedup_t *dd;
+    uint32_t num_bucket = 1;
+
+    if (!hdl || num_idx == 0 || num_idx > 0x7fffffff || data_size == 0) {
+        return SHR_E_PARAM;
+    }
+    while (num_bucket < num_idx) {
+        num_bucket <<= 1;
+    }
+
+    dd = sal_alloc(sizeof(*dd), "shrDedup");
+    if (!dd) {
+        return SHR_E_MEMORY;
+    }
+    sal_memset(dd, 0, sizeof(*dd));
+    dd->num_idx = num_idx;
+    dd->data_size = data_size;
+    dd->bucket_mask = num_bucket - 1;
+    dd->bucket = sal_alloc(num_bucket * sizeof(int32_t), "shrDedupBkt");
+    dd->next = sal_alloc(num_idx * sizeof(int32_t), "shrDedupNext");
+    dd->hash = sal_alloc(num_idx * sizeof(uint32_t), "shrDedupHash");
+    dd->used = sal_alloc(num_idx, "shrDedupUsed");
+    dd->data = sal_alloc((size_t)num_idx * data_size, "shrDedupData");
+    if (!dd->bucket || !dd->next || !dd->hash || !dd->used || !dd->data) {
+        shr_hash_dedup_destroy(dd);
+        return SHR_E_MEMORY;
+    }
+    shr_hash_dedup_clear(dd);
+
+    *hdl = dd;
+    return SHR_E_NONE;
+}
+
+void
+shr_hash_dedup_destroy(shr_hash_dedup_hdl_t hdl)
+{
+    shr_hash_dedup_t *dd = hdl;
+
+    if (!dd) {
+        return;
+    }
+    if (dd->bucket) {
+        sal_free(dd->bucket);
+    }
+    if (dd->next) {
+        sal_free(dd->next);
+    }
+    if (dd->hash) {
+        sal_free(dd->hash);
+    }
+    if (dd->used) {
+        sal_free(dd->used);
+    }
+    if (dd->data) {
+        sal_free(dd->data);
+    }
+    sal_free(dd);
+}
+
+void
+shr_hash_dedup_clear(shr_hash_dedup_hdl_t hdl)
+{
+    shr_hash_dedup_t *dd = hdl;
+    uint32_t j;
+
+    if (!dd) {
+        return;
+    }
+    for (j = 0; j <= dd->bucket_mask; j++) {
+        dd->bucket[j] = DEDUP_NONE;
+    }
+    sal_memset(dd->used, 0, dd->num_idx);
+}
+
+int
+shr_hash_dedup_find(shr_hash_dedup_hdl_t hdl, const void *data,
+                    uint32_t *idx)
+{
+    shr_hash_dedup_t *dd = hdl;
+    uint32_t hash;
+    int32_t cur;
+
+    if (!dd || !data || !idx) {
+        return SHR_E_PARAM;
+    }
+    hash = shr_word_hash(data, dd->data_size);
+    for (cur = dd->bucket[hash & dd->bucket_mask];
+         cur != DEDUP_NONE;
+         cur = dd->next[cur]) {
+        if (dd->hash[cur] == hash &&
+            sal_memcmp(dedup_data(dd, cur), data, dd->data_size) == 0) {
+            *idx = (uint32_t)cur;
+            return SHR_E_NONE;
+        }
+    }
+    return SHR_E_NOT_FOUND;
+}
+
+int
+shr_hash_dedup_insert(shr_hash_dedup_hdl_t hdl, uint32_t idx,
+                      const void *data)
+{
+    shr_hash_dedup_t *dd = hdl;
+    uint32_t hash;
+    uint32_t bkt;
+
+    if (!dd || !data || idx >= dd->num_idx) {
+        return SHR_E_PARAM;
+    }
+    if (dd->used[idx]) {
+        return SHR_E_EXISTS;
+    }
+    hash = shr_word_hash(data, dd->data_size);
+    bkt = hash & dd->bucket_mask;
+    sal_memcpy(dedup_data(dd, idx), data, dd->data_size);
+    dd->hash[idx] = hash;
+    dd->next[idx] = dd->bucket[bkt];
+    dd->bucket[bkt] = (int32_t)idx;
+    dd->used[idx] = 1;
+    return SHR_E_NONE;
+}
+
+int
+shr_hash_dedup_delete(shr_hash_dedup_hdl_t hdl, uint32_t idx)
+{
+    shr_hash_dedup_t *dd = hdl;
+    int32_t *link;
+
+    if (!dd || idx >= dd->num_idx) {
+        return SHR_E_PARAM;
+    }
+    if (!dd->used[idx]) {
+        return SHR_E_NOT_FOUND;
+    }
+    link = &dd->bucket[dd->hash[idx] & dd->bucket_mask];
+    while (*link != (int32_t)idx) {
+        link = &dd->next[*link];
+    }
+    *link = dd->next[idx];
+    dd->used[idx] = 0;
+    return SHR_E_NONE;
+}
@@ -0,0 +1,451 @@
+/*! \file hash_mph.c
+ *
+ * Minimal perfect hash over static string sets.
+ *
+ * The index uses the hash and displace scheme. Keys are distributed into
+ * small buckets and each bucket gets a displacement pair which places all
+ * its keys in free slots of a table that holds exactly one slot per key.
+ * Buckets are placed largest first while the table is still sparse.
+ */
+/*
+ * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
+ * Broadcom Limited and/or its subsidiaries.
+ * 
+ * Broadcom Switch Software License
+ * 
+ * This license governs the use of the accompanying Broadcom software. Your 
+ * use of the software indicates your acceptance of the terms and conditions 
+ * of this license. If you do not agree to the terms and conditions of this 
+ * license, do not use the software.
+ * 1. Definitions
+ *    "Licensor" means any person or entity that distributes its Work.
+ *    "Software" means the original work of authorship made available under 
+ *    this license.
+ *    "Work" means the Software and any additions to or derivative works of 
+ *    the Software that are made available under this license.
+ *    The terms "reproduce," "reproduction," "derivative works," and 
+ *    "distribution" have the meaning as provided under U.S. copyright law.
+ *    Works, including the Software, are "made available" under this license 
+ *    by including in or with the Work either (a) a copyright notice 
+ *    referencing the applicability of this license to the Work, or (b) a copy 
+ *    of this license.
+ * 2. Grant of Copyright License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    copyright license to reproduce, prepare derivative works of, publicly 
+ *    display, publicly perform, sublicense and distribute its Work and any 
+ *    resulting derivative works in any form.
+ * 3. Grant of Patent License
+ *    Subject to the terms and conditions of this license, each Licensor 
+ *    grants to you a perpetual, worldwide, non-exclusive, and royalty-free 
+ *    patent license to make, have made, use, offer to sell, sell, import, and 
+ *    otherwise transfer its Work, in whole or in part. This patent license 
+ *    applies only to the patent claims licensable by Licensor that would be 
+ *    infringed by Licensor's Work (or portion thereof) individually and 
+ *    excluding any combinations with any other materials or technology.
+ *    If you institute patent litigation against any Licensor (including a 
+ *    cross-claim or counterclaim in a lawsuit) to enforce any patents that 
+ *    you allege are infringed by any Work, then your patent license from such 
+ *    Licensor to the Work shall terminate as of the date such litigation is 
+ *    filed.
+ * 4. Redistribution
+ *    You may reproduce or distribute the Work only if (a) you do so under 
+ *    this License, (b) you include a complete copy of this License with your 
+ *    distribution, and (c) you retain without modification any copyright, 
+ *    patent, trademark, or attribution notices that are present in the Work.
+ * 5. Derivative Works
+ *    You may specify that additional or different terms apply to the use, 
+ *    reproduction, and distribution of your derivative works of the Work 
+ *    ("Your Terms") only if (a) Your Terms provide that the limitations of 
+ *    Section 7 apply to your derivative works, and (b) you identify the 
+ *    specific derivative works that are subject to Your Terms. 
+ *    Notwithstanding Your Terms, this license (including the redistribution 
+ *    requirements in Section 4) will continue to apply to the Work itself.
+ * 6. Trademarks
+ *    This license does not grant any rights to use any Licensor's or its 
+ *    affiliates' names, logos, or trademarks, except as necessary to 
+ *    reproduce the notices described in this license.
+ * 7. Limitations
+ *    Platform. The Work and any derivative works thereof may only be used, or 
+ *    intended for use, with a Broadcom switch integrated circuit.
+ *    No Reverse Engineering. You will not use the Work to disassemble, 
+ *    reverse engineer, decompile, or attempt to ascertain the underlying 
+ *    technology of a Broadcom switch integrated circuit.
+ * 8. Termination
+ *    If you violate any term of this license, then your rights under this 
+ *    license (including the license grants of Sections 2 and 3) will 
+ *    terminate immediately.
+ * 9. Disclaimer of Warranty
+ *    THE WORK IS PROVIDED "AS IS" WITHOUT WARRANTIES OR CONDITIONS OF ANY 
+ *    KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WARRANTIES OR CONDITIONS OF 
+ *    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE OR 
+ *    NON-INFRINGEMENT. YOU BEAR THE RISK OF UNDERTAKING ANY ACTIVITIES UNDER 
+ *    THIS LICENSE. SOME STATES' CONSUMER LAWS DO NOT ALLOW EXCLUSION OF AN 
+ *    IMPLIED WARRANTY, SO THIS DISCLAIMER MAY NOT APPLY TO YOU.
+ * 10. Limitation of Liability
+ *    EXCEPT AS PROHIBITED BY APPLICABLE LAW, IN NO EVENT AND UNDER NO LEGAL 
+ *    THEORY, WHETHER IN TORT (INCLUDING NEGLIGENCE), CONTRACT, OR OTHERWISE 
+ *    SHALL ANY LICENSOR BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY DIRECT, 
+ *    INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF 
+ *    OR RELATED TO THIS LICENSE, THE USE OR INABILITY TO USE THE WORK 
+ *    (INCLUDING BUT NOT LIMITED TO LOSS OF GOODWILL, BUSINESS INTERRUPTION, 
+ *    LOST PROFITS OR DATA, COMPUTER FAILURE OR MALFUNCTION, OR ANY OTHER 
+ *    COMMERCIAL DAMAGES OR LOSSES), EVEN IF THE LICENSOR HAS BEEN ADVISED OF 
+ *    THE POSSIBILITY OF SUCH DAMAGES.
+ */
+
+
+#include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <shr/shr_error.h>
+#include <shr/shr_bitop.h>
+#include <shr/shr_mph.h>
+
+/*******************************************************************************
+ * Local definitions
+ */
+
+/* Average number of keys per bucket. */
+#define MPH_BUCKET_LOAD     4
+
+/* Maximum number of first displacement values to try for a bucket. */
+#define MPH_D0_MAX          1024
+
+/* Number of seeds to try before giving up. */
+#define MPH_SEED_MAX        8
+
+/* Marks a duplicate key during construction. */
+#define MPH_KEY_DUP         0xffffffff
+
+typedef struct mph_disp_s {
+    uint32_t d0;
+    uint32_t d1;
+} mph_disp_t;
+
+struct shr_mph_s {
+    uint64_t seed;
+    uint32_t num_slots;
+    uint32_t num_buckets;
+    mph_disp_t *disp;
+    uint32_t *val;
+};
+
+/* Construction work area. */
+typedef struct mph_work_s {
+    /* Key hashes. */
+    uint64_t *hash;
+    /* Key indexes ordered by bucket. */
+    uint32_t *order;
+    /* First order index of each bucket (num_buckets + 1 entries). */
+    uint32_t *start;
+    /* Number of unique keys of each bucket. */
+    uint32_t *size;
+    /* Slot occupancy. */
+    SHR_BITDCL *used;
+    /* Slots of the bucket being placed. */
+    uint32_t *pos;
+} mph_work_t;
+
+/*******************************************************************************
+ * Private functions
+ */
+
+static inline uint64_t
+mph_mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static uint64_t
+mph_hash(uint64_t seed, uint64_t salt, const char *str)
+{
+    uint64_t h = 0xcbf29ce484222325ULL ^ mph_mix(salt ^ seed);
+
+    while (*str) {
+        h ^= (uint8_t)*str++;
+        h *= 0x100000001b3ULL;
+    }
+    return mph_mix(h);
+}
+
+static inline uint32_t
+mph_bucket(uint64_t h, uint32_t num_buckets)
+{
+    return (uint32_t)(h >> 32) % num_buckets;
+}
+
+static inline uint32_t
+mph_slot(uint64_t h, uint32_t num_slots, uint32_t d0, uint32_t d1)
+{
+    uint64_t g = mph_mix(h ^ 0x9e3779b97f4a7c15ULL);
+    uint64_t f1 = (uint32_t)g % num_slots;
+    uint64_t f2 = (uint32_t)(g >> 32) % num_slots;
+
+    return (uint32_t)((f1 + d0 * f2 + d1) % num_slots);
+}
+
+static void
+mph_work_free(mph_work_t *w)
+{
+    if (w->hash) {
+        sal_free(w->hash);
+    }
+    if (w->order) {
+        sal_free(w->order);
+    }
+    if (w->start) {
+        sal_free(w->start);
+    }
+    if (w->size) {
+        sal_free(w->size);
+    }
+    if (w->used) {
+        sal_free(w->used);
+    }
+    if (w->pos) {
+        sal_free(w->pos);
+    }
+}
+
+/*
+ * Hash all keys, group them by bucket and drop duplicates. Returns the
+ * number of unique keys and the largest bucket size.
+ */
+static void
+mph_keys_group(shr_mph_t *mph, mph_work_t *w,
+               const shr_mph_key_t *keys, uint32_t num_keys,
+               uint32_t *num_unique, uint32_t *max_size)
+{
+    uint32_t idx, b, i, j, ki, kj;
+    uint32_t unique = 0, max = 0;
+
+    sal_memset(w->start, 0, sizeof(uint32_t) * (mph->num_buckets + 1));
+    for (idx = 0; idx < num_keys; idx++) {
+        w->hash[idx] = mph_hash(mph->seed, keys[idx].salt, keys[idx].str);
+        w->start[mph_bucket(w->hash[idx], mph->num_buckets) + 1]++;
+    }
+    for (b = 0; b < mph->num_buckets; b++) {
+        w->start[b + 1] += w->start[b];
+    }
+    /* Stable placement keeps the key order within each bucket. */
+    sal_memcpy(w->size, w->start, sizeof(uint32_t) * mph->num_buckets);
+    for (idx = 0; idx < num_keys; idx++) {
+        b = mph_bucket(w->hash[idx], mph->num_buckets);
+        w->order[w->size[b]++] = idx;
+    }
+
+    for (b = 0; b < mph->num_buckets; b++) {
+        w->size[b] = 0;
+        for (i = w->start[b]; i < w->start[b + 1]; i++) {
+            ki = w->order[i];
+            for (j = w->start[b]; j < i; j++) {
+                kj = w->order[j];
+                if (kj != MPH_KEY_DUP &&
+                    w->hash[kj] == w->hash[ki] &&
+                    keys[kj].salt == keys[ki].salt &&
+                    sal_strcmp(keys[kj].str, keys[ki].str) == 0) {
+                    break;
+                }
+            }
+            if (j < i) {
+                w->order[i] = MPH_KEY_DUP;
+                continue;
+            }
+            w->size[b]++;
+        }
+        unique += w->size[b];
+        if (w->size[b] > max) {
+            max = w->size[b];
+        }
+    }
+    *num_unique = unique;
+    *max_size = max;
+}
+
+/*
+ * Find a displacement pair which places all keys of a bucket in free
+ * slots and claim the slots.
+ */
+static int
+mph_bucket_place(shr_mph_t *mph, mph_work_t *w,
+                 const shr_mph_key_t *keys, uint32_t b)
+{
+    uint32_t d0, d1, i, k, n, slot;
+    uint32_t m = mph->num_slots;
+
+    for (d0 = 0; d0 < MPH_D0_MAX; d0++) {
+        for (d1 = 0; d1 < m; d1++) {
+            n = 0;
+            for (i = w->start[b]; i < w->start[b + 1]; i++) {
+                if (w->order[i] == MPH_KEY_DUP) {
+                    continue;
+                }
+                slot = mph_slot(w->hash[w->order[i]], m, d0, d1);
+                if (SHR_BITGET(w->used, slot)) {
+                    break;
+                }
+                for (k = 0; k < n; k++) {
+                    if (w->pos[k] == slot) {
+                        break;
+                    }
+                }
+                if (k < n) {
+                    break;
+                }
+                w->pos[n++] = slot;
+            }
+            if (i < w->start[b + 1]) {
+                continue;
+            }
+            /* All keys placed. */
+            n = 0;
+            for (i = w->start[b]; i < w->start[b + 1]; i++) {
+                if (w->order[i] == MPH_KEY_DUP) {
+                    continue;
+                }
+                slot = w->pos[n++];
+                SHR_BITSET(w->used, slot);
+                mph->val[slot] = keys[w->order[i]].val;
+            }
+            mph->disp[b].d0 = d0;
+            mph->disp[b].d1 = d1;
+            return SHR_E_NONE;
+        }
+    }
+    return SHR_E_FAIL;
+}
+
+static int
+mph_build(shr_mph_t *mph, mph_work_t *w,
+          const shr_mph_key_t *keys, uint32_t num_keys)
+{
+    uint32_t unique, max_size, size, b;
+    int rv;
+
+    mph_keys_group(mph, w, keys, num_keys, &unique, &max_size);
+
+    mph->num_slots = unique;
+    if (unique == 0) {
+        return SHR_E_NONE;
+    }
+    if (mph->val == NULL) {
+        mph->val = sal_alloc(sizeof(uint32_t) * unique, "shrMphVal");
+        w->used = sal_alloc(SHR_BITALLOCSIZE(unique), "shrMphUsed");
+        if (!mph->val || !w->used) {
+            return SHR_E_MEMORY;
+        }
+    }
+    sal_memset(w->used, 0, SHR_BITALLOCSIZE(unique));
+    sal_memset(mph->disp, 0, sizeof(mph_disp_t) * mph->num_buckets);
+
+    /* Place the largest buckets first while the table is sparse. */
+    for (size = max_size; size > 0; size--) {
+        for (b = 0; b < mph->num_buckets; b++) {
+            if (w->size[b] != size) {
+                continue;
+            }
+            rv = mph_bucket_place(mph, w, keys, b);
+            if (SHR_FAILURE(rv)) {
+                return rv;
+            }
+        }
+    }
+    return SHR_E_NONE;
+}
+
+/*******************************************************************************
+ * Public functions
+ */
+
+int
+shr_mph_create(const shr_mph_key_t *keys, uint32_t num_keys, shr_mph_t **mph)
+{
+    shr_mph_t *m;
+    mph_work_t w;
+    uint32_t seed;
+    int rv = SHR_E_MEMORY;
+
+    if (!mph || (num_keys && !keys)) {
+        return SHR_E_PARAM;
+    }
+
+    m = sal_alloc(sizeof(*m), "shrMph");
+    if (!m) {
+        return SHR_E_MEMORY;
+    }
+    sal_memset(m, 0, sizeof(*m));
+    sal_memset(&w, 0, sizeof(w));
+    m->num_buckets = num_keys / MPH_BUCKET_LOAD + 1;
+
+    do {
+        m->disp = sal_alloc(sizeof(mph_disp_t) * m->num_buckets, "shrMphDisp");
+        w.hash = sal_alloc(sizeof(uint64_t) * (num_keys + 1), "shrMphHash");
+        w.order = sal_alloc(sizeof(uint32_t) * (num_keys + 1), "shrMphOrder");
+        w.start = sal_alloc(sizeof(uint32_t) * (m->num_buckets + 1),
+                            "shrMphStart");
+        w.size = sal_alloc(sizeof(uint32_t) * m->num_buckets, "shrMphSize");
+        /* Any bucket may hold all keys for some seed. */
+        w.pos = sal_alloc(sizeof(uint32_t) * (num_keys + 1), "shrMphPos");
+        if (!m->disp || !w.hash || !w.order || !w.start || !w.size ||
+            !w.pos) {
+            break;
+        }
+        for (seed = 0; seed < MPH_SEED_MAX; seed++) {
+            m->seed = mph_mix(seed + 1);
+            rv = mph_build(m, &w, keys, num_keys);
+            if (rv != SHR_E_FAIL) {
+                break;
+            }
+        }
+    } while (0);
+
+    mph_work_free(&w);
+    if (SHR_FAILURE(rv)) {
+        shr_mph_destroy(m);
+        return rv;
+    }
+    *mph = m;
+    return SHR_E_NONE;
+}
+
+void
+shr_mph_destroy(shr_mph_t *mph)
+{
+    if (!mph) {
+        return;
+    }
+    if (mph->disp) {
+        sal_free(mph->disp);
+    }
+    if (mph->val) {
+        sal_free(mph->val);
+    }
+    sal_free(mph);
+}
+
+int
+shr_mph_lookup(const shr_mph_t *mph, uint64_t salt, const char *str,
+               uint32_t *val)
+{
+    uint64_t h;
+    const mph_disp_t *d;
+
+    if (!mph || mph->num_slots == 0) {
+        return SHR_E_NOT_FOUND;
+    }
+    h = mph_hash(mph->seed, salt, str);
+    d = &mph->disp[mph_bucket(h, mph->num_buckets)];
+    *val = mph->val[mph_slot(h, mph->num_slots, d->d0, d->d1)];
+    return SHR_E_NONE;
+}
+
+uint32_t
+shr_mph_size(const shr_mph_t *mph)
+{
+    return mph ? mph->num_slots : 0;
+}
@@ -107,5 +107,21 @@
  */
 extern uint32_t shr_elf_hash(const uint8_t *key, size_t key_len);
 
+/*!
+ * \brief Calculate word-at-a-time multiplicative hash.
+ *
+ * This function consumes the key eight bytes at a time and mixes every
+ * word with two multiplications, so it is considerably faster than
+ * \ref shr_elf_hash for keys longer than a few bytes and distributes
+ * the hash bits evenly over the whole 32-bit result. This makes both
+ * the low and the high bits of the hash usable as table indices.
+ *
+ * \param [in] key Is the value to hash.
+ * \param [in] key_len Is the number of bytes in the key.
+ *
+ * \return The hash value of the key.
+ */
+extern uint32_t shr_word_hash(const uint8_t *key, size_t key_len);
+
 #endif
 
@@ -99,6 +99,40 @@
  */
 typedef struct shr_lmm_hdl_s *shr_lmm_hdl_t;
 
+/*!
+ * \brief Maximal number of local memory instances with thread caches.
+ */
+#ifndef SHR_LMM_CACHE_MAX
+#define SHR_LMM_CACHE_MAX   16
+#endif
+
+/*!
+ * \brief Thread cache statistics.
+ *
+ * A hit is an allocation (or free) that was served by the magazines of
+ * the calling thread without taking the memory manager lock. A miss had
+ * to exchange a magazine with the depot or to access the free list.
+ */
+typedef struct shr_lmm_cache_stats_s {
+    /*! Number of allocations served from the thread cache. */
+    uint64_t alloc_hits;
+
+    /*! Number of allocations that required the memory manager lock. */
+    uint64_t alloc_misses;
+
+    /*! Number of frees served by the thread cache. */
+    uint64_t free_hits;
+
+    /*! Number of frees that required the memory manager lock. */
+    uint64_t free_misses;
+
+    /*! Number of full magazines obtained from the depot. */
+    uint64_t depot_gets;
+
+    /*! Number of full magazines returned to the depot. */
+    uint64_t depot_puts;
+} shr_lmm_cache_stats_t;
+
 /*!
  * \brief Initializes local memory instance.
  *
@@ -279,4 +313,48 @@ extern void
 extern void
 shr_lmm_free(shr_lmm_hdl_t hdl, void *element);
 
+/*!
+ * \brief Enable per-thread caches for a local memory instance.
+ *
+ * This function adds a layer of per-thread magazines in front of the
+ * free list of a multi thread instance. Every thread allocates from and
+ * frees into its own magazines without taking the instance lock. When
+ * the magazines of a thread become empty (or full) they are exchanged
+ * with full (or empty) magazines from a depot that is bounded by
+ * \c depot_size full magazines. Elements beyond the depot capacity are
+ * returned to the free list.
+ *
+ * For instances with restricted number of elements the limit applies
+ * to the elements that are held by the users, so elements that are
+ * cached by other threads never cause an allocation to fail. The memory
+ * of the instance may therefore exceed the limit by the cached elements.
+ *
+ * This function should be called during initialization, before the
+ * instance is being used by multiple threads.
+ *
+ * \param [in] hdl is the local memory handle
+ * \param [in] mag_size is the number of elements in a magazine. Use 0
+ *              for the default size.
+ * \param [in] depot_size is the maximal number of full magazines in the
+ *              depot. Use 0 for the default size.
+ *
+ * \return 0 for success, -1 for failure.
+ */
+extern int
+shr_lmm_cache_enable(shr_lmm_hdl_t hdl,
+                     uint32_t mag_size,
+                     uint32_t depot_size);
+
+/*!
+ * \brief Get the thread cache statistics of a local memory instance.
+ *
+ * \param [in] hdl is the local memory handle
+ * \param [out] stats is the thread cache statistics
+ *
+ * \return 0 for success, -1 for failure (including if the thread cache
+ * was not enabled for this instance).
+ */
+extern int
+shr_lmm_cache_stats_get(shr_lmm_hdl_t hdl, shr_lmm_cache_stats_t *stats);
+
 #endif /* SHR_LMEM_MGR_H */
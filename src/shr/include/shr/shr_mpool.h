@@ -100,6 +100,61 @@ struct shr_mpool_mem_s;
 /*! Handle to be used for all operations on a memory pool. */
 typedef struct shr_mpool_mem_s *shr_mpool_handle_t;
 
+/*!
+ * \brief Memory pool statistics.
+ *
+ * The fragmentation of the first-fit blocks can be derived from \c free
+ * and \c max_free, e.g. as 1 - max_free / free.
+ */
+typedef struct shr_mpool_stats_s {
+
+    /*! Usable size of the pool in bytes. */
+    size_t size;
+
+    /*! Bytes held by first-fit blocks including slabs and descriptors. */
+    size_t used;
+
+    /*! Bytes between the first-fit blocks. */
+    size_t free;
+
+    /*! Largest number of contiguous free bytes. */
+    size_t max_free;
+
+    /*! Number of first-fit blocks including slabs. */
+    uint32_t blocks;
+
+    /*! Number of slabs. */
+    uint32_t slabs;
+
+    /*! Bytes of free objects in the slabs. */
+    size_t slab_free;
+
+    /*! Allocations served by the slabs. */
+    uint64_t slab_allocs;
+
+    /*! Slab allocations which found the calling thread's free list empty. */
+    uint64_t slab_misses;
+
+    /*! Number of slabs carved from the pool. */
+    uint64_t slab_grows;
+
+    /*! Number of empty slabs returned to the pool. */
+    uint64_t slab_trims;
+
+    /*! First-fit searches, a retry after a slab trim counts again. */
+    uint64_t ff_allocs;
+
+    /*! Failed first-fit searches. */
+    uint64_t ff_fails;
+
+    /*! Blocks visited by all first-fit searches. */
+    uint64_t ff_steps;
+
+    /*! Most blocks visited by a single first-fit search. */
+    uint32_t ff_steps_max;
+
+} shr_mpool_stats_t;
+
 /*!
  * \brief Create and initialize mpool control structures.
  *
@@ -107,8 +162,8 @@ typedef struct shr_mpool_mem_s *shr_mpool_handle_t;
  * used to manage a fixed block of memory.
  *
  * The allocated memory will be aligned to a minimum chunk size, in
- * order to minimize fragmentation. No other measures are taken to
- * prevent fragmentation.
+ * order to minimize fragmentation. Size-class slabs for small blocks
+ * can be added using \ref shr_mpool_slab_enable.
  *
  * Although memory can be allocated an freed dynamically, it is
  * recommended that a driver allocates as much memory as it needs
@@ -125,6 +180,30 @@ typedef struct shr_mpool_mem_s *shr_mpool_handle_t;
 extern shr_mpool_handle_t
 shr_mpool_create(void* base_address, size_t size, size_t chunk_size);
 
+/*!
+ * \brief Serve small allocations from size-class slabs.
+ *
+ * Allocations of up to 32 chunks are rounded up to one of a fixed set of
+ * size classes and served from slabs. A slab is a 64 KB first-fit block
+ * which is split into objects of a single size class. Free objects are
+ * kept in free lists which are sharded by calling thread, so threads
+ * allocating and freeing in parallel rarely contend, and the first-fit
+ * block list is only searched to carve a new slab.
+ *
+ * Larger allocations still use the first-fit allocator. If it runs out
+ * of space, slabs without allocated objects are returned to it.
+ *
+ * Slabs cannot be disabled again, except by destroying the pool.
+ *
+ * \param [in] pool mpool handle (from \ref shr_mpool_create).
+ *
+ * \retval 0 No errors.
+ * \retval -1 Slabs are already enabled, the pool is too small or out of
+ *             memory.
+ */
+extern int
+shr_mpool_slab_enable(shr_mpool_handle_t pool);
+
 /*!
  * \brief Free mpool control structures.
  *
@@ -169,6 +248,18 @@ shr_mpool_free(shr_mpool_handle_t pool, void* ptr);
 extern int
 shr_mpool_usage(shr_mpool_handle_t pool);
 
+/*!
+ * \brief Get memory pool statistics.
+ *
+ * \param [in] pool mpool handle (from \ref shr_mpool_create).
+ * \param [out] stats Memory pool statistics.
+ *
+ * \retval 0 No errors.
+ * \retval -1 Invalid parameter.
+ */
+extern int
+shr_mpool_stats_get(shr_mpool_handle_t pool, shr_mpool_stats_t *stats);
+
 /*!
  * \brief Return allocation unit size.
  *
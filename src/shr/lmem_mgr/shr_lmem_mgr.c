@@ -92,11 +92,22 @@
 #include <sal/sal_libc.h>
 #include <sal/sal_alloc.h>
 #include <sal/sal_mutex.h>
+#include <sal/sal_thread.h>
 #include <shr/shr_lmem_mgr.h>
 
 #define LMEM_MGR_SIGNATURE   0x75f2a5dc
 #define ROBUST_ENABLE       1
 
+/* Maximal number of elements of an unrestricted instance */
+#define LMM_UNRESTRICTED    0xFFFFFFFF
+
+/* Default number of elements in a magazine */
+#define LMM_CACHE_MAG_SIZE_DEF      32
+/* Maximal number of elements in a magazine */
+#define LMM_CACHE_MAG_SIZE_MAX      256
+/* Default number of full magazines kept in the depot */
+#define LMM_CACHE_DEPOT_SIZE_DEF    8
+
 #if ROBUST_ENABLE
 typedef enum {ELEMENT_FREE, ELEMENT_ALLOC
 } element_state_t;
@@ -107,6 +118,30 @@ typedef struct local_mem_chunks_s {
     struct local_mem_chunks_s *next;
 } local_mem_chunks_t;
 
+/*
+ * Magazine of free elements. Magazines are moved between the threads
+ * caches and the depot of the memory manager.
+ */
+typedef struct lmm_mag_s {
+    uint32_t rounds;    /* Number of elements in the magazine */
+    void *obj[];
+} lmm_mag_t;
+
+/*
+ * Thread cache layer of a memory manager. The depot is protected by the
+ * memory manager mutex.
+ */
+typedef struct lmm_cache_s {
+    uint32_t id;            /* Index into the thread cache slots */
+    uint32_t mag_size;      /* Number of elements in a full magazine */
+    uint32_t depot_size;    /* Maximal number of full magazines in depot */
+    uint32_t full_cnt;
+    lmm_mag_t **full;       /* Full magazines in the depot */
+    uint32_t empty_cnt;
+    lmm_mag_t **empty;      /* Empty magazines in the depot */
+    shr_lmm_cache_stats_t stats; /* Misses and hits of exited threads */
+} lmm_cache_t;
+
 typedef struct local_mem_mgr_s {
     uint32_t signature;
     size_t element_size;
@@ -115,11 +150,46 @@ typedef struct local_mem_mgr_s {
     bool mt;
     uint32_t max_count;
     uint32_t allocated;
+    uint32_t live;          /* Elements held by users (cached instance) */
     sal_mutex_t mtx;
     uint8_t *free_list;
     local_mem_chunks_t *chunk_list;
+    lmm_cache_t *cache;
 } local_mem_mgr_t;
 
+/*
+ * Per-thread cache. Every cached memory manager owns one slot which holds
+ * the loaded and the previous magazines of the thread (see Bonwick's
+ * magazine allocator). The thread allocates from and frees into its
+ * loaded magazine without any locking. The memory manager mutex is only
+ * taken to exchange magazines with the depot.
+ */
+typedef struct lmm_tcache_slot_s {
+    uint32_t gen;           /* Generation of the memory manager */
+    lmm_mag_t *loaded;
+    lmm_mag_t *prev;
+    uint64_t alloc_hits;
+    uint64_t free_hits;
+} lmm_tcache_slot_t;
+
+typedef struct lmm_tcache_s {
+    lmm_tcache_slot_t slot[SHR_LMM_CACHE_MAX];
+    struct lmm_tcache_s *next;
+} lmm_tcache_t;
+
+/*
+ * Global thread cache state. The memory managers that use thread caches
+ * are registered in a slot. The generation of the slot changes every time
+ * the memory manager is deleted so that the threads will discard their
+ * stale magazines. The cache mutex protects the registration and the list
+ * of thread caches.
+ */
+static sal_mutex_t cache_mtx;
+static sal_thread_data_t *cache_tdata;
+static local_mem_mgr_t *cache_lm[SHR_LMM_CACHE_MAX];
+static uint32_t cache_gen[SHR_LMM_CACHE_MAX];
+static lmm_tcache_t *tcache_list;
+
 static void arrange_new_chunk(local_mem_mgr_t *lm)
 {
     uint8_t *p_element = lm->free_list;
@@ -151,7 +221,7 @@ shr_lmm_init(size_t chunk_size,
              shr_lmm_hdl_t *hdl)
 {
     return shr_lmm_restrict_init(chunk_size, element_size, pointer_offset,
-                                 multi_thread, 0xFFFFFFFF, hdl);
+                                 multi_thread, LMM_UNRESTRICTED, hdl);
 }
 
 int
@@ -177,6 +247,8 @@ shr_lmm_restrict_init(size_t chunk_size,
     lm->mt = multi_thread;
     lm->max_count = max_elements;
     lm->allocated = 0;
+    lm->live = 0;
+    lm->cache = NULL;
     lm->free_list = sal_alloc(chunk_size * element_size, "shrLmmFree");
     if (!lm->free_list) {
         sal_free  (lm);
@@ -205,28 +277,23 @@ shr_lmm_restrict_init(size_t chunk_size,
 }
 
 
-void *shr_lmm_alloc(shr_lmm_hdl_t hdl)
+/*
+ * Allocate an element from the free list. The caller must hold the
+ * memory manager mutex (for multi thread instance).
+ */
+static void *free_list_alloc(local_mem_mgr_t *lm)
 {
-    local_mem_mgr_t *lm = (local_mem_mgr_t *)hdl;
     void *rv;
     uint8_t **next;
     local_mem_chunks_t *p_chunk;
     size_t alloc_size;
     bool success = false;
-#if ROBUST_ENABLE
-    uint32_t *state;
-#endif
 
-    if (!lm || (lm->signature != LMEM_MGR_SIGNATURE)) {
-        return NULL;
-    }
-    if (lm->mt) {
-        sal_mutex_take(lm->mtx, SAL_MUTEX_FOREVER);
-    }
-    if (lm->allocated >= lm->max_count) {
-        if (lm->mt) {
-            sal_mutex_give(lm->mtx);
-        }
+    /*
+     * The elements of a cached instance are accounted when they are
+     * handed to the user, as cached elements are not in use.
+     */
+    if (!lm->cache && lm->allocated >= lm->max_count) {
         return NULL;
     }
     if (lm->free_list == NULL) {
@@ -248,9 +315,6 @@ void *shr_lmm_alloc(shr_lmm_hdl_t hdl)
                 sal_free(lm->free_list);
                 lm->free_list = NULL;
             }
-            if (lm->mt) {
-                sal_mutex_give(lm->mtx);
-            }
             return NULL;
         }
         p_chunk->mem = lm->free_list;
@@ -259,24 +323,324 @@ void *shr_lmm_alloc(shr_lmm_hdl_t hdl)
         arrange_new_chunk(lm);
     }
     rv = (void *)lm->free_list;
-#if ROBUST_ENABLE
-        state = (uint32_t *)(lm->free_list + lm->element_size - sizeof(uint32_t));
-        *state = ELEMENT_ALLOC;
-#endif
 
     next = (uint8_t **)(lm->free_list + lm->pointer_offset);
     lm->free_list = *next;
     lm->allocated++;
-    if (lm->mt) {
+    return rv;
+}
+
+/*
+ * Return an element into the free list. The caller must hold the memory
+ * manager mutex (for multi thread instance).
+ */
+static void free_list_free(local_mem_mgr_t *lm, void *element)
+{
+    uint8_t **next;
+
+    next = (uint8_t **)((uint8_t *)element + lm->pointer_offset);
+    *next = lm->free_list;
+    lm->free_list = element;
+    lm->allocated--;
+}
+
+static lmm_mag_t *mag_alloc(lmm_cache_t *cache)
+{
+    lmm_mag_t *mag;
+
+    mag = sal_alloc(sizeof(lmm_mag_t) + cache->mag_size * sizeof(void *),
+                    "shrLmmMag");
+    if (mag) {
+        mag->rounds = 0;
+    }
+    return mag;
+}
+
+/*
+ * Return all the elements of the magazine into the free list. The caller
+ * must hold the memory manager mutex.
+ */
+static void mag_flush(local_mem_mgr_t *lm, lmm_mag_t *mag)
+{
+    if (!mag) {
+        return;
+    }
+    while (mag->rounds > 0) {
+        free_list_free(lm, mag->obj[--mag->rounds]);
+    }
+}
+
+/*
+ * Per-thread data destructor. Return the elements that are cached by the
+ * exiting thread to their memory managers.
+ */
+static void tcache_destroy(void *arg)
+{
+    lmm_tcache_t *tc = (lmm_tcache_t *)arg;
+    lmm_tcache_t **pp;
+    lmm_tcache_slot_t *slot;
+    local_mem_mgr_t *lm;
+    uint32_t id;
+
+    sal_mutex_take(cache_mtx, SAL_MUTEX_FOREVER);
+    for (id = 0; id < SHR_LMM_CACHE_MAX; id++) {
+        slot = &tc->slot[id];
+        lm = cache_lm[id];
+        if (lm && slot->gen == cache_gen[id]) {
+            sal_mutex_take(lm->mtx, SAL_MUTEX_FOREVER);
+            mag_flush(lm, slot->loaded);
+            mag_flush(lm, slot->prev);
+            lm->cache->stats.alloc_hits += slot->alloc_hits;
+            lm->cache->stats.free_hits += slot->free_hits;
+            sal_mutex_give(lm->mtx);
+        }
+        if (slot->loaded) {
+            sal_free(slot->loaded);
+        }
+        if (slot->prev) {
+            sal_free(slot->prev);
+        }
+    }
+    for (pp = &tcache_list; *pp; pp = &(*pp)->next) {
+        if (*pp == tc) {
+            *pp = tc->next;
+            break;
+        }
+    }
+    sal_mutex_give(cache_mtx);
+    sal_free(tc);
+}
+
+/*
+ * Get the cache slot of the calling thread for the memory manager. The
+ * thread cache is created upon the first use. Returns NULL if the thread
+ * cache can not be used, in which case the caller should use the free
+ * list directly.
+ */
+static lmm_tcache_slot_t *tcache_slot_get(local_mem_mgr_t *lm)
+{
+    lmm_tcache_t *tc;
+    lmm_tcache_slot_t *slot;
+    uint32_t id = lm->cache->id;
+
+    tc = (lmm_tcache_t *)sal_thread_data_get(cache_tdata);
+    if (!tc) {
+        tc = sal_alloc(sizeof(lmm_tcache_t), "shrLmmTcache");
+        if (!tc) {
+            return NULL;
+        }
+        sal_memset(tc, 0, sizeof(*tc));
+        if (sal_thread_data_set(cache_tdata, tc) != 0) {
+            sal_free(tc);
+            return NULL;
+        }
+        sal_mutex_take(cache_mtx, SAL_MUTEX_FOREVER);
+        tc->next = tcache_list;
+        tcache_list = tc;
+        sal_mutex_give(cache_mtx);
+    }
+
+    slot = &tc->slot[id];
+    if (slot->gen != cache_gen[id]) {
+        /*
+         * The slot was used by a memory manager that had been deleted.
+         * The elements in the magazines were freed along with it.
+         */
+        if (slot->loaded) {
+            sal_free(slot->loaded);
+            slot->loaded = NULL;
+        }
+        if (slot->prev) {
+            sal_free(slot->prev);
+            slot->prev = NULL;
+        }
+        slot->alloc_hits = 0;
+        slot->free_hits = 0;
+        slot->gen = cache_gen[id];
+    }
+    if (!slot->loaded) {
+        slot->loaded = mag_alloc(lm->cache);
+    }
+    if (!slot->prev) {
+        slot->prev = mag_alloc(lm->cache);
+    }
+    if (!slot->loaded || !slot->prev) {
+        return NULL;
+    }
+    return slot;
+}
+
+/*
+ * Account an element that is about to be handed to the user of a cached
+ * instance. Returns false if the instance is exhausted.
+ */
+static bool cache_live_get(local_mem_mgr_t *lm)
+{
+    if (lm->max_count == LMM_UNRESTRICTED) {
+        return true;
+    }
+    if (__atomic_add_fetch(&lm->live, 1, __ATOMIC_RELAXED) > lm->max_count) {
+        __atomic_sub_fetch(&lm->live, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    return true;
+}
+
+static void cache_live_put(local_mem_mgr_t *lm)
+{
+    if (lm->max_count != LMM_UNRESTRICTED) {
+        __atomic_sub_fetch(&lm->live, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void *cache_alloc(local_mem_mgr_t *lm)
+{
+    lmm_cache_t *cache = lm->cache;
+    lmm_tcache_slot_t *slot;
+    lmm_mag_t *mag;
+    void *rv = NULL;
+    uint32_t fill;
+
+    slot = tcache_slot_get(lm);
+    if (!slot) {
+        sal_mutex_take(lm->mtx, SAL_MUTEX_FOREVER);
+        rv = free_list_alloc(lm);
         sal_mutex_give(lm->mtx);
+        return rv;
+    }
+
+    if (slot->loaded->rounds == 0 && slot->prev->rounds > 0) {
+        mag = slot->loaded;
+        slot->loaded = slot->prev;
+        slot->prev = mag;
+    }
+    if (slot->loaded->rounds > 0) {
+        slot->alloc_hits++;
+        return slot->loaded->obj[--slot->loaded->rounds];
+    }
+
+    /* Both magazines are empty */
+    sal_mutex_take(lm->mtx, SAL_MUTEX_FOREVER);
+    cache->stats.alloc_misses++;
+    if (cache->full_cnt > 0) {
+        /* Exchange the empty magazine with a full one from the depot */
+        mag = cache->full[--cache->full_cnt];
+        if (cache->empty_cnt < cache->depot_size) {
+            cache->empty[cache->empty_cnt++] = slot->loaded;
+        } else {
+            sal_free(slot->loaded);
+        }
+        slot->loaded = mag;
+        cache->stats.depot_gets++;
+    } else {
+        /* Load half a magazine from the free list */
+        fill = (cache->mag_size + 1) / 2;
+        while (slot->loaded->rounds < fill) {
+            rv = free_list_alloc(lm);
+            if (!rv) {
+                break;
+            }
+            slot->loaded->obj[slot->loaded->rounds++] = rv;
+        }
+    }
+    rv = NULL;
+    if (slot->loaded->rounds > 0) {
+        rv = slot->loaded->obj[--slot->loaded->rounds];
+    }
+    sal_mutex_give(lm->mtx);
+    return rv;
+}
+
+static void cache_free(local_mem_mgr_t *lm, void *element)
+{
+    lmm_cache_t *cache = lm->cache;
+    lmm_tcache_slot_t *slot;
+    lmm_mag_t *mag;
+
+    slot = tcache_slot_get(lm);
+    if (!slot) {
+        sal_mutex_take(lm->mtx, SAL_MUTEX_FOREVER);
+        free_list_free(lm, element);
+        sal_mutex_give(lm->mtx);
+        return;
+    }
+
+    if (slot->loaded->rounds == cache->mag_size &&
+        slot->prev->rounds < cache->mag_size) {
+        mag = slot->loaded;
+        slot->loaded = slot->prev;
+        slot->prev = mag;
+    }
+    if (slot->loaded->rounds < cache->mag_size) {
+        slot->free_hits++;
+        slot->loaded->obj[slot->loaded->rounds++] = element;
+        return;
+    }
+
+    /* Both magazines are full */
+    sal_mutex_take(lm->mtx, SAL_MUTEX_FOREVER);
+    cache->stats.free_misses++;
+    if (cache->full_cnt < cache->depot_size) {
+        /* Exchange the full magazine with an empty one from the depot */
+        if (cache->empty_cnt > 0) {
+            mag = cache->empty[--cache->empty_cnt];
+        } else {
+            mag = mag_alloc(cache);
+        }
+        if (mag) {
+            cache->full[cache->full_cnt++] = slot->loaded;
+            slot->loaded = mag;
+            cache->stats.depot_puts++;
+        }
+    }
+    if (slot->loaded->rounds == cache->mag_size) {
+        /* The depot is full, return the elements to the free list */
+        mag_flush(lm, slot->loaded);
+    }
+    slot->loaded->obj[slot->loaded->rounds++] = element;
+    sal_mutex_give(lm->mtx);
+}
+
+void *shr_lmm_alloc(shr_lmm_hdl_t hdl)
+{
+    local_mem_mgr_t *lm = (local_mem_mgr_t *)hdl;
+    void *rv;
+#if ROBUST_ENABLE
+    uint32_t *state;
+#endif
+
+    if (!lm || (lm->signature != LMEM_MGR_SIGNATURE)) {
+        return NULL;
+    }
+    if (lm->cache) {
+        rv = NULL;
+        if (cache_live_get(lm)) {
+            rv = cache_alloc(lm);
+            if (!rv) {
+                cache_live_put(lm);
+            }
+        }
+    } else {
+        if (lm->mt) {
+            sal_mutex_take(lm->mtx, SAL_MUTEX_FOREVER);
+        }
+        rv = free_list_alloc(lm);
+        if (lm->mt) {
+            sal_mutex_give(lm->mtx);
+        }
+    }
+#if ROBUST_ENABLE
+    if (rv) {
+        state = (uint32_t *)((uint8_t *)rv + lm->element_size - sizeof(uint32_t));
+        *state = ELEMENT_ALLOC;
     }
+#endif
     return rv;
 }
 
 void shr_lmm_free(shr_lmm_hdl_t hdl, void *element)
 {
     local_mem_mgr_t *lm = (local_mem_mgr_t *)hdl;
-    uint8_t **next;
 #if ROBUST_ENABLE
     uint32_t *state;
 #endif
@@ -293,18 +657,119 @@ void shr_lmm_free(shr_lmm_hdl_t hdl, void *element)
         *state = ELEMENT_FREE;
 #endif
 
-    next = (uint8_t **)((uint8_t *)element + lm->pointer_offset);
+    if (lm->cache) {
+        cache_free(lm, element);
+        cache_live_put(lm);
+        return;
+    }
     if (lm->mt) {
         sal_mutex_take(lm->mtx, SAL_MUTEX_FOREVER);
     }
-    *next = lm->free_list;
-    lm->free_list = element;
-    lm->allocated--;
+    free_list_free(lm, element);
     if (lm->mt) {
         sal_mutex_give(lm->mtx);
     }
 }
 
+int shr_lmm_cache_enable(shr_lmm_hdl_t hdl,
+                         uint32_t mag_size,
+                         uint32_t depot_size)
+{
+    local_mem_mgr_t *lm = (local_mem_mgr_t *)hdl;
+    lmm_cache_t *cache;
+    uint32_t id;
+
+    if (!lm || (lm->signature != LMEM_MGR_SIGNATURE) || !lm->mt) {
+        return -1;
+    }
+    if (lm->cache) {
+        return 0;
+    }
+    if (mag_size == 0) {
+        mag_size = LMM_CACHE_MAG_SIZE_DEF;
+    }
+    if (depot_size == 0) {
+        depot_size = LMM_CACHE_DEPOT_SIZE_DEF;
+    }
+    if (mag_size > LMM_CACHE_MAG_SIZE_MAX) {
+        return -1;
+    }
+
+    if (!cache_mtx) {
+        cache_mtx = sal_mutex_create("shrLmmCache");
+        if (!cache_mtx) {
+            return -1;
+        }
+    }
+    if (!cache_tdata) {
+        cache_tdata = sal_thread_data_create(tcache_destroy);
+        if (!cache_tdata) {
+            return -1;
+        }
+    }
+
+    cache = sal_alloc(sizeof(lmm_cache_t) +
+                      2 * depot_size * sizeof(lmm_mag_t *), "shrLmmCache");
+    if (!cache) {
+        return -1;
+    }
+    sal_memset(cache, 0, sizeof(*cache));
+    cache->mag_size = mag_size;
+    cache->depot_size = depot_size;
+    cache->full = (lmm_mag_t **)(cache + 1);
+    cache->empty = cache->full + depot_size;
+
+    /* Register the memory manager in a free thread cache slot */
+    sal_mutex_take(cache_mtx, SAL_MUTEX_FOREVER);
+    for (id = 0; id < SHR_LMM_CACHE_MAX; id++) {
+        if (!cache_lm[id]) {
+            cache_lm[id] = lm;
+            break;
+        }
+    }
+    sal_mutex_give(cache_mtx);
+    if (id == SHR_LMM_CACHE_MAX) {
+        sal_free(cache);
+        return -1;
+    }
+    cache->id = id;
+
+    sal_mutex_take(lm->mtx, SAL_MUTEX_FOREVER);
+    lm->live = lm->allocated;
+    lm->cache = cache;
+    sal_mutex_give(lm->mtx);
+    return 0;
+}
+
+int shr_lmm_cache_stats_get(shr_lmm_hdl_t hdl, shr_lmm_cache_stats_t *stats)
+{
+    local_mem_mgr_t *lm = (local_mem_mgr_t *)hdl;
+    lmm_tcache_t *tc;
+    lmm_tcache_slot_t *slot;
+    uint32_t id;
+
+    if (!lm || (lm->signature != LMEM_MGR_SIGNATURE) ||
+        !lm->cache || !stats) {
+        return -1;
+    }
+    id = lm->cache->id;
+
+    sal_mutex_take(cache_mtx, SAL_MUTEX_FOREVER);
+    sal_mutex_take(lm->mtx, SAL_MUTEX_FOREVER);
+    *stats = lm->cache->stats;
+    sal_mutex_give(lm->mtx);
+    /* The hit counters are maintained by the threads */
+    for (tc = tcache_list; tc; tc = tc->next) {
+        slot = &tc->slot[id];
+        if (slot->gen == cache_gen[id]) {
+            stats->alloc_hits += slot->alloc_hits;
+            stats->free_hits += slot->free_hits;
+        }
+    }
+    sal_mutex_give(cache_mtx);
+    return 0;
+}
+
 void shr_lmm_delete(shr_lmm_hdl_t hdl)
 {
     local_mem_mgr_t *lm = (local_mem_mgr_t *)hdl;
@@ -313,6 +778,21 @@ void shr_lmm_delete(shr_lmm_hdl_t hdl)
     if (!lm || (lm->signature != LMEM_MGR_SIGNATURE)) {
         return;
     }
+    if (lm->cache) {
+        /* Invalidate the magazines that are held by the threads */
+        sal_mutex_take(cache_mtx, SAL_MUTEX_FOREVER);
+        cache_lm[lm->cache->id] = NULL;
+        cache_gen[lm->cache->id]++;
+        sal_mutex_give(cache_mtx);
+        while (lm->cache->full_cnt > 0) {
+            sal_free(lm->cache->full[--lm->cache->full_cnt]);
+        }
+        while (lm->cache->empty_cnt > 0) {
+            sal_free(lm->cache->empty[--lm->cache->empty_cnt]);
+        }
+        sal_free(lm->cache);
+        lm->cache = NULL;
+    }
     if (lm->mt) {
         sal_mutex_destroy(lm->mtx);
     }
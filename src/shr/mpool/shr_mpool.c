@@ -4,7 +4,9 @@
  * large pre-allocated block of physically contiguous memory.
  *
  * The allocator relies on a linked list of allocation descriptors, so
- * it does not scale well.
+ * it does not scale well. Small allocations can optionally be served
+ * from size-class slabs, which are carved from the same memory and have
+ * free lists per thread shard.
  */
 /*
  * Copyright: (c) 2018 Broadcom. All Rights Reserved. "Broadcom" refers to 
@@ -95,6 +97,8 @@
 
 #include <sal/sal_spinlock.h>
 #include <sal/sal_libc.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_thread.h>
 #include <shr/shr_mpool.h>
 
 /*******************************************************************************
@@ -116,14 +120,453 @@
 /*! Minimum pool size for meaningful operation. */
 #define MPOOL_SIZE_MIN          MPOOL_CHUNK_SIZE
 
-typedef struct shr_mpool_mem_s {
+/* Size of a slab (must be a power of two). Slabs are aligned to their size. */
+#ifndef MPOOL_SLAB_SIZE
+#define MPOOL_SLAB_SIZE         (64 * 1024)
+#endif
+
+/* Number of free list shards per size class (threads are hashed to one). */
+#ifndef MPOOL_SLAB_SHARDS
+#define MPOOL_SLAB_SHARDS       8
+#endif
+
+/* Maximum number of objects taken from another shard at a time. */
+#define MPOOL_SLAB_BATCH        16
+
+/* Number of slab size classes. */
+#define MPOOL_SLAB_CLASSES      10
+
+/* Largest slab size class in chunks. */
+#define MPOOL_SLAB_CHUNKS_MAX   32
+
+/*
+ * Slab size classes in chunks. Neighbouring classes are at most 50% apart,
+ * so at most a third of an object is wasted.
+ */
+static const uint32_t mpool_class_chunks[MPOOL_SLAB_CLASSES] = {
+    1, 2, 3, 4, 6, 8, 12, 16, 24, 32
+};
+
+/*
+ * Block descriptor of the first-fit allocator. The descriptor of a block
+ * is stored just in front of the block, i.e. in the tail of the previous
+ * block.
+ */
+typedef struct mpool_blk_s {
     char sig[8];
-    sal_spinlock_t lock;
     uint8_t *addr;
     size_t size;
-    struct shr_mpool_mem_s *next;
+    struct mpool_blk_s *next;
+} mpool_blk_t;
+
+/* Slab map slot. */
+typedef struct mpool_slab_s {
+    uint8_t *addr;      /* First object or NULL if the slot holds no slab */
+    uint32_t cls;       /* Size class */
+    uint32_t scan;      /* Free objects counted by the last trim */
+} mpool_slab_t;
+
+/* Free list shard of a size class. */
+typedef struct mpool_shard_s {
+    sal_spinlock_t lock;
+    void *free;         /* Free objects linked through their first word */
+    uint32_t cnt;       /* Number of free objects */
+    uint64_t allocs;    /* Objects allocated */
+    uint64_t misses;    /* Allocations which found the shard empty */
+} mpool_shard_t;
+
+/* Slab size class. */
+typedef struct mpool_class_s {
+    size_t size;        /* Object size */
+    uint32_t per_slab;  /* Objects per slab */
+    uint32_t slabs;     /* Number of slabs (pool lock) */
+    mpool_shard_t shard[MPOOL_SLAB_SHARDS];
+} mpool_class_t;
+
+/* Pool control structure. */
+typedef struct shr_mpool_mem_s {
+    /* Protects the block list, the slab map and the pool statistics */
+    sal_spinlock_t lock;
+    mpool_blk_t *head;
+    uint8_t *base;
+    uint8_t *end;
+
+    /* Slab layer, cls is NULL if slabs are not enabled */
+    mpool_class_t *cls;
+    uint8_t cls_idx[MPOOL_SLAB_CHUNKS_MAX + 1];
+    uint8_t *slab_base;
+    uint32_t slab_cnt;
+    mpool_slab_t *slab;
+
+    /* Statistics */
+    uint64_t ff_allocs;
+    uint64_t ff_fails;
+    uint64_t ff_steps;
+    uint32_t ff_steps_max;
+    uint64_t slab_grows;
+    uint64_t slab_trims;
 } shr_mpool_mem_t;
 
+/*******************************************************************************
+ * Private functions
+ */
+
+/*
+ * Allocate a block of size bytes (including the descriptor space) from the
+ * block list. The block address is aligned to align if not 0. The caller
+ * must hold the pool lock.
+ */
+static uint8_t *
+mpool_blk_alloc(shr_mpool_mem_t *pool, size_t size, size_t align,
+                uint32_t *steps)
+{
+    mpool_blk_t *mptr = pool->head, *new_mptr;
+    uint8_t *new_addr = NULL;
+    uint32_t cnt = 0;
+
+    while (mptr && mptr->next) {
+        cnt++;
+        new_addr = mptr->addr + mptr->size;
+        if (align) {
+            new_addr = (uint8_t *)(((unsigned long)new_addr + align - 1) &
+                                   ~((unsigned long)align - 1));
+        }
+        if (new_addr <= mptr->next->addr &&
+            (size_t)(mptr->next->addr - new_addr) >= size) {
+            break;
+        }
+        mptr = mptr->next;
+    }
+    *steps = cnt;
+
+    if (!(mptr && mptr->next)) {
+        return NULL;
+    }
+
+    new_mptr = (mpool_blk_t *)(new_addr - sizeof(mpool_blk_t));
+    new_mptr->addr = new_addr;
+    new_mptr->size = size;
+    new_mptr->next = mptr->next;
+    mptr->next = new_mptr;
+
+    /* For debug only */
+    sal_strncpy(new_mptr->sig, "alloc", sizeof(new_mptr->sig));
+
+    return new_addr;
+}
+
+/*
+ * Return a block to the block list. The caller must hold the pool lock.
+ */
+static void
+mpool_blk_free(shr_mpool_mem_t *pool, uint8_t *addr)
+{
+    mpool_blk_t *mptr = pool->head, *prev = NULL;
+
+    while (mptr && mptr->next) {
+        if (mptr->next->addr == addr) {
+            break;
+        }
+        mptr = mptr->next;
+    }
+
+    if (mptr && mptr->next) {
+        prev = mptr;
+        mptr = mptr->next;
+        prev->next = mptr->next;
+        mptr = (mpool_blk_t *)(addr - sizeof(mpool_blk_t));
+        sal_memset(mptr, 0, sizeof(mpool_blk_t));
+    }
+}
+
+/* Block size of an allocation of size bytes. */
+static size_t
+mpool_blk_size(size_t size)
+{
+    size_t mod;
+
+    size += sizeof(mpool_blk_t);
+    mod = size & (MPOOL_CHUNK_SIZE - 1);
+    if (mod != 0) {
+        size += (MPOOL_CHUNK_SIZE - mod);
+    }
+    return size;
+}
+
+/* Free list shard of the calling thread. */
+static inline uint32_t
+mpool_shard_idx(void)
+{
+    unsigned long t = (unsigned long)sal_thread_self();
+
+    t ^= t >> 12;
+    return (uint32_t)((t * 2654435761UL) >> 16) % MPOOL_SLAB_SHARDS;
+}
+
+/* Slab map slot of a pointer or NULL if it is not in a slab. */
+static inline mpool_slab_t *
+mpool_slab_get(shr_mpool_mem_t *pool, uint8_t *ptr)
+{
+    mpool_slab_t *slab;
+
+    if (ptr < pool->base || ptr >= pool->end) {
+        return NULL;
+    }
+    slab = &pool->slab[(ptr - pool->slab_base) / MPOOL_SLAB_SIZE];
+    return slab->addr ? slab : NULL;
+}
+
+/*
+ * Carve a new slab for a size class. Returns the objects linked through
+ * their first word, or NULL if the pool has no space for a slab.
+ */
+static void *
+mpool_slab_grow(shr_mpool_mem_t *pool, uint32_t cls_idx)
+{
+    mpool_class_t *cls = &pool->cls[cls_idx];
+    mpool_slab_t *slab;
+    uint8_t *addr, *obj;
+    uint32_t steps, idx;
+
+    sal_spinlock_lock(pool->lock);
+    addr = mpool_blk_alloc(pool, mpool_blk_size(MPOOL_SLAB_SIZE),
+                           MPOOL_SLAB_SIZE, &steps);
+    if (addr) {
+        slab = &pool->slab[(addr - pool->slab_base) / MPOOL_SLAB_SIZE];
+        slab->addr = addr;
+        slab->cls = cls_idx;
+        slab->scan = 0;
+        cls->slabs++;
+        pool->slab_grows++;
+    }
+    sal_spinlock_unlock(pool->lock);
+
+    if (addr == NULL) {
+        return NULL;
+    }
+
+    for (idx = 0, obj = addr; idx < cls->per_slab - 1; idx++) {
+        *(void **)obj = obj + cls->size;
+        obj += cls->size;
+    }
+    *(void **)obj = NULL;
+
+    return addr;
+}
+
+/* Allocate an object of a size class. */
+static void *
+mpool_slab_alloc(shr_mpool_mem_t *pool, uint32_t cls_idx)
+{
+    mpool_class_t *cls = &pool->cls[cls_idx];
+    uint32_t my_idx = mpool_shard_idx();
+    mpool_shard_t *sh = &cls->shard[my_idx], *osh;
+    void *obj, *first = NULL, *last;
+    uint32_t idx, cnt = 0;
+
+    sal_spinlock_lock(sh->lock);
+    obj = sh->free;
+    if (obj) {
+        sh->free = *(void **)obj;
+        sh->cnt--;
+        sh->allocs++;
+    } else {
+        sh->misses++;
+    }
+    sal_spinlock_unlock(sh->lock);
+    if (obj) {
+        return obj;
+    }
+
+    /* Take a batch of objects from another shard. */
+    for (idx = 1; idx < MPOOL_SLAB_SHARDS; idx++) {
+        osh = &cls->shard[(my_idx + idx) % MPOOL_SLAB_SHARDS];
+        sal_spinlock_lock(osh->lock);
+        first = osh->free;
+        cnt = 0;
+        if (first) {
+            last = first;
+            for (cnt = 1; cnt < MPOOL_SLAB_BATCH && *(void **)last; cnt++) {
+                last = *(void **)last;
+            }
+            osh->free = *(void **)last;
+            osh->cnt -= cnt;
+            *(void **)last = NULL;
+        }
+        sal_spinlock_unlock(osh->lock);
+        if (cnt) {
+            break;
+        }
+    }
+
+    /* Carve a new slab if all shards are empty. */
+    if (first == NULL) {
+        first = mpool_slab_grow(pool, cls_idx);
+        if (first == NULL) {
+            return NULL;
+        }
+        cnt = cls->per_slab;
+    }
+
+    /* Keep the rest of the objects in the shard of this thread. */
+    obj = first;
+    first = *(void **)obj;
+    sal_spinlock_lock(sh->lock);
+    sh->allocs++;
+    if (first) {
+        for (last = first; *(void **)last; last = *(void **)last) {
+            ;
+        }
+        *(void **)last = sh->free;
+        sh->free = first;
+        sh->cnt += cnt - 1;
+    }
+    sal_spinlock_unlock(sh->lock);
+
+    return obj;
+}
+
+/* Return an object to the shard of the calling thread. */
+static void
+mpool_slab_free(shr_mpool_mem_t *pool, mpool_slab_t *slab, uint8_t *ptr)
+{
+    mpool_class_t *cls = &pool->cls[slab->cls];
+    mpool_shard_t *sh;
+    size_t offset = ptr - slab->addr;
+
+    if ((offset % cls->size) != 0 || offset >= cls->per_slab * cls->size) {
+        return;
+    }
+
+    sh = &cls->shard[mpool_shard_idx()];
+    sal_spinlock_lock(sh->lock);
+    *(void **)ptr = sh->free;
+    sh->free = ptr;
+    sh->cnt++;
+    sal_spinlock_unlock(sh->lock);
+}
+
+/*
+ * Return all slabs without allocated objects to the block list.
+ *
+ * Returns the number of released slabs.
+ */
+static uint32_t
+mpool_slab_trim(shr_mpool_mem_t *pool)
+{
+    mpool_class_t *cls;
+    mpool_slab_t *slab;
+    mpool_shard_t *sh;
+    void **prev, *obj;
+    uint32_t cls_idx, idx, released = 0;
+
+    for (cls_idx = 0; cls_idx < MPOOL_SLAB_CLASSES; cls_idx++) {
+        cls = &pool->cls[cls_idx];
+        if (cls->slabs == 0) {
+            continue;
+        }
+
+        for (idx = 0; idx < MPOOL_SLAB_SHARDS; idx++) {
+            sal_spinlock_lock(cls->shard[idx].lock);
+        }
+
+        /* Count the free objects of each slab. */
+        for (idx = 0; idx < pool->slab_cnt; idx++) {
+            if (pool->slab[idx].cls == cls_idx) {
+                pool->slab[idx].scan = 0;
+            }
+        }
+        for (idx = 0; idx < MPOOL_SLAB_SHARDS; idx++) {
+            for (obj = cls->shard[idx].free; obj; obj = *(void **)obj) {
+                mpool_slab_get(pool, obj)->scan++;
+            }
+        }
+
+        /* Unlink the objects of the slabs which are entirely free. */
+        for (idx = 0; idx < MPOOL_SLAB_SHARDS; idx++) {
+            sh = &cls->shard[idx];
+            prev = &sh->free;
+            while ((obj = *prev) != NULL) {
+                if (mpool_slab_get(pool, obj)->scan == cls->per_slab) {
+                    *prev = *(void **)obj;
+                    sh->cnt--;
+                } else {
+                    prev = (void **)obj;
+                }
+            }
+        }
+
+        /* The pool lock is always taken after the shard locks. */
+        sal_spinlock_lock(pool->lock);
+        for (idx = 0; idx < pool->slab_cnt; idx++) {
+            slab = &pool->slab[idx];
+            if (slab->addr && slab->cls == cls_idx &&
+                slab->scan == cls->per_slab) {
+                mpool_blk_free(pool, slab->addr);
+                slab->addr = NULL;
+                slab->scan = 0;
+                cls->slabs--;
+                pool->slab_trims++;
+                released++;
+            }
+        }
+        sal_spinlock_unlock(pool->lock);
+
+        for (idx = MPOOL_SLAB_SHARDS; idx > 0; idx--) {
+            sal_spinlock_unlock(cls->shard[idx - 1].lock);
+        }
+    }
+
+    return released;
+}
+
+/*
+ * Search the block list and account the search.
+ *
+ * Must be called with the pool lock held.
+ */
+static void *
+mpool_ff_search(shr_mpool_mem_t *pool, size_t size)
+{
+    uint32_t steps;
+    uint8_t *addr;
+
+    addr = mpool_blk_alloc(pool, size, 0, &steps);
+
+    pool->ff_allocs++;
+    if (addr == NULL) {
+        pool->ff_fails++;
+    }
+    pool->ff_steps += steps;
+    if (steps > pool->ff_steps_max) {
+        pool->ff_steps_max = steps;
+    }
+
+    return addr;
+}
+
+/* Allocate a block from the block list. */
+static void *
+mpool_ff_alloc(shr_mpool_mem_t *pool, size_t size)
+{
+    uint8_t *addr;
+
+    size = mpool_blk_size(size);
+
+    sal_spinlock_lock(pool->lock);
+    addr = mpool_ff_search(pool, size);
+    sal_spinlock_unlock(pool->lock);
+
+    /* Give empty slabs back and retry. */
+    if (addr == NULL && pool->cls && mpool_slab_trim(pool) > 0) {
+        sal_spinlock_lock(pool->lock);
+        addr = mpool_ff_search(pool, size);
+        sal_spinlock_unlock(pool->lock);
+    }
+
+    return addr;
+}
+
 /*******************************************************************************
  * Public functions
  */
@@ -131,7 +574,8 @@ typedef struct shr_mpool_mem_s {
 shr_mpool_handle_t
 shr_mpool_create(void *base_ptr, size_t size, size_t chunk_size)
 {
-    shr_mpool_mem_t *head, *tail;
+    shr_mpool_mem_t *pool;
+    mpool_blk_t *head, *tail;
     unsigned long mod;
     uint8_t *mpool_base = base_ptr;
 
@@ -144,7 +588,7 @@ shr_mpool_create(void *base_ptr, size_t size, size_t chunk_size)
     }
 
     /* First chunk needs to contain head, tail and alignment */
-    if ((3 * sizeof(shr_mpool_mem_t)) > MPOOL_CHUNK_SIZE) {
+    if ((3 * sizeof(mpool_blk_t)) > MPOOL_CHUNK_SIZE) {
         return NULL;
     }
 
@@ -158,7 +602,13 @@ shr_mpool_create(void *base_ptr, size_t size, size_t chunk_size)
     /* Align pool size to chunk size if needed. */
     size &= ~(MPOOL_CHUNK_SIZE - 1);
 
-    head = (shr_mpool_mem_t *)mpool_base;
+    pool = sal_alloc(sizeof(*pool), "shrMpool");
+    if (pool == NULL) {
+        return NULL;
+    }
+    sal_memset(pool, 0, sizeof(*pool));
+
+    head = (mpool_blk_t *)mpool_base;
     tail = &head[1];
 
     head->size = tail->size = 0;
@@ -171,12 +621,89 @@ shr_mpool_create(void *base_ptr, size_t size, size_t chunk_size)
     sal_strncpy(head->sig, "head", sizeof(head->sig));
     sal_strncpy(tail->sig, "tail", sizeof(tail->sig));
 
-    head->lock = sal_spinlock_create("mpool_lock");
-    if (head->lock == NULL) {
+    pool->head = head;
+    pool->base = head->addr;
+    pool->end = tail->addr;
+
+    pool->lock = sal_spinlock_create("mpool_lock");
+    if (pool->lock == NULL) {
+        sal_free(pool);
         return NULL;
     }
 
-    return head;
+    return pool;
+}
+
+int
+shr_mpool_slab_enable(shr_mpool_handle_t pool)
+{
+    mpool_class_t *cls;
+    uint32_t cls_idx, idx, chunks;
+
+    if (pool == NULL || pool->cls) {
+        return -1;
+    }
+
+    /* The pool must be able to hold a few slabs. */
+    if ((size_t)(pool->end - pool->base) < 4 * MPOOL_SLAB_SIZE) {
+        return -1;
+    }
+
+    pool->slab_base = (uint8_t *)((unsigned long)pool->base &
+                                  ~((unsigned long)MPOOL_SLAB_SIZE - 1));
+    pool->slab_cnt = (pool->end - pool->slab_base) / MPOOL_SLAB_SIZE + 1;
+    pool->slab = sal_alloc(pool->slab_cnt * sizeof(*pool->slab),
+                           "shrMpoolSlab");
+    cls = sal_alloc(MPOOL_SLAB_CLASSES * sizeof(*cls), "shrMpoolClass");
+    if (pool->slab == NULL || cls == NULL) {
+        if (cls) {
+            sal_free(cls);
+        }
+        if (pool->slab) {
+            sal_free(pool->slab);
+            pool->slab = NULL;
+        }
+        return -1;
+    }
+    sal_memset(pool->slab, 0, pool->slab_cnt * sizeof(*pool->slab));
+    sal_memset(cls, 0, MPOOL_SLAB_CLASSES * sizeof(*cls));
+
+    for (cls_idx = 0, chunks = 1; cls_idx < MPOOL_SLAB_CLASSES; cls_idx++) {
+        cls[cls_idx].size = mpool_class_chunks[cls_idx] * MPOOL_CHUNK_SIZE;
+        cls[cls_idx].per_slab = MPOOL_SLAB_SIZE / cls[cls_idx].size;
+        for (; chunks <= mpool_class_chunks[cls_idx]; chunks++) {
+            pool->cls_idx[chunks] = cls_idx;
+        }
+        for (idx = 0; idx < MPOOL_SLAB_SHARDS; idx++) {
+            cls[cls_idx].shard[idx].lock =
+                sal_spinlock_create("mpool_slab_lock");
+            if (cls[cls_idx].shard[idx].lock == NULL) {
+                break;
+            }
+        }
+        if (idx < MPOOL_SLAB_SHARDS) {
+            break;
+        }
+    }
+    pool->cls_idx[0] = 0;
+
+    if (cls_idx < MPOOL_SLAB_CLASSES) {
+        for (cls_idx = 0; cls_idx < MPOOL_SLAB_CLASSES; cls_idx++) {
+            for (idx = 0; idx < MPOOL_SLAB_SHARDS; idx++) {
+                if (cls[cls_idx].shard[idx].lock) {
+                    sal_spinlock_destroy(cls[cls_idx].shard[idx].lock);
+                }
+            }
+        }
+        sal_free(cls);
+        sal_free(pool->slab);
+        pool->slab = NULL;
+        return -1;
+    }
+
+    pool->cls = cls;
+
+    return 0;
 }
 
 /*
@@ -192,11 +719,24 @@ shr_mpool_create(void *base_ptr, size_t size, size_t chunk_size)
 int
 shr_mpool_destroy(shr_mpool_handle_t pool)
 {
+    uint32_t cls_idx, idx;
+
     if (pool == NULL) {
         return -1;
     }
 
+    if (pool->cls) {
+        for (cls_idx = 0; cls_idx < MPOOL_SLAB_CLASSES; cls_idx++) {
+            for (idx = 0; idx < MPOOL_SLAB_SHARDS; idx++) {
+                sal_spinlock_destroy(pool->cls[cls_idx].shard[idx].lock);
+            }
+        }
+        sal_free(pool->cls);
+        sal_free(pool->slab);
+    }
+
     sal_spinlock_destroy(pool->lock);
+    sal_free(pool);
 
     return 0;
 }
@@ -215,49 +755,24 @@ shr_mpool_destroy(shr_mpool_handle_t pool)
 void *
 shr_mpool_alloc(shr_mpool_handle_t pool, size_t size)
 {
-    shr_mpool_mem_t *mptr = pool, *new_mptr = NULL;
-    size_t free_gap;
-    uint8_t *new_addr;
-    int mod;
+    size_t chunks;
+    void *ptr;
 
     if (pool == NULL) {
         return NULL;
     }
 
-    sal_spinlock_lock(pool->lock);
-
-    size += sizeof(shr_mpool_mem_t);
-
-    mod = size & (MPOOL_CHUNK_SIZE - 1);
-    if (mod != 0 ) {
-        size += (MPOOL_CHUNK_SIZE - mod);
-    }
-    while (mptr && mptr->next) {
-        free_gap = mptr->next->addr - (mptr->addr + mptr->size);
-        if (free_gap >= size) {
-            break;
+    if (pool->cls) {
+        chunks = (size + MPOOL_CHUNK_SIZE - 1) / MPOOL_CHUNK_SIZE;
+        if (chunks <= MPOOL_SLAB_CHUNKS_MAX) {
+            ptr = mpool_slab_alloc(pool, pool->cls_idx[chunks]);
+            if (ptr) {
+                return ptr;
+            }
         }
-        mptr = mptr->next;
-    }
-
-    if (!(mptr && mptr->next)) {
-        sal_spinlock_unlock(pool->lock);
-        return NULL;
     }
 
-    new_addr = mptr->addr + mptr->size;
-    new_mptr = (shr_mpool_mem_t *)(new_addr - sizeof(shr_mpool_mem_t));
-    new_mptr->addr = new_addr;
-    new_mptr->size = size;
-    new_mptr->next = mptr->next;
-    mptr->next = new_mptr;
-
-    /* For debug only */
-    sal_strncpy(new_mptr->sig, "alloc", sizeof(new_mptr->sig));
-
-    sal_spinlock_unlock(pool->lock);
-
-    return new_mptr->addr;
+    return mpool_ff_alloc(pool, size);
 }
 
 
@@ -276,29 +791,22 @@ void
 shr_mpool_free(shr_mpool_handle_t pool, void *ptr)
 {
     uint8_t *addr = (uint8_t *)ptr;
-    shr_mpool_mem_t *mptr = pool, *prev = NULL;
+    mpool_slab_t *slab;
 
     if (pool == NULL) {
         return;
     }
 
-    sal_spinlock_lock(pool->lock);
-
-    while (mptr && mptr->next) {
-        if (mptr->next->addr == addr) {
-            break;
+    if (pool->cls) {
+        slab = mpool_slab_get(pool, addr);
+        if (slab) {
+            mpool_slab_free(pool, slab, addr);
+            return;
         }
-        mptr = mptr->next;
-    }
-
-    if (mptr && mptr->next) {
-        prev = mptr;
-        mptr = mptr->next;
-        prev->next = mptr->next;
-        mptr = (shr_mpool_mem_t *)(addr - sizeof(shr_mpool_mem_t));
-        sal_memset(mptr, 0, sizeof(shr_mpool_mem_t));
     }
 
+    sal_spinlock_lock(pool->lock);
+    mpool_blk_free(pool, addr);
     sal_spinlock_unlock(pool->lock);
 }
 
@@ -315,22 +823,71 @@ shr_mpool_free(shr_mpool_handle_t pool, void *ptr)
 int
 shr_mpool_usage(shr_mpool_handle_t pool)
 {
-    int usage = 0;
-    shr_mpool_mem_t *mptr;
+    shr_mpool_stats_t stats;
 
-    if (pool == NULL) {
+    if (shr_mpool_stats_get(pool, &stats) < 0) {
         return -1;
     }
 
-    sal_spinlock_lock(pool->lock);
+    return (int)(stats.used - stats.slab_free);
+}
 
-    for (mptr = pool; mptr; mptr = mptr->next) {
-	usage += mptr->size;
+int
+shr_mpool_stats_get(shr_mpool_handle_t pool, shr_mpool_stats_t *stats)
+{
+    mpool_blk_t *mptr;
+    mpool_shard_t *sh;
+    size_t gap;
+    uint32_t cls_idx, idx;
+
+    if (pool == NULL || stats == NULL) {
+        return -1;
     }
 
+    sal_memset(stats, 0, sizeof(*stats));
+    stats->size = pool->end - pool->base;
+
+    sal_spinlock_lock(pool->lock);
+    for (mptr = pool->head; mptr; mptr = mptr->next) {
+        stats->used += mptr->size;
+        if (mptr != pool->head && mptr->next) {
+            stats->blocks++;
+        }
+        if (mptr->next) {
+            gap = mptr->next->addr - (mptr->addr + mptr->size);
+            stats->free += gap;
+            if (gap > stats->max_free) {
+                stats->max_free = gap;
+            }
+        }
+    }
+    stats->ff_allocs = pool->ff_allocs;
+    stats->ff_fails = pool->ff_fails;
+    stats->ff_steps = pool->ff_steps;
+    stats->ff_steps_max = pool->ff_steps_max;
+    stats->slab_grows = pool->slab_grows;
+    stats->slab_trims = pool->slab_trims;
+    if (pool->cls) {
+        for (cls_idx = 0; cls_idx < MPOOL_SLAB_CLASSES; cls_idx++) {
+            stats->slabs += pool->cls[cls_idx].slabs;
+        }
+    }
     sal_spinlock_unlock(pool->lock);
 
-    return usage;
+    if (pool->cls) {
+        for (cls_idx = 0; cls_idx < MPOOL_SLAB_CLASSES; cls_idx++) {
+            for (idx = 0; idx < MPOOL_SLAB_SHARDS; idx++) {
+                sh = &pool->cls[cls_idx].shard[idx];
+                sal_spinlock_lock(sh->lock);
+                stats->slab_free += sh->cnt * pool->cls[cls_idx].size;
+                stats->slab_allocs += sh->allocs;
+                stats->slab_misses += sh->misses;
+                sal_spinlock_unlock(sh->lock);
+            }
+        }
+    }
+
+    return 0;
 }
 
 size_t
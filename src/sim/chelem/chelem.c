@@ -90,98 +90,329 @@
  */
 
 #include <sal/sal_assert.h>
+#include <sal/sal_alloc.h>
+#include <sal/sal_mutex.h>
 
-#include <sim/chelem/chelem.h>
+#include <bcmdrd_config.h>
 
-#ifndef CHELEM_MAX
-#define CHELEM_MAX              (500 * 1024)
-#endif
+#include <sim/chelem/chelem.h>
 
 #ifndef CHELEM_ENTRY_NAX
 #define CHELEM_ENTRY_NAX        (4 * 32)
 #endif
 
+/* Number of elements per storage block. */
+#ifndef CHELEM_BLK_SIZE
+#define CHELEM_BLK_SIZE         4096
+#endif
+
+/* Initial number of hash buckets (power of 2). */
+#define CHELEM_HASH_MIN         4096
+
+/* Empty hash bucket. */
+#define CHELEM_IDX_NONE         0xffffffff
+
 typedef struct chelem_s {
-    int unit;
     uint32_t addrx;
     uint32_t addr;
     uint8_t data[CHELEM_ENTRY_NAX];
 } chelem_t;
 
+/*
+ * Per-unit storage. Elements live in fixed size blocks which are never
+ * moved, and are located through an open addressing hash table holding
+ * element indexes.
+ */
+typedef struct chelem_db_s {
+    chelem_t **blks;
+    uint32_t num_blks;
+    uint32_t count;
+    uint32_t *hash;
+    uint32_t hash_size;
+} chelem_db_t;
 
-static chelem_t chelem[CHELEM_MAX];
+static chelem_db_t chelem_db[BCMDRD_CONFIG_MAX_UNITS];
 
-static uint32_t chelem_free_idx = 0;
+/*
+ * The lock is created by chelem_init() before the simulated devices
+ * are created. Reads before that point find an empty database.
+ */
+static sal_mutex_t chelem_lock;
 
-static chelem_t *
-find_chelem(int unit, uint32_t addrx, uint32_t addr, chelem_t *chelems)
+#define CHELEM_ELEM(_db, _idx) \
+    (&(_db)->blks[(_idx) / CHELEM_BLK_SIZE][(_idx) % CHELEM_BLK_SIZE])
+
+static uint32_t
+chelem_hash(uint32_t addrx, uint32_t addr)
 {
-    uint32_t i;
-    for (i = 0; i < chelem_free_idx; i++) {
-        if (chelems[i].addrx == addrx &&
-            chelems[i].addr == addr &&
-            chelems[i].unit == unit) {
-            return chelems + i;
+    uint32_t h = addr ^ (addrx * 0x9e3779b9);
+
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+static uint32_t *
+find_bucket(chelem_db_t *db, uint32_t addrx, uint32_t addr)
+{
+    uint32_t mask = db->hash_size - 1;
+    uint32_t b = chelem_hash(addrx, addr) & mask;
+    chelem_t *ch;
+
+    while (db->hash[b] != CHELEM_IDX_NONE) {
+        ch = CHELEM_ELEM(db, db->hash[b]);
+        if (ch->addrx == addrx && ch->addr == addr) {
+            break;
         }
+        b = (b + 1) & mask;
     }
-    return NULL;
+    return &db->hash[b];
 }
 
 static chelem_t *
-find_or_create_chelem(int unit, uint32_t addrx, uint32_t addr, chelem_t *chelems)
+find_chelem(int unit, uint32_t addrx, uint32_t addr)
 {
+    chelem_db_t *db = &chelem_db[unit];
+    uint32_t *bkt;
+
+    if (db->hash == NULL) {
+        return NULL;
+    }
+    bkt = find_bucket(db, addrx, addr);
+    if (*bkt == CHELEM_IDX_NONE) {
+        return NULL;
+    }
+    return CHELEM_ELEM(db, *bkt);
+}
+
+static int
+hash_resize(chelem_db_t *db, uint32_t hash_size)
+{
+    uint32_t *hash, *old_hash = db->hash;
+    uint32_t idx;
     chelem_t *ch;
 
-    if ((ch = find_chelem(unit, addrx, addr, chelems)) == NULL) {
-        if (chelem_free_idx < CHELEM_MAX) {
-            ch = &chelems[chelem_free_idx++];
-        } else {
-            assert(0);
+    hash = sal_alloc(hash_size * sizeof(*hash), "simChelemHash");
+    if (hash == NULL) {
+        return -1;
+    }
+    sal_memset(hash, 0xff, hash_size * sizeof(*hash));
+
+    db->hash = hash;
+    db->hash_size = hash_size;
+    for (idx = 0; idx < db->count; idx++) {
+        ch = CHELEM_ELEM(db, idx);
+        *find_bucket(db, ch->addrx, ch->addr) = idx;
+    }
+
+    if (old_hash) {
+        sal_free(old_hash);
+    }
+    return 0;
+}
+
+static chelem_t *
+find_or_create_chelem(int unit, uint32_t addrx, uint32_t addr)
+{
+    chelem_db_t *db = &chelem_db[unit];
+    chelem_t **blks;
+    chelem_t *ch;
+    uint32_t *bkt;
+    uint32_t idx;
+
+    /* Keep the hash table at most half full. */
+    if (db->hash == NULL || (db->count + 1) * 2 > db->hash_size) {
+        if (hash_resize(db, db->hash ? db->hash_size * 2 :
+                                       CHELEM_HASH_MIN) < 0) {
+            return NULL;
+        }
+    }
+
+    bkt = find_bucket(db, addrx, addr);
+    if (*bkt != CHELEM_IDX_NONE) {
+        return CHELEM_ELEM(db, *bkt);
+    }
+
+    idx = db->count;
+    if (idx / CHELEM_BLK_SIZE >= db->num_blks) {
+        blks = sal_alloc((db->num_blks + 1) * sizeof(*blks), "simChelemBlks");
+        if (blks == NULL) {
+            return NULL;
+        }
+        blks[db->num_blks] = sal_alloc(CHELEM_BLK_SIZE * sizeof(chelem_t),
+                                       "simChelemBlk");
+        if (blks[db->num_blks] == NULL) {
+            sal_free(blks);
             return NULL;
         }
+        if (db->blks) {
+            sal_memcpy(blks, db->blks, db->num_blks * sizeof(*blks));
+            sal_free(db->blks);
+        }
+        db->blks = blks;
+        db->num_blks++;
     }
 
-    ch->unit = unit;
+    ch = CHELEM_ELEM(db, idx);
+    sal_memset(ch, 0, sizeof(*ch));
     ch->addrx = addrx;
     ch->addr = addr;
+    *bkt = idx;
+    db->count++;
 
     return ch;
 }
 
+static void
+chelem_lock_take(void)
+{
+    sal_mutex_take(chelem_lock, SAL_MUTEX_FOREVER);
+}
+
+static void
+chelem_lock_give(void)
+{
+    sal_mutex_give(chelem_lock);
+}
+
+int
+chelem_init(void)
+{
+    if (chelem_lock == NULL) {
+        chelem_lock = sal_mutex_create("simChelemLock");
+        if (chelem_lock == NULL) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
 void
 chelem_clear_all(void)
 {
-    sal_memset(chelem, 0, sizeof(chelem));
+    chelem_db_t *db;
+    uint32_t b;
+    int unit;
+
+    if (chelem_lock) {
+        sal_mutex_take(chelem_lock, SAL_MUTEX_FOREVER);
+    }
+    for (unit = 0; unit < BCMDRD_CONFIG_MAX_UNITS; unit++) {
+        db = &chelem_db[unit];
+        for (b = 0; b < db->num_blks; b++) {
+            sal_free(db->blks[b]);
+        }
+        if (db->blks) {
+            sal_free(db->blks);
+        }
+        if (db->hash) {
+            sal_free(db->hash);
+        }
+        sal_memset(db, 0, sizeof(*db));
+    }
+    if (chelem_lock) {
+        sal_mutex_give(chelem_lock);
+    }
 }
 
 int
 chelem_read(int unit, uint32_t addrx, uint32_t addr,
             void *data, size_t size)
 {
+    return chelem_range_read(unit, addrx, addr, 0, 1, data, size);
+}
+
+int
+chelem_write(int unit, uint32_t addrx, uint32_t addr,
+             void *data, size_t size)
+{
+    return chelem_range_write(unit, addrx, addr, 0, 1, data, size);
+}
+
+int
+chelem_range_read(int unit, uint32_t addrx, uint32_t addr, uint32_t stride,
+                  uint32_t count, void *data, size_t size)
+{
+    uint8_t *buf = data;
     chelem_t *ch;
+    uint32_t i;
 
-    ch = find_chelem(unit, addrx, addr, chelem);
-    if (ch) {
-        assert(size < sizeof(ch->data));
-        sal_memcpy(data, ch->data, size);
-    } else {
-        sal_memset(data, 0, size);
+    if (unit < 0 || unit >= BCMDRD_CONFIG_MAX_UNITS) {
+        return -1;
     }
+    assert(size <= CHELEM_ENTRY_NAX);
+
+    if (chelem_lock == NULL) {
+        sal_memset(data, 0, size * count);
+        return 0;
+    }
+
+    chelem_lock_take();
+    for (i = 0; i < count; i++) {
+        ch = find_chelem(unit, addrx, addr + i * stride);
+        if (ch) {
+            sal_memcpy(buf, ch->data, size);
+        } else {
+            sal_memset(buf, 0, size);
+        }
+        buf += size;
+    }
+    chelem_lock_give();
+
     return 0;
 }
 
 int
-chelem_write(int unit, uint32_t addrx, uint32_t addr,
-             void *data, size_t size)
+chelem_range_write(int unit, uint32_t addrx, uint32_t addr, uint32_t stride,
+                   uint32_t count, void *data, size_t size)
 {
+    uint8_t *buf = data;
     chelem_t *ch;
+    uint32_t i;
+    int rv = 0;
 
-    ch = find_or_create_chelem(unit, addrx, addr, chelem);
-    if (!ch) {
+    if (unit < 0 || unit >= BCMDRD_CONFIG_MAX_UNITS) {
         return -1;
     }
-    assert(ch);
-    assert(size <= sizeof(ch->data));
-    sal_memcpy(ch->data, data, size);
-    return 0;
+    assert(size <= CHELEM_ENTRY_NAX);
+
+    if (chelem_lock == NULL) {
+        return -1;
+    }
+
+    chelem_lock_take();
+    for (i = 0; i < count; i++) {
+        ch = find_or_create_chelem(unit, addrx, addr + i * stride);
+        if (!ch) {
+            rv = -1;
+            break;
+        }
+        sal_memcpy(ch->data, buf, size);
+        buf += size;
+    }
+    chelem_lock_give();
+
+    return rv;
+}
+
+int
+chelem_count(int unit)
+{
+    int count;
+
+    if (unit < 0 || unit >= BCMDRD_CONFIG_MAX_UNITS) {
+        return -1;
+    }
+    if (chelem_lock == NULL) {
+        return 0;
+    }
+
+    chelem_lock_take();
+    count = chelem_db[unit].count;
+    chelem_lock_give();
+
+    return count;
 }
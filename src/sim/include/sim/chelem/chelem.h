@@ -94,6 +94,9 @@
 
 #include <sal/sal_libc.h>
 
+extern int
+chelem_init(void);
+
 extern void
 chelem_clear_all(void);
 
@@ -105,4 +108,15 @@ extern int
 chelem_write(int unit, uint32_t addrx, uint32_t addr,
              void *data, size_t size);
 
+extern int
+chelem_range_read(int unit, uint32_t addrx, uint32_t addr, uint32_t stride,
+                  uint32_t count, void *data, size_t size);
+
+extern int
+chelem_range_write(int unit, uint32_t addrx, uint32_t addr, uint32_t stride,
+                   uint32_t count, void *data, size_t size);
+
+extern int
+chelem_count(int unit);
+
 #endif /* CHELEM_H */